@@ -0,0 +1,4 @@
+//a
+int main() {
+    return 1 + 2;
+}
\ No newline at end of file
@@ -0,0 +1,9 @@
+//fun main():
+//       0:   int t0
+//       1:   t0 = 1
+//       4:   ret t0
+int main() {
+    int a = 1;
+    int b = 2;
+    return a;
+}
\ No newline at end of file
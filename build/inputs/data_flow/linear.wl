@@ -0,0 +1,30 @@
+//fun main():
+//       0:   int t0
+//       1:   t0 = 1
+//       2:   int t1
+//       3:   int t2
+//       4:   t2 = t0 + 1
+//       5:   t1 = t2
+//       6:   int t3
+//       7:   int t4
+//       8:   t4 = t1 + 1
+//       9:   t3 = t4
+//      10:   int t5
+//      11:   int t6
+//      12:   t6 = t3 + 1
+//      13:   t5 = t6
+//      14:   int t7
+//      15:   int t8
+//      16:   t8 = t5 + 1
+//      17:   t7 = t8
+//      18:   int t9
+//      19:   t9 = t7 + 1
+//      20:   ret t9
+int main() {
+    int a = 1;
+    int b = a + 1;
+    int c = b + 1;
+    int d = c + 1;
+    int e = d + 1;
+    return e + 1;
+}
\ No newline at end of file
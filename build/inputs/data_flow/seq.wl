@@ -0,0 +1,18 @@
+//fun main():
+//       0:   int t0
+//       1:   t0 = 1
+//       2:   t0 = t0 + 1
+//       3:   t0 = t0 + 1
+//       4:   t0 = t0 + 1
+//       5:   t0 = t0 + 1
+//       6:   t0 = t0 + 1
+//       7:   ret t0
+int main() {
+    int a = 1;
+    ++a;
+    ++a;
+    ++a;
+    ++a;
+    ++a;
+    return a;
+}
\ No newline at end of file
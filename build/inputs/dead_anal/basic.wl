@@ -0,0 +1,34 @@
+//a
+int main(int param) {
+	while (1) {
+		
+	}
+	while (0) {
+		
+	}
+	while (0 + 0) {
+		
+	}
+	while (0 + 1) {
+		
+	}
+	while (1 * 2 * 3 * 4 * 5) {
+		
+	}
+	while (2 * 2 - 2 * 2) {
+	
+	}
+	while (5 + 5) {
+		
+	}
+
+	int i = 0;
+	while (i + i) {
+		
+	}
+	while (i + param) {
+		
+	}
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,10 @@
+//fun main():
+//       0:   int t0
+//       3:   t0.2 = 3
+//       4:   ret t0.2
+int main() {
+    int a = 1;
+    a = 2;
+    a = 3;
+    return a;
+}
\ No newline at end of file
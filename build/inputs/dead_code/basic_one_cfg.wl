@@ -0,0 +1,15 @@
+//fun main():
+//       2:   int t1
+//       3:   t1.0 = 2
+//       4:   int t2
+//       5:   t2.0 = 3
+//       8:   int t4
+//       9:   t4.0 = t1.0 + t2.0
+//      10:   ret t4.0
+int main() {
+    int a = 1;
+    int b = 2;
+    int c = 3;
+    int d = 4;
+    return b + c;
+}
\ No newline at end of file
@@ -0,0 +1,27 @@
+//fun main():
+//       0:   int t0
+//       1:   t0.0 = 1
+//       2:   int t1
+//       3:   t1.0 = 2
+//       6:   | int t3
+//       7:   | t3.0 = t0.0 + t1.0
+//       8:   | if t3.0 != 0 goto L10
+//       9:   | jmp L12
+//      10:   | t1.2 = 4
+//      11:   | jmp L13
+//      12:   | t1.1 = 5
+//            t1.3 = φ(t1.2, t1.1)
+//      13:   ret t1.3
+int main() {
+    int a = 1;
+    int b = 2;
+    int c = 3;
+
+    if (a + b) {
+        b = 4;
+    } else {
+        b = 5;
+    }
+
+    return b;
+}
\ No newline at end of file
@@ -0,0 +1,18 @@
+//fun main():
+//       0:   int t0
+//       1:   t0.0 = 1
+//       8:   | jmp L17
+//      17:   ret t0.0
+int main() {
+    int a = 1;
+    int b = 2;
+    int c = 0;
+
+    if (a < b) {
+        c = a + b;
+    } else {
+        c = a - b;
+    }
+
+    return a;
+}
@@ -0,0 +1,8 @@
+//a
+int main() {
+    int a = 1;
+    int b = 2;
+    int c = 3;
+    int d = 4;
+    return b + c;
+}
\ No newline at end of file
@@ -0,0 +1,4 @@
+//6
+int main() {
+    return 1 + 2 + 3;
+}
\ No newline at end of file
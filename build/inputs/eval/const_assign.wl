@@ -0,0 +1,10 @@
+//720
+int main() {
+    int a = 1;
+    int b = a + 1;
+    int c = b + 1;
+    int d = c + 1;
+    int e = d + 1;
+    int f = e + 1;
+    return a * b * c * d * e * f;
+}
\ No newline at end of file
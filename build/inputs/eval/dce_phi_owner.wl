@@ -0,0 +1,9 @@
+//30
+int main() {
+    int p = 30;
+    if (p < 3) {
+        p = 1;
+    }
+    for (int i = 1; i <= 40; i = i + 2) {}
+    return p;
+}
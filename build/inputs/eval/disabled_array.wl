@@ -0,0 +1,7 @@
+//3
+int main() {
+    int mem[2];
+    mem[0] = 1;
+    mem[1] = 2;
+    return mem[0] + mem[1];
+}
\ No newline at end of file
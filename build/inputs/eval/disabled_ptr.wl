@@ -0,0 +1,7 @@
+//2
+int main() {
+    int a = 3;
+    int *ptr = &a;
+    a = 2;
+    return *ptr;
+}
\ No newline at end of file
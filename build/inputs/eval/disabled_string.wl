@@ -0,0 +1,5 @@
+//1
+int main() {
+    char *s = "Abc";
+    return s[0];
+}
\ No newline at end of file
@@ -0,0 +1,8 @@
+//5040
+int main() {
+    int res = 1;
+    for (int i = 1; i <= 7; ++i) {
+        res = res * i;
+    }
+    return res;
+}
\ No newline at end of file
@@ -0,0 +1,11 @@
+//120
+int fact(int n) {
+    if (n == 1) {
+        return 1;
+    }
+    return n * fact(n - 1);
+}
+
+int main() {
+    return fact(5);
+}
\ No newline at end of file
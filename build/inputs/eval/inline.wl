@@ -0,0 +1,30 @@
+//116
+int sq(int x) {
+    return x * x;
+}
+
+int dist(int x) {
+    if (x < 0) {
+        return 0 - x;
+    }
+    return x;
+}
+
+int fact(int n) {
+    if (n < 2) {
+        return 1;
+    }
+    return n * fact(n - 1);
+}
+
+int twice(int x) {
+    return sq(sq(x));
+}
+
+int main() {
+    int s = 0;
+    for (int i = 0; i < 9; ++i) {
+        s = s + sq(i) + dist(i - 4);
+    }
+    return ((s - fact(4)) + twice(2)) - 100;
+}
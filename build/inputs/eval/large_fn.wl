@@ -0,0 +1,65 @@
+//277
+int main() {
+    int v0 = 7;
+    int v1 = ((v0 * 3) + 1) % 1000;
+    int v2 = ((v1 * 3) + 2) % 1000;
+    int v3 = ((v2 * 3) + 3) % 1000;
+    int v4 = ((v3 * 3) + 4) % 1000;
+    int v5 = ((v4 * 3) + 5) % 1000;
+    int v6 = ((v5 * 3) + 6) % 1000;
+    int v7 = ((v6 * 3) + 7) % 1000;
+    int v8 = ((v7 * 3) + 8) % 1000;
+    int v9 = ((v8 * 3) + 9) % 1000;
+    int v10 = ((v9 * 3) + 10) % 1000;
+    int v11 = ((v10 * 3) + 11) % 1000;
+    int v12 = ((v11 * 3) + 12) % 1000;
+    int v13 = ((v12 * 3) + 13) % 1000;
+    int v14 = ((v13 * 3) + 14) % 1000;
+    int v15 = ((v14 * 3) + 15) % 1000;
+    int v16 = ((v15 * 3) + 16) % 1000;
+    int v17 = ((v16 * 3) + 17) % 1000;
+    int v18 = ((v17 * 3) + 18) % 1000;
+    int v19 = ((v18 * 3) + 19) % 1000;
+    int v20 = ((v19 * 3) + 20) % 1000;
+    int v21 = ((v20 * 3) + 21) % 1000;
+    int v22 = ((v21 * 3) + 22) % 1000;
+    int v23 = ((v22 * 3) + 23) % 1000;
+    int v24 = ((v23 * 3) + 24) % 1000;
+    int v25 = ((v24 * 3) + 25) % 1000;
+    int v26 = ((v25 * 3) + 26) % 1000;
+    int v27 = ((v26 * 3) + 27) % 1000;
+    int v28 = ((v27 * 3) + 28) % 1000;
+    int v29 = ((v28 * 3) + 29) % 1000;
+    int v30 = ((v29 * 3) + 30) % 1000;
+    int v31 = ((v30 * 3) + 31) % 1000;
+    int v32 = ((v31 * 3) + 32) % 1000;
+    int v33 = ((v32 * 3) + 33) % 1000;
+    int v34 = ((v33 * 3) + 34) % 1000;
+    int v35 = ((v34 * 3) + 35) % 1000;
+    int v36 = ((v35 * 3) + 36) % 1000;
+    int v37 = ((v36 * 3) + 37) % 1000;
+    int v38 = ((v37 * 3) + 38) % 1000;
+    int v39 = ((v38 * 3) + 39) % 1000;
+    int v40 = ((v39 * 3) + 40) % 1000;
+    int v41 = ((v40 * 3) + 41) % 1000;
+    int v42 = ((v41 * 3) + 42) % 1000;
+    int v43 = ((v42 * 3) + 43) % 1000;
+    int v44 = ((v43 * 3) + 44) % 1000;
+    int v45 = ((v44 * 3) + 45) % 1000;
+    int v46 = ((v45 * 3) + 46) % 1000;
+    int v47 = ((v46 * 3) + 47) % 1000;
+    int v48 = ((v47 * 3) + 48) % 1000;
+    int v49 = ((v48 * 3) + 49) % 1000;
+    int v50 = ((v49 * 3) + 50) % 1000;
+    int v51 = ((v50 * 3) + 51) % 1000;
+    int v52 = ((v51 * 3) + 52) % 1000;
+    int v53 = ((v52 * 3) + 53) % 1000;
+    int v54 = ((v53 * 3) + 54) % 1000;
+    int v55 = ((v54 * 3) + 55) % 1000;
+    int v56 = ((v55 * 3) + 56) % 1000;
+    int v57 = ((v56 * 3) + 57) % 1000;
+    int v58 = ((v57 * 3) + 58) % 1000;
+    int v59 = ((v58 * 3) + 59) % 1000;
+    int v60 = ((v59 * 3) + 60) % 1000;
+    return v60;
+}
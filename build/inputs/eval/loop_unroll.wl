@@ -0,0 +1,32 @@
+//243
+int f(int n) {
+    int s = 0;
+    for (int i = 0; i < n; ++i) {
+        if (i > 5) {
+            s = s + 2;
+        }
+        s = s + i;
+    }
+    for (int k = 100; k >= 0; k = k - 3) {
+        s = s + k;
+        if (s > 1500) {
+            break;
+        }
+    }
+    int j = 0;
+    while (j < 7) {
+        s = s + j * 3;
+        j = j + 1;
+    }
+    for (int m = 10; m != 40; m = m + 5) {
+        s = s - m;
+    }
+    return s;
+}
+int main() {
+    int r = 0;
+    for (int t = 0; t < 11; ++t) {
+        r = r + f(t);
+    }
+    return r % 256;
+}
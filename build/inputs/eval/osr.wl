@@ -0,0 +1,29 @@
+//194933
+int step(int x, int n) {
+    if (n == 0) {
+        return x;
+    }
+    return step(((x * 7) + n) % 1009, n - 1);
+}
+
+/* Called once, so it only tiers up on loop back edges. */
+int kernel(int n) {
+    int seed = 17;
+    int acc = 0;
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < 20; ++j) {
+            seed = step(seed, j % 3);
+            acc = (acc + (seed ^ i)) % 65521;
+        }
+    }
+    return acc;
+}
+
+int main() {
+    int acc = kernel(300);
+    int sum = 0;
+    for (int i = 0; i < 5000; ++i) {
+        sum = (sum + ((i * i) % 97)) % 10007;
+    }
+    return (acc * 3) + sum;
+}
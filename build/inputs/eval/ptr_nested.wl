@@ -0,0 +1,8 @@
+//3
+int main() {
+    int    v = 3;
+    int  *p0 = &v;
+    int **p1 = &p0;
+
+    return **p1;
+}
\ No newline at end of file
@@ -0,0 +1,17 @@
+//7830
+int f(int a, int b, int c) {
+    int s = 0;
+    for (int i = 0; i < 20; ++i) {
+        int x = a + i + 3 + b + 4;
+        int y = 3 + (b + a) + 4 + i;
+        int m = (a * i) * 2 * 3;
+        int z = (x ^ c) ^ (i ^ c);
+        int w = ((i & 7) & (x & 7)) | 1;
+        s = s + x + y + m + z + w + 1;
+    }
+    return s;
+}
+
+int main() {
+    return f(5, 11, 9);
+}
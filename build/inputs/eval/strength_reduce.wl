@@ -0,0 +1,13 @@
+//14900
+int main() {
+    int s = 0;
+    for (int i = 0; i < 50; ++i) {
+        s = s + i * 7 + (i + 3) * 2 - (i << 2);
+    }
+    int k = 100;
+    while (k > 10) {
+        s = s + k * 5;
+        k = k - 3;
+    }
+    return s;
+}
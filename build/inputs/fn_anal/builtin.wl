@@ -0,0 +1,5 @@
+//E<3:5>: Arguments size mismatch: 1 got, but 0 expected
+int main() {
+    call_trace(0);
+    return 0;
+}
\ No newline at end of file
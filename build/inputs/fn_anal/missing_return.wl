@@ -0,0 +1,2 @@
+//E<2:1>: Expected return value
+int main() {}
\ No newline at end of file
@@ -0,0 +1,4 @@
+//E<3:5>: Cannot return value from void function
+void f() {
+    return "Hi";
+}
\ No newline at end of file
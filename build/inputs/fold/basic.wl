@@ -0,0 +1,9 @@
+//fun main():
+//       0:   int t0
+//       1:   int t1
+//       2:   t1 = 5
+//       3:   t0 = 6
+//       4:   ret 6
+int main() {
+    return 1 + 2 + 3;
+}
\ No newline at end of file
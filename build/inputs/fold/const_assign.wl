@@ -0,0 +1,43 @@
+//fun main():
+//       0:   int t0
+//       1:   t0 = 1
+//       2:   int t1
+//       3:   int t2
+//       4:   t2 = 2
+//       5:   t1 = 2
+//       6:   int t3
+//       7:   int t4
+//       8:   t4 = 3
+//       9:   t3 = 3
+//      10:   int t5
+//      11:   int t6
+//      12:   t6 = 4
+//      13:   t5 = 4
+//      14:   int t7
+//      15:   int t8
+//      16:   t8 = 5
+//      17:   t7 = 5
+//      18:   int t9
+//      19:   int t10
+//      20:   t10 = 6
+//      21:   t9 = 6
+//      22:   int t11
+//      23:   int t12
+//      24:   int t13
+//      25:   int t14
+//      26:   int t15
+//      27:   t15 = 30
+//      28:   t14 = 120
+//      29:   t13 = 360
+//      30:   t12 = 720
+//      31:   t11 = 720
+//      32:   ret 720
+int main() {
+    int a = 1;
+    int b = a + 1;
+    int c = b + 1;
+    int d = c + 1;
+    int e = d + 1;
+    int f = e + 1;
+    return a * b * c * d * e * f;
+}
\ No newline at end of file
@@ -0,0 +1,32 @@
+//fun main():
+//       0:   int t0
+//       3:   int t2
+//       6:   int t3
+//       7:   int t4
+//      10:   int t5
+//      11:   int t6
+//       2:   int t1
+//       1:   t0 = 1
+//       4:   t2 = t0 + 2
+//       5:   t1 = t2
+//       8:   t4 = t1 * 3
+//       9:   t3 = t4
+//      12:   t6 = t3 - 4
+//      13:   t5 = t6
+//      14:   ret t5
+//--------
+//t0: 0
+//t2: 0
+//t3: 0
+//t4: 0
+//t5: 0
+//t6: 0
+//t1: 0
+//frame size: 8
+int main() {
+    int a = 1;
+    int b = a + 2;
+    int c = b * 3;
+    int d = c - 4;
+    return d;
+}
@@ -0,0 +1,42 @@
+//fun main():
+//       0:   int t0
+//       4:   int t2
+//       8:   int t3
+//       9:   int t4
+//      12:   int t5
+//      17:   int t6
+//      18:   int t7
+//       2:   int t1
+//       1:   t0 = 0
+//       3:   t1 = 0
+//       5:   | t2 = t1 < 10
+//       6:   | if t2 != 0 goto L10
+//       7:   | jmp L19
+//      10:   | t4 = t1 * 2
+//      11:   | t3 = t4
+//      13:   | t5 = t0 + t3
+//      14:   | t0 = t5
+//      15:   | t1 = t1 + 1
+//      16:   | jmp L5
+//      19:   t7 = t0 + 1
+//      20:   t6 = t7
+//      21:   ret t6
+//--------
+//t0: 0
+//t2: 4
+//t3: 4
+//t4: 4
+//t5: 0
+//t6: 0
+//t7: 0
+//t1: 8
+//frame size: 16
+int main() {
+    int s = 0;
+    for (int i = 0; i < 10; ++i) {
+        int t = i * 2;
+        s = s + t;
+    }
+    int r = s + 1;
+    return r;
+}
@@ -0,0 +1,30 @@
+//fun main():
+//       0:   char t0
+//       4:   boolean t2
+//       6:   int t3
+//       7:   int t4
+//      10:   char t5
+//       2:   int t1
+//       1:   t0 = 'a'
+//       3:   t1 = 1
+//       5:   t2 = 1
+//       8:   t4 = t1 + 1
+//       9:   t3 = t4
+//      11:   t5 = t0
+//      12:   ret t3
+//--------
+//t0: 0
+//t2: 1
+//t3: 4
+//t4: 4
+//t5: 0
+//t1: 4
+//frame size: 8
+int main() {
+    char c = 'a';
+    int i = 1;
+    bool b = true;
+    int j = i + 1;
+    char d = c;
+    return j;
+}
@@ -0,0 +1,17 @@
+//a
+int sum_2()
+{
+    int r = 1 + 2;
+    return r;
+}
+
+int sum_3()
+{
+    int r = 1 + 2 + 3;
+    return r;
+}
+
+int main()
+{
+    return 0;
+}
\ No newline at end of file
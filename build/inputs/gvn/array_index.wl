@@ -0,0 +1,62 @@
+//fun main():
+//       0:   int t0[16]
+//       1:   int t1
+//       2:   t1.0 = 0
+//       3:   int t2
+//       4:   t2.0 = 0
+//            | t1.1 = φ(t1.0, t1.2)
+//            | t2.1 = φ(t2.0, t2.2)
+//       5:   | int t3
+//       6:   | t3.0 = t2.1 < 4
+//       7:   | if t3.0 != 0 goto L9
+//       8:   | jmp L45
+//       9:   | int t4
+//      10:   | t4.0 = 0
+//            | | t1.2 = φ(t1.1, t1.3)
+//            | | t4.1 = φ(t4.0, t4.2)
+//      11:   | | int t5
+//      12:   | | t5.0 = t4.1 < 4
+//      13:   | | if t5.0 != 0 goto L15
+//      14:   | | jmp L43
+//      15:   | | int t6
+//      16:   | | int t7
+//      17:   | | t7.0 = t2.1 * 4
+//      18:   | | t6.0 = t7.0 + t4.1
+//      19:   | | int * t8
+//      20:   | | t8.0 = t0 + t6.0
+//      21:   | | int t9
+//      22:   | | t9.0 = t2.1 + t4.1
+//      23:   | | *t8.0 = t9.0
+//      24:   | | int t10
+//      25:   | | int t11
+//      26:   | | int t12
+//      27:   | | int t13
+//      28:   | | t13.0 = t7.0
+//      29:   | | t12.0 = t6.0
+//      30:   | | int * t14
+//      31:   | | t14.0 = t8.0
+//      32:   | | int t15
+//      33:   | | int t16
+//      34:   | | t16.0 = t7.0
+//      35:   | | t15.0 = t6.0
+//      36:   | | int * t17
+//      37:   | | t17.0 = t8.0
+//      38:   | | t11.0 = *t8.0 * *t8.0
+//      39:   | | t10.0 = t1.2 + t11.0
+//      40:   | | t1.3 = t10.0
+//      41:   | | t4.2 = t4.1 + 1
+//      42:   | | jmp L11
+//      43:   | t2.2 = t2.1 + 1
+//      44:   | jmp L5
+//      45:   ret t1.1
+int main() {
+    int a[16];
+    int s = 0;
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            a[i * 4 + j] = i + j;
+            s = s + a[i * 4 + j] * a[4 * i + j];
+        }
+    }
+    return s;
+}
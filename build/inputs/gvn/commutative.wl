@@ -0,0 +1,31 @@
+//fun f(int t0, int t1):
+//       0:   int t2
+//       1:   int t3
+//       2:   t3.0 = t0 + t1
+//       3:   t2.0 = t3.0
+//       4:   int t4
+//       5:   int t5
+//       6:   t5.0 = t3.0
+//       7:   t4.0 = t3.0
+//       8:   int t6
+//       9:   int t7
+//      10:   t7.0 = t0 - t1
+//      11:   t6.0 = t7.0
+//      12:   int t8
+//      13:   int t9
+//      14:   t9.0 = t1 - t0
+//      15:   t8.0 = t9.0
+//      16:   int t10
+//      17:   int t11
+//      18:   t11.0 = t3.0 * t3.0
+//      19:   int t12
+//      20:   t12.0 = t7.0 * t9.0
+//      21:   t10.0 = t11.0 + t12.0
+//      22:   ret t10.0
+int f(int a, int b) {
+    int x = a + b;
+    int y = b + a;
+    int z = a - b;
+    int w = b - a;
+    return x * y + z * w;
+}
@@ -0,0 +1,34 @@
+//fun f(int t0, int t1):
+//       0:   int t2
+//       1:   t2.0 = 0
+//       2:   | int t3
+//       3:   | t3.0 = t0 < t1
+//       4:   | if t3.0 != 0 goto L6
+//       5:   | jmp L10
+//       6:   | int t4
+//       7:   | t4.0 = t0 * t1
+//       8:   | t2.2 = t4.0
+//       9:   | jmp L15
+//      10:   | int t5
+//      11:   | int t6
+//      12:   | t6.0 = t0 * t1
+//      13:   | t5.0 = t6.0 + 1
+//      14:   | t2.1 = t5.0
+//            t2.3 = φ(t2.2, t2.1)
+//      15:   int t7
+//      16:   int t8
+//      17:   t8.0 = t0 * t1
+//      18:   t7.0 = t8.0
+//      19:   int t9
+//      20:   t9.0 = t2.3 + t8.0
+//      21:   ret t9.0
+int f(int a, int b) {
+    int r = 0;
+    if (a < b) {
+        r = a * b;
+    } else {
+        r = a * b + 1;
+    }
+    int q = a * b;
+    return r + q;
+}
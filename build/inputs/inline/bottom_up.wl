@@ -0,0 +1,67 @@
+//fun inc(int t0):
+//       0:   int t1
+//       1:   t1 = t0 + 1
+//       2:   ret t1
+//fun twice(int t0):
+//       0:   int t5
+//       1:   int t6
+//       2:   int t3
+//       3:   int t4
+//       4:   int t1
+//       5:   t3 = t0
+//       6:   t4 = t3 + 1
+//       7:   t1 = t4
+//       8:   int t2
+//       9:   t5 = t1
+//      10:   t6 = t5 + 1
+//      11:   t2 = t6
+//      12:   ret t2
+//fun f(int t0):
+//       0:   int t12
+//       1:   int t13
+//       2:   int t14
+//       3:   int t15
+//       4:   int t16
+//       5:   int t17
+//       6:   int t18
+//       7:   int t5
+//       8:   int t6
+//       9:   int t7
+//      10:   int t8
+//      11:   int t9
+//      12:   int t10
+//      13:   int t11
+//      14:   int t1
+//      15:   int t2
+//      16:   t5 = t0
+//      17:   t8 = t5
+//      18:   t9 = t8 + 1
+//      19:   t10 = t9
+//      20:   t6 = t10
+//      21:   t7 = t6 + 1
+//      22:   t11 = t7
+//      23:   t2 = t11
+//      24:   int t3
+//      25:   t3 = t0 + 1
+//      26:   int t4
+//      27:   t12 = t3
+//      28:   t15 = t12
+//      29:   t16 = t15 + 1
+//      30:   t17 = t16
+//      31:   t13 = t17
+//      32:   t14 = t13 + 1
+//      33:   t18 = t14
+//      34:   t4 = t18
+//      35:   t1 = t2 + t4
+//      36:   ret t1
+int inc(int x) {
+    return x + 1;
+}
+
+int twice(int x) {
+    return inc(inc(x));
+}
+
+int f(int a) {
+    return twice(a) + twice(a + 1);
+}
@@ -0,0 +1,52 @@
+//fun dist(int t0):
+//       0:   | int t1
+//       1:   | t1 = t0 < 0
+//       2:   | if t1 != 0 goto L4
+//       3:   | jmp L7
+//       4:   | int t2
+//       5:   | t2 = 0 - t0
+//       6:   | ret t2
+//       7:   ret t0
+//fun f(int t0):
+//       0:   int t7
+//       1:   int t8
+//       2:   int t9
+//       3:   int t1
+//       4:   t1 = 0
+//       5:   int t2
+//       6:   t2 = 0
+//       7:   | int t3
+//       8:   | t3 = t2 < t0
+//       9:   | if t3 != 0 goto L11
+//      10:   | jmp L27
+//      11:   | int t4
+//      12:   | int t5
+//      13:   | t5 = t2 - 5
+//      14:   | int t6
+//      15:   | t7 = t5
+//      16:   | | t8 = t7 < 0
+//      17:   | | if t8 != 0 goto L19
+//      18:   | | jmp L22
+//      19:   | | t9 = 0 - t7
+//      20:   | t6 = t9
+//      21:   | jmp L23
+//      22:   | t6 = t7
+//      23:   | t4 = t1 + t6
+//      24:   | t1 = t4
+//      25:   | t2 = t2 + 1
+//      26:   | jmp L7
+//      27:   ret t1
+int dist(int x) {
+    if (x < 0) {
+        return 0 - x;
+    }
+    return x;
+}
+
+int f(int n) {
+    int s = 0;
+    for (int i = 0; i < n; ++i) {
+        s = s + dist(i - 5);
+    }
+    return s;
+}
@@ -0,0 +1,41 @@
+//fun fact(int t0):
+//       0:   | int t1
+//       1:   | t1 = t0 < 2
+//       2:   | if t1 != 0 goto L4
+//       3:   | jmp L5
+//       4:   | ret 1
+//       5:   int t2
+//       6:   int t3
+//       7:   t3 = t0 - 1
+//       8:   int t4
+//       9:   t4 = call fact(t3)
+//      10:   t2 = t0 * t4
+//      11:   ret t2
+//fun f():
+//       0:   int t1
+//       1:   int t2
+//       2:   int t3
+//       3:   int t4
+//       4:   int t5
+//       5:   int t0
+//       6:   t1 = 5
+//       7:   | t2 = t1 < 2
+//       8:   | if t2 != 0 goto L10
+//       9:   | jmp L12
+//      10:   t0 = 1
+//      11:   jmp L16
+//      12:   t4 = t1 - 1
+//      13:   t5 = call fact(t4)
+//      14:   t3 = t1 * t5
+//      15:   t0 = t3
+//      16:   ret t0
+int fact(int n) {
+    if (n < 2) {
+        return 1;
+    }
+    return n * fact(n - 1);
+}
+
+int f() {
+    return fact(5);
+}
@@ -0,0 +1,29 @@
+//fun main():
+//       0:   int t0[2 x 3 x 4]
+//       1:   int t1
+//       2:   t1 = 1 * 3
+//       3:   int t2
+//       4:   t2 = t1 + 2
+//       5:   int t3
+//       6:   t3 = t2 * 4
+//       7:   int t4
+//       8:   t4 = t3 + 3
+//       9:   int * t5
+//      10:   t5 = t0 + t4
+//      11:   *t5 = 5
+//      12:   int t6
+//      13:   t6 = 1 * 3
+//      14:   int t7
+//      15:   t7 = t6 + 0
+//      16:   int t8
+//      17:   t8 = t7 * 4
+//      18:   int t9
+//      19:   t9 = t8 + 2
+//      20:   int * t10
+//      21:   t10 = t0 + t9
+//      22:   ret *t10
+int main() {
+    int a[2][3][4];
+    a[1][2][3] = 5;
+    return a[1][0][2];
+}
@@ -0,0 +1,9 @@
+//fun main():
+//       0:   int t0[5]
+//       1:   int t1[1 x 2 x 3]
+//       2:   ret 0
+int main() {
+    int mem_1[5];
+    int mem_2[1][2][3];
+    return 0;
+}
\ No newline at end of file
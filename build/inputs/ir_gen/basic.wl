@@ -0,0 +1,5 @@
+//fun main():
+//       0:   ret 0
+int main() {
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,20 @@
+//fun main():
+//       0:   int t0
+//       1:   t0 = 0
+//       2:   | int t1
+//       3:   | t1 = t0
+//       4:   | t1 = t1 + 1
+//       5:   | t0 = t0 + 1
+//       6:   | int t2
+//       7:   | t2 = t0 < 10
+//       8:   | if t2 != 0 goto L2
+//       9:   ret 0
+int main() {
+    int i = 0;
+    do {
+        int j = i;
+        ++j;
+        ++i;
+    } while (i < 10);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,7 @@
+//fun main():
+//       0:   | if 1 != 0 goto L0
+//       1:   ret 0
+int main() {
+    do {} while (1);
+    return 0;
+}
\ No newline at end of file
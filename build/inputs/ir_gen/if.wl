@@ -0,0 +1,15 @@
+//fun main():
+//       0:   | int t0
+//       1:   | int t1
+//       2:   | t1 = 2 + 3
+//       3:   | t0 = 1 + t1
+//       4:   | if t0 != 0 goto L6
+//       5:   | jmp L7
+//       6:   | ret 1
+//       7:   ret 2
+int main() {
+    if (1 + 2 + 3) {
+        return 1;
+    }
+    return 2;
+}
\ No newline at end of file
@@ -0,0 +1,11 @@
+//fun main():
+//       0:   int t0
+//       1:   int t1
+//       2:   t1 = 1 * 2
+//       3:   int t2
+//       4:   t2 = 3 * 4
+//       5:   t0 = t1 + t2
+//       6:   ret t0
+int main() {
+    return 1 * 2 + 3 * 4;
+}
\ No newline at end of file
@@ -0,0 +1,8 @@
+//fun main():
+//       0:   char t0[4]
+//       1:   t0 = "abc"
+//       2:   ret 0
+int main() {
+    char *str = "abc";
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,18 @@
+//fun main():
+//       0:   int t0
+//       1:   t0 = 1
+//       2:   int t1
+//       3:   t1 = 2
+//       4:   int t2
+//       5:   t2 = 3
+//       6:   int t3
+//       7:   int t4
+//       8:   t4 = t1 + t2
+//       9:   t3 = t0 + t4
+//      10:   ret t3
+int main() {
+    int a = 1;
+    int b = 2;
+    int c = 3;
+    return a + b + c;
+}
\ No newline at end of file
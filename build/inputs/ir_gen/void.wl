@@ -0,0 +1,3 @@
+//fun f():
+//       0:   ret
+void f() {}
\ No newline at end of file
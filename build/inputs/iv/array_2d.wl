@@ -0,0 +1,43 @@
+//fun f():
+//       0:   int t9
+//       1:   int t0[10 x 20]
+//       2:   int t1
+//       3:   t1.0 = 0
+//       4:   t9.0 = t1.0 * 20
+//            | t1.1 = φ(t1.0, t1.2)
+//            | t9.1 = φ(t9.0, t9.2)
+//       5:   | int t2
+//       6:   | t2.0 = t9.1 < 200
+//       7:   | if t2.0 != 0 goto L9
+//       8:   | jmp L29
+//       9:   | int t3
+//      10:   | t3.0 = 0
+//      11:   | int t5
+//      12:   | t5.0 = t9.1
+//            | | t3.1 = φ(t3.0, t3.2)
+//      13:   | | int t4
+//      14:   | | t4.0 = t3.1 < 20
+//      15:   | | if t4.0 != 0 goto L17
+//      16:   | | jmp L26
+//      17:   | | int t6
+//      18:   | | t6.0 = t5.0 + t3.1
+//      19:   | | int * t7
+//      20:   | | t7.0 = t0 + t6.0
+//      21:   | | int t8
+//      22:   | | t8.0 = t1.1 + t3.1
+//      23:   | | *t7.0 = t8.0
+//      24:   | | t3.2 = t3.1 + 1
+//      25:   | | jmp L13
+//      26:   | t1.2 = t1.1 + 1
+//      27:   | t9.2 = t9.1 + 20
+//      28:   | jmp L5
+//      29:   ret 0
+int f() {
+    int a[10][20];
+    for (int i = 0; i < 10; ++i) {
+        for (int j = 0; j < 20; ++j) {
+            a[i][j] = i + j;
+        }
+    }
+    return 0;
+}
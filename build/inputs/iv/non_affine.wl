@@ -0,0 +1,26 @@
+//fun f(int t0):
+//       0:   int t1
+//       1:   t1.0 = 0
+//       2:   int t2
+//       3:   t2.0 = 0
+//            | t1.1 = φ(t1.0, t1.2)
+//            | t2.1 = φ(t2.0, t2.2)
+//       4:   | int t3
+//       5:   | t3.0 = t2.1 < t0
+//       6:   | if t3.0 != 0 goto L8
+//       7:   | jmp L15
+//       8:   | int t4
+//       9:   | int t5
+//      10:   | t5.0 = t2.1 * t2.1
+//      11:   | t4.0 = t1.1 + t5.0
+//      12:   | t1.2 = t4.0
+//      13:   | t2.2 = t2.1 + 1
+//      14:   | jmp L4
+//      15:   ret t1.1
+int f(int n) {
+    int s = 0;
+    for (int i = 0; i < n; ++i) {
+        s = s + i * i;
+    }
+    return s;
+}
@@ -0,0 +1,60 @@
+//fun f(int t0):
+//       0:   int t17
+//       1:   int t16
+//       2:   int t15
+//       3:   int t1
+//       4:   t1.0 = 0
+//       5:   int t2
+//       6:   t2.0 = 0
+//       7:   t15.0 = t2.0 * 3
+//       8:   t16.0 = t2.0 * 3
+//       9:   t16.1 = t16.0 + 3
+//      10:   t17.0 = t0 * 3
+//            | t1.1 = φ(t1.0, t1.2)
+//            | t2.1 = φ(t2.0, t2.2)
+//            | t15.1 = φ(t15.0, t15.2)
+//            | t16.2 = φ(t16.1, t16.3)
+//      11:   | int t3
+//      12:   | t3.0 = t15.1 < t17.0
+//      13:   | if t3.0 != 0 goto L15
+//      14:   | jmp L42
+//      15:   | int t4
+//      16:   | int t5
+//      17:   | t5.0 = t15.1
+//      18:   | t4.0 = t5.0
+//      19:   | int t6
+//      20:   | int t7
+//      21:   | int t8
+//      22:   | t8.0 = t2.1 + 1
+//      23:   | t7.0 = t16.2
+//      24:   | t6.0 = t7.0
+//      25:   | int t9
+//      26:   | int t10
+//      27:   | t10.0 = t15.1
+//      28:   | t9.0 = t10.0
+//      29:   | int t11
+//      30:   | int t12
+//      31:   | int t13
+//      32:   | t13.0 = t6.0 + t9.0
+//      33:   | t12.0 = t4.0 + t13.0
+//      34:   | t11.0 = t1.1 + t12.0
+//      35:   | t1.2 = t11.0
+//      36:   | int t14
+//      37:   | t14.0 = t2.1 + 2
+//      38:   | t16.3 = t16.2 + 6
+//      39:   | t15.2 = t15.1 + 6
+//      40:   | t2.2 = t14.0
+//      41:   | jmp L11
+//      42:   ret t1.1
+int f(int n) {
+    int s = 0;
+    int i = 0;
+    while (i < n) {
+        int x = i * 3;
+        int y = (i + 1) * 3;
+        int z = 3 * i;
+        s = s + x + y + z;
+        i = i + 2;
+    }
+    return s;
+}
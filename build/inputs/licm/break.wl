@@ -0,0 +1,38 @@
+//fun f(int t0, int t1):
+//       0:   int t2
+//       1:   t2.0 = 0
+//       2:   int t3
+//       3:   t3.0 = 0
+//       4:   int t7
+//       5:   t7.0 = t1 * t1
+//            | t2.1 = φ(t2.0, t2.2)
+//            | t3.1 = φ(t3.0, t3.2)
+//       6:   | int t4
+//       7:   | t4.0 = t3.1 < t0
+//       8:   | if t4.0 != 0 goto L10
+//       9:   | jmp L22
+//      10:   | | int t5
+//      11:   | | t5.0 = t2.1 > 100
+//      12:   | | if t5.0 != 0 goto L14
+//      13:   | | jmp L15
+//      14:   | | jmp L22
+//      15:   | int t6
+//      16:   | t6.0 = t2.1 + t7.0
+//      17:   | t2.2 = t6.0
+//      18:   | int t8
+//      19:   | t8.0 = t3.1 + 1
+//      20:   | t3.2 = t8.0
+//      21:   | jmp L6
+//      22:   ret t2.1
+int f(int n, int a) {
+    int s = 0;
+    int i = 0;
+    while (i < n) {
+        if (s > 100) {
+            break;
+        }
+        s = s + a * a;
+        i = i + 1;
+    }
+    return s;
+}
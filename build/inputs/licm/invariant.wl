@@ -0,0 +1,30 @@
+//fun f(int t0, int t1):
+//       0:   int t2
+//       1:   t2.0 = 0
+//       2:   int t3
+//       3:   t3.0 = 0
+//       4:   int t6
+//       5:   t6.0 = t1 * 4
+//            | t2.1 = φ(t2.0, t2.2)
+//            | t3.1 = φ(t3.0, t3.2)
+//       6:   | int t4
+//       7:   | t4.0 = t3.1 < t0
+//       8:   | if t4.0 != 0 goto L10
+//       9:   | jmp L17
+//      10:   | int t5
+//      11:   | t5.0 = t2.1 + t6.0
+//      12:   | t2.2 = t5.0
+//      13:   | int t7
+//      14:   | t7.0 = t3.1 + 1
+//      15:   | t3.2 = t7.0
+//      16:   | jmp L6
+//      17:   ret t2.1
+int f(int n, int k) {
+    int s = 0;
+    int i = 0;
+    while (i < n) {
+        s = s + k * 4;
+        i = i + 1;
+    }
+    return s;
+}
@@ -0,0 +1,44 @@
+//fun f(int t0, int t1, int t2):
+//       0:   int t3
+//       1:   t3.0 = 0
+//       2:   int t4
+//       3:   t4.0 = 0
+//       4:   int t11
+//       5:   t11.0 = t1 + t2
+//       6:   int t10
+//       7:   t10.0 = t11.0 * 2
+//            | t3.1 = φ(t3.0, t3.2)
+//            | t4.1 = φ(t4.0, t4.2)
+//       8:   | int t5
+//       9:   | t5.0 = t4.1 < t0
+//      10:   | if t5.0 != 0 goto L12
+//      11:   | jmp L29
+//      12:   | int t6
+//      13:   | t6.0 = 0
+//      14:   | int t12
+//      15:   | t12.0 = t4.1 * 3
+//      16:   | int t9
+//      17:   | t9.0 = t10.0 + t12.0
+//            | | t3.2 = φ(t3.1, t3.3)
+//            | | t6.1 = φ(t6.0, t6.2)
+//      18:   | | int t7
+//      19:   | | t7.0 = t6.1 < t0
+//      20:   | | if t7.0 != 0 goto L22
+//      21:   | | jmp L27
+//      22:   | | int t8
+//      23:   | | t8.0 = t3.2 + t9.0
+//      24:   | | t3.3 = t8.0
+//      25:   | | t6.2 = t6.1 + 1
+//      26:   | | jmp L18
+//      27:   | t4.2 = t4.1 + 1
+//      28:   | jmp L8
+//      29:   ret t3.1
+int f(int n, int a, int b) {
+    int s = 0;
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            s = s + (a + b) * 2 + i * 3;
+        }
+    }
+    return s;
+}
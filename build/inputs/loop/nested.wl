@@ -0,0 +1,52 @@
+//fun main():
+//       0:   int t0
+//       1:   t0 = 0
+//       2:   int t1
+//       3:   t1 = 0
+//       4:   | int t2
+//       5:   | t2 = t1 < 10
+//       6:   | if t2 != 0 goto L8
+//       7:   | jmp L31
+//       8:   | int t3
+//       9:   | t3 = 0
+//      10:   | | int t4
+//      11:   | | t4 = t3 < 10
+//      12:   | | if t4 != 0 goto L14
+//      13:   | | jmp L21
+//      14:   | | int t5
+//      15:   | | int t6
+//      16:   | | t6 = t1 * t3
+//      17:   | | t5 = t0 + t6
+//      18:   | | t0 = t5
+//      19:   | | t3 = t3 + 1
+//      20:   | | jmp L10
+//      21:   | | int t7
+//      22:   | | t7 = t0 > 100
+//      23:   | | if t7 != 0 goto L25
+//      24:   | | jmp L29
+//      25:   | | int t8
+//      26:   | | t8 = t0 - 100
+//      27:   | | t0 = t8
+//      28:   | | jmp L21
+//      29:   | t1 = t1 + 1
+//      30:   | jmp L4
+//      31:   ret t0
+//--------
+//loop 4: depth 1, preheader 3
+// latches (30) exits (7) body (4, 5, 6, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30)
+//  loop 10: depth 2, preheader 9
+//   latches (20) exits (13) body (10, 11, 12, 14, 15, 16, 17, 18, 19, 20)
+//  loop 21: depth 2, preheader 13
+//   latches (28) exits (24) body (21, 22, 23, 25, 26, 27, 28)
+int main() {
+    int s = 0;
+    for (int i = 0; i < 10; ++i) {
+        for (int j = 0; j < 10; ++j) {
+            s = s + i * j;
+        }
+        while (s > 100) {
+            s = s - 100;
+        }
+    }
+    return s;
+}
@@ -0,0 +1,14 @@
+//fun f(int t0):
+//       0:   | int t1
+//       1:   | t1 = t0 < 0
+//       2:   | if t1 != 0 goto L4
+//       3:   | jmp L5
+//       4:   | ret 0
+//       5:   ret t0
+//--------
+int f(int a) {
+    if (a < 0) {
+        return 0;
+    }
+    return a;
+}
@@ -0,0 +1,63 @@
+//81
+/* Too big to be inlined. */
+int f(int a)
+{
+    int x0 = a + 0;
+    int x1 = a + 1;
+    int x2 = a + 2;
+    int x3 = a + 3;
+    int x4 = a + 4;
+    int x5 = a + 5;
+    int x6 = a + 6;
+    int x7 = a + 7;
+    int x8 = a + 8;
+    int x9 = a + 9;
+    int x10 = a + 10;
+    int x11 = a + 11;
+    int x12 = a + 12;
+    int x13 = a + 13;
+    int x14 = a + 14;
+    int x15 = a + 15;
+    int x16 = a + 16;
+    int x17 = a + 17;
+    int x18 = a + 18;
+    int x19 = a + 19;
+    int x20 = a + 20;
+    int x21 = a + 21;
+    int x22 = a + 22;
+    int x23 = a + 23;
+    int x24 = a + 24;
+    int x25 = a + 25;
+    int x26 = a + 26;
+    int x27 = a + 27;
+    int x28 = a + 28;
+    int x29 = a + 29;
+    int x30 = a + 30;
+    int x31 = a + 31;
+    int x32 = a + 32;
+    int x33 = a + 33;
+    int x34 = a + 34;
+    int x35 = a + 35;
+    int x36 = a + 36;
+    int x37 = a + 37;
+    int x38 = a + 38;
+    int x39 = a + 39;
+    int x40 = a + 40;
+    int x41 = a + 41;
+    int x42 = a + 42;
+    int x43 = a + 43;
+    int x44 = a + 44;
+    int x45 = a + 45;
+    int x46 = a + 46;
+    int x47 = a + 47;
+    int x48 = a + 48;
+    int x49 = a + 49;
+    return (x49 - x10) + a;
+}
+
+int main()
+{
+    int r1 = f(1);
+    int r2 = f(2);
+    return r1 + r2;
+}
@@ -0,0 +1,16 @@
+//5
+int g()
+{
+    int a = 1;
+    int b = 2;
+    int c = a + b;
+    int d = c * a;
+    int e = d - b;
+    return 0;
+}
+
+int main()
+{
+    g();
+    return 5;
+}
@@ -0,0 +1,35 @@
+//122
+int main() {
+    int m[6][7];
+    int t[7][6];
+    int c[3][4][5];
+    for (int i = 0; i < 6; ++i) {
+        for (int j = 0; j < 7; ++j) {
+            m[i][j] = (i * 10) + j;
+        }
+    }
+    for (int i = 0; i < 6; ++i) {
+        for (int j = 0; j < 7; ++j) {
+            t[j][i] = m[i][j];
+        }
+    }
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            for (int k = 0; k < 5; ++k) {
+                c[i][j][k] = (i * j) + (k * 2);
+            }
+        }
+    }
+    int sum = 0;
+    for (int j = 0; j < 7; ++j) {
+        for (int i = 0; i < 6; ++i) {
+            sum = sum + (t[j][i] * (((i + j) % 3) + 1));
+        }
+    }
+    for (int i = 1; i < 3; ++i) {
+        for (int k = 0; k < 5; ++k) {
+            sum = sum + (c[i][i + 1][k] * c[i - 1][3 - i][4 - k]);
+        }
+    }
+    return sum % 256;
+}
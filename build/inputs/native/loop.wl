@@ -0,0 +1,10 @@
+//51
+int main() {
+    int count = 0;
+    for (int i = 0; i < 20; ++i) {
+        if (i % 3 == 0 || i / 7 >= 2) {
+            count = count + i;
+        }
+    }
+    return count / 3 + 8;
+}
@@ -0,0 +1,93 @@
+//27
+int main() {
+    int acc = 1;
+    int v1 = acc % 1000;
+    v1 = (v1 + ((acc / 8) | (acc << 1))) % 1000;
+    v1 = (v1 + (((35 << 0) % 19) / 18)) % 1000;
+    int v2 = (((acc << 3) | (14 | acc)) % 14) % 1000;
+    int v3 = (((v2 / 19) * v2) - (1 / 13)) % 1000;
+    int v4 = v2 % 1000;
+    if (v3 <= ((v3 - 10) * (v2 * 31))) {
+        if (((acc & v1) - (acc ^ v3)) <= ((v4 | 31) - v3)) {
+            v2 = (((v3 | v2) | v4) - ((v2 ^ 22) - (v4 + v1))) % 1000;
+            v2 = (((v1 << 3) | (v3 + 11)) << 1) % 1000;
+            v3 = (((acc << 2) ^ (v4 + v3)) / 7) % 1000;
+        } else {
+            v1 = (v1 + (((acc ^ v3) | (17 & 33)) & v2)) % 1000;
+            v4 = (v2 & ((v4 << 2) / 24)) % 1000;
+            for (int i5 = 0; i5 < 1; ++i5) {
+                if ((v3 / 13) < (15 * (acc << 1))) {
+                    v1 = (v1 + (v3 * (i5 & (33 & i5)))) % 1000;
+                    v1 = (v1 + (v4 + ((v1 & v1) + v1))) % 1000;
+                    if (((v4 + 20) ^ (9 / 19)) <= (20 << 0)) {
+                        v4 = (v4 + (30 | v4)) % 1000;
+                        v4 = (v4 + (((4 << 0) - v3) / 1)) % 1000;
+                    }
+                    v3 = v3 % 1000;
+                }
+                if (((12 / 23) * (4 * v4)) != ((v2 - 32) / 19)) {
+                    if (((v4 - 14) | v3) <= (i5 | (22 ^ 14))) {
+                        v3 = ((v1 ^ 28) * ((v2 + v4) % 11)) % 1000;
+                        v2 = (acc & (33 % 2)) % 1000;
+                        v3 = i5 % 1000;
+                    } else {
+                        v2 = (v2 + ((v1 % 16) << 2)) % 1000;
+                        v3 = (v4 / 24) % 1000;
+                        v4 = v4 % 1000;
+                    }
+                    v3 = acc % 1000;
+                    v3 = (v3 + ((acc * (v4 & 14)) + v4)) % 1000;
+                } else {
+                    v1 = (((49 % 10) & (v2 + 47)) - ((50 - i5) * (v3 % 22))) % 1000;
+                    v3 = ((v4 << 2) | acc) % 1000;
+                    v2 = v4 % 1000;
+                }
+                v1 = (v1 + (5 % 20)) % 1000;
+                v2 = (v2 + v2) % 1000;
+            }
+        }
+        if ((v3 & (14 << 1)) > v4) {
+            for (int i6 = 0; i6 < 3; ++i6) {
+                if (v3 < i6) {
+                    v3 = (v3 + i6) % 1000;
+                }
+                if ((20 - v3) < (v1 ^ v4)) {
+                    v2 = (v2 + (36 % 19)) % 1000;
+                    v3 = ((v2 | (5 / 13)) << 2) % 1000;
+                    v4 = (v4 + (((acc * i6) & (v2 | acc)) * ((v2 - v3) - (acc / 7)))) % 1000;
+                }
+                if (i6 < ((acc | acc) % 23)) {
+                    v1 = (v1 + v1) % 1000;
+                } else {
+                    v3 = (v3 + ((v1 - (v2 ^ v1)) / 3)) % 1000;
+                    if (((13 % 23) & v3) != ((20 / 24) | (49 * 12))) {
+                        v3 = (v3 + (((i6 & acc) << 1) | ((v2 / 1) | v2))) % 1000;
+                        v2 = (23 * ((acc / 10) << 1)) % 1000;
+                        v3 = (v3 + (v3 | acc)) % 1000;
+                    } else {
+                        v1 = (v1 + ((v2 << 1) & i6)) % 1000;
+                        v1 = (v4 << 1) % 1000;
+                    }
+                }
+            }
+            v3 = (v3 + 44) % 1000;
+        } else {
+            v3 = (v3 + v1) % 1000;
+        }
+    }
+    if (v2 < ((10 + 6) & (v3 + 18))) {
+        for (int i7 = 0; i7 < 1; ++i7) {
+            v2 = (v2 + ((v4 << 3) + ((v3 - v4) - (v2 & v4)))) % 1000;
+        }
+    }
+    for (int i8 = 0; i8 < 5; ++i8) {
+        for (int i9 = 0; i9 < 3; ++i9) {
+            v4 = (v4 + (((v3 << 1) / 3) % 24)) % 1000;
+            for (int i10 = 0; i10 < 4; ++i10) {
+                v4 = v4 % 1000;
+            }
+        }
+        v2 = (v2 + (((acc | 45) % 5) ^ ((i8 + v3) + acc))) % 1000;
+    }
+    return (acc + v1 + v2 + v3 + v4) % 1000;
+}
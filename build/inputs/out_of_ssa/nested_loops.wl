@@ -0,0 +1,46 @@
+//fun main():
+//       0:   int t0
+//       1:   t0 = 0
+//       2:   int t1
+//       3:   t1 = 0
+//       4:   | int t2
+//       5:   | t2 = t1 < 10
+//       6:   | if t2 != 0 goto L8
+//       7:   | jmp L31
+//       8:   | int t3
+//       9:   | t3 = 0
+//      10:   | | int t4
+//      11:   | | t4 = t3 < t1
+//      12:   | | if t4 != 0 goto L14
+//      13:   | | jmp L29
+//      14:   | | | int t5
+//      15:   | | | int t6
+//      16:   | | | t6 = t3 % 2
+//      17:   | | | t5 = t6 == 0
+//      18:   | | | if t5 != 0 goto L20
+//      19:   | | | jmp L24
+//      20:   | | | int t7
+//      21:   | | | t7 = t0 + t3
+//      22:   | | | t0 = t7
+//      23:   | | | jmp L27
+//      24:   | | | int t8
+//      25:   | | | t8 = t0 - 1
+//      26:   | | | t0 = t8
+//      27:   | | t3 = t3 + 1
+//      28:   | | jmp L10
+//      29:   | t1 = t1 + 1
+//      30:   | jmp L4
+//      31:   ret t0
+int main() {
+    int s = 0;
+    for (int i = 0; i < 10; ++i) {
+        for (int j = 0; j < i; ++j) {
+            if (j % 2 == 0) {
+                s = s + j;
+            } else {
+                s = s - 1;
+            }
+        }
+    }
+    return s;
+}
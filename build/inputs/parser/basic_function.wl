@@ -0,0 +1,15 @@
+//CompoundStmt <line:0, col:0>
+//  FunctionDecl <line:13, col:1>
+//    FunctionDeclRetType <line:13, col:1> int
+//    FunctionDeclName <line:13, col:1> `main`
+//    FunctionDeclArgs <line:13, col:1>
+//      CompoundStmt <line:13, col:29>
+//        VarDecl <line:13, col:10> int `argc`
+//        VarDecl <line:13, col:20> char `argv`
+//    FunctionDeclBody <line:13, col:1>
+//      CompoundStmt <line:13, col:31>
+//        ReturnStmt <line:14, col:3>
+//          Number <line:14, col:10> 0
+int main(int argc, char argv) {
+  return 0;
+}
@@ -0,0 +1,63 @@
+//CompoundStmt <line:0, col:0>
+//  FunctionDecl <line:49, col:1>
+//    FunctionDeclRetType <line:49, col:1> void
+//    FunctionDeclName <line:49, col:1> `f`
+//    FunctionDeclArgs <line:49, col:1>
+//    FunctionDeclBody <line:49, col:1>
+//      CompoundStmt <line:49, col:10>
+//        CompoundStmt <line:50, col:5>
+//          CompoundStmt <line:50, col:6>
+//            CompoundStmt <line:50, col:7>
+//              CompoundStmt <line:50, col:8>
+//                CompoundStmt <line:50, col:9>
+//                  CompoundStmt <line:50, col:10>
+//                    CompoundStmt <line:50, col:11>
+//                      CompoundStmt <line:50, col:12>
+//                        CompoundStmt <line:50, col:13>
+//                          CompoundStmt <line:50, col:14>
+//                            CompoundStmt <line:50, col:15>
+//                              CompoundStmt <line:50, col:16>
+//                                CompoundStmt <line:50, col:17>
+//                                  CompoundStmt <line:50, col:18>
+//                                    CompoundStmt <line:50, col:19>
+//                                      CompoundStmt <line:50, col:20>
+//                                        CompoundStmt <line:50, col:21>
+//                                          CompoundStmt <line:50, col:22>
+//                                            CompoundStmt <line:50, col:23>
+//                                              CompoundStmt <line:50, col:24>
+//                                                CompoundStmt <line:50, col:25>
+//                                                  CompoundStmt <line:50, col:26>
+//                                                    CompoundStmt <line:50, col:27>
+//                                                      CompoundStmt <line:51, col:9>
+//                                                        CompoundStmt <line:51, col:10>
+//                                                          CompoundStmt <line:51, col:11>
+//                                                            CompoundStmt <line:51, col:12>
+//                                                              CompoundStmt <line:51, col:13>
+//                                                                CompoundStmt <line:51, col:14>
+//                                                                  CompoundStmt <line:51, col:15>
+//                                                                    CompoundStmt <line:51, col:16>
+//                                                                      CompoundStmt <line:51, col:17>
+//                            CompoundStmt <line:55, col:5>
+//                            CompoundStmt <line:56, col:5>
+//                            CompoundStmt <line:57, col:5>
+//                              CompoundStmt <line:58, col:9>
+//                                CompoundStmt <line:59, col:13>
+//                                  CompoundStmt <line:59, col:14>
+//                                    CompoundStmt <line:59, col:15>
+//                                      CompoundStmt <line:59, col:16>
+//                                        CompoundStmt <line:59, col:17>
+void f() {
+    {{{{{{{{{{{{{{{{{{{{{{{
+        {{{{{{{{{
+
+        }}}}}}}}}
+    }}}}}}}}}}}}}
+    {}
+    {}
+    {
+        {
+            {{{{{}}}}}
+        }
+    }
+    }}}}}}}}}}
+}
\ No newline at end of file
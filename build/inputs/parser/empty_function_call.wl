@@ -0,0 +1,12 @@
+//CompoundStmt <line:0, col:0>
+//  FunctionDecl <line:10, col:1>
+//    FunctionDeclRetType <line:10, col:1> void
+//    FunctionDeclName <line:10, col:1> `f`
+//    FunctionDeclArgs <line:10, col:1>
+//    FunctionDeclBody <line:10, col:1>
+//      CompoundStmt <line:10, col:10>
+//        FunctionCall <line:11, col:3> `empty_function_call`
+//          FunctionCallArgs <line:11, col:3>
+void f() {
+  empty_function_call();
+}
\ No newline at end of file
@@ -0,0 +1,6 @@
+//CompoundStmt <line:0, col:0>
+//  FunctionProtoDecl <line:6, col:1>
+//    FunctionProtoRetType <line:6, col:1> void
+//    FunctionProtoName <line:6, col:1> `f`
+//    FunctionProtoArgs <line:6, col:1>
+void f();
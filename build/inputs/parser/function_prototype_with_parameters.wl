@@ -0,0 +1,11 @@
+//CompoundStmt <line:0, col:0>
+//  FunctionProtoDecl <line:11, col:1>
+//    FunctionProtoRetType <line:11, col:1> void
+//    FunctionProtoName <line:11, col:1> `f`
+//    FunctionProtoArgs <line:11, col:1>
+//      CompoundStmt <line:11, col:49>
+//        VarDecl <line:11, col:8> int `arg1`
+//        VarDecl <line:11, col:18> int `arg2`
+//        VarDecl <line:11, col:28> float `arg3`
+//        VarDecl <line:11, col:40> char `arg4`
+void f(int arg1, int arg2, float arg3, char arg4);
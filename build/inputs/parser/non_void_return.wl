@@ -0,0 +1,12 @@
+//CompoundStmt <line:0, col:0>
+//  FunctionDecl <line:10, col:1>
+//    FunctionDeclRetType <line:10, col:1> float
+//    FunctionDeclName <line:10, col:1> `f`
+//    FunctionDeclArgs <line:10, col:1>
+//    FunctionDeclBody <line:10, col:1>
+//      CompoundStmt <line:10, col:11>
+//        ReturnStmt <line:11, col:3>
+//          FloatLiteral <line:11, col:10> 0.000000
+float f() {
+  return 0.0;
+}
@@ -0,0 +1,11 @@
+//CompoundStmt <line:0, col:0>
+//  FunctionDecl <line:9, col:1>
+//    FunctionDeclRetType <line:9, col:1> void
+//    FunctionDeclName <line:9, col:1> `f`
+//    FunctionDeclArgs <line:9, col:1>
+//    FunctionDeclBody <line:9, col:1>
+//      CompoundStmt <line:9, col:10>
+//        ReturnStmt <line:10, col:3>
+void f() {
+  return;
+}
\ No newline at end of file
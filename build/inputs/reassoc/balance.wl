@@ -0,0 +1,27 @@
+//fun main(int t0, int t1, int t2, int t3):
+//       0:   int t4
+//       1:   int t5
+//       2:   t5.0 = t0 * t1
+//       3:   t4.0 = t5.0
+//       4:   int t6
+//       5:   int t7
+//       6:   t7.0 = t2 * t3
+//       7:   t6.0 = t7.0
+//       8:   int t8
+//       9:   int t9
+//      10:   int t10
+//      11:   int t11
+//      12:   int t12
+//      13:   int t13
+//      14:   t9.0 = t0 + 7
+//      15:   t10.0 = t1 + t2
+//      16:   t11.0 = t3 + t4.0
+//      17:   t12.0 = t9.0 + t10.0
+//      18:   t13.0 = t11.0 + t6.0
+//      19:   t8.0 = t12.0 + t13.0
+//      20:   ret t8.0
+int main(int a, int b, int c, int d) {
+    int e = a * b;
+    int f = c * d;
+    return a + b + c + d + e + f + 7;
+}
@@ -0,0 +1,10 @@
+//fun main(int t0, int t1):
+//       0:   int t2
+//       1:   int t3
+//       2:   int t4
+//       3:   t3.0 = t0 + 3
+//       4:   t2.0 = t3.0 + t1
+//       5:   ret t2.0
+int main(int a, int b) {
+    return a + 1 + b + 2;
+}
@@ -0,0 +1,29 @@
+//fun main():
+//       0:   int #reg0
+//       1:   int #reg1
+//       2:   int #reg1
+//       3:   int #reg0
+//       4:   int #reg2
+//       5:   int #reg1
+//       6:   int #reg0
+//       7:   int #reg0
+//       8:   int #reg0
+//       9:   int #reg3
+//      10:   #reg0 = 0
+//      11:   #reg3 = 1
+//      12:   #reg1 = #reg0 + #reg3
+//      13:   #reg2 = 9
+//      14:   #reg1 = 8
+//      15:   #reg0 = #reg0 + #reg3
+//      16:   #reg0 = #reg2 + #reg0
+//      17:   #reg0 = #reg1 + #reg0
+//      18:   ret #reg0
+int main() {
+	int a = 0;
+	int b = 1;
+	int c = a + b;
+	int d = a;
+	int e = 9;
+	int f = 8;
+	return f + e + a + b;
+}
\ No newline at end of file
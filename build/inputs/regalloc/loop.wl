@@ -0,0 +1,33 @@
+//fun main():
+//       0:   int #reg2
+//       1:   int #reg1
+//       2:   int #reg0
+//       3:   int #reg0
+//       4:   int #reg0
+//       5:   int #reg0
+//       6:   int #reg0
+//       7:   int #reg0
+//       8:   #reg2 = 0
+//       9:   #reg0 = 0
+//      10:   | #reg1 = #reg0 >= #reg2
+//      11:   | if #reg1 != 0 goto L13
+//      12:   | jmp L19
+//      13:   | #reg0 = 32 << 2
+//      14:   | #reg0 = 23 & #reg0
+//      15:   | #reg0 = #reg2 & #reg0
+//      16:   | #reg0 = #reg0 | 5
+//      17:   | #reg2 = #reg2 - 1
+//      18:   | jmp L10
+//      19:   #reg0 = #reg2 + #reg0
+//      20:   ret #reg0
+int main() {
+	int a = 0;
+	int b = 0;
+
+	while (b >= a) {
+		b = (a & 23 & 32 << 2) | 5;
+		--a;
+	}
+
+	return a + b;
+}
\ No newline at end of file
@@ -0,0 +1,74 @@
+//fun main():
+//       0:   int #reg0
+//       1:   int #reg0
+//       2:   int #reg2
+//       3:   int #reg0
+//       4:   int #reg0
+//       5:   int #reg1
+//       6:   int #reg0
+//       7:   int #reg0
+//       8:   int t0
+//       9:   int #reg0
+//      10:   int t3
+//      11:   int #reg0
+//      12:   int #reg5
+//      13:   int #reg4
+//      14:   int #reg3
+//      15:   int #reg2
+//      16:   int #reg1
+//      17:   int #reg0
+//      18:   int #reg6
+//      19:   int #reg1
+//      20:   int #reg6
+//      21:   int #reg7
+//      22:   int #reg6
+//      23:   int #reg0
+//      24:   int #reg0
+//      25:   int #reg0
+//      26:   int #reg2
+//      27:   int t1
+//      28:   #reg0 = 3
+//      29:   #reg0 = #reg0 * #reg0
+//      30:   t1 = #reg0
+//      31:   #reg1 = t1
+//      32:   #reg0 = 3
+//      33:   #reg0 = #reg1 - #reg0
+//      34:   t3 = #reg0
+//      35:   #reg5 = 1
+//      36:   #reg4 = 2
+//      37:   #reg3 = 3
+//      38:   #reg2 = 4
+//      39:   #reg1 = 0
+//      40:   #reg0 = 0
+//      41:   | #reg6 = #reg0 < 10
+//      42:   | if #reg6 != 0 goto L44
+//      43:   | jmp L50
+//      44:   | #reg7 = #reg5 * #reg4
+//      45:   | #reg6 = #reg3 * #reg2
+//      46:   | #reg6 = #reg7 - #reg6
+//      47:   | #reg1 = #reg1 + #reg6
+//      48:   | #reg0 = #reg0 + 1
+//      49:   | jmp L41
+//      50:   #reg2 = t1
+//      51:   #reg0 = t3
+//      52:   #reg2 = #reg2 + #reg0
+//      53:   #reg0 = 3
+//      54:   #reg0 = #reg0 + #reg2
+//      55:   #reg0 = #reg1 + #reg0
+//      56:   ret #reg0
+int main() {
+    int x = 3;
+    int y = x * x;
+    int z = y - x;
+    int a = 1;
+    int b = 2;
+    int c = 3;
+    int d = 4;
+    int s = 0;
+    int i = 0;
+    while (i < 10) {
+        s = s + a * b - c * d;
+        i = i + 1;
+    }
+    return s + x + y + z;
+}
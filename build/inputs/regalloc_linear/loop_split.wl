@@ -0,0 +1,71 @@
+//fun main():
+//       0:   int #reg0
+//       1:   int #reg1
+//       2:   int #reg3
+//       3:   int #reg1
+//       4:   int #reg1
+//       5:   int #reg0
+//       6:   int #reg3
+//       7:   int #reg2
+//       8:   int t9
+//       9:   int t10
+//      10:   int #reg2
+//      11:   int #reg2
+//      12:   int #reg0
+//      13:   int #reg2
+//      14:   int #reg3
+//      15:   int #reg0
+//      16:   int #reg0
+//      17:   int #reg1
+//      18:   int #reg0
+//      19:   int #reg2
+//      20:   #reg0 = 3
+//      21:   #reg1 = #reg0 * #reg0
+//      22:   #reg2 = #reg1
+//      23:   #reg1 = #reg2 - #reg0
+//      24:   #reg3 = #reg1
+//      25:   #reg1 = 1
+//      26:   t0 = #reg0
+//      27:   #reg0 = 2
+//      28:   t3 = #reg3
+//      29:   #reg3 = 3
+//      30:   t1 = #reg2
+//      31:   #reg2 = 4
+//      32:   t9 = 0
+//      33:   t10 = 0
+//      34:   t8 = #reg2
+//      35:   | #reg2 = t10 < 10
+//      36:   | if #reg2 != 0 goto L38
+//      37:   | jmp L50
+//      38:   | #reg2 = #reg1 * #reg0
+//      39:   | t7 = #reg3
+//      40:   | #reg3 = t7 * t8
+//      41:   | t6 = #reg0
+//      42:   | #reg0 = #reg2 - #reg3
+//      43:   | #reg2 = t9 + #reg0
+//      44:   | t9 = #reg2
+//      45:   | #reg0 = t10 + 1
+//      46:   | t10 = #reg0
+//      47:   | #reg0 = t6
+//      48:   | #reg3 = t7
+//      49:   | jmp L35
+//      50:   #reg0 = t1 + t3
+//      51:   #reg1 = t0 + #reg0
+//      52:   #reg0 = t9 + #reg1
+//      53:   ret #reg0
+int main() {
+    int x = 3;
+    int y = x * x;
+    int z = y - x;
+    int a = 1;
+    int b = 2;
+    int c = 3;
+    int d = 4;
+    int s = 0;
+    int i = 0;
+    while (i < 10) {
+        s = s + a * b - c * d;
+        i = i + 1;
+    }
+    return s + x + y + z;
+}
@@ -0,0 +1,68 @@
+//fun main():
+//       0:   int #reg0
+//       1:   int #reg2
+//       2:   int #reg3
+//       3:   int #reg1
+//       4:   int #reg0
+//       5:   int t6
+//       6:   int t7
+//       7:   int t8
+//       8:   int t9
+//       9:   int #reg0
+//      10:   int #reg1
+//      11:   int #reg0
+//      12:   int t13
+//      13:   int #reg1
+//      14:   int #reg2
+//      15:   int #reg1
+//      16:   int #reg3
+//      17:   int #reg1
+//      18:   int #reg2
+//      19:   int #reg3
+//      20:   int #reg2
+//      21:   int #reg2
+//      22:   int #reg1
+//      23:   #reg0 = 1
+//      24:   #reg1 = 2
+//      25:   #reg2 = 3
+//      26:   #reg3 = 4
+//      27:   t1 = #reg1
+//      28:   #reg1 = 5
+//      29:   t0 = #reg0
+//      30:   #reg0 = 6
+//      31:   t6 = 7
+//      32:   t7 = 8
+//      33:   t8 = 9
+//      34:   t9 = 10
+//      35:   t13 = t1 * #reg2
+//      36:   #reg2 = #reg3 / #reg1
+//      37:   #reg1 = #reg2 + #reg0
+//      38:   #reg0 = t13 - #reg1
+//      39:   #reg1 = t0 + #reg0
+//      40:   #reg0 = #reg1
+//      41:   #reg1 = t6 * t7
+//      42:   #reg2 = t9 * t0
+//      43:   #reg3 = #reg2 - t1
+//      44:   #reg2 = t8 + #reg3
+//      45:   #reg3 = #reg1 - #reg2
+//      46:   #reg1 = #reg3
+//      47:   #reg2 = #reg0 + #reg1
+//      48:   ret #reg2
+int main() {
+    int a = 1;
+    int b = 2;
+    int c = 3;
+    int d = 4;
+    int e = 5;
+    int f = 6;
+    int g = 7;
+    int h = 8;
+    int i = 9;
+    int j = 10;
+
+    // Perform a complex series of operations to ensure spill
+    int result1 = a + b * c - d / e + f;
+    int result2 = g * h - i + j * a - b;
+
+    return result1 + result2;
+}
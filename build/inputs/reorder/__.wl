@@ -0,0 +1,13 @@
+//fun main():
+//       0:   int t0
+//       1:   int t1
+//       3:   int t3
+//       2:   int t2
+//       4:   t3 = 4 + 5
+//       5:   t2 = 3 + t3
+//       6:   t1 = 2 + t2
+//       7:   t0 = 1 + t1
+//       8:   ret t0
+int main() {
+    return 1 + 2 + 3 + 4 + 5;
+}
\ No newline at end of file
@@ -0,0 +1,19 @@
+//fun main(int t0):
+//       0:   int t1
+//       1:   t1 = t0
+//       2:   | int t2
+//       3:   | t2 = t1 + 1
+//       4:   | t1 = t2
+//       5:   ret t1
+int main(int x) {
+    int r = x;
+    if (1) {
+        r = r + 1;
+    } else {
+        r = r + 2;
+    }
+    while (0) {
+        r = r * 2;
+    }
+    return r;
+}
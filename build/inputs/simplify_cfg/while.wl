@@ -0,0 +1,27 @@
+//fun main(int t0):
+//       0:   int t1
+//       1:   t1 = 0
+//       2:   | int t2
+//       3:   | t2 = t1 < t0
+//       4:   | if t2 == 0 goto L9
+//       5:   | int t3
+//       6:   | t3 = t1 + 2
+//       7:   | t1 = t3
+//       8:   | jmp L2
+//       9:   | int t4
+//      10:   | t4 = t1 - 1
+//      11:   | t1 = t4
+//      12:   | int t5
+//      13:   | t5 = t1 > t0
+//      14:   | if t5 != 0 goto L9
+//      15:   ret t1
+int main(int n) {
+    int i = 0;
+    while (i < n) {
+        i = i + 2;
+    }
+    do {
+        i = i - 1;
+    } while (i > n);
+    return i;
+}
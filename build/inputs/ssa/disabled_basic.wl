@@ -0,0 +1,13 @@
+//fun main():
+//       0:   int t0
+//       1:   t0.0 = 1
+//       2:   int t1
+//       3:   t1.0 = 2
+//       4:   int t2
+//       5:   t2.0 = t0.0 + t1.0
+//       6:   ret t2.0
+int main() {
+    int a = 1;
+    int b = 2;
+    return a + b;
+}
\ No newline at end of file
@@ -0,0 +1,83 @@
+//fun main():
+//       0:   int t0
+//       1:   t0.0 = 0
+//       2:   int t1
+//       3:   t1.0 = 0
+//       4:   int t2
+//       5:   t2.0 = 0
+//       6:   int t3
+//       7:   t3.0 = 0
+//       8:   int t4
+//       9:   t4.0 = 0
+//      10:   int t5
+//      11:   t5.0 = 1
+//      12:   int t6
+//      13:   t6.0 = 1
+//      14:   int t7
+//      15:   t7.0 = 1
+//      16:   int t8
+//      17:   t8.0 = 1
+//      18:   | | if t1.0 != 0 goto L20
+//      19:   | | jmp L28
+//      20:   | | t6.1 = t5.0
+//      21:   | | | if t4.0 != 0 goto L23
+//      22:   | | | jmp L25
+//      23:   | | | t8.2 = 2
+//      24:   | | | jmp L26
+//      25:   | | | t8.1 = 3
+//      26:   | | t7.2 = t7.1 + 1
+//      27:   | | jmp L31
+//      28:   | | int t9
+//      29:   | | t9.0 = t7.0 + 2
+//      30:   | | t7.1 = t9.0
+//            | | | t6.2 = φ(31, 27)
+//            | | | t7.3 = φ(31, 27)
+//            | | | t9.1 = φ(31, 27)
+//      31:   | | | if t2.0 != 0 goto L33
+//      32:   | | | jmp L36
+//      33:   | | | int t10
+//      34:   | | | t10.0 = t8.2 + 4
+//      35:   | | | t8.3 = t10.0
+//            | | t8.4 = φ(36, 32)
+//            | | t10.1 = φ(36, 32)
+//      36:   | | if t3.0 != 0 goto L31
+//      37:   | if t0.0 != 0 goto L18
+//      38:   int t11
+//      39:   t11.0 = t5.0 + 6
+//      40:   t5.1 = t11.0
+//      41:   ret 0
+int main() {
+    int t = 0;
+    int p = 0;
+    int r = 0;
+    int s = 0;
+    int q = 0;
+
+    int i = 1;
+    int j = 1;
+    int k = 1;
+    int l = 1;
+
+    do {
+        if (p) {
+            j = i;
+            if (q) {
+                l = 2;
+            } else {
+                l = 3;
+            }
+            ++k;
+        } else {
+            k = k + 2;
+        }
+        do {
+            if (r) {
+                l = l + 4;
+            }
+        } while (s);
+    } while (t);
+
+    i = i + 6;
+
+    return 0;
+}
\ No newline at end of file
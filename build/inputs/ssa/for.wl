@@ -0,0 +1,24 @@
+//fun main():
+//       0:   int t0
+//       1:   t0.0 = 0
+//       2:   int t1
+//       3:   t1.0 = 0
+//            | t0.1 = φ(t0.0, t0.3)
+//            | t1.1 = φ(t1.0, t1.2)
+//       4:   | int t2
+//       5:   | t2.0 = t1.1 < 10
+//       6:   | if t2.0 != 0 goto L8
+//       7:   | jmp L12
+//       8:   | t0.2 = t1.1
+//       9:   | t0.3 = t0.2 + 1
+//      10:   | t1.2 = t1.1 + 1
+//      11:   | jmp L4
+//      12:   ret t0.1
+int main() {
+    int j = 0;
+    for (int i = 0; i < 10; ++i) {
+        j = i;
+        ++j;
+    }
+    return j;
+}
\ No newline at end of file
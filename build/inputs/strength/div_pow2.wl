@@ -0,0 +1,46 @@
+//fun main(int t0):
+//       0:   int t19
+//       1:   int t18
+//       2:   int t17
+//       3:   int t16
+//       4:   int t15
+//       5:   int t14
+//       6:   int t13
+//       7:   int t12
+//       8:   int t11
+//       9:   int t10
+//      10:   int t9
+//      11:   int t1
+//      12:   int t2
+//      13:   t9 = t0 >> 31
+//      14:   t10 = t9 & 7
+//      15:   t11 = t0 + t10
+//      16:   t2 = t11 >> 3
+//      17:   t1 = t2
+//      18:   int t3
+//      19:   int t4
+//      20:   t12 = t0 >> 31
+//      21:   t13 = t12 & 15
+//      22:   t14 = t0 + t13
+//      23:   t15 = t14 & -16
+//      24:   t4 = t0 - t15
+//      25:   t3 = t4
+//      26:   int t5
+//      27:   int t6
+//      28:   t16 = t0 >> 31
+//      29:   t17 = t16 & 3
+//      30:   t18 = t0 + t17
+//      31:   t19 = t18 >> 2
+//      32:   t6 = 0 - t19
+//      33:   t5 = t6
+//      34:   int t7
+//      35:   int t8
+//      36:   t8 = t3 + t5
+//      37:   t7 = t1 + t8
+//      38:   ret t7
+int main(int x) {
+    int a = x / 8;
+    int b = x % 16;
+    int c = x / -4;
+    return a + b + c;
+}
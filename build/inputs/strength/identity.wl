@@ -0,0 +1,31 @@
+//fun main(int t0):
+//       0:   int t1
+//       1:   int t2
+//       2:   t2 = t0
+//       3:   t1 = t2
+//       4:   int t3
+//       5:   int t4
+//       6:   t4 = 0 - t0
+//       7:   t3 = t4
+//       8:   int t5
+//       9:   int t6
+//      10:   t6 = 0
+//      11:   t5 = t6
+//      12:   int t7
+//      13:   int t8
+//      14:   t8 = t0 / 0
+//      15:   t7 = t8
+//      16:   int t9
+//      17:   int t10
+//      18:   int t11
+//      19:   t11 = t5 + t7
+//      20:   t10 = t3 + t11
+//      21:   t9 = t1 + t10
+//      22:   ret t9
+int main(int x) {
+    int a = x / 1;
+    int b = x / -1;
+    int c = x % 1;
+    int d = x / 0;
+    return a + b + c + d;
+}
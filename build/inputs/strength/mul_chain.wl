@@ -0,0 +1,46 @@
+//fun main(int t0):
+//       0:   int t18
+//       1:   int t17
+//       2:   int t16
+//       3:   int t15
+//       4:   int t1
+//       5:   int t2
+//       6:   t15 = t0 << 3
+//       7:   t2 = t15 + t0
+//       8:   t1 = t2
+//       9:   int t3
+//      10:   int t4
+//      11:   t16 = t0 << 3
+//      12:   t4 = t16 - t0
+//      13:   t3 = t4
+//      14:   int t5
+//      15:   int t6
+//      16:   t17 = t0 << 1
+//      17:   t6 = t17 + t0
+//      18:   t5 = t6
+//      19:   int t7
+//      20:   int t8
+//      21:   t18 = t0 << 3
+//      22:   t8 = t0 - t18
+//      23:   t7 = t8
+//      24:   int t9
+//      25:   int t10
+//      26:   t10 = t0 * 10
+//      27:   t9 = t10
+//      28:   int t11
+//      29:   int t12
+//      30:   int t13
+//      31:   int t14
+//      32:   t14 = t7 + t9
+//      33:   t13 = t5 + t14
+//      34:   t12 = t3 + t13
+//      35:   t11 = t1 + t12
+//      36:   ret t11
+int main(int x) {
+    int a = x * 9;
+    int b = x * 7;
+    int c = 3 * x;
+    int d = x * -7;
+    int e = x * 10;
+    return a + b + c + d + e;
+}
@@ -0,0 +1,4 @@
+//E<3:14>: Cannot apply `+` to int and char
+void f(int a, char b) {
+    return a + b;
+}
@@ -0,0 +1,6 @@
+//E<4:9>: Cannot get 16'th index of 4 dimensional array
+int main() {
+    int mem[1][2][3][4];
+    mem[0][0][0][0][0][0][0][0][0][0][0][0][0][0][0][0];
+    return 0;
+}
@@ -0,0 +1,5 @@
+//E<3:5>: Array size cannot be equal '0'
+int main() {
+    int mem[0];
+    return 0;
+}
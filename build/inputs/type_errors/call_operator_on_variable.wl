@@ -0,0 +1,6 @@
+//E<4:5>: `var` is not a function
+int main() {
+    int var = 1;
+    var();
+    return 0;
+}
\ No newline at end of file
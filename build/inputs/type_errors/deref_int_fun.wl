@@ -0,0 +1,8 @@
+//E<7:12>: Attempt to dereference integral type
+int c() {
+    return 1;
+}
+
+int main() {
+    return *c();
+}
\ No newline at end of file
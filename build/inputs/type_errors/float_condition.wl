@@ -0,0 +1,6 @@
+//E<4:5>: Cannot convert float to boolean
+int main() {
+    float f = 1.1233112123;
+    if (f) {}
+    return 0;
+}
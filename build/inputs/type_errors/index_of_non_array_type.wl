@@ -0,0 +1,6 @@
+//E<4:5>: Cannot get index of non-array type
+int main() {
+    int var = 0;
+    var[1];
+    return 0;
+}
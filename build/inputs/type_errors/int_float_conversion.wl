@@ -0,0 +1,7 @@
+//E<5:30>: Cannot apply `+` to int and float
+int main() {
+    int   i =   0;
+    float f = 0.0;
+    /* ??? */ int result = i + f;
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,5 @@
+//E<3:5>: Cannot assign char to variable of type int
+int main() {
+    int a = 'a';
+    return 0;
+}
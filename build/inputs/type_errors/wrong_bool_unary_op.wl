@@ -0,0 +1,10 @@
+//E<8:5>: Cannot apply `--` to boolean
+int main() {
+    int num = 0;
+    --num;
+    char sym = 'a';
+    --sym;
+    bool val = true;
+    --val;
+    return 0;
+}
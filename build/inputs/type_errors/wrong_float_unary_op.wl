@@ -0,0 +1,10 @@
+//E<8:5>: Cannot apply `--` to float
+int main() {
+    int num = 0;
+    --num;
+    char sym = 'a';
+    --sym;
+    float val = 0.0;
+    --val;
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,4 @@
+//E<3:16>: Cannot apply `+` to char and float
+int main() {
+    return 'a' + 2.5;
+}
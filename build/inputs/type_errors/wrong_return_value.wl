@@ -0,0 +1,4 @@
+//E<2:1>: Cannot return string instead of int
+int main() {
+    return "Hello";
+}
\ No newline at end of file
@@ -0,0 +1,10 @@
+//E<9:12>: Function `unknown` not found
+int main() {
+    call_trace(); // Builtin.
+    call_trace(); // Builtin.
+    call_trace(); // Builtin.
+    call_trace(); // Builtin.
+    call_trace(); // Builtin.
+    call_trace(); // Builtin.
+    return unknown();
+}
@@ -0,0 +1,4 @@
+//E<3:12>: Function `unknown` not found
+int main() {
+    return unknown();
+}
@@ -0,0 +1,3 @@
+//E<3:1>: Function `main` already declared at line 2, column 1
+int main() { return 0; }
+int main() { return 0; }
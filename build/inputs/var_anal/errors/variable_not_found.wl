@@ -0,0 +1,4 @@
+//E<3:12>: Variable `zero` not found
+int main() {
+    return zero;
+}
@@ -0,0 +1,7 @@
+//E<5:5>: Variable as argument of unary operator expected
+void f() {}
+
+int main() {
+    --f();
+    return 0;
+}
@@ -0,0 +1,150 @@
+/* Verification-only replacement for flex output of lex/grammar.lex. */
+#include "front_end/lex/tok.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+FILE *yyin = NULL;
+FILE *yyout = NULL;
+int yylineno = 1;
+int yycolumn = 1;
+char *yytext;
+int yyleng;
+
+extern void lex_consume_token(struct token *tok);
+
+static const struct { const char *s; int t; } kw[] = {
+ {"bool",TOK_BOOL},{"break",TOK_BREAK},{"char",TOK_CHAR},{"continue",TOK_CONTINUE},
+ {"do",TOK_DO},{"else",TOK_ELSE},{"false",TOK_FALSE},{"float",TOK_FLOAT},{"for",TOK_FOR},
+ {"if",TOK_IF},{"int",TOK_INT},{"return",TOK_RETURN},{"struct",TOK_STRUCT},{"true",TOK_TRUE},
+ {"void",TOK_VOID},{"while",TOK_WHILE},
+};
+static const struct { const char *s; int t; } ops[] = {
+ {"=",TOK_ASSIGN},{"/=",TOK_DIV_ASSIGN},{"%=",TOK_MOD_ASSIGN},{"+=",TOK_PLUS_ASSIGN},
+ {"-=",TOK_MINUS_ASSIGN},{">>=",TOK_SHR_ASSIGN},{"<<=",TOK_SHL_ASSIGN},{"&=",TOK_BIT_AND_ASSIGN},
+ {"|=",TOK_BIT_OR_ASSIGN},{"^=",TOK_XOR_ASSIGN},{"&&",TOK_AND},{"||",TOK_OR},{"&",TOK_BIT_AND},
+ {"|",TOK_BIT_OR},{"==",TOK_EQ},{"!=",TOK_NEQ},{">",TOK_GT},{"<",TOK_LT},{">=",TOK_GE},
+ {"<=",TOK_LE},{"<<",TOK_SHL},{">>",TOK_SHR},{"+",TOK_PLUS},{"-",TOK_MINUS},{"*",TOK_STAR},
+ {"/",TOK_SLASH},{"%",TOK_MOD},{"++",TOK_INC},{"--",TOK_DEC},{".",TOK_DOT},{",",TOK_COMMA},
+ {":",TOK_COLON},{";",TOK_SEMICOLON},{"!",TOK_NOT},{"^",TOK_XOR},{"[",TOK_OPEN_BOX_BRACKET},
+ {"]",TOK_CLOSE_BOX_BRACKET},{"(",TOK_OPEN_PAREN},{")",TOK_CLOSE_PAREN},{"{",TOK_OPEN_CURLY_BRACKET},
+ {"}",TOK_CLOSE_CURLY_BRACKET},
+};
+
+enum { K_SKIP, K_WORD, K_QUOTED, K_OP, K_BAD };
+
+static int m_linecomment(const char *p) {
+  if (p[0] != '/' || p[1] != '/') return 0;
+  int i = 2; while (p[i] && p[i] != '\n') ++i;
+  return p[i] == '\n' ? i + 1 : 0;
+}
+static int m_blockcomment(const char *p) {
+  if (p[0] != '/' || p[1] != '*') return 0;
+  int best = 0;
+  for (int i = 2; p[i] && p[i] != '\n'; ++i)
+    if (p[i] == '*' && p[i+1] == '/') best = i + 2;
+  return best;
+}
+static int m_int(const char *p) {
+  int i = 0; if (p[i] == '-') ++i;
+  int s = i; while (isdigit((unsigned char)p[i])) ++i;
+  return i > s ? i : 0;
+}
+static int m_float(const char *p) {
+  int i = m_int(p); if (!i) return 0;
+  if (p[i] != '.') return 0; ++i;
+  int s = i; while (isdigit((unsigned char)p[i])) ++i;
+  return i > s ? i : 0;
+}
+static int m_string(const char *p) {
+  if (p[0] != '"') return 0;
+  int i = 1;
+  for (;;) {
+    if (!p[i]) return 0;
+    if (p[i] == '"') return i + 1;
+    if (p[i] == '\\') { if (!p[i+1] || p[i+1] == '\n') return 0; i += 2; continue; }
+    ++i;
+  }
+}
+static int m_char(const char *p) {
+  return (p[0] == '\'' && p[1] && p[1] != '\n' && p[2] == '\'') ? 3 : 0;
+}
+static int m_ident(const char *p) {
+  if (!(isalpha((unsigned char)p[0]) || p[0] == '_')) return 0;
+  int i = 1; while (isalnum((unsigned char)p[i]) || p[i] == '_') ++i;
+  return i;
+}
+
+int yylex(void)
+{
+  int lex_lineno, lex_colno;
+  int prev_yylineno = yylineno;
+  char *buf = NULL; size_t cap = 0, len = 0;
+  if (!yyin) yyin = stdin;
+  int c;
+  while ((c = fgetc(yyin)) != EOF) {
+    if (len + 2 >= cap) { cap = cap ? cap * 2 : 4096; buf = realloc(buf, cap); }
+    buf[len++] = (char)c;
+  }
+  if (!buf) buf = malloc(1);
+  buf[len] = 0;
+  const char *p = buf;
+  while (*p) {
+    int best = 0, kind = K_BAD, type = 0, l;
+#define TRY(expr, k, t) do { l = (expr); if (l > best) { best = l; kind = (k); type = (t); } } while (0)
+    TRY(m_linecomment(p), K_SKIP, 0);
+    TRY(m_blockcomment(p), K_SKIP, 0);
+    TRY(isspace((unsigned char)*p) ? 1 : 0, K_SKIP, 0);
+    TRY(m_int(p), K_WORD, TOK_INT_LITERAL);
+    TRY(m_float(p), K_WORD, TOK_FLOAT_LITERAL);
+    TRY(m_string(p), K_QUOTED, TOK_STRING_LITERAL);
+    TRY(m_char(p), K_QUOTED, TOK_CHAR_LITERAL);
+    for (size_t k = 0; k < sizeof kw / sizeof *kw; ++k) {
+      size_t n = strlen(kw[k].s);
+      TRY(strncmp(p, kw[k].s, n) == 0 ? (int)n : 0, K_WORD, kw[k].t);
+    }
+    for (size_t k = 0; k < sizeof ops / sizeof *ops; ++k) {
+      size_t n = strlen(ops[k].s);
+      TRY(strncmp(p, ops[k].s, n) == 0 ? (int)n : 0, K_OP, ops[k].t);
+    }
+    TRY(m_ident(p), K_WORD, TOK_SYMBOL);
+    if (!best) {
+      if (*p == '\n') { best = 1; kind = K_SKIP; }
+      else { fprintf(stderr, "Illegal token `%c`\n", *p); fflush(stderr); __builtin_trap(); }
+    }
+    yytext = strndup(p, best);
+    yyleng = best;
+    for (int i = 0; i < best; ++i) if (yytext[i] == '\n') ++yylineno;
+    lex_lineno = prev_yylineno;
+    lex_colno = yycolumn;
+    if (yylineno == prev_yylineno) {
+      yycolumn += yyleng;
+    } else {
+      for (yycolumn = 1; yytext[yyleng - yycolumn] != '\n'; ++yycolumn) {}
+      prev_yylineno = yylineno;
+    }
+    if (kind == K_WORD || kind == K_QUOTED || kind == K_OP) {
+      struct token t = { .data = NULL, .type = type, .line_no = lex_lineno, .col_no = lex_colno };
+      if (kind == K_WORD) t.data = strdup(yytext);
+      if (kind == K_QUOTED) {
+        t.data = strdup(yytext + 1);
+        size_t dl = strlen(t.data);
+        if (dl > 0) t.data[dl - 1] = '\0';
+      }
+      lex_consume_token(&t);
+    }
+    free(yytext);
+    p += best;
+  }
+  free(buf);
+  return 0;
+}
+
+int yylex_destroy(void)
+{
+  yyin = NULL;
+  yyout = NULL;
+  yylineno = 1;
+  return 0;
+}
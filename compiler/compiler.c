@@ -1,4 +1,8 @@
+#include "back_end/back_end.h"
+#include "back_end/emit.h"
 #include "back_end/eval.h"
+#include "back_end/link.h"
+#include "back_end/sched.h"
 #include "front_end/anal/anal.h"
 #include "front_end/ast/ast.h"
 #include "front_end/ast/ast_dump.h"
@@ -8,8 +12,10 @@
 #include "middle_end/ir/gen.h"
 #include "middle_end/ir/ir_dump.h"
 #include "middle_end/ir/ir_bin.h"
+#include "middle_end/ir/regalloc.h"
 #include "middle_end/ir/type.h"
 #include "middle_end/opt/opt.h"
+#include "util/alloc.h"
 #include "util/diagnostic.h"
 #include <errno.h>
 #include <string.h>
@@ -118,35 +124,87 @@ void dump_ir(struct ir_unit *ir)
 /**********************************************
  **             Interpreter                  **
  **********************************************/
-void opt(struct ir_unit *ir)
+void reg_alloc(struct ir_unit *ir, bool fast)
 {
-    ir_type_pass(ir);
-    ir_opt_reorder(ir);
-    ir_opt_arith(ir);
-
-    struct ir_node *it = ir->fn_decls;
-    while (it) {
-        struct ir_fn_decl *decl = it->ir;
-        ir_cfg_build(decl);
-        it = it->next;
-    }
+    struct ir_reg_file file = {.count = 8};
+
+    if (fast)
+        ir_reg_alloc_linear(ir, &file);
+    else
+        ir_reg_alloc(ir, &file);
 }
 
 #ifdef CONFIG_USE_BACKEND_EVAL
-void run_backend(const char *filename)
-{
+void run_backend(
+    const char      *filename,
+    unused char     *out,
+    unused bool      object,
+    unused bool      dump_sched,
+    unused char     *sched_model,
+    unused bool      fast_regalloc
+) {
     struct ir_unit unit = gen_ir(filename);
-    opt(&unit);
+    ir_opt_pipeline(&unit);
 
     int r = eval(&unit);
     printf("Exit with %d\n", r);
 }
+
+void run_link(unused const char **objects, unused uint64_t count, unused char *out)
+{
+    puts("Linking requires native back end.");
+    exit(1);
+}
 #endif /* CONFIG_USE_BACKEND_EVAL */
 
-#ifdef CONFIG_USE_BACKEND_RISC_V
-void run_backend(unused const char *filename)
-{}
-#endif /* CONFIG_USE_BACKEND_RISC_V */
+#if defined CONFIG_USE_BACKEND_RISC_V || defined CONFIG_USE_BACKEND_X86_64
+void run_backend(
+    const char      *filename,
+    char            *out,
+    bool             object,
+    bool             dump_sched,
+    char            *sched_model,
+    bool             fast_regalloc
+) {
+    struct codegen_output output = {0};
+
+    if (sched_model) {
+        const struct sched_model *model = sched_model_find(sched_model);
+        if (!model) {
+            printf("Unknown scheduling model `%s`.\n", sched_model);
+            exit(1);
+        }
+        sched_model_set(model);
+    }
+
+    struct ir_unit unit = gen_ir(filename);
+    ir_opt_pipeline(&unit);
+
+    back_end_init(&output);
+    back_end_gen(&unit, fast_regalloc);
+
+    if (dump_sched) {
+        struct sched_stats stats = {0};
+        sched_stats_get(&stats);
+        printf(
+            "Scheduled %lu instructions, estimated cycles before: %lu, after: %lu\n",
+            stats.instrs, stats.cycles_before, stats.cycles_after
+        );
+    }
+
+    if (object)
+        back_end_emit_object(&output, out ? out : "a.o");
+    else
+        back_end_emit(&output, out ? out : "a.out");
+
+    ir_unit_cleanup(&unit);
+}
+
+void run_link(const char **objects, uint64_t count, char *out)
+{
+    back_end_link(objects, count, out ? out : "a.out");
+}
+#endif /* CONFIG_USE_BACKEND_RISC_V || CONFIG_USE_BACKEND_X86_64 */
 
 
 void configure_ast(bool simple)
@@ -168,8 +226,18 @@ void parse_cmdline(int argc, char *argv[])
     bool  ast_simple  = 0;
     bool  ir          = 0;
     bool  read_bin_ir = 0;
+    bool  regalloc    = 0;
+    bool  fast_ra     = 0;
+    bool  sched       = 0;
+    char *sched_model = NULL;
+    bool  object      = 0;
+    bool  link        = 0;
+    char *out         = NULL;
     int   file_i      = -1;
     char *file        = NULL;
+    /* Object files to link. */
+    const char **inputs     = weak_calloc(argc, sizeof (char *));
+    uint64_t     inputs_cnt = 0;
 
     /* This simple algorithm allows us to have
        command line args of type:
@@ -182,7 +250,17 @@ void parse_cmdline(int argc, char *argv[])
         else if (!strcmp(argv[i], "--dump-ast-simple")) ast_simple  = 1;
         else if (!strcmp(argv[i], "--dump-ir"))         ir          = 1;
         else if (!strcmp(argv[i], "--read-ir"))         read_bin_ir = 1;
-        else                                            file_i      = i;
+        else if (!strcmp(argv[i], "--dump-regalloc"))   regalloc    = 1;
+        else if (!strcmp(argv[i], "--fast-regalloc"))   fast_ra     = 1;
+        else if (!strcmp(argv[i], "--dump-sched"))      sched       = 1;
+        else if (!strncmp(argv[i], "--sched-model=", 14)) sched_model = argv[i] + 14;
+        else if (!strcmp(argv[i], "-c"))                object      = 1;
+        else if (!strcmp(argv[i], "--link"))            link        = 1;
+        else if (!strcmp(argv[i], "-o") && i + 1 < argc) out        = argv[++i];
+        else {
+            file_i = i;
+            inputs[inputs_cnt++] = argv[i];
+        }
 
     if (file_i == -1) {
         puts("No input file was given.");
@@ -191,6 +269,14 @@ void parse_cmdline(int argc, char *argv[])
 
     file = argv[file_i];
 
+    if (link) {
+        run_link(inputs, inputs_cnt, out);
+        weak_free(inputs);
+        exit(0);
+    }
+
+    weak_free(inputs);
+
     if (tokens) {
         tok_array_t *t = gen_tokens(file);
         dump_tokens(t);
@@ -216,6 +302,15 @@ void parse_cmdline(int argc, char *argv[])
         exit(0);
     }
 
+    if (regalloc) {
+        struct ir_unit unit = gen_ir(file);
+        ir_opt_pipeline(&unit);
+        reg_alloc(&unit, fast_ra);
+        dump_ir(&unit);
+        ir_unit_cleanup(&unit);
+        exit(0);
+    }
+
     if (read_bin_ir) {
         struct ir_unit unit = ir_read_binary(file);
         dump_ir(&unit);
@@ -223,7 +318,7 @@ void parse_cmdline(int argc, char *argv[])
         exit(0);
     }
 
-    run_backend(file);
+    run_backend(file, out, object, sched, sched_model, fast_ra);
 }
 
 void help();
@@ -251,12 +346,21 @@ void help()
 {
     printf(
         "Usage: weak_compiler <options...> | <input-file>\n"
+        "       weak_compiler -c <input-file> -o <object-file>\n"
+        "       weak_compiler --link <object-files...> -o <output-file>\n"
         "\n"
         "\t--dump-tokens\n"
         "\t--dump-ast\n"
         "\t--dump-ast-simple\n"
         "\t--dump-ir\n"
         "\t--read-ir\n"
+        "\t--dump-regalloc\n"
+        "\t--fast-regalloc\n"
+        "\t--dump-sched\n"
+        "\t--sched-model=<u74|single>\n"
+        "\t-c\n"
+        "\t-o <output-file>\n"
+        "\t--link\n"
     );
     exit(0);
 }
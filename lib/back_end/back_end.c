@@ -1,44 +1,293 @@
 #include "back_end/back_end.h"
 #include "back_end/elf.h"
 #include "util/compiler.h"
+#include "util/unreachable.h"
 #include <string.h>
 
+#define LABEL_UNBOUND UINT64_MAX
+
+#define NO_FIXUP      UINT64_MAX
+
+/* Instruction at .text offset `off`, whose target is
+   `label`. */
+struct fixup {
+    uint64_t off;
+    uint64_t label;
+};
+
+/* Code, written by one put() call. */
+struct chunk {
+    uint64_t off;
+    uint64_t size;
+    /* Offset and size after layout. */
+    uint64_t new_off;
+    uint64_t new_size;
+    /* Index of fixup or NO_FIXUP. */
+    uint64_t fixup;
+};
+
 static struct codegen_output *output_code;
 static instr_vector_t        *text_section;
-static uint64_t               text_seek;
+/* Index:  label
+   Value: .text offset or LABEL_UNBOUND */
+static vector_t(uint64_t)     labels;
+/* Index:  label
+   Value: Symbol name or NULL */
+static vector_t(const char *) label_syms;
+static vector_t(struct fixup) fixups;
+static vector_t(struct chunk) chunks;
 
 uint64_t back_end_seek()
 {
-    return text_seek;
+    return text_section->count;
 }
 
-void back_end_seek_set(uint64_t seek)
+void put(uint8_t *code, uint64_t size)
 {
-    text_seek = seek;
+    struct chunk chunk = {
+        .off  = back_end_seek(),
+        .size = size
+    };
+
+    /* Text was cleared by caller. */
+    if (chunk.off == 0)
+        vector_clear(chunks);
+
+    vector_push_back(chunks, chunk);
+
+    for (uint64_t i = 0; i < size; ++i)
+        vector_push_back(*text_section, code[i]);
 }
 
-void put(uint8_t *code, uint64_t size)
+/**********************************************
+ **                 Layout                   **
+ **********************************************/
+
+/* First non-empty chunk, starting at `off` or later. */
+static uint64_t chunk_find(uint64_t off)
+{
+    uint64_t lo = 0;
+    uint64_t hi = chunks.count;
+
+    while (lo < hi) {
+        uint64_t mid = lo + (hi - lo) / 2;
+
+        if (vector_at(chunks, mid).off < off)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    while (lo < chunks.count && vector_at(chunks, lo).size == 0)
+        ++lo;
+
+    return lo;
+}
+
+static uint64_t layout_size()
+{
+    if (chunks.count == 0)
+        return 0;
+
+    struct chunk *last = &vector_back(chunks);
+    return last->new_off + last->new_size;
+}
+
+/* Offset of `off` after layout. */
+static uint64_t layout_map(uint64_t off)
+{
+    uint64_t i = chunk_find(off);
+
+    if (i == chunks.count)
+        return layout_size();
+
+    return vector_at(chunks, i).new_off;
+}
+
+static void layout_place()
+{
+    uint64_t off = 0;
+
+    vector_foreach(chunks, i) {
+        struct chunk *c = &vector_at(chunks, i);
+
+        c->new_off = off;
+        off += c->new_size;
+    }
+}
+
+/* Start from the shortest forms and grow instructions,
+   whose label became too far, until nothing changes.
+   Sizes only grow, so it terminates. */
+static bool layout_relax()
+{
+    bool changed = 0;
+
+    vector_foreach(chunks, i) {
+        struct chunk *c = &vector_at(chunks, i);
+
+        if (c->fixup == NO_FIXUP)
+            continue;
+
+        struct fixup *f    = &vector_at(fixups, c->fixup);
+        int64_t       dist = (int64_t) layout_map(vector_at(labels, f->label))
+                           - (int64_t) c->new_off;
+        uint64_t      size = back_end_native_relax_size(
+            &vector_at(*text_section, c->off), c->size, /*fixup=*/1, dist
+        );
+
+        if (size > c->new_size) {
+            c->new_size = size;
+            changed     = 1;
+        }
+    }
+
+    return changed;
+}
+
+/* Move code, labels, fixups and symbols to places,
+   chosen by layout. */
+static void layout_emit()
+{
+    instr_vector_t text = {0};
+
+    vector_foreach(chunks, i) {
+        struct chunk *c = &vector_at(chunks, i);
+
+        for (uint64_t j = 0; j < c->new_size; ++j)
+            vector_push_back(text, 0);
+
+        uint64_t pos = back_end_native_relax(
+            &vector_at(*text_section, c->off), c->size,
+            &vector_at(text, c->new_off), c->new_size
+        );
+
+        if (c->fixup != NO_FIXUP)
+            vector_at(fixups, c->fixup).off = c->new_off + pos;
+    }
+
+    vector_foreach(labels, i) {
+        uint64_t *label = &vector_at(labels, i);
+
+        if (*label != LABEL_UNBOUND)
+            *label = layout_map(*label);
+    }
+
+    vector_foreach(output_code->symtab, i) {
+        struct elf_symtab_entry *e = &vector_at(output_code->symtab, i);
+        e->off = layout_map(e->off);
+    }
+
+    vector_foreach(chunks, i) {
+        struct chunk *c = &vector_at(chunks, i);
+
+        c->off  = c->new_off;
+        c->size = c->new_size;
+    }
+
+    vector_free(*text_section);
+    *text_section = text;
+}
+
+static void layout()
 {
-    uint64_t s = back_end_seek();
+    bool changed = 0;
 
-    for (uint64_t i = 0; i < size; ++i) {
-        vector_emplace(*text_section, back_end_seek());
-        vector_at(*text_section, s + i) = code[i];
-        ++text_seek;
+    vector_foreach(chunks, i) {
+        struct chunk *c = &vector_at(chunks, i);
+
+        c->fixup    = NO_FIXUP;
+        c->new_size = back_end_native_relax_size(
+            &vector_at(*text_section, c->off), c->size, /*fixup=*/0, 0
+        );
     }
+
+    vector_foreach(fixups, i) {
+        uint64_t c = chunk_find(vector_at(fixups, i).off);
+
+        if (c == chunks.count)
+            weak_unreachable("Fixup at %lu refers to no instruction.", vector_at(fixups, i).off);
+
+        vector_at(chunks, c).fixup    = i;
+        vector_at(chunks, c).new_size = back_end_native_relax_size(
+            &vector_at(*text_section, vector_at(chunks, c).off),
+            vector_at(chunks, c).size, /*fixup=*/1, 0
+        );
+    }
+
+    do {
+        layout_place();
+    } while (layout_relax());
+
+    vector_foreach(chunks, i) {
+        struct chunk *c = &vector_at(chunks, i);
+        changed |= c->new_size != c->size;
+    }
+
+    if (changed)
+        layout_emit();
+}
+
+/**********************************************
+ **                 Fixups                   **
+ **********************************************/
+
+uint64_t back_end_label()
+{
+    vector_push_back(labels, LABEL_UNBOUND);
+    vector_push_back(label_syms, NULL);
+    return labels.count - 1;
+}
+
+void back_end_label_sym(uint64_t label, const char *name)
+{
+    vector_at(label_syms, label) = name;
 }
 
-static uint64_t calculate_strtab_size(symtab_vector_t *v)
+void back_end_label_bind(uint64_t label)
 {
-    uint64_t len = 0;
+    vector_at(labels, label) = back_end_seek();
+}
 
-    vector_foreach(*v, i) {
-        struct elf_symtab_entry *e = &vector_at(*v, i);
+void back_end_fixup(uint64_t label)
+{
+    struct fixup fixup = {
+        .off   = back_end_seek(),
+        .label = label
+    };
 
-        len += strlen(e->name) + 1;
+    vector_push_back(fixups, fixup);
+}
+
+void back_end_fixups_resolve()
+{
+    layout();
+
+    vector_foreach(fixups, i) {
+        struct fixup *fixup = &vector_at(fixups, i);
+        uint64_t      to    = vector_at(labels, fixup->label);
+        const char   *sym   = vector_at(label_syms, fixup->label);
+
+        if (to == LABEL_UNBOUND && sym) {
+            /* Function from other unit. */
+            struct elf_reloc reloc = {
+                .off = fixup->off
+            };
+            strncpy(reloc.name, sym, sizeof (reloc.name) - 1);
+            vector_push_back(output_code->relocs, reloc);
+            continue;
+        }
+
+        if (to == LABEL_UNBOUND)
+            weak_fatal_error("Label %lu is referenced, but not bound.", fixup->label);
+
+        back_end_native_patch(
+            &vector_at(*text_section, fixup->off),
+            (int64_t) to - (int64_t) fixup->off
+        );
     }
 
-    return len;
+    vector_clear(fixups);
 }
 
 void back_end_emit_sym(const char *name, uint64_t off)
@@ -57,35 +306,41 @@ void back_end_init(struct codegen_output *output)
     hashmap_init(&output_code->fn_offsets, 32);
 
     text_section = &output->instrs;
+
+    vector_clear(labels);
+    vector_clear(label_syms);
+    vector_clear(fixups);
+    vector_clear(chunks);
 }
 
-void back_end_emit(struct codegen_output *output, const char *path)
+static void back_end_cleanup(struct codegen_output *output)
 {
-    uint64_t text_size   = output->instrs.count;
-    uint64_t strtab_size = calculate_strtab_size(&output->symtab);
+    vector_free(output->symtab);
+    vector_free(output->relocs);
 
-    struct {
-        const char *name;
-        uint64_t    size;
-    } sections[] = {
-        { ".text",     text_size   },
-        { ".strtab",   strtab_size },
-        { ".shstrtab", 40          }, /* Enough to place 4 sections (with symtab). */
-    };
+    output_code = NULL;
+    text_section = NULL;
 
-    for (uint64_t i = 0; i < __weak_array_size(sections); ++i)
-        elf_init_section(output, sections[i].name, sections[i].size);
+    vector_free(labels);
+    vector_free(label_syms);
+    vector_free(fixups);
+    vector_free(chunks);
+}
 
-    elf_init_symtab(output, output->symtab.count);
+void back_end_emit(struct codegen_output *output, const char *path)
+{
+    back_end_fixups_resolve();
 
-    struct elf_entry elf = {
-        .filename = path,
-        .output   = *output
-    };
+    if (output->relocs.count > 0)
+        weak_fatal_error("Undefined reference to `%s`.", vector_at(output->relocs, 0).name);
 
-    elf_init(&elf);
-    elf_exit(&elf);
+    elf_write(output, path, ET_EXEC);
+    back_end_cleanup(output);
+}
 
-    output_code = NULL;
-    text_section = NULL;
-}
\ No newline at end of file
+void back_end_emit_object(struct codegen_output *output, const char *path)
+{
+    back_end_fixups_resolve();
+    elf_write(output, path, ET_REL);
+    back_end_cleanup(output);
+}
@@ -8,35 +8,87 @@
 #define WEAK_COMPILER_BACKEND_BACKEND_H
 
 #include "back_end/elf.h"
+#include <stdbool.h>
 
 void back_end_init(struct codegen_output *output);
+/* Write executable. Every called function must be
+   defined. */
 void back_end_emit(struct codegen_output *output, const char *path);
+/* Write relocatable object. Calls to functions, which
+   are not defined, are left to linker. */
+void back_end_emit_object(struct codegen_output *output, const char *path);
 void back_end_emit_sym(const char *name, uint64_t off);
 
 /* Returns number of generated bytes
    at this point of time. */
 uint64_t back_end_seek();
-/* Used to set position from which we want
-   to insert code with `back_end_native_*`
-   functions. */
-void back_end_seek_set(uint64_t seek);
 
+/* Append code to the end of .text. Code is never
+   inserted in the middle, forward references are
+   resolved with fixups instead. */
 void put(uint8_t *code, uint64_t size);
 
+/* Create new label, which is not bound to any
+   position yet. */
+uint64_t back_end_label();
+/* Bind label to current position. */
+void back_end_label_bind(uint64_t label);
+/* Name label by function `name`. If label is never bound,
+   references to it become relocations against undefined
+   symbol. `name` should live until code is emitted. */
+void back_end_label_sym(uint64_t label, const char *name);
+/* Remember, that next emitted instruction (call,
+   jump or branch) refers to label. Its offset is
+   written by back_end_fixups_resolve(). */
+void back_end_fixup(uint64_t label);
+/* Lay out code, then patch each referring instruction
+   with offset to its label. Called by back_end_emit()
+   after all code is generated. */
+void back_end_fixups_resolve();
+
 int  back_end_return_reg();
+/* Register of n-th integer argument of call. */
+int  back_end_arg_reg(int n);
+/* Temporary register, not preserved across calls, or
+   -1 if there is no n-th one. Temporaries are disjoint
+   with argument registers. */
+int  back_end_tmp_reg(int n);
+/* Callee-saved register, given to register allocator,
+   or -1 if there is no n-th one. */
+int  back_end_saved_reg(int n);
+/* Stack pointer. Area of `stack_usage` bytes, reserved by
+   back_end_native_prologue(), starts at its value. */
+int  back_end_sp_reg();
+/* Register, which always reads as zero, or -1 if
+   target has no such one. */
+int  back_end_zero_reg();
 
 void back_end_native_add    (int dst, int reg1, int reg2);
 void back_end_native_addi   (int dst, int reg1, int imm);
 void back_end_native_addiw  (int dst, int reg1, int imm);
 void back_end_native_sub    (int dst, int reg1, int reg2);
 void back_end_native_div    (int dst, int reg1, int reg2);
+void back_end_native_rem    (int dst, int reg1, int reg2);
 void back_end_native_mul    (int dst, int reg1, int reg2);
 void back_end_native_xor    (int dst, int reg1, int reg2);
 void back_end_native_xori   (int dst, int reg1, int imm);
 void back_end_native_and    (int dst, int reg1, int reg2);
+void back_end_native_andi   (int dst, int reg1, int imm);
 void back_end_native_or     (int dst, int reg1, int reg2);
+void back_end_native_ori    (int dst, int reg1, int imm);
 void back_end_native_sra    (int dst, int reg1, int reg2);
 void back_end_native_srl    (int dst, int reg1, int reg2);
+void back_end_native_srai   (int dst, int reg1, int imm);
+void back_end_native_sll    (int dst, int reg1, int reg2);
+void back_end_native_slli   (int dst, int reg1, int imm);
+/* dst = reg1 < reg2, signed. */
+void back_end_native_slt    (int dst, int reg1, int reg2);
+/* dst = reg1 < imm, signed. */
+void back_end_native_slti   (int dst, int reg1, int imm);
+/* dst = reg1 == 0. */
+void back_end_native_seqz   (int dst, int reg1);
+/* dst = reg1 != 0. */
+void back_end_native_snez   (int dst, int reg1);
 
 void back_end_native_li     (int dst,           int imm);
 void back_end_native_lb     (int dst, int addr, int off);
@@ -54,7 +106,27 @@ void back_end_native_sd     (int dst, int addr, int off);
 
 void back_end_native_ret    ();
 void back_end_native_call   (int off);
+void back_end_native_jmp    (int off);
 void back_end_native_jmp_reg(int reg);
+void back_end_native_beq    (int reg1, int reg2, int off);
+void back_end_native_bne    (int reg1, int reg2, int off);
+void back_end_native_blt    (int reg1, int reg2, int off);
+void back_end_native_bge    (int reg1, int reg2, int off);
+
+/* Write PC-relative offset to call, jump or branch
+   instruction, located at `code`. */
+void back_end_native_patch  (uint8_t *code, int64_t off);
+
+/* Size of instruction `code` of `size` bytes after layout.
+   If instruction refers to label (`fixup` is set), `off`
+   is distance to it. Target may choose shorter form or
+   longer sequence, that reaches far label. */
+uint64_t back_end_native_relax_size(const uint8_t *code, uint64_t size, bool fixup, int64_t off);
+/* Write instruction `code` of `size` bytes to `out` in form
+   of `out_size` bytes, given by back_end_native_relax_size().
+
+   \return Position of instruction to be patched in `out`. */
+uint64_t back_end_native_relax(const uint8_t *code, uint64_t size, uint8_t *out, uint64_t out_size);
 
 void back_end_native_syscall_0(int syscall);
 void back_end_native_syscall_1(int syscall, int _1);
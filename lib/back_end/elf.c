@@ -8,7 +8,6 @@
 #include "util/compiler.h"
 #include "util/crc32.h"
 #include "util/vector.h"
-#include "util/compiler.h"
 #include "util/unreachable.h"
 #include <errno.h>
 #include <fcntl.h>
@@ -16,53 +15,67 @@
 #include <string.h>
 #include <stdlib.h>
 #include <unistd.h>
-#include <sys/mman.h>
+#include <sys/uio.h>
 
 #define ELF_PHDR_OFF                0x0040
 #define ELF_SH_SIZE                 0x0040
-#define ELF_SH_OFF                  0x4000
-#define ELF_INIT_SIZE               0x8000
 #define ELF_PHDR_ALIGN              0x1000
+#if defined CONFIG_USE_BACKEND_X86_64
+/* Usual base of x86-64 executables. Pages below
+   vm.mmap_min_addr cannot be mapped. */
+#define ELF_ENTRY_ADDR              0x401000
+#else
 #define ELF_ENTRY_ADDR              (ELF_PHDR_ALIGN * 2)
+#endif
 /* How much bytes occupy one symtab entry. */
 #define ELF_SYMTAB_ENTSIZE          24
-
-#define ELF64_ST_BIND(info)         ((info) >> 4)
-#define ELF64_ST_TYPE(info)         ((info) & 0xf)
-#define ELF64_ST_INFO(bind, type)   (((bind) << 4) + ((type) & 0xf))
-
-static int   elf_fd;
-static char *elf_map;
-
-#define emit(addr, byte_string) \
-    { strcpy(&elf_map[addr], byte_string); }
-
-#define emit_bytes_cnt(addr, data, size) \
-    { memcpy(&((uint8_t *) elf_map)[(addr)], (data), (size)); }
-
-#define emit_bytes(addr, data) \
-    { emit_bytes_cnt(addr, data, sizeof (*(data))); }
-
-static char *emit_symbol(char *start, const char *section)
+/* How much bytes occupy one .rela.text entry. */
+#define ELF_RELA_ENTSIZE            24
+/* Most parts passed to one pwritev() call. Equals to
+   IOV_MAX of Linux. */
+#define ELF_IOV_MAX                 1024
+
+typedef vector_t(struct elf_shdr) shdr_vector_t;
+typedef vector_t(struct iovec) iovec_vector_t;
+
+static int      elf_fd;
+/* ET_EXEC or ET_REL. */
+static uint16_t elf_type;
+/* Undefined symbols of object file, which are placed
+   after defined ones in .symtab. */
+static symtab_vector_t elf_undef;
+/* Key:   CRC32 of undefined symbol name
+   Value: Index in .symtab */
+static hashmap_t       elf_undef_idx;
+/* Section header table. Offsets are computed before
+   anything is written. */
+static shdr_vector_t   elf_shdrs;
+/* Parts of file in order of offsets, including
+   padding between them. Written at once. */
+static iovec_vector_t  elf_iov;
+/* File offset after last part of elf_iov. */
+static uint64_t        elf_iov_off;
+static struct elf_fhdr elf_fhdr;
+static struct elf_phdr elf_phdr;
+/* Source of padding. */
+static const uint8_t   elf_zeros[ELF_PHDR_ALIGN];
+
+static uint64_t align_up(uint64_t off, uint64_t align)
 {
-    uint64_t len = strlen(section);
-    strcpy(start, section);
-    start[len] = 0;
-    return start + len + /* NULL byte. */1;
+    return (off + align - 1) & ~(align - 1);
 }
 
-static void emit_shdr(uint64_t idx, struct elf_shdr *shdr)
+static void emit_bytes(instr_vector_t *v, const void *data, uint64_t size)
 {
-    uint64_t shdr_off = ELF_SH_OFF + (ELF_SH_SIZE * idx);
+    const uint8_t *bytes = data;
 
-    emit_bytes(shdr_off, shdr);
+    for (uint64_t i = 0; i < size; ++i)
+        vector_push_back(*v, bytes[i]);
 }
 
-static void emit_phdr(uint64_t idx, struct elf_phdr *phdr)
+static void emit_symbol(instr_vector_t *v, const char *name)
 {
-    uint64_t off = ELF_PHDR_OFF + (sizeof (*phdr) * idx);
-
-    emit_bytes(off, phdr);
+    emit_bytes(v, name, strlen(name) + /* NULL byte. */1);
 }
 
 static int dispatch_section_type(const char *name)
@@ -87,30 +100,32 @@ static int dispatch_section_type(const char *name)
         return SHT_STRTAB;
     if (!strcmp(name, ".symtab"))
         return SHT_SYMTAB;
+    if (!strcmp(name, ".rela.text"))
+        return SHT_RELA;
 
     weak_unreachable("Don't know which section type assign to `%s`", name);
 }
 
-static uint16_t emit_phdrs(uint64_t text_size)
+/* Null symbol and, in object file, .text section symbol
+   precede global ones. */
+static uint64_t elf_locals()
 {
-    uint16_t phnum = 0;
+    return elf_type == ET_REL ? 2 : 1;
+}
 
-    struct elf_phdr phdr = {
-        .type   = PT_LOAD,
-        .flags  = PF_R | PF_X,
-        .off    = ELF_PHDR_ALIGN,
-        .vaddr  = ELF_ENTRY_ADDR,
-        .paddr  = ELF_ENTRY_ADDR,
-        .memsz  = text_size,
-        .filesz = text_size,
-        .align  = ELF_PHDR_ALIGN
-    };
-    emit_phdr(phnum++, &phdr);
+/* Code lives in output itself, contents of other sections
+   are built by emit_*() functions below. */
+static instr_vector_t *section_data(
+    struct codegen_output *output,
+    struct elf_section    *section
+) {
+    if (!strcmp(section->name, ".text"))
+        return &output->instrs;
 
-    return phnum;
+    return &section->instrs;
 }
 
-struct elf_off {
+struct elf_idx {
     uint64_t strtab;
     uint64_t shstrtab;
     uint64_t symtab;
@@ -119,9 +134,7 @@ struct elf_off {
 
 static void calculate_section_indexes(
     section_vector_t *sections,
-    uint64_t         *text_idx,
-    uint64_t         *strtab_idx,
-    uint64_t         *shstrtab_idx
+    struct elf_idx   *idxs
 ) {
     uint64_t idx = 1;
 
@@ -129,233 +142,346 @@ static void calculate_section_indexes(
         struct elf_section *section = &vector_at(*sections, i);
 
         if (!strcmp(section->name, ".text"))
-            *text_idx = idx;
+            idxs->text = idx;
 
         if (!strcmp(section->name, ".strtab"))
-            *strtab_idx = idx;
+            idxs->strtab = idx;
 
         if (!strcmp(section->name, ".shstrtab"))
-            *shstrtab_idx = idx;
+            idxs->shstrtab = idx;
+
+        if (!strcmp(section->name, ".symtab"))
+            idxs->symtab = idx;
 
         ++idx;
     }
 }
 
-static void emit_shdrs(
-    struct codegen_output *output,
-    section_vector_t      *sections,
-    uint64_t               strtab_idx,
-    struct elf_off        *offs,
-    uint64_t              *text_size
+/* Place sections one after another and return offset
+   of section header table, which follows them. */
+static uint64_t emit_shdrs(
+    struct codegen_output *o,
+    struct elf_idx        *idxs
 ) {
-    uint64_t idx      = 1;
-    uint64_t shnum    = 0;
     uint64_t name_off = 0;
-    uint64_t off      = 0x1000;
+    /* Loadable .text must be at page boundary in
+       executable, object has no such requirement. */
+    uint64_t off      = elf_type == ET_EXEC
+        ? ELF_PHDR_ALIGN
+        : sizeof (struct elf_fhdr);
+
+    vector_clear(elf_shdrs);
 
     struct elf_shdr null_shdr = {
         0
     };
-    emit_shdr(shnum++, &null_shdr);
+    vector_push_back(elf_shdrs, null_shdr);
 
-    vector_foreach(*sections, i) {
-        struct elf_section *section = &vector_at(*sections, i);
+    vector_foreach(o->sections, i) {
+        struct elf_section *section = &vector_at(o->sections, i);
+
+        section->size = section_data(o, section)->count;
 
         struct elf_shdr shdr = {
             .name_ptr  = 0x01 + name_off,
             .type      = dispatch_section_type(section->name),
             .addr      = 0,
-            .off       = off,
-            .size      = section->size + 1, /* I don't know why, but this extra
-                                               byte is required in order to not
-                                               corrupt .symtab mapping in objdump. */
-            .flags     = PF_W,
-            .addralign = 0x4
+            .size      = section->size,
+            .flags     = 0,
+            .addralign = 0x1
         };
 
         name_off += strlen(section->name) + /* NULL byte */ 1;
 
-        if (!strcmp(section->name, ".strtab"))
-            offs->strtab = off;
-
-        if (!strcmp(section->name, ".shstrtab"))
-            offs->shstrtab = off;
-
         if (!strcmp(section->name, ".text")) {
-            offs->text = off;
-            shdr.addr = ELF_ENTRY_ADDR;
-            *text_size = section->size + 1;
+            shdr.flags     = SHF_ALLOC | SHF_EXECINSTR;
+            shdr.addralign = ELF_TEXT_ALIGN;
+            if (elf_type == ET_EXEC)
+                shdr.addr = ELF_ENTRY_ADDR;
         }
 
         if (!strcmp(section->name, ".symtab")) {
-            shdr.link    = strtab_idx;
-            shdr.info    = output->symtab.count;
-            shdr.entsize = ELF_SYMTAB_ENTSIZE;
-            offs->symtab = off;
+            shdr.link      = idxs->strtab;
+            /* Index of first global symbol. */
+            shdr.info      = elf_locals();
+            shdr.entsize   = ELF_SYMTAB_ENTSIZE;
+            shdr.addralign = 0x8;
         }
 
-        emit_shdr(shnum++, &shdr);
+        if (!strcmp(section->name, ".rela.text")) {
+            shdr.link      = idxs->symtab;
+            shdr.info      = idxs->text;
+            shdr.flags     = SHF_INFO_LINK;
+            shdr.entsize   = ELF_RELA_ENTSIZE;
+            shdr.addralign = 0x8;
+        }
 
+        off = align_up(off, shdr.addralign);
+        shdr.off = off;
         off += section->size;
-        ++idx;
+
+        vector_push_back(elf_shdrs, shdr);
     }
-}
 
-static uint64_t emit_shstrtab(
-    section_vector_t *sections,
-    uint64_t          shstrtab_off
-) {
-    char *start = &elf_map[shstrtab_off];
-    char *s     = start;
+    return align_up(off, 0x8);
+}
 
+static void emit_shstrtab(section_vector_t *sections, instr_vector_t *v)
+{
     /* Placeholder first symbol, which is empty.
        Required by first NULL section */
-    s = emit_symbol(s, "");
+    emit_symbol(v, "");
 
     vector_foreach(*sections, i) {
         struct elf_section *section = &vector_at(*sections, i);
 
-        s = emit_symbol(s, section->name);
+        emit_symbol(v, section->name);
     }
-
-    return s - start;
-}
-
-static void emit_text(
-    struct codegen_output *output,
-    uint64_t               text_off
-) {
-    instr_vector_t *text_data = &output->instrs;
-
-    /* TODO: Pretty large text section smashes ELF by overriding
-             some parts. */
-    emit_bytes_cnt(text_off, text_data->data, text_data->size);
 }
 
 static void emit_symtab(
-    struct elf_off        *offs,
-    uint64_t               text_idx,
-    struct codegen_output *o
+    struct elf_idx        *idxs,
+    struct codegen_output *o,
+    instr_vector_t        *strtab,
+    instr_vector_t        *symtab
 ) {
-    char     *s   = &elf_map[offs->strtab];
-    uint64_t  it  = 0;
-    uint64_t  off = offs->symtab;
+    /* Symbols of object file are relative to section. */
+    uint64_t base = elf_type == ET_EXEC ? ELF_ENTRY_ADDR : 0;
 
-    s = emit_symbol(s, "");
+    emit_symbol(strtab, "");
 
     /* First symtab entry is empty. */
     struct elf_sym null_sym = {0};
-    emit_bytes(off, &null_sym);
+    emit_bytes(symtab, &null_sym, sizeof (null_sym));
+
+    if (elf_type == ET_REL) {
+        struct elf_sym sym = {
+            .info   = ELF64_ST_INFO(STB_LOCAL, STT_SECTION),
+            .other  = STV_DEFAULT,
+            .shndx  = idxs->text
+        };
+        emit_bytes(symtab, &sym, sizeof (sym));
+    }
 
     vector_foreach(o->symtab, i) {
         struct elf_symtab_entry *e = &vector_at(o->symtab, i);
 
-        s = emit_symbol(s, e->name);
-
         struct elf_sym sym = {
-            .name   = 1 + it, /* Offset in .strtab */
+            .name   = strtab->count, /* Offset in .strtab */
             .size   = 0,
-            .value  = ELF_ENTRY_ADDR + e->off,
+            .value  = base + e->off,
             .info   = ELF64_ST_INFO(STB_GLOBAL, STT_FUNC),
             .other  = STV_DEFAULT, /* Visibility. */
-            .shndx  = text_idx
+            .shndx  = idxs->text
         };
 
-        off += ELF_SYMTAB_ENTSIZE;
-        emit_bytes(off, &sym);
+        emit_symbol(strtab, e->name);
+        emit_bytes(symtab, &sym, sizeof (sym));
+    }
+
+    vector_foreach(elf_undef, i) {
+        struct elf_symtab_entry *e = &vector_at(elf_undef, i);
 
-        it += strlen(e->name) + /* NULL */ 1;
+        struct elf_sym sym = {
+            .name   = strtab->count,
+            .info   = ELF64_ST_INFO(STB_GLOBAL, STT_NOTYPE),
+            .other  = STV_DEFAULT,
+            .shndx  = SHN_UNDEF
+        };
+
+        emit_symbol(strtab, e->name);
+        emit_bytes(symtab, &sym, sizeof (sym));
     }
 }
 
+static void emit_rela(struct codegen_output *o, instr_vector_t *v)
+{
+    vector_foreach(o->relocs, i) {
+        struct elf_reloc *r   = &vector_at(o->relocs, i);
+        bool              ok  = 0;
+        uint64_t          sym = hashmap_get(&elf_undef_idx, crc32_string(r->name), &ok);
+
+        if (!ok)
+            weak_unreachable("Relocation against unknown symbol `%s`.", r->name);
+
+        struct elf_rela rela = {
+            .off    = r->off + ELF_R_CALL_FIELD,
+            .info   = ELF64_R_INFO(sym, ELF_R_CALL),
+            .addend = ELF_R_CALL_ADDEND
+        };
+
+        emit_bytes(v, &rela, sizeof (rela));
+    }
+}
+
+static void emit_phdr(uint64_t text_size)
+{
+    struct elf_phdr phdr = {
+        .type   = PT_LOAD,
+        .flags  = PF_R | PF_X,
+        .off    = ELF_PHDR_ALIGN,
+        .vaddr  = ELF_ENTRY_ADDR,
+        .paddr  = ELF_ENTRY_ADDR,
+        .memsz  = text_size,
+        .filesz = text_size,
+        .align  = ELF_PHDR_ALIGN
+    };
+
+    elf_phdr = phdr;
+}
+
 static void emit_fhdr(
-    uint64_t text_size,
+    uint64_t shoff,
     uint64_t shstrtab_idx,
     uint64_t shnum
 ) {
-     struct elf_fhdr fhdr = {
+    bool exec = elf_type == ET_EXEC;
+
+    struct elf_fhdr fhdr = {
         .ident     = "\x7F\x45\x4C\x46\x02\x01\x01",
-        .type      = ET_EXEC,
+        .type      = elf_type,
         .machine   = ELF_TARGET_ARCH,
         .version   = 2,
-        .entry     = ELF_ENTRY_ADDR,
-        .phoff     = ELF_PHDR_OFF,
-        .shoff     = ELF_SH_OFF,
-        .flags     = 0x00,
+        .entry     = exec ? ELF_ENTRY_ADDR : 0,
+        .phoff     = exec ? ELF_PHDR_OFF : 0,
+        .shoff     = shoff,
+        .flags     = ELF_TARGET_FLAGS,
         .ehsize    = 0x40,
-        .phentsize = sizeof (struct elf_phdr),
-        .phnum     = emit_phdrs(text_size),
+        .phentsize = exec ? sizeof (struct elf_phdr) : 0,
+        .phnum     = exec ? 1 : 0,
         .shentsize = ELF_SH_SIZE,
         .shnum     = shnum + /* First NULL section */ 1,
         .shstrndx  = shstrtab_idx
     };
 
-    emit_bytes(0x00, &fhdr);
+    elf_fhdr = fhdr;
+}
+
+/* Queue `size` bytes at file offset `off`. Gap after
+   previous part is filled with zeros. */
+static void emit_iov(uint64_t off, const void *data, uint64_t size)
+{
+    while (elf_iov_off < off) {
+        uint64_t pad = off - elf_iov_off;
+
+        if (pad > sizeof (elf_zeros))
+            pad = sizeof (elf_zeros);
+
+        struct iovec iov = {
+            .iov_base = (void *) elf_zeros,
+            .iov_len  = pad
+        };
+        vector_push_back(elf_iov, iov);
+        elf_iov_off += pad;
+    }
+
+    if (size == 0)
+        return;
+
+    struct iovec iov = {
+        .iov_base = (void *) data,
+        .iov_len  = size
+    };
+    vector_push_back(elf_iov, iov);
+    elf_iov_off += size;
+}
+
+/* Write all queued parts, resuming after partial
+   writes. */
+static void write_iov()
+{
+    struct iovec *iov = elf_iov.data;
+    uint64_t      cnt = elf_iov.count;
+    uint64_t      off = 0;
+
+    while (cnt > 0) {
+        ssize_t n = pwritev(elf_fd, iov, cnt > ELF_IOV_MAX ? ELF_IOV_MAX : cnt, off);
+
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            weak_fatal_errno("pwritev()");
+        }
+
+        off += n;
+
+        while (cnt > 0 && (size_t) n >= iov->iov_len) {
+            n -= iov->iov_len;
+            ++iov;
+            --cnt;
+        }
+
+        if (cnt > 0) {
+            iov->iov_base  = (uint8_t *) iov->iov_base + n;
+            iov->iov_len  -= n;
+        }
+    }
 }
 
 void elf_init(struct elf_entry *e)
 {
-    elf_fd = open(e->filename, O_CREAT | O_TRUNC | O_RDWR, 0666);
-
-    if (ftruncate(elf_fd, ELF_INIT_SIZE) < 0)
-        weak_fatal_errno("ftruncate()");
-
-    elf_map = (char *) mmap(NULL, ELF_INIT_SIZE, PROT_WRITE | PROT_READ, MAP_SHARED, elf_fd, 0);
-    if (elf_map == MAP_FAILED)
-        weak_fatal_errno("mmap()");
-
-    uint64_t       text_idx       = 0;
-    uint64_t       strtab_idx     = 0;
-    uint64_t       shstrtab_idx   = 0;
-    uint64_t       text_size      = 0;
-    struct elf_off offs           = {0};
-
-    calculate_section_indexes(
-        &e->output.sections,
-        &text_idx,
-        &strtab_idx,
-        &shstrtab_idx
-    );
-
-    emit_shdrs(
-        &e->output,
-        &e->output.sections,
-        strtab_idx,
-        &offs,
-        &text_size
-    );
-
-    emit_text(
-        &e->output,
-        offs.text
-    );
-
-    /* At this number sections names in .shstrtab
-       ends. We should put strings for .symtab 
-       starting from it. */
-    emit_shstrtab(
-        &e->output.sections,
-        offs.shstrtab
-    );
-
-    emit_symtab(
-        &offs,
-        text_idx,
-        &e->output
-    );
-
-    emit_fhdr(
-        text_size,
-        shstrtab_idx,
-        e->output.sections.count
-    );
+    struct codegen_output *o    = &e->output;
+    struct elf_idx         idxs = {0};
+
+    elf_type = e->type;
+
+    calculate_section_indexes(&o->sections, &idxs);
+
+    vector_foreach(o->sections, i) {
+        struct elf_section *s = &vector_at(o->sections, i);
+
+        if (!strcmp(s->name, ".shstrtab")) {
+            vector_clear(s->instrs);
+            emit_shstrtab(&o->sections, &s->instrs);
+        }
+
+        if (!strcmp(s->name, ".rela.text")) {
+            vector_clear(s->instrs);
+            emit_rela(o, &s->instrs);
+        }
+    }
+
+    if (idxs.symtab) {
+        instr_vector_t *strtab = elf_lookup_section(o, ".strtab");
+        instr_vector_t *symtab = elf_lookup_section(o, ".symtab");
+
+        vector_clear(*strtab);
+        vector_clear(*symtab);
+        emit_symtab(&idxs, o, strtab, symtab);
+    }
+
+    /* Now sizes of all sections are known. */
+    uint64_t shoff = emit_shdrs(o, &idxs);
+
+    emit_phdr(o->instrs.count);
+    emit_fhdr(shoff, idxs.shstrtab, o->sections.count);
+
+    vector_clear(elf_iov);
+    elf_iov_off = 0;
+
+    emit_iov(0, &elf_fhdr, sizeof (elf_fhdr));
+
+    if (elf_type == ET_EXEC)
+        emit_iov(ELF_PHDR_OFF, &elf_phdr, sizeof (elf_phdr));
+
+    vector_foreach(o->sections, i) {
+        struct elf_section *s    = &vector_at(o->sections, i);
+        struct elf_shdr    *shdr = &vector_at(elf_shdrs, i + 1);
+
+        emit_iov(shdr->off, section_data(o, s)->data, shdr->size);
+    }
+
+    emit_iov(shoff, elf_shdrs.data, elf_shdrs.count * sizeof (struct elf_shdr));
+
+    elf_fd = open(e->filename, O_CREAT | O_TRUNC | O_WRONLY, 0755);
+    if (elf_fd < 0)
+        weak_fatal_errno("open(%s)", e->filename);
+
+    write_iov();
 }
 
 void elf_exit(struct elf_entry *e)
 {
-    if (munmap(elf_map, ELF_INIT_SIZE) < 0)
-        weak_fatal_errno("munmap()");
-
     if (close(elf_fd) < 0)
         weak_fatal_errno("close()");
 
@@ -367,29 +493,79 @@ void elf_exit(struct elf_entry *e)
         vector_free(s->instrs);
     }
     vector_free(o->sections);
+    vector_free(elf_undef);
+    vector_free(elf_shdrs);
+    vector_free(elf_iov);
+    hashmap_destroy(&elf_undef_idx);
+}
+
+/* Give .symtab index to each distinct function, which
+   is called, but not defined. */
+static void collect_undef(struct codegen_output *output)
+{
+    vector_clear(elf_undef);
+    hashmap_reset(&elf_undef_idx, 32);
+
+    vector_foreach(output->relocs, i) {
+        struct elf_reloc *r   = &vector_at(output->relocs, i);
+        uint64_t          crc = crc32_string(r->name);
+
+        if (hashmap_has(&elf_undef_idx, crc))
+            continue;
+
+        struct elf_symtab_entry e = {0};
+        strncpy(e.name, r->name, sizeof (e.name) - 1);
+
+        hashmap_put(&elf_undef_idx, crc, elf_locals() + output->symtab.count + elf_undef.count);
+        vector_push_back(elf_undef, e);
+    }
+}
+
+void elf_write(struct codegen_output *output, const char *path, uint16_t type)
+{
+    elf_type = type;
+    collect_undef(output);
+
+    static const char *sections[] = {
+        ".text",
+        ".rela.text",
+        ".strtab",
+        ".shstrtab",
+        ".symtab"
+    };
+
+    for (uint64_t i = 0; i < __weak_array_size(sections); ++i) {
+        /* Executable has no relocations. */
+        if (type == ET_EXEC && !strcmp(sections[i], ".rela.text"))
+            continue;
+
+        elf_init_section(output, sections[i]);
+    }
+
+    struct elf_entry elf = {
+        .filename = path,
+        .type     = type,
+        .output   = *output
+    };
+
+    elf_init(&elf);
+    elf_exit(&elf);
+
+    /* Freed by elf_exit() through copy. */
+    memset(&output->fn_offsets, 0, sizeof (output->fn_offsets));
+    memset(&output->sections, 0, sizeof (output->sections));
 }
 
 void elf_init_section(
     struct codegen_output *output,
-    const char            *section,
-    uint64_t               size
+    const char            *section
 ) {
     struct elf_section  s = {0};
 
-    s.size = size;
     strncpy(s.name, section, sizeof (s.name) - 1);
     vector_push_back(output->sections, s);
 }
 
-void elf_init_symtab(
-    struct codegen_output *output,
-    uint64_t               syms_cnt
-) {
-    /* Reserve space for first NULL .symtab entry. */
-    ++syms_cnt;
-    elf_init_section(output, ".symtab", syms_cnt * ELF_SYMTAB_ENTSIZE);
-}
-
 instr_vector_t *elf_lookup_section(
     struct codegen_output *output,
     const char            *section
@@ -20,10 +20,38 @@
            structure into a file.
 */
 
+#define EF_RISCV_RVC        0x0001
+
+#define R_X86_64_PLT32         4
+#define R_RISCV_JAL           17
+
+/* Relocation of call instruction:
+   - ELF_R_CALL        relocation type,
+   - ELF_R_CALL_FIELD  offset of patched field from the
+                       start of instruction,
+   - ELF_R_CALL_ADDEND addend, since field is relative to
+                       its own position or next instruction.
+
+   Text of objects is aligned by ELF_TEXT_ALIGN. */
 #if defined CONFIG_USE_BACKEND_RISC_V
 #define ELF_TARGET_ARCH     0xF3
+#if defined CONFIG_USE_RVC
+#define ELF_TARGET_FLAGS    EF_RISCV_RVC
+#define ELF_TEXT_ALIGN      0x02
+#else
+#define ELF_TARGET_FLAGS    0x00
+#define ELF_TEXT_ALIGN      0x04
+#endif /* CONFIG_USE_RVC */
+#define ELF_R_CALL          R_RISCV_JAL
+#define ELF_R_CALL_FIELD    0
+#define ELF_R_CALL_ADDEND   0
 #elif defined CONFIG_USE_BACKEND_X86_64
 #define ELF_TARGET_ARCH     0x3E
+#define ELF_TARGET_FLAGS    0x00
+#define ELF_TEXT_ALIGN      0x01
+#define ELF_R_CALL          R_X86_64_PLT32
+#define ELF_R_CALL_FIELD    1
+#define ELF_R_CALL_ADDEND   (-4)
 #endif
 
 #define EI_NIDENT             16
@@ -98,6 +126,17 @@
 #define STV_HIDDEN            2
 #define STV_PROTECTED         3
 
+#define ELF64_ST_BIND(info)         ((info) >> 4)
+#define ELF64_ST_TYPE(info)         ((info) & 0xf)
+#define ELF64_ST_INFO(bind, type)   (((bind) << 4) + ((type) & 0xf))
+
+#define ELF64_R_SYM(info)           ((info) >> 32)
+#define ELF64_R_TYPE(info)          ((info) & 0xffffffff)
+#define ELF64_R_INFO(sym, type)     (((uint64_t) (sym) << 32) + (type))
+
+/* Special section indexes. */
+#define SHN_UNDEF             0
+
 #define PT_NULL               0
 #define PT_LOAD               1
 #define PT_DYNAMIC            2
@@ -213,10 +252,20 @@ struct packed elf_sym {
     uint64_t size;
 };
 
+struct packed elf_rela {
+    /* Offset of relocated field in section. */
+    uint64_t off;
+    /* Symbol index and relocation type. */
+    uint64_t info;
+    /* Constant, added to symbol value. */
+    int64_t  addend;
+};
+
 typedef vector_t(uint8_t) instr_vector_t;
 
 struct elf_section {
     char           name[128];
+    /* Computed by writer from contents. */
     uint64_t       size;
     instr_vector_t instrs;
 };
@@ -226,7 +275,15 @@ struct elf_symtab_entry {
     uint64_t       off;
 };
 
+/* Call at .text offset `off` to function `name`, which
+   is not defined in this unit. */
+struct elf_reloc {
+    char           name[128];
+    uint64_t       off;
+};
+
 typedef vector_t(struct elf_symtab_entry) symtab_vector_t;
+typedef vector_t(struct elf_reloc) reloc_vector_t;
 typedef vector_t(struct elf_section) section_vector_t;
 
 struct codegen_output {
@@ -234,23 +291,24 @@ struct codegen_output {
     instr_vector_t        instrs;
     section_vector_t      sections;
     symtab_vector_t       symtab;
+    reloc_vector_t        relocs;
 };
 
 struct elf_entry {
     const char *filename;
+    /* ET_EXEC or ET_REL. */
+    uint16_t    type;
     struct codegen_output
                 output;
 };
 
+/* Add empty section. Contents of .text are taken from
+   output->instrs, of symbol and string tables are built
+   while writing, other sections are written from their
+   `instrs`. */
 void elf_init_section(
     struct codegen_output *output,
-    const char            *section,
-    uint64_t               size
-);
-
-void elf_init_symtab(
-    struct codegen_output *output,
-    uint64_t               syms_cnt
+    const char            *section
 );
 
 instr_vector_t *elf_lookup_section(
@@ -261,4 +319,10 @@ instr_vector_t *elf_lookup_section(
 void elf_init(struct elf_entry *e);
 void elf_exit(struct elf_entry *e);
 
+/* Write code of `output` to `path` as executable (`type`
+   is ET_EXEC) or relocatable object (ET_REL). In object,
+   calls from output->relocs are relocations against
+   undefined symbols. */
+void elf_write(struct codegen_output *output, const char *path, uint16_t type);
+
 #endif // WEAK_COMPILER_BACKEND_ELF_H
\ No newline at end of file
@@ -6,37 +6,151 @@
 
 #include "back_end/emit.h"
 #include "back_end/back_end.h"
+#include "back_end/sched.h"
 
-/*** Temporary ***/
-#include "back_end/risc_v.h"
-/***           ***/
-
+#include "front_end/lex/data_type.h"
+#include "front_end/lex/tok_type.h"
+#include "middle_end/ir/frame.h"
 #include "middle_end/ir/ir.h"
+#include "middle_end/ir/ir_dump.h"
+#include "middle_end/ir/regalloc.h"
 #include "util/compiler.h"
 #include "util/hashmap.h"
 #include "util/crc32.h"
 #include "util/unreachable.h"
 #include <stdbool.h>
 #include <string.h>
+#if defined CONFIG_USE_BACKEND_X86_64
+#include <asm/unistd_64.h>
+#else
 #include <asm-generic/unistd.h>
+#endif
+
+/* Variables, which got register from ir_reg_alloc(), live
+   in callee-saved registers. The rest live in stack frame
+   and are addressed relative to stack pointer.
+
+   Frame layout (from stack pointer upwards):
+   - variables, placed by ir_frame_build(),
+   - arguments, which got no register, 8 bytes each,
+   - callee-saved registers, written by function.
+
+   Expressions are computed in temporary registers, which
+   are allocated for one statement. */
+
+#define REGS_LIMIT 32
 
 /**********************************************
  * Variable mapping                           *
  **********************************************/
 
-/* How much stack space is occupied by
-   variables. */
-static uint64_t stack_off;
-
 /* key:   CRC-32 name of a function
-   value: .text offset */
+   value: label */
 static hashmap_t mapping_fn;
-/* key:   CRC-32 name of a variable
+/* key:   variable index
    value: stack offset */
 static hashmap_t mapping;
-/* key:   CRC-32 name
-   value: type */
+/* key:   variable index
+   value: type, packed by type_pack() */
 static hashmap_t mapping_type;
+/* key:   statement address
+   value: label */
+static hashmap_t mapping_stmt;
+
+/**********************************************
+ * Function state                             *
+ **********************************************/
+
+static bool     fn_main;
+static uint64_t fn_ret_label;
+static uint64_t fn_stack_usage;
+/* Callee-saved registers, written by function, and
+   their offsets in frame. */
+static int      fn_saved[REGS_LIMIT];
+static uint64_t fn_saved_off[REGS_LIMIT];
+static uint64_t fn_saved_size;
+/* Displacement of stack pointer made by IR_PUSH. */
+static uint64_t sp_shift;
+
+/* Registers are given by target in back_end_gen(). */
+static int      tmp_regs[REGS_LIMIT];
+static uint64_t tmp_regs_size;
+/* Bit i is set if tmp_regs[i] holds value. */
+static uint32_t tmp_regs_busy;
+static uint64_t tmp_regs_next;
+
+/**********************************************
+ * Types                                      *
+ **********************************************/
+
+struct var_type {
+    enum data_type dt;
+    uint64_t       ptr_depth;
+    bool           array;
+};
+
+static uint64_t type_pack(enum data_type dt, uint64_t ptr_depth, bool array)
+{
+    return (uint64_t) dt | (ptr_depth << 8) | ((uint64_t) array << 32);
+}
+
+static struct var_type type_of(uint64_t idx)
+{
+    bool     ok     = 0;
+    uint64_t bits   = hashmap_get(&mapping_type, idx, &ok);
+
+    if (!ok)
+        weak_fatal_error("Cannot get type of `t%lu`", idx);
+
+    return (struct var_type) {
+        .dt        = bits & 0xFF,
+        .ptr_depth = (bits >> 8) & 0xFFFFFF,
+        .array     = bits >> 32
+    };
+}
+
+static uint64_t type_size(enum data_type dt, uint64_t ptr_depth)
+{
+    if (ptr_depth > 0)
+        return 8;
+
+    switch (dt) {
+    case D_T_BOOL:
+    case D_T_CHAR:
+        return 1;
+    case D_T_INT:
+        return 4;
+    case D_T_FLOAT:
+        weak_fatal_error("Floating point is not supported by native back end.");
+    default:
+        weak_unreachable("Cannot get size of `%s`.", data_type_to_string(dt));
+    }
+}
+
+/* Pointer depth of value, which expression yields. Arrays
+   yield address of their first element. */
+static uint64_t expr_ptr_depth(struct ir_node *ir)
+{
+    if (ir->type != IR_SYM)
+        return 0;
+
+    struct ir_sym  *sym  = ir->ir;
+    struct var_type type = type_of(sym->idx);
+    uint64_t        ptr  = type.ptr_depth + type.array;
+
+    if (sym->addr_of) return ptr + 1;
+    if (sym->deref)   return ptr - 1;
+    return ptr;
+}
+
+/* Size of object, pointed by value of expression. */
+static uint64_t expr_pointee_size(struct ir_node *ir)
+{
+    struct ir_sym  *sym  = ir->ir;
+    struct var_type type = type_of(sym->idx);
+
+    return type_size(type.dt, expr_ptr_depth(ir) - 1);
+}
 
 /**********************************************
  * Codegen                                    *
@@ -50,211 +164,1232 @@ static uint64_t offset_of(uint64_t alloca_idx)
     if (!ok)
         weak_fatal_error("Cannot get stack offset for `t%lu`\n", alloca_idx);
 
-    return off;
+    return off + sp_shift;
+}
+
+/* Search starts after last given register, so
+   neighbouring statements compute in different
+   registers and scheduler is free to overlap them. */
+static int tmp_reg()
+{
+    for (uint64_t n = 0; n < tmp_regs_size; ++n) {
+        uint64_t i = (tmp_regs_next + n) % tmp_regs_size;
+
+        if (tmp_regs_busy & (1U << i))
+            continue;
+
+        tmp_regs_busy |= 1U << i;
+        tmp_regs_next  = (i + 1) % tmp_regs_size;
+        return tmp_regs[i];
+    }
+
+    weak_fatal_error("No free registers.");
+}
+
+static bool tmp_is(int reg)
+{
+    for (uint64_t i = 0; i < tmp_regs_size; ++i)
+        if (tmp_regs[i] == reg)
+            return tmp_regs_busy & (1U << i);
+
+    return 0;
+}
+
+/* Release temporary, whose value is consumed. Other
+   registers are ignored. */
+static void tmp_free(int reg)
+{
+    for (uint64_t i = 0; i < tmp_regs_size; ++i)
+        if (tmp_regs[i] == reg)
+            tmp_regs_busy &= ~(1U << i);
+}
+
+/* Label is created on first reference, so jump may
+   be emitted before its target. */
+static uint64_t stmt_label(struct ir_node *ir)
+{
+    uint64_t key   = (uint64_t) ir;
+    bool     ok    = 0;
+    uint64_t label = hashmap_get(&mapping_stmt, key, &ok);
+
+    if (!ok) {
+        label = back_end_label();
+        hashmap_put(&mapping_stmt, key, label);
+    }
+
+    return label;
+}
+
+static void load(int dst, int addr, int off, enum data_type dt, uint64_t ptr_depth)
+{
+    if (ptr_depth > 0) {
+        sched_put(SCHED_LD, dst, addr, off);
+        return;
+    }
+
+    switch (dt) {
+    case D_T_BOOL: sched_put(SCHED_LBU, dst, addr, off); break;
+    case D_T_CHAR: sched_put(SCHED_LB, dst, addr, off); break;
+    case D_T_INT:  sched_put(SCHED_LW, dst, addr, off); break;
+    case D_T_FLOAT:
+        weak_fatal_error("Floating point is not supported by native back end.");
+    default:
+        weak_unreachable("Cannot load `%s`.", data_type_to_string(dt));
+    }
+}
+
+static void store(int reg, int addr, int off, enum data_type dt, uint64_t ptr_depth)
+{
+    if (ptr_depth > 0) {
+        sched_put(SCHED_SD, reg, addr, off);
+        return;
+    }
+
+    switch (dt) {
+    case D_T_BOOL:
+    case D_T_CHAR: sched_put(SCHED_SB, reg, addr, off); break;
+    case D_T_INT:  sched_put(SCHED_SW, reg, addr, off); break;
+    case D_T_FLOAT:
+        weak_fatal_error("Floating point is not supported by native back end.");
+    default:
+        weak_unreachable("Cannot store `%s`.", data_type_to_string(dt));
+    }
 }
 
 static void visit(struct ir_node *ir);
+static int  visit_expr(struct ir_node *ir, int dst);
+static void visit_fn_call(struct ir_fn_call *ir);
+
+static void visit_alloca(struct ir_node *ir, uint64_t off)
+{
+    struct ir_alloca *alloca = ir->ir;
+
+    hashmap_put(&mapping, alloca->idx, off);
+    hashmap_put(&mapping_type, alloca->idx, type_pack(alloca->dt, alloca->ptr_depth, 0));
+}
+
+static void visit_alloca_array(struct ir_alloca_array *ir)
+{
+    hashmap_put(&mapping, ir->idx, ir->frame_off);
+    hashmap_put(&mapping_type, ir->idx, type_pack(ir->dt, 0, /*array=*/1));
+}
+
+static int visit_imm(struct ir_imm *ir, int dst)
+{
+    switch (ir->type) {
+    case IMM_BOOL: sched_put(SCHED_LI, dst, ir->imm.__bool, 0); break;
+    case IMM_CHAR: sched_put(SCHED_LI, dst, ir->imm.__char, 0); break;
+    case IMM_INT:  sched_put(SCHED_LI, dst, ir->imm.__int, 0); break;
+    case IMM_FLOAT:
+        weak_fatal_error("Floating point is not supported by native back end.");
+    default:
+        weak_unreachable("Unknown immediate type (numeric: %d).", ir->type);
+    }
+
+    return dst;
+}
+
+/* Value of variable itself, ignoring & and *. Register
+   variables are used in place, if `dst` is -1. */
+static int visit_var(struct ir_node *ir, int dst)
+{
+    struct ir_sym  *sym  = ir->ir;
+    struct var_type type = type_of(sym->idx);
+
+    if (type.array) {
+        int reg = dst != -1 ? dst : tmp_reg();
+        sched_put(SCHED_ADDI, reg, back_end_sp_reg(), offset_of(sym->idx));
+        return reg;
+    }
+
+    if (ir->claimed_reg != IR_NO_CLAIMED_REG) {
+        if (dst != -1 && dst != ir->claimed_reg)
+            sched_put(SCHED_ADDI, dst, ir->claimed_reg, 0);
+        return dst != -1 ? dst : ir->claimed_reg;
+    }
+
+    int reg = dst != -1 ? dst : tmp_reg();
+    load(reg, back_end_sp_reg(), offset_of(sym->idx), type.dt, type.ptr_depth);
+    return reg;
+}
+
+static int visit_sym(struct ir_node *ir, int dst)
+{
+    struct ir_sym  *sym  = ir->ir;
+    struct var_type type = type_of(sym->idx);
+
+    if (sym->addr_of) {
+        int reg = dst != -1 ? dst : tmp_reg();
+        sched_put(SCHED_ADDI, reg, back_end_sp_reg(), offset_of(sym->idx));
+        return reg;
+    }
+
+    if (sym->deref) {
+        int addr = visit_var(ir, -1);
+        int reg  = dst != -1 ? dst : tmp_is(addr) ? addr : tmp_reg();
+        load(reg, addr, 0, type.dt, type.ptr_depth - 1);
+        if (addr != reg)
+            tmp_free(addr);
+        return reg;
+    }
 
-static void visit_alloca(struct ir_alloca *ir)
+    return visit_var(ir, dst);
+}
+
+/* Integer offset is given in elements, so scale it by
+   size of pointee. Variable is copied to not change it. */
+static int scale(int reg, uint64_t size)
 {
-    uint64_t size = data_type_size[ir->dt];
+    if (size == 1)
+        return reg;
 
-    hashmap_put(&mapping, ir->idx, stack_off);
-    hashmap_put(&mapping_type, ir->idx, ir->dt);
+    if (!tmp_is(reg)) {
+        int tmp = tmp_reg();
+        sched_put(SCHED_ADDI, tmp, reg, 0);
+        reg = tmp;
+    }
 
-    printf("Allocating t%lu at offset %lu\n", ir->idx, offset_of(ir->idx));
+    for (; size > 1; size >>= 1)
+        sched_put(SCHED_ADD, reg, reg, reg);
 
-    stack_off += size;
+    return reg;
 }
 
-struct tmp_reg {
-    int reg;
-    int busy;
+/**********************************************
+ * Instruction selection                      *
+ **********************************************/
+
+/* Expression trees are covered with patterns from `rules`
+   in bottom-up rewrite system (BURS) manner. First, each
+   node is labeled with the cheapest rule producing every
+   nonterminal from it, including costs of operands. Then
+   tree is reduced from the root, emitting chosen rules.
+
+   So `x + 5` becomes single addiw, comparison under
+   condition becomes single branch and constant array
+   index is folded into stack offset.
+
+   Costs are numbers of RISC-V instructions. */
+
+enum nt {
+    NT_REG,   /* Value in register. */
+    NT_IMM,   /* Signed 12-bit immediate. */
+    NT_ZERO,  /* Immediate 0. */
+    NT_ADDR,  /* Stack pointer + constant. */
+    NT_COND,  /* Branch to `cond_label`, taken if value is true. */
+    NT_COUNT
+};
+
+struct operand {
+    /* NT_REG. */
+    int     reg;
+    /* NT_IMM, NT_ZERO, or offset from stack pointer for NT_ADDR. */
+    int64_t imm;
+};
+
+struct state;
+
+typedef bool           (*match_t) (struct ir_node *ir);
+typedef struct operand (*reduce_t)(struct state *s, struct operand *kids, int dst);
+
+struct rule {
+    /* Produced nonterminal. */
+    enum nt          nt;
+    /* Chain rule converts `kids[0]` to `nt` and does not
+       look at IR. */
+    bool             chain;
+    /* Root of pattern. */
+    enum ir_type     type;
+    /* Operator of IR_BIN. */
+    enum token_type  op;
+    /* Nonterminals of IR_BIN operands. */
+    enum nt          kids[2];
+    /* Cost of rule itself, without operands. */
+    uint64_t         cost;
+    /* Additional condition or NULL. */
+    match_t          match;
+    reduce_t         reduce;
+};
+
+struct state {
+    struct ir_node    *ir;
+    struct state      *kids[2];
+    uint64_t           cost[NT_COUNT];
+    const struct rule *rule[NT_COUNT];
 };
 
-static struct tmp_reg __tmp_reg_1 = { .reg = risc_v_reg_t0, /* busy */ 0 };
-static struct tmp_reg __tmp_reg_2 = { .reg = risc_v_reg_t1, /* busy */ 0 };
+#define STATES_LIMIT 64
+#define COST_INF     UINT64_MAX
 
-static struct tmp_reg *__tmp_reg_active;
+static struct state states[STATES_LIMIT];
+static uint64_t     states_size;
+static uint64_t     cond_label;
 
-static struct tmp_reg *select_tmp_reg()
+/****   Patterns   ****/
+
+static int64_t imm_value(struct ir_node *ir)
 {
-         if (!__tmp_reg_1.busy) { __tmp_reg_active = &__tmp_reg_1; }
-    else if (!__tmp_reg_2.busy) { __tmp_reg_active = &__tmp_reg_2; }
-    else
-        weak_fatal_error("No free registers.");
+    struct ir_imm *imm = ir->ir;
 
-    return __tmp_reg_active;
+    switch (imm->type) {
+    case IMM_BOOL: return imm->imm.__bool;
+    case IMM_CHAR: return imm->imm.__char;
+    case IMM_INT:  return imm->imm.__int;
+    default:
+        weak_unreachable("Immediate is not integer (numeric: %d).", imm->type);
+    }
 }
 
-static void visit_imm(struct ir_imm *ir)
+static bool fits_imm12(int64_t imm)
 {
-    switch (ir->type) {
-    case IMM_INT:
-        back_end_native_li(select_tmp_reg()->reg, ir->imm.__int);
+    return imm >= -2048 && imm <= 2047;
+}
+
+static bool match_imm12(struct ir_node *ir)
+{
+    struct ir_imm *imm = ir->ir;
+    return imm->type != IMM_FLOAT && fits_imm12(imm_value(ir));
+}
+
+static bool match_zero(struct ir_node *ir)
+{
+    struct ir_imm *imm = ir->ir;
+    return imm->type != IMM_FLOAT && imm_value(ir) == 0;
+}
+
+/* Variable itself, not its address or pointee. */
+static bool sym_plain(struct ir_node *ir)
+{
+    struct ir_sym *sym = ir->ir;
+    return !sym->deref && !sym->addr_of && !type_of(sym->idx).array;
+}
+
+static bool match_sym_reg(struct ir_node *ir)
+{
+    return sym_plain(ir) && ir->claimed_reg != IR_NO_CLAIMED_REG;
+}
+
+static bool match_sym_mem(struct ir_node *ir)
+{
+    return sym_plain(ir) && ir->claimed_reg == IR_NO_CLAIMED_REG;
+}
+
+static bool match_deref_reg(struct ir_node *ir)
+{
+    struct ir_sym *sym = ir->ir;
+    return sym->deref && ir->claimed_reg != IR_NO_CLAIMED_REG;
+}
+
+static bool match_deref_mem(struct ir_node *ir)
+{
+    struct ir_sym *sym = ir->ir;
+    return sym->deref && ir->claimed_reg == IR_NO_CLAIMED_REG;
+}
+
+static bool match_sym_addr(struct ir_node *ir)
+{
+    struct ir_sym *sym = ir->ir;
+    return !sym->deref && (sym->addr_of || type_of(sym->idx).array);
+}
+
+static bool match_int(struct ir_node *ir)
+{
+    struct ir_bin *bin = ir->ir;
+    return !expr_ptr_depth(bin->lhs) && !expr_ptr_depth(bin->rhs);
+}
+
+/* imm + 1 fits, so `x <= imm` is `x < imm + 1`. */
+static bool match_imm_below_max(struct ir_node *ir)
+{
+    struct ir_bin *bin = ir->ir;
+    return match_int(ir) && bin->rhs->type == IR_IMM && imm_value(bin->rhs) < 2047;
+}
+
+/* -imm fits, so `x - imm` is `x + (-imm)`. */
+static bool match_imm_above_min(struct ir_node *ir)
+{
+    struct ir_bin *bin = ir->ir;
+    return match_int(ir) && bin->rhs->type == IR_IMM && imm_value(bin->rhs) > -2048;
+}
+
+static bool match_ptr_imm(struct ir_node *ir)
+{
+    struct ir_bin *bin = ir->ir;
+
+    if (!expr_ptr_depth(bin->lhs) || bin->rhs->type != IR_IMM)
+        return 0;
+
+    return fits_imm12(imm_value(bin->rhs) * expr_pointee_size(bin->lhs));
+}
+
+static bool match_addr(struct ir_node *ir)
+{
+    struct ir_bin *bin = ir->ir;
+    return bin->lhs->type == IR_SYM;
+}
+
+static bool match_zero_reg(unused struct ir_node *ir)
+{
+    return back_end_zero_reg() != -1;
+}
+
+/****   Reductions   ****/
+
+static struct operand operand_reg(int reg)
+{
+    return (struct operand) {.reg = reg, .imm = 0};
+}
+
+/* Destination of result, if it is not given. Operand
+   temporary is reused, since its value is consumed. */
+static int dst_pick(int dst, struct operand *kids)
+{
+    if (dst != -1)
+        return dst;
+    if (tmp_is(kids[0].reg))
+        return kids[0].reg;
+    if (tmp_is(kids[1].reg))
+        return kids[1].reg;
+
+    return tmp_reg();
+}
+
+static void kids_free(struct operand *kids, int dst)
+{
+    if (kids[0].reg != dst) tmp_free(kids[0].reg);
+    if (kids[1].reg != dst) tmp_free(kids[1].reg);
+}
+
+static struct operand emit_imm(struct state *s, unused struct operand *kids, unused int dst)
+{
+    return (struct operand) {.reg = -1, .imm = imm_value(s->ir)};
+}
+
+static struct operand emit_li_imm(struct state *s, unused struct operand *kids, int dst)
+{
+    return operand_reg(visit_imm(s->ir->ir, dst != -1 ? dst : tmp_reg()));
+}
+
+static struct operand emit_sym(struct state *s, unused struct operand *kids, int dst)
+{
+    return operand_reg(visit_sym(s->ir, dst));
+}
+
+static struct operand emit_sym_addr(struct state *s, unused struct operand *kids, unused int dst)
+{
+    struct ir_sym *sym = s->ir->ir;
+    return (struct operand) {.reg = -1, .imm = offset_of(sym->idx)};
+}
+
+static struct operand emit_call(struct state *s, unused struct operand *kids, int dst)
+{
+    visit_fn_call(s->ir->ir);
+
+    int reg = dst != -1 ? dst : tmp_reg();
+    if (reg != back_end_return_reg())
+        sched_put(SCHED_ADDI, reg, back_end_return_reg(), 0);
+
+    return operand_reg(reg);
+}
+
+static struct operand emit_li(unused struct state *s, struct operand *kids, int dst)
+{
+    int reg = dst_pick(dst, kids);
+    sched_put(SCHED_LI, reg, kids[0].imm, 0);
+    return operand_reg(reg);
+}
+
+static struct operand emit_addr(unused struct state *s, struct operand *kids, int dst)
+{
+    int reg = dst_pick(dst, kids);
+    sched_put(SCHED_ADDI, reg, back_end_sp_reg(), kids[0].imm);
+    return operand_reg(reg);
+}
+
+static struct operand emit_addr_bin(struct state *s, struct operand *kids, unused int dst)
+{
+    struct ir_bin *bin = s->ir->ir;
+    int64_t        off = kids[1].imm * expr_pointee_size(bin->lhs);
+
+    return (struct operand) {
+        .reg = -1,
+        .imm = kids[0].imm + (bin->op == TOK_PLUS ? off : -off)
+    };
+}
+
+static struct operand emit_bin_rr(struct state *s, struct operand *kids, int dst)
+{
+    struct ir_bin *ir    = s->ir->ir;
+    uint64_t       l_ptr = expr_ptr_depth(ir->lhs);
+    uint64_t       r_ptr = expr_ptr_depth(ir->rhs);
+    bool           sext  = 0;
+
+    if ((ir->op == TOK_PLUS || ir->op == TOK_MINUS) && (!l_ptr != !r_ptr)) {
+        if (l_ptr) kids[1].reg = scale(kids[1].reg, expr_pointee_size(ir->lhs));
+        else       kids[0].reg = scale(kids[0].reg, expr_pointee_size(ir->rhs));
+    }
+
+    int l = kids[0].reg;
+    int r = kids[1].reg;
+
+    dst = dst_pick(dst, kids);
+
+    switch (ir->op) {
+    case TOK_PLUS:    sched_put(SCHED_ADD, dst, l, r); sext = !l_ptr && !r_ptr; break;
+    case TOK_MINUS:   sched_put(SCHED_SUB, dst, l, r); sext = !l_ptr && !r_ptr; break;
+    case TOK_STAR:    sched_put(SCHED_MUL, dst, l, r); sext = 1; break;
+    case TOK_SLASH:   sched_put(SCHED_DIV, dst, l, r); break;
+    case TOK_MOD:     sched_put(SCHED_REM, dst, l, r); break;
+    case TOK_SHL:     sched_put(SCHED_SLL, dst, l, r); sext = 1; break;
+    case TOK_SHR:     sched_put(SCHED_SRA, dst, l, r); break;
+    case TOK_BIT_AND: sched_put(SCHED_AND, dst, l, r); break;
+    case TOK_BIT_OR:  sched_put(SCHED_OR, dst, l, r); break;
+    case TOK_XOR:     sched_put(SCHED_XOR, dst, l, r); break;
+    case TOK_MULHI:
+        /* Values are kept sign-extended, so high
+           half of 32-bit product is in bits 32..63. */
+        sched_put(SCHED_MUL, dst, l, r);
+        sched_put(SCHED_SRAI, dst, dst, 32);
+        break;
+    case TOK_LT:
+        sched_put(SCHED_SLT, dst, l, r);
+        break;
+    case TOK_GT:
+        sched_put(SCHED_SLT, dst, r, l);
+        break;
+    case TOK_LE:
+        sched_put(SCHED_SLT, dst, r, l);
+        sched_put(SCHED_XORI, dst, dst, 1);
+        break;
+    case TOK_GE:
+        sched_put(SCHED_SLT, dst, l, r);
+        sched_put(SCHED_XORI, dst, dst, 1);
+        break;
+    case TOK_EQ:
+        sched_put(SCHED_XOR, dst, l, r);
+        sched_put(SCHED_SEQZ, dst, dst, 0);
+        break;
+    case TOK_NEQ:
+        sched_put(SCHED_XOR, dst, l, r);
+        sched_put(SCHED_SNEZ, dst, dst, 0);
+        break;
+    case TOK_AND: {
+        int tmp = tmp_is(l) && l != dst ? l : tmp_reg();
+        sched_put(SCHED_SNEZ, tmp, l, 0);
+        sched_put(SCHED_SNEZ, dst, r, 0);
+        sched_put(SCHED_AND, dst, dst, tmp);
+        tmp_free(tmp);
+        break;
+    }
+    case TOK_OR:
+        sched_put(SCHED_OR, dst, l, r);
+        sched_put(SCHED_SNEZ, dst, dst, 0);
         break;
-    case IMM_BOOL:
-    case IMM_FLOAT:
-    case IMM_CHAR:
     default:
+        weak_unreachable("Unknown binary operator `%s`.", tok_to_string(ir->op));
+    }
+
+    /* Keep 32-bit result sign-extended to 64 bits. */
+    if (sext)
+        sched_put(SCHED_ADDIW, dst, dst, 0);
+
+    kids_free(kids, dst);
+
+    return operand_reg(dst);
+}
+
+/* `l` is register operand and `imm` is immediate one,
+   regardless of their order in `ir`. */
+static int bin_ri(struct ir_bin *ir, struct operand l, int64_t imm, int dst)
+{
+    struct operand kids[2] = {l, {.reg = -1, .imm = 0}};
+    int            reg     = l.reg;
+
+    dst = dst_pick(dst, kids);
+
+    switch (ir->op) {
+    case TOK_PLUS:
+        if (expr_ptr_depth(ir->lhs))
+            sched_put(SCHED_ADDI, dst, reg, imm * expr_pointee_size(ir->lhs));
+        else
+            sched_put(SCHED_ADDIW, dst, reg, imm);
+        break;
+    case TOK_MINUS:   sched_put(SCHED_ADDIW, dst, reg, -imm); break;
+    case TOK_BIT_AND: sched_put(SCHED_ANDI, dst, reg, imm); break;
+    case TOK_BIT_OR:  sched_put(SCHED_ORI, dst, reg, imm); break;
+    case TOK_XOR:     sched_put(SCHED_XORI, dst, reg, imm); break;
+    case TOK_SHL:
+        sched_put(SCHED_SLLI, dst, reg, imm & 31);
+        sched_put(SCHED_ADDIW, dst, dst, 0);
+        break;
+    case TOK_SHR:
+        sched_put(SCHED_SRAI, dst, reg, imm & 31);
+        break;
+    case TOK_LT:
+        sched_put(SCHED_SLTI, dst, reg, imm);
+        break;
+    case TOK_LE:
+        sched_put(SCHED_SLTI, dst, reg, imm + 1);
+        break;
+    case TOK_GT:
+        sched_put(SCHED_SLTI, dst, reg, imm + 1);
+        sched_put(SCHED_XORI, dst, dst, 1);
         break;
+    case TOK_GE:
+        sched_put(SCHED_SLTI, dst, reg, imm);
+        sched_put(SCHED_XORI, dst, dst, 1);
+        break;
+    case TOK_EQ:
+    case TOK_NEQ:
+        if (imm != 0) {
+            sched_put(SCHED_XORI, dst, reg, imm);
+            reg = dst;
+        }
+        if (ir->op == TOK_EQ)
+            sched_put(SCHED_SEQZ, dst, reg, 0);
+        else
+            sched_put(SCHED_SNEZ, dst, reg, 0);
+        break;
+    default:
+        weak_unreachable("Unknown binary operator `%s`.", tok_to_string(ir->op));
+    }
+
+    kids_free(kids, dst);
+
+    return dst;
+}
+
+static struct operand emit_bin_ri(struct state *s, struct operand *kids, int dst)
+{
+    return operand_reg(bin_ri(s->ir->ir, kids[0], kids[1].imm, dst));
+}
+
+/* Commutative operator with immediate on the left. */
+static struct operand emit_bin_ir(struct state *s, struct operand *kids, int dst)
+{
+    return operand_reg(bin_ri(s->ir->ir, kids[1], kids[0].imm, dst));
+}
+
+static void branch(enum token_type op, int l, int r)
+{
+    sched_fixup(cond_label);
+
+    switch (op) {
+    case TOK_EQ:  sched_put(SCHED_BEQ, l, r, 0); break;
+    case TOK_NEQ: sched_put(SCHED_BNE, l, r, 0); break;
+    case TOK_LT:  sched_put(SCHED_BLT, l, r, 0); break;
+    case TOK_GT:  sched_put(SCHED_BLT, r, l, 0); break;
+    case TOK_LE:  sched_put(SCHED_BGE, r, l, 0); break;
+    case TOK_GE:  sched_put(SCHED_BGE, l, r, 0); break;
+    default:
+        weak_unreachable("Cannot branch on `%s`.", tok_to_string(op));
+    }
+}
+
+static struct operand emit_branch_rr(struct state *s, struct operand *kids, unused int dst)
+{
+    struct ir_bin *bin = s->ir->ir;
+
+    branch(bin->op, kids[0].reg, kids[1].reg);
+    kids_free(kids, -1);
+
+    return operand_reg(-1);
+}
+
+static struct operand emit_branch_rz(struct state *s, struct operand *kids, unused int dst)
+{
+    struct ir_bin *bin = s->ir->ir;
+
+    branch(bin->op, kids[0].reg, back_end_zero_reg());
+    kids_free(kids, -1);
+
+    return operand_reg(-1);
+}
+
+static struct operand emit_branch_reg(unused struct state *s, struct operand *kids, unused int dst)
+{
+    int zero = back_end_zero_reg();
+
+    if (zero == -1) {
+        zero = tmp_reg();
+        sched_put(SCHED_LI, zero, 0, 0);
+    }
+
+    sched_fixup(cond_label);
+    sched_put(SCHED_BNE, kids[0].reg, zero, 0);
+    tmp_free(zero);
+    kids_free(kids, -1);
+
+    return operand_reg(-1);
+}
+
+/* Key: Nonterminal, pattern and its cost.
+   Value: Emitted code. */
+static const struct rule rules[] = {
+    /* nt       chain  type        op            kids                cost  match                 reduce */
+
+    /* Leaves. */
+    { NT_IMM,   0,     IR_IMM,     0,            {0},                0,    match_imm12,          emit_imm        },
+    { NT_ZERO,  0,     IR_IMM,     0,            {0},                0,    match_zero,           emit_imm        },
+    { NT_REG,   0,     IR_IMM,     0,            {0},                2,    NULL,                 emit_li_imm     },
+    { NT_REG,   0,     IR_SYM,     0,            {0},                0,    match_sym_reg,        emit_sym        },
+    { NT_REG,   0,     IR_SYM,     0,            {0},                1,    match_sym_mem,        emit_sym        },
+    { NT_REG,   0,     IR_SYM,     0,            {0},                1,    match_deref_reg,      emit_sym        },
+    { NT_REG,   0,     IR_SYM,     0,            {0},                2,    match_deref_mem,      emit_sym        },
+    { NT_ADDR,  0,     IR_SYM,     0,            {0},                0,    match_sym_addr,       emit_sym_addr   },
+    { NT_REG,   0,     IR_FN_CALL, 0,            {0},                1,    NULL,                 emit_call       },
+
+    /* Chain rules. */
+    { NT_REG,   1,     0,          0,            {NT_IMM},           1,    NULL,                 emit_li         },
+    { NT_REG,   1,     0,          0,            {NT_ADDR},          1,    NULL,                 emit_addr       },
+    { NT_COND,  1,     0,          0,            {NT_REG},           1,    match_zero_reg,       emit_branch_reg },
+    { NT_COND,  1,     0,          0,            {NT_REG},           2,    NULL,                 emit_branch_reg },
+
+    /* Constant array index. */
+    { NT_ADDR,  0,     IR_BIN,     TOK_PLUS,     {NT_ADDR, NT_IMM},  0,    match_addr,           emit_addr_bin   },
+    { NT_ADDR,  0,     IR_BIN,     TOK_MINUS,    {NT_ADDR, NT_IMM},  0,    match_addr,           emit_addr_bin   },
+
+    /* Register, register. */
+    { NT_REG,   0,     IR_BIN,     TOK_PLUS,     {NT_REG, NT_REG},   2,    NULL,                 emit_bin_rr     },
+    { NT_REG,   0,     IR_BIN,     TOK_MINUS,    {NT_REG, NT_REG},   2,    NULL,                 emit_bin_rr     },
+    { NT_REG,   0,     IR_BIN,     TOK_STAR,     {NT_REG, NT_REG},   2,    NULL,                 emit_bin_rr     },
+    { NT_REG,   0,     IR_BIN,     TOK_SLASH,    {NT_REG, NT_REG},   1,    NULL,                 emit_bin_rr     },
+    { NT_REG,   0,     IR_BIN,     TOK_MOD,      {NT_REG, NT_REG},   1,    NULL,                 emit_bin_rr     },
+    { NT_REG,   0,     IR_BIN,     TOK_SHL,      {NT_REG, NT_REG},   2,    NULL,                 emit_bin_rr     },
+    { NT_REG,   0,     IR_BIN,     TOK_SHR,      {NT_REG, NT_REG},   1,    NULL,                 emit_bin_rr     },
+    { NT_REG,   0,     IR_BIN,     TOK_BIT_AND,  {NT_REG, NT_REG},   1,    NULL,                 emit_bin_rr     },
+    { NT_REG,   0,     IR_BIN,     TOK_BIT_OR,   {NT_REG, NT_REG},   1,    NULL,                 emit_bin_rr     },
+    { NT_REG,   0,     IR_BIN,     TOK_XOR,      {NT_REG, NT_REG},   1,    NULL,                 emit_bin_rr     },
+    { NT_REG,   0,     IR_BIN,     TOK_MULHI,    {NT_REG, NT_REG},   2,    NULL,                 emit_bin_rr     },
+    { NT_REG,   0,     IR_BIN,     TOK_LT,       {NT_REG, NT_REG},   1,    NULL,                 emit_bin_rr     },
+    { NT_REG,   0,     IR_BIN,     TOK_GT,       {NT_REG, NT_REG},   1,    NULL,                 emit_bin_rr     },
+    { NT_REG,   0,     IR_BIN,     TOK_LE,       {NT_REG, NT_REG},   2,    NULL,                 emit_bin_rr     },
+    { NT_REG,   0,     IR_BIN,     TOK_GE,       {NT_REG, NT_REG},   2,    NULL,                 emit_bin_rr     },
+    { NT_REG,   0,     IR_BIN,     TOK_EQ,       {NT_REG, NT_REG},   2,    NULL,                 emit_bin_rr     },
+    { NT_REG,   0,     IR_BIN,     TOK_NEQ,      {NT_REG, NT_REG},   2,    NULL,                 emit_bin_rr     },
+    { NT_REG,   0,     IR_BIN,     TOK_AND,      {NT_REG, NT_REG},   3,    NULL,                 emit_bin_rr     },
+    { NT_REG,   0,     IR_BIN,     TOK_OR,       {NT_REG, NT_REG},   2,    NULL,                 emit_bin_rr     },
+
+    /* Register, immediate (I-type). */
+    { NT_REG,   0,     IR_BIN,     TOK_PLUS,     {NT_REG, NT_IMM},   1,    match_int,            emit_bin_ri     },
+    { NT_REG,   0,     IR_BIN,     TOK_PLUS,     {NT_REG, NT_IMM},   1,    match_ptr_imm,        emit_bin_ri     },
+    { NT_REG,   0,     IR_BIN,     TOK_MINUS,    {NT_REG, NT_IMM},   1,    match_imm_above_min,  emit_bin_ri     },
+    { NT_REG,   0,     IR_BIN,     TOK_BIT_AND,  {NT_REG, NT_IMM},   1,    match_int,            emit_bin_ri     },
+    { NT_REG,   0,     IR_BIN,     TOK_BIT_OR,   {NT_REG, NT_IMM},   1,    match_int,            emit_bin_ri     },
+    { NT_REG,   0,     IR_BIN,     TOK_XOR,      {NT_REG, NT_IMM},   1,    match_int,            emit_bin_ri     },
+    { NT_REG,   0,     IR_BIN,     TOK_SHL,      {NT_REG, NT_IMM},   2,    match_int,            emit_bin_ri     },
+    { NT_REG,   0,     IR_BIN,     TOK_SHR,      {NT_REG, NT_IMM},   1,    match_int,            emit_bin_ri     },
+    { NT_REG,   0,     IR_BIN,     TOK_LT,       {NT_REG, NT_IMM},   1,    match_int,            emit_bin_ri     },
+    { NT_REG,   0,     IR_BIN,     TOK_LE,       {NT_REG, NT_IMM},   1,    match_imm_below_max,  emit_bin_ri     },
+    { NT_REG,   0,     IR_BIN,     TOK_GT,       {NT_REG, NT_IMM},   2,    match_imm_below_max,  emit_bin_ri     },
+    { NT_REG,   0,     IR_BIN,     TOK_GE,       {NT_REG, NT_IMM},   2,    match_int,            emit_bin_ri     },
+    { NT_REG,   0,     IR_BIN,     TOK_EQ,       {NT_REG, NT_IMM},   2,    match_int,            emit_bin_ri     },
+    { NT_REG,   0,     IR_BIN,     TOK_NEQ,      {NT_REG, NT_IMM},   2,    match_int,            emit_bin_ri     },
+    { NT_REG,   0,     IR_BIN,     TOK_EQ,       {NT_REG, NT_ZERO},  1,    match_int,            emit_bin_ri     },
+    { NT_REG,   0,     IR_BIN,     TOK_NEQ,      {NT_REG, NT_ZERO},  1,    match_int,            emit_bin_ri     },
+
+    /* Immediate, register. Commutative only. */
+    { NT_REG,   0,     IR_BIN,     TOK_PLUS,     {NT_IMM, NT_REG},   1,    match_int,            emit_bin_ir     },
+    { NT_REG,   0,     IR_BIN,     TOK_BIT_AND,  {NT_IMM, NT_REG},   1,    match_int,            emit_bin_ir     },
+    { NT_REG,   0,     IR_BIN,     TOK_BIT_OR,   {NT_IMM, NT_REG},   1,    match_int,            emit_bin_ir     },
+    { NT_REG,   0,     IR_BIN,     TOK_XOR,      {NT_IMM, NT_REG},   1,    match_int,            emit_bin_ir     },
+    { NT_REG,   0,     IR_BIN,     TOK_EQ,       {NT_IMM, NT_REG},   2,    match_int,            emit_bin_ir     },
+    { NT_REG,   0,     IR_BIN,     TOK_NEQ,      {NT_IMM, NT_REG},   2,    match_int,            emit_bin_ir     },
+
+    /* Compare and branch. */
+    { NT_COND,  0,     IR_BIN,     TOK_EQ,       {NT_REG, NT_REG},   1,    NULL,                 emit_branch_rr  },
+    { NT_COND,  0,     IR_BIN,     TOK_NEQ,      {NT_REG, NT_REG},   1,    NULL,                 emit_branch_rr  },
+    { NT_COND,  0,     IR_BIN,     TOK_LT,       {NT_REG, NT_REG},   1,    NULL,                 emit_branch_rr  },
+    { NT_COND,  0,     IR_BIN,     TOK_GT,       {NT_REG, NT_REG},   1,    NULL,                 emit_branch_rr  },
+    { NT_COND,  0,     IR_BIN,     TOK_LE,       {NT_REG, NT_REG},   1,    NULL,                 emit_branch_rr  },
+    { NT_COND,  0,     IR_BIN,     TOK_GE,       {NT_REG, NT_REG},   1,    NULL,                 emit_branch_rr  },
+    { NT_COND,  0,     IR_BIN,     TOK_EQ,       {NT_REG, NT_ZERO},  1,    match_zero_reg,       emit_branch_rz  },
+    { NT_COND,  0,     IR_BIN,     TOK_NEQ,      {NT_REG, NT_ZERO},  1,    match_zero_reg,       emit_branch_rz  },
+    { NT_COND,  0,     IR_BIN,     TOK_LT,       {NT_REG, NT_ZERO},  1,    match_zero_reg,       emit_branch_rz  },
+    { NT_COND,  0,     IR_BIN,     TOK_GT,       {NT_REG, NT_ZERO},  1,    match_zero_reg,       emit_branch_rz  },
+    { NT_COND,  0,     IR_BIN,     TOK_LE,       {NT_REG, NT_ZERO},  1,    match_zero_reg,       emit_branch_rz  },
+    { NT_COND,  0,     IR_BIN,     TOK_GE,       {NT_REG, NT_ZERO},  1,    match_zero_reg,       emit_branch_rz  },
+};
+
+/****   Labeling   ****/
+
+static void rule_try(struct state *s, const struct rule *r, uint64_t cost)
+{
+    if (cost < s->cost[r->nt]) {
+        s->cost[r->nt] = cost;
+        s->rule[r->nt] = r;
+    }
+}
+
+/* Cost of pattern with operands or COST_INF, if some
+   operand cannot be produced. */
+static uint64_t rule_cost(struct state *s, const struct rule *r)
+{
+    uint64_t cost = r->cost;
+
+    if (r->type != IR_BIN)
+        return cost;
+
+    for (uint64_t i = 0; i < 2; ++i) {
+        uint64_t kid = s->kids[i]->cost[r->kids[i]];
+        if (kid == COST_INF)
+            return COST_INF;
+        cost += kid;
+    }
+
+    return cost;
+}
+
+static struct state *label(struct ir_node *ir)
+{
+    switch (ir->type) {
+    case IR_STRING:
+        weak_fatal_error("Strings are not supported by native back end.");
+    case IR_MEMBER:
+        weak_fatal_error("Structures are not supported by native back end.");
+    default:
+        break;
+    }
+
+    if (states_size >= STATES_LIMIT)
+        weak_fatal_error("Expression is too complex.");
+
+    struct state *s = &states[states_size++];
+
+    memset(s, 0, sizeof (*s));
+    s->ir = ir;
+    for (uint64_t i = 0; i < NT_COUNT; ++i)
+        s->cost[i] = COST_INF;
+
+    if (ir->type == IR_BIN) {
+        struct ir_bin *bin = ir->ir;
+        s->kids[0] = label(bin->lhs);
+        s->kids[1] = label(bin->rhs);
+    }
+
+    for (uint64_t i = 0; i < __weak_array_size(rules); ++i) {
+        const struct rule *r = &rules[i];
+
+        if (r->chain || r->type != ir->type)
+            continue;
+        if (r->type == IR_BIN && r->op != ((struct ir_bin *) ir->ir)->op)
+            continue;
+        if (r->match && !r->match(ir))
+            continue;
+
+        uint64_t cost = rule_cost(s, r);
+        if (cost != COST_INF)
+            rule_try(s, r, cost);
+    }
+
+    /* Each chain rule has positive cost, so this stops. */
+    bool changed = 1;
+    while (changed) {
+        changed = 0;
+
+        for (uint64_t i = 0; i < __weak_array_size(rules); ++i) {
+            const struct rule *r   = &rules[i];
+            uint64_t           src = 0;
+
+            if (!r->chain || (r->match && !r->match(ir)))
+                continue;
+
+            src = s->cost[r->kids[0]];
+            if (src == COST_INF || r->cost + src >= s->cost[r->nt])
+                continue;
+
+            rule_try(s, r, r->cost + src);
+            changed = 1;
+        }
+    }
+
+    return s;
+}
+
+static struct operand reduce(struct state *s, enum nt nt, int dst)
+{
+    const struct rule *r       = s->rule[nt];
+    struct operand     kids[2] = {{.reg = -1}, {.reg = -1}};
+
+    if (!r)
+        weak_unreachable("No pattern covers `%s`.", ir_type_to_string(s->ir->type));
+
+    if (r->chain) {
+        kids[0] = reduce(s, r->kids[0], -1);
+    } else if (r->type == IR_BIN) {
+        kids[0] = reduce(s->kids[0], r->kids[0], -1);
+        kids[1] = reduce(s->kids[1], r->kids[1], -1);
     }
+
+    return r->reduce(s, kids, dst);
 }
 
-static void visit_ret(unused struct ir_ret *ir)
+/* Cover tree with the cheapest patterns, producing `nt`.
+   Reentrant, since call arguments are selected during
+   reduction of call. */
+static struct operand munch(struct ir_node *ir, enum nt nt, int dst)
 {
-    if (ir->body)
-        visit(ir->body);
+    uint64_t       base = states_size;
+    struct operand op   = reduce(label(ir), nt, dst);
 
-    back_end_native_addi(back_end_return_reg(), __tmp_reg_active->reg, 0);
+    states_size = base;
+
+    return op;
+}
+
+/* Compute expression. Result is placed to `dst`,
+   if it is not -1, or to any register otherwise. */
+static int visit_expr(struct ir_node *ir, int dst)
+{
+    return munch(ir, NT_REG, dst).reg;
+}
+
+static void visit_ret(struct ir_node *ir)
+{
+    struct ir_ret *ret = ir->ir;
+
+    if (ret->body)
+        visit_expr(ret->body, back_end_return_reg());
+
+    if (ir->next) {
+        sched_fixup(fn_ret_label);
+        sched_put(SCHED_JMP, 0, 0, 0);
+    }
 }
 
 static void visit_store(struct ir_store *ir)
 {
-    visit(ir->body);
+    if (ir->idx->type != IR_SYM)
+        weak_fatal_error("Store to `%s` is not supported by native back end.",
+            ir_type_to_string(ir->idx->type));
+
+    struct ir_node *idx  = ir->idx;
+    struct ir_sym  *sym  = idx->ir;
+    struct var_type type = type_of(sym->idx);
+
+    if (sym->deref) {
+        /* Call clobbers temporaries, so do it first. */
+        int val  = visit_expr(ir->body, -1);
+        int addr = visit_var(idx, -1);
+        store(val, addr, 0, type.dt, type.ptr_depth - 1);
+        return;
+    }
+
+    if (idx->claimed_reg != IR_NO_CLAIMED_REG) {
+        visit_expr(ir->body, idx->claimed_reg);
+        return;
+    }
+
+    int val = visit_expr(ir->body, -1);
+    store(val, back_end_sp_reg(), offset_of(sym->idx), type.dt, type.ptr_depth);
+}
+
+static void visit_push(struct ir_push *ir)
+{
+    sched_put(SCHED_ADDI, back_end_sp_reg(), back_end_sp_reg(), -16);
+    sched_put(SCHED_SD, ir->reg, back_end_sp_reg(), 0);
+    sp_shift += 16;
+}
+
+static void visit_pop(struct ir_pop *ir)
+{
+    sched_put(SCHED_LD, ir->reg, back_end_sp_reg(), 0);
+    sched_put(SCHED_ADDI, back_end_sp_reg(), back_end_sp_reg(), 16);
+    sp_shift -= 16;
+}
+
+static void visit_jump(struct ir_jump *ir)
+{
+    sched_fixup(stmt_label(ir->target));
+    sched_put(SCHED_JMP, 0, 0, 0);
+}
+
+/* False branch is next statement, so only true
+   one needs jump. */
+static void visit_cond(struct ir_cond *ir)
+{
+    cond_label = stmt_label(ir->target);
+    munch(ir->cond, NT_COND, -1);
+}
+
+static bool is_branch(struct ir_node *ir)
+{
+    return ir->type == IR_JUMP || ir->type == IR_COND || ir->type == IR_RET;
+}
+
+/* Statement is reached only by falling through from
+   the previous one, so it continues basic block and
+   needs no label. */
+static bool is_fallthrough(struct ir_node *ir)
+{
+    if (ir->cfg.preds.count == 0)
+        return 1;
+
+    return ir->cfg.preds.count == 1
+        && ir->prev
+        && vector_at(ir->cfg.preds, 0) == ir->prev
+        && !is_branch(ir->prev);
 }
 
 static void visit_chain(struct ir_node *ir)
 {
     while (ir) {
+        if (!is_fallthrough(ir))
+            sched_label_bind(stmt_label(ir));
+        tmp_regs_busy = 0;
+
         visit(ir);
+
+        /* Statements are not always placed in order of
+           execution, for example after loop rotation. */
+        if (!is_branch(ir) && ir->cfg.succs.count > 0) {
+            struct ir_node *succ = vector_at(ir->cfg.succs, 0);
+            if (succ != ir->next) {
+                sched_fixup(stmt_label(succ));
+                sched_put(SCHED_JMP, 0, 0, 0);
+            }
+        }
+
         ir = ir->next;
     }
 }
 
-static void visit_fn_main(unused struct ir_fn_decl *ir)
+/* Collect variables and registers, used by function,
+   and lay them out in frame. */
+static void fn_layout(struct ir_fn_decl *ir)
 {
-    visit_chain(ir->body);
+    bool     written[REGS_LIMIT] = {0};
+    uint64_t off                 = ir->frame_size;
+
+    hashmap_reset(&mapping, 32);
+    hashmap_reset(&mapping_type, 32);
+    hashmap_reset(&mapping_stmt, 256);
+
+    for (struct ir_node *it = ir->args; it; it = it->next) {
+        visit_alloca(it, off);
+        off += 8;
+
+        if (it->claimed_reg != IR_NO_CLAIMED_REG)
+            written[it->claimed_reg] = 1;
+    }
+
+    for (struct ir_node *it = ir->body; it; it = it->next) {
+        switch (it->type) {
+        case IR_ALLOCA:
+            visit_alloca(it, ((struct ir_alloca *) it->ir)->frame_off);
+            break;
+        case IR_ALLOCA_ARRAY:
+            visit_alloca_array(it->ir);
+            break;
+        case IR_STORE: {
+            struct ir_store *store = it->ir;
+            int              reg   = store->idx->claimed_reg;
+            if (reg != IR_NO_CLAIMED_REG)
+                written[reg] = 1;
+            break;
+        }
+        default:
+            break;
+        }
+    }
+
+    fn_saved_size = 0;
+
+    for (int reg = 0; reg < REGS_LIMIT; ++reg) {
+        if (!written[reg])
+            continue;
+
+        fn_saved[fn_saved_size]     = reg;
+        fn_saved_off[fn_saved_size] = off;
+        ++fn_saved_size;
+        off += 8;
+    }
 
-    // back_end_native_addi(risc_v_reg_a0, __tmp_reg_active);
-    back_end_native_syscall_0(__NR_exit);
+    /* Stack pointer is 16-byte aligned. */
+    fn_stack_usage = (off + 15) & ~15UL;
+    sp_shift       = 0;
 }
 
-static void visit_fn_usual(unused struct ir_fn_decl *ir)
+static void visit_fn_args(struct ir_fn_decl *ir)
 {
-    /* TODO: Calculate how much variables are allocated
-             in function.
+    int n = 0;
 
-             This codegen assumed to compute variable
-             values using temporary registers and
-             store value to variable via stack.
+    for (struct ir_node *it = ir->args; it; it = it->next, ++n) {
+        struct ir_alloca *arg = it->ir;
+        int               reg = back_end_arg_reg(n);
 
-             Variable is also must be referred only
-             by stack. */
-    int stack_usage = 0;
+        if (n >= 6 || reg < 0)
+            weak_fatal_error("Too many arguments of `%s`.", ir->name);
 
-    back_end_native_prologue(stack_usage);
+        if (it->claimed_reg != IR_NO_CLAIMED_REG)
+            sched_put(SCHED_ADDI, it->claimed_reg, reg, 0);
+        else
+            store(reg, back_end_sp_reg(), offset_of(arg->idx), arg->dt, arg->ptr_depth);
+    }
+}
 
-    visit_chain(ir->body);
+static void visit_fn_main(unused struct ir_fn_decl *ir)
+{
+    /* Returned value is exit code. */
+    if (back_end_arg_reg(0) != back_end_return_reg())
+        sched_put(SCHED_ADDI, back_end_arg_reg(0), back_end_return_reg(), 0);
 
-    back_end_native_epilogue(stack_usage);
-    back_end_native_ret();
+    sched_put(SCHED_SYSCALL, __NR_exit, 0, 0);
 }
 
-/* _start must be located at the start address
-   and perform jump to main.
+static void visit_fn_usual(unused struct ir_fn_decl *ir)
+{
+    for (uint64_t i = 0; i < fn_saved_size; ++i)
+        sched_put(SCHED_LD, fn_saved[i], back_end_sp_reg(), fn_saved_off[i]);
+
+    sched_put(SCHED_EPILOGUE, fn_stack_usage, 0, 0);
+    sched_put(SCHED_RET, 0, 0, 0);
+}
 
-   For now it contains only one instruction,
-   but will be useful to make generic API. */
-static uint64_t _start_size  = 0x04;
-/* This is setup before `main` code generation
-   in order to jump from _start. */
-static uint64_t main_seek    = 0x00;
-static bool     main_emitted = 0;
+/* Label is created on first reference, so function
+   may be called before its code is generated. Function,
+   which is only declared, is left to linker. */
+static uint64_t fn_label(const char *name)
+{
+    uint64_t crc   = crc32_string(name);
+    bool     ok    = 0;
+    uint64_t label = hashmap_get(&mapping_fn, crc, &ok);
+
+    if (!ok) {
+        label = back_end_label();
+        back_end_label_sym(label, name);
+        hashmap_put(&mapping_fn, crc, label);
+    }
+
+    return label;
+}
 
 static void visit_fn_call(struct ir_fn_call *ir)
 {
-    uint64_t crc = crc32_string(ir->name);
-    bool     ok  = 0;
-    uint64_t off = hashmap_get(&mapping_fn, crc, &ok);
+    int n = 0;
 
-    if (!ok)
-        weak_fatal_error("Cannot find `%s` function.", ir->name);
+    for (struct ir_node *it = ir->args; it; it = it->next, ++n) {
+        int reg = back_end_arg_reg(n);
 
-    uint64_t call_off = off - back_end_seek();
-    if (!main_emitted)
-        /* main() is implemented as `jal <main-offset>`.
-           At this moment we generating functions before main
-           so we pre-calculate size of _start function and
-           substract this.
+        if (n >= 6 || reg < 0)
+            weak_fatal_error("Too many arguments of `%s`.", ir->name);
 
-           After main() is generated, our seek is aligned to
-           real value with _start offset. */
-        call_off -= _start_size;
+        /* Arguments are symbols and immediates, so
+           only temporaries are used to compute them. */
+        visit_expr(it, reg);
+    }
 
-    back_end_native_call(call_off);
+    sched_fixup(fn_label(ir->name));
+    sched_put(SCHED_CALL, 0, 0, 0);
 }
 
 static void visit_fn_decl(struct ir_fn_decl *ir)
 {
+    ir_frame_build(ir);
+    fn_layout(ir);
 
-    uint64_t crc = crc32_string(ir->name);
-
-    if (!strcmp(ir->name, "main")) {
-        main_emitted = 1;
+    fn_main      = !strcmp(ir->name, "main");
+    fn_ret_label = back_end_label();
 
-        main_seek = back_end_seek() + _start_size;
-        back_end_emit_sym(ir->name, main_seek);
+    sched_label_bind(fn_label(ir->name));
+    back_end_emit_sym(ir->name, back_end_seek());
+    sched_put(SCHED_PROLOGUE, fn_stack_usage, 0, 0);
 
-        uint64_t seek = back_end_seek() + _start_size;
+    /* main() never returns, so its registers are not saved. */
+    if (!fn_main)
+        for (uint64_t i = 0; i < fn_saved_size; ++i)
+            sched_put(SCHED_SD, fn_saved[i], back_end_sp_reg(), fn_saved_off[i]);
 
-        hashmap_put(&mapping_fn, crc, main_seek);
+    visit_fn_args(ir);
+    visit_chain(ir->body);
 
-        back_end_seek_set(0);
-        back_end_native_call(main_seek);
-        back_end_seek_set(seek);
+    sched_label_bind(fn_ret_label);
 
+    if (fn_main)
         visit_fn_main(ir);
-    } else {
-        /* Where `main()` is generated, we don't need
-           to play with additional _start function
-           offset and it is correct without it now. */
-        uint64_t off = main_emitted
-            ? back_end_seek()
-            : back_end_seek() + _start_size;
-
-        back_end_emit_sym(ir->name, off);
-        hashmap_put(&mapping_fn, crc, off);
+    else
         visit_fn_usual(ir);
-    }
 }
 
 static void visit(struct ir_node *ir)
 {
     switch (ir->type) {
-    case IR_ALLOCA:       visit_alloca(ir->ir); break;
-    case IR_ALLOCA_ARRAY: /* visit_alloca_array(ir->ir); */ break;
-    case IR_IMM:          visit_imm(ir->ir); break;
-    case IR_STRING:       /* visit_string(ir->ir); */ break;
-    case IR_SYM:          /* visit_sym(ir); */ break;
+    case IR_ALLOCA:       /* Placed by fn_layout(). */ break;
+    case IR_ALLOCA_ARRAY: /* Placed by fn_layout(). */ break;
+    case IR_IMM:
+    case IR_SYM:
+    case IR_BIN:          visit_expr(ir, -1); break;
+    case IR_STRING:
+        weak_fatal_error("Strings are not supported by native back end.");
     case IR_STORE:        visit_store(ir->ir); break;
-    case IR_PUSH:         /* visit_push(ir->ir); */ break;
-    case IR_POP:          /* visit_pop(ir->ir); */ break;
-    case IR_BIN:          /* visit_bin(ir->ir); */ break;
-    case IR_JUMP:         /* visit_jump(ir->ir); */ break;
-    case IR_COND:         /* visit_cond(ir->ir); */ break;
-    case IR_RET:          visit_ret(ir->ir); break;
-    case IR_MEMBER:       /* visit_member(ir->ir); */ break;
-    case IR_TYPE_DECL:    /* visit_type_decl(ir->ir); */ break;
-    case IR_FN_DECL:      /* visit_fn_decl(ir->ir); */ break;
+    case IR_PUSH:         visit_push(ir->ir); break;
+    case IR_POP:          visit_pop(ir->ir); break;
+    case IR_JUMP:         visit_jump(ir->ir); break;
+    case IR_COND:         visit_cond(ir->ir); break;
+    case IR_RET:          visit_ret(ir); break;
+    case IR_MEMBER:
+        weak_fatal_error("Structures are not supported by native back end.");
+    case IR_TYPE_DECL:    break;
+    case IR_FN_DECL:      visit_fn_decl(ir->ir); break;
     case IR_FN_CALL:      visit_fn_call(ir->ir); break;
-    case IR_PHI:          /* visit_phi(ir->ir); */ break;
+    case IR_PHI:
+        weak_unreachable("Phi nodes should be eliminated with ir_destroy_ssa().");
     default:
         weak_unreachable("Unknown IR type (numeric: %d).", ir->type);
     }
 }
 
-void back_end_gen(struct ir_unit *unit)
+static bool has_main(struct ir_unit *unit)
 {
-    hashmap_init(&mapping_fn, 32);
-    hashmap_init(&mapping, 32);
-    hashmap_init(&mapping_type, 32);
+    for (struct ir_node *it = unit->fn_decls; it; it = it->next) {
+        struct ir_fn_decl *decl = it->ir;
+
+        if (!strcmp(decl->name, "main"))
+            return 1;
+    }
 
-    back_end_emit_sym("_start", back_end_seek());
+    return 0;
+}
+
+void back_end_gen(struct ir_unit *unit, bool fast_regalloc)
+{
+    int                saved[REGS_LIMIT] = {0};
+    struct ir_reg_file file              = {.count = 0, .regs = saved};
+
+    hashmap_reset(&mapping_fn, 32);
+    sched_reset();
+
+    tmp_regs_size = 0;
+    tmp_regs_next = 0;
+    while (tmp_regs_size < REGS_LIMIT && back_end_tmp_reg(tmp_regs_size) != -1) {
+        tmp_regs[tmp_regs_size] = back_end_tmp_reg(tmp_regs_size);
+        ++tmp_regs_size;
+    }
+
+    while (file.count < REGS_LIMIT && back_end_saved_reg(file.count) != -1) {
+        saved[file.count] = back_end_saved_reg(file.count);
+        ++file.count;
+    }
+
+    if (fast_regalloc)
+        ir_reg_alloc_linear(unit, &file);
+    else
+        ir_reg_alloc(unit, &file);
+
+    /* _start must be located at the start address
+       and perform jump to main. Other units of program
+       have no entry point. */
+    if (has_main(unit)) {
+        back_end_emit_sym("_start", back_end_seek());
+        sched_fixup(fn_label("main"));
+        sched_put(SCHED_CALL, 0, 0, 0);
+    }
 
     struct ir_node *it = unit->fn_decls;
     while (it) {
         visit_fn_decl(it->ir);
         it = it->next;
     }
-}
\ No newline at end of file
+
+    sched_flush();
+}
@@ -8,9 +8,13 @@
 #define WEAK_COMPILER_BACKEND_EMIT_H
 
 #include "back_end/elf.h"
+#include <stdbool.h>
 
 struct ir_unit;
 
-void back_end_gen(struct ir_unit *unit);
+/* Generate code of unit. Registers are allocated by
+   ir_reg_alloc_linear() if `fast_regalloc` is set, and
+   by ir_reg_alloc() otherwise. */
+void back_end_gen(struct ir_unit *unit, bool fast_regalloc);
 
 #endif // WEAK_COMPILER_BACKEND_EMIT_H
\ No newline at end of file
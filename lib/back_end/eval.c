@@ -5,9 +5,13 @@
  */
 
 #include "back_end/eval.h"
+#include "back_end/jit.h"
+#include "back_end/stencil.h"
 #include "front_end/lex/data_type.h"
+#include "middle_end/ir/frame.h"
 #include "middle_end/ir/ir.h"
 #include "middle_end/ir/ir_dump.h"
+#include "util/alloc.h"
 #include "util/compiler.h"
 #include "util/crc32.h"
 #include "util/hashmap.h"
@@ -29,11 +33,11 @@
 /* sp -- stack pointer
    bp -- base pointer (callee-save) */
 
-/* NOTE: Such stack usage has sense only with reordered alloca
-         instructions, where they are all collected at the beginning of
-         the function. Thus, we not require to injure our stack during
-         loop execution. Each variable allocated once and set up
-         multiple times.
+/* NOTE: Variables are placed at offsets of frame layout, computed
+         by ir_frame_build(). Frame is reserved once on function
+         entry, so alloca does not move stack pointer and can be
+         executed any number of times, e.g. in loops. Variables with
+         disjoint live ranges share the same slot.
 
          Moreover, language semantics forbid to have uninitialized
          values.
@@ -42,9 +46,19 @@
 static struct value stack[STACK_SIZE_BYTES];
 /* Index: sym_idx
    Value: sp */
-static char     stack_map[STACK_SIZE_BYTES];
+static uint32_t stack_map[STACK_SIZE_BYTES];
+/* Entries of stack_map, overwritten by callee. Saved
+   on call and restored on return, caller's first. */
+static uint32_t stack_map_saved[STACK_SIZE_BYTES];
+static uint64_t stack_map_saved_top;
+/* Index: sym_idx
+   Value: value of variable, passed to on-stack replacement
+          code. */
+static int32_t  osr_vars[STACK_SIZE_BYTES];
 /* Global stack pointer. Named as assembly register. */
 static uint64_t sp;
+/* Frame pointer of current function. */
+static uint64_t fp;
 
 
 
@@ -52,7 +66,9 @@ static void reset()
 {
     memset(stack_map, 0, sizeof (stack_map));
     memset(stack, 0, sizeof (stack));
+    stack_map_saved_top = 0;
     sp = 0;
+    fp = 0;
 }
 
 /* Notice: There is no `pop` function, since popping
@@ -116,39 +132,14 @@ static uint64_t dt_size(enum data_type dt)
     }
 }
 
-static uint64_t alloca_size(struct ir_alloca *alloca)
-{
-    if (alloca->ptr_depth > 0)
-        return 8;
-
-    return dt_size(alloca->dt);
-}
-
-static uint64_t alloca_array_size(struct ir_alloca_array *alloca)
-{
-    uint64_t siz = 1;
-
-    for (uint64_t i = 0; i < alloca->arity_size; ++i)
-        siz *= alloca->arity[i];
-    siz *= dt_size(alloca->dt);
-
-    return siz;
-}
-
 static void eval_alloca(struct ir_alloca *alloca)
 {
-    uint64_t i     = alloca->idx;
-    uint64_t bytes = alloca_size(alloca);
-
-    push(i, bytes);
+    stack_map[alloca->idx] = fp + alloca->frame_off;
 }
 
 static void eval_alloca_array(struct ir_alloca_array *alloca)
 {
-    uint64_t i     = alloca->idx;
-    uint64_t bytes = alloca_array_size(alloca);
-
-    push(i, bytes);
+    stack_map[alloca->idx] = fp + alloca->frame_off;
 }
 
 
@@ -242,6 +233,7 @@ static void eval_ints(
     case TOK_STAR:    i = l  * r; break;
     case TOK_SLASH:   i = l  / r; break;
     case TOK_MOD:     i = l  % r; break;
+    case TOK_MULHI:   i = ((int64_t) l * r) >> 32; break;
     default:
         weak_unreachable("Unknown token type `%s`.", tok_to_string(op));
     }
@@ -472,6 +464,8 @@ static void instr_eval(struct ir_node *ir)
     case IR_COND:
         eval_cond(ir);
         break;
+    case IR_PHI:
+        weak_unreachable("Phi nodes should be eliminated with ir_destroy_ssa().");
     default:
         weak_unreachable("Unknown IR type (numeric: %d).", ir->type);
     }
@@ -482,18 +476,77 @@ static void instr_eval(struct ir_node *ir)
 /**********************************************
  **           Functions routines             **
  **********************************************/
+
+/* Function is compiled to native code after it was called
+   or jumped backward given number of times. First, cheap
+   copy-and-patch compiler is used, then JIT. Compiled code
+   is used starting from the next call. Running call also
+   leaves interpreter on the back edge, which reaches the
+   threshold, so a loop in function called once is compiled
+   too (on-stack replacement). */
+#define STENCIL_CALLS_THRESHOLD      2
+#define STENCIL_BACK_EDGES_THRESHOLD 64
+#define JIT_CALLS_THRESHOLD          64
+#define JIT_BACK_EDGES_THRESHOLD     1024
+
+struct fun {
+    struct ir_fn_decl *decl;
+    /** Number of stack_map entries, used by function. */
+    uint64_t           syms;
+    uint64_t           calls;
+    uint64_t           back_edges;
+    /** Result of stencil_compile() or jit_compile(), or NULL. */
+    void              *native;
+    bool               stencil_tried;
+    bool               jit_tried;
+};
+
+/* Key:   CRC32 of function name
+   Value: struct fun * */
 static hashmap_t funs;
 
+/* Symbols get stack_map entries only as arguments and
+   allocas. Arguments are allocas too. */
+static uint64_t fun_syms(struct ir_node *ir, uint64_t syms)
+{
+    for (; ir; ir = ir->next) {
+        uint64_t idx = 0;
+
+        switch (ir->type) {
+        case IR_ALLOCA:       idx = ((struct ir_alloca *) ir->ir)->idx; break;
+        case IR_ALLOCA_ARRAY: idx = ((struct ir_alloca_array *) ir->ir)->idx; break;
+        default:              continue;
+        }
+
+        if (idx + 1 > syms)
+            syms = idx + 1;
+    }
+
+    return syms;
+}
+
 static void fun_list_init(struct ir_node *ir)
 {
     while (ir) {
-        struct ir_fn_decl *fun = ir->ir;
-        hashmap_put(&funs, crc32_string(fun->name), (uint64_t) fun);
+        struct ir_fn_decl *decl = ir->ir;
+        struct fun        *fun  = weak_new(struct fun);
+        ir_frame_build(decl);
+        fun->decl = decl;
+        fun->syms = fun_syms(decl->body, fun_syms(decl->args, 0));
+        hashmap_put(&funs, crc32_string(decl->name), (uint64_t) fun);
         ir = ir->next;
     }
 }
 
-static struct ir_fn_decl *fun_lookup(const char *name)
+static void fun_list_free()
+{
+    hashmap_foreach(&funs, k, v) {
+        (void) k;
+        weak_free((struct fun *) v);
+    }
+}
+
+static struct fun *fun_lookup(const char *name)
 {
     uint64_t hash = crc32_string(name);
 
@@ -502,14 +555,76 @@ static struct ir_fn_decl *fun_lookup(const char *name)
     if (!ok)
         weak_unreachable("Function lookup failed for `%s`, CRC32: %lu", name, hash);
 
-    return (struct ir_fn_decl *) got;
+    return (struct fun *) got;
+}
+
+static struct ir_fn_decl *fun_decl_lookup(const char *name)
+{
+    return fun_lookup(name)->decl;
 }
 
-static void fun_eval(struct ir_fn_decl *decl)
+static void fun_tier_up(struct fun *fun)
 {
-    struct ir_node *it = decl->body;
+    void *code = NULL;
+
+    /* On failure function stays on its current tier. */
+    if (!fun->stencil_tried &&
+        (fun->calls      >= STENCIL_CALLS_THRESHOLD ||
+         fun->back_edges >= STENCIL_BACK_EDGES_THRESHOLD)) {
+        fun->stencil_tried = 1;
+        code = stencil_compile(fun->decl, fun_decl_lookup);
+    }
+
+    if (!fun->jit_tried &&
+        (fun->calls      >= JIT_CALLS_THRESHOLD ||
+         fun->back_edges >= JIT_BACK_EDGES_THRESHOLD)) {
+        fun->jit_tried = 1;
+        code = jit_compile(fun->decl, fun_decl_lookup);
+    }
+
+    if (code)
+        fun->native = code;
+}
+
+/* Continue current call of function in native code from
+   loop header. Only int variables are supported by native
+   code, so each variable is copied as int.
+
+   \return Whether function returned. */
+static bool fun_osr(struct fun *fun, struct ir_node *header)
+{
+    void *code = NULL;
+
+    fun_tier_up(fun);
+
+    if (!fun->native)
+        return 0;
+
+    if (fun->back_edges == STENCIL_BACK_EDGES_THRESHOLD)
+        code = stencil_compile_osr(fun->decl, fun_decl_lookup, header);
+
+    if (fun->back_edges == JIT_BACK_EDGES_THRESHOLD)
+        code = jit_compile_osr(fun->decl, fun_decl_lookup, header);
+
+    if (!code)
+        return 0;
+
+    for (uint64_t i = 0; i < fun->syms; ++i)
+        memcpy(&osr_vars[i], &stack[stack_map[i]], sizeof (int32_t));
+
+    last.dt    = D_T_INT;
+    last.__int = jit_call_osr(code, osr_vars);
+    return 1;
+}
+
+static void fun_eval(struct fun *fun)
+{
+    struct ir_fn_decl *decl = fun->decl;
+    struct ir_node    *it   = decl->body;
 
     instr_ptr = it;
+    fp        = sp;
+    sp       += decl->frame_size;
 
     while (instr_ptr) {
         struct ir_node *prev_ptr = instr_ptr;
@@ -521,6 +636,13 @@ static void fun_eval(struct ir_fn_decl *decl)
         switch (prev_ptr->type) {
         case IR_COND:
         case IR_JUMP:
+            if (instr_ptr && instr_ptr->instr_idx <= prev_ptr->instr_idx) {
+                ++fun->back_edges;
+                if ((fun->back_edges == STENCIL_BACK_EDGES_THRESHOLD ||
+                     fun->back_edges == JIT_BACK_EDGES_THRESHOLD) &&
+                    fun_osr(fun, instr_ptr))
+                    return;
+            }
             break;
         default:
             if (instr_ptr)
@@ -562,15 +684,47 @@ static void push_call_arg(struct ir_node *arg, uint64_t *sym)
     set_call_arg(arg, sym);
 }
 
+static void native_call_eval(struct fun *fun, struct ir_fn_call *fcall)
+{
+    int32_t         args[JIT_ARGS_LIMIT] = {0};
+    uint64_t        args_size            = 0;
+    struct ir_node *arg                  = fcall->args;
+
+    /* Compiled functions accept only ints. */
+    while (arg) {
+        instr_eval(arg);
+        args[args_size++] = last.__int;
+        arg = arg->next;
+    }
+
+    last.dt    = D_T_INT;
+    last.__int = jit_call(fun->native, args, args_size);
+}
+
 static void call_eval(struct ir_fn_call *fcall)
 {
+    struct fun *fun = fun_lookup(fcall->name);
+
+    ++fun->calls;
+    fun_tier_up(fun);
+
+    if (fun->native) {
+        native_call_eval(fun, fcall);
+        return;
+    }
+
     /* Prologue @{ */
     uint64_t        sym            = 0;
     uint64_t        bp             = sp;
+    uint64_t        save_fp        = fp;
     struct ir_node *save_instr_ptr = instr_ptr;
-    char            stack_map_copy[STACK_SIZE_BYTES] = {0};
+    uint32_t       *saved          = &stack_map_saved[stack_map_saved_top];
+
+    if (stack_map_saved_top + fun->syms > STACK_SIZE_BYTES)
+        weak_unreachable("Stack overflow in call to `%s`", fcall->name);
 
-   memcpy(stack_map_copy, stack_map, STACK_SIZE_BYTES); 
+    memcpy(saved, stack_map, fun->syms * sizeof (*stack_map));
+    stack_map_saved_top += fun->syms;
 
     struct ir_node *arg = fcall->args;
     while (arg) {
@@ -580,14 +734,15 @@ static void call_eval(struct ir_fn_call *fcall)
     /* }@ */
 
     /* Body @{ */
-    struct ir_fn_decl *fun = fun_lookup(fcall->name);
     fun_eval(fun);
     /* }@ */
 
     /* Epilogue @{ */
     sp = bp;
+    fp = save_fp;
     instr_ptr = save_instr_ptr;
-   memcpy(stack_map, stack_map_copy, STACK_SIZE_BYTES); 
+    stack_map_saved_top -= fun->syms;
+    memcpy(stack_map, saved, fun->syms * sizeof (*stack_map));
     /* }@ */
 }
 
@@ -599,6 +754,8 @@ static void call_eval(struct ir_fn_call *fcall)
 int32_t eval(struct ir_unit *unit)
 {
     reset();
+    stencil_reset();
+    jit_reset();
     hashmap_reset(&funs, 512);
 
     fun_list_init(unit->fn_decls);
@@ -612,5 +769,9 @@ int32_t eval(struct ir_unit *unit)
     if (last.dt != D_T_INT)
         weak_unreachable("main() return only ints.");
 
+    fun_list_free();
+    stencil_reset();
+    jit_reset();
+
     return last.__int;
 }
\ No newline at end of file
@@ -0,0 +1,732 @@
+/* jit.c - x86-64 JIT compiler for IR interpreter.
+ * Copyright (C) 2024 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#include "back_end/jit.h"
+#include "util/compiler.h"
+#include "util/unreachable.h"
+
+#if defined __x86_64__
+
+#include "middle_end/ir/ir.h"
+#include "util/alloc.h"
+#include "util/hashmap.h"
+#include "util/vector.h"
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/* Code generator is a trivial template one. Each variable
+   lives in its own 8-byte stack slot at [rbp - 8 * (idx + 1)].
+   Expressions are computed to eax, right operand of binary
+   operation is held in ecx. All arithmetic is 32-bit, as in
+   interpreter. */
+
+struct jit_fn {
+    struct ir_fn_decl *decl;
+    void              *code;
+    bool               failed;
+    bool               in_progress;
+};
+
+struct jit_fixup {
+    /** Offset of rel32 operand. */
+    uint64_t        off;
+    struct ir_node *target;
+};
+
+/** Executable memory, given by jit_install(). */
+struct jit_region {
+    void     *mem;
+    uint64_t  size;
+};
+
+typedef vector_t(uint8_t) jit_code_t;
+typedef vector_t(struct jit_fixup) jit_fixup_vector_t;
+typedef vector_t(struct jit_region) jit_region_vector_t;
+
+static jit_region_vector_t  regions;
+
+/* Key:   ir_fn_decl address
+   Value: struct jit_fn * */
+static hashmap_t            fns;
+static jit_lookup_t         fn_lookup;
+
+/* State of currently compiled function. */
+static struct jit_fn       *fn_current;
+static jit_code_t           code;
+/* Key:   ir_node address
+   Value: code offset */
+static hashmap_t            labels;
+static jit_fixup_vector_t   fixups;
+static uint64_t             slots;
+/* Code for on-stack replacement is compiled. */
+static bool                 osr;
+
+static const uint8_t arg_regs[JIT_ARGS_LIMIT] = {
+    /*edi=*/7, /*esi=*/6, /*edx=*/2, /*ecx=*/1, /*r8d=*/8, /*r9d=*/9
+};
+
+static wur void *fn_compile(struct ir_fn_decl *decl);
+
+/**********************************************
+ **                Encoding                  **
+ **********************************************/
+static void put(uint64_t size, const char *bytes)
+{
+    for (uint64_t i = 0; i < size; ++i)
+        vector_push_back(code, (uint8_t) bytes[i]);
+}
+
+static void put_8(uint8_t byte)
+{
+    vector_push_back(code, byte);
+}
+
+static void put_32(uint32_t imm)
+{
+    for (int i = 0; i < 4; ++i)
+        put_8((imm >> (i * 8)) & 0xFF);
+}
+
+static void put_64(uint64_t imm)
+{
+    put_32(imm & 0xFFFFFFFF);
+    put_32(imm >> 32);
+}
+
+static int32_t slot(uint64_t idx)
+{
+    return -8 * (int32_t) (idx + 1);
+}
+
+/* mov r32, [rbp + slot] */
+static void put_load(uint8_t reg, uint64_t idx)
+{
+    if (reg >= 8)
+        put_8(0x44);
+    put_8(0x8B);
+    put_8(0x85 | ((reg & 7) << 3));
+    put_32(slot(idx));
+}
+
+/* mov [rbp + slot], r32 */
+static void put_store(uint8_t reg, uint64_t idx)
+{
+    if (reg >= 8)
+        put_8(0x44);
+    put_8(0x89);
+    put_8(0x85 | ((reg & 7) << 3));
+    put_32(slot(idx));
+}
+
+/* mov eax, [rdi + 4 * idx] */
+static void put_osr_load(uint64_t idx)
+{
+    put(2, "\x8b\x87");
+    put_32(4 * idx);
+}
+
+/* mov r32, imm32 */
+static void put_li(uint8_t reg, int32_t imm)
+{
+    if (reg >= 8)
+        put_8(0x41);
+    put_8(0xB8 + (reg & 7));
+    put_32(imm);
+}
+
+static void put_fixup(struct ir_node *target)
+{
+    struct jit_fixup fixup = {
+        .off    = code.count,
+        .target = target
+    };
+    vector_push_back(fixups, fixup);
+    put_32(0);
+}
+
+/**********************************************
+ **                Operands                  **
+ **********************************************/
+static wur bool is_int(enum data_type dt, uint64_t ptr_depth)
+{
+    return dt == D_T_INT && ptr_depth == 0;
+}
+
+static wur bool sym_ok(struct ir_node *ir)
+{
+    struct ir_sym *sym = ir->ir;
+
+    return !sym->deref && !sym->addr_of && sym->idx < slots &&
+            is_int(sym->type_info.dt, sym->type_info.ptr_depth);
+}
+
+/* Load immediate or variable to register. */
+static wur bool operand(uint8_t reg, struct ir_node *ir)
+{
+    switch (ir->type) {
+    case IR_IMM: {
+        struct ir_imm *imm = ir->ir;
+        if (imm->type != IMM_INT)
+            return 0;
+        put_li(reg, imm->imm.__int);
+        return 1;
+    }
+    case IR_SYM:
+        if (!sym_ok(ir))
+            return 0;
+        put_load(reg, ((struct ir_sym *) ir->ir)->idx);
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+/**********************************************
+ **               Expressions                **
+ **********************************************/
+static wur bool value(struct ir_node *ir);
+
+static wur bool put_op(enum token_type op)
+{
+    /* Setcc opcodes after 0x0F. */
+    uint8_t cc = 0;
+
+    switch (op) {
+    case TOK_PLUS:    put(2, "\x01\xc8");         return 1; /* add eax, ecx  */
+    case TOK_MINUS:   put(2, "\x29\xc8");         return 1; /* sub eax, ecx  */
+    case TOK_BIT_AND: put(2, "\x21\xc8");         return 1; /* and eax, ecx  */
+    case TOK_BIT_OR:  put(2, "\x09\xc8");         return 1; /* or eax, ecx   */
+    case TOK_XOR:     put(2, "\x31\xc8");         return 1; /* xor eax, ecx  */
+    case TOK_STAR:    put(3, "\x0f\xaf\xc1");     return 1; /* imul eax, ecx */
+    case TOK_SHL:     put(2, "\xd3\xe0");         return 1; /* shl eax, cl   */
+    case TOK_SHR:     put(2, "\xd3\xf8");         return 1; /* sar eax, cl   */
+    case TOK_SLASH:
+        put(3,
+            "\x99"                                /* cdq           */
+            "\xf7\xf9"                            /* idiv ecx      */
+        );
+        return 1;
+    case TOK_MOD:
+        put(5,
+            "\x99"                                /* cdq           */
+            "\xf7\xf9"                            /* idiv ecx      */
+            "\x89\xd0"                            /* mov eax, edx  */
+        );
+        return 1;
+    case TOK_MULHI:
+        put(14,
+            "\x48\x63\xc0"                        /* movsxd rax, eax  */
+            "\x48\x63\xc9"                        /* movsxd rcx, ecx  */
+            "\x48\x0f\xaf\xc1"                    /* imul rax, rcx    */
+            "\x48\xc1\xf8\x20"                    /* sar rax, 32      */
+        );
+        return 1;
+    case TOK_AND:
+        put(13,
+            "\x85\xc0"                            /* test eax, eax */
+            "\x0f\x95\xc0"                        /* setne al      */
+            "\x85\xc9"                            /* test ecx, ecx */
+            "\x0f\x95\xc1"                        /* setne cl      */
+            "\x20\xc8"                            /* and al, cl    */
+        );
+        put(3, "\x0f\xb6\xc0");                   /* movzx eax, al */
+        return 1;
+    case TOK_OR:
+        put(5,
+            "\x09\xc8"                            /* or eax, ecx   */
+            "\x0f\x95\xc0"                        /* setne al      */
+        );
+        put(3, "\x0f\xb6\xc0");                   /* movzx eax, al */
+        return 1;
+    case TOK_EQ:  cc = 0x94; break;
+    case TOK_NEQ: cc = 0x95; break;
+    case TOK_LT:  cc = 0x9C; break;
+    case TOK_GE:  cc = 0x9D; break;
+    case TOK_LE:  cc = 0x9E; break;
+    case TOK_GT:  cc = 0x9F; break;
+    default:
+        return 0;
+    }
+
+    put(2, "\x39\xc8");                           /* cmp eax, ecx  */
+    put_8(0x0F);                                  /* setcc al      */
+    put_8(cc);
+    put_8(0xC0);
+    put(3, "\x0f\xb6\xc0");                       /* movzx eax, al */
+    return 1;
+}
+
+static wur bool put_bin(struct ir_bin *bin)
+{
+    switch (bin->rhs->type) {
+    case IR_IMM:
+    case IR_SYM:
+        if (!value(bin->lhs) || !operand(/*ecx=*/1, bin->rhs))
+            return 0;
+        break;
+    default:
+        if (!value(bin->rhs))
+            return 0;
+        put_8(0x50);                              /* push rax */
+        if (!value(bin->lhs))
+            return 0;
+        put_8(0x59);                              /* pop rcx  */
+        break;
+    }
+
+    return put_op(bin->op);
+}
+
+static wur bool value(struct ir_node *ir)
+{
+    switch (ir->type) {
+    case IR_IMM:
+    case IR_SYM:
+        return operand(/*eax=*/0, ir);
+    case IR_BIN:
+        return put_bin(ir->ir);
+    default:
+        return 0;
+    }
+}
+
+static wur bool call(struct ir_fn_call *fcall)
+{
+    struct ir_fn_decl *decl = fn_lookup(fcall->name);
+    struct ir_node    *arg  = fcall->args;
+    uint64_t           i    = 0;
+    void              *callee = NULL;
+
+    /* Callee is compiled before, so its address is
+       already known. Self call is relative, unless code
+       for on-stack replacement is compiled: it does not
+       start at function entry. */
+    if (decl != fn_current->decl || osr) {
+        callee = fn_compile(decl);
+        if (!callee)
+            return 0;
+    }
+
+    while (arg) {
+        if (i >= JIT_ARGS_LIMIT || !operand(arg_regs[i++], arg))
+            return 0;
+        arg = arg->next;
+    }
+
+    if (callee) {
+        put(2, "\x49\xbb");                       /* movabs r11, callee */
+        put_64((uint64_t) callee);
+        put(3, "\x41\xff\xd3");                   /* call r11           */
+    } else {
+        put_8(0xE8);                              /* call rel32         */
+        put_32(-(int32_t) (code.count + 4));
+    }
+
+    return 1;
+}
+
+/**********************************************
+ **               Statements                 **
+ **********************************************/
+static wur bool store(struct ir_store *store)
+{
+    if (store->idx->type != IR_SYM || !sym_ok(store->idx))
+        return 0;
+
+    bool ok = store->body->type == IR_FN_CALL
+        ? call(store->body->ir)
+        : value(store->body);
+
+    if (ok)
+        put_store(/*eax=*/0, ((struct ir_sym *) store->idx->ir)->idx);
+
+    return ok;
+}
+
+static wur bool stmt(struct ir_node *ir)
+{
+    switch (ir->type) {
+    case IR_ALLOCA: {
+        struct ir_alloca *alloca = ir->ir;
+        return is_int(alloca->dt, alloca->ptr_depth);
+    }
+    case IR_STORE:
+        return store(ir->ir);
+    case IR_FN_CALL:
+        return call(ir->ir);
+    case IR_COND: {
+        struct ir_cond *cond = ir->ir;
+        if (!value(cond->cond))
+            return 0;
+        put(4,
+            "\x85\xc0"                            /* test eax, eax */
+            "\x0f\x85"                            /* jne rel32     */
+        );
+        put_fixup(cond->target);
+        return 1;
+    }
+    case IR_JUMP:
+        put_8(0xE9);                              /* jmp rel32     */
+        put_fixup(((struct ir_jump *) ir->ir)->target);
+        return 1;
+    case IR_RET: {
+        struct ir_ret *ret = ir->ir;
+        if (ret->body && !value(ret->body))
+            return 0;
+        put(2, "\xc9\xc3");                       /* leave; ret    */
+        return 1;
+    }
+    default:
+        return 0;
+    }
+}
+
+/**********************************************
+ **               Functions                  **
+ **********************************************/
+static wur bool frame_build(struct ir_fn_decl *decl)
+{
+    struct ir_node *it = decl->args;
+    uint64_t        n  = 0;
+
+    slots = 0;
+
+    for (it = decl->args; it; it = it->next, ++n) {
+        if (it->type != IR_ALLOCA || n >= JIT_ARGS_LIMIT)
+            return 0;
+        struct ir_alloca *alloca = it->ir;
+        if (!is_int(alloca->dt, alloca->ptr_depth))
+            return 0;
+        if (slots < alloca->idx + 1)
+            slots = alloca->idx + 1;
+    }
+
+    for (it = decl->body; it; it = it->next) {
+        if (it->type != IR_ALLOCA)
+            continue;
+        struct ir_alloca *alloca = it->ir;
+        if (slots < alloca->idx + 1)
+            slots = alloca->idx + 1;
+    }
+
+    return decl->ret_type == D_T_VOID ||
+           is_int(decl->ret_type, decl->ptr_depth);
+}
+
+/* If `entry` is given, variables are copied from array
+   in rdi and execution continues from `entry`. */
+static void prologue(struct ir_node *entry)
+{
+    uint64_t frame = (slots * 8 + 15) & ~15ULL;
+
+    put(7,
+        "\x55"                                    /* push rbp      */
+        "\x48\x89\xe5"                            /* mov rbp, rsp  */
+        "\x48\x81\xec"                            /* sub rsp, imm  */
+    );
+    put_32(frame);
+
+    if (entry) {
+        for (uint64_t idx = 0; idx < slots; ++idx) {
+            put_osr_load(idx);
+            put_store(/*eax=*/0, idx);
+        }
+        put_8(0xE9);                              /* jmp rel32     */
+        put_fixup(entry);
+        return;
+    }
+
+    struct ir_node *it = fn_current->decl->args;
+    uint64_t        i  = 0;
+
+    for (; it; it = it->next)
+        put_store(arg_regs[i++], ((struct ir_alloca *) it->ir)->idx);
+}
+
+static wur bool body_gen(struct ir_fn_decl *decl, struct ir_node *entry)
+{
+    struct ir_node *it = decl->body;
+
+    prologue(entry);
+
+    for (; it; it = it->next) {
+        hashmap_put(&labels, (uint64_t) it, code.count);
+
+        if (!stmt(it))
+            return 0;
+
+        /* Interpreter follows CFG, not the statement list. */
+        if (it->type != IR_COND && it->type != IR_JUMP &&
+            it->type != IR_RET && it->cfg.succs.count > 0) {
+            struct ir_node *succ = vector_at(it->cfg.succs, 0);
+            if (succ != it->next) {
+                put_8(0xE9);                      /* jmp rel32     */
+                put_fixup(succ);
+            }
+        }
+    }
+
+    put(2, "\xc9\xc3");                           /* leave; ret    */
+
+    vector_foreach(fixups, i) {
+        struct jit_fixup *fixup = &vector_at(fixups, i);
+
+        bool     ok = 0;
+        uint64_t to = hashmap_get(&labels, (uint64_t) fixup->target, &ok);
+        if (!ok)
+            return 0;
+
+        int32_t rel = (int32_t) (to - (fixup->off + 4));
+        memcpy(&code.data[fixup->off], &rel, sizeof (rel));
+    }
+
+    return 1;
+}
+
+static void perf_map_write(const char *name, void *mem, uint64_t size)
+{
+    char path[64] = {0};
+    snprintf(path, sizeof (path) - 1, "/tmp/perf-%d.map", getpid());
+
+    FILE *map = fopen(path, "a");
+    if (!map)
+        return;
+
+    fprintf(map, "%lx %lx %s\n", (uint64_t) mem, size, name);
+    fclose(map);
+}
+
+void *jit_install(const char *name, const uint8_t *bytes, uint64_t size)
+{
+    void *mem = mmap(
+        /*addr=*/NULL,
+        size,
+        PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS,
+        /*fd=*/-1,
+        /*offset=*/0
+    );
+    if (mem == MAP_FAILED)
+        return NULL;
+
+    memcpy(mem, bytes, size);
+
+    if (mprotect(mem, size, PROT_READ | PROT_EXEC) < 0) {
+        munmap(mem, size);
+        return NULL;
+    }
+
+    struct jit_region region = {
+        .mem  = mem,
+        .size = size
+    };
+    vector_push_back(regions, region);
+    perf_map_write(name, mem, size);
+    return mem;
+}
+
+static bool callees_compile(struct ir_fn_decl *decl)
+{
+    struct ir_node *it = decl->body;
+
+    for (; it; it = it->next) {
+        struct ir_fn_call *fcall = NULL;
+
+        if (it->type == IR_FN_CALL)
+            fcall = it->ir;
+        if (it->type == IR_STORE &&
+            ((struct ir_store *) it->ir)->body->type == IR_FN_CALL)
+            fcall = ((struct ir_store *) it->ir)->body->ir;
+
+        if (!fcall)
+            continue;
+
+        struct ir_fn_decl *callee = fn_lookup(fcall->name);
+        if (callee != decl && !fn_compile(callee))
+            return 0;
+    }
+
+    return 1;
+}
+
+static struct jit_fn *fn_get(struct ir_fn_decl *decl)
+{
+    bool     ok  = 0;
+    uint64_t got = hashmap_get(&fns, (uint64_t) decl, &ok);
+
+    if (ok)
+        return (struct jit_fn *) got;
+
+    struct jit_fn *fn = weak_new(struct jit_fn);
+    fn->decl = decl;
+    hashmap_put(&fns, (uint64_t) decl, (uint64_t) fn);
+    return fn;
+}
+
+static void *fn_compile(struct ir_fn_decl *decl)
+{
+    struct jit_fn *fn = fn_get(decl);
+
+    if (fn->code || fn->failed)
+        return fn->code;
+
+    /* Mutual recursion. */
+    if (fn->in_progress)
+        return NULL;
+
+    fn->in_progress = 1;
+    /* Code buffer is shared, so all callees are
+       compiled before this function. */
+    fn->failed = !callees_compile(decl);
+    fn->in_progress = 0;
+
+    if (fn->failed)
+        return NULL;
+
+    fn_current = fn;
+    vector_clear(code);
+    vector_clear(fixups);
+    hashmap_reset(&labels, 256);
+
+    fn->failed = !frame_build(decl) ||
+                 !body_gen(decl, /*entry=*/NULL);
+
+    if (!fn->failed)
+        fn->code = jit_install(decl->name, code.data, code.count);
+
+    fn->failed = !fn->code;
+
+    return fn->code;
+}
+
+void *jit_compile(struct ir_fn_decl *decl, jit_lookup_t lookup)
+{
+    if (!fns.buckets)
+        hashmap_init(&fns, 64);
+
+    fn_lookup = lookup;
+    return fn_compile(decl);
+}
+
+void *jit_compile_osr(struct ir_fn_decl *decl, jit_lookup_t lookup, struct ir_node *entry)
+{
+    char name[256] = {0};
+
+    /* Checks, that all IR is supported, and compiles
+       callees. */
+    if (!jit_compile(decl, lookup))
+        return NULL;
+
+    fn_current = fn_get(decl);
+    vector_clear(code);
+    vector_clear(fixups);
+    hashmap_reset(&labels, 256);
+
+    osr = 1;
+    bool ok = frame_build(decl) && body_gen(decl, entry);
+    osr = 0;
+
+    if (!ok)
+        return NULL;
+
+    snprintf(name, sizeof (name) - 1, "%s.osr", decl->name);
+    return jit_install(name, code.data, code.count);
+}
+
+int32_t jit_call(void *code, int32_t *args, uint64_t args_size)
+{
+    typedef int32_t (*jit_fn_t)(
+        int32_t, int32_t, int32_t, int32_t, int32_t, int32_t
+    );
+
+    /* Unused registers are ignored by callee, so
+       always pass maximum number of arguments. */
+    int32_t a[JIT_ARGS_LIMIT] = {0};
+    union {
+        void     *code;
+        jit_fn_t  fn;
+    } u = { .code = code };
+
+    if (args_size > JIT_ARGS_LIMIT)
+        weak_unreachable("Too many arguments: %lu", args_size);
+
+    memcpy(a, args, args_size * sizeof (int32_t));
+
+    return u.fn(a[0], a[1], a[2], a[3], a[4], a[5]);
+}
+
+int32_t jit_call_osr(void *code, int32_t *vars)
+{
+    typedef int32_t (*jit_osr_fn_t)(int32_t *);
+
+    union {
+        void         *code;
+        jit_osr_fn_t  fn;
+    } u = { .code = code };
+
+    return u.fn(vars);
+}
+
+void jit_reset()
+{
+    /* hashmap_foreach() does not expect empty map. */
+    if (fns.buckets) {
+        hashmap_foreach(&fns, k, v) {
+            (void) k;
+            weak_free((struct jit_fn *) v);
+        }
+        hashmap_destroy(&fns);
+    }
+
+    vector_foreach(regions, i) {
+        struct jit_region *region = &vector_at(regions, i);
+        munmap(region->mem, region->size);
+    }
+    vector_free(regions);
+    if (labels.buckets)
+        hashmap_destroy(&labels);
+    vector_free(code);
+    vector_free(fixups);
+}
+
+#else  /* !__x86_64__ */
+
+void *jit_compile(unused struct ir_fn_decl *decl, unused jit_lookup_t lookup)
+{
+    return NULL;
+}
+
+void *jit_compile_osr(
+    unused struct ir_fn_decl *decl,
+    unused jit_lookup_t       lookup,
+    unused struct ir_node    *entry
+) {
+    return NULL;
+}
+
+int32_t jit_call(unused void *code, unused int32_t *args, unused uint64_t args_size)
+{
+    weak_unreachable("JIT is not supported on this host.");
+}
+
+int32_t jit_call_osr(unused void *code, unused int32_t *vars)
+{
+    weak_unreachable("JIT is not supported on this host.");
+}
+
+void *jit_install(
+    unused const char    *name,
+    unused const uint8_t *bytes,
+    unused uint64_t       size
+) {
+    return NULL;
+}
+
+void jit_reset() {}
+
+#endif /* __x86_64__ */
@@ -0,0 +1,63 @@
+/* jit.h - x86-64 JIT compiler for IR interpreter.
+ * Copyright (C) 2024 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#ifndef WEAK_COMPILER_BACKEND_JIT_H
+#define WEAK_COMPILER_BACKEND_JIT_H
+
+#include <stdint.h>
+
+struct ir_fn_decl;
+struct ir_node;
+
+/** Maximum number of arguments of compiled function. */
+#define JIT_ARGS_LIMIT 6
+
+typedef struct ir_fn_decl *(*jit_lookup_t)(const char *name);
+
+/** Compile function to native code in executable memory.
+    Functions, called by it, are compiled too. `lookup` is
+    used to find them by name.
+
+    Only functions over `int` variables and arguments are
+    supported. Mutual recursion is not supported, self
+    recursion is.
+
+    Each compiled function is written to /tmp/perf-<pid>.map,
+    so `perf` can attribute samples to it.
+
+    \return Native code of `int32_t f(int32_t, ...)` or NULL,
+            if some IR is not supported or host is not x86-64.
+            Result is cached, so function is compiled only once. */
+void *jit_compile(struct ir_fn_decl *decl, jit_lookup_t lookup);
+
+/** Compile function for on-stack replacement: code takes
+    values of all variables, indexed by variable index, and
+    continues from statement `entry` of function body.
+
+    Used to leave interpreter in the middle of long loop.
+    Result is not cached.
+
+    \return Native code, callable with jit_call_osr(), or NULL. */
+void *jit_compile_osr(struct ir_fn_decl *decl, jit_lookup_t lookup, struct ir_node *entry);
+
+/** Call code returned by jit_compile() with arguments in
+    registers by System V ABI. */
+int32_t jit_call(void *code, int32_t *args, uint64_t args_size);
+
+/** Call code returned by jit_compile_osr() or
+    stencil_compile_osr() with values of variables. */
+int32_t jit_call_osr(void *code, int32_t *vars);
+
+/** Copy code to new executable memory and publish it in
+    /tmp/perf-<pid>.map under given name.
+
+    \return Executable copy of code or NULL on failure. */
+void *jit_install(const char *name, const uint8_t *bytes, uint64_t size);
+
+/** Release all compiled and installed code. */
+void jit_reset();
+
+#endif // WEAK_COMPILER_BACKEND_JIT_H
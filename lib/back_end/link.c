@@ -0,0 +1,285 @@
+/* link.c - Static linker.
+ * Copyright (C) 2024 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#include "back_end/link.h"
+#include "back_end/back_end.h"
+#include "back_end/elf.h"
+#include "util/crc32.h"
+#include "util/hashmap.h"
+#include "util/unreachable.h"
+#include "util/vector.h"
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/* Object file, mapped into memory. */
+struct link_object {
+    const char            *path;
+    const uint8_t         *map;
+    uint64_t               size;
+    const struct elf_shdr *text;
+    const struct elf_shdr *symtab;
+    const struct elf_shdr *strtab;
+    /* NULL if object calls nothing outside. */
+    const struct elf_shdr *rela;
+    /* Offset of .text in executable. */
+    uint64_t               base;
+};
+
+static vector_t(struct link_object) objects;
+/* Key:   CRC32 of global symbol name
+   Value: .text offset in executable */
+static hashmap_t       symbols;
+static instr_vector_t  text;
+static symtab_vector_t symtab;
+
+/**********************************************
+ **               Reading                    **
+ **********************************************/
+
+static const void *link_data(struct link_object *o, uint64_t off, uint64_t size)
+{
+    if (off > o->size || size > o->size - off)
+        weak_fatal_error("`%s` is truncated.", o->path);
+
+    return o->map + off;
+}
+
+static const struct elf_shdr *link_section(struct link_object *o, uint64_t idx)
+{
+    const struct elf_fhdr *fhdr = link_data(o, 0, sizeof (*fhdr));
+
+    if (idx >= fhdr->shnum)
+        weak_fatal_error("`%s` has no section %lu.", o->path, idx);
+
+    return link_data(o, fhdr->shoff + idx * sizeof (struct elf_shdr), sizeof (struct elf_shdr));
+}
+
+static const struct elf_sym *link_sym(struct link_object *o, uint64_t idx)
+{
+    if ((idx + 1) * sizeof (struct elf_sym) > o->symtab->size)
+        weak_fatal_error("`%s` has no symbol %lu.", o->path, idx);
+
+    return link_data(o, o->symtab->off + idx * sizeof (struct elf_sym), sizeof (struct elf_sym));
+}
+
+static const char *link_sym_name(struct link_object *o, const struct elf_sym *sym)
+{
+    const char *strtab = link_data(o, o->strtab->off, o->strtab->size);
+
+    if (sym->name >= o->strtab->size || !memchr(strtab + sym->name, 0, o->strtab->size - sym->name))
+        weak_fatal_error("`%s` has corrupted .strtab.", o->path);
+
+    return strtab + sym->name;
+}
+
+static void link_open(const char *path)
+{
+    struct link_object o  = {.path = path};
+    struct stat        st = {0};
+    int                fd = open(path, O_RDONLY);
+
+    if (fd < 0)
+        weak_fatal_errno("open(%s)", path);
+
+    if (fstat(fd, &st) < 0)
+        weak_fatal_errno("fstat(%s)", path);
+
+    o.size = st.st_size;
+    o.map  = mmap(NULL, o.size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (o.map == MAP_FAILED)
+        weak_fatal_errno("mmap(%s)", path);
+
+    if (close(fd) < 0)
+        weak_fatal_errno("close()");
+
+    const struct elf_fhdr *fhdr = link_data(&o, 0, sizeof (*fhdr));
+
+    if (memcmp(fhdr->ident, "\x7F\x45\x4C\x46\x02\x01", 6) ||
+        fhdr->type != ET_REL ||
+        fhdr->machine != ELF_TARGET_ARCH)
+        weak_fatal_error("`%s` is not relocatable object for this target.", path);
+
+    const struct elf_shdr *shstrtab = link_section(&o, fhdr->shstrndx);
+    const char            *names    = link_data(&o, shstrtab->off, shstrtab->size);
+
+    for (uint64_t i = 1; i < fhdr->shnum; ++i) {
+        const struct elf_shdr *s = link_section(&o, i);
+
+        if (s->name_ptr >= shstrtab->size)
+            weak_fatal_error("`%s` has corrupted .shstrtab.", path);
+
+        if (!strcmp(names + s->name_ptr, ".text"))
+            o.text = s;
+
+        if (s->type == SHT_SYMTAB) {
+            o.symtab = s;
+            o.strtab = link_section(&o, s->link);
+        }
+
+        if (s->type == SHT_RELA)
+            o.rela = s;
+    }
+
+    if (!o.text || !o.symtab)
+        weak_fatal_error("`%s` has no .text or .symtab.", path);
+
+    vector_push_back(objects, o);
+}
+
+/**********************************************
+ **               Linking                    **
+ **********************************************/
+
+static bool link_defines(struct link_object *o, const char *name)
+{
+    uint64_t count = o->symtab->size / sizeof (struct elf_sym);
+
+    for (uint64_t i = o->symtab->info; i < count; ++i) {
+        const struct elf_sym *sym = link_sym(o, i);
+
+        if (sym->shndx != SHN_UNDEF && !strcmp(link_sym_name(o, sym), name))
+            return 1;
+    }
+
+    return 0;
+}
+
+/* Place .text of each object, starting from one with
+   entry point. */
+static void link_place()
+{
+    uint64_t entry = objects.count;
+
+    vector_foreach(objects, i)
+        if (link_defines(&vector_at(objects, i), "_start"))
+            entry = i;
+
+    if (entry == objects.count)
+        weak_fatal_error("No object defines main().");
+
+    struct link_object first = vector_at(objects, entry);
+    vector_at(objects, entry) = vector_at(objects, 0);
+    vector_at(objects, 0)     = first;
+
+    vector_foreach(objects, i) {
+        struct link_object *o     = &vector_at(objects, i);
+        uint64_t            align = o->text->addralign ? o->text->addralign : 1;
+        const uint8_t      *code  = link_data(o, o->text->off, o->text->size);
+
+        while (text.count % align)
+            vector_push_back(text, 0);
+
+        o->base = text.count;
+
+        for (uint64_t j = 0; j < o->text->size; ++j)
+            vector_push_back(text, code[j]);
+    }
+}
+
+static void link_symbols(struct link_object *o)
+{
+    uint64_t count = o->symtab->size / sizeof (struct elf_sym);
+
+    /* Only global symbols are visible to other objects. */
+    for (uint64_t i = o->symtab->info; i < count; ++i) {
+        const struct elf_sym *sym  = link_sym(o, i);
+        const char           *name = link_sym_name(o, sym);
+        uint64_t              crc  = crc32_string(name);
+
+        if (sym->shndx == SHN_UNDEF)
+            continue;
+
+        if (hashmap_has(&symbols, crc))
+            weak_fatal_error("Multiple definition of `%s` in `%s`.", name, o->path);
+
+        struct elf_symtab_entry e = {
+            .off = o->base + sym->value
+        };
+        strncpy(e.name, name, sizeof (e.name) - 1);
+
+        hashmap_put(&symbols, crc, e.off);
+        vector_push_back(symtab, e);
+    }
+}
+
+/* Addend of each relocation is implied by ELF_R_CALL_ADDEND,
+   back_end_native_patch() takes offset from the start of
+   instruction. */
+static void link_relocate(struct link_object *o)
+{
+    if (!o->rela)
+        return;
+
+    uint64_t count = o->rela->size / sizeof (struct elf_rela);
+
+    for (uint64_t i = 0; i < count; ++i) {
+        const struct elf_rela *r    = link_data(o, o->rela->off + i * sizeof (*r), sizeof (*r));
+        const struct elf_sym  *sym  = link_sym(o, ELF64_R_SYM(r->info));
+        const char            *name = link_sym_name(o, sym);
+        uint64_t               to   = 0;
+        bool                   ok   = 0;
+
+        if (ELF64_R_TYPE(r->info) != ELF_R_CALL)
+            weak_fatal_error("Unsupported relocation %lu in `%s`.", ELF64_R_TYPE(r->info), o->path);
+
+        /* Start of call instruction. Wraps around, if field
+           is closer to the start of .text than allowed. */
+        uint64_t instr = r->off - ELF_R_CALL_FIELD;
+
+        if (instr >= o->text->size || o->text->size - instr < ELF_R_CALL_FIELD + sizeof (uint32_t))
+            weak_fatal_error("Relocation is out of .text in `%s`.", o->path);
+
+        if (sym->shndx != SHN_UNDEF)
+            to = o->base + sym->value;
+        else
+            to = hashmap_get(&symbols, crc32_string(name), &ok);
+
+        if (sym->shndx == SHN_UNDEF && !ok)
+            weak_fatal_error("Undefined reference to `%s` in `%s`.", name, o->path);
+
+        uint64_t at = o->base + instr;
+
+        back_end_native_patch(&vector_at(text, at), (int64_t) to - (int64_t) at);
+    }
+}
+
+void back_end_link(const char **paths, uint64_t count, const char *path)
+{
+    hashmap_reset(&symbols, 64);
+
+    for (uint64_t i = 0; i < count; ++i)
+        link_open(paths[i]);
+
+    link_place();
+
+    vector_foreach(objects, i)
+        link_symbols(&vector_at(objects, i));
+
+    vector_foreach(objects, i)
+        link_relocate(&vector_at(objects, i));
+
+    struct codegen_output output = {
+        .instrs = text,
+        .symtab = symtab
+    };
+
+    elf_write(&output, path, ET_EXEC);
+
+    vector_foreach(objects, i) {
+        struct link_object *o = &vector_at(objects, i);
+
+        if (munmap((void *) o->map, o->size) < 0)
+            weak_fatal_errno("munmap()");
+    }
+
+    vector_free(objects);
+    vector_free(text);
+    vector_free(symtab);
+    hashmap_destroy(&symbols);
+}
@@ -0,0 +1,21 @@
+/* link.h - Static linker.
+ * Copyright (C) 2024 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#ifndef WEAK_COMPILER_BACKEND_LINK_H
+#define WEAK_COMPILER_BACKEND_LINK_H
+
+#include <stdint.h>
+
+/** Link relocatable objects, written by back_end_emit_object(),
+    into executable `path`.
+
+    .text sections are concatenated and calls to functions of
+    other objects are patched. Object, defining _start (that is,
+    main()), goes first, since executable is entered at the start
+    of .text. Duplicate and missing definitions are fatal errors. */
+void back_end_link(const char **objects, uint64_t count, const char *path);
+
+#endif // WEAK_COMPILER_BACKEND_LINK_H
@@ -6,53 +6,8 @@
 
 #include "back_end/back_end.h"
 #include "back_end/risc_v.h"
-
-/**********************************************
- **          Register allocation             **
- **********************************************/
-
-#define MAX_REGISTERS  32
-#define FREE_REG_START  5  // Start from `t0` (register 5)
-#define FREE_REG_END   31  // End at `t6` (register 31)
-
-static int reg_lru[MAX_REGISTERS] = {0};
-
-__attribute__ ((constructor)) static void init_lru()
-{
-    int idx = 0;
-    for (int i = FREE_REG_START; i <= FREE_REG_END; i++) {
-        reg_lru[idx++] = i;
-    }
-}
-
-static void update_lru(int reg)
-{
-    int i;
-    for (i = 0; i < MAX_REGISTERS; i++) {
-        if (reg_lru[i] == reg) {
-            break;
-        }
-    }
-    /* Shift elements to the left */
-    for (int j = i; j < MAX_REGISTERS - 1; j++) {
-        reg_lru[j] = reg_lru[j + 1];
-    }
-    /* Place the used register at the end */
-    reg_lru[MAX_REGISTERS - 1] = reg;
-}
-
-static int allocate_register()
-{
-    for (int i = FREE_REG_START; i <= FREE_REG_END; i++) {
-        /* Reclaim the least recently used register */
-        if (reg_lru[0] == i) {
-            int reg = reg_lru[0];
-            update_lru(reg);
-            return reg;
-        }
-    }
-    return -1;
-}
+#include "util/unreachable.h"
+#include <string.h>
 
 /**********************************************
  **            RISC-V encoding               **
@@ -79,20 +34,36 @@ static void risc_v_20_imm_op(uint32_t op, int32_t reg, int32_t imm)
     put(code, 4);
 }
 
+/* Immediate bits of J-type instruction (jal). */
+static uint32_t risc_v_j_imm(int off)
+{
+    return (((uint32_t)(off >>  1) & 0x3FF) << 21)
+         | (((uint32_t)(off >> 11) & 0x1  ) << 20)
+         | (((uint32_t)(off >> 12) & 0xFF ) << 12)
+         | (((uint32_t)(off >> 20) & 0x1  ) << 31);
+}
+
+/* Immediate bits of B-type instruction (beq, bne, ...). */
+static uint32_t risc_v_b_imm(int off)
+{
+    return (((uint32_t)(off >>  1) & 0xF ) <<  8)
+         | (((uint32_t)(off >>  5) & 0x3F) << 25)
+         | (((uint32_t)(off >> 11) & 0x1 ) <<  7)
+         | (((uint32_t)(off >> 12) & 0x1 ) << 31);
+}
+
 static void risc_v_jal(int reg, int off)
 {
-    union {
-        uint8_t  code[4];
-        uint32_t instr;
-    } u;
+    uint8_t code[4] = {0};
+    write_uint32_le_m(code, risc_v_I_jal | ((uint32_t) reg << 7) | risc_v_j_imm(off));
+    put(code, 4);
+}
 
-    u.instr = risc_v_I_jal
-            | ( (uint32_t) reg <<  7)
-            | (((uint32_t)(off >>  1) & 0x3FF) << 21)
-            | (((uint32_t)(off >> 11) & 0x1  ) << 20)
-            | (((uint32_t)(off >> 12) & 0xFF ) << 12)
-            | (((uint32_t)(off >> 20) & 0x1  ) << 31);
-    put(u.code, 4);
+static void risc_v_b_op(int op, int r1, int r2, int off)
+{
+    uint8_t code[4] = {0};
+    write_uint32_le_m(code, op | (r1 << 15) | (r2 << 20) | risc_v_b_imm(off));
+    put(code, 4);
 }
 
 /* Load [31:12] bits of the register from 20-bit imm, signextend & zero lower bits */
@@ -135,15 +106,6 @@ static void risc_v_s_op_internal(int op, int reg, int addr, int off)
     put(code, 4);
 }
 
-static void risc_v_s_op(int op, int reg, int addr, int off)
-{
-    if (risc_v_is_valid_imm(off)) {
-        risc_v_s_op_internal(op, reg, addr, off);
-    } else {
-        /* TODO: Claim regs. */
-    }
-}
-
 /* Set native register reg to sign-extended 32-bit imm */
 static void risc_v_native_setreg32s(int reg, int imm)
 {
@@ -181,6 +143,8 @@ static int64_t sign_extend(uint64_t val, uint8_t bits)
     return ((int64_t)(val << (64 - bits))) >> (64 - bits);
 }
 
+/* Immediates and offsets, not fitting in 12 bits, are
+   loaded to `risc_v_reg_scratch`. */
 static void risc_v_i_op(int op, int rds, int r, int32_t imm)
 {
     if (risc_v_is_valid_imm(imm)) {
@@ -191,42 +155,312 @@ static void risc_v_i_op(int op, int rds, int r, int32_t imm)
             risc_v_i_op_internal(op, rds, r, imm >> 1);
             risc_v_i_op_internal(op, rds, rds, imm - (imm >> 1));
         } else {
-            fflush(stdout);
-            /* Reclaim register, load 32-bit imm, use in R-type op. */
-            int rtmp = allocate_register();
-            if (rtmp == -1) {
-                printf("No regs\n");
-                fflush(stdout);
-                abort();
-            }
-            printf("1 Allocated %d\n", rtmp);
-            fflush(stdout);
-            risc_v_native_setreg32(rtmp, imm);
-            risc_v_r_op(risc_v_i_to_r(op), rds, r, rtmp);
-            update_lru(rtmp);
+            /* Load 32-bit imm, use in R-type op. */
+            risc_v_native_setreg32(risc_v_reg_scratch, imm);
+            risc_v_r_op(risc_v_i_to_r(op), rds, r, risc_v_reg_scratch);
         }
     } else {
         int32_t imm_lo = sign_extend(imm, 12);
-        printf("%x sign extend %x\n", imm, imm_lo);
-        int rtmp = allocate_register();
-        if (rtmp == -1) {
-            printf("No regs\n");
-            fflush(stdout);
-            abort();
-        }
-        printf("2 Allocated %d\n", rtmp);
-        fflush(stdout);
 
-        risc_v_lui(rtmp, imm - imm_lo);
-        printf("lui %d, %x\n", rtmp, imm - imm_lo);
+        risc_v_lui(risc_v_reg_scratch, imm - imm_lo);
+        risc_v_r_op(risc_v_R_add, risc_v_reg_scratch, risc_v_reg_scratch, r);
+        risc_v_i_op_internal(op, rds, risc_v_reg_scratch, imm_lo);
+    }
+}
 
-        risc_v_r_op(risc_v_R_add, rtmp, rtmp, r);
-        printf("add %d, %d, %d\n", rtmp, rtmp, r);
+static void risc_v_s_op(int op, int reg, int addr, int off)
+{
+    if (risc_v_is_valid_imm(off)) {
+        risc_v_s_op_internal(op, reg, addr, off);
+    } else {
+        int32_t off_lo = sign_extend(off, 12);
+
+        risc_v_lui(risc_v_reg_scratch, off - off_lo);
+        risc_v_r_op(risc_v_R_add, risc_v_reg_scratch, risc_v_reg_scratch, addr);
+        risc_v_s_op_internal(op, reg, risc_v_reg_scratch, off_lo);
+    }
+}
+
+/**********************************************
+ **        Compressed instructions           **
+ **********************************************/
 
-        risc_v_i_op_internal(op, rds, rtmp, imm_lo);
-        printf("lb %d, %d, %x\n", rds, rtmp, imm_lo);
+#define risc_v_rd(i)  (((i) >>  7) & 0x1F)
+#define risc_v_rs1(i) (((i) >> 15) & 0x1F)
+#define risc_v_rs2(i) (((i) >> 20) & 0x1F)
+#define risc_v_f3(i)  (((i) >> 12) & 0x7)
 
-        update_lru(rtmp);
+static uint32_t read_uint32_le_m(const void *addr)
+{
+    const uint8_t *mem = (const uint8_t *) addr;
+    return (uint32_t) mem[0]
+         | (uint32_t) mem[1] <<  8
+         | (uint32_t) mem[2] << 16
+         | (uint32_t) mem[3] << 24;
+}
+
+static void write_uint16_le_m(void *addr, uint16_t v)
+{
+    uint8_t *mem = (uint8_t *) addr;
+    mem[0] = (v     ) & 0xFF;
+    mem[1] = (v >> 8) & 0xFF;
+}
+
+/* Registers x8-x15, addressable by 3-bit field. */
+static bool risc_v_is_c_reg(int reg)
+{
+    return reg >= 8 && reg <= 15;
+}
+
+static bool risc_v_fits(int64_t imm, int bits)
+{
+    return imm >= -(1L << (bits - 1)) && imm < (1L << (bits - 1));
+}
+
+/* Bit `from` of `v`, placed at bit `to`. */
+static uint16_t risc_v_bit(int64_t v, int from, int to)
+{
+    return ((v >> from) & 1) << to;
+}
+
+/* CI format: imm[5] at bit 12, imm[4:0] at bits 6:2. */
+static uint16_t risc_v_ci(int f3, int rd, int64_t imm, int op)
+{
+    return (f3 << 13) | risc_v_bit(imm, 5, 12) | (rd << 7) | ((imm & 0x1F) << 2) | op;
+}
+
+/* Immediate bits of CJ-type instruction (c.j). */
+static uint16_t risc_v_cj_imm(int64_t off)
+{
+    return risc_v_bit(off, 11, 12) | risc_v_bit(off,  4, 11)
+         | risc_v_bit(off,  9, 10) | risc_v_bit(off,  8,  9)
+         | risc_v_bit(off, 10,  8) | risc_v_bit(off,  6,  7)
+         | risc_v_bit(off,  7,  6) | risc_v_bit(off,  3,  5)
+         | risc_v_bit(off,  2,  4) | risc_v_bit(off,  1,  3)
+         | risc_v_bit(off,  5,  2);
+}
+
+/* Immediate bits of CB-type branch (c.beqz, c.bnez). */
+static uint16_t risc_v_cb_imm(int64_t off)
+{
+    return risc_v_bit(off, 8, 12) | risc_v_bit(off, 4, 11)
+         | risc_v_bit(off, 3, 10) | risc_v_bit(off, 7,  6)
+         | risc_v_bit(off, 6,  5) | risc_v_bit(off, 2,  4)
+         | risc_v_bit(off, 1,  3) | risc_v_bit(off, 5,  2);
+}
+
+static bool risc_v_compress_op_imm(uint32_t i, uint16_t *c)
+{
+    int     rd  = risc_v_rd(i);
+    int     rs1 = risc_v_rs1(i);
+    int64_t imm = (int32_t) i >> 20;
+
+    if (rd == risc_v_reg_zero)
+        return 0;
+
+    switch (risc_v_f3(i)) {
+    case 0: /* addi */
+        if (rs1 == risc_v_reg_zero && risc_v_fits(imm, 6))
+            /* c.li */
+            *c = risc_v_ci(0b010, rd, imm, 0b01);
+        else if (imm == 0)
+            /* c.mv */
+            *c = (0b1000 << 12) | (rd << 7) | (rs1 << 2) | 0b10;
+        else if (rd == risc_v_reg_sp && rs1 == risc_v_reg_sp &&
+                 imm % 16 == 0 && risc_v_fits(imm, 10))
+            /* c.addi16sp */
+            *c = (0b011 << 13) | risc_v_bit(imm, 9, 12) | (rd << 7)
+               | risc_v_bit(imm, 4, 6) | risc_v_bit(imm, 6, 5)
+               | risc_v_bit(imm, 8, 4) | risc_v_bit(imm, 7, 3)
+               | risc_v_bit(imm, 5, 2) | 0b01;
+        else if (rd == rs1 && risc_v_fits(imm, 6))
+            /* c.addi */
+            *c = risc_v_ci(0b000, rd, imm, 0b01);
+        else if (rs1 == risc_v_reg_sp && risc_v_is_c_reg(rd) &&
+                 imm > 0 && imm < 1024 && imm % 4 == 0)
+            /* c.addi4spn */
+            *c = ((imm >> 4 & 0x3) << 11) | ((imm >> 6 & 0xF) << 7)
+               | risc_v_bit(imm, 2, 6) | risc_v_bit(imm, 3, 5)
+               | ((rd - 8) << 2);
+        else
+            return 0;
+        return 1;
+    case 1: /* slli */
+        if (rd != rs1 || (imm & 0x3F) == 0)
+            return 0;
+        *c = risc_v_ci(0b000, rd, imm & 0x3F, 0b10);
+        return 1;
+    case 5: /* srli, srai */
+        if (rd != rs1 || !risc_v_is_c_reg(rd) || (imm & 0x3F) == 0)
+            return 0;
+        *c = risc_v_ci(0b100, rd - 8, imm & 0x3F, 0b01)
+           | ((i >> 30 & 1) << 10);
+        return 1;
+    case 7: /* andi */
+        if (rd != rs1 || !risc_v_is_c_reg(rd) || !risc_v_fits(imm, 6))
+            return 0;
+        *c = risc_v_ci(0b100, rd - 8, imm, 0b01) | (0b10 << 10);
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+static bool risc_v_compress_op(uint32_t i, uint16_t *c)
+{
+    int rd  = risc_v_rd(i);
+    int rs1 = risc_v_rs1(i);
+    int rs2 = risc_v_rs2(i);
+
+    uint32_t op  = i & 0xFE00707F;
+
+    if (rd == risc_v_reg_zero)
+        return 0;
+
+    /* Operations are commutative, except sub. */
+    if (rd == rs2 && op != risc_v_R_sub) {
+        rs2 = rs1;
+        rs1 = rd;
+    }
+
+    if (op == risc_v_R_add) {
+        if (rs1 == risc_v_reg_zero && rs2 != risc_v_reg_zero)
+            /* c.mv */
+            *c = (0b1000 << 12) | (rd << 7) | (rs2 << 2) | 0b10;
+        else if (rd == rs1 && rs2 != risc_v_reg_zero)
+            /* c.add */
+            *c = (0b1001 << 12) | (rd << 7) | (rs2 << 2) | 0b10;
+        else
+            return 0;
+        return 1;
+    }
+
+    if (rd != rs1 || !risc_v_is_c_reg(rd) || !risc_v_is_c_reg(rs2))
+        return 0;
+
+    int funct2;
+    switch (op) {
+    case risc_v_R_sub: funct2 = 0b00; break;
+    case risc_v_R_xor: funct2 = 0b01; break;
+    case risc_v_R_or:  funct2 = 0b10; break;
+    case risc_v_R_and: funct2 = 0b11; break;
+    default:
+        return 0;
+    }
+
+    /* c.sub, c.xor, c.or, c.and */
+    *c = (0b100011 << 10) | ((rd - 8) << 7) | (funct2 << 5) | ((rs2 - 8) << 2) | 0b01;
+    return 1;
+}
+
+/* c.lw, c.ld, c.sw, c.sd and their sp-relative forms.
+   `reg` is loaded or stored register. */
+static bool risc_v_compress_mem(bool store, int f3, int reg, int addr, int64_t off, uint16_t *c)
+{
+    bool wide = f3 == 3;
+    int  q    = wide ? 0b011 : 0b010;
+
+    if (f3 != 2 && f3 != 3)
+        return 0;
+    if (off < 0 || off % (wide ? 8 : 4))
+        return 0;
+
+    if (store)
+        q |= 0b100;
+
+    if (addr == risc_v_reg_sp) {
+        if (off >= (wide ? 512 : 256))
+            return 0;
+        if (!store && reg == risc_v_reg_zero)
+            return 0;
+
+        if (store && wide)
+            /* c.sdsp */
+            *c = (q << 13) | ((off >> 3 & 0x7) << 10) | ((off >> 6 & 0x7) << 7) | (reg << 2) | 0b10;
+        else if (store)
+            /* c.swsp */
+            *c = (q << 13) | ((off >> 2 & 0xF) << 9) | ((off >> 6 & 0x3) << 7) | (reg << 2) | 0b10;
+        else if (wide)
+            /* c.ldsp */
+            *c = (q << 13) | risc_v_bit(off, 5, 12) | (reg << 7)
+               | ((off >> 3 & 0x3) << 5) | ((off >> 6 & 0x7) << 2) | 0b10;
+        else
+            /* c.lwsp */
+            *c = (q << 13) | risc_v_bit(off, 5, 12) | (reg << 7)
+               | ((off >> 2 & 0x7) << 4) | ((off >> 6 & 0x3) << 2) | 0b10;
+        return 1;
+    }
+
+    if (!risc_v_is_c_reg(reg) || !risc_v_is_c_reg(addr) || off >= (wide ? 256 : 128))
+        return 0;
+
+    /* c.lw, c.ld, c.sw, c.sd */
+    *c = (q << 13) | ((off >> 3 & 0x7) << 10) | ((addr - 8) << 7) | ((reg - 8) << 2);
+    if (wide)
+        *c |= (off >> 6 & 0x3) << 5;
+    else
+        *c |= risc_v_bit(off, 2, 6) | risc_v_bit(off, 6, 5);
+    return 1;
+}
+
+/* Find 16-bit form of instruction. Offset of jump or
+   branch is `off`, if `fixup` is set. Instructions with
+   offset, given explicitly, stay as is. */
+static bool risc_v_compress(uint32_t i, bool fixup, int64_t off, uint16_t *c)
+{
+    int rd  = risc_v_rd(i);
+    int rs1 = risc_v_rs1(i);
+    int rs2 = risc_v_rs2(i);
+
+    switch (i & 0x7F) {
+    case 0b0010011:
+        return risc_v_compress_op_imm(i, c);
+    case risc_v_I_addiw: {
+        int64_t imm = (int32_t) i >> 20;
+        if (risc_v_f3(i) != 0 || rd == risc_v_reg_zero || rd != rs1 || !risc_v_fits(imm, 6))
+            return 0;
+        /* c.addiw */
+        *c = risc_v_ci(0b001, rd, imm, 0b01);
+        return 1;
+    }
+    case 0b0110011:
+        return risc_v_compress_op(i, c);
+    case 0b0000011:
+        return risc_v_compress_mem(
+            /*store=*/0, risc_v_f3(i), rd, rs1, (int32_t) i >> 20, c);
+    case 0b0100011:
+        return risc_v_compress_mem(
+            /*store=*/1, risc_v_f3(i), rs2, rs1,
+            (((int32_t) i >> 25) * 32) | rd, c);
+    case risc_v_I_lui: {
+        int64_t imm = (int32_t) i >> 12;
+        if (rd == risc_v_reg_zero || rd == risc_v_reg_sp || imm == 0 || !risc_v_fits(imm, 6))
+            return 0;
+        /* c.lui */
+        *c = risc_v_ci(0b011, rd, imm, 0b01);
+        return 1;
+    }
+    case risc_v_I_jalr:
+        if (rd != risc_v_reg_zero || rs1 == risc_v_reg_zero || (i >> 20) != 0)
+            return 0;
+        /* c.jr */
+        *c = (0b1000 << 12) | (rs1 << 7) | 0b10;
+        return 1;
+    case risc_v_I_jal:
+        if (!fixup || rd != risc_v_reg_zero || !risc_v_fits(off, 12))
+            return 0;
+        /* c.j */
+        *c = (0b101 << 13) | risc_v_cj_imm(off) | 0b01;
+        return 1;
+    case risc_v_B_beq & 0x7F:
+        if (!fixup || risc_v_f3(i) > 1 || rs2 != risc_v_reg_zero ||
+            !risc_v_is_c_reg(rs1) || !risc_v_fits(off, 9))
+            return 0;
+        /* c.beqz, c.bnez */
+        *c = ((0b110 | risc_v_f3(i)) << 13) | risc_v_cb_imm(off) | ((rs1 - 8) << 7) | 0b01;
+        return 1;
+    default:
+        return 0;
     }
 }
 
@@ -239,6 +473,50 @@ int back_end_return_reg()
     return risc_v_reg_a0;
 }
 
+int back_end_arg_reg(int n)
+{
+    if (n < 0 || n > 7)
+        weak_unreachable("No register for argument %d.", n);
+
+    return risc_v_reg_a0 + n;
+}
+
+int back_end_tmp_reg(int n)
+{
+    static const int regs[] = {
+        risc_v_reg_t0,
+        risc_v_reg_t1,
+        risc_v_reg_t2,
+        risc_v_reg_t3,
+        risc_v_reg_t4,
+        risc_v_reg_t5
+    };
+
+    if (n < 0 || n >= (int) __weak_array_size(regs))
+        return -1;
+
+    return regs[n];
+}
+
+int back_end_saved_reg(int n)
+{
+    /* s0 is frame pointer. */
+    if (n < 0 || n > 10)
+        return -1;
+
+    return n == 0 ? risc_v_reg_s1 : risc_v_reg_s2 + n - 1;
+}
+
+int back_end_sp_reg()
+{
+    return risc_v_reg_sp;
+}
+
+int back_end_zero_reg()
+{
+    return risc_v_reg_zero;
+}
+
 void back_end_native_add(int dst, int reg1, int reg2)
 {
     risc_v_r_op(risc_v_R_add, dst, reg1, reg2);
@@ -264,6 +542,11 @@ void back_end_native_div(int dst, int reg1, int reg2)
     risc_v_r_op(risc_v_M_div, dst, reg1, reg2);
 }
 
+void back_end_native_rem(int dst, int reg1, int reg2)
+{
+    risc_v_r_op(risc_v_M_mod, dst, reg1, reg2);
+}
+
 void back_end_native_mul(int dst, int reg1, int reg2)
 {
     risc_v_r_op(risc_v_M_mul, dst, reg1, reg2);
@@ -274,16 +557,31 @@ void back_end_native_xor(int dst, int reg1, int reg2)
     risc_v_r_op(risc_v_R_xor, dst, reg1, reg2);
 }
 
+void back_end_native_xori(int dst, int reg1, int imm)
+{
+    risc_v_i_op(risc_v_I_xori, dst, reg1, imm);
+}
+
 void back_end_native_and(int dst, int reg1, int reg2)
 {
     risc_v_r_op(risc_v_R_and, dst, reg1, reg2);
 }
 
+void back_end_native_andi(int dst, int reg1, int imm)
+{
+    risc_v_i_op(risc_v_I_andi, dst, reg1, imm);
+}
+
 void back_end_native_or(int dst, int reg1, int reg2)
 {
     risc_v_r_op(risc_v_R_or, dst, reg1, reg2);
 }
 
+void back_end_native_ori(int dst, int reg1, int imm)
+{
+    risc_v_i_op(risc_v_I_ori, dst, reg1, imm);
+}
+
 void back_end_native_sra(int dst, int reg1, int reg2)
 {
     risc_v_r_op(risc_v_R_sra, dst, reg1, reg2);
@@ -294,9 +592,44 @@ void back_end_native_srl(int dst, int reg1, int reg2)
     risc_v_r_op(risc_v_R_srl, dst, reg1, reg2);
 }
 
+void back_end_native_srai(int dst, int reg1, int imm)
+{
+    risc_v_i_op_internal(risc_v_I_srai, dst, reg1, imm & 0x3F);
+}
+
+void back_end_native_sll(int dst, int reg1, int reg2)
+{
+    risc_v_r_op(risc_v_R_sll, dst, reg1, reg2);
+}
+
+void back_end_native_slli(int dst, int reg1, int imm)
+{
+    risc_v_i_op_internal(risc_v_I_slli, dst, reg1, imm & 0x3F);
+}
+
+void back_end_native_slt(int dst, int reg1, int reg2)
+{
+    risc_v_r_op(risc_v_R_slt, dst, reg1, reg2);
+}
+
+void back_end_native_slti(int dst, int reg1, int imm)
+{
+    risc_v_i_op(risc_v_I_slti, dst, reg1, imm);
+}
+
+void back_end_native_seqz(int dst, int reg1)
+{
+    risc_v_i_op_internal(risc_v_I_sltiu, dst, reg1, 1);
+}
+
+void back_end_native_snez(int dst, int reg1)
+{
+    risc_v_r_op(risc_v_R_sltu, dst, risc_v_reg_zero, reg1);
+}
+
 void back_end_native_li(int dst, int imm)
 {
-    back_end_native_addi(dst, risc_v_reg_zero, imm);
+    risc_v_native_setreg32s(dst, imm);
 }
 
 void back_end_native_lb(int dst, int addr, int off)
@@ -364,11 +697,135 @@ void back_end_native_call(int off)
     risc_v_jal(risc_v_reg_ra, off);
 }
 
+void back_end_native_jmp(int off)
+{
+    risc_v_jal(risc_v_reg_zero, off);
+}
+
 void back_end_native_jmp_reg(int reg)
 {
     risc_v_i_op(risc_v_I_jalr, risc_v_reg_zero, reg, 0);
 }
 
+void back_end_native_beq(int reg1, int reg2, int off)
+{
+    risc_v_b_op(risc_v_B_beq, reg1, reg2, off);
+}
+
+void back_end_native_bne(int reg1, int reg2, int off)
+{
+    risc_v_b_op(risc_v_B_bne, reg1, reg2, off);
+}
+
+void back_end_native_blt(int reg1, int reg2, int off)
+{
+    risc_v_b_op(risc_v_B_blt, reg1, reg2, off);
+}
+
+void back_end_native_bge(int reg1, int reg2, int off)
+{
+    risc_v_b_op(risc_v_B_bge, reg1, reg2, off);
+}
+
+void back_end_native_patch(uint8_t *code, int64_t off)
+{
+    if ((code[0] & 0b11) != 0b11) {
+        uint16_t instr = code[0] | (code[1] << 8);
+
+        switch (instr >> 13) {
+        case 0b101:
+            instr = (instr & 0xE003) | risc_v_cj_imm(off);
+            break;
+        case 0b110:
+        case 0b111:
+            instr = (instr & 0xE383) | risc_v_cb_imm(off);
+            break;
+        default:
+            weak_unreachable("Cannot patch instruction %04x.", instr);
+        }
+
+        write_uint16_le_m(code, instr);
+        return;
+    }
+
+    uint32_t instr = read_uint32_le_m(code);
+
+    switch (instr & 0x7F) {
+    case risc_v_I_jal:
+        if (off < -(1 << 20) || off >= (1 << 20))
+            weak_fatal_error("Jump offset %ld does not fit in 21 bits.", off);
+
+        instr = (instr & 0x00000FFF) | risc_v_j_imm(off);
+        break;
+    case risc_v_B_beq & 0x7F:
+        if (off < -(1 << 12) || off >= (1 << 12))
+            weak_fatal_error("Branch offset %ld does not fit in 13 bits.", off);
+
+        instr = (instr & 0x01FFF07F) | risc_v_b_imm(off);
+        break;
+    default:
+        weak_unreachable("Cannot patch instruction %08x.", instr);
+    }
+
+    write_uint32_le_m(code, instr);
+}
+
+uint64_t back_end_native_relax_size(const uint8_t *code, uint64_t size, bool fixup, int64_t off)
+{
+    uint16_t c     = 0;
+    uint32_t instr = 0;
+
+    /* Already laid out. */
+    if (size != 4)
+        return size;
+
+    instr = read_uint32_le_m(code);
+
+#ifdef CONFIG_USE_RVC
+    if (risc_v_compress(instr, fixup, off, &c))
+        return 2;
+#else
+    (void) c;
+#endif /* CONFIG_USE_RVC */
+
+    if (fixup && (instr & 0x7F) == (risc_v_B_beq & 0x7F) && !risc_v_fits(off, 13))
+        return 8;
+
+    return 4;
+}
+
+uint64_t back_end_native_relax(const uint8_t *code, uint64_t size, uint8_t *out, uint64_t out_size)
+{
+    uint16_t c     = 0;
+    uint32_t instr = 0;
+
+    if (size == out_size) {
+        memcpy(out, code, size);
+        return 0;
+    }
+
+    instr = read_uint32_le_m(code);
+
+    switch (out_size) {
+    case 2:
+        /* Offset is written later, so only registers
+           decide, if instruction has short form. */
+        if (!risc_v_compress(instr, /*fixup=*/1, /*off=*/0, &c))
+            weak_unreachable("Cannot compress instruction %08x.", instr);
+
+        write_uint16_le_m(out, c);
+        return 0;
+    case 8:
+        /* Branch with inverted condition skips jump,
+           which reaches far target. */
+        write_uint32_le_m(out, ((instr ^ (1 << 12)) & 0x01FFF07F) | risc_v_b_imm(8));
+        write_uint32_le_m(out + 4, risc_v_I_jal | (risc_v_reg_zero << 7));
+        return 4;
+    default:
+        weak_unreachable("Cannot relax instruction %08x to %lu bytes.", instr, out_size);
+    }
+}
+
 void back_end_native_syscall_0(int syscall)
 {
     back_end_native_li(risc_v_reg_a7, syscall);
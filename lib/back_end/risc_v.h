@@ -98,4 +98,8 @@
 #define risc_v_reg_t3               28
 #define risc_v_reg_t4               29
 #define risc_v_reg_t5               30
-#define risc_v_reg_t6               31
\ No newline at end of file
+#define risc_v_reg_t6               31
+
+/* Clobbered by encoder to materialize large immediates
+   and offsets. Never given to code generator. */
+#define risc_v_reg_scratch          risc_v_reg_t6
\ No newline at end of file
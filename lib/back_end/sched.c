@@ -0,0 +1,505 @@
+/* sched.c - Basic block list scheduler.
+ * Copyright (C) 2024 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#include "back_end/sched.h"
+#include "back_end/back_end.h"
+#include "util/compiler.h"
+#include "util/unreachable.h"
+#include "util/vector.h"
+#include <string.h>
+
+/* Operations are collected until the end of basic block.
+   Then dependence graph of block is built from registers
+   and memory accesses and operations are reordered by list
+   scheduling: in each cycle ready operation with the longest
+   latency path to the end of block is issued, so independent
+   work fills delays of loads, multiplies and divides.
+
+   New order is kept only if model estimates it faster
+   than the original one. */
+
+/* Longer blocks are split. */
+#define BLOCK_LIMIT 256
+#define NO_EDGE     -1
+
+#define max(a, b) ((a) > (b) ? (a) : (b))
+
+enum role {
+    ROLE_NONE,
+    ROLE_DEF,
+    ROLE_USE,
+    ROLE_IMM
+};
+
+struct op_info {
+    enum sched_class cls;
+    enum role        roles[3];
+    /* Bytes read or written by load or store. */
+    uint8_t          bytes;
+    /* Operation ends basic block. */
+    bool             barrier;
+};
+
+struct instr {
+    enum sched_op op;
+    int           ops[3];
+    bool          fixup;
+    uint64_t      label;
+};
+
+#define RRR { ROLE_DEF, ROLE_USE, ROLE_USE }
+#define RRI { ROLE_DEF, ROLE_USE, ROLE_IMM }
+#define RR  { ROLE_DEF, ROLE_USE, ROLE_NONE }
+#define RI  { ROLE_DEF, ROLE_IMM, ROLE_NONE }
+#define LD  { ROLE_DEF, ROLE_USE, ROLE_IMM }
+#define ST  { ROLE_USE, ROLE_USE, ROLE_IMM }
+#define BR  { ROLE_USE, ROLE_USE, ROLE_IMM }
+#define I   { ROLE_IMM, ROLE_NONE, ROLE_NONE }
+#define R   { ROLE_USE, ROLE_NONE, ROLE_NONE }
+#define NO  { ROLE_NONE, ROLE_NONE, ROLE_NONE }
+
+/* Key: Operation.
+   Value: Class, operand roles, memory access size, barrier flag. */
+static const struct op_info infos[SCHED_OP_COUNT] = {
+    [SCHED_ADD]      = { SCHED_CLASS_ALU,   RRR, 0, 0 },
+    [SCHED_ADDI]     = { SCHED_CLASS_ALU,   RRI, 0, 0 },
+    [SCHED_ADDIW]    = { SCHED_CLASS_ALU,   RRI, 0, 0 },
+    [SCHED_SUB]      = { SCHED_CLASS_ALU,   RRR, 0, 0 },
+    [SCHED_DIV]      = { SCHED_CLASS_DIV,   RRR, 0, 0 },
+    [SCHED_REM]      = { SCHED_CLASS_DIV,   RRR, 0, 0 },
+    [SCHED_MUL]      = { SCHED_CLASS_MUL,   RRR, 0, 0 },
+    [SCHED_XOR]      = { SCHED_CLASS_ALU,   RRR, 0, 0 },
+    [SCHED_XORI]     = { SCHED_CLASS_ALU,   RRI, 0, 0 },
+    [SCHED_AND]      = { SCHED_CLASS_ALU,   RRR, 0, 0 },
+    [SCHED_ANDI]     = { SCHED_CLASS_ALU,   RRI, 0, 0 },
+    [SCHED_OR]       = { SCHED_CLASS_ALU,   RRR, 0, 0 },
+    [SCHED_ORI]      = { SCHED_CLASS_ALU,   RRI, 0, 0 },
+    [SCHED_SRA]      = { SCHED_CLASS_ALU,   RRR, 0, 0 },
+    [SCHED_SRL]      = { SCHED_CLASS_ALU,   RRR, 0, 0 },
+    [SCHED_SRAI]     = { SCHED_CLASS_ALU,   RRI, 0, 0 },
+    [SCHED_SLL]      = { SCHED_CLASS_ALU,   RRR, 0, 0 },
+    [SCHED_SLLI]     = { SCHED_CLASS_ALU,   RRI, 0, 0 },
+    [SCHED_SLT]      = { SCHED_CLASS_ALU,   RRR, 0, 0 },
+    [SCHED_SLTI]     = { SCHED_CLASS_ALU,   RRI, 0, 0 },
+    [SCHED_SEQZ]     = { SCHED_CLASS_ALU,   RR,  0, 0 },
+    [SCHED_SNEZ]     = { SCHED_CLASS_ALU,   RR,  0, 0 },
+    [SCHED_LI]       = { SCHED_CLASS_ALU,   RI,  0, 0 },
+    [SCHED_LB]       = { SCHED_CLASS_LOAD,  LD,  1, 0 },
+    [SCHED_LBU]      = { SCHED_CLASS_LOAD,  LD,  1, 0 },
+    [SCHED_LH]       = { SCHED_CLASS_LOAD,  LD,  2, 0 },
+    [SCHED_LHU]      = { SCHED_CLASS_LOAD,  LD,  2, 0 },
+    [SCHED_LW]       = { SCHED_CLASS_LOAD,  LD,  4, 0 },
+    [SCHED_LWU]      = { SCHED_CLASS_LOAD,  LD,  4, 0 },
+    [SCHED_LD]       = { SCHED_CLASS_LOAD,  LD,  8, 0 },
+    [SCHED_SB]       = { SCHED_CLASS_STORE, ST,  1, 0 },
+    [SCHED_SH]       = { SCHED_CLASS_STORE, ST,  2, 0 },
+    [SCHED_SW]       = { SCHED_CLASS_STORE, ST,  4, 0 },
+    [SCHED_SD]       = { SCHED_CLASS_STORE, ST,  8, 0 },
+    [SCHED_RET]      = { SCHED_CLASS_BRANCH,NO,  0, 1 },
+    [SCHED_CALL]     = { SCHED_CLASS_BRANCH,I,   0, 1 },
+    [SCHED_JMP]      = { SCHED_CLASS_BRANCH,I,   0, 1 },
+    [SCHED_JMP_REG]  = { SCHED_CLASS_BRANCH,R,   0, 1 },
+    [SCHED_BEQ]      = { SCHED_CLASS_BRANCH,BR,  0, 1 },
+    [SCHED_BNE]      = { SCHED_CLASS_BRANCH,BR,  0, 1 },
+    [SCHED_BLT]      = { SCHED_CLASS_BRANCH,BR,  0, 1 },
+    [SCHED_BGE]      = { SCHED_CLASS_BRANCH,BR,  0, 1 },
+    [SCHED_SYSCALL]  = { SCHED_CLASS_BRANCH,I,   0, 1 },
+    [SCHED_PROLOGUE] = { SCHED_CLASS_ALU,   I,   0, 1 },
+    [SCHED_EPILOGUE] = { SCHED_CLASS_ALU,   I,   0, 1 },
+};
+
+#undef RRR
+#undef RRI
+#undef RR
+#undef RI
+#undef LD
+#undef ST
+#undef BR
+#undef I
+#undef R
+#undef NO
+
+static const struct sched_model models[] = {
+    /* Integer pipeline of SiFive U74: two ALU pipes, one
+       memory pipe, pipelined multiplier and iterative divider. */
+    {
+        .name        = "u74",
+        .issue_width = 2,
+        .latency     = {
+            [SCHED_CLASS_ALU]    = 1,
+            [SCHED_CLASS_LOAD]   = 3,
+            [SCHED_CLASS_STORE]  = 1,
+            [SCHED_CLASS_MUL]    = 3,
+            [SCHED_CLASS_DIV]    = 20,
+            [SCHED_CLASS_BRANCH] = 1
+        },
+        .units       = {
+            [SCHED_CLASS_ALU]    = 2,
+            [SCHED_CLASS_LOAD]   = 1,
+            [SCHED_CLASS_MUL]    = 1,
+            [SCHED_CLASS_DIV]    = 1,
+            [SCHED_CLASS_BRANCH] = 1
+        }
+    },
+    {
+        .name        = "single",
+        .issue_width = 1,
+        .latency     = {
+            [SCHED_CLASS_ALU]    = 1,
+            [SCHED_CLASS_LOAD]   = 2,
+            [SCHED_CLASS_STORE]  = 1,
+            [SCHED_CLASS_MUL]    = 4,
+            [SCHED_CLASS_DIV]    = 34,
+            [SCHED_CLASS_BRANCH] = 1
+        },
+        .units       = {
+            [SCHED_CLASS_ALU]    = 1,
+            [SCHED_CLASS_LOAD]   = 1,
+            [SCHED_CLASS_MUL]    = 1,
+            [SCHED_CLASS_DIV]    = 1,
+            [SCHED_CLASS_BRANCH] = 1
+        }
+    }
+};
+
+static const struct sched_model *model = &models[0];
+static struct sched_stats        stats;
+static vector_t(struct instr)    block;
+static bool                      fixup_pending;
+static uint64_t                  fixup_label;
+/* edges[i][j]: latency from i-th to j-th operation of
+   block, i < j, or NO_EDGE. */
+static int16_t                   edges[BLOCK_LIMIT][BLOCK_LIMIT];
+
+/**********************************************
+ * Dependencies                               *
+ **********************************************/
+
+static uint64_t latency(const struct instr *in)
+{
+    return model->latency[infos[in->op].cls];
+}
+
+static enum sched_class unit(const struct instr *in)
+{
+    enum sched_class cls = infos[in->op].cls;
+    return cls == SCHED_CLASS_STORE ? SCHED_CLASS_LOAD : cls;
+}
+
+/* Accesses relative to stack pointer are disambiguated by
+   offset. If stack pointer changes between them, they are
+   ordered anyway through dependencies on it. */
+static bool may_alias(const struct instr *a, const struct instr *b)
+{
+    int sp = back_end_sp_reg();
+
+    if (a->ops[1] != sp || b->ops[1] != sp)
+        return 1;
+
+    int64_t a_lo = a->ops[2];
+    int64_t b_lo = b->ops[2];
+    int64_t a_hi = a_lo + infos[a->op].bytes;
+    int64_t b_hi = b_lo + infos[b->op].bytes;
+
+    return a_lo < b_hi && b_lo < a_hi;
+}
+
+static int dep(const struct instr *a, const struct instr *b)
+{
+    const struct op_info *ia  = &infos[a->op];
+    const struct op_info *ib  = &infos[b->op];
+    int                   lat = NO_EDGE;
+
+    /* Barrier stays at the end. */
+    if (ib->barrier)
+        lat = 0;
+
+    for (uint64_t i = 0; i < 3; ++i)
+        for (uint64_t j = 0; j < 3; ++j) {
+            if (a->ops[i] != b->ops[j])
+                continue;
+
+            enum role ra = ia->roles[i];
+            enum role rb = ib->roles[j];
+
+            if (ra == ROLE_DEF && rb == ROLE_USE)
+                lat = max(lat, (int) latency(a));
+            else if ((ra == ROLE_DEF && rb == ROLE_DEF) ||
+                     (ra == ROLE_USE && rb == ROLE_DEF))
+                lat = max(lat, 0);
+        }
+
+    bool store_a = ia->cls == SCHED_CLASS_STORE;
+    bool store_b = ib->cls == SCHED_CLASS_STORE;
+
+    if (ia->bytes && ib->bytes && (store_a || store_b) && may_alias(a, b))
+        lat = max(lat, store_a && !store_b ? (int) latency(a) : 0);
+
+    return lat;
+}
+
+static void edges_build(const struct instr *instrs, uint64_t n)
+{
+    for (uint64_t i = 0; i < n; ++i)
+        for (uint64_t j = i + 1; j < n; ++j)
+            edges[i][j] = dep(&instrs[i], &instrs[j]);
+}
+
+/**********************************************
+ * Scheduling                                 *
+ **********************************************/
+
+/* Issue cycles of operations in given order on in-order
+   pipeline. Operation waits for its operands and for free
+   issue slot and unit. */
+static uint64_t estimate(const struct instr *instrs, const uint64_t *order, uint64_t n)
+{
+    uint64_t issue[BLOCK_LIMIT] = {0};
+    uint64_t units[SCHED_CLASS_COUNT] = {0};
+    uint64_t cycle  = 0;
+    uint64_t issued = 0;
+
+    for (uint64_t k = 0; k < n; ++k) {
+        uint64_t         i = order[k];
+        uint64_t         t = cycle;
+        enum sched_class u = unit(&instrs[i]);
+
+        for (uint64_t p = 0; p < i; ++p)
+            if (edges[p][i] != NO_EDGE)
+                t = max(t, issue[p] + edges[p][i]);
+
+        if (t == cycle && (issued == model->issue_width || units[u] == model->units[u]))
+            ++t;
+
+        if (t != cycle) {
+            cycle  = t;
+            issued = 0;
+            memset(units, 0, sizeof (units));
+        }
+
+        issue[i] = t;
+        ++issued;
+        ++units[u];
+    }
+
+    return n > 0 ? cycle + 1 : 0;
+}
+
+static void schedule(const struct instr *instrs, uint64_t *order, uint64_t n)
+{
+    uint64_t height[BLOCK_LIMIT] = {0};
+    uint64_t ready [BLOCK_LIMIT] = {0};
+    uint64_t preds [BLOCK_LIMIT] = {0};
+    bool     done  [BLOCK_LIMIT] = {0};
+    uint64_t placed = 0;
+    uint64_t cycle  = 0;
+
+    /* Longest latency path to the end of block. */
+    for (uint64_t i = n; i-- > 0;) {
+        height[i] = latency(&instrs[i]);
+
+        for (uint64_t j = i + 1; j < n; ++j) {
+            if (edges[i][j] == NO_EDGE)
+                continue;
+            height[i] = max(height[i], edges[i][j] + height[j]);
+            ++preds[j];
+        }
+    }
+
+    while (placed < n) {
+        uint64_t units[SCHED_CLASS_COUNT] = {0};
+        uint64_t issued = 0;
+
+        while (issued < model->issue_width) {
+            int64_t best = -1;
+
+            for (uint64_t i = 0; i < n; ++i) {
+                enum sched_class u = unit(&instrs[i]);
+
+                if (done[i] || preds[i] > 0 || ready[i] > cycle || units[u] == model->units[u])
+                    continue;
+                if (best == -1 || height[i] > height[best])
+                    best = i;
+            }
+
+            if (best == -1)
+                break;
+
+            done[best]       = 1;
+            order[placed++]  = best;
+            ++units[unit(&instrs[best])];
+            ++issued;
+
+            for (uint64_t j = best + 1; j < n; ++j) {
+                if (edges[best][j] == NO_EDGE)
+                    continue;
+                --preds[j];
+                ready[j] = max(ready[j], cycle + edges[best][j]);
+            }
+        }
+
+        ++cycle;
+    }
+}
+
+/**********************************************
+ * Encoding                                   *
+ **********************************************/
+
+static void encode(const struct instr *in)
+{
+    int a = in->ops[0];
+    int b = in->ops[1];
+    int c = in->ops[2];
+
+    if (in->fixup)
+        back_end_fixup(in->label);
+
+    switch (in->op) {
+    case SCHED_ADD:      back_end_native_add(a, b, c); break;
+    case SCHED_ADDI:     back_end_native_addi(a, b, c); break;
+    case SCHED_ADDIW:    back_end_native_addiw(a, b, c); break;
+    case SCHED_SUB:      back_end_native_sub(a, b, c); break;
+    case SCHED_DIV:      back_end_native_div(a, b, c); break;
+    case SCHED_REM:      back_end_native_rem(a, b, c); break;
+    case SCHED_MUL:      back_end_native_mul(a, b, c); break;
+    case SCHED_XOR:      back_end_native_xor(a, b, c); break;
+    case SCHED_XORI:     back_end_native_xori(a, b, c); break;
+    case SCHED_AND:      back_end_native_and(a, b, c); break;
+    case SCHED_ANDI:     back_end_native_andi(a, b, c); break;
+    case SCHED_OR:       back_end_native_or(a, b, c); break;
+    case SCHED_ORI:      back_end_native_ori(a, b, c); break;
+    case SCHED_SRA:      back_end_native_sra(a, b, c); break;
+    case SCHED_SRL:      back_end_native_srl(a, b, c); break;
+    case SCHED_SRAI:     back_end_native_srai(a, b, c); break;
+    case SCHED_SLL:      back_end_native_sll(a, b, c); break;
+    case SCHED_SLLI:     back_end_native_slli(a, b, c); break;
+    case SCHED_SLT:      back_end_native_slt(a, b, c); break;
+    case SCHED_SLTI:     back_end_native_slti(a, b, c); break;
+    case SCHED_SEQZ:     back_end_native_seqz(a, b); break;
+    case SCHED_SNEZ:     back_end_native_snez(a, b); break;
+    case SCHED_LI:       back_end_native_li(a, b); break;
+    case SCHED_LB:       back_end_native_lb(a, b, c); break;
+    case SCHED_LBU:      back_end_native_lbu(a, b, c); break;
+    case SCHED_LH:       back_end_native_lh(a, b, c); break;
+    case SCHED_LHU:      back_end_native_lhu(a, b, c); break;
+    case SCHED_LW:       back_end_native_lw(a, b, c); break;
+    case SCHED_LWU:      back_end_native_lwu(a, b, c); break;
+    case SCHED_LD:       back_end_native_ld(a, b, c); break;
+    case SCHED_SB:       back_end_native_sb(a, b, c); break;
+    case SCHED_SH:       back_end_native_sh(a, b, c); break;
+    case SCHED_SW:       back_end_native_sw(a, b, c); break;
+    case SCHED_SD:       back_end_native_sd(a, b, c); break;
+    case SCHED_RET:      back_end_native_ret(); break;
+    case SCHED_CALL:     back_end_native_call(a); break;
+    case SCHED_JMP:      back_end_native_jmp(a); break;
+    case SCHED_JMP_REG:  back_end_native_jmp_reg(a); break;
+    case SCHED_BEQ:      back_end_native_beq(a, b, c); break;
+    case SCHED_BNE:      back_end_native_bne(a, b, c); break;
+    case SCHED_BLT:      back_end_native_blt(a, b, c); break;
+    case SCHED_BGE:      back_end_native_bge(a, b, c); break;
+    case SCHED_SYSCALL:  back_end_native_syscall_0(a); break;
+    case SCHED_PROLOGUE: back_end_native_prologue(a); break;
+    case SCHED_EPILOGUE: back_end_native_epilogue(a); break;
+    default:
+        weak_unreachable("Unknown operation (numeric: %d).", in->op);
+    }
+}
+
+/**********************************************
+ * Interface                                  *
+ **********************************************/
+
+const struct sched_model *sched_model_find(const char *name)
+{
+    for (uint64_t i = 0; i < __weak_array_size(models); ++i)
+        if (!strcmp(models[i].name, name))
+            return &models[i];
+
+    return NULL;
+}
+
+void sched_model_set(const struct sched_model *m)
+{
+    model = m;
+}
+
+void sched_reset()
+{
+    vector_clear(block);
+    memset(&stats, 0, sizeof (stats));
+    fixup_pending = 0;
+}
+
+void sched_fixup(uint64_t label)
+{
+    fixup_pending = 1;
+    fixup_label   = label;
+}
+
+void sched_label_bind(uint64_t label)
+{
+    sched_flush();
+    back_end_label_bind(label);
+}
+
+void sched_put(enum sched_op op, int a, int b, int c)
+{
+    struct instr in = {
+        .op    = op,
+        .ops   = {a, b, c},
+        .fixup = fixup_pending,
+        .label = fixup_label
+    };
+
+    fixup_pending = 0;
+
+    if (block.count >= BLOCK_LIMIT)
+        sched_flush();
+
+    vector_push_back(block, in);
+
+    if (infos[op].barrier)
+        sched_flush();
+}
+
+void sched_flush()
+{
+    uint64_t n = block.count;
+    uint64_t orig [BLOCK_LIMIT];
+    uint64_t order[BLOCK_LIMIT];
+
+    if (n == 0)
+        return;
+
+    for (uint64_t i = 0; i < n; ++i)
+        orig[i] = i;
+
+    edges_build(block.data, n);
+    schedule(block.data, order, n);
+
+    uint64_t before = estimate(block.data, orig, n);
+    uint64_t after  = estimate(block.data, order, n);
+
+    if (after >= before) {
+        memcpy(order, orig, sizeof (*order) * n);
+        after = before;
+    }
+
+    stats.instrs        += n;
+    stats.cycles_before += before;
+    stats.cycles_after  += after;
+
+    for (uint64_t i = 0; i < n; ++i)
+        encode(&block.data[order[i]]);
+
+    vector_clear(block);
+}
+
+void sched_stats_get(struct sched_stats *out)
+{
+    *out = stats;
+}
@@ -0,0 +1,120 @@
+/* sched.h - Basic block list scheduler.
+ * Copyright (C) 2024 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#ifndef WEAK_COMPILER_BACKEND_SCHED_H
+#define WEAK_COMPILER_BACKEND_SCHED_H
+
+#include <stdint.h>
+
+/** Machine operation. Operands have meaning of arguments
+    of back_end_native_* function with the same name. */
+enum sched_op {
+    SCHED_ADD,
+    SCHED_ADDI,
+    SCHED_ADDIW,
+    SCHED_SUB,
+    SCHED_DIV,
+    SCHED_REM,
+    SCHED_MUL,
+    SCHED_XOR,
+    SCHED_XORI,
+    SCHED_AND,
+    SCHED_ANDI,
+    SCHED_OR,
+    SCHED_ORI,
+    SCHED_SRA,
+    SCHED_SRL,
+    SCHED_SRAI,
+    SCHED_SLL,
+    SCHED_SLLI,
+    SCHED_SLT,
+    SCHED_SLTI,
+    SCHED_SEQZ,
+    SCHED_SNEZ,
+    SCHED_LI,
+    SCHED_LB,
+    SCHED_LBU,
+    SCHED_LH,
+    SCHED_LHU,
+    SCHED_LW,
+    SCHED_LWU,
+    SCHED_LD,
+    SCHED_SB,
+    SCHED_SH,
+    SCHED_SW,
+    SCHED_SD,
+    SCHED_RET,
+    SCHED_CALL,
+    SCHED_JMP,
+    SCHED_JMP_REG,
+    SCHED_BEQ,
+    SCHED_BNE,
+    SCHED_BLT,
+    SCHED_BGE,
+    /* back_end_native_syscall_0(). */
+    SCHED_SYSCALL,
+    SCHED_PROLOGUE,
+    SCHED_EPILOGUE,
+    SCHED_OP_COUNT
+};
+
+/** Class of operation in latency model. */
+enum sched_class {
+    SCHED_CLASS_ALU,
+    SCHED_CLASS_LOAD,
+    SCHED_CLASS_STORE,
+    SCHED_CLASS_MUL,
+    SCHED_CLASS_DIV,
+    SCHED_CLASS_BRANCH,
+    SCHED_CLASS_COUNT
+};
+
+/** In-order pipeline. */
+struct sched_model {
+    const char *name;
+    /** Operations issued per cycle. */
+    uint64_t    issue_width;
+    /** Cycles after issue, when result can be used. */
+    uint64_t    latency[SCHED_CLASS_COUNT];
+    /** Operations of class issued per cycle. Loads and
+        stores share units of SCHED_CLASS_LOAD. */
+    uint64_t    units[SCHED_CLASS_COUNT];
+};
+
+/** Estimated cycles of straight-line code, summed
+    over basic blocks. */
+struct sched_stats {
+    uint64_t instrs;
+    uint64_t cycles_before;
+    uint64_t cycles_after;
+};
+
+/** Find model by name. Known ones are
+    - "u74"    (SiFive U74, dual-issue, default),
+    - "single" (single-issue in-order core).
+
+    \return Model or NULL. */
+const struct sched_model *sched_model_find(const char *name);
+void sched_model_set(const struct sched_model *model);
+
+/** Drop pending operations and statistics. */
+void sched_reset();
+/** Remember, that next operation (call, jump or branch)
+    refers to label. See back_end_fixup(). */
+void sched_fixup(uint64_t label);
+/** Bind label to current position. Pending operations
+    are scheduled and encoded first. */
+void sched_label_bind(uint64_t label);
+/** Add operation to current basic block. Block ends with
+    call, jump, branch, return, system call, prologue
+    and epilogue, then it is scheduled and encoded. */
+void sched_put(enum sched_op op, int a, int b, int c);
+/** Schedule and encode pending operations. */
+void sched_flush();
+
+void sched_stats_get(struct sched_stats *stats);
+
+#endif // WEAK_COMPILER_BACKEND_SCHED_H
@@ -0,0 +1,668 @@
+/* stencil.c - Copy-and-patch baseline compiler for IR interpreter.
+ * Copyright (C) 2024 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#include "back_end/stencil.h"
+#include "util/compiler.h"
+
+#if defined __x86_64__
+
+#include "middle_end/ir/ir.h"
+#include "util/alloc.h"
+#include "util/hashmap.h"
+#include "util/vector.h"
+#include <stdio.h>
+#include <string.h>
+
+/* Stencils work over the same frame layout as jit.c: variable
+   with index N lives at [rbp - 8 * (N + 1)]. Value of each
+   expression stencil is left in eax, right operand of binary
+   operation stencil is taken from ecx. Thus stencils can be
+   concatenated in any order, as the interpreter evaluates
+   IR, without register allocation. */
+
+enum stencil_hole {
+    HOLE_NONE,
+    /** Immediate value. */
+    HOLE_IMM32,
+    /** Displacement of variable slot from rbp. */
+    HOLE_SLOT,
+    /** Branch or call target, relative to end of stencil. */
+    HOLE_REL32,
+    /** Absolute address of callee. */
+    HOLE_ABS64
+};
+
+enum stencil_kind {
+    S_PROLOGUE,
+    S_EPILOGUE,
+    S_IMM,
+    S_SYM,
+    S_TMP_IMM,
+    S_TMP_SYM,
+    S_PUSH,
+    S_POP_TMP,
+    S_STORE,
+    S_ADD,
+    S_SUB,
+    S_MUL,
+    S_DIV,
+    S_MOD,
+    S_MULHI,
+    S_BIT_AND,
+    S_BIT_OR,
+    S_XOR,
+    S_SHL,
+    S_SHR,
+    S_AND,
+    S_OR,
+    S_EQ,
+    S_NEQ,
+    S_LT,
+    S_LE,
+    S_GT,
+    S_GE,
+    S_COND,
+    S_JUMP,
+    S_CALL,
+    S_CALL_SELF,
+    S_ARG_0,
+    S_ARG_1,
+    S_ARG_2,
+    S_ARG_3,
+    S_ARG_4,
+    S_ARG_5,
+    S_PARAM_0,
+    S_PARAM_1,
+    S_PARAM_2,
+    S_PARAM_3,
+    S_PARAM_4,
+    S_PARAM_5,
+    S_OSR_LOAD,
+    S_COUNT
+};
+
+struct stencil {
+    const char        *code;
+    uint8_t            size;
+    /** Offset of hole, if kind is not HOLE_NONE. */
+    uint8_t            hole;
+    enum stencil_hole  kind;
+};
+
+/* Key:   Stencil kind
+   Value: Machine code with at most one hole */
+static const struct stencil stencils[S_COUNT] = {
+    /* push rbp; mov rbp, rsp; sub rsp, imm32 */
+    [S_PROLOGUE]  = { "\x55\x48\x89\xe5\x48\x81\xec\0\0\0\0", 11, 7, HOLE_IMM32 },
+    /* leave; ret */
+    [S_EPILOGUE]  = { "\xc9\xc3",                            2, 0, HOLE_NONE  },
+    /* mov eax, imm32 */
+    [S_IMM]       = { "\xb8\0\0\0\0",                        5, 1, HOLE_IMM32 },
+    /* mov eax, [rbp + slot] */
+    [S_SYM]       = { "\x8b\x85\0\0\0\0",                    6, 2, HOLE_SLOT  },
+    /* mov ecx, imm32 */
+    [S_TMP_IMM]   = { "\xb9\0\0\0\0",                        5, 1, HOLE_IMM32 },
+    /* mov ecx, [rbp + slot] */
+    [S_TMP_SYM]   = { "\x8b\x8d\0\0\0\0",                    6, 2, HOLE_SLOT  },
+    /* push rax */
+    [S_PUSH]      = { "\x50",                                1, 0, HOLE_NONE  },
+    /* pop rcx */
+    [S_POP_TMP]   = { "\x59",                                1, 0, HOLE_NONE  },
+    /* mov [rbp + slot], eax */
+    [S_STORE]     = { "\x89\x85\0\0\0\0",                    6, 2, HOLE_SLOT  },
+    /* add eax, ecx */
+    [S_ADD]       = { "\x01\xc8",                            2, 0, HOLE_NONE  },
+    /* sub eax, ecx */
+    [S_SUB]       = { "\x29\xc8",                            2, 0, HOLE_NONE  },
+    /* imul eax, ecx */
+    [S_MUL]       = { "\x0f\xaf\xc1",                        3, 0, HOLE_NONE  },
+    /* cdq; idiv ecx */
+    [S_DIV]       = { "\x99\xf7\xf9",                        3, 0, HOLE_NONE  },
+    /* cdq; idiv ecx; mov eax, edx */
+    [S_MOD]       = { "\x99\xf7\xf9\x89\xd0",                5, 0, HOLE_NONE  },
+    /* movsxd rax, eax; movsxd rcx, ecx; imul rax, rcx; sar rax, 32 */
+    [S_MULHI]     = { "\x48\x63\xc0\x48\x63\xc9\x48\x0f\xaf\xc1\x48\xc1\xf8\x20", 14, 0, HOLE_NONE },
+    /* and eax, ecx */
+    [S_BIT_AND]   = { "\x21\xc8",                            2, 0, HOLE_NONE  },
+    /* or eax, ecx */
+    [S_BIT_OR]    = { "\x09\xc8",                            2, 0, HOLE_NONE  },
+    /* xor eax, ecx */
+    [S_XOR]       = { "\x31\xc8",                            2, 0, HOLE_NONE  },
+    /* shl eax, cl */
+    [S_SHL]       = { "\xd3\xe0",                            2, 0, HOLE_NONE  },
+    /* sar eax, cl */
+    [S_SHR]       = { "\xd3\xf8",                            2, 0, HOLE_NONE  },
+    /* test eax, eax; setne al; test ecx, ecx; setne cl; and al, cl; movzx eax, al */
+    [S_AND]       = { "\x85\xc0\x0f\x95\xc0\x85\xc9\x0f\x95\xc1\x20\xc8\x0f\xb6\xc0", 15, 0, HOLE_NONE },
+    /* or eax, ecx; setne al; movzx eax, al */
+    [S_OR]        = { "\x09\xc8\x0f\x95\xc0\x0f\xb6\xc0",    8, 0, HOLE_NONE  },
+    /* cmp eax, ecx; setcc al; movzx eax, al */
+    [S_EQ]        = { "\x39\xc8\x0f\x94\xc0\x0f\xb6\xc0",    8, 0, HOLE_NONE  },
+    [S_NEQ]       = { "\x39\xc8\x0f\x95\xc0\x0f\xb6\xc0",    8, 0, HOLE_NONE  },
+    [S_LT]        = { "\x39\xc8\x0f\x9c\xc0\x0f\xb6\xc0",    8, 0, HOLE_NONE  },
+    [S_LE]        = { "\x39\xc8\x0f\x9e\xc0\x0f\xb6\xc0",    8, 0, HOLE_NONE  },
+    [S_GT]        = { "\x39\xc8\x0f\x9f\xc0\x0f\xb6\xc0",    8, 0, HOLE_NONE  },
+    [S_GE]        = { "\x39\xc8\x0f\x9d\xc0\x0f\xb6\xc0",    8, 0, HOLE_NONE  },
+    /* test eax, eax; jne rel32 */
+    [S_COND]      = { "\x85\xc0\x0f\x85\0\0\0\0",            8, 4, HOLE_REL32 },
+    /* jmp rel32 */
+    [S_JUMP]      = { "\xe9\0\0\0\0",                        5, 1, HOLE_REL32 },
+    /* movabs r11, imm64; call r11 */
+    [S_CALL]      = { "\x49\xbb\0\0\0\0\0\0\0\0\x41\xff\xd3", 13, 2, HOLE_ABS64 },
+    /* call rel32 */
+    [S_CALL_SELF] = { "\xe8\0\0\0\0",                        5, 1, HOLE_REL32 },
+    /* mov <argument register>, eax */
+    [S_ARG_0]     = { "\x89\xc7",                            2, 0, HOLE_NONE  },
+    [S_ARG_1]     = { "\x89\xc6",                            2, 0, HOLE_NONE  },
+    [S_ARG_2]     = { "\x89\xc2",                            2, 0, HOLE_NONE  },
+    [S_ARG_3]     = { "\x89\xc1",                            2, 0, HOLE_NONE  },
+    [S_ARG_4]     = { "\x41\x89\xc0",                        3, 0, HOLE_NONE  },
+    [S_ARG_5]     = { "\x41\x89\xc1",                        3, 0, HOLE_NONE  },
+    /* mov [rbp + slot], <argument register> */
+    [S_PARAM_0]   = { "\x89\xbd\0\0\0\0",                    6, 2, HOLE_SLOT  },
+    [S_PARAM_1]   = { "\x89\xb5\0\0\0\0",                    6, 2, HOLE_SLOT  },
+    [S_PARAM_2]   = { "\x89\x95\0\0\0\0",                    6, 2, HOLE_SLOT  },
+    [S_PARAM_3]   = { "\x89\x8d\0\0\0\0",                    6, 2, HOLE_SLOT  },
+    [S_PARAM_4]   = { "\x44\x89\x85\0\0\0\0",                7, 3, HOLE_SLOT  },
+    [S_PARAM_5]   = { "\x44\x89\x8d\0\0\0\0",                7, 3, HOLE_SLOT  },
+    /* mov eax, [rdi + imm32] */
+    [S_OSR_LOAD]  = { "\x8b\x87\0\0\0\0",                    6, 2, HOLE_IMM32 },
+};
+
+struct stencil_fn {
+    struct ir_fn_decl *decl;
+    void              *code;
+    bool               failed;
+    bool               in_progress;
+};
+
+struct stencil_fixup {
+    /** Offset of HOLE_REL32. */
+    uint64_t        off;
+    struct ir_node *target;
+};
+
+typedef vector_t(uint8_t) stencil_code_t;
+typedef vector_t(struct stencil_fixup) stencil_fixup_vector_t;
+
+/* Key:   ir_fn_decl address
+   Value: struct stencil_fn * */
+static hashmap_t              fns;
+static jit_lookup_t           fn_lookup;
+
+/* State of currently compiled function. */
+static struct stencil_fn     *fn_current;
+static stencil_code_t         code;
+/* Key:   ir_node address
+   Value: code offset */
+static hashmap_t              labels;
+static stencil_fixup_vector_t fixups;
+static uint64_t               slots;
+/* Code for on-stack replacement is compiled. */
+static bool                   osr;
+
+static wur void *fn_compile(struct ir_fn_decl *decl);
+
+/**********************************************
+ **             Copy and patch               **
+ **********************************************/
+
+/* Copy stencil to the end of code and patch its hole.
+   \return Offset of hole. */
+static uint64_t copy(enum stencil_kind kind, int64_t value)
+{
+    const struct stencil *s   = &stencils[kind];
+    uint64_t              off = code.count + s->hole;
+
+    for (uint8_t i = 0; i < s->size; ++i)
+        vector_push_back(code, (uint8_t) s->code[i]);
+
+    int32_t imm32 = (int32_t) value;
+
+    switch (s->kind) {
+    case HOLE_NONE:
+        break;
+    case HOLE_SLOT:
+        imm32 = -8 * (int32_t) (value + 1);
+        /* Fallthrough. */
+    case HOLE_IMM32:
+    case HOLE_REL32:
+        memcpy(&code.data[off], &imm32, sizeof (imm32));
+        break;
+    case HOLE_ABS64:
+        memcpy(&code.data[off], &value, sizeof (value));
+        break;
+    }
+
+    return off;
+}
+
+static void copy_branch(enum stencil_kind kind, struct ir_node *target)
+{
+    struct stencil_fixup fixup = {
+        .off    = copy(kind, 0),
+        .target = target
+    };
+    vector_push_back(fixups, fixup);
+}
+
+/**********************************************
+ **                Operands                  **
+ **********************************************/
+static wur bool is_int(enum data_type dt, uint64_t ptr_depth)
+{
+    return dt == D_T_INT && ptr_depth == 0;
+}
+
+static wur bool sym_ok(struct ir_node *ir)
+{
+    struct ir_sym *sym = ir->ir;
+
+    return !sym->deref && !sym->addr_of && sym->idx < slots &&
+            is_int(sym->type_info.dt, sym->type_info.ptr_depth);
+}
+
+/* Copy stencil of immediate or variable load to eax
+   or, if `tmp` is set, to ecx. */
+static wur bool operand(bool tmp, struct ir_node *ir)
+{
+    switch (ir->type) {
+    case IR_IMM: {
+        struct ir_imm *imm = ir->ir;
+        if (imm->type != IMM_INT)
+            return 0;
+        copy(tmp ? S_TMP_IMM : S_IMM, imm->imm.__int);
+        return 1;
+    }
+    case IR_SYM:
+        if (!sym_ok(ir))
+            return 0;
+        copy(tmp ? S_TMP_SYM : S_SYM, ((struct ir_sym *) ir->ir)->idx);
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+/**********************************************
+ **               Expressions                **
+ **********************************************/
+static wur bool value(struct ir_node *ir);
+
+static wur bool bin_stencil(enum token_type op, enum stencil_kind *kind)
+{
+    switch (op) {
+    case TOK_PLUS:    *kind = S_ADD;     return 1;
+    case TOK_MINUS:   *kind = S_SUB;     return 1;
+    case TOK_STAR:    *kind = S_MUL;     return 1;
+    case TOK_SLASH:   *kind = S_DIV;     return 1;
+    case TOK_MOD:     *kind = S_MOD;     return 1;
+    case TOK_MULHI:   *kind = S_MULHI;   return 1;
+    case TOK_BIT_AND: *kind = S_BIT_AND; return 1;
+    case TOK_BIT_OR:  *kind = S_BIT_OR;  return 1;
+    case TOK_XOR:     *kind = S_XOR;     return 1;
+    case TOK_SHL:     *kind = S_SHL;     return 1;
+    case TOK_SHR:     *kind = S_SHR;     return 1;
+    case TOK_AND:     *kind = S_AND;     return 1;
+    case TOK_OR:      *kind = S_OR;      return 1;
+    case TOK_EQ:      *kind = S_EQ;      return 1;
+    case TOK_NEQ:     *kind = S_NEQ;     return 1;
+    case TOK_LT:      *kind = S_LT;      return 1;
+    case TOK_LE:      *kind = S_LE;      return 1;
+    case TOK_GT:      *kind = S_GT;      return 1;
+    case TOK_GE:      *kind = S_GE;      return 1;
+    default:
+        return 0;
+    }
+}
+
+static wur bool bin(struct ir_bin *bin)
+{
+    enum stencil_kind kind = S_COUNT;
+
+    if (!bin_stencil(bin->op, &kind))
+        return 0;
+
+    switch (bin->rhs->type) {
+    case IR_IMM:
+    case IR_SYM:
+        if (!value(bin->lhs) || !operand(/*tmp=*/1, bin->rhs))
+            return 0;
+        break;
+    default:
+        if (!value(bin->rhs))
+            return 0;
+        copy(S_PUSH, 0);
+        if (!value(bin->lhs))
+            return 0;
+        copy(S_POP_TMP, 0);
+        break;
+    }
+
+    copy(kind, 0);
+    return 1;
+}
+
+static wur bool value(struct ir_node *ir)
+{
+    switch (ir->type) {
+    case IR_IMM:
+    case IR_SYM:
+        return operand(/*tmp=*/0, ir);
+    case IR_BIN:
+        return bin(ir->ir);
+    default:
+        return 0;
+    }
+}
+
+static wur bool call(struct ir_fn_call *fcall)
+{
+    struct ir_fn_decl *decl   = fn_lookup(fcall->name);
+    struct ir_node    *arg    = fcall->args;
+    uint64_t           i      = 0;
+    void              *callee = NULL;
+
+    /* Code for on-stack replacement does not start at
+       function entry, so self call is not relative. */
+    if (decl != fn_current->decl || osr) {
+        callee = fn_compile(decl);
+        if (!callee)
+            return 0;
+    }
+
+    /* Argument is computed to eax, then moved to its register.
+       Only eax is clobbered by operand stencils. */
+    while (arg) {
+        if (i >= JIT_ARGS_LIMIT || !operand(/*tmp=*/0, arg))
+            return 0;
+        copy(S_ARG_0 + i++, 0);
+        arg = arg->next;
+    }
+
+    if (callee)
+        copy(S_CALL, (int64_t) callee);
+    else
+        copy(S_CALL_SELF, -(int64_t) (code.count + stencils[S_CALL_SELF].size));
+
+    return 1;
+}
+
+/**********************************************
+ **               Statements                 **
+ **********************************************/
+static wur bool store(struct ir_store *store)
+{
+    if (store->idx->type != IR_SYM || !sym_ok(store->idx))
+        return 0;
+
+    bool ok = store->body->type == IR_FN_CALL
+        ? call(store->body->ir)
+        : value(store->body);
+
+    if (ok)
+        copy(S_STORE, ((struct ir_sym *) store->idx->ir)->idx);
+
+    return ok;
+}
+
+static wur bool stmt(struct ir_node *ir)
+{
+    switch (ir->type) {
+    case IR_ALLOCA: {
+        struct ir_alloca *alloca = ir->ir;
+        return is_int(alloca->dt, alloca->ptr_depth);
+    }
+    case IR_STORE:
+        return store(ir->ir);
+    case IR_FN_CALL:
+        return call(ir->ir);
+    case IR_COND: {
+        struct ir_cond *cond = ir->ir;
+        if (!value(cond->cond))
+            return 0;
+        copy_branch(S_COND, cond->target);
+        return 1;
+    }
+    case IR_JUMP:
+        copy_branch(S_JUMP, ((struct ir_jump *) ir->ir)->target);
+        return 1;
+    case IR_RET: {
+        struct ir_ret *ret = ir->ir;
+        if (ret->body && !value(ret->body))
+            return 0;
+        copy(S_EPILOGUE, 0);
+        return 1;
+    }
+    default:
+        return 0;
+    }
+}
+
+/**********************************************
+ **               Functions                  **
+ **********************************************/
+static wur bool frame_build(struct ir_fn_decl *decl)
+{
+    struct ir_node *it = decl->args;
+    uint64_t        n  = 0;
+
+    slots = 0;
+
+    for (it = decl->args; it; it = it->next, ++n) {
+        if (it->type != IR_ALLOCA || n >= JIT_ARGS_LIMIT)
+            return 0;
+        struct ir_alloca *alloca = it->ir;
+        if (!is_int(alloca->dt, alloca->ptr_depth))
+            return 0;
+        if (slots < alloca->idx + 1)
+            slots = alloca->idx + 1;
+    }
+
+    for (it = decl->body; it; it = it->next) {
+        if (it->type != IR_ALLOCA)
+            continue;
+        struct ir_alloca *alloca = it->ir;
+        if (slots < alloca->idx + 1)
+            slots = alloca->idx + 1;
+    }
+
+    return decl->ret_type == D_T_VOID ||
+           is_int(decl->ret_type, decl->ptr_depth);
+}
+
+/* If `entry` is given, variables are copied from array
+   in rdi and execution continues from `entry`. */
+static wur bool body_gen(struct ir_fn_decl *decl, struct ir_node *entry)
+{
+    struct ir_node *it = decl->args;
+    uint64_t        i  = 0;
+
+    copy(S_PROLOGUE, (slots * 8 + 15) & ~15ULL);
+
+    if (entry) {
+        for (uint64_t idx = 0; idx < slots; ++idx) {
+            copy(S_OSR_LOAD, 4 * idx);
+            copy(S_STORE, idx);
+        }
+        copy_branch(S_JUMP, entry);
+    } else {
+        for (; it; it = it->next)
+            copy(S_PARAM_0 + i++, ((struct ir_alloca *) it->ir)->idx);
+    }
+
+    for (it = decl->body; it; it = it->next) {
+        hashmap_put(&labels, (uint64_t) it, code.count);
+
+        if (!stmt(it))
+            return 0;
+
+        /* Interpreter follows CFG, not the statement list. */
+        if (it->type != IR_COND && it->type != IR_JUMP &&
+            it->type != IR_RET && it->cfg.succs.count > 0) {
+            struct ir_node *succ = vector_at(it->cfg.succs, 0);
+            if (succ != it->next)
+                copy_branch(S_JUMP, succ);
+        }
+    }
+
+    copy(S_EPILOGUE, 0);
+
+    vector_foreach(fixups, i) {
+        struct stencil_fixup *fixup = &vector_at(fixups, i);
+
+        bool     ok = 0;
+        uint64_t to = hashmap_get(&labels, (uint64_t) fixup->target, &ok);
+        if (!ok)
+            return 0;
+
+        int32_t rel = (int32_t) (to - (fixup->off + 4));
+        memcpy(&code.data[fixup->off], &rel, sizeof (rel));
+    }
+
+    return 1;
+}
+
+static bool callees_compile(struct ir_fn_decl *decl)
+{
+    struct ir_node *it = decl->body;
+
+    for (; it; it = it->next) {
+        struct ir_fn_call *fcall = NULL;
+
+        if (it->type == IR_FN_CALL)
+            fcall = it->ir;
+        if (it->type == IR_STORE &&
+            ((struct ir_store *) it->ir)->body->type == IR_FN_CALL)
+            fcall = ((struct ir_store *) it->ir)->body->ir;
+
+        if (!fcall)
+            continue;
+
+        struct ir_fn_decl *callee = fn_lookup(fcall->name);
+        if (callee != decl && !fn_compile(callee))
+            return 0;
+    }
+
+    return 1;
+}
+
+static struct stencil_fn *fn_get(struct ir_fn_decl *decl)
+{
+    bool     ok  = 0;
+    uint64_t got = hashmap_get(&fns, (uint64_t) decl, &ok);
+
+    if (ok)
+        return (struct stencil_fn *) got;
+
+    struct stencil_fn *fn = weak_new(struct stencil_fn);
+    fn->decl = decl;
+    hashmap_put(&fns, (uint64_t) decl, (uint64_t) fn);
+    return fn;
+}
+
+static void *fn_compile(struct ir_fn_decl *decl)
+{
+    struct stencil_fn *fn = fn_get(decl);
+
+    if (fn->code || fn->failed)
+        return fn->code;
+
+    /* Mutual recursion. */
+    if (fn->in_progress)
+        return NULL;
+
+    fn->in_progress = 1;
+    /* Code buffer is shared, so all callees are
+       compiled before this function. */
+    fn->failed = !callees_compile(decl);
+    fn->in_progress = 0;
+
+    if (fn->failed)
+        return NULL;
+
+    fn_current = fn;
+    vector_clear(code);
+    vector_clear(fixups);
+    hashmap_reset(&labels, 256);
+
+    if (frame_build(decl) && body_gen(decl, /*entry=*/NULL))
+        fn->code = jit_install(decl->name, code.data, code.count);
+
+    fn->failed = !fn->code;
+
+    return fn->code;
+}
+
+void *stencil_compile(struct ir_fn_decl *decl, jit_lookup_t lookup)
+{
+    if (!fns.buckets)
+        hashmap_init(&fns, 64);
+
+    fn_lookup = lookup;
+    return fn_compile(decl);
+}
+
+void *stencil_compile_osr(struct ir_fn_decl *decl, jit_lookup_t lookup, struct ir_node *entry)
+{
+    char name[256] = {0};
+
+    /* Checks, that all IR is supported, and compiles
+       callees. */
+    if (!stencil_compile(decl, lookup))
+        return NULL;
+
+    fn_current = fn_get(decl);
+    vector_clear(code);
+    vector_clear(fixups);
+    hashmap_reset(&labels, 256);
+
+    osr = 1;
+    bool ok = frame_build(decl) && body_gen(decl, entry);
+    osr = 0;
+
+    if (!ok)
+        return NULL;
+
+    snprintf(name, sizeof (name) - 1, "%s.osr", decl->name);
+    return jit_install(name, code.data, code.count);
+}
+
+void stencil_reset()
+{
+    /* hashmap_foreach() does not expect empty map. */
+    if (fns.buckets) {
+        hashmap_foreach(&fns, k, v) {
+            (void) k;
+            weak_free((struct stencil_fn *) v);
+        }
+        hashmap_destroy(&fns);
+    }
+
+    if (labels.buckets)
+        hashmap_destroy(&labels);
+    vector_free(code);
+    vector_free(fixups);
+}
+
+#else  /* !__x86_64__ */
+
+void *stencil_compile(unused struct ir_fn_decl *decl, unused jit_lookup_t lookup)
+{
+    return NULL;
+}
+
+void *stencil_compile_osr(
+    unused struct ir_fn_decl *decl,
+    unused jit_lookup_t       lookup,
+    unused struct ir_node    *entry
+) {
+    return NULL;
+}
+
+void stencil_reset() {}
+
+#endif /* __x86_64__ */
@@ -0,0 +1,32 @@
+/* stencil.h - Copy-and-patch baseline compiler for IR interpreter.
+ * Copyright (C) 2024 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#ifndef WEAK_COMPILER_BACKEND_STENCIL_H
+#define WEAK_COMPILER_BACKEND_STENCIL_H
+
+#include "back_end/jit.h"
+
+/** Compile function by copying prebuilt machine code stencil
+    of each IR operation and patching its hole with stack
+    offset, immediate value, branch or call target.
+
+    No instruction selection and register allocation is done,
+    so compilation is linear in IR size. Supported IR is the same
+    as for jit_compile().
+
+    \return Native code, callable with jit_call(), or NULL. */
+void *stencil_compile(struct ir_fn_decl *decl, jit_lookup_t lookup);
+
+/** Compile function for on-stack replacement, as
+    jit_compile_osr() does.
+
+    \return Native code, callable with jit_call_osr(), or NULL. */
+void *stencil_compile_osr(struct ir_fn_decl *decl, jit_lookup_t lookup, struct ir_node *entry);
+
+/** Forget compiled functions. Memory is released by jit_reset(). */
+void stencil_reset();
+
+#endif // WEAK_COMPILER_BACKEND_STENCIL_H
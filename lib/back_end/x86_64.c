@@ -0,0 +1,603 @@
+/* x86_64.c - x86-64 encoding.
+ * Copyright (C) 2024 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#include "back_end/back_end.h"
+#include "back_end/x86_64.h"
+#include "util/compiler.h"
+#include "util/unreachable.h"
+#include <string.h>
+
+/* Generic interface is RISC-V like: three-operand
+   instructions and loads/stores with register and
+   offset. Two-operand x86-64 instructions are combined
+   with moves, using `x86_64_reg_scratch` if destination
+   is also an operand. Memory is always addressed as
+   [base + disp32]. */
+
+/**********************************************
+ **            x86-64 encoding               **
+ **********************************************/
+
+static void put_8(uint8_t v)
+{
+    put(&v, 1);
+}
+
+static void put_32(uint32_t v)
+{
+    uint8_t code[4] = {
+        (v      ) & 0xFF,
+        (v >>  8) & 0xFF,
+        (v >> 16) & 0xFF,
+        (v >> 24) & 0xFF
+    };
+    put(code, 4);
+}
+
+/* REX prefix is emitted always. Without it, byte
+   registers 4-7 would be ah, ch, dh, bh. */
+static void x86_64_rex(bool w, int reg, int rm)
+{
+    put_8(x86_64_rex_prefix
+        | (w ? x86_64_rex_w : 0)
+        | ((reg >> 3) << 2)
+        | ((rm  >> 3)     ));
+}
+
+static void x86_64_opcode(bool two_byte, uint8_t op)
+{
+    if (two_byte)
+        put_8(x86_64_two_byte);
+    put_8(op);
+}
+
+/* op reg, rm or op rm, reg with both operands in
+   registers. */
+static void x86_64_rr(bool w, bool two_byte, uint8_t op, int reg, int rm)
+{
+    x86_64_rex(w, reg, rm);
+    x86_64_opcode(two_byte, op);
+    put_8(0xC0 | ((reg & 7) << 3) | (rm & 7));
+}
+
+/* op reg, [base + disp32]. rsp and r12 as base
+   require SIB byte. */
+static void x86_64_rm(bool w, bool two_byte, uint8_t op, int reg, int base, int32_t disp)
+{
+    x86_64_rex(w, reg, base);
+    x86_64_opcode(two_byte, op);
+    put_8(0x80 | ((reg & 7) << 3) | (base & 7));
+
+    if ((base & 7) == x86_64_reg_rsp)
+        put_8(0x24);
+
+    put_32(disp);
+}
+
+static void x86_64_mov(int dst, int src)
+{
+    if (dst != src)
+        x86_64_rr(/*w=*/1, /*two_byte=*/0, x86_64_mov_store, src, dst);
+}
+
+static void x86_64_push(int reg)
+{
+    if (reg >= 8)
+        put_8(x86_64_rex_prefix | x86_64_rex_b);
+    put_8(x86_64_push_r + (reg & 7));
+}
+
+static void x86_64_pop(int reg)
+{
+    if (reg >= 8)
+        put_8(x86_64_rex_prefix | x86_64_rex_b);
+    put_8(x86_64_pop_r + (reg & 7));
+}
+
+/* op r/m64, imm32 */
+static void x86_64_imm_op(uint8_t op, int digit, int rm, int32_t imm)
+{
+    x86_64_rex(/*w=*/1, 0, rm);
+    put_8(op);
+    put_8(0xC0 | (digit << 3) | (rm & 7));
+    put_32(imm);
+}
+
+/* dst = reg1 op reg2, where op is `op r/m64, r64`. */
+static void x86_64_bin(uint8_t op, bool commutative, int dst, int reg1, int reg2)
+{
+    if (dst != reg2) {
+        x86_64_mov(dst, reg1);
+        x86_64_rr(/*w=*/1, /*two_byte=*/0, op, reg2, dst);
+    } else if (commutative) {
+        x86_64_rr(/*w=*/1, /*two_byte=*/0, op, reg1, dst);
+    } else {
+        x86_64_mov(x86_64_reg_scratch, reg1);
+        x86_64_rr(/*w=*/1, /*two_byte=*/0, op, reg2, x86_64_reg_scratch);
+        x86_64_mov(dst, x86_64_reg_scratch);
+    }
+}
+
+/* Shift count must be in cl, so rcx is preserved, if
+   it is not a destination. */
+static void x86_64_shift(int digit, int dst, int reg1, int reg2)
+{
+    x86_64_mov(x86_64_reg_scratch, reg1);
+
+    if (dst != x86_64_reg_rcx)
+        x86_64_push(x86_64_reg_rcx);
+
+    x86_64_mov(x86_64_reg_rcx, reg2);
+    x86_64_rex(/*w=*/1, 0, x86_64_reg_scratch);
+    put_8(x86_64_grp2_cl);
+    put_8(0xC0 | (digit << 3) | (x86_64_reg_scratch & 7));
+
+    if (dst != x86_64_reg_rcx)
+        x86_64_pop(x86_64_reg_rcx);
+
+    x86_64_mov(dst, x86_64_reg_scratch);
+}
+
+/* idiv takes dividend in rdx:rax and writes quotient to
+   rax and remainder to rdx. Both are preserved, if they
+   are not a destination. */
+static void x86_64_div(int dst, int reg1, int reg2, bool rem)
+{
+    if (dst != x86_64_reg_rdx) x86_64_push(x86_64_reg_rdx);
+    if (dst != x86_64_reg_rax) x86_64_push(x86_64_reg_rax);
+
+    x86_64_mov(x86_64_reg_scratch, reg2);
+    x86_64_mov(x86_64_reg_rax, reg1);
+    put_8(x86_64_rex_prefix | x86_64_rex_w);
+    put_8(x86_64_cqo);
+    x86_64_rex(/*w=*/1, 0, x86_64_reg_scratch);
+    put_8(x86_64_grp3);
+    put_8(0xC0 | (x86_64_grp3_idiv << 3) | (x86_64_reg_scratch & 7));
+    x86_64_mov(dst, rem ? x86_64_reg_rdx : x86_64_reg_rax);
+
+    if (dst != x86_64_reg_rax) x86_64_pop(x86_64_reg_rax);
+    if (dst != x86_64_reg_rdx) x86_64_pop(x86_64_reg_rdx);
+}
+
+/* setcc dst8; movzx dst, dst8. Flags are set by caller. */
+static void x86_64_setcc(uint8_t cc, int dst)
+{
+    x86_64_rex(/*w=*/0, 0, dst);
+    x86_64_opcode(/*two_byte=*/1, cc);
+    put_8(0xC0 | (dst & 7));
+    x86_64_rr(/*w=*/1, /*two_byte=*/1, x86_64_movzx_8, dst, dst);
+}
+
+static void x86_64_rel32(uint8_t op, int off)
+{
+    put_8(op);
+    /* Offset is counted from the instruction start, as
+       in RISC-V, but x86-64 counts from its end. */
+    put_32(off - 5);
+}
+
+/* cmp + jcc. Offset is counted from cmp. */
+static void x86_64_branch(uint8_t jcc, int reg1, int reg2, int off)
+{
+    x86_64_rr(/*w=*/1, /*two_byte=*/0, x86_64_cmp, reg2, reg1);
+    put_8(x86_64_two_byte);
+    put_8(jcc);
+    put_32(off - 9);
+}
+
+/**********************************************
+ **         Generic instructions             **
+ **********************************************/
+
+int back_end_return_reg()
+{
+    return x86_64_reg_rax;
+}
+
+int back_end_arg_reg(int n)
+{
+    static const int regs[] = {
+        x86_64_reg_rdi,
+        x86_64_reg_rsi,
+        x86_64_reg_rdx,
+        x86_64_reg_rcx,
+        x86_64_reg_r8,
+        x86_64_reg_r9
+    };
+
+    if (n < 0 || n >= (int) __weak_array_size(regs))
+        weak_unreachable("No register for argument %d.", n);
+
+    return regs[n];
+}
+
+/* rax is free between calls, r10 is not used by calls
+   at all. */
+int back_end_tmp_reg(int n)
+{
+    static const int regs[] = {
+        x86_64_reg_r10,
+        x86_64_reg_rax
+    };
+
+    if (n < 0 || n >= (int) __weak_array_size(regs))
+        return -1;
+
+    return regs[n];
+}
+
+int back_end_saved_reg(int n)
+{
+    static const int regs[] = {
+        x86_64_reg_rbx,
+        x86_64_reg_r12,
+        x86_64_reg_r13,
+        x86_64_reg_r14,
+        x86_64_reg_r15
+    };
+
+    if (n < 0 || n >= (int) __weak_array_size(regs))
+        return -1;
+
+    return regs[n];
+}
+
+int back_end_sp_reg()
+{
+    return x86_64_reg_rsp;
+}
+
+int back_end_zero_reg()
+{
+    return -1;
+}
+
+void back_end_native_add(int dst, int reg1, int reg2)
+{
+    x86_64_bin(x86_64_add, /*commutative=*/1, dst, reg1, reg2);
+}
+
+void back_end_native_addi(int dst, int reg1, int imm)
+{
+    if (imm == 0)
+        x86_64_mov(dst, reg1);
+    else
+        x86_64_rm(/*w=*/1, /*two_byte=*/0, x86_64_lea, dst, reg1, imm);
+}
+
+void back_end_native_addiw(int dst, int reg1, int imm)
+{
+    x86_64_rm(/*w=*/0, /*two_byte=*/0, x86_64_lea, dst, reg1, imm);
+    x86_64_rr(/*w=*/1, /*two_byte=*/0, x86_64_movsxd, dst, dst);
+}
+
+void back_end_native_sub(int dst, int reg1, int reg2)
+{
+    x86_64_bin(x86_64_sub, /*commutative=*/0, dst, reg1, reg2);
+}
+
+void back_end_native_div(int dst, int reg1, int reg2)
+{
+    x86_64_div(dst, reg1, reg2, /*rem=*/0);
+}
+
+void back_end_native_rem(int dst, int reg1, int reg2)
+{
+    x86_64_div(dst, reg1, reg2, /*rem=*/1);
+}
+
+void back_end_native_mul(int dst, int reg1, int reg2)
+{
+    if (dst == reg2) {
+        x86_64_rr(/*w=*/1, /*two_byte=*/1, x86_64_imul, dst, reg1);
+    } else {
+        x86_64_mov(dst, reg1);
+        x86_64_rr(/*w=*/1, /*two_byte=*/1, x86_64_imul, dst, reg2);
+    }
+}
+
+void back_end_native_xor(int dst, int reg1, int reg2)
+{
+    x86_64_bin(x86_64_xor, /*commutative=*/1, dst, reg1, reg2);
+}
+
+void back_end_native_xori(int dst, int reg1, int imm)
+{
+    x86_64_mov(dst, reg1);
+    x86_64_imm_op(x86_64_grp1_imm32, x86_64_grp1_xor, dst, imm);
+}
+
+void back_end_native_and(int dst, int reg1, int reg2)
+{
+    x86_64_bin(x86_64_and, /*commutative=*/1, dst, reg1, reg2);
+}
+
+void back_end_native_andi(int dst, int reg1, int imm)
+{
+    x86_64_mov(dst, reg1);
+    x86_64_imm_op(x86_64_grp1_imm32, x86_64_grp1_and, dst, imm);
+}
+
+void back_end_native_or(int dst, int reg1, int reg2)
+{
+    x86_64_bin(x86_64_or, /*commutative=*/1, dst, reg1, reg2);
+}
+
+void back_end_native_ori(int dst, int reg1, int imm)
+{
+    x86_64_mov(dst, reg1);
+    x86_64_imm_op(x86_64_grp1_imm32, x86_64_grp1_or, dst, imm);
+}
+
+void back_end_native_sra(int dst, int reg1, int reg2)
+{
+    x86_64_shift(x86_64_grp2_sar, dst, reg1, reg2);
+}
+
+void back_end_native_srl(int dst, int reg1, int reg2)
+{
+    x86_64_shift(x86_64_grp2_shr, dst, reg1, reg2);
+}
+
+void back_end_native_srai(int dst, int reg1, int imm)
+{
+    x86_64_mov(dst, reg1);
+    x86_64_rex(/*w=*/1, 0, dst);
+    put_8(x86_64_grp2_imm8);
+    put_8(0xC0 | (x86_64_grp2_sar << 3) | (dst & 7));
+    put_8(imm);
+}
+
+void back_end_native_sll(int dst, int reg1, int reg2)
+{
+    x86_64_shift(x86_64_grp2_shl, dst, reg1, reg2);
+}
+
+void back_end_native_slli(int dst, int reg1, int imm)
+{
+    x86_64_mov(dst, reg1);
+    x86_64_rex(/*w=*/1, 0, dst);
+    put_8(x86_64_grp2_imm8);
+    put_8(0xC0 | (x86_64_grp2_shl << 3) | (dst & 7));
+    put_8(imm);
+}
+
+void back_end_native_slt(int dst, int reg1, int reg2)
+{
+    x86_64_rr(/*w=*/1, /*two_byte=*/0, x86_64_cmp, reg2, reg1);
+    x86_64_setcc(x86_64_setl, dst);
+}
+
+void back_end_native_slti(int dst, int reg1, int imm)
+{
+    x86_64_imm_op(x86_64_grp1_imm32, x86_64_grp1_cmp, reg1, imm);
+    x86_64_setcc(x86_64_setl, dst);
+}
+
+void back_end_native_seqz(int dst, int reg1)
+{
+    x86_64_rr(/*w=*/1, /*two_byte=*/0, x86_64_test, reg1, reg1);
+    x86_64_setcc(x86_64_sete, dst);
+}
+
+void back_end_native_snez(int dst, int reg1)
+{
+    x86_64_rr(/*w=*/1, /*two_byte=*/0, x86_64_test, reg1, reg1);
+    x86_64_setcc(x86_64_setne, dst);
+}
+
+void back_end_native_li(int dst, int imm)
+{
+    x86_64_rex(/*w=*/1, 0, dst);
+    put_8(x86_64_mov_imm32);
+    put_8(0xC0 | (dst & 7));
+    put_32(imm);
+}
+
+void back_end_native_lb(int dst, int addr, int off)
+{
+    x86_64_rm(/*w=*/1, /*two_byte=*/1, x86_64_movsx_8, dst, addr, off);
+}
+
+void back_end_native_lbu(int dst, int addr, int off)
+{
+    x86_64_rm(/*w=*/1, /*two_byte=*/1, x86_64_movzx_8, dst, addr, off);
+}
+
+void back_end_native_lh(int dst, int addr, int off)
+{
+    x86_64_rm(/*w=*/1, /*two_byte=*/1, x86_64_movsx_16, dst, addr, off);
+}
+
+void back_end_native_lhu(int dst, int addr, int off)
+{
+    x86_64_rm(/*w=*/1, /*two_byte=*/1, x86_64_movzx_16, dst, addr, off);
+}
+
+void back_end_native_lw(int dst, int addr, int off)
+{
+    x86_64_rm(/*w=*/1, /*two_byte=*/0, x86_64_movsxd, dst, addr, off);
+}
+
+void back_end_native_lwu(int dst, int addr, int off)
+{
+    /* 32-bit move clears upper half. */
+    x86_64_rm(/*w=*/0, /*two_byte=*/0, x86_64_mov_load, dst, addr, off);
+}
+
+void back_end_native_ld(int dst, int addr, int off)
+{
+    x86_64_rm(/*w=*/1, /*two_byte=*/0, x86_64_mov_load, dst, addr, off);
+}
+
+void back_end_native_sb(int dst, int addr, int off)
+{
+    x86_64_rm(/*w=*/0, /*two_byte=*/0, x86_64_mov_store_8, dst, addr, off);
+}
+
+void back_end_native_sh(int dst, int addr, int off)
+{
+    put_8(x86_64_operand_16);
+    x86_64_rm(/*w=*/0, /*two_byte=*/0, x86_64_mov_store, dst, addr, off);
+}
+
+void back_end_native_sw(int dst, int addr, int off)
+{
+    x86_64_rm(/*w=*/0, /*two_byte=*/0, x86_64_mov_store, dst, addr, off);
+}
+
+void back_end_native_sd(int dst, int addr, int off)
+{
+    x86_64_rm(/*w=*/1, /*two_byte=*/0, x86_64_mov_store, dst, addr, off);
+}
+
+void back_end_native_ret()
+{
+    put_8(x86_64_ret);
+}
+
+void back_end_native_call(int off)
+{
+    x86_64_rel32(x86_64_call_rel32, off);
+}
+
+void back_end_native_jmp(int off)
+{
+    x86_64_rel32(x86_64_jmp_rel32, off);
+}
+
+void back_end_native_jmp_reg(int reg)
+{
+    if (reg >= 8)
+        put_8(x86_64_rex_prefix | x86_64_rex_b);
+    put_8(x86_64_grp5);
+    put_8(0xC0 | (x86_64_grp5_jmp << 3) | (reg & 7));
+}
+
+void back_end_native_beq(int reg1, int reg2, int off)
+{
+    x86_64_branch(x86_64_je, reg1, reg2, off);
+}
+
+void back_end_native_bne(int reg1, int reg2, int off)
+{
+    x86_64_branch(x86_64_jne, reg1, reg2, off);
+}
+
+void back_end_native_blt(int reg1, int reg2, int off)
+{
+    x86_64_branch(x86_64_jl, reg1, reg2, off);
+}
+
+void back_end_native_bge(int reg1, int reg2, int off)
+{
+    x86_64_branch(x86_64_jge, reg1, reg2, off);
+}
+
+void back_end_native_patch(uint8_t *code, int64_t off)
+{
+    uint64_t rel_at = 0;
+
+    if (code[0] == x86_64_call_rel32 || code[0] == x86_64_jmp_rel32)
+        /* call/jmp rel32 */
+        rel_at = 1;
+    else if (code[1] == x86_64_cmp && code[3] == x86_64_two_byte)
+        /* REX cmp ModRM, jcc rel32 */
+        rel_at = 5;
+    else
+        weak_unreachable("Cannot patch instruction %02x %02x.", code[0], code[1]);
+
+    int64_t rel = off - (int64_t) (rel_at + 4);
+
+    if (rel < INT32_MIN || rel > INT32_MAX)
+        weak_fatal_error("Jump offset %ld does not fit in 32 bits.", off);
+
+    code[rel_at + 0] = (rel      ) & 0xFF;
+    code[rel_at + 1] = (rel >>  8) & 0xFF;
+    code[rel_at + 2] = (rel >> 16) & 0xFF;
+    code[rel_at + 3] = (rel >> 24) & 0xFF;
+}
+
+/* Jumps and branches are always encoded with 32-bit
+   offset, so code is left as is. */
+uint64_t back_end_native_relax_size(unused const uint8_t *code, uint64_t size, unused bool fixup, unused int64_t off)
+{
+    return size;
+}
+
+uint64_t back_end_native_relax(const uint8_t *code, uint64_t size, uint8_t *out, unused uint64_t out_size)
+{
+    memcpy(out, code, size);
+    return 0;
+}
+
+/* Linux system call ABI: number in rax, arguments in
+   rdi, rsi, rdx, r10, r8, r9. */
+void back_end_native_syscall_0(int syscall)
+{
+    back_end_native_li(x86_64_reg_rax, syscall);
+    x86_64_opcode(/*two_byte=*/1, x86_64_syscall);
+}
+
+void back_end_native_syscall_1(int syscall, int _1)
+{
+    back_end_native_li(x86_64_reg_rdi, _1);
+    back_end_native_syscall_0(syscall);
+}
+
+void back_end_native_syscall_2(int syscall, int _1, int _2)
+{
+    back_end_native_li(x86_64_reg_rsi, _2);
+    back_end_native_syscall_1(syscall, _1);
+}
+
+void back_end_native_syscall_3(int syscall, int _1, int _2, int _3)
+{
+    back_end_native_li(x86_64_reg_rdx, _3);
+    back_end_native_syscall_2(syscall, _1, _2);
+}
+
+void back_end_native_syscall_4(int syscall, int _1, int _2, int _3, int _4)
+{
+    back_end_native_li(x86_64_reg_r10, _4);
+    back_end_native_syscall_3(syscall, _1, _2, _3);
+}
+
+void back_end_native_syscall_5(int syscall, int _1, int _2, int _3, int _4, int _5)
+{
+    back_end_native_li(x86_64_reg_r8, _5);
+    back_end_native_syscall_4(syscall, _1, _2, _3, _4);
+}
+
+void back_end_native_syscall_6(int syscall, int _1, int _2, int _3, int _4, int _5, int _6)
+{
+    back_end_native_li(x86_64_reg_r9, _6);
+    back_end_native_syscall_5(syscall, _1, _2, _3, _4, _5);
+}
+
+static int align_to_16_bytes(int num)
+{
+    return (num + 15) & ~15;
+}
+
+/* System V ABI: rsp is 16-byte aligned before call,
+   so after return address and rbp are pushed it is
+   aligned again. */
+void back_end_native_prologue(int stack_usage)
+{
+    int extra_stack_usage = align_to_16_bytes(stack_usage);
+
+    x86_64_push(x86_64_reg_rbp);
+    x86_64_mov(x86_64_reg_rbp, x86_64_reg_rsp);
+
+    if (extra_stack_usage > 0)
+        x86_64_imm_op(x86_64_grp1_imm32, x86_64_grp1_sub, x86_64_reg_rsp, extra_stack_usage);
+}
+
+void back_end_native_epilogue(unused int stack_usage)
+{
+    put_8(x86_64_leave);
+}
@@ -0,0 +1,98 @@
+/* x86_64.h - x86-64 instructions and registers.
+ * Copyright (C) 2024 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#ifndef WEAK_COMPILER_BACKEND_X86_64_H
+#define WEAK_COMPILER_BACKEND_X86_64_H
+
+/**********************************************
+ **           Instruction codes              **
+ **********************************************/
+
+/* op r/m64, r64 */
+#define x86_64_add                  0x01
+#define x86_64_or                   0x09
+#define x86_64_and                  0x21
+#define x86_64_sub                  0x29
+#define x86_64_xor                  0x31
+#define x86_64_cmp                  0x39
+#define x86_64_test                 0x85
+#define x86_64_mov_store_8          0x88
+#define x86_64_mov_store            0x89
+/* op r64, r/m64 */
+#define x86_64_movsxd               0x63
+#define x86_64_mov_load             0x8B
+#define x86_64_lea                  0x8D
+/* Two-byte opcodes, after 0x0F */
+#define x86_64_imul                 0xAF
+#define x86_64_movzx_8              0xB6
+#define x86_64_movzx_16             0xB7
+#define x86_64_movsx_8              0xBE
+#define x86_64_movsx_16             0xBF
+#define x86_64_syscall              0x05
+#define x86_64_je                   0x84
+#define x86_64_jne                  0x85
+#define x86_64_jl                   0x8C
+#define x86_64_jge                  0x8D
+#define x86_64_sete                 0x94
+#define x86_64_setne                0x95
+#define x86_64_setl                 0x9C
+/* op r/m64, imm32 with /digit in ModRM */
+#define x86_64_grp1_imm32           0x81
+#define x86_64_grp1_or              1
+#define x86_64_grp1_and             4
+#define x86_64_grp1_sub             5
+#define x86_64_grp1_xor             6
+#define x86_64_grp1_cmp             7
+/* op r/m64, cl or op r/m64, imm8 */
+#define x86_64_grp2_cl              0xD3
+#define x86_64_grp2_imm8            0xC1
+#define x86_64_grp2_shl             4
+#define x86_64_grp2_shr             5
+#define x86_64_grp2_sar             7
+/* op r/m64 */
+#define x86_64_grp3                 0xF7
+#define x86_64_grp3_idiv            7
+#define x86_64_grp5                 0xFF
+#define x86_64_grp5_jmp             4
+/* Misc */
+#define x86_64_mov_imm32            0xC7
+#define x86_64_call_rel32           0xE8
+#define x86_64_jmp_rel32            0xE9
+#define x86_64_ret                  0xC3
+#define x86_64_leave                0xC9
+#define x86_64_cqo                  0x99
+#define x86_64_push_r               0x50
+#define x86_64_pop_r                0x58
+#define x86_64_two_byte             0x0F
+#define x86_64_operand_16           0x66
+
+#define x86_64_rex_prefix           0x40
+#define x86_64_rex_w                0x08
+#define x86_64_rex_b                0x01
+
+/* Registers */
+#define x86_64_reg_rax               0
+#define x86_64_reg_rcx               1
+#define x86_64_reg_rdx               2
+#define x86_64_reg_rbx               3
+#define x86_64_reg_rsp               4
+#define x86_64_reg_rbp               5
+#define x86_64_reg_rsi               6
+#define x86_64_reg_rdi               7
+#define x86_64_reg_r8                8
+#define x86_64_reg_r9                9
+#define x86_64_reg_r10              10
+#define x86_64_reg_r11              11
+#define x86_64_reg_r12              12
+#define x86_64_reg_r13              13
+#define x86_64_reg_r14              14
+#define x86_64_reg_r15              15
+
+/* Clobbered by encoder to emulate three-operand
+   instructions. Never given to code generator. */
+#define x86_64_reg_scratch          x86_64_reg_r11
+
+#endif // WEAK_COMPILER_BACKEND_X86_64_H
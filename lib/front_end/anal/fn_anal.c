@@ -90,6 +90,9 @@ static void visit_fn_decl(struct ast_node *ast)
 {
     struct ast_fn_decl *decl = ast->ast;
     fn_storage_push(&fn_storage, decl->name, decl);
+    /* Prototype. */
+    if (decl->body == NULL)
+        return;
     /* Don't need to analyze arguments though. */
     visit(decl->body);
 
@@ -43,6 +43,12 @@ void fn_storage_push(
         fn->args[i] = arg->dt;
     }
 
+    bool     ok  = 0;
+    uint64_t old = hashmap_get(s, crc32_string(name), &ok);
+    /* Definition replaces prototype. */
+    if (ok)
+        weak_free((struct builtin_fn *) old);
+
     hashmap_put(s, crc32_string(name), (uint64_t) fn);
 
 }
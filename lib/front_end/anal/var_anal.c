@@ -386,10 +386,32 @@ static void visit_compound(struct ast_node *ast)
     ast_storage_end_scope(&storage);
 }
 
+static bool is_fn_proto(struct ast_storage_decl *decl)
+{
+    if (!decl || decl->ast->type != AST_FUNCTION_DECL)
+        return 0;
+
+    struct ast_fn_decl *fn = decl->ast->ast;
+    return fn->body == NULL;
+}
+
 static void visit_fn_decl(struct ast_node *ast)
 {
     struct ast_fn_decl *decl = ast->ast;
-    assert_is_not_declared(decl->name, ast);
+
+    /* Prototype. Function is defined later or in other
+       object file. */
+    if (decl->body == NULL) {
+        assert_is_not_declared(decl->name, ast);
+        ast_storage_push(&storage, decl->name, ast);
+        return;
+    }
+
+    /* Definition may follow prototype, then uses are
+       still counted by prototype. */
+    bool has_proto = is_fn_proto(ast_storage_lookup(&storage, decl->name));
+    if (!has_proto)
+        assert_is_not_declared(decl->name, ast);
 
     ast_storage_start_scope(&storage);
     /* This is to have function in recursive calls. */
@@ -402,7 +424,8 @@ static void visit_fn_decl(struct ast_node *ast)
     make_unused_var_analysis();
     ast_storage_end_scope(&storage);
     /* This is to have function outside. */
-    ast_storage_push(&storage, decl->name, ast);
+    if (!has_proto)
+        ast_storage_push(&storage, decl->name, ast);
 }
 
 static void visit_fn_call(struct ast_node *ast)
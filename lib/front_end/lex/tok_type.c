@@ -73,6 +73,7 @@ const char *tok_to_string(enum token_type t)
     case TOK_CLOSE_CURLY_BRACKET:    return "}";
     case TOK_OPEN_PAREN:             return "(";
     case TOK_CLOSE_PAREN:            return ")";
+    case TOK_MULHI:                  return "mulh";
     default:
         weak_unreachable("Unknown token type (numeric: %d).", t);
     }
@@ -77,7 +77,10 @@ enum token_type {
     TOK_OPEN_CURLY_BRACKET,  // {
     TOK_CLOSE_CURLY_BRACKET, // }
     TOK_OPEN_PAREN,          // (
-    TOK_CLOSE_PAREN          // )
+    TOK_CLOSE_PAREN,         // )
+
+    /** IR-only operators, never produced by lexer. */
+    TOK_MULHI                // High 32 bits of 64-bit product
 };
 
 /** \return String representation of the token. Don't
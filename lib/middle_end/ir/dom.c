@@ -6,49 +6,74 @@
 
 #include "middle_end/ir/dom.h"
 #include "middle_end/ir/ir.h"
+#include "util/alloc.h"
 #include <string.h>
 
-#define MAX_VERTICES 512
-
 #define MIN(a,b) (((a)<(b))?(a):(b))
 
-static vector_t(int) graph        [MAX_VERTICES];
-static vector_t(int) reverse_graph[MAX_VERTICES];
+typedef vector_t(int) dom_edges_t;
+
+/* All arrays below are indexed by vertex and have
+   `vertices` elements. */
+static dom_edges_t *graph;
+static dom_edges_t *reverse_graph;
 /* semidoms[u] = {v | sdom[v] = u} */
-static vector_t(int) semidoms     [MAX_VERTICES];
+static dom_edges_t *semidoms;
 
-static uint64_t visit_time        [MAX_VERTICES];
-static uint64_t inverse_visit_time[MAX_VERTICES];
-static uint64_t parent_in_dfs_tree[MAX_VERTICES];
-static uint64_t semidom           [MAX_VERTICES];
-static uint64_t idom              [MAX_VERTICES];
-static uint64_t union_find        [MAX_VERTICES];
-static uint64_t path_compression  [MAX_VERTICES];
+static uint64_t    *visit_time;
+static uint64_t    *inverse_visit_time;
+static uint64_t    *parent_in_dfs_tree;
+static uint64_t    *semidom;
+static uint64_t    *idom;
+static uint64_t    *union_find;
+static uint64_t    *path_compression;
 
-static uint64_t dfs_index;
+static uint64_t     vertices;
+static uint64_t     dfs_index;
 
-static void dom_tree_reset_state()
+static void dom_tree_free()
 {
-    for (uint64_t i = 0; i < MAX_VERTICES; ++i) {
+    for (uint64_t i = 0; i < vertices; ++i) {
         vector_free(graph[i]);
         vector_free(reverse_graph[i]);
         vector_free(semidoms[i]);
     }
 
-    memset(graph,              0, sizeof (graph));
-    memset(reverse_graph,      0, sizeof (reverse_graph));
-    memset(semidoms,           0, sizeof (semidoms));
-    memset(visit_time,         0, sizeof (visit_time));
-    memset(inverse_visit_time, 0, sizeof (inverse_visit_time));
-    memset(parent_in_dfs_tree, 0, sizeof (parent_in_dfs_tree));
-    memset(semidom,            0, sizeof (semidom));
-    memset(idom,               0, sizeof (idom));
-    memset(union_find,         0, sizeof (union_find));
-    memset(path_compression,   0, sizeof (path_compression));
-
+    weak_free(graph);
+    weak_free(reverse_graph);
+    weak_free(semidoms);
+    weak_free(visit_time);
+    weak_free(inverse_visit_time);
+    weak_free(parent_in_dfs_tree);
+    weak_free(semidom);
+    weak_free(idom);
+    weak_free(union_find);
+    weak_free(path_compression);
+
+    vertices  = 0;
     dfs_index = 0;
 }
 
+/* Allocate state for graph of `n` vertices. DFS numbers
+   start from 1, so arrays have one more element. */
+static void dom_tree_reset_state(uint64_t n)
+{
+    n                 += 1;
+    vertices           = n;
+    dfs_index          = 0;
+
+    graph              = weak_calloc(n, sizeof (*graph));
+    reverse_graph      = weak_calloc(n, sizeof (*reverse_graph));
+    semidoms           = weak_calloc(n, sizeof (*semidoms));
+    visit_time         = weak_calloc(n, sizeof (*visit_time));
+    inverse_visit_time = weak_calloc(n, sizeof (*inverse_visit_time));
+    parent_in_dfs_tree = weak_calloc(n, sizeof (*parent_in_dfs_tree));
+    semidom            = weak_calloc(n, sizeof (*semidom));
+    idom               = weak_calloc(n, sizeof (*idom));
+    union_find         = weak_calloc(n, sizeof (*union_find));
+    path_compression   = weak_calloc(n, sizeof (*path_compression));
+}
+
 struct edge {
     uint64_t from;
     uint64_t to;
@@ -169,52 +194,140 @@ static void dom_tree()
             idom[i]  = idom[idom[i]];
 }
 
-/* Put IR nodes to static array. Used in this specific dominator
-   tree algorithm.
-
-   Returns number of added items. */
-static uint64_t dom_tree_fill(struct ir_node *it, struct ir_node **stmts)
+static void dom_edge(uint64_t u, uint64_t v)
 {
-    uint64_t cnt = 0;
+    vector_push_back(graph[u], v);
+    vector_push_back(reverse_graph[v], u);
+}
 
+/* Put IR nodes to array, indexed by instr_idx. Used in this
+   specific dominator tree algorithm. Phi nodes are skipped, since they are not
+   a part of CFG.
+
+   If `reverse` is set, edges of reverse CFG are added. Then
+   all statements without successors are connected with virtual
+   `exit` vertex. This is used to compute post-dominators. */
+static void dom_tree_fill(
+    struct ir_node  *it,
+    struct ir_node **stmts,
+    bool             reverse,
+    uint64_t         exit
+) {
     while (it) {
-        stmts[it->instr_idx] = it;
+        if (it->type == IR_PHI) {
+            it = it->next;
+            continue;
+        }
+
+        uint64_t u = it->instr_idx;
+        stmts[u] = it;
 
         vector_foreach(it->cfg.succs, i) {
-            uint64_t u = it->instr_idx;
             uint64_t v = vector_at(it->cfg.succs, i)->instr_idx;
 
-            vector_push_back(graph[u], v);
-            vector_push_back(reverse_graph[v], u);
+            if (reverse)
+                dom_edge(v, u);
+            else
+                dom_edge(u, v);
         }
 
+        if (reverse && it->cfg.succs.count == 0)
+            dom_edge(exit, u);
+
         it = it->next;
-        ++cnt;
     }
+}
+
+/* Vertex after last instruction. */
+static uint64_t dom_exit_vertex(struct ir_node *it)
+{
+    uint64_t max = 0;
 
-    return cnt;
+    while (it) {
+        if (it->instr_idx > max)
+            max = it->instr_idx;
+        it = it->next;
+    }
+
+    return max + 1;
 }
 
 void ir_dominator_tree(struct ir_fn_decl *decl)
 {
-    struct ir_node *it                  = decl->body;
-    struct ir_node *stmts[MAX_VERTICES] = {0};
+    struct ir_node  *it    = decl->body;
+    uint64_t         n     = dom_exit_vertex(it);
+    struct ir_node **stmts = weak_calloc(n, sizeof (*stmts));
 
-    dom_tree_reset_state();
+    dom_tree_reset_state(n);
+    dom_tree_fill(it, stmts, /*reverse=*/0, /*exit=*/0);
 
-    uint64_t stmts_cnt = dom_tree_fill(it, stmts);
+    for (it = decl->body; it; it = it->next) {
+        it->idom = NULL;
+        vector_free(it->idom_back);
+    }
 
-    dfs(0);
+    dfs(decl->body->instr_idx);
     dom_tree();
 
-    for (uint64_t i = 0; i < stmts_cnt; ++i) {
+    for (it = decl->body; it; it = it->next) {
+        uint64_t i = it->instr_idx;
+
+        /* Unreachable statements are not dominated by anything. */
+        if (it->type == IR_PHI || !visit_time[i])
+            continue;
+
         uint64_t        idom_idx = inverse_visit_time[idom[visit_time[i]]];
-        struct ir_node *stmt     = stmts[i];
         struct ir_node *dom      = stmts[idom_idx];
 
-        stmt->idom = dom;
-        vector_push_back(dom->idom_back, stmt);
+        it->idom = dom;
+        /* Root dominates itself, but is not own child. */
+        if (dom != it)
+            vector_push_back(dom->idom_back, it);
+    }
+
+    weak_free(stmts);
+    dom_tree_free();
+}
+
+void ir_post_dominator_tree(struct ir_fn_decl *decl)
+{
+    struct ir_node  *it    = decl->body;
+    uint64_t         exit  = dom_exit_vertex(it);
+    /* Exit is a vertex too. */
+    struct ir_node **stmts = weak_calloc(exit + 1, sizeof (*stmts));
+
+    dom_tree_reset_state(exit + 1);
+    dom_tree_fill(it, stmts, /*reverse=*/1, exit);
+
+    for (it = decl->body; it; it = it->next) {
+        it->ipdom = NULL;
+        vector_free(it->ipdom_back);
+    }
+
+    dfs(exit);
+    dom_tree();
+
+    for (it = decl->body; it; it = it->next) {
+        uint64_t i = it->instr_idx;
+
+        /* Statements of infinite loops cannot reach exit
+           and have no post-dominators. */
+        if (it->type == IR_PHI || !visit_time[i])
+            continue;
+
+        uint64_t ipdom_idx = inverse_visit_time[idom[visit_time[i]]];
+
+        if (ipdom_idx == exit)
+            continue;
+
+        struct ir_node *pdom = stmts[ipdom_idx];
+
+        it->ipdom = pdom;
+        vector_push_back(pdom->ipdom_back, it);
     }
+
+    weak_free(stmts);
+    dom_tree_free();
 }
 
 /* Cooper algorithm
@@ -223,13 +336,18 @@ void ir_dominance_frontier(struct ir_fn_decl *decl)
 {
     struct ir_node *b = decl->body;
 
+    for (; b; b = b->next)
+        vector_free(b->df);
+
+    b = decl->body;
+
     while (b) {
         if (b->cfg.preds.count >= 2) {
             vector_foreach(b->cfg.preds, pred_i) {
                 struct ir_node *p = vector_at(b->cfg.preds, pred_i);
                 struct ir_node *runner = p;
 
-                while (runner != b->idom) {
+                while (runner && runner != b->idom) {
                     vector_push_back(runner->df, b);
 
                     /* Upper statement is reached. */
@@ -245,6 +363,36 @@ void ir_dominance_frontier(struct ir_fn_decl *decl)
     }
 }
 
+/* The same algorithm applied to reverse CFG. Post-dominance
+   frontier of statement X is set of conditions Y, such as X
+   post-dominates some successor of Y, but not Y itself. This
+   is exactly the control dependence relation. */
+void ir_post_dominance_frontier(struct ir_fn_decl *decl)
+{
+    struct ir_node *b = decl->body;
+
+    for (; b; b = b->next)
+        vector_free(b->pdf);
+
+    b = decl->body;
+
+    while (b) {
+        if (b->cfg.succs.count >= 2) {
+            vector_foreach(b->cfg.succs, succ_i) {
+                struct ir_node *runner = vector_at(b->cfg.succs, succ_i);
+
+                /* NULL is function exit. */
+                while (runner && runner != b->ipdom) {
+                    vector_push_back(runner->pdf, b);
+                    runner = runner->ipdom;
+                }
+            }
+        }
+
+        b = b->next;
+    }
+}
+
 bool ir_dominated_by(struct ir_node *node, struct ir_node *dom)
 {
     if (node == dom) return 1;
@@ -267,4 +415,14 @@ bool ir_dominates(struct ir_node *dom, struct ir_node *node)
     }
 
     return 0;
-}
\ No newline at end of file
+}
+
+bool ir_post_dominates(struct ir_node *pdom, struct ir_node *node)
+{
+    while (node) {
+        if (node == pdom) return 1;
+        node = node->ipdom;
+    }
+
+    return 0;
+}
@@ -17,10 +17,21 @@ void ir_dominator_tree(struct ir_fn_decl *decl);
 
 void ir_dominance_frontier(struct ir_fn_decl *decl);
 
+/** Build post-dominator tree. Statements, immediately post-dominated
+    by function exit, have NULL `ipdom`. */
+void ir_post_dominator_tree(struct ir_fn_decl *decl);
+
+/** Compute control dependence (post-dominance frontier).
+    Requires post-dominator tree. */
+void ir_post_dominance_frontier(struct ir_fn_decl *decl);
+
 /** Judge of \p node is dominated by \p dom. */
 bool ir_dominated_by(struct ir_node *node, struct ir_node *dom);
 
 /** Judge if \p dom is dominator of \p node. */
 bool ir_dominates(struct ir_node *dom, struct ir_node *node);
 
+/** Judge if \p pdom is post-dominator of \p node. */
+bool ir_post_dominates(struct ir_node *pdom, struct ir_node *node);
+
 #endif // WEAK_COMPILER_MIDDLE_END_DOM_H
\ No newline at end of file
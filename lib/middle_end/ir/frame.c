@@ -0,0 +1,340 @@
+/* frame.c - Stack frame layout.
+ * Copyright (C) 2024 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#include "middle_end/ir/frame.h"
+#include "middle_end/ir/gen.h"
+#include "middle_end/ir/ir.h"
+#include "middle_end/ir/ir_ops.h"
+#include "front_end/lex/data_type.h"
+#include "util/hashmap.h"
+#include "util/vector.h"
+#include <string.h>
+
+/* Stack slot coloring. Frame grows with number of values,
+   live at the same time, rather than with number of
+   variables in source. Like with register allocation,
+   two variables interfere, if one is defined where other
+   is live. Slots are assigned greedily in order of alloca
+   statements. */
+
+#define FRAME_VARS_LIMIT 512
+#define LIVE_WORDS       (FRAME_VARS_LIMIT / 64)
+
+typedef vector_t(uint64_t) idx_vector_t;
+typedef uint64_t           live_set_t[LIVE_WORDS];
+
+struct stmt_info {
+    struct ir_node *ir;
+    live_set_t      use;
+    uint64_t        def;
+    live_set_t      in;
+    live_set_t      out;
+};
+
+struct slot {
+    uint64_t        size;
+    uint64_t        align;
+    uint64_t        off;
+    /** Variables, sharing this slot. */
+    idx_vector_t    vars;
+};
+
+/* Scalar variable, whose address is never taken. */
+static bool                       shared[FRAME_VARS_LIMIT];
+static bool                       interfere[FRAME_VARS_LIMIT][FRAME_VARS_LIMIT];
+static vector_t(struct stmt_info) stmts;
+static vector_t(struct slot)      slots;
+/* Key:   statement
+   Value: index in `stmts` */
+static hashmap_t                  stmt_idx;
+
+/**********************************************
+ **              Live sets                   **
+ **********************************************/
+
+really_inline static void live_add(live_set_t set, uint64_t idx)
+{
+    set[idx / 64] |= 1ULL << (idx % 64);
+}
+
+really_inline static void live_del(live_set_t set, uint64_t idx)
+{
+    set[idx / 64] &= ~(1ULL << (idx % 64));
+}
+
+really_inline static bool live_has(live_set_t set, uint64_t idx)
+{
+    return set[idx / 64] & (1ULL << (idx % 64));
+}
+
+static bool shared_sym(struct ir_node *ir)
+{
+    if (ir->type != IR_SYM)
+        return 0;
+
+    struct ir_sym *sym = ir->ir;
+
+    return sym->idx < FRAME_VARS_LIMIT && shared[sym->idx];
+}
+
+static void use_collect(struct ir_node *sym, void *data)
+{
+    if (shared_sym(sym))
+        live_add(data, ((struct ir_sym *) sym->ir)->idx);
+}
+
+static void addr_taken(struct ir_node *sym, unused void *data)
+{
+    struct ir_sym *s = sym->ir;
+
+    if (s->addr_of && s->idx < FRAME_VARS_LIMIT)
+        shared[s->idx] = 0;
+}
+
+static void shared_collect(struct ir_fn_decl *decl)
+{
+    memset(shared, 0, sizeof (shared));
+
+    for (struct ir_node *it = decl->body; it; it = it->next) {
+        if (it->type != IR_ALLOCA)
+            continue;
+
+        struct ir_alloca *alloca = it->ir;
+
+        if (alloca->idx < FRAME_VARS_LIMIT && alloca->dt != D_T_STRUCT)
+            shared[alloca->idx] = 1;
+    }
+
+    for (struct ir_node *it = decl->body; it; it = it->next)
+        ir_foreach_use(it, addr_taken, NULL);
+}
+
+static void liveness(struct ir_fn_decl *decl)
+{
+    bool changed = 1;
+
+    vector_clear(stmts);
+    hashmap_reset(&stmt_idx, 256);
+
+    for (struct ir_node *it = decl->body; it; it = it->next) {
+        struct stmt_info  info = {.ir = it, .def = UINT64_MAX};
+        struct ir_node   *def  = ir_def(it);
+
+        ir_foreach_use(it, use_collect, info.use);
+
+        if (def && shared_sym(def))
+            info.def = ((struct ir_sym *) def->ir)->idx;
+
+        hashmap_put(&stmt_idx, (uint64_t) it, stmts.count);
+        vector_push_back(stmts, info);
+    }
+
+    while (changed) {
+        changed = 0;
+
+        vector_foreach_back(stmts, i) {
+            struct stmt_info *info = &vector_at(stmts, i);
+            live_set_t        in   = {0};
+
+            vector_foreach(info->ir->cfg.succs, j) {
+                bool     ok   = 0;
+                uint64_t succ = hashmap_get(&stmt_idx, (uint64_t) vector_at(info->ir->cfg.succs, j), &ok);
+
+                if (!ok)
+                    continue;
+
+                for (uint64_t w = 0; w < LIVE_WORDS; ++w)
+                    info->out[w] |= vector_at(stmts, succ).in[w];
+            }
+
+            memcpy(in, info->out, sizeof (live_set_t));
+
+            if (info->def != UINT64_MAX)
+                live_del(in, info->def);
+
+            for (uint64_t w = 0; w < LIVE_WORDS; ++w)
+                in[w] |= info->use[w];
+
+            if (memcmp(in, info->in, sizeof (live_set_t))) {
+                memcpy(info->in, in, sizeof (live_set_t));
+                changed = 1;
+            }
+        }
+    }
+}
+
+static void add_edges(uint64_t u, live_set_t set)
+{
+    for (uint64_t v = 0; v < FRAME_VARS_LIMIT; ++v) {
+        if (u == v || !live_has(set, v))
+            continue;
+
+        interfere[u][v] = 1;
+        interfere[v][u] = 1;
+    }
+}
+
+static void interference_build()
+{
+    memset(interfere, 0, sizeof (interfere));
+
+    vector_foreach(stmts, i) {
+        struct stmt_info *info = &vector_at(stmts, i);
+
+        if (info->def != UINT64_MAX)
+            add_edges(info->def, info->out);
+    }
+
+    /* Values, read before any definition, are live
+       together from function entry. */
+    if (stmts.count > 0) {
+        struct stmt_info *entry = &vector_at(stmts, 0);
+
+        for (uint64_t v = 0; v < FRAME_VARS_LIMIT; ++v)
+            if (live_has(entry->in, v))
+                add_edges(v, entry->in);
+    }
+}
+
+/**********************************************
+ **                 Slots                    **
+ **********************************************/
+
+static uint64_t alloca_size(struct ir_alloca *alloca)
+{
+    int size = data_type_size[alloca->dt];
+
+    if (alloca->ptr_depth > 0)
+        return 8;
+
+    return size > 0 ? size : 8;
+}
+
+static uint64_t alloca_array_size(struct ir_alloca_array *alloca)
+{
+    uint64_t size = data_type_size[alloca->dt];
+
+    for (uint64_t i = 0; i < alloca->arity_size; ++i)
+        size *= alloca->arity[i];
+
+    return size;
+}
+
+static uint64_t slot_new(uint64_t size, uint64_t align, uint64_t idx)
+{
+    struct slot slot = {
+        .size  = size,
+        .align = align == 0 || align > 8 ? 8 : align
+    };
+
+    vector_push_back(slot.vars, idx);
+    vector_push_back(slots, slot);
+
+    return slots.count - 1;
+}
+
+static bool slot_fits(struct slot *slot, uint64_t size, uint64_t idx)
+{
+    if (slot->size != size)
+        return 0;
+
+    vector_foreach(slot->vars, i) {
+        uint64_t v = vector_at(slot->vars, i);
+
+        if (v >= FRAME_VARS_LIMIT || !shared[v] || interfere[idx][v])
+            return 0;
+    }
+
+    return 1;
+}
+
+static uint64_t slot_assign(struct ir_alloca *alloca)
+{
+    uint64_t size = alloca_size(alloca);
+
+    if (alloca->idx < FRAME_VARS_LIMIT && shared[alloca->idx]) {
+        vector_foreach(slots, i) {
+            struct slot *slot = &vector_at(slots, i);
+
+            if (slot_fits(slot, size, alloca->idx)) {
+                vector_push_back(slot->vars, alloca->idx);
+                return i;
+            }
+        }
+    }
+
+    return slot_new(size, size, alloca->idx);
+}
+
+static void layout(struct ir_fn_decl *decl)
+{
+    ir_vector_t  allocas  = {0};
+    idx_vector_t assigned = {0};
+    uint64_t     off      = 0;
+
+    for (struct ir_node *it = decl->body; it; it = it->next) {
+        uint64_t slot = 0;
+
+        if (it->type == IR_ALLOCA) {
+            slot = slot_assign(it->ir);
+        } else if (it->type == IR_ALLOCA_ARRAY) {
+            struct ir_alloca_array *alloca = it->ir;
+            uint64_t                elem   = data_type_size[alloca->dt];
+
+            slot = slot_new(alloca_array_size(alloca), elem, alloca->idx);
+        } else {
+            continue;
+        }
+
+        vector_push_back(allocas, it);
+        vector_push_back(assigned, slot);
+    }
+
+    vector_foreach(slots, i) {
+        struct slot *slot = &vector_at(slots, i);
+
+        off       = (off + slot->align - 1) & ~(slot->align - 1);
+        slot->off = off;
+        off      += slot->size;
+    }
+
+    vector_foreach(allocas, i) {
+        struct ir_node *it  = vector_at(allocas, i);
+        uint64_t        off = vector_at(slots, vector_at(assigned, i)).off;
+
+        if (it->type == IR_ALLOCA)
+            ((struct ir_alloca *) it->ir)->frame_off = off;
+        else
+            ((struct ir_alloca_array *) it->ir)->frame_off = off;
+    }
+
+    decl->frame_size = (off + 7) & ~7ULL;
+
+    vector_foreach(slots, i)
+        vector_free(vector_at(slots, i).vars);
+
+    vector_free(allocas);
+    vector_free(assigned);
+    vector_clear(slots);
+}
+
+void ir_frame_build(struct ir_fn_decl *decl)
+{
+    decl->frame_size = 0;
+
+    if (!decl->body)
+        return;
+
+    ir_cfg_build(decl);
+    shared_collect(decl);
+    liveness(decl);
+    interference_build();
+    layout(decl);
+
+    vector_free(stmts);
+    vector_free(slots);
+    hashmap_destroy(&stmt_idx);
+}
@@ -0,0 +1,26 @@
+/* frame.h - Stack frame layout.
+ * Copyright (C) 2024 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#ifndef WEAK_COMPILER_MIDDLE_END_FRAME_H
+#define WEAK_COMPILER_MIDDLE_END_FRAME_H
+
+struct ir_fn_decl;
+
+/** Assign stack frame offsets to variables of function.
+
+    Scalar variables, whose address is never taken, share
+    stack slot, if their live ranges are disjoint and they
+    have the same size. Arrays and variables, whose address
+    is taken, get their own slots. Arguments are not part of
+    the frame.
+
+    Result is written to `frame_off` of each alloca and to
+    `frame_size` of function.
+
+    \pre Phi nodes are eliminated. */
+void ir_frame_build(struct ir_fn_decl *decl);
+
+#endif // WEAK_COMPILER_MIDDLE_END_FRAME_H
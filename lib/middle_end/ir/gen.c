@@ -8,6 +8,7 @@
 #include "front_end/ast/ast.h"
 #include "middle_end/ir/ir.h"
 #include "middle_end/ir/storage.h"
+#include "middle_end/ir/type.h"
 #include "util/crc32.h"
 #include "util/hashmap.h"
 #include "util/unreachable.h"
@@ -34,13 +35,8 @@ static struct type        ir_type_map[65536];
    - increments with every created alloca instruction. */
 static uint64_t           ir_var_idx;
 static bool               ir_save_first;
-static bool               ir_meta_is_loop;
 /* Depth of source-level blocks ({ ... }). */
 static uint64_t           ir_block_depth;
-/* Loop index in function boundaries. If loop is nested,
-   index is incremented sequentially. */
-static uint64_t           ir_loop_idx;
-static uint64_t           ir_meta_loop_idx;
 /* This used to judge if we should put function call to IR list
    or use it as instruction operand. */
 static bool               ir_is_global_scope;
@@ -79,12 +75,6 @@ static void try_add_meta(struct ir_node *ir)
 {
     ir->meta.kind = IR_META_SYM;
     ir->meta.block_depth = ir_block_depth;
-    ir->meta.global_loop_idx = ir_loop_idx;
-
-    if (ir_meta_is_loop) {
-        ir->meta.sym.loop = 1;
-        ir->meta.sym.loop_idx = ir_meta_loop_idx++;
-    }
 }
 
 /* Note: This function does not set previous pointers
@@ -128,7 +118,6 @@ static void reset_fn_state()
     memset(ir_type_map, 0, sizeof (ir_type_map));
     ir_last_type = D_T_UNKNOWN;
     ir_var_idx = 0;
-    ir_loop_idx = 0;
     ir_block_depth = 0;
     ir_first = NULL;
     ir_last = NULL;
@@ -307,9 +296,7 @@ static void visit_for(struct ast_for *ast)
        
        Initial part is optional. */
 
-    ir_meta_is_loop = 1;
     if (ast->init) visit(ast->init);
-    ir_meta_is_loop = 0;
 
     /* Body starts with condition that is checked on each
       iteration. */
@@ -322,9 +309,6 @@ static void visit_for(struct ast_for *ast)
 
     vector_push_back(ir_loop_header_stack, header_idx);
 
-    if (ir_block_depth == 0)
-        ++ir_loop_idx;
-
     ++ir_block_depth;
     /* Condition is optional. */
     if (ast->condition) {
@@ -352,9 +336,7 @@ static void visit_for(struct ast_for *ast)
         body_start = NULL;
 
     /* Increment is optional. */
-    ir_meta_is_loop = 1;
     if (ast->increment) visit(ast->increment);
-    ir_meta_is_loop = 0;
 
     ir_last = ir_jump_init(next_iter_jump_idx);
 
@@ -383,13 +365,8 @@ static void visit_while(struct ast_while *ast)
 
     vector_push_back(ir_loop_header_stack, header_idx);
 
-    if (ir_block_depth == 0)
-        ++ir_loop_idx;
-
     ++ir_block_depth;
-    ir_meta_is_loop = 1;
     visit(ast->cond);
-    ir_meta_is_loop = 0;
 
     struct ir_node *cond_bin      = ir_bin_init(TOK_NEQ, ir_last, zero_cond_immediate());
     struct ir_node *cond          = ir_cond_init(cond_bin, /*Not used for now.*/-1);
@@ -436,15 +413,10 @@ static void visit_do_while(struct ast_do_while *ast)
     else
         stmt_begin = ir_last->instr_idx + 1;
 
-    if (ir_block_depth == 0)
-        ++ir_loop_idx;
-
     ++ir_block_depth;
     visit(ast->body);
 
-    ir_meta_is_loop = 1;
     visit(ast->condition);
-    ir_meta_is_loop = 0;
 
     struct ir_node *cond = ir_cond_init(
         ir_bin_init(
@@ -726,35 +698,72 @@ static void visit_array_decl(struct ast_array_decl *ast)
     ir_storage_push(ast->name, next_idx, ast->dt, ast->ptr_depth, ir_last);
 }
 
-static void visit_array_access(struct ast_array_access *ast)
+/* Integer temporary `tN = lhs op rhs`. Returns tN. */
+static struct ir_node *emit_index_bin(enum token_type op, struct ir_node *lhs, struct ir_node *rhs)
 {
-    /* First just assume one-dimensional array.
-       Next extend to multi-dimensional. */
+    uint64_t next_idx = ir_var_idx++;
 
-    struct ir_storage_record *record  = ir_storage_get(ast->name);
-    struct ast_compound      *indices = ast->indices->ast;
+    ir_last = ir_alloca_init(D_T_INT, /*ptr_depth=*/0, next_idx);
+    ir_type_map[next_idx].dt = D_T_INT;
+    ir_type_map[next_idx].ptr_depth = 0;
+    insert_last();
+    ir_last = ir_store_sym_init(next_idx, ir_bin_init(op, lhs, rhs));
+    insert_last();
+
+    return ir_sym_init(next_idx);
+}
 
-    if (indices->size == 1) {
-        visit(indices->stmts[0]);
-        struct ir_node *idx = ir_last;
+/* Elements are stored in row-major order, so element
+   a[i][j][k] of array a[D0][D1][D2] has offset
+     ((i * D1) + j) * D2 + k. */
+static struct ir_node *emit_array_offset(
+    struct ir_storage_record *record,
+    struct ast_compound      *indices
+) {
+    struct ir_alloca_array *array = NULL;
 
-        uint64_t next_idx = ir_var_idx++;
+    if (record->ir && record->ir->type == IR_ALLOCA_ARRAY)
+        array = record->ir->ir;
 
-        ir_last = ir_alloca_init(record->dt, /*ptr=*/1, next_idx);
-        ir_type_map[next_idx].dt = record->dt;
-        ir_type_map[next_idx].ptr_depth = record->ptr_depth;
-        insert_last();
-        ir_last = ir_store_init(
-            ir_sym_init(next_idx),
-            ir_bin_init(
-                TOK_PLUS,
-                ir_sym_init(record->sym_idx),
-                idx
-            )
+    visit(indices->stmts[0]);
+    struct ir_node *offset = ir_last;
+
+    for (uint64_t i = 1; i < indices->size; ++i) {
+        assert(array && i < array->arity_size && "Array dimensions mismatch.");
+
+        struct ir_node *row = emit_index_bin(
+            TOK_STAR, offset, ir_imm_int_init(array->arity[i])
         );
-        insert_last();
-        ir_last = ir_sym_ptr_init(next_idx);
+
+        visit(indices->stmts[i]);
+        offset = emit_index_bin(TOK_PLUS, row, ir_last);
     }
+
+    return offset;
+}
+
+static void visit_array_access(struct ast_array_access *ast)
+{
+    struct ir_storage_record *record  = ir_storage_get(ast->name);
+    struct ast_compound      *indices = ast->indices->ast;
+    struct ir_node           *idx     = emit_array_offset(record, indices);
+
+    uint64_t next_idx = ir_var_idx++;
+
+    ir_last = ir_alloca_init(record->dt, /*ptr=*/1, next_idx);
+    ir_type_map[next_idx].dt = record->dt;
+    ir_type_map[next_idx].ptr_depth = record->ptr_depth;
+    insert_last();
+    ir_last = ir_store_init(
+        ir_sym_init(next_idx),
+        ir_bin_init(
+            TOK_PLUS,
+            ir_sym_init(record->sym_idx),
+            idx
+        )
+    );
+    insert_last();
+    ir_last = ir_sym_ptr_init(next_idx);
 }
 
 static void visit_member(unused struct ast_member *ast)
@@ -776,6 +785,13 @@ static void visit_compound(struct ast_compound *ast)
 
 static void visit_fn_decl(struct ast_fn_decl *decl)
 {
+    /* Prototype of function from other unit. Calls
+       to it are resolved by linker. */
+    if (decl->body == NULL) {
+        store_return_type(decl->name, decl->data_type);
+        return;
+    }
+
     reset_fn_state();
 
     visit(decl->args);
@@ -811,6 +827,20 @@ static void visit_fn_decl(struct ast_fn_decl *decl)
     ir_storage_reset();
 }
 
+/* Type pass does not know functions, which are only
+   declared, so type of call is given here. */
+static struct ir_node *fn_call_init(char *name, struct ir_node *args, enum data_type dt)
+{
+    struct ir_node    *ir   = ir_fn_call_init(name, args);
+    struct ir_fn_call *call = ir->ir;
+
+    call->type_info.dt = dt;
+    if (dt != D_T_VOID && dt != D_T_STRUCT)
+        call->type_info.bytes = ir_type_size(dt);
+
+    return ir;
+}
+
 static void visit_fn_call(struct ast_fn_call *ast)
 {
     struct ast_compound *args_ast   = ast->args->ast;
@@ -834,7 +864,7 @@ static void visit_fn_call(struct ast_fn_call *ast)
     char *fcall_name = strdup(ast->name);
 
     if (ir_is_global_scope) {
-        ir_last = ir_fn_call_init(fcall_name, args_start);
+        ir_last = fn_call_init(fcall_name, args_start, ret_dt);
         insert(ir_last);
     } else {
         uint64_t next_idx = ir_var_idx++;
@@ -842,7 +872,7 @@ static void visit_fn_call(struct ast_fn_call *ast)
         ir_type_map[next_idx].dt = ret_dt;
         insert_last();
 
-        ir_last = ir_fn_call_init(fcall_name, args_start);
+        ir_last = fn_call_init(fcall_name, args_start, ret_dt);
         ir_last = ir_store_sym_init(next_idx, ir_last);
         insert_last();
         ir_last = ir_sym_init(next_idx);
@@ -895,7 +925,10 @@ really_inline static void link_stmt_map(hashmap_t *stmt_map, struct ir_node *ir)
     hashmap_init(stmt_map, 128);
 
     while (ir) {
-        hashmap_put(stmt_map, ir->instr_idx, (uint64_t) ir);
+        /* Phi nodes share instruction index with statement
+           they belong to and cannot be jump targets. */
+        if (ir->type != IR_PHI)
+            hashmap_put(stmt_map, ir->instr_idx, (uint64_t) ir);
         /* Clear all CFG information. */
         vector_free(ir->cfg.preds);
         vector_free(ir->cfg.succs);
@@ -951,7 +984,7 @@ really_inline static void link_cond(hashmap_t *stmt_map, struct ir_node *stmt)
     cond->target = link_target(stmt_map, to);
 
     vector_push_back(stmt->cfg.succs, cond->target);
-    vector_push_back(stmt->cfg.succs, stmt->next);
+    vector_push_back(stmt->cfg.succs, ir_next_stmt(stmt));
 
     ir_vector_t *prevs = &cond->target->cfg.preds;
     vector_push_back(*prevs, stmt);
@@ -959,8 +992,10 @@ really_inline static void link_cond(hashmap_t *stmt_map, struct ir_node *stmt)
 
 really_inline static void link_stmt(struct ir_node *stmt)
 {
-    if (stmt->next)
-        vector_push_back(stmt->cfg.succs, stmt->next);
+    struct ir_node *next = ir_next_stmt(stmt);
+
+    if (next)
+        vector_push_back(stmt->cfg.succs, next);
 }
 
 static void link(struct ir_fn_decl *decl)
@@ -970,18 +1005,20 @@ static void link(struct ir_fn_decl *decl)
 
     link_stmt_map(&stmt_map, it);
 
-    hashmap_foreach(&stmt_map, k, v) {
-        (void) k;
-        struct ir_node *stmt = (struct ir_node *) v;
+    /* Statements are linked in list order, so predecessors
+       of each statement are also sorted by list position. */
+    for (; it; it = it->next) {
+        struct ir_node *stmt = it;
+
+        if (stmt->type == IR_PHI)
+            continue;
 
         /* Link previous. If we have return statement,
            some predecessors will be dropped. */
-        if (stmt->instr_idx > 0) {
-            struct ir_node *prev = link_target(&stmt_map, stmt->instr_idx - 1);
+        struct ir_node *prev = ir_prev_stmt(stmt);
 
-            if (prev->type != IR_JUMP)
-                vector_push_back(stmt->cfg.preds, prev);
-        }
+        if (prev && prev->type != IR_JUMP)
+            vector_push_back(stmt->cfg.preds, prev);
 
         switch (stmt->type) {
         case IR_JUMP:
@@ -1013,6 +1050,11 @@ void ir_cfg_build(struct ir_fn_decl *decl)
     link(decl);
 
     while (it) {
+        if (it->type == IR_PHI) {
+            it = it->next;
+            continue;
+        }
+
         bool new = 0;
         new |= it->cfg.preds.count == 0; /* Very beginning. */
         new |= it->cfg.preds.count >= 2; /* Branch. */
@@ -1026,6 +1068,11 @@ void ir_cfg_build(struct ir_fn_decl *decl)
 
         it = it->next;
     }
+
+    /* Phi node belongs to the block of its statement. */
+    for (it = decl->body; it; it = it->next)
+        if (it->type == IR_PHI)
+            it->cfg_block_no = ir_next_stmt(it)->cfg_block_no;
 }
 
 struct ir_unit ir_gen(struct ast_node *ast)
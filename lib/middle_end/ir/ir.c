@@ -6,6 +6,7 @@
 
 #include "middle_end/ir/ir.h"
 #include "util/alloc.h"
+#include "util/arena.h"
 #include "util/unreachable.h"
 #include <assert.h>
 #include <string.h>
@@ -15,6 +16,10 @@
    instruction allocation. So it needed to have
    indexing from 0. */
 static uint64_t ir_instr_idx = -1;
+/* Phi operands. Phi nodes are created and removed
+   by passes all the time, but operands of all of
+   them are freed once with IR by ir_unit_cleanup(). */
+static struct arena ir_phi_arena;
 
 void ir_reset_state()
 {
@@ -28,7 +33,6 @@ struct ir_node *ir_node_init(enum ir_type type, void *ir)
     node->instr_idx = ir_instr_idx;
     node->ir = ir;
     node->meta.block_depth = META_VALUE_UNKNOWN;
-    node->meta.global_loop_idx = META_VALUE_UNKNOWN;
     node->cfg_block_no = 0;
     node->claimed_reg = IR_NO_CLAIMED_REG;
     return node;
@@ -292,19 +296,146 @@ struct ir_node *ir_fn_call_init(char *name, struct ir_node *args)
     return ir_node_init(IR_FN_CALL, ir);
 }
 
-wur struct ir_node *ir_phi_init(
-    uint64_t sym_idx,
-    uint64_t op_1_idx,
-    uint64_t op_2_idx
-) {
+wur struct ir_node *ir_phi_init(uint64_t sym_idx, uint64_t args_size)
+{
     struct ir_phi *ir = weak_calloc(1, sizeof (struct ir_phi));
     ir->sym_idx = sym_idx;
-    ir->op_1_idx = op_1_idx;
-    ir->op_2_idx = op_2_idx;
-    ++ir_instr_idx;
+    ir->ssa_idx = UINT64_MAX;
+    ir_phi_args_reset(ir, args_size);
     return ir_node_init(IR_PHI, ir);
 }
 
+void ir_phi_args_reset(struct ir_phi *phi, uint64_t args_size)
+{
+    phi->args_size = args_size;
+    phi->args = arena_alloc(&ir_phi_arena, args_size * sizeof (struct ir_phi_arg));
+
+    for (uint64_t i = 0; i < args_size; ++i)
+        phi->args[i].ssa_idx = -1;
+}
+
+static void *payload_copy(void *ir, uint64_t size)
+{
+    void *copy = weak_calloc(1, size);
+    memcpy(copy, ir, size);
+    return copy;
+}
+
+static struct ir_node *ir_list_copy(struct ir_node *ir)
+{
+    struct ir_node *head = NULL;
+    struct ir_node *tail = NULL;
+
+    for (struct ir_node *it = ir; it; it = it->next) {
+        struct ir_node *copy = ir_node_copy(it);
+
+        if (tail)
+            ir_insert_after(tail, copy);
+        else
+            head = copy;
+
+        tail = copy;
+    }
+
+    return head;
+}
+
+struct ir_node *ir_node_copy(struct ir_node *ir)
+{
+    void *copy = NULL;
+
+    switch (ir->type) {
+    case IR_ALLOCA:
+        copy = payload_copy(ir->ir, sizeof (struct ir_alloca));
+        break;
+    case IR_ALLOCA_ARRAY:
+        copy = payload_copy(ir->ir, sizeof (struct ir_alloca_array));
+        break;
+    case IR_IMM:
+        copy = payload_copy(ir->ir, sizeof (struct ir_imm));
+        break;
+    case IR_SYM:
+        copy = payload_copy(ir->ir, sizeof (struct ir_sym));
+        break;
+    case IR_PUSH:
+        copy = payload_copy(ir->ir, sizeof (struct ir_push));
+        break;
+    case IR_POP:
+        copy = payload_copy(ir->ir, sizeof (struct ir_pop));
+        break;
+    case IR_JUMP:
+        copy = payload_copy(ir->ir, sizeof (struct ir_jump));
+        break;
+    case IR_MEMBER:
+        copy = payload_copy(ir->ir, sizeof (struct ir_member));
+        break;
+    case IR_STRING: {
+        struct ir_string *s = payload_copy(ir->ir, sizeof (struct ir_string));
+        s->imm = payload_copy(s->imm, strlen(s->imm) + 1);
+        copy = s;
+        break;
+    }
+    case IR_STORE: {
+        struct ir_store *s = payload_copy(ir->ir, sizeof (struct ir_store));
+        s->idx  = ir_node_copy(s->idx);
+        s->body = ir_node_copy(s->body);
+        copy = s;
+        break;
+    }
+    case IR_BIN: {
+        struct ir_bin *b = payload_copy(ir->ir, sizeof (struct ir_bin));
+        b->lhs    = ir_node_copy(b->lhs);
+        b->rhs    = ir_node_copy(b->rhs);
+        b->parent = NULL;
+        copy = b;
+        break;
+    }
+    case IR_COND: {
+        struct ir_cond *c = payload_copy(ir->ir, sizeof (struct ir_cond));
+        c->cond = ir_node_copy(c->cond);
+        copy = c;
+        break;
+    }
+    case IR_RET: {
+        struct ir_ret *r = payload_copy(ir->ir, sizeof (struct ir_ret));
+        if (r->body)
+            r->body = ir_node_copy(r->body);
+        copy = r;
+        break;
+    }
+    case IR_FN_CALL: {
+        struct ir_fn_call *c = payload_copy(ir->ir, sizeof (struct ir_fn_call));
+        c->name = payload_copy(c->name, strlen(c->name) + 1);
+        c->args = ir_list_copy(c->args);
+        copy = c;
+        break;
+    }
+    case IR_PHI: {
+        struct ir_phi *p = payload_copy(ir->ir, sizeof (struct ir_phi));
+        struct ir_phi *o = ir->ir;
+        ir_phi_args_reset(p, o->args_size);
+        memcpy(p->args, o->args, o->args_size * sizeof (struct ir_phi_arg));
+        copy = p;
+        break;
+    }
+    default:
+        weak_unreachable("Cannot copy IR type (numeric: %d).", ir->type);
+    }
+
+    struct ir_node *node = ir_node_init(ir->type, copy);
+    node->instr_idx = ir->instr_idx;
+    node->meta      = ir->meta;
+
+    if (ir->type == IR_STORE) {
+        struct ir_store *store = copy;
+
+        if (store->body->type == IR_BIN)
+            ((struct ir_bin *) store->body->ir)->parent = node;
+    }
+
+    return node;
+}
+
 static void ir_string_cleanup(struct ir_string *ir)
 {
     weak_free(ir->imm);
@@ -344,6 +475,8 @@ static void ir_type_decl_cleanup(struct ir_type_decl *ir)
 
 static void ir_fn_decl_cleanup(struct ir_fn_decl *ir)
 {
+    ir_loops_cleanup(ir);
+
     struct ir_node *it = ir->args;
     while (it) {
         ir_node_cleanup(it);
@@ -397,9 +530,13 @@ void ir_node_cleanup(struct ir_node *ir)
         weak_unreachable("Unknown IR type (numeric: %d).", ir->type);
     }
 
-    vector_clear(ir->idom_back);
-    vector_clear(ir->ddg_stmts);
-    vector_clear(ir->df);
+    vector_free(ir->idom_back);
+    vector_free(ir->ipdom_back);
+    vector_free(ir->ddg_stmts);
+    vector_free(ir->df);
+    vector_free(ir->pdf);
+    vector_free(ir->cfg.succs);
+    vector_free(ir->cfg.preds);
     weak_free(ir->ir);
     weak_free(ir);
 }
@@ -412,4 +549,6 @@ void ir_unit_cleanup(struct ir_unit *ir)
         ir_node_cleanup(it);
         it = it->next;
     }
+
+    arena_destroy(&ir_phi_arena);
 }
@@ -10,6 +10,7 @@
 #include "front_end/lex/data_type.h"
 #include "front_end/lex/tok_type.h"
 #include "middle_end/ir/ir_ops.h"
+#include "middle_end/ir/loop.h"
 #include "middle_end/ir/meta.h"
 #include "middle_end/ir/type.h"
 #include "util/compiler.h"
@@ -97,8 +98,19 @@ struct ir_node {
     ir_vector_t         idom_back;
     /** Dominance frontier. */
     ir_vector_t         df;
+    /** Immediate post-dominator. NULL if statement is immediately
+        post-dominated by function exit or cannot reach it at all. */
+    struct ir_node     *ipdom;
+    /** Backward edges of post-dominator tree. */
+    ir_vector_t         ipdom_back;
+    /** Post-dominance frontier. These are conditional statements
+        on which current node is control dependent. */
+    ir_vector_t         pdf;
     /** Number of basic block in CFG to which current node is associated. */
     uint64_t            cfg_block_no;
+    /** Innermost natural loop, containing this statement, or
+        NULL. Computed by ir_loops_build(). */
+    struct ir_loop     *loop;
 
     /** Data dependence graph.
        
@@ -136,6 +148,8 @@ struct ir_alloca {
         D_T_INT %1.
         Alternatively, string names can be stored. */
     uint64_t         idx;
+    /** Offset in stack frame. Computed by ir_frame_build(). */
+    uint64_t         frame_off;
 };
 
 struct ir_alloca_array {
@@ -144,6 +158,8 @@ struct ir_alloca_array {
     uint64_t         arity[16];
     uint64_t         arity_size;
     uint64_t         idx;
+    /** Offset in stack frame. Computed by ir_frame_build(). */
+    uint64_t         frame_off;
 };
 
 enum ir_imm_type {
@@ -283,6 +299,12 @@ struct ir_fn_decl {
         - struct ir_type_decl_t (compound type, nested). */
     struct ir_node  *args;
     struct ir_node  *body;
+    /** Outermost loops of loop-nest forest. Computed by
+        ir_loops_build(). */
+    ir_loop_vector_t loops;
+    /** Size of stack frame in bytes, excluding arguments.
+        Computed by ir_frame_build(). */
+    uint64_t         frame_size;
 };
 
 struct ir_fn_call {
@@ -295,12 +317,24 @@ struct ir_fn_call {
     struct type      type_info;
 };
 
+struct ir_phi_arg {
+    /** SSA index of variable, or -1 if there is no reaching
+        definition through this edge. */
+    int64_t          ssa_idx;
+    /** CFG predecessor of the statement, through which
+        value comes. */
+    struct ir_node  *pred;
+};
+
+/** Phi node is placed right before the statement it belongs
+    to and is not a part of CFG itself. It has one operand
+    per CFG predecessor of this statement. */
 struct ir_phi {
-    uint64_t         sym_idx;
-    uint64_t         ssa_idx;
-    uint64_t         op_1_idx;
-    uint64_t         op_2_idx;
-    int              args[128];
+    uint64_t           sym_idx;
+    uint64_t           ssa_idx;
+    uint64_t           args_size;
+    /** Allocated from arena, which is freed by ir_unit_cleanup(). */
+    struct ir_phi_arg *args;
 };
 
 void ir_reset_state();
@@ -344,11 +378,15 @@ wur struct ir_node *ir_fn_decl_init(
 );
 wur struct ir_node *ir_fn_call_init(char *name, struct ir_node *args);
 
-wur struct ir_node *ir_phi_init(
-    uint64_t sym_idx,
-    uint64_t op_1_idx,
-    uint64_t op_2_idx
-);
+wur struct ir_node *ir_phi_init(uint64_t sym_idx, uint64_t args_size);
+/** Replace operands of phi with `args_size` operands without
+    reaching definition. Old ones are not accessible after this. */
+void ir_phi_args_reset(struct ir_phi *phi, uint64_t args_size);
+
+/** Deep copy of statement \p ir with all its operands. Jump
+    targets of copy refer to the same statements as original
+    ones. CFG, dominator and loop links are not copied. */
+wur struct ir_node *ir_node_copy(struct ir_node *ir);
 
 void ir_node_cleanup(struct ir_node *ir);
 void ir_unit_cleanup(struct ir_unit *ir);
@@ -232,7 +232,15 @@ static void ir_dump_fn_call(FILE *mem, struct ir_fn_call *ir)
 
 static void ir_dump_phi(FILE *mem, struct ir_phi *ir)
 {
-    fprintf(mem, "t%lu.%lu = φ(%lu, %lu)", ir->sym_idx, ir->ssa_idx, ir->op_1_idx, ir->op_2_idx);
+    fprintf(mem, "t%lu.%lu = φ(", ir->sym_idx, ir->ssa_idx);
+    for (uint64_t i = 0; i < ir->args_size; ++i) {
+        fprintf(mem, "t%lu", ir->sym_idx);
+        if (ir->args[i].ssa_idx >= 0)
+            fprintf(mem, ".%ld", ir->args[i].ssa_idx);
+        if (i < ir->args_size - 1)
+            fprintf(mem, ", ");
+    }
+    fprintf(mem, ")");
 }
 
 unused static void type_dump(struct type *t)
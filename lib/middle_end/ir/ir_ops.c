@@ -19,4 +19,153 @@ void ir_remove(struct ir_node **ir, struct ir_node **list_head)
         (*ir) = (*ir)->next;
         (*list_head) = (*ir);
     }
-}
\ No newline at end of file
+}
+
+/*  (prev    ) -- next --> (curr    )
+    (prev    ) <- prev --- (curr    )
+
+    (prev    ) -- next --> (new     ) -- next --> (curr    )
+    (prev    ) <- prev --- (new     ) <- prev --- (curr    ) */
+void ir_insert_before(struct ir_node *curr, struct ir_node *new, struct ir_node **list_head)
+{
+    struct ir_node *prev = curr->prev;
+
+    if (prev)
+        prev->next = new;
+    else
+        *list_head = new;
+
+    new->prev = prev;
+    new->next = curr;
+    curr->prev = new;
+}
+
+void ir_insert_after(struct ir_node *curr, struct ir_node *new)
+{
+    struct ir_node *next = curr->next;
+
+    if (next)
+        next->prev = new;
+
+    new->next = next;
+    new->prev = curr;
+    curr->next = new;
+}
+
+struct ir_node *ir_next_stmt(struct ir_node *ir)
+{
+    ir = ir->next;
+    while (ir && ir->type == IR_PHI)
+        ir = ir->next;
+    return ir;
+}
+
+struct ir_node *ir_prev_stmt(struct ir_node *ir)
+{
+    ir = ir->prev;
+    while (ir && ir->type == IR_PHI)
+        ir = ir->prev;
+    return ir;
+}
+
+static void foreach_use_operand(
+    struct ir_node  *ir,
+    void           (*fn)(struct ir_node *, void *),
+    void            *data
+) {
+    switch (ir->type) {
+    case IR_SYM:
+        fn(ir, data);
+        break;
+    case IR_BIN: {
+        struct ir_bin *bin = ir->ir;
+        foreach_use_operand(bin->lhs, fn, data);
+        foreach_use_operand(bin->rhs, fn, data);
+        break;
+    }
+    case IR_FN_CALL: {
+        struct ir_fn_call *call = ir->ir;
+        struct ir_node    *arg  = call->args;
+        while (arg) {
+            foreach_use_operand(arg, fn, data);
+            arg = arg->next;
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+void ir_foreach_use(
+    struct ir_node  *ir,
+    void           (*fn)(struct ir_node *sym, void *data),
+    void            *data
+) {
+    switch (ir->type) {
+    case IR_STORE: {
+        struct ir_store *store = ir->ir;
+        struct ir_sym   *sym   = store->idx->ir;
+        foreach_use_operand(store->body, fn, data);
+        if (sym->deref)
+            fn(store->idx, data);
+        break;
+    }
+    case IR_COND: {
+        struct ir_cond *cond = ir->ir;
+        foreach_use_operand(cond->cond, fn, data);
+        break;
+    }
+    case IR_RET: {
+        struct ir_ret *ret = ir->ir;
+        if (ret->body)
+            foreach_use_operand(ret->body, fn, data);
+        break;
+    }
+    case IR_FN_CALL:
+        foreach_use_operand(ir, fn, data);
+        break;
+    default:
+        break;
+    }
+}
+
+struct ir_node *ir_def(struct ir_node *ir)
+{
+    if (ir->type != IR_STORE)
+        return NULL;
+
+    struct ir_store *store = ir->ir;
+    struct ir_sym   *sym   = store->idx->ir;
+
+    return sym->deref ? NULL : store->idx;
+}
+
+void ir_renumber(struct ir_node *ir)
+{
+    uint64_t        idx = 0;
+    struct ir_node *it  = ir;
+
+    for (; it; it = it->next) {
+        /* Phi node shares index with its statement. */
+        if (it->type == IR_PHI)
+            continue;
+
+        for (struct ir_node *p = it->prev; p && p->type == IR_PHI; p = p->prev)
+            p->instr_idx = idx;
+
+        it->instr_idx = idx++;
+    }
+
+    for (it = ir; it; it = it->next) {
+        if (it->type == IR_JUMP) {
+            struct ir_jump *jump = it->ir;
+            jump->idx = jump->target->instr_idx;
+        }
+
+        if (it->type == IR_COND) {
+            struct ir_cond *cond = it->ir;
+            cond->goto_label = cond->target->instr_idx;
+        }
+    }
+}
@@ -7,6 +7,7 @@
 #ifndef WEAK_COMPILER_MIDDLE_END_IR_OPS_H
 #define WEAK_COMPILER_MIDDLE_END_IR_OPS_H
 
+#include "util/compiler.h"
 #include "util/vector.h"
 #include <stdbool.h>
 
@@ -17,4 +18,43 @@ typedef vector_t(struct ir_node *) ir_vector_t;
     in list, update `list_head`. */
 void ir_remove(struct ir_node **ir, struct ir_node **list_head);
 
-#endif // WEAK_COMPILER_MIDDLE_END_IR_OPS_H
\ No newline at end of file
+/** Insert `new` to the IR list right before `curr`. If `curr`
+    is a first statement in list, update `list_head`.
+
+    \note CFG is not updated. */
+void ir_insert_before(struct ir_node *curr, struct ir_node *new, struct ir_node **list_head);
+
+/** Insert `new` to the IR list right after `curr`.
+
+    \note CFG is not updated. */
+void ir_insert_after(struct ir_node *curr, struct ir_node *new);
+
+/** Get next or previous statement in list, skipping
+    phi nodes, which are not a part of CFG. */
+wur struct ir_node *ir_next_stmt(struct ir_node *ir);
+wur struct ir_node *ir_prev_stmt(struct ir_node *ir);
+
+/** Call `fn` for each symbol read by statement `ir`. These are
+    operands of binary operations, call arguments, returned values
+    and pointers, which are dereferenced to store a value.
+
+    \note Phi operands are not symbols and are not visited. */
+void ir_foreach_use(
+    struct ir_node  *ir,
+    void           (*fn)(struct ir_node *sym, void *data),
+    void            *data
+);
+
+/** Get symbol, which is assigned by statement `ir`. Store through
+    pointer does not define any symbol, so NULL is returned, like
+    for any statement other than store. */
+wur struct ir_node *ir_def(struct ir_node *ir);
+
+/** Assign sequential instruction indices to statements of
+    list `ir` after some were inserted or removed. Jump labels
+    are taken from jump targets, so CFG should be built before.
+
+    \note CFG should be built again after this. */
+void ir_renumber(struct ir_node *ir);
+
+#endif // WEAK_COMPILER_MIDDLE_END_IR_OPS_H
@@ -0,0 +1,380 @@
+/* iv.c - Induction variables analysis.
+ * Copyright (C) 2024 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#include "middle_end/ir/iv.h"
+#include "middle_end/ir/ir.h"
+#include "middle_end/ir/loop.h"
+#include "util/alloc.h"
+#include "util/hashmap.h"
+#include <limits.h>
+
+/* Basic variables are recognized by phi nodes in loop
+   header, whose operand from back edge is computed as phi
+   value plus constant (possibly through copies).
+
+   Derived variables are then found by walking the loop
+   body and combining affine functions of basic variables
+   with constants through +, -, * and <<. Scale and offset
+   are kept in 32-bit range, so they can be used as integer
+   immediates.
+
+   Only `int` variables are considered, because other types
+   either wrap at different width or are pointers. */
+
+/* Key:   value_key(sym_idx, ssa_idx)
+   Value: defining store */
+static hashmap_t defs;
+/* Key:   sym_idx
+   Value: 1 if variable is plain `int` */
+static hashmap_t ints;
+/* Key:   value_key(sym_idx, ssa_idx)
+   Value: struct ir_iv * */
+static hashmap_t ivs;
+
+really_inline static uint64_t value_key(uint64_t sym_idx, uint64_t ssa_idx)
+{
+    return (sym_idx << 32) | (ssa_idx & 0xFFFFFFFF);
+}
+
+/**********************************************
+ **                Operands                  **
+ **********************************************/
+
+static void ints_collect(struct ir_node *ir)
+{
+    if (ir->type != IR_ALLOCA)
+        return;
+
+    struct ir_alloca *alloca = ir->ir;
+
+    if (alloca->dt == D_T_INT && alloca->ptr_depth == 0)
+        hashmap_put(&ints, alloca->idx, 1);
+}
+
+static void defs_collect(struct ir_fn_decl *decl)
+{
+    hashmap_reset(&defs, 256);
+    hashmap_reset(&ints, 64);
+
+    for (struct ir_node *it = decl->args; it; it = it->next)
+        ints_collect(it);
+
+    for (struct ir_node *it = decl->body; it; it = it->next) {
+        ints_collect(it);
+
+        struct ir_node *def = ir_def(it);
+        if (!def)
+            continue;
+
+        struct ir_sym *sym = def->ir;
+        if (sym->ssa_idx != UINT64_MAX)
+            hashmap_put(&defs, value_key(sym->idx, sym->ssa_idx), (uint64_t) it);
+    }
+}
+
+static bool value_sym(struct ir_node *ir)
+{
+    if (ir->type != IR_SYM)
+        return 0;
+
+    struct ir_sym *sym = ir->ir;
+
+    return !sym->deref && !sym->addr_of && sym->ssa_idx != UINT64_MAX;
+}
+
+static struct ir_node *def_of(uint64_t sym_idx, uint64_t ssa_idx)
+{
+    bool     ok  = 0;
+    uint64_t got = hashmap_get(&defs, value_key(sym_idx, ssa_idx), &ok);
+
+    return ok ? (struct ir_node *) got : NULL;
+}
+
+static bool int_sym(struct ir_node *ir)
+{
+    return hashmap_has(&ints, ((struct ir_sym *) ir->ir)->idx);
+}
+
+static bool int_imm(struct ir_node *ir, int64_t *out)
+{
+    if (ir->type != IR_IMM)
+        return 0;
+
+    struct ir_imm *imm = ir->ir;
+
+    if (imm->type != IMM_INT)
+        return 0;
+
+    *out = imm->imm.__int;
+    return 1;
+}
+
+static bool in_range(int64_t v)
+{
+    return v >= INT_MIN && v <= INT_MAX;
+}
+
+static struct ir_iv *iv_of(struct ir_node *ir)
+{
+    if (!value_sym(ir))
+        return NULL;
+
+    struct ir_sym *sym = ir->ir;
+    bool           ok  = 0;
+    uint64_t       got = hashmap_get(&ivs, value_key(sym->idx, sym->ssa_idx), &ok);
+
+    return ok ? (struct ir_iv *) got : NULL;
+}
+
+static struct ir_iv *iv_new(uint64_t sym_idx, uint64_t ssa_idx, struct ir_node *def, ir_iv_vector_t *out)
+{
+    struct ir_iv *iv = weak_calloc(1, sizeof (struct ir_iv));
+
+    iv->sym_idx = sym_idx;
+    iv->ssa_idx = ssa_idx;
+    iv->def     = def;
+
+    hashmap_put(&ivs, value_key(sym_idx, ssa_idx), (uint64_t) iv);
+    vector_push_back(*out, iv);
+
+    return iv;
+}
+
+/**********************************************
+ **            Basic variables               **
+ **********************************************/
+
+/* Is `ir` a phi value? */
+static bool phi_value(struct ir_node *ir, struct ir_phi *phi)
+{
+    if (!value_sym(ir))
+        return 0;
+
+    struct ir_sym *sym = ir->ir;
+
+    return sym->idx == phi->sym_idx && sym->ssa_idx == phi->ssa_idx;
+}
+
+/* Match `phi + step`, `step + phi` or `phi - step`. */
+static bool step_match(struct ir_bin *bin, struct ir_phi *phi, int64_t *step)
+{
+    if (bin->op == TOK_PLUS && phi_value(bin->lhs, phi))
+        return int_imm(bin->rhs, step);
+
+    if (bin->op == TOK_PLUS && phi_value(bin->rhs, phi))
+        return int_imm(bin->lhs, step);
+
+    if (bin->op == TOK_MINUS && phi_value(bin->lhs, phi) && int_imm(bin->rhs, step)) {
+        *step = -*step;
+        return 1;
+    }
+
+    return 0;
+}
+
+/* Follow copies from value on back edge to statement,
+   that adds step. */
+static struct ir_node *update_find(struct ir_loop *loop, uint64_t sym_idx, uint64_t ssa_idx)
+{
+    struct ir_node *def = def_of(sym_idx, ssa_idx);
+
+    while (def && ir_loop_contains(loop, def)) {
+        struct ir_store *store = def->ir;
+
+        if (store->body->type == IR_BIN)
+            return def;
+
+        if (!value_sym(store->body))
+            return NULL;
+
+        struct ir_sym *sym = store->body->ir;
+        def = def_of(sym->idx, sym->ssa_idx);
+    }
+
+    return NULL;
+}
+
+static void basic_collect(struct ir_loop *loop, ir_iv_vector_t *out)
+{
+    struct ir_node *it = loop->header;
+
+    while (it->prev && it->prev->type == IR_PHI)
+        it = it->prev;
+
+    for (; it != loop->header; it = it->next) {
+        struct ir_phi *phi  = it->ir;
+        int64_t        init = -1;
+        int64_t        back = -1;
+
+        if (phi->args_size != 2)
+            continue;
+
+        for (uint64_t i = 0; i < 2; ++i) {
+            if (ir_loop_contains(loop, phi->args[i].pred))
+                back = i;
+            else
+                init = i;
+        }
+
+        if (init < 0 || back < 0 || !hashmap_has(&ints, phi->sym_idx))
+            continue;
+
+        struct ir_node *update = update_find(loop, phi->sym_idx, phi->args[back].ssa_idx);
+        int64_t         step   = 0;
+
+        if (!update || ir_loop_of(update) != loop)
+            continue;
+
+        if (!step_match(((struct ir_store *) update->ir)->body->ir, phi, &step))
+            continue;
+
+        struct ir_iv *iv = iv_new(phi->sym_idx, phi->ssa_idx, it, out);
+
+        iv->basic        = iv;
+        iv->scale        = 1;
+        iv->offset       = 0;
+        iv->step         = step;
+        iv->update       = update;
+        iv->init_ssa_idx = phi->args[init].ssa_idx;
+    }
+}
+
+/**********************************************
+ **           Derived variables              **
+ **********************************************/
+
+/* `iv op c` or `c op iv`. Result is scale and offset. */
+static bool affine(
+    enum token_type  op,
+    struct ir_iv    *iv,
+    int64_t          c,
+    bool             iv_left,
+    int64_t         *scale,
+    int64_t         *offset
+) {
+    switch (op) {
+    case TOK_PLUS:
+        *scale  = iv->scale;
+        *offset = iv->offset + c;
+        break;
+    case TOK_MINUS:
+        *scale  = iv_left ? iv->scale : -iv->scale;
+        *offset = iv_left ? iv->offset - c : c - iv->offset;
+        break;
+    case TOK_STAR:
+        *scale  = iv->scale * c;
+        *offset = iv->offset * c;
+        break;
+    case TOK_SHL:
+        if (!iv_left || c < 0 || c > 30)
+            return 0;
+        *scale  = iv->scale * (1LL << c);
+        *offset = iv->offset * (1LL << c);
+        break;
+    default:
+        return 0;
+    }
+
+    return in_range(*scale) && in_range(*offset);
+}
+
+static bool derive(struct ir_node *body, struct ir_iv **basic, int64_t *scale, int64_t *offset)
+{
+    struct ir_iv *iv = NULL;
+    int64_t       c  = 0;
+
+    if (body->type == IR_SYM) {
+        if (!(iv = iv_of(body)))
+            return 0;
+
+        *basic  = iv->basic;
+        *scale  = iv->scale;
+        *offset = iv->offset;
+        return 1;
+    }
+
+    if (body->type != IR_BIN)
+        return 0;
+
+    struct ir_bin *bin = body->ir;
+
+    if ((iv = iv_of(bin->lhs)) && int_imm(bin->rhs, &c)) {
+        *basic = iv->basic;
+        return affine(bin->op, iv, c, /*iv_left=*/1, scale, offset);
+    }
+
+    if ((iv = iv_of(bin->rhs)) && int_imm(bin->lhs, &c)) {
+        *basic = iv->basic;
+        return affine(bin->op, iv, c, /*iv_left=*/0, scale, offset);
+    }
+
+    return 0;
+}
+
+static void derived_collect(struct ir_loop *loop, ir_iv_vector_t *out)
+{
+    bool changed = 1;
+
+    while (changed) {
+        changed = 0;
+
+        vector_foreach(loop->stmts, i) {
+            struct ir_node *it  = vector_at(loop->stmts, i);
+            struct ir_node *def = ir_def(it);
+
+            if (!def || !value_sym(def) || !int_sym(def) || iv_of(def))
+                continue;
+
+            struct ir_iv *basic  = NULL;
+            int64_t       scale  = 0;
+            int64_t       offset = 0;
+
+            if (!derive(((struct ir_store *) it->ir)->body, &basic, &scale, &offset))
+                continue;
+
+            struct ir_sym *sym = def->ir;
+            struct ir_iv  *iv  = iv_new(sym->idx, sym->ssa_idx, it, out);
+
+            iv->basic  = basic;
+            iv->scale  = scale;
+            iv->offset = offset;
+            changed    = 1;
+        }
+    }
+}
+
+void ir_ivs_build(struct ir_fn_decl *decl, struct ir_loop *loop, ir_iv_vector_t *out)
+{
+    hashmap_reset(&ivs, 64);
+
+    defs_collect(decl);
+    basic_collect(loop, out);
+    derived_collect(loop, out);
+
+    hashmap_destroy(&defs);
+    hashmap_destroy(&ints);
+    hashmap_destroy(&ivs);
+}
+
+void ir_ivs_cleanup(ir_iv_vector_t *ivs_vec)
+{
+    vector_foreach(*ivs_vec, i)
+        weak_free(vector_at(*ivs_vec, i));
+
+    vector_free(*ivs_vec);
+}
+
+struct ir_iv *ir_iv_find(ir_iv_vector_t *ivs_vec, uint64_t sym_idx, uint64_t ssa_idx)
+{
+    vector_foreach(*ivs_vec, i) {
+        struct ir_iv *iv = vector_at(*ivs_vec, i);
+
+        if (iv->sym_idx == sym_idx && iv->ssa_idx == ssa_idx)
+            return iv;
+    }
+
+    return NULL;
+}
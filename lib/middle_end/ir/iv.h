@@ -0,0 +1,64 @@
+/* iv.h - Induction variables analysis.
+ * Copyright (C) 2024 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#ifndef WEAK_COMPILER_MIDDLE_END_IV_H
+#define WEAK_COMPILER_MIDDLE_END_IV_H
+
+#include "middle_end/ir/ir_ops.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+struct ir_fn_decl;
+struct ir_loop;
+struct ir_iv;
+
+typedef vector_t(struct ir_iv *) ir_iv_vector_t;
+
+/** Integer SSA value, that changes by affine law on each
+    loop iteration.
+
+    Basic variable is defined by phi node in loop header as
+      i.1 = φ(i.0, i.2)
+      ...
+      i.2 = i.1 + step
+    Derived variable is an affine function of basic one
+      j = i.1 * scale + offset. */
+struct ir_iv {
+    /** Variable and SSA version of value. */
+    uint64_t        sym_idx;
+    uint64_t        ssa_idx;
+    /** Phi node for basic variable, statement otherwise. */
+    struct ir_node *def;
+    /** Basic variable, which this one is derived from.
+        Points to itself for basic variable. */
+    struct ir_iv   *basic;
+    /** value = basic * scale + offset. */
+    int64_t         scale;
+    int64_t         offset;
+    /** Basic variable only. Value added on each iteration. */
+    int64_t         step;
+    /** Basic variable only. Statement, that adds step. */
+    struct ir_node *update;
+    /** Basic variable only. SSA version of phi operand
+        coming from outside of loop. */
+    uint64_t        init_ssa_idx;
+};
+
+/** Find basic and derived induction variables of \p loop.
+    Basic variables are placed first in \p out. Variables of
+    nested loops are not included.
+
+    \pre SSA form, dominator tree and loop-nest forest are
+         built. */
+void ir_ivs_build(struct ir_fn_decl *decl, struct ir_loop *loop, ir_iv_vector_t *out);
+
+/** Free induction variables found by ir_ivs_build(). */
+void ir_ivs_cleanup(ir_iv_vector_t *ivs);
+
+/** Induction variable with given SSA value or NULL. */
+struct ir_iv *ir_iv_find(ir_iv_vector_t *ivs, uint64_t sym_idx, uint64_t ssa_idx);
+
+#endif // WEAK_COMPILER_MIDDLE_END_IV_H
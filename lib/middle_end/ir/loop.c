@@ -0,0 +1,359 @@
+/* loop.c - Natural loops and loop-nest forest.
+ * Copyright (C) 2024 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#include "middle_end/ir/loop.h"
+#include "middle_end/ir/dom.h"
+#include "middle_end/ir/ir.h"
+#include "middle_end/ir/ir_ops.h"
+#include "util/alloc.h"
+#include "util/hashmap.h"
+#include <stdlib.h>
+
+/* Edge u -> h is a back edge if h dominates u. Natural loop
+   of such edge is h and all statements, from which u can
+   be reached without passing h.
+
+   Two natural loops with different headers are either
+   disjoint or nested, so when loops are processed from
+   largest to smallest, enclosing loop of each loop is the
+   innermost loop already known for its header.
+
+   Loop analysis does not use AST-time metadata, so it
+   remains correct after any CFG restructuring, as long as
+   it is built again. */
+
+/* Key:   header
+   Value: struct ir_loop * */
+static hashmap_t headers;
+
+static struct ir_loop *loop_get(struct ir_node *header, ir_loop_vector_t *all)
+{
+    bool     ok   = 0;
+    uint64_t got  = hashmap_get(&headers, (uint64_t) header, &ok);
+
+    if (ok)
+        return (struct ir_loop *) got;
+
+    struct ir_loop *loop = weak_calloc(1, sizeof (struct ir_loop));
+    loop->header = header;
+
+    hashmap_put(&headers, (uint64_t) header, (uint64_t) loop);
+    vector_push_back(*all, loop);
+
+    return loop;
+}
+
+/* Unreachable statements are not dominated by anything. */
+static bool reachable(struct ir_node *ir)
+{
+    return ir->idom;
+}
+
+static void back_edges_collect(struct ir_fn_decl *decl, ir_loop_vector_t *all)
+{
+    for (struct ir_node *it = decl->body; it; it = it->next) {
+        if (it->type == IR_PHI || !reachable(it))
+            continue;
+
+        vector_foreach(it->cfg.succs, i) {
+            struct ir_node *h = vector_at(it->cfg.succs, i);
+
+            if (!ir_dominates(h, it))
+                continue;
+
+            struct ir_loop *loop = loop_get(h, all);
+            vector_push_back(loop->latches, it);
+        }
+    }
+}
+
+static void body_collect(struct ir_fn_decl *decl, struct ir_loop *loop)
+{
+    hashmap_t   body = {0};
+    ir_vector_t w    = {0};
+
+    hashmap_init(&body, 64);
+    hashmap_put(&body, (uint64_t) loop->header, 1);
+
+    vector_foreach(loop->latches, i) {
+        struct ir_node *latch = vector_at(loop->latches, i);
+
+        if (!hashmap_has(&body, (uint64_t) latch)) {
+            hashmap_put(&body, (uint64_t) latch, 1);
+            vector_push_back(w, latch);
+        }
+    }
+
+    while (w.count > 0) {
+        struct ir_node *it = vector_back(w);
+        vector_pop_back(w);
+
+        vector_foreach(it->cfg.preds, i) {
+            struct ir_node *pred = vector_at(it->cfg.preds, i);
+
+            if (hashmap_has(&body, (uint64_t) pred) || !reachable(pred))
+                continue;
+
+            hashmap_put(&body, (uint64_t) pred, 1);
+            vector_push_back(w, pred);
+        }
+    }
+
+    for (struct ir_node *it = decl->body; it; it = it->next)
+        if (it->type != IR_PHI && hashmap_has(&body, (uint64_t) it))
+            vector_push_back(loop->stmts, it);
+
+    vector_free(w);
+    hashmap_destroy(&body);
+}
+
+static int loop_cmp(const void *l, const void *r)
+{
+    const struct ir_loop *a = *(struct ir_loop **) l;
+    const struct ir_loop *b = *(struct ir_loop **) r;
+
+    if (a->stmts.count != b->stmts.count)
+        return a->stmts.count > b->stmts.count ? -1 : 1;
+
+    return a->header->instr_idx < b->header->instr_idx ? -1 : 1;
+}
+
+static void nest(struct ir_fn_decl *decl, ir_loop_vector_t *all)
+{
+    qsort(all->data, all->count, sizeof (struct ir_loop *), loop_cmp);
+
+    vector_foreach(*all, i) {
+        struct ir_loop *loop = vector_at(*all, i);
+
+        loop->parent = loop->header->loop;
+
+        if (loop->parent) {
+            loop->depth = loop->parent->depth + 1;
+            vector_push_back(loop->parent->children, loop);
+        } else {
+            loop->depth = 1;
+            vector_push_back(decl->loops, loop);
+        }
+
+        vector_foreach(loop->stmts, j)
+            vector_at(loop->stmts, j)->loop = loop;
+    }
+}
+
+static bool exit_has(struct ir_loop *loop, struct ir_node *ir)
+{
+    vector_foreach(loop->exits, i)
+        if (vector_at(loop->exits, i) == ir)
+            return 1;
+
+    return 0;
+}
+
+static void edges_collect(struct ir_loop *loop)
+{
+    vector_foreach(loop->stmts, i) {
+        struct ir_node *it = vector_at(loop->stmts, i);
+
+        vector_foreach(it->cfg.succs, j) {
+            struct ir_node *succ = vector_at(it->cfg.succs, j);
+
+            if (!ir_loop_contains(loop, succ) && !exit_has(loop, succ))
+                vector_push_back(loop->exits, succ);
+        }
+    }
+
+    struct ir_node *entry   = NULL;
+    uint64_t        entries = 0;
+
+    vector_foreach(loop->header->cfg.preds, i) {
+        struct ir_node *pred = vector_at(loop->header->cfg.preds, i);
+
+        if (!ir_loop_contains(loop, pred)) {
+            entry = pred;
+            ++entries;
+        }
+    }
+
+    if (entries == 1 && entry->cfg.succs.count == 1)
+        loop->preheader = entry;
+}
+
+/* Phi node belongs to loop of its statement. */
+static void phis_assign(struct ir_fn_decl *decl)
+{
+    struct ir_node *it = decl->body;
+
+    while (it) {
+        if (it->type != IR_PHI) {
+            it = it->next;
+            continue;
+        }
+
+        struct ir_node *stmt = it;
+        while (stmt->type == IR_PHI)
+            stmt = stmt->next;
+
+        for (; it != stmt; it = it->next)
+            it->loop = stmt->loop;
+    }
+}
+
+void ir_loops_build(struct ir_fn_decl *decl)
+{
+    ir_loop_vector_t all = {0};
+
+    ir_loops_cleanup(decl);
+    hashmap_reset(&headers, 64);
+
+    back_edges_collect(decl, &all);
+
+    vector_foreach(all, i)
+        body_collect(decl, vector_at(all, i));
+
+    nest(decl, &all);
+
+    vector_foreach(all, i)
+        edges_collect(vector_at(all, i));
+
+    phis_assign(decl);
+
+    vector_free(all);
+    hashmap_destroy(&headers);
+}
+
+static void loop_cleanup(struct ir_loop *loop)
+{
+    vector_foreach(loop->children, i)
+        loop_cleanup(vector_at(loop->children, i));
+
+    vector_free(loop->latches);
+    vector_free(loop->exits);
+    vector_free(loop->stmts);
+    vector_free(loop->children);
+    weak_free(loop);
+}
+
+void ir_loops_cleanup(struct ir_fn_decl *decl)
+{
+    vector_foreach(decl->loops, i)
+        loop_cleanup(vector_at(decl->loops, i));
+
+    vector_free(decl->loops);
+
+    for (struct ir_node *it = decl->body; it; it = it->next)
+        it->loop = NULL;
+}
+
+struct ir_loop *ir_loop_of(struct ir_node *ir)
+{
+    return ir->loop;
+}
+
+struct ir_loop *ir_loop_outermost(struct ir_node *ir)
+{
+    struct ir_loop *loop = ir->loop;
+
+    while (loop && loop->parent)
+        loop = loop->parent;
+
+    return loop;
+}
+
+bool ir_loop_contains(struct ir_loop *loop, struct ir_node *ir)
+{
+    for (struct ir_loop *it = ir->loop; it; it = it->parent)
+        if (it == loop)
+            return 1;
+
+    return 0;
+}
+
+uint64_t ir_loop_depth(struct ir_node *ir)
+{
+    return ir->loop ? ir->loop->depth : 0;
+}
+
+static struct ir_node *phi_first(struct ir_node *stmt)
+{
+    while (stmt->prev && stmt->prev->type == IR_PHI)
+        stmt = stmt->prev;
+
+    return stmt;
+}
+
+static bool falls_through(struct ir_node *ir)
+{
+    return ir->type != IR_JUMP && ir->type != IR_RET;
+}
+
+struct ir_node *ir_loop_entry(struct ir_fn_decl *decl, struct ir_loop *loop)
+{
+    struct ir_node *entry = NULL;
+    struct ir_node *pos   = phi_first(loop->header);
+
+    vector_foreach(loop->header->cfg.preds, i) {
+        struct ir_node *pred = vector_at(loop->header->cfg.preds, i);
+
+        if (ir_loop_contains(loop, pred))
+            continue;
+
+        if (entry)
+            return NULL;
+
+        entry = pred;
+    }
+
+    if (!entry || pos == decl->body)
+        return NULL;
+
+    /* Something from loop falls through to header. */
+    if (pos->prev != entry && falls_through(pos->prev))
+        return NULL;
+
+    return entry;
+}
+
+static void entry_retarget(struct ir_node *entry, struct ir_node *header, struct ir_node *to)
+{
+    if (entry->type == IR_JUMP && ((struct ir_jump *) entry->ir)->target == header)
+        ((struct ir_jump *) entry->ir)->target = to;
+
+    if (entry->type == IR_COND && ((struct ir_cond *) entry->ir)->target == header)
+        ((struct ir_cond *) entry->ir)->target = to;
+}
+
+void ir_loop_entry_insert(
+    struct ir_fn_decl *decl,
+    struct ir_loop    *loop,
+    struct ir_node    *entry,
+    ir_vector_t       *stmts
+) {
+    struct ir_node *header = loop->header;
+    struct ir_node *pos    = phi_first(header);
+    struct ir_node *last   = NULL;
+    uint64_t        depth  = pos->prev->meta.block_depth;
+
+    if (stmts->count == 0)
+        return;
+
+    vector_foreach(*stmts, i) {
+        struct ir_node *it = vector_at(*stmts, i);
+
+        ir_insert_before(pos, it, &decl->body);
+        it->meta.block_depth = depth;
+        last = it;
+    }
+
+    entry_retarget(entry, header, vector_at(*stmts, 0));
+
+    for (struct ir_node *it = pos; it != header; it = it->next) {
+        struct ir_phi *phi = it->ir;
+
+        for (uint64_t i = 0; i < phi->args_size; ++i)
+            if (phi->args[i].pred == entry)
+                phi->args[i].pred = last;
+    }
+}
@@ -0,0 +1,84 @@
+/* loop.h - Natural loops and loop-nest forest.
+ * Copyright (C) 2024 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#ifndef WEAK_COMPILER_MIDDLE_END_LOOP_H
+#define WEAK_COMPILER_MIDDLE_END_LOOP_H
+
+#include "middle_end/ir/ir_ops.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+struct ir_fn_decl;
+struct ir_loop;
+
+typedef vector_t(struct ir_loop *) ir_loop_vector_t;
+
+/** Natural loop. Loops with the same header are merged. */
+struct ir_loop {
+    /** The only entry of loop. Dominates all its statements. */
+    struct ir_node   *header;
+    /** Sources of back edges to header. */
+    ir_vector_t       latches;
+    /** Statements outside of loop, to which control goes
+        from the loop. */
+    ir_vector_t       exits;
+    /** The only predecessor of header outside of loop, if
+        header is its only successor. NULL otherwise. */
+    struct ir_node   *preheader;
+    /** All statements of loop including nested loops, in
+        order of IR list. Phi nodes are not included. */
+    ir_vector_t       stmts;
+    /** Enclosing loop or NULL for outermost loop. */
+    struct ir_loop   *parent;
+    /** Immediately nested loops. */
+    ir_loop_vector_t  children;
+    /** 1 for outermost loop. */
+    uint64_t          depth;
+};
+
+/** Find natural loops using back edges (edges to dominator)
+    and build loop-nest forest. Outermost loops are stored
+    in `decl->loops`, innermost loop of each statement in
+    its `loop` field. Previous forest is freed.
+
+    \pre CFG and dominator tree are built. */
+void ir_loops_build(struct ir_fn_decl *decl);
+
+/** Free loop-nest forest of \p decl. */
+void ir_loops_cleanup(struct ir_fn_decl *decl);
+
+/** Innermost loop containing \p ir or NULL. */
+struct ir_loop *ir_loop_of(struct ir_node *ir);
+
+/** Outermost loop containing \p ir or NULL. */
+struct ir_loop *ir_loop_outermost(struct ir_node *ir);
+
+/** Judge if \p ir is inside \p loop (possibly, in nested loop). */
+bool ir_loop_contains(struct ir_loop *loop, struct ir_node *ir);
+
+/** Loop nesting depth of \p ir. 0 if \p ir is not in loop. */
+uint64_t ir_loop_depth(struct ir_node *ir);
+
+/** The only statement outside of \p loop, from which control
+    goes to header, if new statements can be placed between
+    it and header. NULL otherwise. */
+struct ir_node *ir_loop_entry(struct ir_fn_decl *decl, struct ir_loop *loop);
+
+/** Link \p stmts (not in the list yet) in given order right
+    before the header of \p loop, so they are executed once
+    on the way from \p entry to the loop. Jump from \p entry
+    and operands of header phi nodes are updated.
+
+    \pre \p entry is given by ir_loop_entry().
+    \note CFG should be built again after this. */
+void ir_loop_entry_insert(
+    struct ir_fn_decl *decl,
+    struct ir_loop    *loop,
+    struct ir_node    *entry,
+    ir_vector_t       *stmts
+);
+
+#endif // WEAK_COMPILER_MIDDLE_END_LOOP_H
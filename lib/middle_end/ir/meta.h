@@ -23,9 +23,7 @@ struct meta {
     union {
         /** Variable information. */
         struct {
-            bool    loop;
             bool    noalias;
-            int32_t loop_idx;
         } sym;
 
         /** Function information. */
@@ -35,25 +33,10 @@ struct meta {
     };
 
     /** Depth of current block. Needed to handle
-        nested code blocks inside '{' and '}' in optimizations. */
-    uint64_t block_depth;
-
-    /** Most outer loop index. Needed to know when
-        to stop optimizing algorithms in case when
-        loops are placed close. Without it
-        we could incorrectly think, that shown below
-        3 while's is the same loop because of same
-        loop depth.
-
-        while (a) { ... } /< Loop depth = 1
-        <<< separator >>>
+        nested code blocks inside '{' and '}' in optimizations.
 
-        while (b) { ... } /< Loop depth = 1
-        <<< separator >>>
-
-        while (c) { ... } /< Loop depth = 1
-        <<< separator >>> */
-    uint64_t global_loop_idx;
+        \note Loops are found by CFG analysis, see loop.h. */
+    uint64_t block_depth;
 };
 
 #endif // WEAK_COMPILER_MIDDLE_END_META_H
@@ -5,312 +5,1042 @@
  */
 
 #include "middle_end/ir/regalloc.h"
+#include "middle_end/ir/dom.h"
+#include "middle_end/ir/gen.h"
 #include "middle_end/ir/ir.h"
+#include "middle_end/ir/ir_ops.h"
+#include "middle_end/ir/loop.h"
+#include "util/hashmap.h"
+#include "util/vector.h"
 #include <assert.h>
 #include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 
-/**********************************************
- **       Graph-coloring allocator           **
- **********************************************/
+/* Iterated register coalescing (George, Appel, 1996) on
+   top of Chaitin-Briggs allocator.
+
+   Nodes of interference graph are scalar variables, whose
+   address is never taken. Edges are computed from liveness
+   of variables at each CFG statement. Copies `a = b` are
+   coalesced if this does not make graph uncolorable
+   (Briggs and George conservative tests).
+
+   Spilled variable lives in its stack slot. Each use is
+   preceded by load into new short-lived variable, each
+   definition is followed by store from such variable.
+   Variables, defined once by immediate value, are not
+   loaded, but computed again before each use. After spill
+   code is inserted, allocation is repeated. */
 
 /* This sets theoretically possible size of registers and
    variables for static arrays. */
 #define REG_ALLOC_VARS_LIMIT 512
 #define REG_ALLOC_REGS_LIMIT  32
+#define REG_ALLOC_ROUNDS       8
+#define LIVE_WORDS           (REG_ALLOC_VARS_LIMIT / 64)
 
-static uint64_t reg_alloc_max_regs =  -1;
+typedef vector_t(uint64_t) idx_vector_t;
+typedef uint64_t           live_set_t[LIVE_WORDS];
 
-struct interference_graph {
-    int graph[REG_ALLOC_VARS_LIMIT][REG_ALLOC_VARS_LIMIT];
-    int degree[REG_ALLOC_VARS_LIMIT];
+enum node_state {
+    NODE_NONE,
+    NODE_SIMPLIFY,
+    NODE_FREEZE,
+    NODE_SPILL,
+    NODE_SPILLED,
+    NODE_COALESCED,
+    NODE_COLORED,
+    NODE_SELECT
 };
 
-struct live_range {
-    int start;
-    int end;
+enum move_state {
+    MOVE_WORKLIST,
+    MOVE_ACTIVE,
+    MOVE_COALESCED,
+    MOVE_CONSTRAINED,
+    MOVE_FROZEN
 };
 
-struct live_range_info {
-    struct live_range ranges[REG_ALLOC_VARS_LIMIT];
-    int               count;
+struct move {
+    uint64_t        dst;
+    uint64_t        src;
+    enum move_state state;
+};
+
+struct var {
+    /** Scalar variable, whose address is never taken. */
+    bool            candidate;
+    /** Spilled by previous round. Lives in memory. */
+    bool            memory;
+    /** Created by spill code. Is never spilled again. */
+    bool            temp;
+    struct ir_node *alloca;
+    /** Number of definitions and the last one. */
+    uint64_t        defs;
+    struct ir_node *def;
+    /** Defined once by immediate value. */
+    bool            remat;
+
+    enum node_state state;
+    uint64_t        degree;
+    uint64_t        alias;
+    int             color;
+    /** Uses and definitions weighted by loop depth. */
+    double          cost;
+    idx_vector_t    adj;
+    idx_vector_t    moves;
+
+    /** Live interval [start, end] in statements order. Since
+        `split` variable is kept in memory. */
+    uint64_t        start;
+    uint64_t        end;
+    uint64_t        split;
+    /** Any occurrence of variable. */
+    struct ir_node *sym;
 };
 
-struct reg_allocator {
-    int  color[REG_ALLOC_VARS_LIMIT];
-    bool spill[REG_ALLOC_VARS_LIMIT];
-    int  reg_free[REG_ALLOC_REGS_LIMIT];
+struct stmt_info {
+    struct ir_node *ir;
+    live_set_t      use;
+    uint64_t        def;
+    live_set_t      in;
+    live_set_t      out;
 };
 
-static void reg_alloc_add_edge(struct interference_graph *g, int u, int v)
+static const struct ir_reg_file *reg_file;
+static uint64_t                  regs;
+static uint64_t                  vars_count;
+static struct var                vars[REG_ALLOC_VARS_LIMIT];
+static bool                      adj_set[REG_ALLOC_VARS_LIMIT][REG_ALLOC_VARS_LIMIT];
+static vector_t(struct move)     moves;
+static vector_t(struct stmt_info) stmts;
+static idx_vector_t              select_stack;
+/* Key:   statement
+   Value: index in `stmts` */
+static hashmap_t                 stmt_idx;
+
+/**********************************************
+ **              Live sets                   **
+ **********************************************/
+
+really_inline static void live_add(live_set_t set, uint64_t idx)
 {
-    if (!g->graph[u][v]) {
-        g->graph[u][v] = 1;
-        g->graph[v][u] = 1;
-        g->degree[u]++;
-        g->degree[v]++;
-    }
+    set[idx / 64] |= 1ULL << (idx % 64);
+}
+
+really_inline static void live_del(live_set_t set, uint64_t idx)
+{
+    set[idx / 64] &= ~(1ULL << (idx % 64));
+}
+
+really_inline static bool live_has(live_set_t set, uint64_t idx)
+{
+    return set[idx / 64] & (1ULL << (idx % 64));
+}
+
+static bool candidate_sym(struct ir_node *ir)
+{
+    if (ir->type != IR_SYM)
+        return 0;
+
+    struct ir_sym *sym = ir->ir;
+
+    return sym->idx < REG_ALLOC_VARS_LIMIT && vars[sym->idx].candidate;
+}
+
+static void use_collect(struct ir_node *sym, void *data)
+{
+    if (candidate_sym(sym))
+        live_add(data, ((struct ir_sym *) sym->ir)->idx);
 }
 
-static void reg_alloc_build_graph(struct interference_graph *g, struct live_range_info *info)
+static uint64_t def_of(struct ir_node *ir)
 {
-    for (uint64_t i = 0; i < info->count; ++i) {
-        for (uint64_t j = i + 1; j < info->count; ++j) {
-            if (info->ranges[i].start <= info->ranges[j].end &&
-                info->ranges[j].start <= info->ranges[i].end)
-                reg_alloc_add_edge(g, i, j);
+    struct ir_node *def = ir_def(ir);
+
+    if (!def || !candidate_sym(def))
+        return UINT64_MAX;
+
+    return ((struct ir_sym *) def->ir)->idx;
+}
+
+static void liveness(struct ir_fn_decl *decl)
+{
+    bool changed = 1;
+
+    vector_clear(stmts);
+    hashmap_reset(&stmt_idx, 256);
+
+    for (struct ir_node *it = decl->body; it; it = it->next) {
+        if (it->type == IR_PHI)
+            continue;
+
+        struct stmt_info info = {.ir = it};
+
+        ir_foreach_use(it, use_collect, info.use);
+        info.def = def_of(it);
+
+        hashmap_put(&stmt_idx, (uint64_t) it, stmts.count);
+        vector_push_back(stmts, info);
+    }
+
+    while (changed) {
+        changed = 0;
+
+        vector_foreach_back(stmts, i) {
+            struct stmt_info *info = &vector_at(stmts, i);
+            live_set_t        in   = {0};
+
+            vector_foreach(info->ir->cfg.succs, j) {
+                bool     ok   = 0;
+                uint64_t succ = hashmap_get(&stmt_idx, (uint64_t) vector_at(info->ir->cfg.succs, j), &ok);
+
+                if (!ok)
+                    continue;
+
+                for (uint64_t w = 0; w < LIVE_WORDS; ++w)
+                    info->out[w] |= vector_at(stmts, succ).in[w];
+            }
+
+            memcpy(in, info->out, sizeof (live_set_t));
+
+            if (info->def != UINT64_MAX)
+                live_del(in, info->def);
+
+            for (uint64_t w = 0; w < LIVE_WORDS; ++w)
+                in[w] |= info->use[w];
+
+            if (memcmp(in, info->in, sizeof (live_set_t))) {
+                memcpy(info->in, in, sizeof (live_set_t));
+                changed = 1;
+            }
         }
     }
 }
 
-static void reg_alloc(struct interference_graph *g, struct reg_allocator *allocator)
+/**********************************************
+ **           Interference graph             **
+ **********************************************/
+
+static void add_edge(uint64_t u, uint64_t v)
+{
+    if (u == v || adj_set[u][v])
+        return;
+
+    adj_set[u][v] = 1;
+    adj_set[v][u] = 1;
+
+    vector_push_back(vars[u].adj, v);
+    vector_push_back(vars[v].adj, u);
+    ++vars[u].degree;
+    ++vars[v].degree;
+}
+
+static bool move_of(struct ir_node *ir, uint64_t *dst, uint64_t *src)
 {
-    for (uint64_t i = 0; i < REG_ALLOC_VARS_LIMIT; ++i) {
-        allocator->color[i] = -1;
-        allocator->spill[i] =  0;
+    if (ir->type != IR_STORE)
+        return 0;
+
+    struct ir_store *store = ir->ir;
+
+    if (!candidate_sym(store->idx) || !candidate_sym(store->body))
+        return 0;
+
+    struct ir_sym *lhs = store->idx->ir;
+    struct ir_sym *rhs = store->body->ir;
+
+    if (lhs->deref || rhs->deref || rhs->addr_of || lhs->idx == rhs->idx)
+        return 0;
+
+    *dst = lhs->idx;
+    *src = rhs->idx;
+    return 1;
+}
+
+static double weight(struct ir_node *ir, bool loops)
+{
+    double   w     = 1.0;
+    uint64_t depth = loops ? ir_loop_depth(ir) : 0;
+
+    for (uint64_t i = 0; i < depth && i < 6; ++i)
+        w *= 10.0;
+
+    return w;
+}
+
+static void costs_compute(struct ir_fn_decl *decl)
+{
+    /* Dominator tree is limited by statements count. */
+    bool loops = stmts.count < 500;
+
+    if (loops) {
+        ir_dominator_tree(decl);
+        ir_loops_build(decl);
     }
 
-    bool available[REG_ALLOC_REGS_LIMIT] = {0};
+    vector_foreach(stmts, i) {
+        struct stmt_info *info = &vector_at(stmts, i);
+        double            w    = weight(info->ir, loops);
 
-    for (uint64_t i = 0; i < REG_ALLOC_VARS_LIMIT; ++i) {
-        for (uint64_t j = 0; j < reg_alloc_max_regs; ++j) {
-            available[j] = 1;
-        }
+        for (uint64_t v = 0; v < vars_count; ++v)
+            if (live_has(info->use, v))
+                vars[v].cost += w;
 
-        for (uint64_t j = 0; j < REG_ALLOC_VARS_LIMIT; ++j) {
-            if (g->graph[i][j] && allocator->color[j] != -1)
-                available[allocator->color[j]] = 0;
+        if (info->def != UINT64_MAX) {
+            vars[info->def].cost += w;
+            vars[info->def].def   = info->ir;
+            ++vars[info->def].defs;
         }
+    }
 
-        int reg = -1;
-        for (uint64_t j = 0; j < reg_alloc_max_regs; ++j) {
-            if (available[j]) {
-                reg = j;
-                break;
-            }
+    if (loops)
+        ir_loops_cleanup(decl);
+}
+
+static void build(struct ir_fn_decl *decl)
+{
+    vector_foreach(stmts, i) {
+        struct stmt_info *info = &vector_at(stmts, i);
+        live_set_t        live = {0};
+        uint64_t          dst  = 0;
+        uint64_t          src  = 0;
+
+        memcpy(live, info->out, sizeof (live_set_t));
+
+        if (move_of(info->ir, &dst, &src)) {
+            struct move move = {
+                .dst   = dst,
+                .src   = src,
+                .state = MOVE_WORKLIST
+            };
+
+            live_del(live, src);
+            vector_push_back(vars[dst].moves, moves.count);
+            vector_push_back(vars[src].moves, moves.count);
+            vector_push_back(moves, move);
         }
 
-        if (reg != -1)
-            allocator->color[i] = reg;
-        else
-            allocator->spill[i] = 1;
+        if (info->def == UINT64_MAX)
+            continue;
+
+        for (uint64_t v = 0; v < vars_count; ++v)
+            if (live_has(live, v))
+                add_edge(info->def, v);
     }
+
+    /* Arguments are defined together on function entry. */
+    if (stmts.count == 0)
+        return;
+
+    live_set_t entry = {0};
+
+    memcpy(entry, vector_at(stmts, 0).in, sizeof (live_set_t));
+
+    for (struct ir_node *it = decl->args; it; it = it->next) {
+        uint64_t idx = ((struct ir_alloca *) it->ir)->idx;
+
+        if (idx < REG_ALLOC_VARS_LIMIT && vars[idx].candidate)
+            live_add(entry, idx);
+    }
+
+    for (uint64_t u = 0; u < vars_count; ++u)
+        for (uint64_t v = u + 1; v < vars_count; ++v)
+            if (live_has(entry, u) && live_has(entry, v))
+                add_edge(u, v);
 }
 
 /**********************************************
- **        Allocator initialization          **
+ **        Iterated register coalescing      **
  **********************************************/
 
-static void reg_alloc_store_op_idx(struct ir_node *ir, int *lhs, int *rhs)
+static bool active(uint64_t n)
 {
-    *lhs = -1;
-    *rhs = -1;
+    return vars[n].state != NODE_SELECT && vars[n].state != NODE_COALESCED;
+}
 
-    switch (ir->type) {
-    case IR_SYM: {
-        struct ir_sym *sym = ir->ir;
-        *lhs = sym->idx;
-        break;
+static bool move_active(uint64_t m)
+{
+    enum move_state state = vector_at(moves, m).state;
+
+    return state == MOVE_ACTIVE || state == MOVE_WORKLIST;
+}
+
+static bool move_related(uint64_t n)
+{
+    vector_foreach(vars[n].moves, i)
+        if (move_active(vector_at(vars[n].moves, i)))
+            return 1;
+
+    return 0;
+}
+
+static uint64_t alias(uint64_t n)
+{
+    while (vars[n].state == NODE_COALESCED)
+        n = vars[n].alias;
+
+    return n;
+}
+
+static void enable_moves(uint64_t n)
+{
+    vector_foreach(vars[n].moves, i) {
+        struct move *move = &vector_at(moves, vector_at(vars[n].moves, i));
+
+        if (move->state == MOVE_ACTIVE)
+            move->state = MOVE_WORKLIST;
     }
-    case IR_BIN: {
-        struct ir_bin *bin = ir->ir;
+}
 
-        if (bin->lhs->type == IR_SYM) {
-            struct ir_sym *sym = bin->lhs->ir;
-            *lhs = sym->idx;
-        }
+static void decrement_degree(uint64_t m)
+{
+    uint64_t d = vars[m].degree--;
+
+    if (d != regs || vars[m].state != NODE_SPILL)
+        return;
+
+    enable_moves(m);
+
+    vector_foreach(vars[m].adj, i) {
+        uint64_t n = vector_at(vars[m].adj, i);
+        if (active(n))
+            enable_moves(n);
+    }
+
+    vars[m].state = move_related(m) ? NODE_FREEZE : NODE_SIMPLIFY;
+}
 
-        if (bin->rhs->type == IR_SYM) {
-            struct ir_sym *sym = bin->rhs->ir;
-            *rhs = sym->idx;
+static void make_worklist()
+{
+    for (uint64_t n = 0; n < vars_count; ++n) {
+        if (!vars[n].candidate)
+            continue;
+
+        if (vars[n].degree >= regs)
+            vars[n].state = NODE_SPILL;
+        else if (move_related(n))
+            vars[n].state = NODE_FREEZE;
+        else
+            vars[n].state = NODE_SIMPLIFY;
+    }
+}
+
+static bool pick(enum node_state state, uint64_t *out)
+{
+    for (uint64_t n = 0; n < vars_count; ++n) {
+        if (vars[n].candidate && vars[n].state == state) {
+            *out = n;
+            return 1;
         }
+    }
 
-        break;
+    return 0;
+}
+
+static void simplify(uint64_t n)
+{
+    vars[n].state = NODE_SELECT;
+    vector_push_back(select_stack, n);
+
+    vector_foreach(vars[n].adj, i) {
+        uint64_t m = vector_at(vars[n].adj, i);
+        if (active(m))
+            decrement_degree(m);
     }
-    default:
-        break;
+}
+
+static void add_worklist(uint64_t u)
+{
+    if (vars[u].state == NODE_FREEZE && !move_related(u) && vars[u].degree < regs)
+        vars[u].state = NODE_SIMPLIFY;
+}
+
+/* Briggs: node made by combining has fewer than K
+   neighbors of significant degree. */
+static bool briggs(uint64_t u, uint64_t v)
+{
+    uint64_t k = 0;
+
+    for (uint64_t n = 0; n < vars_count; ++n) {
+        if (!vars[n].candidate || !active(n))
+            continue;
+
+        if ((adj_set[u][n] || adj_set[v][n]) && vars[n].degree >= regs)
+            ++k;
     }
+
+    return k < regs;
 }
 
-static void reg_alloc_live_range_store(struct live_range_info *info, struct ir_node *ir)
+/* George: each neighbor of v either already interferes
+   with u or has insignificant degree. */
+static bool george(uint64_t u, uint64_t v)
 {
-    struct ir_store *store = ir->ir;
-    assert(store->idx->type == IR_SYM);
+    vector_foreach(vars[v].adj, i) {
+        uint64_t t = vector_at(vars[v].adj, i);
 
-    struct ir_sym *sym = store->idx->ir;
-    int            res = sym->idx;
-    int            i   = ir->instr_idx; /* Usage place in code. */
-    int            lhs = 0;
-    int            rhs = 0;
+        if (active(t) && vars[t].degree >= regs && !adj_set[t][u])
+            return 0;
+    }
+
+    return 1;
+}
 
-    reg_alloc_store_op_idx(store->body, &lhs, &rhs);
+static void combine(uint64_t u, uint64_t v)
+{
+    vars[v].state = NODE_COALESCED;
+    vars[v].alias = u;
 
-    /* Result. */
-    if (info->ranges[res].start == -1) {
-        info->ranges[res].start = i;
+    vector_foreach(vars[v].moves, i)
+        vector_push_back(vars[u].moves, vector_at(vars[v].moves, i));
+
+    enable_moves(v);
+
+    vector_foreach(vars[v].adj, i) {
+        uint64_t t = vector_at(vars[v].adj, i);
+
+        if (!active(t))
+            continue;
+
+        add_edge(t, u);
+        decrement_degree(t);
     }
-    info->ranges[res].end = i;
 
-    /* Left argument. */
-    if (lhs != -1) {
-        if (info->ranges[lhs].start == -1) {
-            info->ranges[lhs].start = i;
+    if (vars[u].degree >= regs && vars[u].state == NODE_FREEZE)
+        vars[u].state = NODE_SPILL;
+}
+
+static void coalesce(struct move *move)
+{
+    uint64_t u = alias(move->dst);
+    uint64_t v = alias(move->src);
+
+    /* Spill temporary never represents coalesced
+       node, otherwise node would become unspillable. */
+    if (vars[u].temp) {
+        uint64_t t = u;
+        u = v;
+        v = t;
+    }
+
+    if (u == v) {
+        move->state = MOVE_COALESCED;
+        add_worklist(u);
+    } else if (adj_set[u][v]) {
+        move->state = MOVE_CONSTRAINED;
+        add_worklist(u);
+        add_worklist(v);
+    } else if (george(u, v) || briggs(u, v)) {
+        move->state = MOVE_COALESCED;
+        combine(u, v);
+        add_worklist(u);
+    } else {
+        move->state = MOVE_ACTIVE;
+    }
+}
+
+static void freeze_moves(uint64_t u)
+{
+    vector_foreach(vars[u].moves, i) {
+        struct move *move = &vector_at(moves, vector_at(vars[u].moves, i));
+
+        if (!move_active(move - moves.data))
+            continue;
+
+        uint64_t x = alias(move->dst);
+        uint64_t y = alias(move->src);
+        uint64_t v = y == alias(u) ? x : y;
+
+        move->state = MOVE_FROZEN;
+
+        if (vars[v].state == NODE_FREEZE && !move_related(v) && vars[v].degree < regs)
+            vars[v].state = NODE_SIMPLIFY;
+    }
+}
+
+static void freeze(uint64_t u)
+{
+    vars[u].state = NODE_SIMPLIFY;
+    freeze_moves(u);
+}
+
+/* Chaitin: cheapest to spill is the one with the least
+   cost to degree ratio. */
+static void select_spill()
+{
+    uint64_t best = UINT64_MAX;
+
+    for (uint64_t n = 0; n < vars_count; ++n) {
+        if (!vars[n].candidate || vars[n].state != NODE_SPILL)
+            continue;
+
+        if (best == UINT64_MAX) {
+            best = n;
+            continue;
+        }
+
+        if (vars[n].temp != vars[best].temp) {
+            if (vars[best].temp)
+                best = n;
+            continue;
         }
-        info->ranges[lhs].end = i;
+
+        if (vars[n].cost * vars[best].degree < vars[best].cost * vars[n].degree)
+            best = n;
     }
 
-    /* Right argument. */
-    if (rhs != -1) {
-        if (info->ranges[rhs].start == -1) {
-            info->ranges[rhs].start = i;
+    vars[best].state = NODE_SIMPLIFY;
+    freeze_moves(best);
+}
+
+static bool move_pick(struct move **out)
+{
+    vector_foreach(moves, i) {
+        if (vector_at(moves, i).state == MOVE_WORKLIST) {
+            *out = &vector_at(moves, i);
+            return 1;
         }
-        info->ranges[rhs].end = i;
     }
+
+    return 0;
 }
 
-static void reg_alloc_live_ranges(struct live_range_info *info, struct ir_node *ir)
+static void assign_colors()
 {
-    for (uint64_t i = 0; i < REG_ALLOC_VARS_LIMIT; ++i) {
-        info->ranges[i].start = -1;
-        info->ranges[i].end   = -1;
+    while (select_stack.count > 0) {
+        uint64_t n = vector_back(select_stack);
+        bool     used[REG_ALLOC_REGS_LIMIT] = {0};
+
+        vector_pop_back(select_stack);
+
+        vector_foreach(vars[n].adj, i) {
+            uint64_t w = alias(vector_at(vars[n].adj, i));
+
+            if (vars[w].state == NODE_COLORED)
+                used[vars[w].color] = 1;
+        }
+
+        vars[n].state = NODE_SPILLED;
+
+        for (uint64_t c = 0; c < regs; ++c) {
+            if (!used[c]) {
+                vars[n].state = NODE_COLORED;
+                vars[n].color = c;
+                break;
+            }
+        }
     }
 
-    while (ir) {
-        if (ir->type == IR_STORE)
-            reg_alloc_live_range_store(info, ir);
+    for (uint64_t n = 0; n < vars_count; ++n)
+        if (vars[n].state == NODE_COALESCED)
+            vars[n].color = vars[alias(n)].color;
+}
+
+static bool color(struct ir_fn_decl *decl)
+{
+    uint64_t     n    = 0;
+    struct move *move = NULL;
+
+    liveness(decl);
+    costs_compute(decl);
+    build(decl);
+    make_worklist();
 
-        ir = ir->next;
+    while (1) {
+        if (pick(NODE_SIMPLIFY, &n))
+            simplify(n);
+        else if (move_pick(&move))
+            coalesce(move);
+        else if (pick(NODE_FREEZE, &n))
+            freeze(n);
+        else if (pick(NODE_SPILL, &n))
+            select_spill();
+        else
+            break;
     }
 
-    info->count = REG_ALLOC_VARS_LIMIT;
+    assign_colors();
+
+    return !pick(NODE_SPILLED, &n);
 }
 
 /**********************************************
- **       Register -> IR assignment          **
+ **              Spill code                  **
  **********************************************/
 
-static void ir_insert_before(struct ir_node *curr, struct ir_node *new)
+static uint64_t temp_new(struct ir_fn_decl *decl, uint64_t v)
 {
-    struct ir_node *prev = curr->prev;
+    if (vars_count >= REG_ALLOC_VARS_LIMIT)
+        return UINT64_MAX;
+
+    uint64_t          t      = vars_count++;
+    struct ir_alloca *alloca = vars[v].alloca->ir;
+    struct ir_node   *decl_t = ir_alloca_init(alloca->dt, alloca->ptr_depth, t);
 
-    prev->next = new;
-    new->prev = prev;
-    new->next = curr;
-    curr->prev = new;
+    memcpy(&decl_t->meta, &vars[v].alloca->meta, sizeof (struct meta));
+    decl_t->meta.block_depth = 0;
+    ir_insert_before(decl->body, decl_t, &decl->body);
 
-    memcpy(&new->meta, &curr->meta, sizeof (struct meta));
+    vars[t].candidate = 1;
+    vars[t].temp      = 1;
+    vars[t].alloca    = decl_t;
+
+    return t;
 }
 
-static int select_spill_reg(struct reg_allocator *allocator)
+/* Store `dst = src`, where both are copies of `sym` with
+   dereference dropped. */
+static struct ir_node *copy_init(struct ir_node *sym, uint64_t dst, struct ir_node *src)
 {
-    for (int i = 0; i < reg_alloc_max_regs; i++) {
-        if (!allocator->reg_free[i]) {
-            return i;
-        }
+    struct ir_node *idx = ir_node_copy(sym);
+    struct ir_sym  *lhs = idx->ir;
+
+    lhs->idx     = dst;
+    lhs->deref   = 0;
+    lhs->addr_of = 0;
+
+    if (src->type == IR_SYM)
+        ((struct ir_sym *) src->ir)->deref = 0;
+
+    return ir_store_init(idx, src);
+}
+
+static bool spilled(uint64_t v)
+{
+    return vars[v].candidate && vars[v].state == NODE_SPILLED;
+}
+
+static bool rematerializable(uint64_t v)
+{
+    if (vars[v].defs != 1)
+        return 0;
+
+    struct ir_store *store = vars[v].def->ir;
+
+    return store->body->type == IR_IMM;
+}
+
+/* Definitions are removed while spilling, so immediates
+   are remembered before. */
+static void remat_collect()
+{
+    for (uint64_t v = 0; v < vars_count; ++v) {
+        vars[v].remat = spilled(v) && rematerializable(v);
+
+        if (vars[v].remat)
+            vars[v].def = ir_node_copy(((struct ir_store *) vars[v].def->ir)->body);
     }
-    return -1;
 }
 
-/** @{                */
-/**    push regN      */
-/**    regN = 0       */
-/**    pop regN       */
-/**                   */
-/** TODO: Update      */
-/**       store index */
-static void put_spill(struct ir_node *ir, struct reg_allocator *allocator, int reg)
+static void spilled_use(struct ir_node *sym, void *data)
 {
-    ir_insert_before(ir, ir_push_init(reg));
-    /* TODO: Correct mark spill. */
-    allocator->reg_free[reg] = 1;
+    if (candidate_sym(sym) && spilled(((struct ir_sym *) sym->ir)->idx))
+        vector_push_back(*(ir_vector_t *) data, sym);
 }
 
-static void put_reload(struct ir_node *ir, struct reg_allocator *allocator, int reg)
+static void link_before(struct ir_fn_decl *decl, struct ir_node *stmt, ir_vector_t *new)
 {
-    ir_insert_before(ir, ir_pop_init(reg));
-    /* TODO: Correct mark spill. */
-    allocator->reg_free[reg] = 0;
+    if (new->count == 0)
+        return;
+
+    struct ir_node *first = vector_at(*new, 0);
+
+    vector_foreach(stmt->cfg.preds, i) {
+        struct ir_node *pred = vector_at(stmt->cfg.preds, i);
+
+        if (pred->type == IR_JUMP && ((struct ir_jump *) pred->ir)->target == stmt)
+            ((struct ir_jump *) pred->ir)->target = first;
+
+        if (pred->type == IR_COND && ((struct ir_cond *) pred->ir)->target == stmt)
+            ((struct ir_cond *) pred->ir)->target = first;
+    }
+
+    vector_foreach(*new, i) {
+        struct ir_node *it = vector_at(*new, i);
+
+        memcpy(&it->meta, &stmt->meta, sizeof (struct meta));
+        ir_insert_before(stmt, it, &decl->body);
+    }
 }
-/** @} */
 
-/* TODO: Insert push and pop before and after live range bounds? */
-/* TODO: What if one variable has two non-intersecting lifetimes? */
-static void handle_spill(
-    struct ir_node         *parent,
-    struct ir_node         *ir,
-    struct reg_allocator   *allocator,
-    struct live_range_info *live_range
-) {
-    if (ir->type != IR_SYM)
+static void stmt_unlink(struct ir_fn_decl *decl, struct ir_node *stmt)
+{
+    vector_foreach(stmt->cfg.preds, i) {
+        struct ir_node *pred = vector_at(stmt->cfg.preds, i);
+
+        if (pred->type == IR_JUMP && ((struct ir_jump *) pred->ir)->target == stmt)
+            ((struct ir_jump *) pred->ir)->target = stmt->next;
+
+        if (pred->type == IR_COND && ((struct ir_cond *) pred->ir)->target == stmt)
+            ((struct ir_cond *) pred->ir)->target = stmt->next;
+    }
+
+    if (stmt->prev)
+        stmt->prev->next = stmt->next;
+    else
+        decl->body = stmt->next;
+
+    stmt->next->prev = stmt->prev;
+    ir_node_cleanup(stmt);
+}
+
+static void spill_uses(struct ir_fn_decl *decl, struct ir_node *stmt)
+{
+    ir_vector_t uses  = {0};
+    ir_vector_t loads = {0};
+    uint64_t    spills[REG_ALLOC_VARS_LIMIT];
+    uint64_t    temps[REG_ALLOC_VARS_LIMIT];
+
+    ir_foreach_use(stmt, spilled_use, &uses);
+
+    vector_foreach(uses, i) {
+        struct ir_node *use = vector_at(uses, i);
+        struct ir_sym  *sym = use->ir;
+        uint64_t        v   = sym->idx;
+        uint64_t        t   = UINT64_MAX;
+
+        /* The same variable can be used twice: `v * v`. */
+        for (uint64_t j = 0; j < i; ++j)
+            if (spills[j] == v)
+                t = temps[j];
+
+        spills[i] = v;
+        temps[i]  = UINT64_MAX;
+
+        if (t == UINT64_MAX) {
+            /* Out of variables. Use reads the stack slot,
+               so definition of the immediate must stay. */
+            if ((t = temp_new(decl, v)) == UINT64_MAX) {
+                if (vars[v].remat) {
+                    ir_node_cleanup(vars[v].def);
+                    vars[v].def   = NULL;
+                    vars[v].remat = 0;
+                }
+                continue;
+            }
+
+            struct ir_node *src = vars[v].remat
+                ? ir_node_copy(vars[v].def)
+                : ir_node_copy(use);
+
+            vector_push_back(loads, copy_init(use, t, src));
+        }
+
+        temps[i] = t;
+        sym->idx = t;
+    }
+
+    link_before(decl, stmt, &loads);
+
+    vector_free(uses);
+    vector_free(loads);
+}
+
+static void spill_def(struct ir_fn_decl *decl, struct ir_node *stmt, ir_vector_t *remats)
+{
+    uint64_t v = def_of(stmt);
+
+    if (v == UINT64_MAX || !spilled(v))
         return;
 
-    if (ir->claimed_reg != IR_NO_CLAIMED_REG)
+    /* Removed after all uses are rewritten. */
+    if (vars[v].remat && stmt->next) {
+        vector_push_back(*remats, stmt);
         return;
+    }
 
-    struct ir_sym *sym = ir->ir;
-    if (allocator->spill[sym->idx]) {
-        int reg_to_spill = select_spill_reg(allocator);
+    uint64_t t = temp_new(decl, v);
 
-        if (reg_to_spill == -1)
-            return;
+    if (t == UINT64_MAX)
+        return;
+
+    struct ir_store *store = stmt->ir;
+    struct ir_node  *value = ir_node_copy(store->idx);
+    struct ir_node  *save  = NULL;
+
+    ((struct ir_sym *) value->ir)->idx = t;
+    save = copy_init(store->idx, v, value);
+    ((struct ir_sym *) store->idx->ir)->idx = t;
+
+    memcpy(&save->meta, &stmt->meta, sizeof (struct meta));
+    ir_insert_after(stmt, save);
+}
+
+static void spill(struct ir_fn_decl *decl)
+{
+    ir_vector_t list   = {0};
+    ir_vector_t remats = {0};
 
-        put_spill(parent, allocator, reg_to_spill);
+    remat_collect();
 
-        allocator->spill[sym->idx] = reg_to_spill;
-        allocator->color[sym->idx] = reg_to_spill;
+    /* Statements are inserted while walking. */
+    for (struct ir_node *it = decl->body; it; it = it->next)
+        if (it->type != IR_PHI)
+            vector_push_back(list, it);
 
-        put_reload(parent->next, allocator, reg_to_spill);
+    vector_foreach(list, i) {
+        struct ir_node *stmt = vector_at(list, i);
 
-        parent->claimed_reg = reg_to_spill;
+        spill_uses(decl, stmt);
+        spill_def(decl, stmt, &remats);
     }
+
+    /* In reverse order, so jump to the first of adjacent
+       definitions is moved past all of them. */
+    for (uint64_t i = remats.count; i-- > 0;) {
+        struct ir_node *stmt = vector_at(remats, i);
+
+        if (vars[def_of(stmt)].remat)
+            stmt_unlink(decl, stmt);
+    }
+
+    for (uint64_t v = 0; v < vars_count; ++v) {
+        if (vars[v].remat)
+            ir_node_cleanup(vars[v].def);
+
+        if (spilled(v)) {
+            vars[v].candidate = 0;
+            vars[v].memory    = 1;
+        }
+    }
+
+    vector_free(list);
+    vector_free(remats);
+
+    ir_renumber(decl->body);
+    ir_cfg_build(decl);
 }
 
-static void reg_alloc_assign_claimed_reg(
-    struct ir_node         *ir,
-    struct reg_allocator   *allocator,
-    struct live_range_info *live_range
-) {
+/**********************************************
+ **              Initialization              **
+ **********************************************/
+
+static void var_decl(struct ir_node *ir)
+{
+    uint64_t idx = 0;
+
+    if (ir->type == IR_ALLOCA) {
+        struct ir_alloca *alloca = ir->ir;
+        idx = alloca->idx;
+
+        if (idx < REG_ALLOC_VARS_LIMIT && alloca->dt != D_T_STRUCT) {
+            vars[idx].candidate = 1;
+            vars[idx].alloca    = ir;
+        }
+    } else if (ir->type == IR_ALLOCA_ARRAY) {
+        idx = ((struct ir_alloca_array *) ir->ir)->idx;
+    } else {
+        return;
+    }
+
+    if (idx + 1 > vars_count)
+        vars_count = idx + 1 > REG_ALLOC_VARS_LIMIT ? REG_ALLOC_VARS_LIMIT : idx + 1;
+}
+
+static void addr_taken(struct ir_node *sym, unused void *data)
+{
+    struct ir_sym *s = sym->ir;
+
+    if (s->addr_of && s->idx < REG_ALLOC_VARS_LIMIT)
+        vars[s->idx].candidate = 0;
+}
+
+static void vars_init(struct ir_fn_decl *decl)
+{
+    memset(vars, 0, sizeof (vars));
+    vars_count = 0;
+
+    for (struct ir_node *it = decl->args; it; it = it->next)
+        var_decl(it);
+
+    for (struct ir_node *it = decl->body; it; it = it->next) {
+        var_decl(it);
+        ir_foreach_use(it, addr_taken, NULL);
+    }
+}
+
+/* Forget graph of the previous round. */
+static void round_reset()
+{
+    for (uint64_t n = 0; n < vars_count; ++n) {
+        struct var *var = &vars[n];
+
+        vector_free(var->adj);
+        vector_free(var->moves);
+
+        var->state  = NODE_NONE;
+        var->degree = 0;
+        var->alias  = 0;
+        var->color  = -1;
+        var->cost   = 0.0;
+        var->defs   = 0;
+        var->def    = NULL;
+        var->remat  = 0;
+        var->start  = 0;
+        var->split  = UINT64_MAX;
+    }
+
+    memset(adj_set, 0, sizeof (adj_set));
+    vector_clear(moves);
+    vector_clear(select_stack);
+}
+
+/**********************************************
+ **       Register -> IR assignment          **
+ **********************************************/
+
+/* Register of variable at statement number `pos`. */
+static void claim_reg(struct ir_node *ir, uint64_t idx, uint64_t pos)
+{
+    if (idx >= REG_ALLOC_VARS_LIMIT || !vars[idx].candidate || vars[idx].color < 0)
+        return;
+
+    if (pos >= vars[idx].split)
+        return;
+
+    int color = vars[idx].color;
+
+    ir->claimed_reg = reg_file->regs ? reg_file->regs[color] : color;
+}
+
+static void claim(struct ir_node *ir, uint64_t pos)
+{
     switch (ir->type) {
-    case IR_SYM: {
-        struct ir_sym *sym = ir->ir;
-        if (!allocator->spill[sym->idx])
-            ir->claimed_reg = allocator->color[sym->idx];
+    case IR_SYM:
+        claim_reg(ir, ((struct ir_sym *) ir->ir)->idx, pos);
         break;
-    }
     case IR_ALLOCA: {
-        struct ir_alloca *alloca = ir->ir;
-        if (!allocator->spill[alloca->idx])
-            ir->claimed_reg = allocator->color[alloca->idx];
+        uint64_t idx = ((struct ir_alloca *) ir->ir)->idx;
+        if (idx < REG_ALLOC_VARS_LIMIT)
+            claim_reg(ir, idx, vars[idx].start);
         break;
     }
     case IR_STORE: {
         struct ir_store *store = ir->ir;
-        reg_alloc_assign_claimed_reg(store->idx, allocator, live_range);
-        reg_alloc_assign_claimed_reg(store->body, allocator, live_range);
-
-        handle_spill(ir, store->idx, allocator, live_range);
+        claim(store->idx, pos);
+        claim(store->body, pos);
         break;
     }
     case IR_BIN: {
         struct ir_bin *bin = ir->ir;
-        reg_alloc_assign_claimed_reg(bin->lhs, allocator, live_range);
-        reg_alloc_assign_claimed_reg(bin->rhs, allocator, live_range);
-
-        handle_spill(bin->parent, bin->lhs, allocator, live_range);
-        handle_spill(bin->parent, bin->rhs, allocator, live_range);
+        claim(bin->lhs, pos);
+        claim(bin->rhs, pos);
         break;
     }
-    case IR_COND: {
-        struct ir_cond *cond = ir->ir;
-        reg_alloc_assign_claimed_reg(cond->cond, allocator, live_range);
-
-        handle_spill(ir, cond->cond, allocator, live_range);
+    case IR_COND:
+        claim(((struct ir_cond *) ir->ir)->cond, pos);
         break;
-    }
     case IR_RET: {
         struct ir_ret *ret = ir->ir;
         if (ret->body)
-            reg_alloc_assign_claimed_reg(ret->body, allocator, live_range);
+            claim(ret->body, pos);
+        break;
+    }
+    case IR_FN_CALL: {
+        struct ir_fn_call *call = ir->ir;
+        for (struct ir_node *arg = call->args; arg; arg = arg->next)
+            claim(arg, pos);
         break;
     }
     default:
@@ -318,14 +1048,291 @@ static void reg_alloc_assign_claimed_reg(
     }
 }
 
-static void reg_alloc_assign_claimed_regs(
-    struct ir_node         *it,
-    struct reg_allocator   *allocator,
-    struct live_range_info *live_range
-) {
+/* Copy between variables, that were coalesced or got the
+   same register by chance, does nothing. */
+static void coalesced_moves_remove(struct ir_fn_decl *decl)
+{
+    struct ir_node *it      = decl->body;
+    bool            removed = 0;
+
     while (it) {
-        reg_alloc_assign_claimed_reg(it, allocator, live_range);
-        it = it->next;
+        struct ir_node *next = it->next;
+        uint64_t        dst  = 0;
+        uint64_t        src  = 0;
+
+        if (next && move_of(it, &dst, &src) &&
+            vars[dst].color >= 0 && vars[dst].color == vars[src].color) {
+            stmt_unlink(decl, it);
+            removed = 1;
+        }
+
+        it = next;
+    }
+
+    if (removed) {
+        ir_renumber(decl->body);
+        ir_cfg_build(decl);
+    }
+}
+
+/**********************************************
+ **          Linear-scan allocator           **
+ **********************************************/
+
+/* Poletto and Sarkar linear scan over conservative live
+   intervals. When no register is free, interval ending
+   last is split at current position: its beginning keeps
+   the register, the rest stays in memory. Values are moved
+   between register and memory on CFG edges, along which
+   location of live variable changes. */
+
+static void interval_extend(uint64_t v, uint64_t pos)
+{
+    if (pos < vars[v].start)
+        vars[v].start = pos;
+
+    if (pos > vars[v].end)
+        vars[v].end = pos;
+}
+
+static void sym_remember(struct ir_node *sym, unused void *data)
+{
+    if (!candidate_sym(sym))
+        return;
+
+    struct var *var = &vars[((struct ir_sym *) sym->ir)->idx];
+
+    if (!var->sym)
+        var->sym = sym;
+}
+
+static void intervals_build(struct ir_fn_decl *decl)
+{
+    for (uint64_t v = 0; v < vars_count; ++v) {
+        vars[v].color = -1;
+        vars[v].start = UINT64_MAX;
+        vars[v].end   = 0;
+        vars[v].split = UINT64_MAX;
+    }
+
+    vector_foreach(stmts, i) {
+        struct stmt_info *info = &vector_at(stmts, i);
+        struct ir_node   *def  = ir_def(info->ir);
+
+        for (uint64_t w = 0; w < LIVE_WORDS; ++w) {
+            uint64_t bits = info->in[w] | info->out[w] | info->use[w];
+
+            while (bits) {
+                interval_extend(w * 64 + __builtin_ctzll(bits), i);
+                bits &= bits - 1;
+            }
+        }
+
+        if (info->def != UINT64_MAX)
+            interval_extend(info->def, i);
+
+        ir_foreach_use(info->ir, sym_remember, NULL);
+
+        if (def)
+            sym_remember(def, NULL);
+    }
+
+    /* Arguments are passed on function entry. */
+    for (struct ir_node *it = decl->args; it; it = it->next) {
+        uint64_t idx = ((struct ir_alloca *) it->ir)->idx;
+
+        if (idx < REG_ALLOC_VARS_LIMIT && vars[idx].candidate)
+            interval_extend(idx, 0);
+    }
+}
+
+static int interval_cmp(const void *lhs, const void *rhs)
+{
+    uint64_t l = *(const uint64_t *) lhs;
+    uint64_t r = *(const uint64_t *) rhs;
+
+    if (vars[l].start != vars[r].start)
+        return vars[l].start < vars[r].start ? -1 : 1;
+
+    return (l > r) - (l < r);
+}
+
+/* Active intervals are sorted by end. */
+static void active_insert(idx_vector_t *active, uint64_t v)
+{
+    uint64_t i = active->count;
+
+    vector_push_back(*active, v);
+
+    for (; i > 0 && vars[vector_at(*active, i - 1)].end > vars[v].end; --i)
+        vector_at(*active, i) = vector_at(*active, i - 1);
+
+    vector_at(*active, i) = v;
+}
+
+static void linear_scan()
+{
+    idx_vector_t order  = {0};
+    idx_vector_t active = {0};
+    bool         busy[REG_ALLOC_REGS_LIMIT] = {0};
+
+    for (uint64_t v = 0; v < vars_count; ++v)
+        if (vars[v].candidate && vars[v].start != UINT64_MAX)
+            vector_push_back(order, v);
+
+    qsort(order.data, order.count, sizeof (uint64_t), interval_cmp);
+
+    vector_foreach(order, i) {
+        uint64_t cur = vector_at(order, i);
+        int      reg = -1;
+
+        while (active.count > 0 && vars[vector_at(active, 0)].end < vars[cur].start) {
+            busy[vars[vector_at(active, 0)].color] = 0;
+            vector_erase(active, 0);
+        }
+
+        for (uint64_t c = 0; c < regs && reg < 0; ++c)
+            if (!busy[c])
+                reg = c;
+
+        if (reg >= 0) {
+            busy[reg]       = 1;
+            vars[cur].color = reg;
+            active_insert(&active, cur);
+            continue;
+        }
+
+        uint64_t victim = vector_back(active);
+
+        /* Current interval ends last, it is not worth
+           taking register from others. */
+        if (vars[victim].end <= vars[cur].end)
+            continue;
+
+        vars[victim].split = vars[cur].start;
+        vars[cur].color    = vars[victim].color;
+
+        vector_pop_back(active);
+        active_insert(&active, cur);
+    }
+
+    vector_free(order);
+    vector_free(active);
+}
+
+static bool in_reg(uint64_t v, uint64_t pos)
+{
+    return vars[v].color >= 0 && pos < vars[v].split;
+}
+
+static struct ir_node *move_init(uint64_t v, bool to_reg)
+{
+    struct ir_node *dst = ir_node_copy(vars[v].sym);
+    struct ir_node *src = ir_node_copy(vars[v].sym);
+    int             reg = vars[v].color;
+
+    if (reg_file->regs)
+        reg = reg_file->regs[reg];
+
+    ((struct ir_sym *) dst->ir)->deref   = 0;
+    ((struct ir_sym *) dst->ir)->addr_of = 0;
+    ((struct ir_sym *) src->ir)->deref   = 0;
+    ((struct ir_sym *) src->ir)->addr_of = 0;
+
+    dst->claimed_reg = to_reg ? reg : IR_NO_CLAIMED_REG;
+    src->claimed_reg = to_reg ? IR_NO_CLAIMED_REG : reg;
+
+    return ir_store_init(dst, src);
+}
+
+/* Stores go first, since loaded variable may take the
+   register of stored one. */
+static void edge_moves(uint64_t from, uint64_t to, ir_vector_t *out)
+{
+    struct stmt_info *info = &vector_at(stmts, to);
+
+    for (uint64_t to_reg = 0; to_reg < 2; ++to_reg) {
+        for (uint64_t v = 0; v < vars_count; ++v) {
+            if (vars[v].split == UINT64_MAX || !live_has(info->in, v))
+                continue;
+
+            if (in_reg(v, from) != in_reg(v, to) && in_reg(v, to) == to_reg)
+                vector_push_back(*out, move_init(v, to_reg));
+        }
+    }
+}
+
+/* Critical edge from condition gets its own block at the
+   end of function. */
+static void edge_block(
+    struct ir_fn_decl *decl,
+    struct ir_node    *cond,
+    struct ir_node    *target,
+    ir_vector_t       *new
+) {
+    struct ir_node *last = decl->body;
+    struct ir_node *jmp  = ir_jump_init(target->instr_idx);
+
+    while (last->next)
+        last = last->next;
+
+    ((struct ir_jump *) jmp->ir)->target = target;
+    vector_push_back(*new, jmp);
+
+    vector_foreach(*new, i) {
+        struct ir_node *it = vector_at(*new, i);
+
+        memcpy(&it->meta, &cond->meta, sizeof (struct meta));
+        ir_insert_after(last, it);
+        last = it;
+    }
+
+    ((struct ir_cond *) cond->ir)->target = vector_at(*new, 0);
+}
+
+static void resolve(struct ir_fn_decl *decl)
+{
+    bool changed = 0;
+
+    vector_foreach(stmts, i) {
+        struct ir_node *from = vector_at(stmts, i).ir;
+
+        vector_foreach(from->cfg.succs, j) {
+            struct ir_node *to  = vector_at(from->cfg.succs, j);
+            ir_vector_t     new = {0};
+            bool            ok  = 0;
+            uint64_t        idx = hashmap_get(&stmt_idx, (uint64_t) to, &ok);
+
+            if (ok)
+                edge_moves(i, idx, &new);
+
+            if (new.count == 0)
+                continue;
+
+            if (from->type == IR_COND && ((struct ir_cond *) from->ir)->target == to) {
+                edge_block(decl, from, to, &new);
+            } else if (from->type == IR_JUMP) {
+                link_before(decl, from, &new);
+            } else {
+                struct ir_node *last = from;
+
+                vector_foreach(new, k) {
+                    struct ir_node *it = vector_at(new, k);
+
+                    memcpy(&it->meta, &from->meta, sizeof (struct meta));
+                    ir_insert_after(last, it);
+                    last = it;
+                }
+            }
+
+            changed = 1;
+            vector_free(new);
+        }
+    }
+
+    if (changed) {
+        ir_renumber(decl->body);
+        ir_cfg_build(decl);
     }
 }
 
@@ -333,39 +1340,61 @@ static void reg_alloc_assign_claimed_regs(
  **                Traversal                 **
  **********************************************/
 
-static void reg_alloc_dump_lifetimes(struct live_range_info *live_range)
+static void reg_alloc_fn(struct ir_fn_decl *decl)
 {
-    for (uint64_t i = 0; i < live_range->count; ++i) {
-        if (live_range->ranges[i].start == -1 ||
-            live_range->ranges[i].end   == -1 )
+    if (!decl->body)
+        return;
+
+    ir_cfg_build(decl);
+    vars_init(decl);
+
+    for (uint64_t round = 0; round < REG_ALLOC_ROUNDS; ++round) {
+        round_reset();
+
+        /* Variables, still spilled after the last round,
+           are left in memory. */
+        if (color(decl) || round + 1 == REG_ALLOC_ROUNDS)
             break;
 
-        printf(
-            "Lifetime for t%-2lu = { %-2d - %-2d }\n",
-            i,
-            live_range->ranges[i].start,
-            live_range->ranges[i].end
-        );
+        spill(decl);
     }
+
+    for (struct ir_node *it = decl->args; it; it = it->next)
+        claim(it, /*pos=*/0);
+
+    for (struct ir_node *it = decl->body; it; it = it->next)
+        claim(it, /*pos=*/0);
+
+    coalesced_moves_remove(decl);
+    round_reset();
 }
 
-static void reg_alloc_fn(struct ir_fn_decl *ir)
+static void reg_alloc_linear_fn(struct ir_fn_decl *decl)
 {
-    /* TODO: function args. */
-    struct interference_graph graph           = {0};
-    struct live_range_info    live_range_info = {0};
-    struct reg_allocator      allocator       = {0};
+    if (!decl->body)
+        return;
+
+    ir_cfg_build(decl);
+    vars_init(decl);
+    liveness(decl);
+    intervals_build(decl);
+    linear_scan();
+
+    for (struct ir_node *it = decl->args; it; it = it->next)
+        claim(it, /*pos=*/0);
+
+    vector_foreach(stmts, i)
+        claim(vector_at(stmts, i).ir, i);
 
-    reg_alloc_live_ranges(&live_range_info, ir->body);
-    reg_alloc_build_graph(&graph, &live_range_info);
-    reg_alloc(&graph, &allocator);
-    reg_alloc_assign_claimed_regs(ir->body, &allocator, &live_range_info);
-    reg_alloc_dump_lifetimes(&live_range_info);
+    resolve(decl);
 }
 
-void ir_reg_alloc(struct ir_unit *unit, uint64_t hardware_regs)
+void ir_reg_alloc(struct ir_unit *unit, const struct ir_reg_file *file)
 {
-    reg_alloc_max_regs = hardware_regs;
+    assert(file->count > 0 && file->count <= REG_ALLOC_REGS_LIMIT);
+
+    reg_file = file;
+    regs     = file->count;
 
     struct ir_node *it = unit->fn_decls;
     while (it) {
@@ -373,4 +1402,27 @@ void ir_reg_alloc(struct ir_unit *unit, uint64_t hardware_regs)
         reg_alloc_fn(decl);
         it = it->next;
     }
-}
\ No newline at end of file
+
+    vector_free(moves);
+    vector_free(stmts);
+    vector_free(select_stack);
+    hashmap_destroy(&stmt_idx);
+}
+
+void ir_reg_alloc_linear(struct ir_unit *unit, const struct ir_reg_file *file)
+{
+    assert(file->count > 0 && file->count <= REG_ALLOC_REGS_LIMIT);
+
+    reg_file = file;
+    regs     = file->count;
+
+    struct ir_node *it = unit->fn_decls;
+    while (it) {
+        struct ir_fn_decl *decl = it->ir;
+        reg_alloc_linear_fn(decl);
+        it = it->next;
+    }
+
+    vector_free(stmts);
+    hashmap_destroy(&stmt_idx);
+}
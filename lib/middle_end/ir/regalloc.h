@@ -11,11 +11,37 @@
 
 struct ir_unit;
 
+/** Target register file. */
+struct ir_reg_file {
+    /** Number of registers available for allocation. */
+    uint64_t   count;
+    /** Hardware numbers of allocatable registers. If NULL,
+        registers are numbered from 0 to count - 1. */
+    const int *regs;
+};
+
 /** Perform register allocation.
 
-    Graph-coloring algorithm is used.
+    Iterated register coalescing graph-coloring algorithm
+    is used. Interference is computed from liveness over CFG,
+    spill costs are weighted by loop depth. Spilled variables
+    are kept in memory and loaded to short-lived variables
+    around each use and definition.
+
+    Variables, which got no register, have `claimed_reg` set
+    to IR_NO_CLAIMED_REG.
+
+    \param file   Registers of target machine. */
+void ir_reg_alloc(struct ir_unit *unit, const struct ir_reg_file *file);
+
+/** Perform fast register allocation.
 
-    \param virtual_regs   Number of avaialble hardware registers. */
-void ir_reg_alloc(struct ir_unit *unit, uint64_t hardware_regs);
+    Linear scan over live intervals is used. It runs in
+    nearly linear time, but gives worse code, than
+    ir_reg_alloc(). When registers are exhausted, interval,
+    which ends last, is split: its rest is kept in memory.
+    Moves between register and memory are inserted on CFG
+    edges, where location of variable changes. */
+void ir_reg_alloc_linear(struct ir_unit *unit, const struct ir_reg_file *file);
 
 #endif // WEAK_COMPILER_MIDDLE_REGALLOC_H
\ No newline at end of file
@@ -8,15 +8,204 @@
 #include "middle_end/ir/ir.h"
 #include "middle_end/ir/dom.h"
 #include "middle_end/ir/gen.h"
-#include "middle_end/ir/ir_dump.h"
 #include "middle_end/ir/ir_ops.h"
 #include "util/alloc.h"
 #include "util/hashmap.h"
 #include "util/vector.h"
 #include <assert.h>
-#include <stdio.h>
 #include <string.h>
 
+/* Only scalar variables, whose address is never taken, are
+   renamed. Arrays and variables accessed through pointers
+   stay in memory.
+
+   Key:   sym_idx
+   Value: dense index of variable */
+static hashmap_t ssa_vars;
+static uint64_t  ssa_vars_count;
+
+static void ssa_vars_collect_alloca(struct ir_node *it)
+{
+    for (; it; it = it->next) {
+        if (it->type != IR_ALLOCA)
+            continue;
+
+        struct ir_alloca *alloca = it->ir;
+        hashmap_put(&ssa_vars, alloca->idx, ssa_vars_count++);
+    }
+}
+
+static void ssa_vars_drop_addr_taken(struct ir_node *sym, unused void *data)
+{
+    struct ir_sym *s = sym->ir;
+
+    if (s->addr_of)
+        hashmap_remove(&ssa_vars, s->idx);
+}
+
+static void ssa_vars_collect(struct ir_fn_decl *decl)
+{
+    hashmap_reset(&ssa_vars, 256);
+    ssa_vars_count = 0;
+
+    ssa_vars_collect_alloca(decl->args);
+    ssa_vars_collect_alloca(decl->body);
+
+    for (struct ir_node *it = decl->body; it; it = it->next)
+        ir_foreach_use(it, ssa_vars_drop_addr_taken, NULL);
+}
+
+static bool ssa_var(struct ir_node *sym)
+{
+    return sym && hashmap_has(&ssa_vars, ((struct ir_sym *) sym->ir)->idx);
+}
+
+static uint64_t ssa_var_id(uint64_t sym_idx)
+{
+    bool     ok = 0;
+    uint64_t id = hashmap_get(&ssa_vars, sym_idx, &ok);
+
+    assert(ok);
+
+    return id;
+}
+
+/**********************************************
+ **        Statements and bit sets           **
+ **********************************************/
+
+static ir_vector_t stmts;
+/* Key:   ir
+   Value: index in `stmts` */
+static hashmap_t   stmt_ids;
+/* Size of each set in words. */
+static uint64_t    set_words;
+
+static void stmts_collect(struct ir_fn_decl *decl)
+{
+    vector_clear(stmts);
+    hashmap_reset(&stmt_ids, 256);
+
+    for (struct ir_node *it = decl->body; it; it = it->next) {
+        if (it->type == IR_PHI)
+            continue;
+
+        hashmap_put(&stmt_ids, (uint64_t) it, stmts.count);
+        vector_push_back(stmts, it);
+    }
+}
+
+static void stmts_destroy()
+{
+    vector_free(stmts);
+    hashmap_destroy(&stmt_ids);
+}
+
+static uint64_t stmt_id(struct ir_node *ir)
+{
+    bool     ok = 0;
+    uint64_t id = hashmap_get(&stmt_ids, (uint64_t) ir, &ok);
+
+    assert(ok);
+
+    return id;
+}
+
+/* Allocate set for each statement. */
+static uint64_t *sets_alloc(uint64_t elems)
+{
+    set_words = (elems + 63) / 64;
+
+    return weak_calloc(stmts.count * set_words + 1, sizeof (uint64_t));
+}
+
+really_inline static uint64_t *set_of(uint64_t *sets, uint64_t stmt)
+{
+    return sets + stmt * set_words;
+}
+
+really_inline static void set_add(uint64_t *set, int64_t v)
+{
+    if (v >= 0)
+        set[v / 64] |= 1ULL << (v % 64);
+}
+
+really_inline static bool set_has(uint64_t *set, uint64_t v)
+{
+    return set[v / 64] & (1ULL << (v % 64));
+}
+
+/**********************************************
+ **         Variables liveness               **
+ **********************************************/
+
+/* Variables live at entry of each statement. Phi node is
+   placed only where its variable is live, otherwise it is
+   never used (pruned SSA). */
+static uint64_t *vars_live_in;
+
+static void var_use_collect(struct ir_node *ir, void *set)
+{
+    if (ssa_var(ir))
+        set_add(set, ssa_var_id(((struct ir_sym *) ir->ir)->idx));
+}
+
+static void vars_liveness_compute()
+{
+    uint64_t *uses = sets_alloc(ssa_vars_count);
+    uint64_t *defs = sets_alloc(ssa_vars_count);
+    uint64_t *out  = weak_calloc(set_words + 1, sizeof (uint64_t));
+    bool      changed = 1;
+
+    vars_live_in = sets_alloc(ssa_vars_count);
+
+    vector_foreach(stmts, i) {
+        struct ir_node *it  = vector_at(stmts, i);
+        struct ir_node *def = ir_def(it);
+
+        ir_foreach_use(it, var_use_collect, set_of(uses, i));
+
+        if (ssa_var(def))
+            set_add(set_of(defs, i), ssa_var_id(((struct ir_sym *) def->ir)->idx));
+    }
+
+    while (changed) {
+        changed = 0;
+
+        vector_foreach_back(stmts, i) {
+            struct ir_node *it  = vector_at(stmts, i);
+            uint64_t       *in  = set_of(vars_live_in, i);
+            uint64_t       *use = set_of(uses, i);
+            uint64_t       *def = set_of(defs, i);
+
+            memset(out, 0, set_words * sizeof (uint64_t));
+
+            vector_foreach(it->cfg.succs, j) {
+                uint64_t *succ_in = set_of(vars_live_in, stmt_id(vector_at(it->cfg.succs, j)));
+
+                for (uint64_t w = 0; w < set_words; ++w)
+                    out[w] |= succ_in[w];
+            }
+
+            for (uint64_t w = 0; w < set_words; ++w) {
+                uint64_t new = use[w] | (out[w] & ~def[w]);
+
+                changed |= new != in[w];
+                in[w] = new;
+            }
+        }
+    }
+
+    weak_free(out);
+    weak_free(defs);
+    weak_free(uses);
+}
+
+static bool var_live_in(struct ir_node *stmt, uint64_t sym_idx)
+{
+    return set_has(set_of(vars_live_in, stmt_id(stmt)), ssa_var_id(sym_idx));
+}
+
 static void assigns_collect(struct ir_fn_decl *decl, hashmap_t *out)
 {
     struct ir_node *it = decl->body;
@@ -24,10 +213,10 @@ static void assigns_collect(struct ir_fn_decl *decl, hashmap_t *out)
     hashmap_reset(out, 256);
 
     while (it) {
-        if (it->type == IR_STORE) {
-            struct ir_store *store = it->ir;
-            assert(store->idx->type == IR_SYM);
-            struct ir_sym *sym = store->idx->ir;
+        struct ir_node *def = ir_def(it);
+
+        if (ssa_var(def)) {
+            struct ir_sym *sym = def->ir;
 
             bool ok = 0;
             uint64_t addr = hashmap_get(out, sym->idx, &ok);
@@ -53,43 +242,31 @@ static void assigns_destroy(hashmap_t *assigns)
     hashmap_foreach(assigns, k, v) {
         (void) k;
         vector_free(*(ir_vector_t *) v);
+        weak_free((ir_vector_t *) v);
     }
     hashmap_destroy(assigns);
 }
 
-/*  TODO: update all links correctly (IR list and CFG).
-
-    (prev    ) -- next --> (curr    )
-    (prev    ) <- prev --- (curr    )
-
-    (prev    ) -- next --> (new     ) -- next --> (curr    )
-    (prev    ) <- prev --- (new     ) <- prev --- (curr    ) */
-static void ir_insert_before(struct ir_node *curr, struct ir_node *new)
+/* Phi node is placed right before its statement, after
+   already inserted phi nodes. It has the same instruction
+   index, since it is not a standalone CFG node. */
+static void phi_put(struct ir_fn_decl *decl, struct ir_node *y, uint64_t sym_idx)
 {
-    struct ir_node *prev = curr->prev;
+    struct ir_node *phi  = ir_phi_init(sym_idx, y->cfg.preds.count);
+    struct ir_phi  *args = phi->ir;
 
-    prev->next = new;
-    new->prev = prev;
-    new->next = curr;
-    curr->prev = new;
+    vector_foreach(y->cfg.preds, i)
+        args->args[i].pred = vector_at(y->cfg.preds, i);
 
-    vector_push_back(prev->cfg.succs, new);
-    vector_push_back(curr->cfg.preds, new);
+    phi->instr_idx = y->instr_idx;
+    phi->cfg_block_no = y->cfg_block_no;
+    memcpy(&phi->meta, &y->meta, sizeof (struct meta));
 
-    /* TODO: Now first SSA renaming algorithm visits
-             statement after phi, then before. Fix it
-             by introducing correct predecessors.
-             Phi node must be the only predecessor of next statement. */
-
-    /* To traverse dominator tree next. */
-    vector_push_back(curr->idom_back, new);
+    ir_insert_before(y, phi, &decl->body);
 }
 
 /* This function implements algorithm given in
-   https://c9x.me/compile/bib/ssa.pdf
-
-   TODO: Fix placement order. Now it pushed to the start
-         of some block. */
+   https://c9x.me/compile/bib/ssa.pdf */
 static void phi_insert(
     struct ir_fn_decl *decl,
     /* Key:   sym_idx
@@ -97,15 +274,15 @@ static void phi_insert(
     hashmap_t *assigns
 ) {
     /* Key:   ir
-       Value: 1 | 0 */
-    hashmap_t       dom_fron_plus = {0};
+       Value: 1 if phi for current symbol is placed */
+    hashmap_t       has_already = {0};
     /* Key:   ir
-       Value: sym_idx */
-    hashmap_t       work          = {0};
-    ir_vector_t     w             = {0};
+       Value: 1 if ir was added to worklist */
+    hashmap_t       work        = {0};
+    ir_vector_t     w           = {0};
 
     hashmap_foreach(assigns, sym_idx, __list) {
-        hashmap_reset(&dom_fron_plus, 256);
+        hashmap_reset(&has_already, 256);
         hashmap_reset(&work, 256);
         /* `w` vector generally can be left uncleared, since algorithm
            assumes that we do something while it not empty. So now it
@@ -113,22 +290,10 @@ static void phi_insert(
 
         ir_vector_t *assign_list = (ir_vector_t *) __list;
 
-        vector_foreach(*assign_list, i) {
-            (void) i;
-            hashmap_put(&work, 0, 0);
-        }
-
-        struct ir_node *it = decl->body;
-        while (it) {
-            hashmap_put(&dom_fron_plus, (uint64_t) it, 0);
-            it = it->next;
-        }
-
         vector_foreach(*assign_list, i) {
             struct ir_node *x = vector_at(*assign_list, i);
-            uint64_t x_addr = (uint64_t) x;
 
-            hashmap_put(&work, x_addr, 1);
+            hashmap_put(&work, (uint64_t) x, 1);
             vector_push_back(w, x);
         }
 
@@ -140,25 +305,19 @@ static void phi_insert(
                 struct ir_node *y = vector_at(x->df, i);
                 uint64_t y_addr = (uint64_t) y;
 
-                bool ok = 0;
-                uint64_t got = hashmap_get(&dom_fron_plus, y_addr, &ok);
-                if (ok && got == 0) {
-                    struct ir_node *phi = ir_phi_init(
-                        sym_idx,
-                        y->instr_idx,
-                        vector_at(y->cfg.preds, 0)->instr_idx
-                    );
-
-                    ir_insert_before(y, phi);
-                    memcpy(&phi->meta, &y->meta, sizeof (struct meta));
-                    hashmap_put(&dom_fron_plus, y_addr, 1);
-
-                    ok = 0;
-                    uint64_t val = hashmap_get(&work, y_addr, &ok);
-                    if (ok && val == 0) {
-                        hashmap_put(&work, (uint64_t) y, 1);
-                        vector_push_back(w, y);
-                    }
+                if (hashmap_has(&has_already, y_addr))
+                    continue;
+
+                hashmap_put(&has_already, y_addr, 1);
+
+                if (!var_live_in(y, sym_idx))
+                    continue;
+
+                phi_put(decl, y, sym_idx);
+
+                if (!hashmap_has(&work, y_addr)) {
+                    hashmap_put(&work, y_addr, 1);
+                    vector_push_back(w, y);
                 }
             }
         }
@@ -166,241 +325,1035 @@ static void phi_insert(
 
     vector_free(w);
     hashmap_destroy(&work);
-    hashmap_destroy(&dom_fron_plus);
+    hashmap_destroy(&has_already);
 }
 
-/* TODO: Replace stack with map (sym_idx, ssa_idx)? */
-typedef hashmap_t ssa_stack_t;
 typedef vector_t(uint64_t) ssa_list_t;
 
-static uint64_t ssa_idx;
+/* Key:   sym_idx
+   Value: ssa_list_t * with SSA indices. Top of the stack
+          is currently visible definition. */
+static hashmap_t ssa_stacks;
+/* Key:   sym_idx
+   Value: next free SSA index */
+static hashmap_t ssa_counters;
 
-ssa_list_t *ssa_stack_get_list(ssa_stack_t *stack, uint64_t sym_idx)
+static ssa_list_t *ssa_stack(uint64_t sym_idx)
 {
     bool ok = 0;
-    ssa_list_t *list = (ssa_list_t *) hashmap_get(stack, sym_idx, &ok);
+    ssa_list_t *list = (ssa_list_t *) hashmap_get(&ssa_stacks, sym_idx, &ok);
+
     if (!ok) {
-        printf("No symbol %lu!\n", sym_idx);
-        return NULL;
+        list = weak_calloc(1, sizeof (*list));
+        hashmap_put(&ssa_stacks, sym_idx, (uint64_t) list);
     }
 
     return list;
 }
 
-ssa_list_t *ssa_stack_put(ssa_stack_t *stack, uint64_t sym_idx)
+/* Returns UINT64_MAX if there is no reaching definition,
+   for example, for function parameters. */
+static uint64_t ssa_top(uint64_t sym_idx)
 {
-    ssa_list_t *list = (ssa_list_t *) weak_calloc(1, sizeof (*list));
+    ssa_list_t *list = ssa_stack(sym_idx);
 
-    hashmap_put(stack, sym_idx, (uint64_t) list);
+    if (list->count == 0)
+        return UINT64_MAX;
 
-    return list;
+    return vector_back(*list);
 }
 
-void ssa_stack_dump(ssa_stack_t *stack)
+static uint64_t ssa_push(uint64_t sym_idx)
 {
-    return;
-    printf("\nSSA stuck dump:\n");
-    hashmap_foreach(stack, sym_idx, ptr) {
-        ssa_list_t *list = (ssa_list_t *) ptr;
-        printf("  symbol %lu: ( ", sym_idx);
-        vector_foreach(*list, i) {
-            printf("%lu ", vector_at(*list, i));
-        }
-        printf(")\n");
+    bool     ok  = 0;
+    uint64_t idx = hashmap_get(&ssa_counters, sym_idx, &ok);
+
+    if (!ok)
+        idx = 0;
+
+    hashmap_put(&ssa_counters, sym_idx, idx + 1);
+    vector_push_back(*ssa_stack(sym_idx), idx);
+
+    return idx;
+}
+
+static void ssa_pop(uint64_t sym_idx)
+{
+    vector_pop_back(*ssa_stack(sym_idx));
+}
+
+static void ssa_stacks_destroy()
+{
+    hashmap_foreach(&ssa_stacks, k, v) {
+        (void) k;
+        vector_free(*(ssa_list_t *) v);
+        weak_free((ssa_list_t *) v);
     }
+    hashmap_destroy(&ssa_stacks);
+    hashmap_destroy(&ssa_counters);
 }
 
-static void ssa_rename_sym(struct ir_node *ir, uint64_t sym_idx, ssa_stack_t *stack)
+static struct ir_node *phi_first(struct ir_node *stmt)
 {
-    if (ir->type != IR_SYM)
-        return;
+    while (stmt->prev && stmt->prev->type == IR_PHI)
+        stmt = stmt->prev;
 
+    return stmt;
+}
+
+static void ssa_rename_use(struct ir_node *ir, unused void *data)
+{
     struct ir_sym *sym = ir->ir;
-    if (sym->idx == sym_idx) {
-        ssa_list_t *list = ssa_stack_get_list(stack, sym_idx);
-        sym->ssa_idx = vector_back(*list);
-        ssa_idx = sym->ssa_idx;
+
+    if (ssa_var(ir))
+        sym->ssa_idx = ssa_top(sym->idx);
+}
+
+/* Fill operands of phi nodes of `succ`, which are
+   incoming from `ir`. */
+static void ssa_rename_phi_args(struct ir_node *ir, struct ir_node *succ)
+{
+    for (struct ir_node *it = phi_first(succ); it != succ; it = it->next) {
+        struct ir_phi *phi = it->ir;
+
+        for (uint64_t i = 0; i < phi->args_size; ++i)
+            if (phi->args[i].pred == ir)
+                phi->args[i].ssa_idx = (int64_t) ssa_top(phi->sym_idx);
     }
+}
 
-    ssa_stack_dump(stack);
+static void ssa_rename(struct ir_node *ir)
+{
+    /* Symbols defined in this statement. Popped after
+       dominator tree children are visited. */
+    vector_t(uint64_t) defs = {0};
+
+    /* 1. Phi nodes define new versions before statement. */
+    for (struct ir_node *it = phi_first(ir); it != ir; it = it->next) {
+        struct ir_phi *phi = it->ir;
+        phi->ssa_idx = ssa_push(phi->sym_idx);
+        vector_push_back(defs, phi->sym_idx);
+    }
+
+    /* 2. Uses are renamed to currently visible definitions,
+          then assigned symbol gets new version. */
+    ir_foreach_use(ir, ssa_rename_use, NULL);
+
+    struct ir_node *def = ir_def(ir);
+    if (ssa_var(def)) {
+        struct ir_sym *sym = def->ir;
+        sym->ssa_idx = ssa_push(sym->idx);
+        vector_push_back(defs, sym->idx);
+    }
+
+    /* 3. Operands of phi nodes in CFG successors. */
+    vector_foreach(ir->cfg.succs, i)
+        ssa_rename_phi_args(ir, vector_at(ir->cfg.succs, i));
+
+    /* 4. Call recursive for dominator tree children. */
+    vector_foreach(ir->idom_back, i)
+        ssa_rename(vector_at(ir->idom_back, i));
+
+    /* 5. Pop from stack for current assignments. */
+    vector_foreach(defs, i)
+        ssa_pop(vector_at(defs, i));
+
+    vector_free(defs);
 }
 
-static void ssa_rename_bin(struct ir_node *ir, uint64_t sym_idx, ssa_stack_t *stack)
+void ir_compute_ssa(struct ir_node *decls)
 {
-    struct ir_bin *bin = ir->ir;
-    ssa_rename_sym(bin->lhs, sym_idx, stack);
-    ssa_rename_sym(bin->rhs, sym_idx, stack);
+    struct ir_node *it = decls;
+    while (it) {
+        struct ir_fn_decl *decl = it->ir;
+        /* Key:   sym_idx
+           Value: array of ir's */
+        hashmap_t assigns = {0};
+
+        ssa_vars_collect(decl);
+        assigns_collect(decl, &assigns);
+        stmts_collect(decl);
+        vars_liveness_compute();
+
+        ir_dominator_tree(decl);
+        ir_dominance_frontier(decl);
+        phi_insert(decl, &assigns);
+
+        weak_free(vars_live_in);
+        stmts_destroy();
+
+        hashmap_reset(&ssa_stacks, 256);
+        hashmap_reset(&ssa_counters, 256);
+        ssa_rename(decl->body);
+        ssa_stacks_destroy();
+
+        assigns_destroy(&assigns);
+        hashmap_destroy(&ssa_vars);
+
+        it = it->next;
+    }
 }
 
-static void ssa_rename_cond(struct ir_node *ir, uint64_t sym_idx, ssa_stack_t *stack)
+/**********************************************
+ **           Out of SSA translation         **
+ **********************************************/
+
+/* Phi nodes are replaced with copies on incoming edges.
+
+   Versions of one variable, whose live ranges do not
+   interfere, are coalesced back to this variable. This is
+   the usual case right after ir_compute_ssa(), so most of
+   phi nodes do not produce any copy. Interfering versions
+   (after optimizations moved something) get new variables.
+
+   Copies of one edge are parallel by meaning, so they are
+   sequentialized, using temporary variable to break cycles.
+   Critical edges are split to have a place for copies.
+
+   https://hal.inria.fr/inria-00349925v1/document */
+
+struct ssa_value {
+    uint64_t sym_idx;
+    /* UINT64_MAX for function parameter at entry. */
+    uint64_t ssa_idx;
+};
+
+struct ssa_copy {
+    uint64_t dst;
+    uint64_t src;
+};
+
+typedef vector_t(struct ssa_copy) ssa_copies_t;
+
+static vector_t(struct ssa_value) values;
+/* Key:   value_key(sym_idx, ssa_idx)
+   Value: index in `values` */
+static hashmap_t   value_ids;
+/* Key:   sym_idx
+   Value: 1 if symbol has SSA versions */
+static hashmap_t   renamed;
+/* Key:   sym_idx
+   Value: struct ir_sym * with type of variable */
+static hashmap_t   sym_types;
+/* Key:   sym_idx
+   Value: struct ir_alloca * of variable */
+static hashmap_t   sym_allocas;
+static uint64_t    next_sym_idx;
+
+/* Sets of values for each statement. */
+static uint64_t   *uses;
+static uint64_t   *defs;
+static uint64_t   *phi_defs;
+static uint64_t   *live_in;
+static uint64_t   *live_out;
+/* Interference graph. Adjacency list of each value. */
+static ssa_list_t *interference;
+/* Key:   a * values.count + b
+   Value: 1 if edge is in the graph */
+static hashmap_t   edges;
+/* Union-find of coalesced values. */
+static uint64_t   *parent;
+/* Values of each class (for roots only). */
+static ssa_list_t *members;
+/* Variable of each class (for roots only). */
+static uint64_t   *storage;
+
+really_inline static uint64_t value_key(uint64_t sym_idx, uint64_t ssa_idx)
 {
-    struct ir_cond *cond = ir->ir;
-    ssa_rename_bin(cond->cond, sym_idx, stack);
+    return (sym_idx << 32) | (ssa_idx & 0xFFFFFFFF);
 }
 
-static void ssa_rename_phi(struct ir_node *ir, uint64_t sym_idx, ssa_stack_t *stack)
+static void value_add(uint64_t sym_idx, uint64_t ssa_idx)
+{
+    uint64_t key = value_key(sym_idx, ssa_idx);
+
+    if (hashmap_has(&value_ids, key))
+        return;
+
+    struct ssa_value v = {
+        .sym_idx = sym_idx,
+        .ssa_idx = ssa_idx
+    };
+
+    hashmap_put(&value_ids, key, values.count);
+    vector_push_back(values, v);
+}
+
+/* Returns -1 for undefined value, like local variable
+   before first assignment. */
+static int64_t value_find(uint64_t sym_idx, uint64_t ssa_idx)
+{
+    bool     ok = 0;
+    uint64_t id = hashmap_get(&value_ids, value_key(sym_idx, ssa_idx), &ok);
+
+    return ok ? (int64_t) id : -1;
+}
+
+static int64_t sym_value(struct ir_node *ir)
+{
+    struct ir_sym *sym = ir->ir;
+
+    if (!hashmap_has(&renamed, sym->idx))
+        return -1;
+
+    return value_find(sym->idx, sym->ssa_idx);
+}
+
+/* Returns -1 if there is no operand for given predecessor. */
+static int64_t phi_arg_value(struct ir_node *ir, struct ir_node *pred)
 {
     struct ir_phi *phi = ir->ir;
-    if (phi->sym_idx == sym_idx) {
-        phi->ssa_idx = ++ssa_idx;
-        ssa_list_t *list = ssa_stack_put(stack, sym_idx);
-        vector_push_back(*list, phi->ssa_idx);
-        ssa_stack_dump(stack);
+
+    for (uint64_t i = 0; i < phi->args_size; ++i) {
+        int64_t ssa_idx = phi->args[i].ssa_idx;
+
+        if (phi->args[i].pred == pred)
+            return value_find(phi->sym_idx, ssa_idx < 0 ? UINT64_MAX : (uint64_t) ssa_idx);
     }
+
+    return -1;
+}
+
+static int64_t phi_value(struct ir_node *ir)
+{
+    struct ir_phi *phi = ir->ir;
+
+    return value_find(phi->sym_idx, phi->ssa_idx);
+}
+
+/**********************************************
+ **        Values and statements             **
+ **********************************************/
+
+static void sym_collect(struct ir_node *ir, unused void *data)
+{
+    struct ir_sym *sym = ir->ir;
+
+    if (!hashmap_has(&sym_types, sym->idx))
+        hashmap_put(&sym_types, sym->idx, (uint64_t) sym);
+
+    if (sym->ssa_idx == UINT64_MAX)
+        return;
+
+    hashmap_put(&renamed, sym->idx, 1);
+    value_add(sym->idx, sym->ssa_idx);
 }
 
-static void ssa_rename_store(struct ir_node *ir, uint64_t sym_idx, ssa_stack_t *stack)
+static void allocas_collect(struct ir_node *it, bool args)
 {
-    struct ir_store *store = ir->ir;
+    for (; it; it = it->next) {
+        if (it->type != IR_ALLOCA && it->type != IR_ALLOCA_ARRAY)
+            continue;
+
+        uint64_t idx = it->type == IR_ALLOCA
+            ? ((struct ir_alloca *) it->ir)->idx
+            : ((struct ir_alloca_array *) it->ir)->idx;
+
+        if (next_sym_idx <= idx)
+            next_sym_idx = idx + 1;
 
-    switch (store->body->type) {
-    case IR_BIN:
-        ssa_rename_bin(store->body, sym_idx, stack);
-        break;
-    case IR_SYM:
-        ssa_rename_sym(store->body, sym_idx, stack);
-        break;
-    default:
-        break;
+        hashmap_put(&sym_allocas, idx, (uint64_t) it->ir);
+
+        /* Parameter value at entry is used before first
+           assignment, if any. */
+        if (args && hashmap_has(&renamed, idx))
+            value_add(idx, UINT64_MAX);
     }
+}
 
-    if (store->idx->type == IR_SYM) {
-        struct ir_sym *sym = store->idx->ir;
+static void values_collect(struct ir_fn_decl *decl)
+{
+    stmts_collect(decl);
 
-        if (sym->idx == sym_idx) {
-            sym->ssa_idx = ++ssa_idx;
-            ssa_list_t *list = ssa_stack_put(stack, sym_idx);
-            vector_push_back(*list, sym->ssa_idx);
+    for (struct ir_node *it = decl->body; it; it = it->next) {
+        if (it->type == IR_PHI) {
+            struct ir_phi *phi = it->ir;
+            hashmap_put(&renamed, phi->sym_idx, 1);
+            value_add(phi->sym_idx, phi->ssa_idx);
+            continue;
         }
+
+        ir_foreach_use(it, sym_collect, NULL);
+
+        struct ir_node *def = ir_def(it);
+        if (def)
+            sym_collect(def, NULL);
     }
 
-    ssa_stack_dump(stack);
+    next_sym_idx = 0;
+    allocas_collect(decl->args, /*args=*/1);
+    allocas_collect(decl->body, /*args=*/0);
 }
 
-static void ssa_rename_ret(struct ir_node *ir, uint64_t sym_idx, ssa_stack_t *stack)
+/**********************************************
+ **               Liveness                   **
+ **********************************************/
+
+static void use_collect(struct ir_node *ir, void *set)
 {
-    struct ir_ret *ret = ir->ir;
-    if (ret->body &&
-        ret->body->type == IR_SYM)
-        ssa_rename_sym(ret->body, sym_idx, stack);
+    set_add(set, sym_value(ir));
+}
 
-    ssa_stack_dump(stack);
+static void sets_collect()
+{
+    vector_foreach(stmts, i) {
+        struct ir_node *it  = vector_at(stmts, i);
+        struct ir_node *def = ir_def(it);
+
+        ir_foreach_use(it, use_collect, set_of(uses, i));
+
+        if (def)
+            set_add(set_of(defs, i), sym_value(def));
+
+        for (struct ir_node *p = it->prev; p && p->type == IR_PHI; p = p->prev)
+            set_add(set_of(phi_defs, i), phi_value(p));
+    }
 }
 
-static void ssa_rename(struct ir_node *ir, uint64_t sym_idx, ssa_stack_t *stack, bool *visited)
+/* Phi nodes use their operands at the end of predecessors
+   and define values at the beginning of their statement. */
+static void live_out_compute(uint64_t stmt, uint64_t *out)
 {
-    if (visited[ir->instr_idx])
-        return;
+    struct ir_node *ir = vector_at(stmts, stmt);
+
+    memset(out, 0, set_words * sizeof (uint64_t));
 
-    visited[ir->instr_idx] = 1;
-
-    printf("visit ");
-    ir_dump_node(stdout, ir);
-    printf("\n");
-
-    switch (ir->type) {
-    case IR_PHI:
-        ssa_rename_phi(ir, sym_idx, stack);
-        break;
-    case IR_COND:
-        ssa_rename_cond(ir, sym_idx, stack);
-        break;
-    case IR_STORE:
-        ssa_rename_store(ir, sym_idx, stack);
-        break;
-    case IR_RET:
-        ssa_rename_ret(ir, sym_idx, stack);
-        break;
-    default:
-        break;
-    }
-
-    /* 1. Some logic with phi nodes. */
     vector_foreach(ir->cfg.succs, i) {
-        struct ir_node *it = vector_at(ir->cfg.succs, i);
-        if (it->type == IR_PHI) {
-            /* ... */
-            struct ir_phi *phi = it->ir;
-            if (phi->sym_idx == sym_idx &&
-                stack->size > 0) {
-                /* TODO: Store variable list assigned in
-                         each related block in phi node.
-                         Then rename operands of phi. */
-                ssa_list_t *list = ssa_stack_get_list(stack, sym_idx);
-                phi->ssa_idx = vector_back(*list);
+        struct ir_node *succ = vector_at(ir->cfg.succs, i);
+        uint64_t        id   = stmt_id(succ);
+        uint64_t       *in   = set_of(live_in, id);
+        uint64_t       *phis = set_of(phi_defs, id);
+
+        for (uint64_t w = 0; w < set_words; ++w)
+            out[w] |= in[w] & ~phis[w];
+
+        for (struct ir_node *p = succ->prev; p && p->type == IR_PHI; p = p->prev)
+            set_add(out, phi_arg_value(p, ir));
+    }
+}
+
+static void liveness_compute()
+{
+    bool changed = 1;
+
+    while (changed) {
+        changed = 0;
+
+        vector_foreach_back(stmts, i) {
+            uint64_t *out = set_of(live_out, i);
+            uint64_t *in  = set_of(live_in,  i);
+            uint64_t *use = set_of(uses,     i);
+            uint64_t *def = set_of(defs,     i);
+
+            live_out_compute(i, out);
+
+            for (uint64_t w = 0; w < set_words; ++w) {
+                uint64_t new = use[w] | (out[w] & ~def[w]);
+
+                changed |= new != in[w];
+                in[w] = new;
             }
         }
     }
+}
+
+/**********************************************
+ **         Interference, coalescing         **
+ **********************************************/
+
+/* Only versions of the same variable can be coalesced,
+   so interference of different variables is not needed. */
+static void interfere(uint64_t a, uint64_t b)
+{
+    if (a == b || vector_at(values, a).sym_idx != vector_at(values, b).sym_idx)
+        return;
+
+    uint64_t key = a * values.count + b;
+
+    if (hashmap_has(&edges, key))
+        return;
+
+    hashmap_put(&edges, key, 1);
+    hashmap_put(&edges, b * values.count + a, 1);
+    vector_push_back(interference[a], b);
+    vector_push_back(interference[b], a);
+}
 
-    /* 2. Call recursive for dominator tree children.
-     *
-     * Incorrect visit order and this phi indexing:
-     *
-     * rename symbol 0
-     * visit int t0
-     * visit t0 = 0
-     * visit int t1
-     * visit t1 = 0
-     * visit int t2
-     * visit t2 = t1 < 10
-     * visit if t2 != 0 goto L8
-     * visit jmp L12
-     * visit ret t0
-     * visit t0 = t1
-     * visit t0 = t0 + 1
-     * visit t1 = t1 + 1
-     * visit jmp L4
-     * visit t0.1 = φ(4, 3)
-     * visit t1.0 = φ(4, 3)
-     * visit t2.0 = φ(4, 3) */
-    vector_foreach(ir->idom_back, i) {
-        struct ir_node *submissive = vector_at(ir->idom_back, i);
-        ssa_rename(submissive, sym_idx, stack, visited);
-    }
-
-    /* 3. Pop from stack for current assignment. */
-    if (ir->type == IR_STORE) {
-        struct ir_store *store = ir->ir;
-        if (store->idx->type != IR_SYM)
-            return;
-        struct ir_sym *sym = store->idx->ir;
-        if (sym->idx == sym_idx) {
-            ssa_list_t *list = ssa_stack_get_list(stack, sym_idx);
-            vector_pop_back(*list);
+/* Value `a` interferes with each value of `set`. */
+static void interfere_set(uint64_t a, uint64_t *set)
+{
+    for (uint64_t w = 0; w < set_words; ++w) {
+        uint64_t bits = set[w];
+
+        while (bits) {
+            interfere(a, w * 64 + __builtin_ctzll(bits));
+            bits &= bits - 1;
         }
     }
 }
 
-void ir_compute_ssa(struct ir_node *decls)
+/* Value interferes with everything live right after its
+   definition. Phi nodes define values simultaneously at
+   the beginning of statement. */
+static void interference_build()
 {
-    struct ir_node *it = decls;
-    while (it) {
-        struct ir_fn_decl *decl = it->ir;
-        /* Key:   sym_idx
-           Value: array of ir's */
-        hashmap_t assigns        = {0};
-        /* Value: sym_idx */
-        ssa_stack_t ssa_stack    = {0};
-        hashmap_init(&ssa_stack, 256);
+    vector_foreach(stmts, i) {
+        uint64_t *out  = set_of(live_out, i);
+        uint64_t *in   = set_of(live_in,  i);
+        uint64_t *def  = set_of(defs,     i);
+        uint64_t *phis = set_of(phi_defs, i);
+
+        for (uint64_t w = 0; w < set_words; ++w) {
+            uint64_t bits = def[w];
+
+            while (bits) {
+                interfere_set(w * 64 + __builtin_ctzll(bits), out);
+                bits &= bits - 1;
+            }
 
-        assigns_collect(decl, &assigns);
+            bits = phis[w];
 
-        ir_dominator_tree(decl);
-        ir_dominance_frontier(decl);
-        phi_insert(decl, &assigns);
-        ir_cfg_build(decl);
+            while (bits) {
+                uint64_t a = w * 64 + __builtin_ctzll(bits);
+                interfere_set(a, in);
+                interfere_set(a, phis);
+                bits &= bits - 1;
+            }
+        }
+    }
+}
+
+static uint64_t class_of(uint64_t v)
+{
+    while (parent[v] != v)
+        v = parent[v] = parent[parent[v]];
+
+    return v;
+}
+
+/* Neighbours of members of class `a` are checked. */
+static bool classes_interfere(uint64_t a, uint64_t b)
+{
+    vector_foreach(members[a], i) {
+        ssa_list_t *adj = &interference[vector_at(members[a], i)];
+
+        vector_foreach(*adj, j)
+            if (class_of(vector_at(*adj, j)) == b)
+                return 1;
+    }
+
+    return 0;
+}
+
+static void coalesce(int64_t a, int64_t b)
+{
+    if (a < 0 || b < 0)
+        return;
+
+    uint64_t ca = class_of(a);
+    uint64_t cb = class_of(b);
+
+    if (ca == cb)
+        return;
+
+    /* Smaller class is merged into bigger one. */
+    if (members[ca].count > members[cb].count) {
+        uint64_t tmp = ca;
+        ca = cb;
+        cb = tmp;
+    }
+
+    if (classes_interfere(ca, cb))
+        return;
+
+    parent[ca] = cb;
+
+    vector_foreach(members[ca], i)
+        vector_push_back(members[cb], vector_at(members[ca], i));
+
+    vector_free(members[ca]);
+}
+
+/* Phi operands are coalesced first, since each such
+   coalescing removes a copy. Then remaining versions are
+   merged, to create as few new variables as possible. */
+static void values_coalesce(struct ir_fn_decl *decl)
+{
+    vector_foreach(values, i) {
+        parent[i] = i;
+        vector_push_back(members[i], i);
+    }
+
+    for (struct ir_node *it = decl->body; it; it = it->next) {
+        if (it->type != IR_PHI)
+            continue;
+
+        struct ir_phi *phi = it->ir;
+
+        for (uint64_t i = 0; i < phi->args_size; ++i)
+            coalesce(phi_value(it), phi_arg_value(it, phi->args[i].pred));
+    }
+
+    vector_foreach(values, a)
+        for (uint64_t b = a + 1; b < values.count; ++b)
+            if (vector_at(values, a).sym_idx == vector_at(values, b).sym_idx)
+                coalesce(a, b);
+}
+
+/* New variables are declared at function entry, so they
+   are alive through the whole function. */
+static uint64_t sym_new(struct ir_fn_decl *decl, uint64_t like)
+{
+    bool     ok     = 0;
+    uint64_t alloca = hashmap_get(&sym_allocas, like, &ok);
+    uint64_t type   = hashmap_get(&sym_types, like, &ok);
+    uint64_t idx    = next_sym_idx++;
+
+    struct ir_alloca *a = (struct ir_alloca *) alloca;
+    struct ir_node   *n = ir_alloca_init(a->dt, a->ptr_depth, idx);
+
+    memcpy(&n->meta, &decl->body->meta, sizeof (struct meta));
+    ir_insert_before(decl->body, n, &decl->body);
+
+    hashmap_put(&sym_allocas, idx, (uint64_t) n->ir);
+    hashmap_put(&sym_types, idx, type);
+
+    return idx;
+}
+
+/* Class with parameter value at entry should keep original
+   variable. Otherwise, original variable is given to the
+   first class, and the rest get new ones. */
+static void storage_assign(struct ir_fn_decl *decl)
+{
+    /* Key:   sym_idx
+       Value: 1 if variable is given to some class */
+    hashmap_t taken = {0};
+
+    hashmap_init(&taken, 64);
+
+    vector_foreach(values, i)
+        storage[i] = UINT64_MAX;
+
+    vector_foreach(values, i) {
+        struct ssa_value *v = &vector_at(values, i);
+
+        if (v->ssa_idx == UINT64_MAX) {
+            storage[class_of(i)] = v->sym_idx;
+            hashmap_put(&taken, v->sym_idx, 1);
+        }
+    }
+
+    vector_foreach(values, i) {
+        struct ssa_value *v = &vector_at(values, i);
+        uint64_t          c = class_of(i);
+
+        if (storage[c] != UINT64_MAX)
+            continue;
+
+        if (hashmap_has(&taken, v->sym_idx)) {
+            storage[c] = sym_new(decl, v->sym_idx);
+        } else {
+            storage[c] = v->sym_idx;
+            hashmap_put(&taken, v->sym_idx, 1);
+        }
+    }
+
+    hashmap_destroy(&taken);
+}
+
+static int64_t value_storage(int64_t v)
+{
+    return v < 0 ? -1 : (int64_t) storage[class_of(v)];
+}
+
+static void sym_rewrite(struct ir_node *ir, unused void *data)
+{
+    struct ir_sym *sym = ir->ir;
+    int64_t        v   = sym_value(ir);
+
+    if (v < 0)
+        return;
+
+    sym->idx = value_storage(v);
+    sym->ssa_idx = UINT64_MAX;
+}
+
+static void syms_rewrite()
+{
+    vector_foreach(stmts, i) {
+        struct ir_node *it  = vector_at(stmts, i);
+        struct ir_node *def = ir_def(it);
+
+        ir_foreach_use(it, sym_rewrite, NULL);
+
+        if (def)
+            sym_rewrite(def, NULL);
+    }
+}
+
+/**********************************************
+ **             Parallel copies              **
+ **********************************************/
+
+/* Parallel copy is turned to sequence of copies, so that
+   each variable is read before it is overwritten. Cycles
+   like (a, b) = (b, a) require one temporary variable. */
+static void copies_sequentialize(
+    struct ir_fn_decl *decl,
+    ssa_copies_t      *parallel,
+    ssa_copies_t      *out
+) {
+    /* Key:   variable
+       Value: where its initial value is located now */
+    hashmap_t loc  = {0};
+    /* Key:   variable
+       Value: variable, which is copied to it */
+    hashmap_t pred = {0};
+    vector_t(uint64_t) ready = {0};
+    vector_t(uint64_t) todo  = {0};
+    bool      ok   = 0;
+
+    hashmap_init(&loc, 32);
+    hashmap_init(&pred, 32);
+
+    vector_foreach(*parallel, i) {
+        struct ssa_copy *c = &vector_at(*parallel, i);
+        hashmap_put(&loc, c->src, c->src);
+        hashmap_put(&pred, c->dst, c->src);
+        vector_push_back(todo, c->dst);
+    }
+
+    /* Variables, which are not used as sources, can be
+       overwritten right away. */
+    vector_foreach(*parallel, i) {
+        struct ssa_copy *c = &vector_at(*parallel, i);
+        if (!hashmap_has(&loc, c->dst))
+            vector_push_back(ready, c->dst);
+    }
 
-        hashmap_foreach(&assigns, sym_idx, __) {
-            bool visited[512] = {0};
+    while (todo.count > 0) {
+        while (ready.count > 0) {
+            uint64_t b = vector_back(ready);
+            vector_pop_back(ready);
+
+            uint64_t a = hashmap_get(&pred, b, &ok);
+            uint64_t c = hashmap_get(&loc, a, &ok);
+
+            struct ssa_copy copy = {
+                .dst = b,
+                .src = c
+            };
+            vector_push_back(*out, copy);
+            hashmap_put(&loc, a, b);
+
+            /* Initial value of `a` is saved, so it can
+               be overwritten now. */
+            if (a == c && hashmap_has(&pred, a))
+                vector_push_back(ready, a);
+        }
 
-            ssa_idx = 0;
-            printf("rename symbol %lu\n", sym_idx);
-            ssa_rename(decl->body, sym_idx, &ssa_stack, visited);
+        uint64_t b = vector_back(todo);
+        vector_pop_back(todo);
+
+        /* Not copied yet, so it is part of a cycle. */
+        if (b != hashmap_get(&loc, hashmap_get(&pred, b, &ok), &ok)) {
+            struct ssa_copy copy = {
+                .dst = sym_new(decl, b),
+                .src = b
+            };
+            vector_push_back(*out, copy);
+            hashmap_put(&loc, b, copy.dst);
+            vector_push_back(ready, b);
         }
+    }
+
+    vector_free(todo);
+    vector_free(ready);
+    hashmap_destroy(&pred);
+    hashmap_destroy(&loc);
+}
+
+/* Copies for edge `pred` -> `stmt`. */
+static void edge_copies(
+    struct ir_fn_decl *decl,
+    struct ir_node    *pred,
+    struct ir_node    *stmt,
+    ssa_copies_t      *out
+) {
+    ssa_copies_t parallel = {0};
+
+    for (struct ir_node *p = stmt->prev; p && p->type == IR_PHI; p = p->prev) {
+        int64_t dst = value_storage(phi_value(p));
+        int64_t src = value_storage(phi_arg_value(p, pred));
+
+        if (dst < 0 || src < 0 || dst == src)
+            continue;
+
+        struct ssa_copy copy = {
+            .dst = dst,
+            .src = src
+        };
+        vector_push_back(parallel, copy);
+    }
+
+    copies_sequentialize(decl, &parallel, out);
+    vector_free(parallel);
+}
+
+static struct ir_node *sym_init(uint64_t idx)
+{
+    bool            ok  = 0;
+    struct ir_node *ir  = ir_sym_init(idx);
+    struct ir_sym  *sym = ir->ir;
+    struct ir_sym  *old = (struct ir_sym *) hashmap_get(&sym_types, idx, &ok);
+
+    assert(ok);
+    memcpy(&sym->type_info, &old->type_info, sizeof (struct type));
+
+    return ir;
+}
+
+static struct ir_node *copy_init(struct ssa_copy *copy, struct ir_node *like)
+{
+    struct ir_node *ir = ir_store_init(sym_init(copy->dst), sym_init(copy->src));
+
+    memcpy(&ir->meta, &like->meta, sizeof (struct meta));
+
+    return ir;
+}
+
+static struct ir_node *jump_init(struct ir_node *target, struct ir_node *like)
+{
+    struct ir_node *ir   = ir_jump_init(target->instr_idx);
+    struct ir_jump *jump = ir->ir;
+
+    jump->target = target;
+    memcpy(&ir->meta, &like->meta, sizeof (struct meta));
 
+    return ir;
+}
+
+/* Returns last inserted statement. */
+static struct ir_node *copies_insert_after(struct ir_node *pos, ssa_copies_t *copies, struct ir_node *like)
+{
+    vector_foreach(*copies, i) {
+        struct ir_node *copy = copy_init(&vector_at(*copies, i), like);
+        ir_insert_after(pos, copy);
+        pos = copy;
+    }
+
+    return pos;
+}
+
+static void retarget(struct ir_fn_decl *decl, struct ir_node *from, struct ir_node *to)
+{
+    for (struct ir_node *it = decl->body; it; it = it->next) {
+        if (it->type == IR_JUMP && ((struct ir_jump *) it->ir)->target == from)
+            ((struct ir_jump *) it->ir)->target = to;
+
+        if (it->type == IR_COND && ((struct ir_cond *) it->ir)->target == from)
+            ((struct ir_cond *) it->ir)->target = to;
+    }
+}
+
+static struct ir_node *list_tail(struct ir_fn_decl *decl)
+{
+    struct ir_node *it = decl->body;
+
+    while (it->next)
         it = it->next;
 
-        assigns_destroy(&assigns);
+    /* Nothing should be executed after the last
+       statement. */
+    if (it->type != IR_RET && it->type != IR_JUMP) {
+        struct ir_node *ret = ir_ret_init(NULL);
+        ir_insert_after(it, ret);
+        it = ret;
+    }
+
+    return it;
+}
+
+/* Copies are placed at the end of predecessor, if it has
+   only one successor. Otherwise, the edge is critical (since
+   statement with phi nodes always has several predecessors)
+   and new block with copies is created on this edge.
+
+   Jump target of the condition is moved to the function
+   end and returns back with jump. */
+static void copies_place(
+    struct ir_fn_decl *decl,
+    struct ir_node    *pred,
+    struct ir_node    *stmt,
+    ssa_copies_t      *copies
+) {
+    if (copies->count == 0)
+        return;
+
+    if (pred->type == IR_JUMP) {
+        struct ir_node *first = NULL;
+
+        vector_foreach(*copies, i) {
+            struct ir_node *copy = copy_init(&vector_at(*copies, i), pred);
+            ir_insert_before(pred, copy, &decl->body);
+            if (!first)
+                first = copy;
+        }
+
+        retarget(decl, pred, first);
+        return;
+    }
+
+    if (pred->type != IR_COND) {
+        copies_insert_after(pred, copies, pred);
+        return;
+    }
+
+    struct ir_cond *cond = pred->ir;
+
+    if (cond->target == stmt) {
+        struct ir_node *tail = list_tail(decl);
+        struct ir_node *last = copies_insert_after(tail, copies, pred);
+
+        ir_insert_after(last, jump_init(stmt, pred));
+        cond->target = tail->next;
+    }
+
+    if (ir_next_stmt(pred) == stmt) {
+        struct ir_node *last = copies_insert_after(pred, copies, pred);
+        ir_insert_after(last, jump_init(stmt, pred));
+    }
+}
+
+/* Predecessor can occur twice, if both branches of condition
+   lead to the same statement. Return statement is also linked
+   as predecessor of the next one, but it is not an edge. */
+static bool edge_first(struct ir_node *stmt, uint64_t i)
+{
+    struct ir_node *pred = vector_at(stmt->cfg.preds, i);
+
+    for (uint64_t j = 0; j < i; ++j)
+        if (vector_at(stmt->cfg.preds, j) == pred)
+            return 0;
+
+    vector_foreach(pred->cfg.succs, j)
+        if (vector_at(pred->cfg.succs, j) == stmt)
+            return 1;
+
+    return 0;
+}
+
+static void phis_eliminate(struct ir_fn_decl *decl)
+{
+    vector_foreach(stmts, s) {
+        struct ir_node *stmt = vector_at(stmts, s);
+
+        if (!stmt->prev || stmt->prev->type != IR_PHI)
+            continue;
+
+        vector_foreach(stmt->cfg.preds, i) {
+            if (!edge_first(stmt, i))
+                continue;
+
+            struct ir_node *pred   = vector_at(stmt->cfg.preds, i);
+            ssa_copies_t    copies = {0};
+
+            edge_copies(decl, pred, stmt, &copies);
+            copies_place(decl, pred, stmt, &copies);
+            vector_free(copies);
+        }
+    }
+
+    struct ir_node *it = decl->body;
+
+    while (it) {
+        struct ir_node *next = it->next;
+
+        if (it->type == IR_PHI) {
+            /* Phi is never last, statement follows it. */
+            if (it->prev)
+                it->prev->next = next;
+            else
+                decl->body = next;
+
+            next->prev = it->prev;
+            ir_node_cleanup(it);
+        }
+
+        it = next;
+    }
+}
+
+static void ssa_destroy_cleanup()
+{
+    weak_free(uses);
+    weak_free(defs);
+    weak_free(phi_defs);
+    weak_free(live_in);
+    weak_free(live_out);
+    vector_foreach(values, i) {
+        vector_free(interference[i]);
+        vector_free(members[i]);
+    }
+
+    weak_free(interference);
+    weak_free(members);
+    weak_free(parent);
+    hashmap_destroy(&edges);
+    weak_free(storage);
+    vector_free(values);
+    hashmap_destroy(&value_ids);
+    hashmap_destroy(&renamed);
+    hashmap_destroy(&sym_types);
+    hashmap_destroy(&sym_allocas);
+    stmts_destroy();
+}
+
+static void ssa_destroy(struct ir_fn_decl *decl)
+{
+    hashmap_reset(&value_ids, 256);
+    hashmap_reset(&renamed, 64);
+    hashmap_reset(&sym_types, 64);
+    hashmap_reset(&sym_allocas, 64);
+    hashmap_reset(&edges, 256);
+
+    values_collect(decl);
+
+    uint64_t n = values.count + 1;
+
+    uses         = sets_alloc(n);
+    defs         = sets_alloc(n);
+    phi_defs     = sets_alloc(n);
+    live_in      = sets_alloc(n);
+    live_out     = sets_alloc(n);
+    interference = weak_calloc(n, sizeof (ssa_list_t));
+    members      = weak_calloc(n, sizeof (ssa_list_t));
+    parent       = weak_calloc(n, sizeof (uint64_t));
+    storage      = weak_calloc(n, sizeof (uint64_t));
+
+    sets_collect();
+    liveness_compute();
+    interference_build();
+    values_coalesce(decl);
+    storage_assign(decl);
+
+    syms_rewrite();
+    phis_eliminate(decl);
+
+    ir_renumber(decl->body);
+    ir_cfg_build(decl);
+
+    ssa_destroy_cleanup();
+}
+
+void ir_destroy_ssa(struct ir_node *decls)
+{
+    struct ir_node *it = decls;
+
+    while (it) {
+        ssa_destroy(it->ir);
+        it = it->next;
     }
 }
 
@@ -14,4 +14,11 @@ struct ir_node;
 
 void ir_compute_ssa(struct ir_node *functions);
 
+/** Translate functions out of SSA form. Phi nodes are replaced
+    with copies on incoming edges, SSA versions of variables
+    are merged back, where their live ranges do not interfere.
+
+    \pre CFG is built. */
+void ir_destroy_ssa(struct ir_node *functions);
+
 #endif // WEAK_COMPILER_MIDDLE_END_SSA_H
\ No newline at end of file
@@ -162,6 +162,11 @@ static void type_pass_fn_call(struct ir_fn_call *call)
         it = it->next;
     }
 
+    /* Function from other unit. Its type is given by
+       IR generator from prototype. */
+    if (!hashmap_has(&fn_map, crc32_string(call->name)))
+        return;
+
     struct type *t = fn_type_lookup(call->name);
     memcpy(&call->type_info, t, sizeof (*t));
 }
@@ -5,9 +5,13 @@
  */
 
 #include "middle_end/opt/opt.h"
+#include "middle_end/ir/gen.h"
 #include "middle_end/ir/ir.h"
+#include "middle_end/ir/ir_ops.h"
 #include "util/unreachable.h"
 #include <assert.h>
+#include <limits.h>
+#include <string.h>
 
 static struct ir_node *opt_arith_node(struct ir_node *ir);
 
@@ -67,20 +71,18 @@ static struct ir_node *opt_arith_bin(struct ir_bin *bin)
 
     /* x + 0 = x */
     if (__match(TOK_PLUS, IR_SYM, IR_IMM)) {
-        struct ir_sym *l_sym = lhs->ir;
         struct ir_imm *r_imm = rhs->ir;
 
         if (r_imm->imm.__int == 0)
-            return ir_sym_init(l_sym->idx);
+            return ir_node_copy(lhs);
     }
 
     /* x - 0 = x */
     if (__match(TOK_MINUS, IR_SYM, IR_IMM)) {
-        struct ir_sym *l_sym = lhs->ir;
         struct ir_imm *r_imm = rhs->ir;
 
         if (r_imm->imm.__int == 0)
-            return ir_sym_init(l_sym->idx);
+            return ir_node_copy(lhs);
     }
 
     /* x * 0 = 0 */
@@ -101,22 +103,20 @@ static struct ir_node *opt_arith_bin(struct ir_bin *bin)
 
     /* x | 0 = x */
     if (__match(TOK_BIT_OR, IR_SYM, IR_IMM)) {
-        struct ir_sym *l_sym = lhs->ir;
         struct ir_imm *r_imm = rhs->ir;
 
         if (r_imm->imm.__int == 0)
-            return ir_sym_init(l_sym->idx);
+            return ir_node_copy(lhs);
     }
 
     /* x * (power of 2) = x << (n'th bit) */
     if (__match(TOK_STAR, IR_SYM, IR_IMM)) {
-        struct ir_sym *l_sym = lhs->ir;
         struct ir_imm *r_imm = rhs->ir;
 
         if (is_power_of_two(r_imm->imm.__int))
             return ir_bin_init(
                 TOK_SHL,
-                ir_sym_init(l_sym->idx),
+                ir_node_copy(lhs),
                 ir_imm_int_init(nth_bit(r_imm->imm.__int))
             );
     }
@@ -179,6 +179,411 @@ static struct ir_node *opt_arith_node(struct ir_node *ir)
     return no_result();
 }
 
+/**********************************************
+ **           Strength reduction             **
+ **********************************************/
+
+/* Division and modulo by constant are replaced with
+   multiplication by "magic" reciprocal, taking high half of
+   the product, and shifts (Granlund, Montgomery, 1994;
+   Warren, "Hacker's Delight", 10-4). Multiplication by
+   2^i + 2^j or 2^i - 2^j becomes two shifts and add.
+
+   Each step is emitted as separate statement with new
+   temporary variable, so three-address form is kept. */
+
+/* Relative latencies of target instructions. Sequence is
+   used only if it is cheaper, than single instruction. */
+struct arith_cost {
+    /** +, -, &, <<, >>. */
+    int add;
+    int mul;
+    int mulhi;
+    /** / and %. */
+    int div;
+};
+
+#if defined CONFIG_USE_BACKEND_RISC_V
+static const struct arith_cost cost = {.add = 1, .mul = 3, .mulhi = 3, .div = 34};
+#elif defined CONFIG_USE_BACKEND_X86_64
+static const struct arith_cost cost = {.add = 1, .mul = 3, .mulhi = 4, .div = 26};
+#else
+static const struct arith_cost cost = {.add = 1, .mul = 3, .mulhi = 3, .div = 20};
+#endif
+
+struct magic {
+    int32_t  mul;
+    uint32_t shift;
+};
+
+static struct ir_fn_decl *curr_decl;
+/* Statement, before which sequence is emitted. */
+static struct ir_node    *curr_stmt;
+/* First statement, emitted before current. */
+static struct ir_node    *curr_first;
+/* Type of reduced operand, shared by all temporaries. */
+static struct type        temp_type;
+static uint64_t           temp_idx;
+
+/* Magic number for signed division by d,
+   where 2 <= |d| < 2^31. */
+static struct magic magic_signed(int32_t d)
+{
+    const uint32_t two31 = 0x80000000U;
+
+    uint32_t ad    = d < 0 ? -(uint32_t) d : (uint32_t) d;
+    uint32_t t     = two31 + ((uint32_t) d >> 31);
+    uint32_t anc   = t - 1 - t % ad;
+    uint32_t q1    = two31 / anc;
+    uint32_t r1    = two31 - q1 * anc;
+    uint32_t q2    = two31 / ad;
+    uint32_t r2    = two31 - q2 * ad;
+    uint32_t delta = 0;
+    uint32_t p     = 31;
+
+    do {
+        ++p;
+        q1 *= 2;
+        r1 *= 2;
+        if (r1 >= anc) {
+            ++q1;
+            r1 -= anc;
+        }
+        q2 *= 2;
+        r2 *= 2;
+        if (r2 >= ad) {
+            ++q2;
+            r2 -= ad;
+        }
+        delta = ad - r2;
+    } while (q1 < delta || (q1 == delta && r1 == 0));
+
+    struct magic m = {
+        .mul   = (int32_t) (q2 + 1),
+        .shift = p - 32
+    };
+
+    if (d < 0)
+        m.mul = -m.mul;
+
+    return m;
+}
+
+static struct ir_node *temp_sym(uint64_t idx)
+{
+    struct ir_node *sym = ir_sym_init(idx);
+
+    memcpy(&((struct ir_sym *) sym->ir)->type_info, &temp_type, sizeof (struct type));
+
+    return sym;
+}
+
+static struct ir_node *imm(int32_t value)
+{
+    return ir_imm_int_init(value);
+}
+
+/* Emit `t = body` before current statement. */
+static struct ir_node *emit(struct ir_node *body)
+{
+    uint64_t        t      = temp_idx++;
+    struct ir_node *alloca = ir_alloca_init(D_T_INT, /*ptr_depth=*/0, t);
+    struct ir_node *store  = ir_store_init(temp_sym(t), body);
+
+    memcpy(&alloca->meta, &curr_stmt->meta, sizeof (struct meta));
+    memcpy(&store->meta, &curr_stmt->meta, sizeof (struct meta));
+    alloca->meta.block_depth = 0;
+
+    ir_insert_before(curr_decl->body, alloca, &curr_decl->body);
+    ir_insert_before(curr_stmt, store, &curr_decl->body);
+
+    if (!curr_first)
+        curr_first = store;
+
+    return temp_sym(t);
+}
+
+static struct ir_node *emit_bin(enum token_type op, struct ir_node *lhs, struct ir_node *rhs)
+{
+    return emit(ir_bin_init(op, lhs, rhs));
+}
+
+/* x * c, where |c| = 2^i + 2^j or 2^i - 2^j. */
+static struct ir_node *mul_reduce(struct ir_node *x, int32_t c)
+{
+    if (c == 0 || c == INT_MIN || is_power_of_two(c))
+        return NULL;
+
+    int64_t         a    = c < 0 ? -(int64_t) c : c;
+    int64_t         low  = a & -a;
+    enum token_type op   = TOK_PLUS;
+    int64_t         high = 0;
+
+    if (is_power_of_two(a - low)) {
+        high = a - low;
+    } else if (a + low <= INT_MAX && is_power_of_two(a + low)) {
+        high = a + low;
+        op   = TOK_MINUS;
+    } else {
+        return NULL;
+    }
+
+    int32_t i   = nth_bit(high);
+    int32_t j   = nth_bit(low);
+    /* -(2^i - 2^j) = 2^j - 2^i, so only sum needs negation. */
+    bool    neg = c < 0 && op == TOK_PLUS;
+    int     seq = cost.add * (1 + (j > 0) + 1 + neg);
+
+    if (seq >= cost.mul)
+        return NULL;
+
+    struct ir_node *l = emit_bin(TOK_SHL, ir_node_copy(x), imm(i));
+    struct ir_node *r = j > 0
+        ? emit_bin(TOK_SHL, ir_node_copy(x), imm(j))
+        : ir_node_copy(x);
+
+    if (neg)
+        return ir_bin_init(TOK_MINUS, imm(0), emit_bin(op, l, r));
+
+    if (c < 0)
+        return ir_bin_init(TOK_MINUS, r, l);
+
+    return ir_bin_init(op, l, r);
+}
+
+/* x / 2^k = (x + bias) >> k, where bias = 2^k - 1 for
+   negative x, so quotient is rounded to zero. Remainder is
+   x - ((x + bias) & -2^k). */
+static struct ir_node *div_pow2(struct ir_node *x, int32_t d, bool mod)
+{
+    int32_t a = d < 0 ? -d : d;
+    int32_t k = nth_bit(a);
+    int     seq = cost.add * (4 + (mod || d < 0));
+
+    if (seq >= cost.div)
+        return NULL;
+
+    struct ir_node *sign = emit_bin(TOK_SHR, ir_node_copy(x), imm(31));
+    struct ir_node *bias = emit_bin(TOK_BIT_AND, sign, imm(a - 1));
+    struct ir_node *sum  = emit_bin(TOK_PLUS, ir_node_copy(x), bias);
+
+    if (mod)
+        return ir_bin_init(
+            TOK_MINUS,
+            ir_node_copy(x),
+            emit_bin(TOK_BIT_AND, sum, imm(-a))
+        );
+
+    if (d < 0)
+        return ir_bin_init(TOK_MINUS, imm(0), emit_bin(TOK_SHR, sum, imm(k)));
+
+    return ir_bin_init(TOK_SHR, sum, imm(k));
+}
+
+/* q = (mulhi(x, M) [+ x | - x]) >> s, then 1 is added if
+   q is negative. Remainder is x - q * d. */
+static struct ir_node *div_magic(struct ir_node *x, int32_t d, bool mod)
+{
+    struct magic m    = magic_signed(d);
+    bool         add  = d > 0 && m.mul < 0;
+    bool         sub  = d < 0 && m.mul > 0;
+    int          seq  = cost.mulhi + cost.add * (add + sub + (m.shift > 0) + 2);
+
+    if (mod)
+        seq += cost.mul + cost.add;
+
+    if (seq >= cost.div)
+        return NULL;
+
+    struct ir_node *q = emit_bin(TOK_MULHI, ir_node_copy(x), imm(m.mul));
+
+    if (add)
+        q = emit_bin(TOK_PLUS, q, ir_node_copy(x));
+
+    if (sub)
+        q = emit_bin(TOK_MINUS, q, ir_node_copy(x));
+
+    if (m.shift > 0)
+        q = emit_bin(TOK_SHR, q, imm(m.shift));
+
+    struct ir_node *sign = emit_bin(TOK_SHR, ir_node_copy(q), imm(31));
+
+    if (!mod)
+        return ir_bin_init(TOK_MINUS, q, sign);
+
+    struct ir_node *quot = emit_bin(TOK_MINUS, q, sign);
+    struct ir_node *prod = mul_reduce(quot, d);
+
+    if (!prod)
+        prod = ir_bin_init(TOK_STAR, ir_node_copy(quot), imm(d));
+
+    ir_node_cleanup(quot);
+
+    return ir_bin_init(TOK_MINUS, ir_node_copy(x), emit(prod));
+}
+
+static struct ir_node *div_reduce(struct ir_node *x, int32_t d, bool mod)
+{
+    if (d == 0 || d == INT_MIN)
+        return NULL;
+
+    if (d == 1 || d == -1) {
+        if (mod)
+            return imm(0);
+
+        return d == 1
+            ? ir_node_copy(x)
+            : ir_bin_init(TOK_MINUS, imm(0), ir_node_copy(x));
+    }
+
+    if (is_power_of_two(d < 0 ? -d : d))
+        return div_pow2(x, d, mod);
+
+    return div_magic(x, d, mod);
+}
+
+/* Plain `int` variable. */
+static bool int_sym(struct ir_node *ir)
+{
+    if (ir->type != IR_SYM)
+        return 0;
+
+    struct ir_sym *sym = ir->ir;
+
+    return !sym->deref && !sym->addr_of &&
+            sym->type_info.dt == D_T_INT && sym->type_info.ptr_depth == 0;
+}
+
+static bool int_imm(struct ir_node *ir, int32_t *out)
+{
+    if (ir->type != IR_IMM)
+        return 0;
+
+    struct ir_imm *imm = ir->ir;
+
+    if (imm->type != IMM_INT)
+        return 0;
+
+    *out = imm->imm.__int;
+    return 1;
+}
+
+static struct ir_node *strength_reduce(struct ir_bin *bin)
+{
+    struct ir_node *x = bin->lhs;
+    int32_t         c = 0;
+
+    if (bin->op == TOK_STAR && int_imm(bin->lhs, &c) && int_sym(bin->rhs))
+        x = bin->rhs;
+    else if (!int_sym(bin->lhs) || !int_imm(bin->rhs, &c))
+        return NULL;
+
+    memcpy(&temp_type, &((struct ir_sym *) x->ir)->type_info, sizeof (struct type));
+
+    switch (bin->op) {
+    case TOK_STAR:  return mul_reduce(x, c);
+    case TOK_SLASH: return div_reduce(x, c, /*mod=*/0);
+    case TOK_MOD:   return div_reduce(x, c, /*mod=*/1);
+    default:
+        return NULL;
+    }
+}
+
+static struct ir_node **reducible_body(struct ir_node *ir)
+{
+    struct ir_node **body = NULL;
+
+    if (ir->type == IR_STORE)
+        body = &((struct ir_store *) ir->ir)->body;
+
+    if (ir->type == IR_RET)
+        body = &((struct ir_ret *) ir->ir)->body;
+
+    if (!body || !*body || (*body)->type != IR_BIN)
+        return NULL;
+
+    return body;
+}
+
+static uint64_t temp_idx_init(struct ir_fn_decl *decl)
+{
+    uint64_t max = 0;
+
+    for (uint64_t pass = 0; pass < 2; ++pass) {
+        struct ir_node *it = pass == 0 ? decl->args : decl->body;
+
+        for (; it; it = it->next) {
+            uint64_t idx = 0;
+
+            if (it->type == IR_ALLOCA)
+                idx = ((struct ir_alloca *) it->ir)->idx + 1;
+            else if (it->type == IR_ALLOCA_ARRAY)
+                idx = ((struct ir_alloca_array *) it->ir)->idx + 1;
+
+            if (idx > max)
+                max = idx;
+        }
+    }
+
+    return max;
+}
+
+/* Jumps to reduced statement should now execute
+   sequence, emitted before it. */
+static void jumps_retarget(struct ir_node *stmt, struct ir_node *first)
+{
+    vector_foreach(stmt->cfg.preds, i) {
+        struct ir_node *pred = vector_at(stmt->cfg.preds, i);
+
+        if (pred->type == IR_JUMP && ((struct ir_jump *) pred->ir)->target == stmt)
+            ((struct ir_jump *) pred->ir)->target = first;
+
+        if (pred->type == IR_COND && ((struct ir_cond *) pred->ir)->target == stmt)
+            ((struct ir_cond *) pred->ir)->target = first;
+    }
+}
+
+static void strength_reduce_fn_decl(struct ir_fn_decl *fn)
+{
+    bool changed = 0;
+
+    if (!fn->body)
+        return;
+
+    curr_decl = fn;
+    temp_idx  = temp_idx_init(fn);
+
+    /* Jump targets must be resolved to insert statements. */
+    ir_cfg_build(fn);
+
+    for (struct ir_node *it = fn->body; it; it = it->next) {
+        struct ir_node **body = reducible_body(it);
+
+        if (!body)
+            continue;
+
+        curr_stmt  = it;
+        curr_first = NULL;
+
+        struct ir_node *node = strength_reduce((*body)->ir);
+
+        if (curr_first)
+            jumps_retarget(it, curr_first);
+
+        if (!node)
+            continue;
+
+        ir_node_cleanup(*body);
+        *body   = node;
+        changed = 1;
+    }
+
+    if (changed) {
+        ir_renumber(fn->body);
+        ir_cfg_build(fn);
+    }
+}
+
 /* Transform arithmetic operations.
   
        1. Negation laws:
@@ -231,6 +636,8 @@ static void ir_opt_arith_fn_decl(struct ir_fn_decl *decl)
         opt_arith_node(it);
         it = it->next;
     }
+
+    strength_reduce_fn_decl(decl);
 }
 
 void ir_opt_arith(struct ir_unit *ir)
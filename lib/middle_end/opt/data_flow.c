@@ -5,7 +5,9 @@
  */
 
 #include "middle_end/opt/opt.h"
+#include "middle_end/ir/dom.h"
 #include "middle_end/ir/ir.h"
+#include "middle_end/ir/loop.h"
 
 static void mark_visited(bool *visited, struct ir_node *ir)
 {
@@ -23,35 +25,44 @@ static void traverse_dd_chain(bool *visited, struct ir_node *it)
     }
 }
 
-/* Walk over loop and mark statements above and below
-   in bounds of loop (up to most outer) as needed. */
+/* Mark whole most outer loop, containing given statement,
+   as needed. Jumps out of loop are needed as well, since
+   they are the way to leave it. */
 static void extend_loop(bool *visited, struct ir_node *ir)
 {
-    struct ir_node *it = ir;
-    uint64_t loop_idx = ir->meta.global_loop_idx;
-
-    /* Traverse loop upwards. */
-    while (it &&
-           it->cfg.preds.count > 0 &&
-           it->meta.global_loop_idx == loop_idx &&
-           it->meta.block_depth > 0
-    ) {
+    struct ir_loop *loop = ir_loop_outermost(ir);
+
+    if (!loop)
+        return;
+
+    vector_foreach(loop->stmts, i) {
+        struct ir_node *it = vector_at(loop->stmts, i);
+
         mark_visited(visited, it);
         traverse_dd_chain(visited, it);
-        it = it->prev;
     }
 
-    it = ir;
+    vector_foreach(loop->exits, i) {
+        struct ir_node *it = vector_at(loop->exits, i);
 
-    /* Traverse loop downwards. */
-    while (it &&
-           it->next &&
-           it->meta.global_loop_idx == loop_idx &&
-           it->meta.block_depth > 0
-    ) {
-        mark_visited(visited, it);
-        traverse_dd_chain(visited, it);
-        it = it->next;
+        if (it->type == IR_JUMP)
+            mark_visited(visited, it);
+    }
+}
+
+static void traverse_ddg(bool *visited, struct ir_node *ir);
+
+/* Conditions, on which statement is control dependent,
+   decide whether it is executed, so they are needed. */
+static void traverse_control(bool *visited, struct ir_node *ir)
+{
+    vector_foreach(ir->pdf, i) {
+        struct ir_node *cond = vector_at(ir->pdf, i);
+        if (!visited[cond->instr_idx]) {
+            mark_visited(visited, cond);
+            traverse_ddg(visited, cond);
+            traverse_control(visited, cond);
+        }
     }
 }
 
@@ -64,6 +75,7 @@ static void traverse_ddg(bool *visited, struct ir_node *ir)
         if (!visited[ddg->instr_idx]) {
             mark_visited(visited, ddg);
             extend_loop(visited, ddg);
+            traverse_control(visited, ddg);
             traverse_ddg(visited, ddg);
         }
     }
@@ -72,9 +84,24 @@ static void traverse_ddg(bool *visited, struct ir_node *ir)
 static void traverse_from_ret(bool *visited, struct ir_node *ir)
 {
     mark_visited(visited, ir);
+    traverse_control(visited, ir);
     traverse_ddg(visited, ir);
 }
 
+/* Branches of needed conditions are left together with
+   jumps, that form them. */
+static void traverse_jumps(bool *visited, struct ir_node *ir)
+{
+    for (struct ir_node *it = ir; it; it = it->next) {
+        if (it->type != IR_JUMP)
+            continue;
+
+        vector_foreach(it->pdf, i)
+            if (visited[vector_at(it->pdf, i)->instr_idx])
+                mark_visited(visited, it);
+    }
+}
+
 static void traverse(bool *visited, struct ir_node *ir)
 {
     struct ir_node *it = ir;
@@ -113,7 +140,14 @@ static void cut(bool *visited, struct ir_node *ir)
 static void ir_opt_data_flow_fn_decl(struct ir_fn_decl *ir)
 {
     bool visited[8192] = {0};
+
+    ir_dominator_tree(ir);
+    ir_post_dominator_tree(ir);
+    ir_post_dominance_frontier(ir);
+    ir_loops_build(ir);
+
     traverse(visited, ir->body);
+    traverse_jumps(visited, ir->body);
     cut(visited, ir->body);
 }
 
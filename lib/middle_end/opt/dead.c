@@ -4,328 +4,663 @@
  * This file is distributed under the MIT license.
  */
 
-/// This optimization is completely wrong.
-/// Correct dead code elimination requires more
-/// advanced techniques such as data dependence graph
-/// and SSA.
-
-#if 0
 #include "middle_end/opt/opt.h"
+#include "middle_end/ir/dom.h"
+#include "middle_end/ir/gen.h"
 #include "middle_end/ir/ir.h"
+#include "middle_end/ir/ir_ops.h"
 #include "util/alloc.h"
 #include "util/hashmap.h"
-#include "util/unreachable.h"
 #include "util/vector.h"
 #include <assert.h>
 
-struct dce_entry {
-    uint64_t instr_idx;
-    uint64_t sym_idx;
-};
+/* Aggressive dead code elimination over SSA form.
+
+   Everything is considered dead until proven live. Marking
+   starts from statements with side effects and goes through
+   use-def chains and control dependence (post-dominance
+   frontier). Then
+   - unmarked conditions are replaced with jumps to the
+     nearest marked post-dominator,
+   - other unmarked statements (except jumps) are removed,
+     or replaced with jumps, if they hold live phi nodes,
+   - code that became unreachable is removed.
+
+   Unlike conservative DCE, this removes also useless branches
+   and loops, whose computations do not affect anything.
+
+   http://www.cs.utexas.edu/~pingali/CS380C/2016/papers/ssa.pdf
+   (section 7.1) */
+
+/* Key:   ir
+   Value: 1 */
+static hashmap_t   marked;
+/* Key:   ssa_key(sym_idx, ssa_idx)
+   Value: defining statement (store or phi) */
+static hashmap_t   defs;
+/* Key:   sym_idx
+   Value: 1 if symbol is referenced by some live statement */
+static hashmap_t   referenced;
+static ir_vector_t worklist;
+
+really_inline static uint64_t ssa_key(uint64_t sym_idx, uint64_t ssa_idx)
+{
+    return (sym_idx << 32) | (ssa_idx & 0xFFFFFFFF);
+}
+
+/* Statement to which phi `ir` belongs. */
+static struct ir_node *phi_owner(struct ir_node *ir)
+{
+    while (ir->type == IR_PHI)
+        ir = ir->next;
 
-static vector_t(struct dce_entry) dead_stores;
-static vector_t(int32_t)          live_instrs;
-static hashmap_t                  alloca_stmts;
+    return ir;
+}
 
+static void mark(struct ir_node *ir)
+{
+    if (!ir || hashmap_has(&marked, (uint64_t) ir))
+        return;
 
+    hashmap_put(&marked, (uint64_t) ir, 1);
+    vector_push_back(worklist, ir);
+}
 
-static void reset_hashmap(hashmap_t *map)
+static bool is_marked(struct ir_node *ir)
 {
-    if (map->buckets) {
-        hashmap_destroy(map);
-    }
-    hashmap_init(map, 512);
+    return hashmap_has(&marked, (uint64_t) ir);
 }
 
-static void alloca_put(struct ir_node *ir)
+/**********************************************
+ **                Roots                     **
+ **********************************************/
+
+static bool store_has_side_effect(struct ir_node *ir)
 {
-    struct ir_alloca *alloca = ir->ir;
-    hashmap_put(&alloca_stmts, (uint64_t) alloca->idx, (uint64_t) ir);
+    struct ir_store *store = ir->ir;
+    struct ir_sym   *sym   = store->idx->ir;
+
+    return store->body->type == IR_FN_CALL ||
+           /* Store through pointer. */
+           sym->deref ||
+           /* Variable is located in memory (array, address taken). */
+           sym->ssa_idx == UINT64_MAX;
+}
+
+static bool has_side_effect(struct ir_node *ir)
+{
+    switch (ir->type) {
+    case IR_RET:
+    case IR_FN_CALL:
+    case IR_PUSH:
+    case IR_POP:
+        return 1;
+    case IR_STORE:
+        return store_has_side_effect(ir);
+    default:
+        return 0;
+    }
 }
 
-static int32_t alloca_get(int32_t sym_idx)
+/* Conditions, which cannot reach function exit (infinite
+   loops), have no post-dominators. Such conditions are kept. */
+static void reaching_exit(struct ir_fn_decl *decl, hashmap_t *out)
 {
-    bool ok = 0;
-    uint64_t addr = hashmap_get(&alloca_stmts, (uint64_t) sym_idx, &ok);
+    ir_vector_t w = {0};
+
+    hashmap_reset(out, 256);
+
+    for (struct ir_node *it = decl->body; it; it = it->next) {
+        if (it->type != IR_PHI && it->cfg.succs.count == 0) {
+            hashmap_put(out, (uint64_t) it, 1);
+            vector_push_back(w, it);
+        }
+    }
 
-    if (!ok)
-        weak_unreachable("Did I put alloca properly?");
+    while (w.count > 0) {
+        struct ir_node *it = vector_back(w);
+        vector_pop_back(w);
 
-    struct ir_node *ir = (struct ir_node *) addr;
+        vector_foreach(it->cfg.preds, i) {
+            struct ir_node *pred = vector_at(it->cfg.preds, i);
 
-    return ir->instr_idx;
+            if (!hashmap_has(out, (uint64_t) pred)) {
+                hashmap_put(out, (uint64_t) pred, 1);
+                vector_push_back(w, pred);
+            }
+        }
+    }
+
+    vector_free(w);
 }
 
-static bool alloca_in_this_cfg(int32_t sym_idx)
+static void defs_collect(struct ir_fn_decl *decl)
 {
-    bool ok = 0;
-    uint64_t value = hashmap_get(&alloca_stmts, sym_idx, &ok);
-    struct ir_node *ir = (struct ir_node *) value;
-    assert(ir->type == IR_ALLOCA);
-    struct ir_alloca *alloca = ir->ir;
+    hashmap_reset(&defs, 256);
+
+    for (struct ir_node *it = decl->body; it; it = it->next) {
+        if (it->type == IR_PHI) {
+            struct ir_phi *phi = it->ir;
+            hashmap_put(&defs, ssa_key(phi->sym_idx, phi->ssa_idx), (uint64_t) it);
+            continue;
+        }
 
-    return alloca->idx == sym_idx;
+        struct ir_node *def = ir_def(it);
+        if (!def)
+            continue;
+
+        struct ir_sym *sym = def->ir;
+        if (sym->ssa_idx != UINT64_MAX)
+            hashmap_put(&defs, ssa_key(sym->idx, sym->ssa_idx), (uint64_t) it);
+    }
 }
 
-static void dce_reset()
+static void mark_roots(struct ir_fn_decl *decl)
 {
-    vector_clear(dead_stores);
-    vector_clear(live_instrs);
-}
+    hashmap_t reach_exit = {0};
 
-static void dce_node(struct ir_node *ir);
+    reaching_exit(decl, &reach_exit);
 
-static void dce_put(uint64_t instr_idx, uint64_t sym_idx)
-{
-    struct dce_entry e = {
-        .instr_idx = instr_idx,
-        .sym_idx   = sym_idx
-    };
+    for (struct ir_node *it = decl->body; it; it = it->next) {
+        if (has_side_effect(it))
+            mark(it);
+
+        if (it->type == IR_COND && !hashmap_has(&reach_exit, (uint64_t) it))
+            mark(it);
+    }
 
-    vector_push_back(dead_stores, e);
+    hashmap_destroy(&reach_exit);
 }
 
-/// This code is totally eliminated, when should not.
-///
-/// int main() {
-///     int b = 2; /// Thrown out (wrong).
-///     int a = 1; /// Thrown out (wrong).
-///     int c = 3;
-/// 
-///     if (a + b) {
-///         c = 4;
-///     } else {
-///         b = 5; // Thrown out (wrong).
-///     }
-/// 
-///     return b;
-/// }
-static void dce_keep_alive_last(uint64_t sym_idx)
+/**********************************************
+ **               Propagation                **
+ **********************************************/
+
+static void mark_def(uint64_t sym_idx, uint64_t ssa_idx)
 {
-    int32_t alloca_idx = 0;
-    int32_t live_idx   = 0;
-    bool     found     = 0;
+    hashmap_put(&referenced, sym_idx, 1);
 
-    vector_foreach(dead_stores, i) {
-        struct dce_entry e = vector_at(dead_stores, i);
+    if (ssa_idx == UINT64_MAX)
+        return;
 
-        if (e.sym_idx == sym_idx && alloca_in_this_cfg(e.sym_idx)) {
-            alloca_idx = alloca_get(sym_idx);
-            live_idx = e.instr_idx;
-            found = 1;
-            break;
-            // printf("Entry (%ld, %ld)\n", e.instr_idx, e.sym_idx);
-        }
-    }
+    bool     ok   = 0;
+    uint64_t addr = hashmap_get(&defs, ssa_key(sym_idx, ssa_idx), &ok);
 
-    if (!found) return;
+    if (ok)
+        mark((struct ir_node *) addr);
+}
+
+static void mark_use(struct ir_node *ir, unused void *data)
+{
+    struct ir_sym *sym = ir->ir;
 
-    vector_push_back(live_instrs, live_idx);
-    vector_push_back(live_instrs, alloca_idx);
+    mark_def(sym->idx, sym->ssa_idx);
 }
 
+static void mark_control_dependence(struct ir_node *ir)
+{
+    vector_foreach(ir->pdf, i)
+        mark(vector_at(ir->pdf, i));
+}
 
-static void dce_store(struct ir_node *ir)
+/* Value of phi depends on through which edge control
+   came to the statement. So branches deciding that are
+   needed. */
+static void mark_phi(struct ir_node *ir)
 {
-    struct ir_store *store = ir->ir;
+    struct ir_phi  *phi   = ir->ir;
+    struct ir_node *owner = phi_owner(ir);
 
-    if (store->idx->type != IR_SYM)
-        return;
+    hashmap_put(&referenced, phi->sym_idx, 1);
 
-    struct ir_sym *sym = store->idx->ir;
-    dce_put(ir->instr_idx, sym->idx);
+    for (uint64_t i = 0; i < phi->args_size; ++i) {
+        struct ir_node *pred = phi->args[i].pred;
 
-    switch (store->body->type) {
-    case IR_IMM: {
-        break;
-    }
-    case IR_SYM: {
-        struct ir_sym *body = store->body->ir;
-        dce_keep_alive_last(body->idx);
-        break;
+        if (phi->args[i].ssa_idx >= 0)
+            mark_def(phi->sym_idx, phi->args[i].ssa_idx);
+
+        if (pred->type == IR_COND)
+            mark(pred);
+        else
+            mark_control_dependence(pred);
     }
-    case IR_BIN:
-        dce_node(store->body);
-        break;
-    default:
-        break;
+
+    mark_control_dependence(owner);
+}
+
+static void propagate()
+{
+    while (worklist.count > 0) {
+        struct ir_node *it = vector_back(worklist);
+        vector_pop_back(worklist);
+
+        if (it->type == IR_PHI) {
+            mark_phi(it);
+            continue;
+        }
+
+        ir_foreach_use(it, mark_use, NULL);
+
+        struct ir_node *def = ir_def(it);
+        if (def)
+            hashmap_put(&referenced, ((struct ir_sym *) def->ir)->idx, 1);
+
+        mark_control_dependence(it);
     }
 }
 
+/**********************************************
+ **        Phi operands preservation         **
+ **********************************************/
+
+/* Phi operands are bound to predecessors. Since this pass
+   changes CFG, operands are matched against new
+   predecessors. New predecessor inherits operand of old
+   predecessor, through which it reached the statement in
+   the original CFG.
+
+   Old operands stay valid, since they are allocated in
+   the arena, which is freed only with the whole IR. */
+struct phi_entry {
+    struct ir_node    *phi;
+    /* Statement phi belonged to before changes. */
+    struct ir_node    *owner;
+    struct ir_phi_arg *args;
+    uint64_t           args_size;
+};
 
+static vector_t(struct phi_entry) phi_entries;
+/* Key:   ir
+   Value: ir_vector_t * with CFG successors before changes */
+static hashmap_t                  old_succs;
 
-static void dce_ret(struct ir_node *ir)
+static void phi_entries_save(struct ir_fn_decl *decl)
 {
-    struct ir_ret *ret = ir->ir;
+    hashmap_reset(&old_succs, 256);
+
+    for (struct ir_node *it = decl->body; it; it = it->next) {
+        if (it->type != IR_PHI) {
+            ir_vector_t *succs = weak_calloc(1, sizeof (ir_vector_t));
+            vector_foreach(it->cfg.succs, i)
+                vector_push_back(*succs, vector_at(it->cfg.succs, i));
+            hashmap_put(&old_succs, (uint64_t) it, (uint64_t) succs);
+            continue;
+        }
 
-    if (!ret->body)
-        return;
+        struct ir_phi   *phi = it->ir;
+        struct phi_entry e   = {
+            .phi       = it,
+            .owner     = phi_owner(it),
+            .args      = phi->args,
+            .args_size = phi->args_size
+        };
 
-    if (ret->body->type != IR_SYM)
-        return;
+        vector_push_back(phi_entries, e);
+    }
+}
+
+/* Operand of old predecessor of `owner` through which
+   `from` was reaching `owner`. */
+static struct ir_phi_arg *old_arg(struct phi_entry *e, struct ir_node *from)
+{
+    hashmap_t          visited = {0};
+    ir_vector_t        w       = {0};
+    struct ir_phi_arg *arg     = NULL;
+
+    hashmap_init(&visited, 64);
+    vector_push_back(w, from);
+
+    while (w.count > 0 && !arg) {
+        struct ir_node *it = vector_back(w);
+        vector_pop_back(w);
+
+        for (uint64_t i = 0; i < e->args_size; ++i)
+            if (e->args[i].pred == it)
+                arg = &e->args[i];
+
+        if (arg)
+            break;
+
+        bool         ok    = 0;
+        ir_vector_t *succs = (ir_vector_t *) hashmap_get(&old_succs, (uint64_t) it, &ok);
 
-    struct ir_sym *sym = ret->body->ir;
+        if (!ok)
+            continue;
 
-    dce_keep_alive_last(sym->idx);
-    /// We always keep return statement because we are
-    /// focused on arithmetic instructions. Eliminating
-    /// returns is really control flow optimizations job.
-    vector_push_back(live_instrs, ir->instr_idx);
+        vector_foreach(*succs, i) {
+            struct ir_node *succ = vector_at(*succs, i);
+
+            if (succ == e->owner || hashmap_has(&visited, (uint64_t) succ))
+                continue;
+
+            hashmap_put(&visited, (uint64_t) succ, 1);
+            vector_push_back(w, succ);
+        }
+    }
+
+    vector_free(w);
+    hashmap_destroy(&visited);
+
+    return arg;
 }
 
-static void dce_bin(struct ir_node *ir)
+static void phi_entry_restore(struct phi_entry *e)
 {
-    struct ir_bin *bin = ir->ir;
+    struct ir_phi  *phi   = e->phi->ir;
+    struct ir_node *owner = phi_owner(e->phi);
+
+    ir_phi_args_reset(phi, owner->cfg.preds.count);
+
+    vector_foreach(owner->cfg.preds, i) {
+        struct ir_node    *pred = vector_at(owner->cfg.preds, i);
+        struct ir_phi_arg *arg  = old_arg(e, pred);
 
-    if (bin->lhs->type == IR_SYM) {
-        struct ir_sym *sym = bin->lhs->ir;
-        dce_keep_alive_last(sym->idx);
+        phi->args[i].pred    = pred;
+        phi->args[i].ssa_idx = arg ? arg->ssa_idx : -1;
     }
+}
 
-    if (bin->rhs->type == IR_SYM) {
-        struct ir_sym *sym = bin->rhs->ir;
-        dce_keep_alive_last(sym->idx);
+static void phi_entries_restore(hashmap_t *removed)
+{
+    vector_foreach(phi_entries, i) {
+        struct phi_entry *e = &vector_at(phi_entries, i);
+
+        if (!hashmap_has(removed, (uint64_t) e->phi))
+            phi_entry_restore(e);
+    }
+
+    hashmap_foreach(&old_succs, k, v) {
+        (void) k;
+        vector_free(*(ir_vector_t *) v);
+        weak_free((ir_vector_t *) v);
     }
+
+    vector_free(phi_entries);
+    hashmap_destroy(&old_succs);
 }
 
-static void dce_fcall(struct ir_node *ir)
+/**********************************************
+ **                 Sweep                    **
+ **********************************************/
+
+/* Statement with live phi nodes can be removed only if phi
+   nodes can be moved to the next statement without changing
+   their incoming edges. */
+static bool removable(struct ir_node *ir, bool live_phi)
 {
-    /// Not our optimization case.
-    vector_push_back(live_instrs, ir->instr_idx);
+    if (!live_phi)
+        return 1;
+
+    if (ir->cfg.succs.count != 1)
+        return 0;
+
+    struct ir_node *succ = vector_at(ir->cfg.succs, 0);
+
+    return succ == ir_next_stmt(ir) && succ->cfg.preds.count == 1;
 }
 
-static void dce_cond(struct ir_node *ir)
+static void sweep_alloca(struct ir_node *ir, hashmap_t *removed)
 {
-    struct ir_cond *cond = ir->ir;
-    dce_node(cond->cond);
-    /// Not our optimization case.
-    vector_push_back(live_instrs, ir->instr_idx);
+    uint64_t idx = ir->type == IR_ALLOCA
+        ? ((struct ir_alloca *) ir->ir)->idx
+        : ((struct ir_alloca_array *) ir->ir)->idx;
+
+    if (!hashmap_has(&referenced, idx))
+        hashmap_put(removed, (uint64_t) ir, 1);
 }
 
-static void dce_jmp(struct ir_node *ir)
+/* Rewrite condition to the jump to its nearest marked
+   post-dominator. All statements in between are useless. */
+static void sweep_cond(struct ir_node *ir)
 {
-    struct ir_jump *jmp = ir->ir;
-    /// Not our optimization case.
-    vector_push_back(live_instrs, ir->instr_idx);
-    /// I am not sure.
-    vector_push_back(live_instrs, jmp->target->instr_idx);
+    struct ir_node *pdom = ir->ipdom;
+
+    while (pdom && !is_marked(pdom))
+        pdom = pdom->ipdom;
+
+    /* Guaranteed by marking: condition, which is not
+       post-dominated by live statement, is control
+       dependence for two different returns. */
+    assert(pdom);
+
+    struct ir_jump *jump = weak_calloc(1, sizeof (struct ir_jump));
+    jump->idx = pdom->instr_idx;
+    jump->target = pdom;
+
+    struct ir_cond *cond = ir->ir;
+    ir_node_cleanup(cond->cond);
+    weak_free(cond);
+
+    ir->type = IR_JUMP;
+    ir->ir = jump;
 }
 
+/* Statement with live phi nodes, which cannot be removed,
+   is rewritten to the jump to its successor. Phi nodes keep
+   their incoming edges, while the statement itself no longer
+   refers to symbols, whose allocas may be removed. */
+static void sweep_stmt(struct ir_node *ir)
+{
+    assert(ir->type == IR_STORE);
+    assert(ir->cfg.succs.count == 1);
 
+    struct ir_node *succ = vector_at(ir->cfg.succs, 0);
+    struct ir_jump *jump = weak_calloc(1, sizeof (struct ir_jump));
+    jump->idx = succ->instr_idx;
+    jump->target = succ;
+
+    struct ir_store *store = ir->ir;
+    ir_node_cleanup(store->idx);
+    ir_node_cleanup(store->body);
+    weak_free(store);
 
-static void dce_node(struct ir_node *ir)
+    ir->type = IR_JUMP;
+    ir->ir = jump;
+}
+
+static void sweep_mark(struct ir_fn_decl *decl, hashmap_t *removed)
 {
-    switch (ir->type) {
-    case IR_ALLOCA:
-        alloca_put(ir);
-        break;
-    case IR_IMM:
-    case IR_SYM:
-    case IR_JUMP:
-        dce_jmp(ir);
-    case IR_MEMBER:
-    case IR_TYPE_DECL:
-    case IR_FUNC_DECL:
-    case IR_FUNC_CALL:
-        dce_fcall(ir);
-        break;
-    case IR_STORE:
-        dce_store(ir);
-        break;
-    case IR_BIN:
-        dce_bin(ir);
-        break;
-    case IR_RET:
-        dce_ret(ir);
-        break;
-    case IR_COND:
-        dce_cond(ir);
-        break;
-    default:
-        weak_unreachable("Unknown IR type (numeric: %d).", ir->type);
+    /* Phi nodes first, to know then which statements
+       still have them. */
+    for (struct ir_node *it = decl->body; it; it = it->next)
+        if (it->type == IR_PHI && !is_marked(it))
+            hashmap_put(removed, (uint64_t) it, 1);
+
+    /* Live phi nodes of removed statement are moved to the
+       next one. */
+    bool moved = 0;
+
+    for (struct ir_node *it = decl->body; it; it = it->next) {
+        if (it->type == IR_PHI)
+            continue;
+
+        bool live_phi = moved;
+        for (struct ir_node *p = it->prev; p && p->type == IR_PHI; p = p->prev)
+            live_phi |= !hashmap_has(removed, (uint64_t) p);
+
+        moved = 0;
+
+        if (is_marked(it))
+            continue;
+
+        switch (it->type) {
+        case IR_ALLOCA:
+        case IR_ALLOCA_ARRAY:
+            if (removable(it, live_phi))
+                sweep_alloca(it, removed);
+            break;
+        case IR_COND:
+            sweep_cond(it);
+            break;
+        case IR_JUMP:
+            break;
+        default:
+            if (removable(it, live_phi))
+                hashmap_put(removed, (uint64_t) it, 1);
+            else
+                sweep_stmt(it);
+            break;
+        }
+
+        moved = live_phi && hashmap_has(removed, (uint64_t) it);
     }
 }
 
-static void dce(struct ir_node *start)
+/* Remove statements not reachable from function entry. */
+static void sweep_unreachable(struct ir_fn_decl *decl, hashmap_t *removed)
 {
-    struct ir_node *it = start;
-    uint64_t cfg_no = 0;
+    hashmap_t   visited = {0};
+    ir_vector_t w       = {0};
 
-    reset_hashmap(&alloca_stmts, 512);
-
-    while (it) {
-//        bool should_reset = 0;
-//        should_reset |= it == start;
-//        should_reset |= cfg_no != it->cfg_block_no;
+    hashmap_init(&visited, 256);
+    hashmap_put(&visited, (uint64_t) decl->body, 1);
+    vector_push_back(w, decl->body);
 
-//        if (should_reset)
-//            dce_reset();
+    while (w.count > 0) {
+        struct ir_node *it = vector_back(w);
+        vector_pop_back(w);
 
-        dce_node(it);
+        vector_foreach(it->cfg.succs, i) {
+            struct ir_node *succ = vector_at(it->cfg.succs, i);
 
-        /*
-        if (!it->next || it->next->cfg_block_no != cfg_no) {
-            vector_foreach(live_instrs, i) {
-                uint64_t instr_idx = vector_at(live_instrs, i);
-                printf("Keep alive entry at idx %ld\n", instr_idx);
+            if (!hashmap_has(&visited, (uint64_t) succ)) {
+                hashmap_put(&visited, (uint64_t) succ, 1);
+                vector_push_back(w, succ);
             }
-            printf("\n");
         }
-        */
-
-//        cfg_no = it->cfg_block_no;
-        it = it->next;
     }
+
+    for (struct ir_node *it = decl->body; it; it = it->next)
+        if (!hashmap_has(&visited, (uint64_t) phi_owner(it)))
+            hashmap_put(removed, (uint64_t) it, 1);
+
+    vector_free(w);
+    hashmap_destroy(&visited);
 }
 
-static void remove_node(struct ir_node **ir, struct ir_node **head)
+static struct ir_node *first_alive(struct ir_node *ir, hashmap_t *removed)
 {
-    /// Note: conditional statements is never removed, so
-    ///       *next_else and *prev_else are unused.
-    if ((*ir)->next) {
-        (*ir)->next->prev = (*ir)->prev;
+    while (ir && (ir->type == IR_PHI || hashmap_has(removed, (uint64_t) ir)))
+        ir = ir->next;
+
+    return ir;
+}
+
+/* Jumps to removed statements are redirected to the next
+   statement left. Then removed statements are unlinked
+   from IR list, but not freed, since they still are
+   referred from old CFG. */
+static void sweep(struct ir_fn_decl *decl, hashmap_t *removed, ir_vector_t *garbage)
+{
+    struct ir_node *it = decl->body;
+
+    for (; it; it = it->next) {
+        if (hashmap_has(removed, (uint64_t) it))
+            continue;
+
+        if (it->type == IR_JUMP) {
+            struct ir_jump *jump = it->ir;
+            jump->target = first_alive(jump->target, removed);
+            assert(jump->target);
+            jump->idx = jump->target->instr_idx;
+        }
+
+        if (it->type == IR_COND) {
+            struct ir_cond *cond = it->ir;
+            cond->target = first_alive(cond->target, removed);
+            assert(cond->target);
+            cond->goto_label = cond->target->instr_idx;
+        }
     }
 
-    if ((*ir)->prev) {
-        (*ir)->prev->next = (*ir)->next;
-    } else {
-        (*ir) = (*ir)->next;
-        (*head) = (*ir);
+    it = decl->body;
+
+    while (it) {
+        struct ir_node *next = it->next;
+
+        if (hashmap_has(removed, (uint64_t) it)) {
+            if (it->prev)
+                it->prev->next = it->next;
+            else
+                decl->body = it->next;
+
+            if (it->next)
+                it->next->prev = it->prev;
+
+            vector_push_back(*garbage, it);
+        }
+
+        it = next;
     }
 }
 
-static int qsort_cmp(const void *lhs, const void *rhs)
+/* Data dependence edges to removed statements are dropped,
+   dominator information is computed again for the new CFG. */
+static void analysis_update(struct ir_fn_decl *decl, hashmap_t *removed)
 {
-    return *(int32_t *) lhs - *(int32_t *) rhs;
+    for (struct ir_node *it = decl->body; it; it = it->next) {
+        ir_vector_t *ddgs = &it->ddg_stmts;
+
+        for (uint64_t i = 0; i < ddgs->count; ) {
+            if (hashmap_has(removed, (uint64_t) vector_at(*ddgs, i)))
+                vector_erase(*ddgs, i);
+            else
+                ++i;
+        }
+    }
+
+    ir_dominator_tree(decl);
+    ir_dominance_frontier(decl);
+    ir_post_dominator_tree(decl);
+    ir_post_dominance_frontier(decl);
 }
 
-static void cut(struct ir_node **ir)
+static void ir_opt_dce_fn_decl(struct ir_fn_decl *decl)
 {
-    struct ir_node *it = *ir;
+    hashmap_t   removed = {0};
+    ir_vector_t garbage = {0};
 
-    qsort(live_instrs.data, live_instrs.count, sizeof (int32_t), qsort_cmp);
+    hashmap_init(&removed, 256);
+    hashmap_reset(&marked, 256);
+    hashmap_reset(&referenced, 256);
 
-    while (it) {
-        struct ir_node *next_node = it->next;
+    ir_post_dominator_tree(decl);
+    ir_post_dominance_frontier(decl);
 
-        int32_t *instr = bsearch(
-            &it->instr_idx,
-            live_instrs.data,
-            live_instrs.count,
-            sizeof (int32_t),
-            qsort_cmp
-        );
+    defs_collect(decl);
+    mark_roots(decl);
+    propagate();
 
-        if (instr == NULL)
-            remove_node(&it, ir);
+    phi_entries_save(decl);
 
-        it = next_node;
-    }
+    sweep_mark(decl, &removed);
+    sweep(decl, &removed, &garbage);
+    ir_cfg_build(decl);
+
+    sweep_unreachable(decl, &removed);
+    sweep(decl, &removed, &garbage);
+    ir_cfg_build(decl);
+
+    phi_entries_restore(&removed);
+    analysis_update(decl, &removed);
+
+    vector_foreach(garbage, i)
+        ir_node_cleanup(vector_at(garbage, i));
+
+    vector_free(garbage);
+    vector_free(worklist);
+    hashmap_destroy(&removed);
+    hashmap_destroy(&marked);
+    hashmap_destroy(&referenced);
+    hashmap_destroy(&defs);
 }
 
-void ir_opt_dead_code_elimination(struct ir_func_decl *decl)
+void ir_opt_dce(struct ir_unit *ir)
 {
-    dce(decl->body);
-    cut(&decl->body);
+    struct ir_node *it = ir->fn_decls;
+
+    while (it) {
+        ir_opt_dce_fn_decl(it->ir);
+        it = it->next;
+    }
 }
-#endif // 0
\ No newline at end of file
@@ -4,7 +4,9 @@
  * This file is distributed under the MIT license.
  */
 
+#include "middle_end/ir/dom.h"
 #include "middle_end/ir/ir.h"
+#include "middle_end/ir/loop.h"
 #include "middle_end/ir/meta.h"
 #include "middle_end/opt/opt.h"
 #include "util/compiler.h"
@@ -21,7 +23,6 @@ static hashmap_t loop_dependent_stmts;
 static void fold_opt_reset()
 {
     hashmap_reset(&consts_mapping, 256);
-    hashmap_reset(&loop_dependent_stmts, 256);
 }
 
 static void consts_mapping_add(uint64_t idx, uint64_t value)
@@ -109,6 +110,7 @@ static int32_t fold_ints(enum token_type op, int32_t l, int32_t r)
     case TOK_STAR:    return l  * r;
     case TOK_SLASH:   return l  / r;
     case TOK_MOD:     return l  % r;
+    case TOK_MULHI:   return ((int64_t) l * r) >> 32;
     case TOK_ASSIGN:  return -1;
     default:
         weak_unreachable("Unknown token type `%s`.", tok_to_string(op));
@@ -186,27 +188,18 @@ static struct ir_node *fold_imm(struct ir_imm *ir)
     return ir_imm_int_init(ir->imm.__int);
 }
 
-static bool fold_store_mark_loop_dependent(struct ir_node *ir)
+static bool fold_store_loop_dependent(struct ir_node *ir)
 {
     struct ir_store *store = ir->ir;
 
-    if (ir->meta.sym.loop) {
-        loop_dependent_put(get_store_idx(store->idx), ir->meta.sym.loop_idx);
-        __weak_debug_msg("Added loop-dependent variable (loop attr) %p. Return\n", store->idx);
-        return 1;
-    }
-    return 0;
+    return loop_dependent(get_store_idx(store->idx));
 }
 
 static void fold_store_bin(struct ir_node *ir)
 {
     struct ir_store *store = ir->ir;
 
-    if (ir->meta.kind != IR_META_UNKNOWN)
-        if (fold_store_mark_loop_dependent(ir))
-            return;
-
-    if (loop_dependent(get_store_idx(store->idx)))
+    if (fold_store_loop_dependent(ir))
         return;
 
     struct ir_node *folded = fold_node(store->body);
@@ -237,9 +230,8 @@ static void fold_store_sym(struct ir_node *ir)
     struct ir_store *store = ir->ir;
     struct ir_sym *sym = store->body->ir;
 
-    if (ir->meta.kind != IR_META_UNKNOWN)
-        if (fold_store_mark_loop_dependent(ir))
-            return;
+    if (fold_store_loop_dependent(ir))
+        return;
 
     if (consts_mapping_is_const(sym->idx)) {
         union ir_imm_val imm = consts_mapping_get(sym->idx);
@@ -260,9 +252,8 @@ static void fold_store_imm(struct ir_node *ir)
     struct ir_store *store = ir->ir;
     struct ir_imm   *imm = store->body->ir;
 
-    if (ir->meta.kind != IR_META_UNKNOWN)
-        if (fold_store_mark_loop_dependent(ir))
-            return;
+    if (fold_store_loop_dependent(ir))
+        return;
 
     if (consts_mapping_is_const(get_store_idx(store->idx))) {
         consts_mapping_update(get_store_idx(store->idx), imm->imm.__int);
@@ -429,11 +420,62 @@ static struct ir_node *fold_node(struct ir_node *ir)
     return no_result();
 }
 
+/* Variable, assigned inside loop and somewhere else (or
+   being a parameter), changes from one iteration to
+   another, so it is never folded. Variables with the only
+   assignment are safe to fold. */
+static void loop_dependent_collect(struct ir_fn_decl *decl)
+{
+    /* Key:   sym_idx
+       Value: number of definitions */
+    hashmap_t defs = {0};
+
+    hashmap_init(&defs, 256);
+    hashmap_reset(&loop_dependent_stmts, 256);
+
+    ir_dominator_tree(decl);
+    ir_loops_build(decl);
+
+    for (struct ir_node *it = decl->args; it; it = it->next)
+        if (it->type == IR_ALLOCA)
+            hashmap_put(&defs, ((struct ir_alloca *) it->ir)->idx, 1);
+
+    for (struct ir_node *it = decl->body; it; it = it->next) {
+        struct ir_node *def = ir_def(it);
+        if (!def)
+            continue;
+
+        bool     ok  = 0;
+        uint64_t idx = get_store_idx(def);
+        uint64_t n   = hashmap_get(&defs, idx, &ok);
+
+        hashmap_put(&defs, idx, ok ? n + 1 : 1);
+    }
+
+    for (struct ir_node *it = decl->body; it; it = it->next) {
+        struct ir_loop *loop = ir_loop_of(it);
+        struct ir_node *def  = ir_def(it);
+
+        if (!loop || !def)
+            continue;
+
+        bool     ok  = 0;
+        uint64_t idx = get_store_idx(def);
+
+        if (hashmap_get(&defs, idx, &ok) > 1)
+            loop_dependent_put(idx, loop->header->instr_idx);
+    }
+
+    hashmap_destroy(&defs);
+}
+
 static void ir_opt_fold_fn_decl(struct ir_fn_decl *decl)
 {
     struct ir_node *it = decl->body;
     uint64_t cfg_no = 0;
 
+    loop_dependent_collect(decl);
+
     while (it) {
         bool should_reset = 0;
         should_reset |= it == decl->body;
@@ -0,0 +1,439 @@
+/* gvn.c - Global value numbering.
+ * Copyright (C) 2024 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#include "middle_end/opt/opt.h"
+#include "middle_end/ir/dom.h"
+#include "middle_end/ir/ir.h"
+#include "middle_end/ir/ir_ops.h"
+#include "util/hashmap.h"
+#include "util/vector.h"
+#include <string.h>
+
+/* Dominator-based value numbering over SSA form.
+
+   Dominator tree is walked in preorder. Each binary
+   expression is hashed by its operator, value numbers of
+   operands and type. If the same expression is already
+   available in some dominating statement, current one is
+   replaced with copy of its result, and uses of current
+   value are rewritten to the available one. Table of
+   available expressions is scoped, so expressions leave
+   it, when walk leaves their dominator subtree.
+
+   Expressions reading memory (dereference, address of
+   mutable variable) are never numbered.
+
+   https://www.cs.tufts.edu/~nr/cs257/archive/keith-cooper/value-numbering.pdf */
+
+/* Value numbers of immediates are tagged with this bit
+   to not be confused with variables. */
+#define GVN_IMM_TAG   (1ULL << 63)
+/* Symbol is not suitable for numbering. */
+#define GVN_NO_NUMBER UINT64_MAX
+/* Expression with such hash is not available. */
+#define GVN_NO_EXPR   UINT64_MAX
+
+struct gvn_expr {
+    enum token_type op;
+    uint64_t        lhs;
+    uint64_t        rhs;
+    enum data_type  dt;
+    uint64_t        ptr_depth;
+    /* Value number of result. */
+    uint64_t        value;
+    /* Index of shadowed entry with the same hash or -1. */
+    int64_t         shadowed;
+    uint64_t        hash;
+};
+
+/* Available expressions from root of dominator tree
+   to current statement. */
+static vector_t(struct gvn_expr) exprs;
+/* Key:   hash of expression
+   Value: index of last such expression in `exprs` or
+          GVN_NO_EXPR. Keys are never removed: hashmap
+          leaves deleted entries in probe chains, so the
+          table would fill up with them after many scopes. */
+static hashmap_t                 exprs_map;
+/* Key:   value_key(sym_idx, ssa_idx)
+   Value: value number, which is key of
+          representative value */
+static hashmap_t                 numbers;
+/* Key:   sym_idx
+   Value: 1 if symbol without SSA version can change,
+          so cannot be numbered */
+static hashmap_t                 unstable;
+/* Key:   sym_idx
+   Value: 1 if symbol is an array */
+static hashmap_t                 arrays;
+
+really_inline static uint64_t value_key(uint64_t sym_idx, uint64_t ssa_idx)
+{
+    return (sym_idx << 32) | (ssa_idx & 0xFFFFFFFF);
+}
+
+/**********************************************
+ **              Value numbers               **
+ **********************************************/
+
+static void unstable_collect_use(struct ir_node *ir, unused void *data)
+{
+    struct ir_sym *sym = ir->ir;
+
+    if (sym->addr_of)
+        hashmap_put(&unstable, sym->idx, 1);
+}
+
+/* Symbols without SSA version are parameters at entry,
+   arrays and variables in memory. Only first two are
+   stable values. */
+static void unstable_collect(struct ir_fn_decl *decl)
+{
+    hashmap_reset(&unstable, 64);
+    hashmap_reset(&arrays, 64);
+
+    for (struct ir_node *it = decl->body; it; it = it->next) {
+        if (it->type == IR_ALLOCA_ARRAY) {
+            struct ir_alloca_array *alloca = it->ir;
+            hashmap_put(&arrays, alloca->idx, 1);
+        }
+
+        ir_foreach_use(it, unstable_collect_use, NULL);
+
+        struct ir_node *def = ir_def(it);
+        if (!def)
+            continue;
+
+        struct ir_sym *sym = def->ir;
+        if (sym->ssa_idx == UINT64_MAX)
+            hashmap_put(&unstable, sym->idx, 1);
+    }
+}
+
+static uint64_t sym_number(struct ir_node *ir)
+{
+    struct ir_sym *sym = ir->ir;
+
+    if (sym->deref || sym->addr_of)
+        return GVN_NO_NUMBER;
+
+    if (sym->ssa_idx == UINT64_MAX && hashmap_has(&unstable, sym->idx))
+        return GVN_NO_NUMBER;
+
+    bool     ok  = 0;
+    uint64_t key = value_key(sym->idx, sym->ssa_idx);
+    uint64_t vn  = hashmap_get(&numbers, key, &ok);
+
+    return ok ? vn : key;
+}
+
+static uint64_t imm_number(struct ir_node *ir)
+{
+    struct ir_imm *imm  = ir->ir;
+    uint64_t       bits = 0;
+
+    switch (imm->type) {
+    case IMM_BOOL:  bits = imm->imm.__bool; break;
+    case IMM_CHAR:  bits = (uint8_t) imm->imm.__char; break;
+    case IMM_FLOAT: memcpy(&bits, &imm->imm.__float, sizeof (float)); break;
+    case IMM_INT:   bits = (uint32_t) imm->imm.__int; break;
+    }
+
+    return GVN_IMM_TAG | ((uint64_t) imm->type << 32) | bits;
+}
+
+static uint64_t number(struct ir_node *ir)
+{
+    switch (ir->type) {
+    case IR_SYM: return sym_number(ir);
+    case IR_IMM: return imm_number(ir);
+    default:     return GVN_NO_NUMBER;
+    }
+}
+
+/* Value of `def` is known to be `vn`. */
+static void number_set(struct ir_node *def, uint64_t vn)
+{
+    struct ir_sym *sym = def->ir;
+
+    hashmap_put(&numbers, value_key(sym->idx, sym->ssa_idx), vn);
+}
+
+/* Immediates have no representative variable, so they are
+   never propagated. Array value is its address, but
+   dereference of array symbol reads its memory, so
+   array is not propagated into dereference. */
+static void use_rewrite(struct ir_node *ir, unused void *data)
+{
+    struct ir_sym *sym = ir->ir;
+
+    if (sym->addr_of || sym->ssa_idx == UINT64_MAX)
+        return;
+
+    bool     ok = 0;
+    uint64_t vn = hashmap_get(&numbers, value_key(sym->idx, sym->ssa_idx), &ok);
+
+    if (!ok || (vn & GVN_IMM_TAG))
+        return;
+
+    if (sym->deref && hashmap_has(&arrays, vn >> 32))
+        return;
+
+    sym->idx     = vn >> 32;
+    sym->ssa_idx = (vn & 0xFFFFFFFF) == 0xFFFFFFFF ? UINT64_MAX : (vn & 0xFFFFFFFF);
+}
+
+/**********************************************
+ **          Available expressions           **
+ **********************************************/
+
+static bool commutative(enum token_type op)
+{
+    switch (op) {
+    case TOK_PLUS:
+    case TOK_STAR:
+    case TOK_MULHI:
+    case TOK_BIT_AND:
+    case TOK_BIT_OR:
+    case TOK_XOR:
+    case TOK_AND:
+    case TOK_OR:
+    case TOK_EQ:
+    case TOK_NEQ:
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+static uint64_t expr_hash(struct gvn_expr *e)
+{
+    uint64_t h = 14695981039346656037ULL;
+
+    h = (h ^ e->op)        * 1099511628211ULL;
+    h = (h ^ e->lhs)       * 1099511628211ULL;
+    h = (h ^ e->rhs)       * 1099511628211ULL;
+    h = (h ^ e->dt)        * 1099511628211ULL;
+    h = (h ^ e->ptr_depth) * 1099511628211ULL;
+
+    return h;
+}
+
+static bool expr_eq(struct gvn_expr *l, struct gvn_expr *r)
+{
+    return l->op        == r->op
+        && l->lhs       == r->lhs
+        && l->rhs       == r->rhs
+        && l->dt        == r->dt
+        && l->ptr_depth == r->ptr_depth;
+}
+
+static struct gvn_expr *expr_find(struct gvn_expr *e)
+{
+    bool     ok  = 0;
+    uint64_t got = hashmap_get(&exprs_map, e->hash, &ok);
+    int64_t  idx = (int64_t) got;
+
+    if (!ok || got == GVN_NO_EXPR)
+        return NULL;
+
+    while (idx >= 0) {
+        struct gvn_expr *it = &vector_at(exprs, idx);
+
+        if (expr_eq(it, e))
+            return it;
+
+        idx = it->shadowed;
+    }
+
+    return NULL;
+}
+
+static void expr_push(struct gvn_expr *e)
+{
+    bool     ok  = 0;
+    uint64_t idx = hashmap_get(&exprs_map, e->hash, &ok);
+
+    e->shadowed = ok && idx != GVN_NO_EXPR ? (int64_t) idx : -1;
+
+    hashmap_put(&exprs_map, e->hash, exprs.count);
+    vector_push_back(exprs, *e);
+}
+
+/* Drop expressions above `size`, restoring what they
+   shadowed. */
+static void exprs_pop(uint64_t size)
+{
+    while (exprs.count > size) {
+        struct gvn_expr *e = &vector_back(exprs);
+
+        hashmap_put(&exprs_map, e->hash, e->shadowed >= 0 ? (uint64_t) e->shadowed : GVN_NO_EXPR);
+
+        vector_pop_back(exprs);
+    }
+}
+
+/**********************************************
+ **               Statements                 **
+ **********************************************/
+
+static bool expr_make(struct ir_store *store, struct gvn_expr *e)
+{
+    struct ir_bin *bin = store->body->ir;
+    struct ir_sym *sym = store->idx->ir;
+
+    e->op        = bin->op;
+    e->lhs       = number(bin->lhs);
+    e->rhs       = number(bin->rhs);
+    e->dt        = sym->type_info.dt;
+    e->ptr_depth = sym->type_info.ptr_depth;
+
+    if (e->lhs == GVN_NO_NUMBER || e->rhs == GVN_NO_NUMBER)
+        return 0;
+
+    if (commutative(e->op) && e->lhs > e->rhs) {
+        uint64_t tmp = e->lhs;
+        e->lhs = e->rhs;
+        e->rhs = tmp;
+    }
+
+    e->hash = expr_hash(e);
+
+    return 1;
+}
+
+/* Replace `t1 = a + b` with `t1 = t0`, where `t0` is an
+   available value of the same expression. */
+static void store_replace(struct ir_store *store, uint64_t vn)
+{
+    struct ir_node *sym = ir_sym_init(vn >> 32);
+    struct ir_sym  *s   = sym->ir;
+    struct ir_sym  *def = store->idx->ir;
+
+    s->ssa_idx   = (vn & 0xFFFFFFFF) == 0xFFFFFFFF ? UINT64_MAX : (vn & 0xFFFFFFFF);
+    s->type_info = def->type_info;
+
+    ir_node_cleanup(store->body);
+    store->body = sym;
+}
+
+static void visit_store(struct ir_node *ir)
+{
+    struct ir_store *store = ir->ir;
+    struct ir_sym   *def   = store->idx->ir;
+
+    if (def->deref || def->ssa_idx == UINT64_MAX)
+        return;
+
+    if (store->body->type == IR_SYM || store->body->type == IR_IMM) {
+        uint64_t vn = number(store->body);
+        if (vn != GVN_NO_NUMBER)
+            number_set(store->idx, vn);
+        return;
+    }
+
+    if (store->body->type != IR_BIN)
+        return;
+
+    struct gvn_expr  e     = {0};
+    struct gvn_expr *avail = NULL;
+
+    if (!expr_make(store, &e))
+        return;
+
+    avail = expr_find(&e);
+
+    if (avail) {
+        number_set(store->idx, avail->value);
+        store_replace(store, avail->value);
+        return;
+    }
+
+    e.value = value_key(def->idx, def->ssa_idx);
+    expr_push(&e);
+}
+
+static void visit_stmt(struct ir_node *ir)
+{
+    ir_foreach_use(ir, use_rewrite, NULL);
+
+    if (ir->type == IR_STORE)
+        visit_store(ir);
+}
+
+/* Dominator tree is as deep as the function is long, so it
+   is walked with explicit stack. */
+struct gvn_frame {
+    struct ir_node *ir;
+    /* Size of `exprs` before `ir` was visited. */
+    uint64_t        size;
+    /* Index of next child in `ir->idom_back`. */
+    uint64_t        child;
+};
+
+static void visit(struct ir_node *root)
+{
+    vector_t(struct gvn_frame) stack = {0};
+    struct gvn_frame           frame = {
+        .ir   = root,
+        .size = exprs.count
+    };
+
+    visit_stmt(root);
+    vector_push_back(stack, frame);
+
+    while (stack.count > 0) {
+        struct gvn_frame *top = &vector_back(stack);
+
+        if (top->child == top->ir->idom_back.count) {
+            exprs_pop(top->size);
+            vector_pop_back(stack);
+            continue;
+        }
+
+        frame.ir    = vector_at(top->ir->idom_back, top->child++);
+        frame.size  = exprs.count;
+        frame.child = 0;
+
+        visit_stmt(frame.ir);
+        vector_push_back(stack, frame);
+    }
+
+    vector_free(stack);
+}
+
+/* Phi operands are always versions of the phi variable, so
+   they cannot refer to representatives of other variables.
+   Copies, which phi operands still refer to, are left. */
+static void ir_opt_gvn_fn_decl(struct ir_fn_decl *decl)
+{
+    if (!decl->body)
+        return;
+
+    hashmap_reset(&exprs_map, 256);
+    hashmap_reset(&numbers, 256);
+
+    unstable_collect(decl);
+    ir_dominator_tree(decl);
+
+    visit(decl->body);
+
+    vector_free(exprs);
+    hashmap_destroy(&exprs_map);
+    hashmap_destroy(&numbers);
+    hashmap_destroy(&unstable);
+    hashmap_destroy(&arrays);
+}
+
+void ir_opt_gvn(struct ir_unit *ir)
+{
+    struct ir_node *it = ir->fn_decls;
+
+    while (it) {
+        ir_opt_gvn_fn_decl(it->ir);
+        it = it->next;
+    }
+}
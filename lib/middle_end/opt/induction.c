@@ -0,0 +1,605 @@
+/* induction.c - Induction variables optimizations.
+ * Copyright (C) 2024 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#include "middle_end/opt/opt.h"
+#include "middle_end/ir/dom.h"
+#include "middle_end/ir/gen.h"
+#include "middle_end/ir/ir.h"
+#include "middle_end/ir/ir_ops.h"
+#include "middle_end/ir/iv.h"
+#include "middle_end/ir/loop.h"
+#include "util/hashmap.h"
+#include "util/vector.h"
+#include <limits.h>
+#include <string.h>
+
+/* Strength reduction.
+
+   Derived induction variable, computed with multiplication
+     j = i * scale + offset
+   is replaced with new basic variable, which is initialized
+   before loop and incremented along with `i`:
+     j.0 = i.0 * scale + offset
+     ...
+     j.1 = φ(j.0, j.2)
+     i.2 = i.1 + step
+     j.2 = j.1 + step * scale
+   All derived variables with equal scale and offset share
+   one new variable.
+
+   Linear function test replacement.
+
+   Comparison of `i` with loop-invariant bound is rewritten
+   to comparison of reduced variable with positive scale and
+   bound transformed the same way. After that `i` is often
+   used only to increment itself and is removed by dead code
+   elimination. Like C, language assumes there is no signed
+   overflow, so affine function with positive scale keeps
+   order of values.
+
+   https://www.cs.rice.edu/~keith/EMBED/OSR.pdf */
+
+struct reduced {
+    struct ir_iv   *basic;
+    int64_t         scale;
+    int64_t         offset;
+    uint64_t        sym_idx;
+    /* SSA version of phi in loop header. */
+    uint64_t        phi_ssa_idx;
+};
+
+/* Key:   value_key(sym_idx, ssa_idx)
+   Value: defining statement or phi */
+static hashmap_t                defs;
+/* Key:   sym_idx
+   Value: 1 if address is taken */
+static hashmap_t                addr_taken;
+/* Key:   loop header
+   Value: 1 */
+static hashmap_t                processed;
+static vector_t(struct reduced) reduced;
+static uint64_t                 next_sym_idx;
+
+really_inline static uint64_t value_key(uint64_t sym_idx, uint64_t ssa_idx)
+{
+    return (sym_idx << 32) | (ssa_idx & 0xFFFFFFFF);
+}
+
+/**********************************************
+ **               Function state             **
+ **********************************************/
+
+static void addr_taken_collect(struct ir_node *ir, unused void *data)
+{
+    struct ir_sym *sym = ir->ir;
+
+    if (sym->addr_of)
+        hashmap_put(&addr_taken, sym->idx, 1);
+}
+
+static void state_collect(struct ir_fn_decl *decl)
+{
+    hashmap_reset(&defs, 256);
+    hashmap_reset(&addr_taken, 64);
+    next_sym_idx = 0;
+
+    for (struct ir_node *it = decl->args; it; it = it->next) {
+        struct ir_alloca *alloca = it->ir;
+        if (next_sym_idx <= alloca->idx)
+            next_sym_idx = alloca->idx + 1;
+    }
+
+    for (struct ir_node *it = decl->body; it; it = it->next) {
+        if (it->type == IR_ALLOCA || it->type == IR_ALLOCA_ARRAY) {
+            uint64_t idx = it->type == IR_ALLOCA
+                ? ((struct ir_alloca *) it->ir)->idx
+                : ((struct ir_alloca_array *) it->ir)->idx;
+
+            if (next_sym_idx <= idx)
+                next_sym_idx = idx + 1;
+        }
+
+        if (it->type == IR_PHI) {
+            struct ir_phi *phi = it->ir;
+            hashmap_put(&defs, value_key(phi->sym_idx, phi->ssa_idx), (uint64_t) it);
+            continue;
+        }
+
+        ir_foreach_use(it, addr_taken_collect, NULL);
+
+        struct ir_node *def = ir_def(it);
+        if (!def)
+            continue;
+
+        struct ir_sym *sym = def->ir;
+        hashmap_put(&defs, value_key(sym->idx, sym->ssa_idx), (uint64_t) it);
+    }
+}
+
+static bool is_param(struct ir_fn_decl *decl, uint64_t sym_idx)
+{
+    for (struct ir_node *it = decl->args; it; it = it->next)
+        if (((struct ir_alloca *) it->ir)->idx == sym_idx)
+            return 1;
+
+    return 0;
+}
+
+/* Immediate, parameter at entry or SSA value defined
+   outside of loop. */
+static bool invariant(struct ir_fn_decl *decl, struct ir_loop *loop, struct ir_node *ir)
+{
+    if (ir->type == IR_IMM)
+        return ((struct ir_imm *) ir->ir)->type == IMM_INT;
+
+    if (ir->type != IR_SYM)
+        return 0;
+
+    struct ir_sym *sym = ir->ir;
+
+    if (sym->deref || sym->addr_of || hashmap_has(&addr_taken, sym->idx))
+        return 0;
+
+    if (sym->ssa_idx == UINT64_MAX)
+        return is_param(decl, sym->idx);
+
+    bool     ok  = 0;
+    uint64_t def = hashmap_get(&defs, value_key(sym->idx, sym->ssa_idx), &ok);
+
+    return ok && !ir_loop_contains(loop, (struct ir_node *) def);
+}
+
+/**********************************************
+ **               New statements             **
+ **********************************************/
+
+/* New variables are declared at function entry. */
+static uint64_t sym_new(struct ir_fn_decl *decl)
+{
+    uint64_t        idx = next_sym_idx++;
+    struct ir_node *n   = ir_alloca_init(D_T_INT, /*ptr_depth=*/0, idx);
+
+    memcpy(&n->meta, &decl->body->meta, sizeof (struct meta));
+    n->meta.block_depth = 0;
+    ir_insert_before(decl->body, n, &decl->body);
+
+    return idx;
+}
+
+static struct ir_node *sym_make(uint64_t idx, uint64_t ssa_idx, struct type *type)
+{
+    struct ir_node *n = ir_sym_init(idx);
+    struct ir_sym  *s = n->ir;
+
+    s->ssa_idx   = ssa_idx;
+    s->type_info = *type;
+
+    return n;
+}
+
+static struct ir_node *copy(struct ir_node *ir)
+{
+    if (ir->type == IR_IMM)
+        return ir_imm_int_init(((struct ir_imm *) ir->ir)->imm.__int);
+
+    struct ir_sym  *sym = ir->ir;
+    struct ir_node *n   = sym_make(sym->idx, sym->ssa_idx, &sym->type_info);
+
+    return n;
+}
+
+/* `sym.ssa_idx = lhs op rhs` */
+static struct ir_node *store_make(
+    uint64_t         idx,
+    uint64_t         ssa_idx,
+    struct type     *type,
+    enum token_type  op,
+    struct ir_node  *lhs,
+    struct ir_node  *rhs
+) {
+    return ir_store_init(sym_make(idx, ssa_idx, type), ir_bin_init(op, lhs, rhs));
+}
+
+/* Append `idx.* = from * scale + offset` to `out`. Result is
+   SSA version of computed value. */
+static uint64_t affine_emit(
+    uint64_t         idx,
+    uint64_t         ssa_idx,
+    struct type     *type,
+    struct ir_node  *from,
+    int64_t          scale,
+    int64_t          offset,
+    ir_vector_t     *out
+) {
+    struct ir_node *mul = store_make(
+        idx, ssa_idx, type, TOK_STAR, from, ir_imm_int_init(scale)
+    );
+    vector_push_back(*out, mul);
+
+    if (offset == 0)
+        return ssa_idx;
+
+    struct ir_node *add = store_make(
+        idx, ssa_idx + 1, type, TOK_PLUS,
+        sym_make(idx, ssa_idx, type), ir_imm_int_init(offset)
+    );
+    vector_push_back(*out, add);
+
+    return ssa_idx + 1;
+}
+
+/* Statement falling through to phi nodes is their operand
+   predecessor, so `new` becomes predecessor instead. */
+static void insert_after(struct ir_node *pos, struct ir_node *new)
+{
+    ir_insert_after(pos, new);
+    memcpy(&new->meta, &pos->meta, sizeof (struct meta));
+
+    for (struct ir_node *it = new->next; it && it->type == IR_PHI; it = it->next) {
+        struct ir_phi *phi = it->ir;
+
+        for (uint64_t i = 0; i < phi->args_size; ++i)
+            if (phi->args[i].pred == pos)
+                phi->args[i].pred = new;
+    }
+}
+
+/**********************************************
+ **            Strength reduction            **
+ **********************************************/
+
+static bool multiplication(struct ir_iv *iv)
+{
+    struct ir_store *store = iv->def->ir;
+
+    if (iv->basic == iv || store->body->type != IR_BIN)
+        return 0;
+
+    enum token_type op = ((struct ir_bin *) store->body->ir)->op;
+
+    return op == TOK_STAR || op == TOK_SHL;
+}
+
+static struct type *type_of(struct ir_iv *basic)
+{
+    struct ir_store *update = basic->update->ir;
+
+    return &((struct ir_sym *) update->idx->ir)->type_info;
+}
+
+static bool in_range(int64_t v)
+{
+    return v >= INT_MIN && v <= INT_MAX;
+}
+
+static struct reduced *reduced_find(struct ir_iv *iv)
+{
+    vector_foreach(reduced, i) {
+        struct reduced *r = &vector_at(reduced, i);
+
+        if (r->basic == iv->basic && r->scale == iv->scale && r->offset == iv->offset)
+            return r;
+    }
+
+    return NULL;
+}
+
+/* Reduced variable, which can be compared instead of `basic`. */
+static struct reduced *reduced_increasing(struct ir_iv *basic)
+{
+    vector_foreach(reduced, i) {
+        struct reduced *r = &vector_at(reduced, i);
+
+        if (r->basic == basic && r->scale > 0)
+            return r;
+    }
+
+    return NULL;
+}
+
+static bool reducible(struct ir_iv *iv, struct ir_node *latch)
+{
+    struct ir_iv *b = iv->basic;
+
+    return multiplication(iv)
+        && b->update != latch
+        && ir_dominates(b->update, latch)
+        && in_range(b->step * iv->scale);
+}
+
+static void reduced_collect(struct ir_fn_decl *decl, ir_iv_vector_t *ivs, struct ir_node *latch)
+{
+    vector_foreach(*ivs, i) {
+        struct ir_iv *iv = vector_at(*ivs, i);
+
+        if (!reducible(iv, latch) || reduced_find(iv))
+            continue;
+
+        struct reduced r = {
+            .basic   = iv->basic,
+            .scale   = iv->scale,
+            .offset  = iv->offset,
+            .sym_idx = sym_new(decl)
+        };
+
+        vector_push_back(reduced, r);
+    }
+}
+
+/* Create initialization (appended to `pre`), phi node and
+   increment of new variable. */
+static void reduced_emit(
+    struct ir_fn_decl *decl,
+    struct ir_loop    *loop,
+    struct ir_node    *latch,
+    struct reduced    *r,
+    ir_vector_t       *pre
+) {
+    struct ir_iv   *b    = r->basic;
+    struct ir_phi  *bphi = b->def->ir;
+    struct type    *type = type_of(b);
+    struct ir_node *init = sym_make(bphi->sym_idx, b->init_ssa_idx, type);
+    uint64_t        ssa  = affine_emit(r->sym_idx, 0, type, init, r->scale, r->offset, pre);
+    uint64_t        next = ssa + 2;
+
+    r->phi_ssa_idx = ssa + 1;
+
+    struct ir_node *phi_node = ir_phi_init(r->sym_idx, loop->header->cfg.preds.count);
+    struct ir_phi  *phi      = phi_node->ir;
+
+    phi->ssa_idx = r->phi_ssa_idx;
+
+    vector_foreach(loop->header->cfg.preds, i) {
+        struct ir_node *pred = vector_at(loop->header->cfg.preds, i);
+
+        phi->args[i].pred    = pred;
+        phi->args[i].ssa_idx = pred == latch ? next : ssa;
+    }
+
+    phi_node->instr_idx    = loop->header->instr_idx;
+    phi_node->cfg_block_no = loop->header->cfg_block_no;
+    memcpy(&phi_node->meta, &loop->header->meta, sizeof (struct meta));
+
+    ir_insert_before(loop->header, phi_node, &decl->body);
+
+    struct ir_node *step = store_make(
+        r->sym_idx, next, type, TOK_PLUS,
+        sym_make(r->sym_idx, r->phi_ssa_idx, type),
+        ir_imm_int_init(b->step * r->scale)
+    );
+
+    insert_after(b->update, step);
+}
+
+/* `j = i * scale + offset` is replaced with `j = r` */
+static void uses_replace(ir_iv_vector_t *ivs, struct ir_node *latch)
+{
+    vector_foreach(*ivs, i) {
+        struct ir_iv *iv = vector_at(*ivs, i);
+
+        if (!reducible(iv, latch))
+            continue;
+
+        struct reduced  *r     = reduced_find(iv);
+        struct ir_store *store = iv->def->ir;
+        struct type     *type  = &((struct ir_sym *) store->idx->ir)->type_info;
+
+        ir_node_cleanup(store->body);
+        store->body = sym_make(r->sym_idx, r->phi_ssa_idx, type);
+    }
+}
+
+/**********************************************
+ **    Linear function test replacement      **
+ **********************************************/
+
+static bool comparison(enum token_type op)
+{
+    switch (op) {
+    case TOK_EQ:
+    case TOK_NEQ:
+    case TOK_LT:
+    case TOK_LE:
+    case TOK_GT:
+    case TOK_GE:
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+static struct ir_iv *basic_of(ir_iv_vector_t *ivs, struct ir_node *ir)
+{
+    if (ir->type != IR_SYM)
+        return NULL;
+
+    struct ir_sym *sym = ir->ir;
+    struct ir_iv  *iv  = ir_iv_find(ivs, sym->idx, sym->ssa_idx);
+
+    return iv && iv->basic == iv ? iv : NULL;
+}
+
+/* Bound transformed by the same affine function. */
+static struct ir_node *bound_emit(
+    struct ir_fn_decl *decl,
+    struct reduced    *r,
+    struct ir_node    *bound,
+    ir_vector_t       *pre
+) {
+    struct type *type = type_of(r->basic);
+
+    if (bound->type == IR_IMM) {
+        int64_t v = ((struct ir_imm *) bound->ir)->imm.__int * r->scale + r->offset;
+
+        return in_range(v) ? ir_imm_int_init(v) : NULL;
+    }
+
+    uint64_t idx = sym_new(decl);
+    uint64_t ssa = affine_emit(idx, 0, type, copy(bound), r->scale, r->offset, pre);
+
+    return sym_make(idx, ssa, type);
+}
+
+static bool test_replace(
+    struct ir_fn_decl *decl,
+    struct ir_loop    *loop,
+    ir_iv_vector_t    *ivs,
+    struct ir_node    *ir,
+    ir_vector_t       *pre
+) {
+    if (ir->type != IR_STORE || ((struct ir_store *) ir->ir)->body->type != IR_BIN)
+        return 0;
+
+    struct ir_bin   *bin   = ((struct ir_store *) ir->ir)->body->ir;
+    struct ir_node **var   = &bin->lhs;
+    struct ir_node **bound = &bin->rhs;
+
+    if (!comparison(bin->op))
+        return 0;
+
+    /* `n > i` is handled the same way as `i < n`. */
+    if (!basic_of(ivs, *var)) {
+        var   = &bin->rhs;
+        bound = &bin->lhs;
+    }
+
+    struct ir_iv *basic = basic_of(ivs, *var);
+
+    if (!basic || !invariant(decl, loop, *bound))
+        return 0;
+
+    struct reduced *r = reduced_increasing(basic);
+
+    if (!r)
+        return 0;
+
+    struct ir_node *new_bound = bound_emit(decl, r, *bound, pre);
+
+    if (!new_bound)
+        return 0;
+
+    ir_node_cleanup(*var);
+    ir_node_cleanup(*bound);
+
+    *var   = sym_make(r->sym_idx, r->phi_ssa_idx, type_of(basic));
+    *bound = new_bound;
+
+    return 1;
+}
+
+static bool tests_replace(
+    struct ir_fn_decl *decl,
+    struct ir_loop    *loop,
+    ir_iv_vector_t    *ivs,
+    ir_vector_t       *pre
+) {
+    bool changed = 0;
+
+    vector_foreach(loop->stmts, i)
+        changed |= test_replace(decl, loop, ivs, vector_at(loop->stmts, i), pre);
+
+    return changed;
+}
+
+/**********************************************
+ **                 Driver                   **
+ **********************************************/
+
+static bool loop_optimize(struct ir_fn_decl *decl, struct ir_loop *loop)
+{
+    ir_iv_vector_t  ivs   = {0};
+    ir_vector_t     pre   = {0};
+    struct ir_node *entry = ir_loop_entry(decl, loop);
+    bool            changed;
+
+    /* Phi nodes of new variables expect one entry and one
+       back edge. */
+    if (!entry || loop->latches.count != 1 || loop->header->cfg.preds.count != 2)
+        return 0;
+
+    struct ir_node *latch = vector_at(loop->latches, 0);
+
+    vector_clear(reduced);
+    ir_ivs_build(decl, loop, &ivs);
+
+    reduced_collect(decl, &ivs, latch);
+
+    vector_foreach(reduced, i)
+        reduced_emit(decl, loop, latch, &vector_at(reduced, i), &pre);
+
+    uses_replace(&ivs, latch);
+
+    changed = reduced.count > 0;
+    changed |= tests_replace(decl, loop, &ivs, &pre);
+
+    ir_loop_entry_insert(decl, loop, entry, &pre);
+
+    ir_ivs_cleanup(&ivs);
+    vector_free(pre);
+
+    return changed;
+}
+
+/* Innermost loop, not processed yet. */
+static struct ir_loop *loop_next(ir_loop_vector_t *loops)
+{
+    vector_foreach(*loops, i) {
+        struct ir_loop *loop  = vector_at(*loops, i);
+        struct ir_loop *inner = loop_next(&loop->children);
+
+        if (inner)
+            return inner;
+
+        if (!hashmap_has(&processed, (uint64_t) loop->header))
+            return loop;
+    }
+
+    return NULL;
+}
+
+static void ir_opt_induction_fn_decl(struct ir_fn_decl *decl)
+{
+    if (!decl->body)
+        return;
+
+    hashmap_reset(&processed, 64);
+
+    while (1) {
+        ir_dominator_tree(decl);
+        ir_loops_build(decl);
+
+        struct ir_loop *loop = loop_next(&decl->loops);
+
+        if (!loop)
+            break;
+
+        hashmap_put(&processed, (uint64_t) loop->header, 1);
+
+        state_collect(decl);
+
+        if (loop_optimize(decl, loop)) {
+            ir_renumber(decl->body);
+            ir_cfg_build(decl);
+        }
+    }
+
+    ir_loops_cleanup(decl);
+
+    vector_free(reduced);
+    hashmap_destroy(&defs);
+    hashmap_destroy(&addr_taken);
+    hashmap_destroy(&processed);
+}
+
+void ir_opt_induction(struct ir_unit *ir)
+{
+    struct ir_node *it = ir->fn_decls;
+
+    while (it) {
+        ir_opt_induction_fn_decl(it->ir);
+        it = it->next;
+    }
+}
@@ -0,0 +1,618 @@
+/* inline.c - Function inlining.
+ * Copyright (C) 2024 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#include "middle_end/opt/opt.h"
+#include "middle_end/ir/ddg.h"
+#include "middle_end/ir/dom.h"
+#include "middle_end/ir/gen.h"
+#include "middle_end/ir/ir.h"
+#include "middle_end/ir/ir_ops.h"
+#include "middle_end/ir/loop.h"
+#include "util/crc32.h"
+#include "util/hashmap.h"
+#include "util/vector.h"
+#include <string.h>
+
+/* Call statement
+     t = call f(a, b)
+   is replaced with copy of body of `f`, where
+   - variables of `f` get new indices in caller and are
+     declared at caller entry,
+   - parameters are assigned with arguments,
+   - `ret x` becomes `t = x` and jump to the statement
+     after the call.
+
+   Functions are processed bottom-up over the call graph,
+   so callee is inlined into its caller after its own calls
+   were inlined. Calls between functions of one cycle of
+   call graph (recursion) are left as is.
+
+   Decision depends on callee size (statements except
+   allocas) and on call site frequency, which is estimated
+   by loop nesting depth. Each loop level makes allowed
+   size bigger. Callee with the only call site in unit is
+   inlined up to INLINE_SIZE_MAX, since its copy replaces
+   the original. Caller cannot become bigger than
+   INLINE_BUDGET statements, because of dominator tree
+   limits. */
+
+/** Callee size, inlined at any call site. */
+#define INLINE_SIZE      8
+/** Callee size, never inlined. */
+#define INLINE_SIZE_MAX  48
+/** Maximum number of statements in caller. */
+#define INLINE_BUDGET    384
+
+typedef vector_t(uint64_t) idx_vector_t;
+
+/** Call graph node. */
+struct cg_node {
+    struct ir_fn_decl *decl;
+    /** Indices of called functions with body. */
+    idx_vector_t       callees;
+    /** Number of call sites in unit. */
+    uint64_t           sites;
+    bool               visited;
+};
+
+static vector_t(struct cg_node) cg;
+/* Key:   crc32(function name)
+   Value: index in call graph */
+static hashmap_t                fns;
+/* Key:   variable index in callee
+   Value: variable index in caller */
+static hashmap_t                syms;
+/* Key:   callee statement
+   Value: its copy in caller */
+static hashmap_t                copies;
+/* Key:   call graph index
+   Value: 1 */
+static hashmap_t                reached;
+/* Key:   callee statement
+   Value: 1 if reachable from function entry */
+static hashmap_t                live;
+static uint64_t                 next_sym_idx;
+
+/**********************************************
+ **               Call graph                 **
+ **********************************************/
+
+static struct ir_fn_call *call_of(struct ir_node *ir)
+{
+    if (ir->type == IR_FN_CALL)
+        return ir->ir;
+
+    if (ir->type == IR_STORE) {
+        struct ir_store *store = ir->ir;
+
+        if (store->body->type == IR_FN_CALL)
+            return store->body->ir;
+    }
+
+    return NULL;
+}
+
+static struct cg_node *cg_lookup(const char *name)
+{
+    bool     ok  = 0;
+    uint64_t idx = hashmap_get(&fns, crc32_string(name), &ok);
+
+    return ok ? &vector_at(cg, idx) : NULL;
+}
+
+static void cg_build(struct ir_unit *ir)
+{
+    hashmap_reset(&fns, 64);
+
+    for (struct ir_node *it = ir->fn_decls; it; it = it->next) {
+        struct ir_fn_decl *decl = it->ir;
+        struct cg_node     node = {.decl = decl};
+
+        hashmap_put(&fns, crc32_string(decl->name), cg.count);
+        vector_push_back(cg, node);
+    }
+
+    vector_foreach(cg, i) {
+        struct cg_node *node = &vector_at(cg, i);
+
+        for (struct ir_node *it = node->decl->body; it; it = it->next) {
+            struct ir_fn_call *call   = call_of(it);
+            struct cg_node    *callee = call ? cg_lookup(call->name) : NULL;
+
+            if (!callee || !callee->decl->body)
+                continue;
+
+            ++callee->sites;
+            vector_push_back(node->callees, callee - cg.data);
+        }
+    }
+}
+
+static void cg_cleanup()
+{
+    vector_foreach(cg, i)
+        vector_free(vector_at(cg, i).callees);
+
+    vector_free(cg);
+}
+
+static void reach(uint64_t from)
+{
+    struct cg_node *node = &vector_at(cg, from);
+
+    vector_foreach(node->callees, i) {
+        uint64_t to = vector_at(node->callees, i);
+
+        if (!hashmap_has(&reached, to)) {
+            hashmap_put(&reached, to, 1);
+            reach(to);
+        }
+    }
+}
+
+/* Callee can reach caller through calls. */
+static bool recursive(struct cg_node *caller, struct cg_node *callee)
+{
+    hashmap_reset(&reached, 64);
+    hashmap_put(&reached, callee - cg.data, 1);
+    reach(callee - cg.data);
+
+    return hashmap_has(&reached, caller - cg.data);
+}
+
+/* Callees go before callers. */
+static void bottom_up(uint64_t idx, idx_vector_t *out)
+{
+    struct cg_node *node = &vector_at(cg, idx);
+
+    if (node->visited)
+        return;
+
+    node->visited = 1;
+
+    vector_foreach(node->callees, i)
+        bottom_up(vector_at(node->callees, i), out);
+
+    vector_push_back(*out, idx);
+}
+
+/**********************************************
+ **               Cost model                 **
+ **********************************************/
+
+static uint64_t fn_size(struct ir_fn_decl *decl, bool allocas)
+{
+    uint64_t size = 0;
+
+    for (struct ir_node *it = decl->body; it; it = it->next)
+        if (allocas || (it->type != IR_ALLOCA && it->type != IR_ALLOCA_ARRAY))
+            ++size;
+
+    return size;
+}
+
+static uint64_t args_count(struct ir_node *args)
+{
+    uint64_t count = 0;
+
+    for (struct ir_node *it = args; it; it = it->next)
+        ++count;
+
+    return count;
+}
+
+static bool profitable(struct cg_node *callee, uint64_t depth)
+{
+    uint64_t size  = fn_size(callee->decl, /*allocas=*/0);
+    uint64_t limit = INLINE_SIZE;
+
+    for (uint64_t i = 0; i < depth && limit < INLINE_SIZE_MAX; ++i)
+        limit *= 4;
+
+    if (callee->sites == 1)
+        limit = INLINE_SIZE_MAX;
+
+    return size <= limit && size <= INLINE_SIZE_MAX;
+}
+
+static bool inlinable(struct cg_node *caller, struct cg_node *callee, struct ir_node *site)
+{
+    struct ir_fn_call *call = call_of(site);
+
+    return callee->decl->body &&
+           site->next &&
+           args_count(call->args) == args_count(callee->decl->args) &&
+           !recursive(caller, callee);
+}
+
+/**********************************************
+ **              Transformation              **
+ **********************************************/
+
+static void syms_collect(struct ir_fn_decl *decl)
+{
+    next_sym_idx = 0;
+
+    for (struct ir_node *it = decl->args; it; it = it->next) {
+        struct ir_alloca *alloca = it->ir;
+
+        if (next_sym_idx <= alloca->idx)
+            next_sym_idx = alloca->idx + 1;
+    }
+
+    for (struct ir_node *it = decl->body; it; it = it->next) {
+        if (it->type != IR_ALLOCA && it->type != IR_ALLOCA_ARRAY)
+            continue;
+
+        uint64_t idx = it->type == IR_ALLOCA
+            ? ((struct ir_alloca *) it->ir)->idx
+            : ((struct ir_alloca_array *) it->ir)->idx;
+
+        if (next_sym_idx <= idx)
+            next_sym_idx = idx + 1;
+    }
+}
+
+static uint64_t sym_map(uint64_t idx)
+{
+    bool     ok  = 0;
+    uint64_t got = hashmap_get(&syms, idx, &ok);
+
+    return ok ? got : idx;
+}
+
+/* Rename variables of callee in copied statement. */
+static void remap(struct ir_node *ir)
+{
+    if (!ir)
+        return;
+
+    switch (ir->type) {
+    case IR_SYM:
+        ((struct ir_sym *) ir->ir)->idx = sym_map(((struct ir_sym *) ir->ir)->idx);
+        break;
+    case IR_MEMBER:
+        ((struct ir_member *) ir->ir)->idx = sym_map(((struct ir_member *) ir->ir)->idx);
+        break;
+    case IR_ALLOCA:
+        ((struct ir_alloca *) ir->ir)->idx = sym_map(((struct ir_alloca *) ir->ir)->idx);
+        break;
+    case IR_ALLOCA_ARRAY:
+        ((struct ir_alloca_array *) ir->ir)->idx = sym_map(((struct ir_alloca_array *) ir->ir)->idx);
+        break;
+    case IR_STORE:
+        remap(((struct ir_store *) ir->ir)->idx);
+        remap(((struct ir_store *) ir->ir)->body);
+        break;
+    case IR_BIN:
+        remap(((struct ir_bin *) ir->ir)->lhs);
+        remap(((struct ir_bin *) ir->ir)->rhs);
+        break;
+    case IR_COND:
+        remap(((struct ir_cond *) ir->ir)->cond);
+        break;
+    case IR_RET:
+        remap(((struct ir_ret *) ir->ir)->body);
+        break;
+    case IR_FN_CALL:
+        for (struct ir_node *it = ((struct ir_fn_call *) ir->ir)->args; it; it = it->next)
+            remap(it);
+        break;
+    default:
+        break;
+    }
+}
+
+static void type_find_sym(struct ir_node *ir, void *data)
+{
+    struct ir_sym *sym   = ir->ir;
+    struct ir_sym *param = data;
+
+    if (sym->idx == param->idx)
+        param->type_info = sym->type_info;
+}
+
+/* Variables of callee are declared at caller entry, so
+   they are not allocated again in loop. */
+static void allocas_copy(struct ir_fn_decl *caller, struct ir_fn_decl *callee)
+{
+    struct ir_node *pos = caller->body;
+
+    hashmap_reset(&syms, 64);
+
+    for (uint64_t i = 0; i < 2; ++i) {
+        struct ir_node *list = i == 0 ? callee->args : callee->body;
+
+        for (struct ir_node *it = list; it; it = it->next) {
+            if (it->type != IR_ALLOCA && it->type != IR_ALLOCA_ARRAY)
+                continue;
+
+            struct ir_node *copy = ir_node_copy(it);
+            uint64_t        idx  = it->type == IR_ALLOCA
+                ? ((struct ir_alloca *) it->ir)->idx
+                : ((struct ir_alloca_array *) it->ir)->idx;
+
+            hashmap_put(&syms, idx, next_sym_idx++);
+            remap(copy);
+
+            memcpy(&copy->meta, &pos->meta, sizeof (struct meta));
+            copy->meta.block_depth = 0;
+            ir_insert_before(pos, copy, &caller->body);
+        }
+    }
+}
+
+/* `param = arg` for each parameter. Type of parameter is
+   taken from its uses in callee. */
+static void params_copy(struct ir_fn_decl *callee, struct ir_node *site, ir_vector_t *out)
+{
+    struct ir_node *arg = call_of(site)->args;
+
+    for (struct ir_node *it = callee->args; it; it = it->next, arg = arg->next) {
+        struct ir_node *param = ir_sym_init(((struct ir_alloca *) it->ir)->idx);
+
+        for (struct ir_node *s = callee->body; s; s = s->next) {
+            struct ir_node *def = ir_def(s);
+
+            ir_foreach_use(s, type_find_sym, param->ir);
+
+            if (def)
+                type_find_sym(def, param->ir);
+        }
+
+        remap(param);
+
+        struct ir_node *store = ir_store_init(param, ir_node_copy(arg));
+
+        store->meta = site->meta;
+        vector_push_back(*out, store);
+    }
+}
+
+/* `ret x` -> `t = x` and jump to statement after the call.
+   Nothing is needed after the last statement of callee. */
+static void ret_copy(
+    struct ir_node *ret,
+    struct ir_node *site,
+    struct ir_node *after,
+    bool            last,
+    ir_vector_t    *out
+) {
+    struct ir_ret *r = ret->ir;
+
+    if (site->type == IR_STORE && r->body) {
+        struct ir_store *store = site->ir;
+        struct ir_node  *body  = ir_node_copy(r->body);
+
+        remap(body);
+
+        struct ir_node *copy = ir_store_init(ir_node_copy(store->idx), body);
+
+        copy->meta = site->meta;
+        vector_push_back(*out, copy);
+    }
+
+    if (!last) {
+        struct ir_node *jump = ir_jump_init(0);
+
+        jump->meta = site->meta;
+        ((struct ir_jump *) jump->ir)->target = after;
+        vector_push_back(*out, jump);
+    }
+}
+
+static void copy_retarget(struct ir_node *ir)
+{
+    bool     ok = 0;
+    uint64_t to = 0;
+
+    if (ir->type == IR_JUMP) {
+        struct ir_jump *jump = ir->ir;
+
+        to = hashmap_get(&copies, (uint64_t) jump->target, &ok);
+        if (ok)
+            jump->target = (struct ir_node *) to;
+    }
+
+    if (ir->type == IR_COND) {
+        struct ir_cond *cond = ir->ir;
+
+        to = hashmap_get(&copies, (uint64_t) cond->target, &ok);
+        if (ok)
+            cond->target = (struct ir_node *) to;
+    }
+}
+
+/* Statements after returning if-else are never executed.
+   Copied into loop they only confuse further analyses. */
+static void live_collect(struct ir_fn_decl *callee)
+{
+    ir_vector_t work = {0};
+
+    hashmap_reset(&live, 64);
+    hashmap_put(&live, (uint64_t) callee->body, 1);
+    vector_push_back(work, callee->body);
+
+    while (work.count > 0) {
+        struct ir_node *it = vector_back(work);
+        vector_pop_back(work);
+
+        vector_foreach(it->cfg.succs, i) {
+            struct ir_node *succ = vector_at(it->cfg.succs, i);
+
+            if (!hashmap_has(&live, (uint64_t) succ)) {
+                hashmap_put(&live, (uint64_t) succ, 1);
+                vector_push_back(work, succ);
+            }
+        }
+    }
+
+    vector_free(work);
+}
+
+static void body_copy(
+    struct ir_fn_decl *callee,
+    struct ir_node    *site,
+    struct ir_node    *after,
+    ir_vector_t       *out
+) {
+    ir_vector_t     stmts  = {0};
+    idx_vector_t    firsts = {0};
+    struct ir_node *next   = after;
+
+    hashmap_reset(&copies, 64);
+    live_collect(callee);
+
+    for (struct ir_node *it = callee->body; it; it = it->next) {
+        vector_push_back(stmts, it);
+        vector_push_back(firsts, out->count);
+
+        if (!hashmap_has(&live, (uint64_t) it))
+            continue;
+
+        if (it->type == IR_RET) {
+            ret_copy(it, site, after, /*last=*/!it->next, out);
+        } else if (it->type != IR_ALLOCA && it->type != IR_ALLOCA_ARRAY) {
+            struct ir_node *copy = ir_node_copy(it);
+
+            copy->meta.block_depth += site->meta.block_depth;
+            remap(copy);
+            vector_push_back(*out, copy);
+        }
+    }
+
+    /* Jump to statement, that produced nothing, goes to the
+       next produced one. */
+    vector_foreach_back(stmts, i) {
+        uint64_t first = vector_at(firsts, i);
+        uint64_t end   = i + 1 < firsts.count ? vector_at(firsts, i + 1) : out->count;
+
+        if (first < end)
+            next = vector_at(*out, first);
+
+        hashmap_put(&copies, (uint64_t) vector_at(stmts, i), (uint64_t) next);
+    }
+
+    vector_foreach(*out, i)
+        copy_retarget(vector_at(*out, i));
+
+    vector_free(stmts);
+    vector_free(firsts);
+}
+
+static void jumps_retarget(struct ir_fn_decl *decl, struct ir_node *from, struct ir_node *to)
+{
+    for (struct ir_node *it = decl->body; it; it = it->next) {
+        if (it->type == IR_JUMP && ((struct ir_jump *) it->ir)->target == from)
+            ((struct ir_jump *) it->ir)->target = to;
+
+        if (it->type == IR_COND && ((struct ir_cond *) it->ir)->target == from)
+            ((struct ir_cond *) it->ir)->target = to;
+    }
+}
+
+static void inline_site(struct ir_fn_decl *caller, struct ir_fn_decl *callee, struct ir_node *site)
+{
+    ir_vector_t     stmts = {0};
+    struct ir_node *after = site->next;
+
+    allocas_copy(caller, callee);
+    params_copy(callee, site, &stmts);
+    body_copy(callee, site, after, &stmts);
+
+    vector_foreach(stmts, i) {
+        ir_insert_before(after, vector_at(stmts, i), &caller->body);
+    }
+
+    jumps_retarget(caller, site, stmts.count > 0 ? vector_at(stmts, 0) : after);
+
+    if (site->prev)
+        site->prev->next = site->next;
+    else
+        caller->body = site->next;
+
+    site->next->prev = site->prev;
+    ir_node_cleanup(site);
+
+    vector_free(stmts);
+}
+
+static void inline_calls(struct cg_node *caller)
+{
+    struct ir_fn_decl  *decl   = caller->decl;
+    ir_vector_t         sites  = {0};
+    idx_vector_t        depths = {0};
+    uint64_t            size   = fn_size(decl, /*allocas=*/1);
+    bool                done   = 0;
+
+    if (!decl->body)
+        return;
+
+    ir_dominator_tree(decl);
+    ir_loops_build(decl);
+
+    for (struct ir_node *it = decl->body; it; it = it->next) {
+        if (!call_of(it))
+            continue;
+
+        vector_push_back(sites, it);
+        vector_push_back(depths, ir_loop_depth(it));
+    }
+
+    ir_loops_cleanup(decl);
+    syms_collect(decl);
+
+    vector_foreach(sites, i) {
+        struct ir_node *site   = vector_at(sites, i);
+        struct cg_node *callee = cg_lookup(call_of(site)->name);
+
+        if (!callee || !inlinable(caller, callee, site) ||
+            !profitable(callee, vector_at(depths, i)))
+            continue;
+
+        uint64_t grow = fn_size(callee->decl, /*allocas=*/1) + args_count(callee->decl->args);
+
+        if (size + grow > INLINE_BUDGET)
+            continue;
+
+        inline_site(decl, callee->decl, site);
+        size += grow;
+        done  = 1;
+    }
+
+    /* Dependence edges may still point to removed call
+       sites. */
+    if (done) {
+        ir_renumber(decl->body);
+        ir_cfg_build(decl);
+        ir_ddg_build(decl);
+    }
+
+    vector_free(sites);
+    vector_free(depths);
+}
+
+void ir_opt_inline(struct ir_unit *ir)
+{
+    idx_vector_t order = {0};
+
+    cg_build(ir);
+
+    vector_foreach(cg, i)
+        bottom_up(i, &order);
+
+    vector_foreach(order, i)
+        inline_calls(&vector_at(cg, vector_at(order, i)));
+
+    vector_free(order);
+    cg_cleanup();
+
+    hashmap_destroy(&fns);
+    hashmap_destroy(&syms);
+    hashmap_destroy(&copies);
+    hashmap_destroy(&reached);
+    hashmap_destroy(&live);
+}
@@ -0,0 +1,381 @@
+/* motion.c - Loop-invariant code motion.
+ * Copyright (C) 2024 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#include "middle_end/opt/opt.h"
+#include "middle_end/ir/dom.h"
+#include "middle_end/ir/gen.h"
+#include "middle_end/ir/ir.h"
+#include "middle_end/ir/ir_ops.h"
+#include "middle_end/ir/loop.h"
+#include "util/hashmap.h"
+#include "util/vector.h"
+
+/* Binary expressions, whose operands are not changed in loop,
+   are moved right before the loop header, so they are
+   computed once before the loop.
+
+   Operand is invariant, if it is
+   - immediate value,
+   - SSA value, defined outside of loop or by invariant
+     statement,
+   - symbol without SSA version, that never changes
+     (parameter at entry, array address).
+
+   Loops are processed from innermost, so expression moved
+   out of inner loop can be moved further out of enclosing
+   loop.
+
+   Everything, except division, is executed speculatively,
+   even if it was under condition in loop, or loop body was
+   never executed. Division by non-constant could trap, so
+   it is moved only if executed on each iteration, that is,
+   if it dominates all exits of the loop. Since each SSA value has the only
+   definition, moving definition does not change any use.
+
+   Loop header must be entered from outside only from one
+   statement (see ir_loop_entry()), otherwise loop is left
+   as is. */
+
+/* Key:   value_key(sym_idx, ssa_idx)
+   Value: defining statement (store or phi) */
+static hashmap_t defs;
+/* Key:   sym_idx
+   Value: 1 if symbol without SSA version can change */
+static hashmap_t unstable;
+/* Key:   statement
+   Value: 1 */
+static hashmap_t invariant;
+/* Key:   statement
+   Value: 1 if it is moved out of current loop */
+static hashmap_t moved;
+/* Key:   loop header
+   Value: 1 */
+static hashmap_t processed;
+
+really_inline static uint64_t value_key(uint64_t sym_idx, uint64_t ssa_idx)
+{
+    return (sym_idx << 32) | (ssa_idx & 0xFFFFFFFF);
+}
+
+/**********************************************
+ **               Analysis                   **
+ **********************************************/
+
+static void unstable_collect_use(struct ir_node *ir, unused void *data)
+{
+    struct ir_sym *sym = ir->ir;
+
+    if (sym->addr_of)
+        hashmap_put(&unstable, sym->idx, 1);
+}
+
+static void defs_collect(struct ir_fn_decl *decl)
+{
+    hashmap_reset(&defs, 256);
+    hashmap_reset(&unstable, 64);
+
+    for (struct ir_node *it = decl->body; it; it = it->next) {
+        if (it->type == IR_PHI) {
+            struct ir_phi *phi = it->ir;
+            hashmap_put(&defs, value_key(phi->sym_idx, phi->ssa_idx), (uint64_t) it);
+            continue;
+        }
+
+        ir_foreach_use(it, unstable_collect_use, NULL);
+
+        struct ir_node *def = ir_def(it);
+        if (!def)
+            continue;
+
+        struct ir_sym *sym = def->ir;
+
+        if (sym->ssa_idx == UINT64_MAX)
+            hashmap_put(&unstable, sym->idx, 1);
+        else
+            hashmap_put(&defs, value_key(sym->idx, sym->ssa_idx), (uint64_t) it);
+    }
+}
+
+static bool operand_invariant(struct ir_loop *loop, struct ir_node *ir)
+{
+    if (ir->type == IR_IMM)
+        return 1;
+
+    if (ir->type != IR_SYM)
+        return 0;
+
+    struct ir_sym *sym = ir->ir;
+
+    if (sym->deref || sym->addr_of)
+        return 0;
+
+    if (sym->ssa_idx == UINT64_MAX)
+        return !hashmap_has(&unstable, sym->idx);
+
+    bool            ok  = 0;
+    struct ir_node *def = (struct ir_node *) hashmap_get(
+        &defs, value_key(sym->idx, sym->ssa_idx), &ok
+    );
+
+    if (!ok)
+        return 1;
+
+    return !ir_loop_contains(loop, def) || hashmap_has(&invariant, (uint64_t) def);
+}
+
+/* Division by constant other than 0 and -1 never traps. */
+static bool traps(struct ir_bin *bin)
+{
+    if (bin->op != TOK_SLASH && bin->op != TOK_MOD)
+        return 0;
+
+    if (bin->rhs->type != IR_IMM)
+        return 1;
+
+    struct ir_imm *imm = bin->rhs->ir;
+
+    return imm->type != IMM_INT || imm->imm.__int == 0 || imm->imm.__int == -1;
+}
+
+/* Statement is executed on each iteration, which leaves
+   the loop. */
+static bool dominates_exits(struct ir_loop *loop, struct ir_node *ir)
+{
+    vector_foreach(loop->stmts, i) {
+        struct ir_node *it = vector_at(loop->stmts, i);
+
+        vector_foreach(it->cfg.succs, j)
+            if (!ir_loop_contains(loop, vector_at(it->cfg.succs, j)) &&
+                !ir_dominates(ir, it))
+                return 0;
+    }
+
+    return 1;
+}
+
+/* Statement can be taken out of its place, if it is not
+   the loop header and does not fall through to phi nodes,
+   which refer to it as to predecessor. */
+static bool movable(struct ir_loop *loop, struct ir_node *ir)
+{
+    return ir != loop->header && ir->next && ir->next->type != IR_PHI;
+}
+
+static bool stmt_invariant(struct ir_loop *loop, struct ir_node *ir)
+{
+    if (ir->type != IR_STORE || !movable(loop, ir))
+        return 0;
+
+    struct ir_store *store = ir->ir;
+    struct ir_sym   *sym   = store->idx->ir;
+
+    if (sym->deref || sym->ssa_idx == UINT64_MAX || store->body->type != IR_BIN)
+        return 0;
+
+    struct ir_bin *bin = store->body->ir;
+
+    if (!operand_invariant(loop, bin->lhs) || !operand_invariant(loop, bin->rhs))
+        return 0;
+
+    return !traps(bin) || dominates_exits(loop, ir);
+}
+
+static void invariants_collect(struct ir_loop *loop, ir_vector_t *out)
+{
+    bool changed = 1;
+
+    hashmap_reset(&invariant, 64);
+
+    while (changed) {
+        changed = 0;
+
+        vector_foreach(loop->stmts, i) {
+            struct ir_node *it = vector_at(loop->stmts, i);
+
+            if (hashmap_has(&invariant, (uint64_t) it) || !stmt_invariant(loop, it))
+                continue;
+
+            hashmap_put(&invariant, (uint64_t) it, 1);
+            changed = 1;
+        }
+    }
+
+    /* Statements go in list order, so definitions remain
+       before uses. */
+    vector_foreach(loop->stmts, i) {
+        struct ir_node *it = vector_at(loop->stmts, i);
+
+        if (hashmap_has(&invariant, (uint64_t) it))
+            vector_push_back(*out, it);
+    }
+}
+
+/**********************************************
+ **               Transformation             **
+ **********************************************/
+
+static struct ir_node *alloca_of(struct ir_loop *loop, uint64_t sym_idx)
+{
+    vector_foreach(loop->stmts, i) {
+        struct ir_node *it = vector_at(loop->stmts, i);
+
+        if (it->type == IR_ALLOCA && ((struct ir_alloca *) it->ir)->idx == sym_idx)
+            return it;
+    }
+
+    return NULL;
+}
+
+static void moved_collect(struct ir_loop *loop, ir_vector_t *stmts, ir_vector_t *out)
+{
+    vector_foreach(*stmts, i) {
+        struct ir_node  *it     = vector_at(*stmts, i);
+        struct ir_store *store  = it->ir;
+        struct ir_node  *alloca = alloca_of(loop, ((struct ir_sym *) store->idx->ir)->idx);
+
+        if (alloca && movable(loop, alloca)) {
+            hashmap_put(&moved, (uint64_t) alloca, 1);
+            vector_push_back(*out, alloca);
+        }
+
+        hashmap_put(&moved, (uint64_t) it, 1);
+        vector_push_back(*out, it);
+    }
+}
+
+/* First statement after \p ir, that remains in place. */
+static struct ir_node *remaining_next(struct ir_node *ir)
+{
+    while (hashmap_has(&moved, (uint64_t) ir))
+        ir = ir->next;
+
+    return ir;
+}
+
+/* Jumps to moved statements now go to the next remaining
+   one, since moved statements are executed before the
+   loop. */
+static void jumps_retarget(struct ir_fn_decl *decl)
+{
+    for (struct ir_node *it = decl->body; it; it = it->next) {
+        if (it->type == IR_JUMP) {
+            struct ir_jump *jump = it->ir;
+            jump->target = remaining_next(jump->target);
+        }
+
+        if (it->type == IR_COND) {
+            struct ir_cond *cond = it->ir;
+            cond->target = remaining_next(cond->target);
+        }
+    }
+}
+
+static void list_unlink(struct ir_node *ir)
+{
+    if (ir->prev)
+        ir->prev->next = ir->next;
+    if (ir->next)
+        ir->next->prev = ir->prev;
+
+    ir->prev = NULL;
+    ir->next = NULL;
+}
+
+/* Move invariant statements between entry and header. Now
+   the last moved statement is a predecessor of header. */
+static bool hoist(struct ir_fn_decl *decl, struct ir_loop *loop)
+{
+    ir_vector_t     stmts = {0};
+    ir_vector_t     move  = {0};
+    struct ir_node *entry = ir_loop_entry(decl, loop);
+
+    if (!entry)
+        return 0;
+
+    hashmap_reset(&moved, 64);
+
+    invariants_collect(loop, &stmts);
+    moved_collect(loop, &stmts, &move);
+    vector_free(stmts);
+
+    if (move.count == 0) {
+        vector_free(move);
+        return 0;
+    }
+
+    jumps_retarget(decl);
+
+    vector_foreach(move, i)
+        list_unlink(vector_at(move, i));
+
+    ir_loop_entry_insert(decl, loop, entry, &move);
+
+    vector_free(move);
+
+    return 1;
+}
+
+/* Innermost loop, not processed yet. */
+static struct ir_loop *loop_next(ir_loop_vector_t *loops)
+{
+    vector_foreach(*loops, i) {
+        struct ir_loop *loop  = vector_at(*loops, i);
+        struct ir_loop *inner = loop_next(&loop->children);
+
+        if (inner)
+            return inner;
+
+        if (!hashmap_has(&processed, (uint64_t) loop->header))
+            return loop;
+    }
+
+    return NULL;
+}
+
+static void ir_opt_motion_fn_decl(struct ir_fn_decl *decl)
+{
+    if (!decl->body)
+        return;
+
+    hashmap_reset(&processed, 64);
+
+    while (1) {
+        ir_dominator_tree(decl);
+        ir_loops_build(decl);
+
+        struct ir_loop *loop = loop_next(&decl->loops);
+
+        if (!loop)
+            break;
+
+        hashmap_put(&processed, (uint64_t) loop->header, 1);
+
+        defs_collect(decl);
+
+        if (hoist(decl, loop)) {
+            ir_renumber(decl->body);
+            ir_cfg_build(decl);
+        }
+    }
+
+    ir_loops_cleanup(decl);
+
+    hashmap_destroy(&defs);
+    hashmap_destroy(&unstable);
+    hashmap_destroy(&invariant);
+    hashmap_destroy(&moved);
+    hashmap_destroy(&processed);
+}
+
+void ir_opt_motion(struct ir_unit *ir)
+{
+    struct ir_node *it = ir->fn_decls;
+
+    while (it) {
+        ir_opt_motion_fn_decl(it->ir);
+        it = it->next;
+    }
+}
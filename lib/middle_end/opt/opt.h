@@ -7,16 +7,66 @@
 #ifndef WEAK_COMPILER_MIDDLE_END_OPT_H
 #define WEAK_COMPILER_MIDDLE_END_OPT_H
 
+#include <stdint.h>
+
 struct ir_fn_decl;
 struct ir_unit;
 
+/** All optimizations in order, in which compiler driver
+    runs them. Types are computed, CFG is built, SSA form is
+    built and destroyed inside.
+
+    \pre IR is just generated. */
+void ir_opt_pipeline(struct ir_unit *ir);
+
+/** Function inlining.
+
+    Calls are replaced with copies of callee body. Functions
+    are processed bottom-up over the call graph, recursive
+    calls are never inlined. Callee is inlined if it is small
+    enough for call site frequency, estimated by loop depth,
+    and caller stays in fixed size budget.
+
+    \pre CFG is built, IR is not in SSA form. */
+void ir_opt_inline(struct ir_unit *ir);
+
+/** Loop unrolling.
+
+    Innermost counted loops (variable compared with bound,
+    changed by constant once per iteration) are unrolled.
+    If trip count is small constant, loop is replaced with
+    copies of body. Otherwise body is repeated \p factor
+    times under one test, and remaining iterations are done
+    by copy of original loop. Factor less than 2 disables
+    the latter. Number of statements in function is kept in
+    fixed budget.
+
+    \pre CFG is built, IR is not in SSA form. */
+void ir_opt_unroll(struct ir_unit *ir, uint64_t factor);
+
 /** Invariant code motion.
-   
-    This is based on dominator tree analysis (probably).
-   
-    \pre Computed dominator tree. */
+
+    Binary expressions with loop-invariant operands are
+    moved before the loop header. Loops are taken from
+    loop-nest forest, innermost first. Division is moved
+    only if it is executed before any exit from the loop.
+    Loops entered from more than one statement are skipped.
+
+    \pre SSA form and CFG are built. */
 void ir_opt_motion(struct ir_unit *ir);
 
+/** Induction variables optimizations.
+
+    Derived induction variables computed by multiplication
+    (like offsets in multi-dimensional array accesses) are
+    replaced with new variables incremented on each
+    iteration. Then comparisons of basic variable with
+    loop-invariant bound are rewritten to use reduced one
+    (linear function test replacement).
+
+    \pre SSA form and CFG are built. */
+void ir_opt_induction(struct ir_unit *ir);
+
 /** Constant and expressions folding.
    
     \todo Dead code elimination. This will make
@@ -71,12 +121,53 @@ void ir_opt_fold(struct ir_unit *ir);
            - A | B = B | A */
 void ir_opt_arith(struct ir_unit *ir);
 
-#if 0
-void ir_opt_dead_code_elimination(struct ir_unit *ir);
-#endif
+/** Aggressive dead code elimination.
+
+    Statements are live only if they are needed to compute
+    side effects (return values, function calls, stores to
+    memory) directly, through data dependencies or through
+    control dependencies. All other statements are removed,
+    and useless conditions are turned into jumps.
+
+    \pre SSA form. */
+void ir_opt_dce(struct ir_unit *ir);
+
+/** Reassociation.
+
+    Chains of the same associative int operator (+, *, &, |,
+    ^), computed in one basic block, are flattened. Operands
+    are sorted by rank, so constants are folded together and
+    commutative operands get canonical order. Then chain is
+    rebuilt as balanced tree. Best run before ir_opt_gvn().
+
+    \pre SSA form and CFG are built. */
+void ir_opt_reassoc(struct ir_unit *ir);
+
+/** Global value numbering.
+
+    Binary expressions, computed again with the same operand
+    values, are replaced with copies of the dominating
+    computation, and uses are rewritten to it. Commutative
+    operators are numbered regardless of operand order.
+    Dead copies are left to ir_opt_dce().
+
+    \pre SSA form. */
+void ir_opt_gvn(struct ir_unit *ir);
 
 void ir_opt_unreachable_code(struct ir_unit *ir);
 
+/** Control flow graph simplification.
+
+    Jumps to jumps are threaded to final target, conditions
+    on constants are turned into jumps or removed, pair of
+    `if x != 0 goto L1; jmp L2` before L1 becomes one
+    `if x == 0 goto L2`, jumps to the next statement and
+    unreachable statements are removed. CFG is built again
+    only if something was changed.
+
+    \pre CFG is built, IR is not in SSA form. */
+void ir_opt_simplify_cfg(struct ir_unit *ir);
+
 /** Instruction reordering.
    
     This collects all alloca instructions in function
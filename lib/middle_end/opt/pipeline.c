@@ -0,0 +1,36 @@
+/* pipeline.c - Sequence of optimizations.
+ * Copyright (C) 2024 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#include "middle_end/opt/opt.h"
+#include "middle_end/ir/gen.h"
+#include "middle_end/ir/ir.h"
+#include "middle_end/ir/ssa.h"
+#include "middle_end/ir/type.h"
+
+void ir_opt_pipeline(struct ir_unit *ir)
+{
+    ir_type_pass(ir);
+    ir_opt_reorder(ir);
+    ir_opt_arith(ir);
+
+    struct ir_node *it = ir->fn_decls;
+    while (it) {
+        struct ir_fn_decl *decl = it->ir;
+        ir_cfg_build(decl);
+        it = it->next;
+    }
+
+    ir_opt_inline(ir);
+    ir_opt_unroll(ir, /*factor=*/4);
+    ir_compute_ssa(ir->fn_decls);
+    ir_opt_reassoc(ir);
+    ir_opt_gvn(ir);
+    ir_opt_motion(ir);
+    ir_opt_induction(ir);
+    ir_opt_dce(ir);
+    ir_destroy_ssa(ir->fn_decls);
+    ir_opt_simplify_cfg(ir);
+}
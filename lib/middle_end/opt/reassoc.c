@@ -0,0 +1,635 @@
+/* reassoc.c - Reassociation of expressions.
+ * Copyright (C) 2024 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#include "middle_end/opt/opt.h"
+#include "middle_end/ir/gen.h"
+#include "middle_end/ir/ir.h"
+#include "middle_end/ir/ir_ops.h"
+#include "front_end/lex/data_type.h"
+#include "util/hashmap.h"
+#include "util/vector.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* Chains of the same associative operator, like
+
+     t1 = a + 1
+     t2 = t1 + b
+     t3 = t2 + 2
+
+   are flattened to list of leaves {a, 1, b, 2}. Inner
+   results must be used only once, inside chain, and whole
+   chain must be in one basic block. Leaves are sorted by
+   rank: constants first, then parameters, then values by
+   position of their definition. So constants are folded
+   together, values, computed earlier (like loop
+   invariants), are paired first, and each expression gets
+   one canonical form for GVN. Then balanced tree is built
+   from leaves, so dependency chain has logarithmic length:
+
+     t1 = a + 3
+     t3 = t1 + b
+
+   Statements of inner results are reused for new tree and
+   moved right before root of chain. Reassociation is done
+   only over int, since floating point operations are not
+   associative.
+
+   P. Briggs, K. Cooper, "Effective partial redundancy
+   elimination", PLDI 1994. */
+
+struct leaf {
+    struct ir_node *ir;
+    /* Folded constant, not owned by any statement. */
+    bool            fresh;
+    uint64_t        rank;
+    uint64_t        idx;
+    uint64_t        ssa_idx;
+};
+
+typedef vector_t(struct leaf) leaf_vector_t;
+
+static struct ir_fn_decl *curr_decl;
+/* Key:   value_key(sym_idx, ssa_idx)
+   Value: store or phi, defining this value */
+static hashmap_t          defs;
+/* Key:   value_key(sym_idx, ssa_idx)
+   Value: number of uses, including phi operands */
+static hashmap_t          uses;
+/* Key:   sym_idx
+   Value: 1 if symbol without SSA version can change */
+static hashmap_t          unstable;
+/* Key:   store
+   Value: 1 if statement is already part of some chain */
+static hashmap_t          consumed;
+/* Statements, unlinked from IR list. They are freed after
+   CFG is built again. */
+static ir_vector_t        garbage;
+
+really_inline static uint64_t value_key(uint64_t sym_idx, uint64_t ssa_idx)
+{
+    return (sym_idx << 32) | (ssa_idx & 0xFFFFFFFF);
+}
+
+/**********************************************
+ **                Analysis                  **
+ **********************************************/
+
+static void use_count(struct ir_node *ir, unused void *data)
+{
+    struct ir_sym *sym = ir->ir;
+    uint64_t       key = value_key(sym->idx, sym->ssa_idx);
+    bool           ok  = 0;
+    uint64_t       n   = hashmap_get(&uses, key, &ok);
+
+    hashmap_put(&uses, key, ok ? n + 1 : 1);
+
+    if (sym->addr_of)
+        hashmap_put(&unstable, sym->idx, 1);
+}
+
+static void phi_use_count(struct ir_phi *phi)
+{
+    for (uint64_t i = 0; i < phi->args_size; ++i) {
+        uint64_t key = value_key(phi->sym_idx, phi->args[i].ssa_idx);
+        bool     ok  = 0;
+        uint64_t n   = hashmap_get(&uses, key, &ok);
+
+        hashmap_put(&uses, key, ok ? n + 1 : 1);
+    }
+}
+
+static void analyze(struct ir_fn_decl *decl)
+{
+    hashmap_reset(&defs, 256);
+    hashmap_reset(&uses, 256);
+    hashmap_reset(&unstable, 64);
+    hashmap_reset(&consumed, 64);
+
+    for (struct ir_node *it = decl->body; it; it = it->next) {
+        if (it->type == IR_PHI) {
+            struct ir_phi *phi = it->ir;
+
+            phi_use_count(phi);
+            hashmap_put(&defs, value_key(phi->sym_idx, phi->ssa_idx), (uint64_t) it);
+            continue;
+        }
+
+        ir_foreach_use(it, use_count, NULL);
+
+        struct ir_node *def = ir_def(it);
+        if (!def)
+            continue;
+
+        struct ir_sym *sym = def->ir;
+
+        if (sym->ssa_idx == UINT64_MAX)
+            hashmap_put(&unstable, sym->idx, 1);
+        else
+            hashmap_put(&defs, value_key(sym->idx, sym->ssa_idx), (uint64_t) it);
+    }
+}
+
+static bool associative(enum token_type op)
+{
+    switch (op) {
+    case TOK_PLUS:
+    case TOK_STAR:
+    case TOK_BIT_AND:
+    case TOK_BIT_OR:
+    case TOK_XOR:
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+static bool int_type(struct type *type)
+{
+    return type->dt == D_T_INT && type->ptr_depth == 0;
+}
+
+/* Statement `t = x op y`, where `t` is an int SSA value. */
+static struct ir_bin *chain_bin(struct ir_node *ir)
+{
+    if (ir->type != IR_STORE)
+        return NULL;
+
+    struct ir_store *store = ir->ir;
+    struct ir_sym   *def   = store->idx->ir;
+
+    if (def->deref || def->ssa_idx == UINT64_MAX || !int_type(&def->type_info))
+        return NULL;
+
+    if (store->body->type != IR_BIN)
+        return NULL;
+
+    struct ir_bin *bin = store->body->ir;
+
+    return associative(bin->op) ? bin : NULL;
+}
+
+/* Control can reach `to` only through `from`. Phi node
+   or jump before statement means start of basic block. */
+static bool straight(struct ir_node *from, struct ir_node *to)
+{
+    for (struct ir_node *it = from; it; it = it->next) {
+        if (it != from) {
+            struct ir_node *prev = it->prev;
+
+            if (prev->type == IR_PHI || prev->type == IR_JUMP || prev->type == IR_COND)
+                return 0;
+
+            if (it->cfg.preds.count != 1)
+                return 0;
+        }
+
+        if (it == to)
+            return 1;
+    }
+
+    return 0;
+}
+
+/* Value, which can be read at any point after definition. */
+static bool stable_leaf(struct ir_node *ir)
+{
+    if (ir->type == IR_IMM)
+        return ((struct ir_imm *) ir->ir)->type == IMM_INT;
+
+    if (ir->type != IR_SYM)
+        return 0;
+
+    struct ir_sym *sym = ir->ir;
+
+    if (sym->deref || sym->addr_of || !int_type(&sym->type_info))
+        return 0;
+
+    return sym->ssa_idx != UINT64_MAX || !hashmap_has(&unstable, sym->idx);
+}
+
+/* Statement, computing inner node of chain `op` with
+   root `root`, or NULL. */
+static struct ir_node *inner(struct ir_node *ir, enum token_type op, struct ir_node *root)
+{
+    if (ir->type != IR_SYM)
+        return NULL;
+
+    struct ir_sym *sym = ir->ir;
+
+    if (sym->deref || sym->addr_of || sym->ssa_idx == UINT64_MAX)
+        return NULL;
+
+    bool            ok   = 0;
+    uint64_t        key  = value_key(sym->idx, sym->ssa_idx);
+    struct ir_node *def  = (struct ir_node *) hashmap_get(&defs, key, &ok);
+    struct ir_bin  *bin  = NULL;
+
+    if (!ok || hashmap_has(&consumed, (uint64_t) def))
+        return NULL;
+
+    if (hashmap_get(&uses, key, &ok) != 1)
+        return NULL;
+
+    bin = chain_bin(def);
+
+    if (!bin || bin->op != op)
+        return NULL;
+
+    return straight(def, root) ? def : NULL;
+}
+
+/**********************************************
+ **               Flattening                 **
+ **********************************************/
+
+/* Phi node has index of statement it belongs to. */
+static uint64_t rank(struct ir_node *ir)
+{
+    if (ir->type == IR_IMM)
+        return 0;
+
+    struct ir_sym  *sym = ir->ir;
+    bool            ok  = 0;
+    struct ir_node *def = (struct ir_node *) hashmap_get(&defs, value_key(sym->idx, sym->ssa_idx), &ok);
+
+    if (sym->ssa_idx == UINT64_MAX || !ok)
+        return 1;
+
+    return def->instr_idx + 2;
+}
+
+static void leaf_push(leaf_vector_t *leaves, struct ir_node *ir)
+{
+    struct leaf leaf = {
+        .ir   = ir,
+        .rank = rank(ir)
+    };
+
+    if (ir->type == IR_SYM) {
+        leaf.idx     = ((struct ir_sym *) ir->ir)->idx;
+        leaf.ssa_idx = ((struct ir_sym *) ir->ir)->ssa_idx;
+    }
+
+    vector_push_back(*leaves, leaf);
+}
+
+/* Collect leaves of operand `ir` and statements of inner
+   nodes. Returns 0 if some leaf cannot be moved to root. */
+static bool flatten(
+    struct ir_node *ir,
+    enum token_type op,
+    struct ir_node *root,
+    leaf_vector_t  *leaves,
+    ir_vector_t    *inners
+) {
+    struct ir_node *def = inner(ir, op, root);
+
+    if (!def) {
+        if (!stable_leaf(ir))
+            return 0;
+
+        leaf_push(leaves, ir);
+        return 1;
+    }
+
+    struct ir_bin *bin = ((struct ir_store *) def->ir)->body->ir;
+
+    vector_push_back(*inners, def);
+
+    return flatten(bin->lhs, op, root, leaves, inners)
+        && flatten(bin->rhs, op, root, leaves, inners);
+}
+
+static int leaf_cmp(const void *l, const void *r)
+{
+    const struct leaf *a = l;
+    const struct leaf *b = r;
+
+    if (a->rank    != b->rank)    return a->rank    < b->rank    ? -1 : 1;
+    if (a->idx     != b->idx)     return a->idx     < b->idx     ? -1 : 1;
+    if (a->ssa_idx != b->ssa_idx) return a->ssa_idx < b->ssa_idx ? -1 : 1;
+    return 0;
+}
+
+static bool leaf_eq(struct leaf *l, struct leaf *r)
+{
+    return l->ir->type == IR_SYM
+        && r->ir->type == IR_SYM
+        && l->idx      == r->idx
+        && l->ssa_idx  == r->ssa_idx;
+}
+
+static int32_t fold(enum token_type op, int32_t l, int32_t r)
+{
+    switch (op) {
+    case TOK_PLUS:    return (int32_t) ((uint32_t) l + (uint32_t) r);
+    case TOK_STAR:    return (int32_t) ((uint32_t) l * (uint32_t) r);
+    case TOK_BIT_AND: return l & r;
+    case TOK_BIT_OR:  return l | r;
+    case TOK_XOR:     return l ^ r;
+    default:
+        weak_unreachable("Unexpected operator `%s`.", tok_to_string(op));
+    }
+}
+
+static int32_t identity(enum token_type op)
+{
+    switch (op) {
+    case TOK_STAR:    return 1;
+    case TOK_BIT_AND: return -1;
+    default:          return 0;
+    }
+}
+
+/* Constant, which makes whole chain equal to itself. */
+static bool absorbing(enum token_type op, int32_t c)
+{
+    switch (op) {
+    case TOK_STAR:
+    case TOK_BIT_AND: return c == 0;
+    case TOK_BIT_OR:  return c == -1;
+    default:          return 0;
+    }
+}
+
+/* Sort leaves, fold constants into one and remove
+   duplicates, where operator allows it (x & x = x,
+   x | x = x, x ^ x = 0). Returns 1 if the whole chain is
+   constant `*c`. */
+static bool canonicalize(enum token_type op, leaf_vector_t *leaves, int32_t *c)
+{
+    leaf_vector_t vars  = {0};
+    bool          konst = 0;
+
+    *c = identity(op);
+
+    qsort(leaves->data, leaves->count, sizeof (struct leaf), leaf_cmp);
+
+    vector_foreach(*leaves, i) {
+        struct leaf *leaf = &vector_at(*leaves, i);
+
+        if (leaf->ir->type == IR_IMM) {
+            *c    = fold(op, *c, ((struct ir_imm *) leaf->ir->ir)->imm.__int);
+            konst = 1;
+            continue;
+        }
+
+        if (vars.count > 0 && leaf_eq(&vector_back(vars), leaf)) {
+            if (op == TOK_BIT_AND || op == TOK_BIT_OR)
+                continue;
+
+            if (op == TOK_XOR) {
+                vector_pop_back(vars);
+                continue;
+            }
+        }
+
+        vector_push_back(vars, *leaf);
+    }
+
+    vector_clear(*leaves);
+
+    vector_foreach(vars, i)
+        vector_push_back(*leaves, vector_at(vars, i));
+
+    vector_free(vars);
+
+    if (absorbing(op, *c) || leaves->count == 0)
+        return 1;
+
+    if (konst && *c != identity(op)) {
+        struct leaf leaf = {
+            .ir    = ir_imm_int_init(*c),
+            .fresh = 1
+        };
+        vector_insert(*leaves, 0, leaf);
+    }
+
+    return 0;
+}
+
+/**********************************************
+ **                Rebuild                   **
+ **********************************************/
+
+static struct ir_node *leaf_copy(struct leaf *leaf)
+{
+    return leaf->fresh ? leaf->ir : ir_node_copy(leaf->ir);
+}
+
+/* Immediate is placed on the right, where other
+   optimizations expect it. */
+static struct ir_node *bin_make(enum token_type op, struct ir_node *lhs, struct ir_node *rhs)
+{
+    if (lhs->type == IR_IMM)
+        return ir_bin_init(op, rhs, lhs);
+
+    return ir_bin_init(op, lhs, rhs);
+}
+
+/* Build balanced tree level by level. Each inner bin is
+   written to the next statement of `inners`, which is
+   moved before root. Root gets last bin. */
+static void rebuild(
+    enum token_type  op,
+    struct ir_node  *root,
+    leaf_vector_t   *leaves,
+    ir_vector_t     *inners
+) {
+    ir_vector_t level = {0};
+    ir_vector_t next  = {0};
+    uint64_t    used  = 0;
+
+    vector_foreach(*leaves, i)
+        vector_push_back(level, leaf_copy(&vector_at(*leaves, i)));
+
+    while (level.count > 2) {
+        vector_clear(next);
+
+        for (uint64_t i = 0; i + 1 < level.count; i += 2) {
+            struct ir_node  *stmt  = vector_at(*inners, used++);
+            struct ir_store *store = stmt->ir;
+
+            store->body = bin_make(op, vector_at(level, i), vector_at(level, i + 1));
+
+            ir_insert_before(root, stmt, &curr_decl->body);
+            vector_push_back(next, ir_node_copy(store->idx));
+        }
+
+        if (level.count % 2 == 1)
+            vector_push_back(next, vector_back(level));
+
+        vector_clear(level);
+        vector_foreach(next, i)
+            vector_push_back(level, vector_at(next, i));
+    }
+
+    struct ir_store *store = root->ir;
+
+    if (level.count == 2)
+        store->body = bin_make(op, vector_at(level, 0), vector_at(level, 1));
+    else
+        store->body = vector_at(level, 0);
+
+    vector_free(level);
+    vector_free(next);
+}
+
+/* Inner statement `stmt` was unlinked from its place
+   after `prev`. Jumps to it should go to statement, which
+   is there now. */
+static void jumps_retarget(struct ir_node *stmt, struct ir_node *prev)
+{
+    struct ir_node *to = ir_next_stmt(prev);
+
+    vector_foreach(stmt->cfg.preds, i) {
+        struct ir_node *pred = vector_at(stmt->cfg.preds, i);
+
+        if (pred->type == IR_JUMP && ((struct ir_jump *) pred->ir)->target == stmt)
+            ((struct ir_jump *) pred->ir)->target = to;
+
+        if (pred->type == IR_COND && ((struct ir_cond *) pred->ir)->target == stmt)
+            ((struct ir_cond *) pred->ir)->target = to;
+    }
+}
+
+/* Old bodies are freed only after the new tree is built,
+   since leaves point into them. Inner statements, which
+   are not needed after constants folding, are freed with
+   their bodies after CFG is built again. */
+static void reassociate(struct ir_node *root)
+{
+    struct ir_store *store  = root->ir;
+    struct ir_bin   *bin    = store->body->ir;
+    enum token_type  op     = bin->op;
+    leaf_vector_t    leaves = {0};
+    ir_vector_t      inners = {0};
+    ir_vector_t      bodies = {0};
+    ir_vector_t      prevs  = {0};
+    uint64_t         needed = 0;
+    int32_t          c      = 0;
+
+    if (!flatten(bin->lhs, op, root, &leaves, &inners) ||
+        !flatten(bin->rhs, op, root, &leaves, &inners))
+        goto out;
+
+    if (canonicalize(op, &leaves, &c)) {
+        struct leaf leaf = {
+            .ir    = ir_imm_int_init(c),
+            .fresh = 1
+        };
+
+        vector_clear(leaves);
+        vector_push_back(leaves, leaf);
+    }
+
+    needed = leaves.count > 2 ? leaves.count - 2 : 0;
+
+    vector_push_back(bodies, store->body);
+
+    vector_foreach(inners, i) {
+        struct ir_node  *stmt = vector_at(inners, i);
+        struct ir_store *s    = stmt->ir;
+        struct ir_node  *head = stmt;
+
+        hashmap_put(&consumed, (uint64_t) stmt, 1);
+        vector_push_back(prevs, stmt->prev);
+        ir_remove(&head, &curr_decl->body);
+
+        if (i < needed)
+            vector_push_back(bodies, s->body);
+        else
+            vector_push_back(garbage, stmt);
+    }
+
+    rebuild(op, root, &leaves, &inners);
+
+    vector_foreach(inners, i)
+        jumps_retarget(vector_at(inners, i), vector_at(prevs, i));
+
+    vector_foreach(bodies, i)
+        ir_node_cleanup(vector_at(bodies, i));
+
+out:
+    vector_free(leaves);
+    vector_free(inners);
+    vector_free(bodies);
+    vector_free(prevs);
+}
+
+/* Data dependence edges to removed statements are dropped. */
+static void ddg_update(struct ir_fn_decl *decl)
+{
+    hashmap_t removed = {0};
+
+    hashmap_init(&removed, 64);
+
+    vector_foreach(garbage, i)
+        hashmap_put(&removed, (uint64_t) vector_at(garbage, i), 1);
+
+    for (struct ir_node *it = decl->body; it; it = it->next) {
+        ir_vector_t *ddgs = &it->ddg_stmts;
+
+        for (uint64_t i = 0; i < ddgs->count; ) {
+            if (hashmap_has(&removed, (uint64_t) vector_at(*ddgs, i)))
+                vector_erase(*ddgs, i);
+            else
+                ++i;
+        }
+    }
+
+    hashmap_destroy(&removed);
+}
+
+static void ir_opt_reassoc_fn_decl(struct ir_fn_decl *decl)
+{
+    ir_vector_t roots = {0};
+
+    if (!decl->body)
+        return;
+
+    curr_decl = decl;
+
+    analyze(decl);
+
+    for (struct ir_node *it = decl->body; it; it = it->next)
+        if (chain_bin(it))
+            vector_push_back(roots, it);
+
+    /* From the end, so last statement of chain is
+       always its root. */
+    vector_foreach_back(roots, i) {
+        struct ir_node *it = vector_at(roots, i);
+
+        if (!hashmap_has(&consumed, (uint64_t) it))
+            reassociate(it);
+    }
+
+    ir_renumber(decl->body);
+    ir_cfg_build(decl);
+    ddg_update(decl);
+
+    vector_foreach(garbage, i)
+        ir_node_cleanup(vector_at(garbage, i));
+
+    vector_free(roots);
+    vector_free(garbage);
+    hashmap_destroy(&defs);
+    hashmap_destroy(&uses);
+    hashmap_destroy(&unstable);
+    hashmap_destroy(&consumed);
+}
+
+void ir_opt_reassoc(struct ir_unit *ir)
+{
+    struct ir_node *it = ir->fn_decls;
+
+    while (it) {
+        ir_opt_reassoc_fn_decl(it->ir);
+        it = it->next;
+    }
+}
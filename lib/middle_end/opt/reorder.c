@@ -127,6 +127,15 @@ static void ir_opt_reorder_fn_decl(struct ir_fn_decl *decl)
             swap(it);
     }
 
+    /* Swapping with the first statement drops back link,
+       so restore them all. */
+    struct ir_node *prev = NULL;
+
+    for (it = decl->body; it; it = it->next) {
+        it->prev = prev;
+        prev = it;
+    }
+
     vector_free(stmts);
 }
 
@@ -0,0 +1,371 @@
+/* simplify.c - Control flow graph simplification.
+ * Copyright (C) 2024 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#include "middle_end/opt/opt.h"
+#include "middle_end/ir/gen.h"
+#include "middle_end/ir/ir.h"
+#include "middle_end/ir/ir_ops.h"
+#include "util/hashmap.h"
+#include "util/vector.h"
+#include <string.h>
+
+/* IR generator emits each `if` and loop condition as
+
+     if x != 0 goto L1
+     jmp L2
+   L1:
+
+   and each `break` or end of `else` branch as jump, which
+   often goes to another jump. Other passes leave
+   conditions on constants and code after them, which is
+   never executed. Each such statement costs dispatch in
+   interpreter and branch in native code.
+
+   There are no explicit basic blocks in IR, so blocks are
+   merged by removing jumps between them. Rules are applied
+   until nothing changes:
+
+     1. Jump to jump goes directly to final target.
+     2. Condition on constants becomes jump or is removed.
+     3. `if x goto L1; jmp L2; L1:` becomes `if !x goto L2`.
+     4. Jump to next statement is removed.
+     5. Statements, not reachable from function entry, are
+        removed. */
+
+/* Limit of followed jumps, protects from cycles
+   like `L1: jmp L1`. */
+#define THREAD_LIMIT 64
+
+static struct ir_fn_decl *curr_decl;
+static bool               changed;
+/* Removed statements. They are freed after CFG is built
+   again. */
+static ir_vector_t        garbage;
+
+/**********************************************
+ **                 Helpers                  **
+ **********************************************/
+
+static struct ir_node **target_of(struct ir_node *ir)
+{
+    switch (ir->type) {
+    case IR_JUMP: return &((struct ir_jump *) ir->ir)->target;
+    case IR_COND: return &((struct ir_cond *) ir->ir)->target;
+    default:      return NULL;
+    }
+}
+
+static void retarget(struct ir_node *from, struct ir_node *to)
+{
+    for (struct ir_node *it = curr_decl->body; it; it = it->next) {
+        struct ir_node **target = target_of(it);
+
+        if (target && *target == from)
+            *target = to;
+    }
+}
+
+static bool targeted(struct ir_node *stmt)
+{
+    for (struct ir_node *it = curr_decl->body; it; it = it->next) {
+        struct ir_node **target = target_of(it);
+
+        if (target && *target == stmt)
+            return 1;
+    }
+
+    return 0;
+}
+
+static void unlink(struct ir_node *stmt)
+{
+    if (stmt->prev)
+        stmt->prev->next = stmt->next;
+    else
+        curr_decl->body = stmt->next;
+
+    if (stmt->next)
+        stmt->next->prev = stmt->prev;
+
+    vector_push_back(garbage, stmt);
+    changed = 1;
+}
+
+/* Remove statement, jumps to it go to `to`. */
+static void stmt_remove(struct ir_node *stmt, struct ir_node *to)
+{
+    retarget(stmt, to);
+    unlink(stmt);
+}
+
+/**********************************************
+ **                 Rules                    **
+ **********************************************/
+
+static void thread(struct ir_node *ir)
+{
+    struct ir_node **target = target_of(ir);
+    struct ir_node  *to     = *target;
+
+    for (uint64_t i = 0; i < THREAD_LIMIT; ++i) {
+        if (to->type != IR_JUMP || to == ir)
+            break;
+
+        to = ((struct ir_jump *) to->ir)->target;
+    }
+
+    if (to != *target) {
+        *target = to;
+        changed = 1;
+    }
+}
+
+static bool imm_value(struct ir_node *ir, double *out)
+{
+    if (ir->type != IR_IMM)
+        return 0;
+
+    struct ir_imm *imm = ir->ir;
+
+    switch (imm->type) {
+    case IMM_BOOL:  *out = imm->imm.__bool;  break;
+    case IMM_CHAR:  *out = imm->imm.__char;  break;
+    case IMM_FLOAT: *out = imm->imm.__float; break;
+    case IMM_INT:   *out = imm->imm.__int;   break;
+    default:
+        return 0;
+    }
+
+    return 1;
+}
+
+/* Evaluate comparison of immediates. Returns 0 if
+   condition is not constant. */
+static bool cond_value(struct ir_cond *cond, bool *out)
+{
+    struct ir_bin *bin = cond->cond->ir;
+    double         l   = 0;
+    double         r   = 0;
+
+    if (!imm_value(bin->lhs, &l) || !imm_value(bin->rhs, &r))
+        return 0;
+
+    switch (bin->op) {
+    case TOK_EQ:  *out = l == r; break;
+    case TOK_NEQ: *out = l != r; break;
+    case TOK_LT:  *out = l <  r; break;
+    case TOK_GT:  *out = l >  r; break;
+    case TOK_LE:  *out = l <= r; break;
+    case TOK_GE:  *out = l >= r; break;
+    default:
+        return 0;
+    }
+
+    return 1;
+}
+
+static void fold_cond(struct ir_node *ir)
+{
+    struct ir_cond *cond  = ir->ir;
+    bool            taken = 0;
+
+    if (cond->cond->type != IR_BIN || !cond_value(cond, &taken))
+        return;
+
+    if (!taken) {
+        stmt_remove(ir, ir_next_stmt(ir));
+        return;
+    }
+
+    struct ir_node *jump = ir_jump_init(cond->target->instr_idx);
+
+    ((struct ir_jump *) jump->ir)->target = cond->target;
+    memcpy(&jump->meta, &ir->meta, sizeof (struct meta));
+
+    ir_insert_before(ir, jump, &curr_decl->body);
+    stmt_remove(ir, jump);
+}
+
+/* Only equality is inverted, since `!(a < b)` is not
+   `a >= b` for NaN floats. */
+static void invert(struct ir_node *ir)
+{
+    struct ir_cond *cond = ir->ir;
+    struct ir_node *jump = ir->next;
+
+    if (!jump || jump->type != IR_JUMP || cond->target != jump->next)
+        return;
+
+    if (cond->cond->type != IR_BIN || targeted(jump))
+        return;
+
+    struct ir_bin *bin = cond->cond->ir;
+
+    switch (bin->op) {
+    case TOK_EQ:  bin->op = TOK_NEQ; break;
+    case TOK_NEQ: bin->op = TOK_EQ;  break;
+    default:
+        return;
+    }
+
+    cond->target = ((struct ir_jump *) jump->ir)->target;
+    unlink(jump);
+}
+
+static void jump_to_next(struct ir_node *ir)
+{
+    struct ir_jump *jump = ir->ir;
+    struct ir_node *next = ir_next_stmt(ir);
+
+    if (next && jump->target == next)
+        stmt_remove(ir, next);
+}
+
+static void rules_apply()
+{
+    struct ir_node *it   = curr_decl->body;
+    struct ir_node *next = NULL;
+
+    for (; it; it = next) {
+        next = it->next;
+
+        if (it->type == IR_JUMP || it->type == IR_COND)
+            thread(it);
+
+        if (it->type == IR_COND) {
+            fold_cond(it);
+            continue;
+        }
+
+        if (it->type == IR_JUMP)
+            jump_to_next(it);
+    }
+
+    /* Jump after condition is removed here, so next
+       statement is taken after invert(). */
+    for (it = curr_decl->body; it; it = it->next)
+        if (it->type == IR_COND)
+            invert(it);
+}
+
+/* Walk over built CFG from function entry. */
+static void unreachable_remove()
+{
+    hashmap_t   visited = {0};
+    ir_vector_t w       = {0};
+
+    hashmap_init(&visited, 256);
+    hashmap_put(&visited, (uint64_t) curr_decl->body, 1);
+    vector_push_back(w, curr_decl->body);
+
+    while (w.count > 0) {
+        struct ir_node *it = vector_back(w);
+        vector_pop_back(w);
+
+        vector_foreach(it->cfg.succs, i) {
+            struct ir_node *succ = vector_at(it->cfg.succs, i);
+
+            if (!hashmap_has(&visited, (uint64_t) succ)) {
+                hashmap_put(&visited, (uint64_t) succ, 1);
+                vector_push_back(w, succ);
+            }
+        }
+    }
+
+    struct ir_node *next = NULL;
+
+    for (struct ir_node *it = curr_decl->body; it; it = next) {
+        next = it->next;
+
+        /* Jumps to unreachable statements are unreachable
+           too, so nothing is retargeted. */
+        if (!hashmap_has(&visited, (uint64_t) it))
+            unlink(it);
+    }
+
+    vector_free(w);
+    hashmap_destroy(&visited);
+}
+
+/* Data dependence edges to removed statements are dropped. */
+static void ddg_update()
+{
+    hashmap_t removed = {0};
+
+    hashmap_init(&removed, 64);
+
+    vector_foreach(garbage, i)
+        hashmap_put(&removed, (uint64_t) vector_at(garbage, i), 1);
+
+    for (struct ir_node *it = curr_decl->body; it; it = it->next) {
+        ir_vector_t *ddgs = &it->ddg_stmts;
+
+        for (uint64_t i = 0; i < ddgs->count; ) {
+            if (hashmap_has(&removed, (uint64_t) vector_at(*ddgs, i)))
+                vector_erase(*ddgs, i);
+            else
+                ++i;
+        }
+    }
+
+    hashmap_destroy(&removed);
+}
+
+static void ir_opt_simplify_cfg_fn_decl(struct ir_fn_decl *decl)
+{
+    bool modified = 0;
+
+
+    if (!decl->body)
+        return;
+
+    curr_decl = decl;
+
+    /* CFG is built again only after some rule changed
+       something. Unreachable code is found on new CFG. */
+    do {
+        bool round = 0;
+
+        changed = 0;
+        rules_apply();
+
+        if (changed) {
+            ir_renumber(decl->body);
+            ir_cfg_build(decl);
+        }
+
+        round   = changed;
+        changed = 0;
+        unreachable_remove();
+
+        if (changed) {
+            ir_renumber(decl->body);
+            ir_cfg_build(decl);
+        }
+
+        round    |= changed;
+        modified |= round;
+        changed   = round;
+    } while (changed);
+
+    if (modified)
+        ddg_update();
+
+    vector_foreach(garbage, i)
+        ir_node_cleanup(vector_at(garbage, i));
+
+    vector_free(garbage);
+}
+
+void ir_opt_simplify_cfg(struct ir_unit *ir)
+{
+    struct ir_node *it = ir->fn_decls;
+
+    while (it) {
+        ir_opt_simplify_cfg_fn_decl(it->ir);
+        it = it->next;
+    }
+}
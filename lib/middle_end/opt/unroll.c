@@ -0,0 +1,857 @@
+/* unroll.c - Loop unrolling.
+ * Copyright (C) 2024 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#include "middle_end/opt/opt.h"
+#include "middle_end/ir/dom.h"
+#include "middle_end/ir/gen.h"
+#include "middle_end/ir/ir.h"
+#include "middle_end/ir/ir_ops.h"
+#include "middle_end/ir/loop.h"
+#include "util/hashmap.h"
+#include "util/vector.h"
+#include <limits.h>
+#include <string.h>
+
+/* Unrolling is done before SSA construction, so copied
+   statements assign the same variables as original ones
+   and nothing has to be renamed.
+
+   Loop is counted, if it has the form generated for `for`
+   and `while` statements
+
+     header:    t = i op bound
+                if t != 0 goto body
+                jmp exit
+     body:      ...
+                i = i + step
+                jmp header
+
+   where `i` is an `int` variable, whose address is never
+   taken, assigned in loop only once on each iteration, and
+   `bound` is an immediate value or variable not changed in
+   loop. Body may leave the loop (break, return), but it
+   cannot go to header other than through the latch. Only
+   innermost loops are unrolled.
+
+   If `i` is initialized by constant right before the loop,
+   the number of iterations is known. Loop with a small trip
+   count is fully unrolled: header test and back edge are
+   removed and body is repeated trip count times.
+
+   Other counted loops are unrolled by given factor F
+
+     header:    t = i op bound - (F - 1) * step
+                if t != 0 goto body
+                jmp remainder
+     body:      body x F
+                jmp header
+     remainder: original loop
+
+   Test of the first loop guarantees, that all F copies of
+   body are executed, so tests between them are not needed.
+   Less than F last iterations are done by remainder loop.
+   As everywhere in the compiler, signed overflow of bound
+   is not expected.
+
+   Dominator tree is limited in size, and each copy makes
+   function bigger, so the number of statements in function
+   after unrolling cannot exceed UNROLL_BUDGET. */
+
+/** Maximum trip count of fully unrolled loop. */
+#define UNROLL_FULL_TRIPS  16
+/** Maximum size of fully unrolled loop. */
+#define UNROLL_FULL_SIZE   64
+/** Maximum size of body unrolled by factor. */
+#define UNROLL_BODY_SIZE   32
+/** Maximum number of statements in function. */
+#define UNROLL_BUDGET      384
+
+struct counted {
+    /** `t = i op bound`. */
+    struct ir_node  *test;
+    /** `if t != 0 goto first`. */
+    struct ir_node  *cond;
+    /** `jmp exit`. */
+    struct ir_node  *exit;
+    /** First statement of body. */
+    struct ir_node  *first;
+    /** `jmp header`. */
+    struct ir_node  *latch;
+    /** Operand of test, that is compared with `i`. */
+    struct ir_node  *bound;
+    /** Operator, as if `i` was left operand. */
+    enum token_type  op;
+    uint64_t         sym_idx;
+    int64_t          step;
+    /** Statements in body, except allocas. */
+    uint64_t         size;
+};
+
+/* Key:   sym_idx
+   Value: 1 if address of variable is taken */
+static hashmap_t addr_taken;
+/* Key:   sym_idx
+   Value: 1 if variable is plain `int` */
+static hashmap_t ints;
+/* Key:   original statement
+   Value: its copy */
+static hashmap_t copies;
+/* Key:   loop header
+   Value: 1 */
+static hashmap_t processed;
+static uint64_t  next_sym_idx;
+
+/**********************************************
+ **               Analysis                   **
+ **********************************************/
+
+static void addr_taken_collect(struct ir_node *ir, unused void *data)
+{
+    struct ir_sym *sym = ir->ir;
+
+    if (sym->addr_of)
+        hashmap_put(&addr_taken, sym->idx, 1);
+}
+
+static void alloca_collect(struct ir_node *ir)
+{
+    uint64_t idx = 0;
+
+    if (ir->type == IR_ALLOCA_ARRAY)
+        idx = ((struct ir_alloca_array *) ir->ir)->idx;
+    else if (ir->type == IR_ALLOCA)
+        idx = ((struct ir_alloca *) ir->ir)->idx;
+    else
+        return;
+
+    if (next_sym_idx <= idx)
+        next_sym_idx = idx + 1;
+
+    if (ir->type != IR_ALLOCA)
+        return;
+
+    struct ir_alloca *alloca = ir->ir;
+
+    if (alloca->dt == D_T_INT && alloca->ptr_depth == 0)
+        hashmap_put(&ints, alloca->idx, 1);
+}
+
+static uint64_t syms_collect(struct ir_fn_decl *decl)
+{
+    uint64_t size = 0;
+
+    hashmap_reset(&addr_taken, 64);
+    hashmap_reset(&ints, 64);
+    next_sym_idx = 0;
+
+    for (struct ir_node *it = decl->args; it; it = it->next)
+        alloca_collect(it);
+
+    for (struct ir_node *it = decl->body; it; it = it->next) {
+        alloca_collect(it);
+        ir_foreach_use(it, addr_taken_collect, NULL);
+        ++size;
+    }
+
+    return size;
+}
+
+/* Plain `int` variable, that can be changed only by
+   assignment to it. */
+static bool int_var(struct ir_node *ir)
+{
+    if (ir->type != IR_SYM)
+        return 0;
+
+    struct ir_sym *sym = ir->ir;
+
+    return !sym->deref && !sym->addr_of &&
+           !hashmap_has(&addr_taken, sym->idx) &&
+            hashmap_has(&ints, sym->idx);
+}
+
+static bool int_imm(struct ir_node *ir, int64_t *out)
+{
+    if (ir->type != IR_IMM)
+        return 0;
+
+    struct ir_imm *imm = ir->ir;
+
+    if (imm->type != IMM_INT)
+        return 0;
+
+    *out = imm->imm.__int;
+    return 1;
+}
+
+static bool in_range(int64_t v)
+{
+    return v >= INT_MIN && v <= INT_MAX;
+}
+
+static bool comparison(enum token_type op)
+{
+    return op == TOK_LT || op == TOK_LE ||
+           op == TOK_GT || op == TOK_GE ||
+           op == TOK_NEQ;
+}
+
+/* `bound op i` is `i swapped(op) bound`. */
+static enum token_type swapped(enum token_type op)
+{
+    switch (op) {
+    case TOK_LT: return TOK_GT;
+    case TOK_LE: return TOK_GE;
+    case TOK_GT: return TOK_LT;
+    case TOK_GE: return TOK_LE;
+    default:     return op;
+    }
+}
+
+/* Statements of loop, assigning variable. */
+static uint64_t defs_count(struct ir_loop *loop, uint64_t sym_idx, struct ir_node **last)
+{
+    uint64_t count = 0;
+
+    vector_foreach(loop->stmts, i) {
+        struct ir_node *it  = vector_at(loop->stmts, i);
+        struct ir_node *def = ir_def(it);
+
+        if (def && ((struct ir_sym *) def->ir)->idx == sym_idx) {
+            *last = it;
+            ++count;
+        }
+    }
+
+    return count;
+}
+
+static bool sym_is(struct ir_node *ir, uint64_t sym_idx)
+{
+    return ir->type == IR_SYM && !((struct ir_sym *) ir->ir)->deref &&
+           ((struct ir_sym *) ir->ir)->idx == sym_idx;
+}
+
+/* Match `i + step`, `step + i` or `i - step`. */
+static bool step_match(struct ir_node *ir, uint64_t sym_idx, int64_t *step)
+{
+    if (ir->type != IR_BIN)
+        return 0;
+
+    struct ir_bin *bin = ir->ir;
+
+    if (bin->op == TOK_PLUS && sym_is(bin->lhs, sym_idx))
+        return int_imm(bin->rhs, step) && *step != 0;
+
+    if (bin->op == TOK_PLUS && sym_is(bin->rhs, sym_idx))
+        return int_imm(bin->lhs, step) && *step != 0;
+
+    if (bin->op == TOK_MINUS && sym_is(bin->lhs, sym_idx) && int_imm(bin->rhs, step)) {
+        *step = -*step;
+        return *step != 0;
+    }
+
+    return 0;
+}
+
+/* `i = i + step` or `t = i + step; i = t`. Update must be
+   executed on each iteration. */
+static bool update_match(struct counted *c, struct ir_loop *loop)
+{
+    struct ir_node *update = NULL;
+
+    if (defs_count(loop, c->sym_idx, &update) != 1)
+        return 0;
+
+    if (ir_loop_of(update) != loop || !ir_dominates(update, c->latch))
+        return 0;
+
+    struct ir_store *store = update->ir;
+
+    if (step_match(store->body, c->sym_idx, &c->step))
+        return 1;
+
+    struct ir_node *prev = update->prev;
+
+    if (!int_var(store->body) || update->cfg.preds.count != 1 ||
+        !prev || prev->type != IR_STORE)
+        return 0;
+
+    struct ir_node *def = ir_def(prev);
+
+    if (!def || !sym_is(def, ((struct ir_sym *) store->body->ir)->idx))
+        return 0;
+
+    return step_match(((struct ir_store *) prev->ir)->body, c->sym_idx, &c->step);
+}
+
+static bool bound_match(struct counted *c, struct ir_loop *loop)
+{
+    int64_t         imm  = 0;
+    struct ir_node *last = NULL;
+
+    if (int_imm(c->bound, &imm))
+        return 1;
+
+    if (!int_var(c->bound) || sym_is(c->bound, c->sym_idx))
+        return 0;
+
+    return defs_count(loop, ((struct ir_sym *) c->bound->ir)->idx, &last) == 0;
+}
+
+/* Choose variable side of `t = lhs op rhs`. */
+static bool test_match(struct counted *c, struct ir_loop *loop)
+{
+    struct ir_store *store = c->test->ir;
+    struct ir_node  *last  = NULL;
+
+    if (store->body->type != IR_BIN)
+        return 0;
+
+    struct ir_bin *bin = store->body->ir;
+
+    if (!comparison(bin->op))
+        return 0;
+
+    for (uint64_t i = 0; i < 2; ++i) {
+        struct ir_node *var   = i == 0 ? bin->lhs : bin->rhs;
+        struct ir_node *bound = i == 0 ? bin->rhs : bin->lhs;
+
+        if (!int_var(var))
+            continue;
+
+        c->sym_idx = ((struct ir_sym *) var->ir)->idx;
+        c->bound   = bound;
+        c->op      = i == 0 ? bin->op : swapped(bin->op);
+
+        if (defs_count(loop, c->sym_idx, &last) == 1)
+            return update_match(c, loop) && bound_match(c, loop);
+    }
+
+    return 0;
+}
+
+/* `if t != 0 goto first`, where `t` is the test result. */
+static bool cond_match(struct counted *c)
+{
+    struct ir_cond *cond = c->cond->ir;
+    struct ir_bin  *bin  = cond->cond->ir;
+    struct ir_node *def  = ir_def(c->test);
+    int64_t         zero = -1;
+
+    return bin->op == TOK_NEQ &&
+           def && sym_is(bin->lhs, ((struct ir_sym *) def->ir)->idx) &&
+           int_imm(bin->rhs, &zero) && zero == 0 &&
+           cond->target == c->exit->next;
+}
+
+/* All statements of loop lie between header and the latch,
+   and this range is entered only through header. Exits
+   from loop (like jump out of header or `break`) can be
+   in range, they are copied together with body. */
+static bool range_closed(struct ir_fn_decl *decl, struct ir_loop *loop, struct ir_node *latch)
+{
+    hashmap_t range = {0};
+    uint64_t  count = 0;
+    bool      ok    = 1;
+
+    hashmap_init(&range, 64);
+
+    for (struct ir_node *it = loop->header; it; it = it->next) {
+        hashmap_put(&range, (uint64_t) it, 1);
+        count += ir_loop_contains(loop, it);
+
+        if (it == latch)
+            break;
+    }
+
+    ok = count == loop->stmts.count;
+
+    for (struct ir_node *it = decl->body; ok && it; it = it->next) {
+        if (hashmap_has(&range, (uint64_t) it))
+            continue;
+
+        vector_foreach(it->cfg.succs, i) {
+            struct ir_node *succ = vector_at(it->cfg.succs, i);
+
+            if (succ != loop->header && hashmap_has(&range, (uint64_t) succ))
+                ok = 0;
+        }
+    }
+
+    hashmap_destroy(&range);
+
+    return ok;
+}
+
+static bool counted_match(struct ir_fn_decl *decl, struct ir_loop *loop, struct counted *c)
+{
+    memset(c, 0, sizeof (*c));
+
+    if (loop->children.count > 0 || loop->latches.count != 1)
+        return 0;
+
+    c->latch = vector_at(loop->latches, 0);
+
+    if (c->latch->type != IR_JUMP || !c->latch->next || !range_closed(decl, loop, c->latch))
+        return 0;
+
+    struct ir_node *it = loop->header;
+
+    while (it->type == IR_ALLOCA)
+        it = it->next;
+
+    c->test  = it;
+    c->cond  = c->test->next;
+    c->exit  = c->cond->next;
+    c->first = c->exit->next;
+
+    if (c->test->type != IR_STORE || c->cond->type != IR_COND ||
+        c->exit->type != IR_JUMP  || c->first == c->latch)
+        return 0;
+
+    struct ir_jump *exit = c->exit->ir;
+
+    if (ir_loop_contains(loop, exit->target) || !cond_match(c) || !test_match(c, loop))
+        return 0;
+
+    for (it = c->first; it != c->latch; it = it->next)
+        if (it->type != IR_ALLOCA)
+            ++c->size;
+
+    return 1;
+}
+
+/* Walk back from the entry of loop through statements with
+   the only predecessor to the last assignment of `i`. */
+static bool init_find(struct ir_fn_decl *decl, struct ir_loop *loop, uint64_t sym_idx, int64_t *init)
+{
+    struct ir_node *it = ir_loop_entry(decl, loop);
+
+    while (it) {
+        struct ir_node *def = ir_def(it);
+
+        if (def && ((struct ir_sym *) def->ir)->idx == sym_idx)
+            return int_imm(((struct ir_store *) it->ir)->body, init);
+
+        if (it->cfg.preds.count != 1)
+            return 0;
+
+        it = vector_at(it->cfg.preds, 0);
+    }
+
+    return 0;
+}
+
+static bool trip_count(struct counted *c, int64_t init, int64_t *out)
+{
+    int64_t bound = 0;
+    int64_t step  = c->step;
+    int64_t n     = 0;
+
+    if (!int_imm(c->bound, &bound))
+        return 0;
+
+    switch (c->op) {
+    case TOK_LT:
+        if (step < 0) return 0;
+        n = init < bound ? (bound - init + step - 1) / step : 0;
+        break;
+    case TOK_LE:
+        if (step < 0) return 0;
+        n = init <= bound ? (bound - init) / step + 1 : 0;
+        break;
+    case TOK_GT:
+        if (step > 0) return 0;
+        n = init > bound ? (init - bound - step - 1) / -step : 0;
+        break;
+    case TOK_GE:
+        if (step > 0) return 0;
+        n = init >= bound ? (init - bound) / -step + 1 : 0;
+        break;
+    case TOK_NEQ:
+        if ((bound - init) % step != 0 || (bound - init) / step < 0)
+            return 0;
+        n = (bound - init) / step;
+        break;
+    default:
+        return 0;
+    }
+
+    /* Variable must not wrap around. */
+    if (!in_range(init + n * step))
+        return 0;
+
+    *out = n;
+    return 1;
+}
+
+/**********************************************
+ **               Transformation             **
+ **********************************************/
+
+static void retarget(struct ir_node *ir, struct ir_node *from, struct ir_node *to)
+{
+    if (ir->type == IR_JUMP && ((struct ir_jump *) ir->ir)->target == from)
+        ((struct ir_jump *) ir->ir)->target = to;
+
+    if (ir->type == IR_COND && ((struct ir_cond *) ir->ir)->target == from)
+        ((struct ir_cond *) ir->ir)->target = to;
+}
+
+static void jumps_retarget(struct ir_fn_decl *decl, struct ir_node *from, struct ir_node *to)
+{
+    for (struct ir_node *it = decl->body; it; it = it->next)
+        retarget(it, from, to);
+}
+
+static struct ir_node *copy_of(struct ir_node *ir)
+{
+    bool     ok  = 0;
+    uint64_t got = hashmap_get(&copies, (uint64_t) ir, &ok);
+
+    return ok ? (struct ir_node *) got : ir;
+}
+
+static void copy_retarget(struct ir_node *ir)
+{
+    if (ir->type == IR_JUMP) {
+        struct ir_jump *jump = ir->ir;
+        jump->target = copy_of(jump->target);
+    }
+
+    if (ir->type == IR_COND) {
+        struct ir_cond *cond = ir->ir;
+        cond->target = copy_of(cond->target);
+    }
+}
+
+/* Copy \p body before \p pos. Allocas are not copied, since
+   variables are already declared. Jumps inside body go to
+   copies, jumps to \p end (the statement after body) go to
+   \p pos. Result is the first statement of copy. */
+static struct ir_node *body_copy(
+    struct ir_fn_decl *decl,
+    ir_vector_t       *body,
+    struct ir_node    *end,
+    struct ir_node    *pos
+) {
+    ir_vector_t     made = {0};
+    struct ir_node *next = pos;
+
+    hashmap_reset(&copies, 64);
+    hashmap_put(&copies, (uint64_t) end, (uint64_t) pos);
+
+    for (int64_t i = body->count - 1; i >= 0; --i) {
+        struct ir_node *it = vector_at(*body, i);
+
+        if (it->type != IR_ALLOCA)
+            next = ir_node_copy(it);
+
+        /* Jump to skipped alloca goes to the next copied
+           statement. */
+        hashmap_put(&copies, (uint64_t) it, (uint64_t) next);
+    }
+
+    vector_foreach(*body, i) {
+        struct ir_node *it = vector_at(*body, i);
+
+        if (it->type == IR_ALLOCA)
+            continue;
+
+        struct ir_node *copy = copy_of(it);
+
+        copy_retarget(copy);
+        ir_insert_before(pos, copy, &decl->body);
+        vector_push_back(made, copy);
+    }
+
+    struct ir_node *first = made.count > 0 ? vector_at(made, 0) : pos;
+
+    vector_free(made);
+
+    return first;
+}
+
+/* Repeat body `times - 1` times after original one, so each
+   copy goes to the next one instead of the latch. */
+static void body_repeat(struct ir_fn_decl *decl, struct counted *c, ir_vector_t *body, uint64_t times)
+{
+    struct ir_node *pos = c->latch;
+
+    for (uint64_t i = 1; i < times; ++i)
+        pos = body_copy(decl, body, c->latch, pos);
+
+    vector_foreach(*body, i)
+        retarget(vector_at(*body, i), c->latch, pos);
+}
+
+static void body_collect(struct counted *c, ir_vector_t *out)
+{
+    for (struct ir_node *it = c->first; it != c->latch; it = it->next)
+        vector_push_back(*out, it);
+}
+
+static void stmt_remove(struct ir_fn_decl *decl, struct ir_node *ir)
+{
+    if (decl->body == ir)
+        decl->body = ir->next;
+
+    if (ir->prev)
+        ir->prev->next = ir->next;
+    if (ir->next)
+        ir->next->prev = ir->prev;
+
+    ir_node_cleanup(ir);
+}
+
+/*   header: t = i op bound          header: body x n
+             if t != 0 goto body             jmp exit
+             jmp exit
+     body:   ...
+             jmp header                                  */
+static void full_unroll(struct ir_fn_decl *decl, struct counted *c, uint64_t trips)
+{
+    ir_vector_t     body = {0};
+    struct ir_node *exit = ((struct ir_jump *) c->exit->ir)->target;
+
+    body_collect(c, &body);
+    body_repeat(decl, c, &body, trips);
+    vector_free(body);
+
+    ((struct ir_jump *) c->latch->ir)->target = exit;
+
+    struct ir_node *header[] = { c->test, c->cond, c->exit };
+
+    for (uint64_t i = 0; i < 3; ++i) {
+        jumps_retarget(decl, header[i], c->first);
+        stmt_remove(decl, header[i]);
+    }
+
+    if (c->latch->next == exit) {
+        jumps_retarget(decl, c->latch, exit);
+        stmt_remove(decl, c->latch);
+    }
+}
+
+/* New variable is declared at function entry. */
+static struct ir_node *sym_new(struct ir_fn_decl *decl, struct ir_sym *like)
+{
+    uint64_t        idx = next_sym_idx++;
+    struct ir_node *n   = ir_alloca_init(D_T_INT, /*ptr_depth=*/0, idx);
+
+    memcpy(&n->meta, &decl->body->meta, sizeof (struct meta));
+    n->meta.block_depth = 0;
+    ir_insert_before(decl->body, n, &decl->body);
+
+    struct ir_node *sym = ir_sym_init(idx);
+    ((struct ir_sym *) sym->ir)->type_info = like->type_info;
+
+    return sym;
+}
+
+/* Bound for the unrolled loop. Immediate value is computed
+   at once, variable bound is computed before the loop. */
+static struct ir_node *limit_make(
+    struct ir_fn_decl *decl,
+    struct ir_loop    *loop,
+    struct counted    *c,
+    int64_t            delta
+) {
+    int64_t bound = 0;
+
+    if (int_imm(c->bound, &bound))
+        return in_range(bound - delta) ? ir_imm_int_init(bound - delta) : NULL;
+
+    struct ir_node *entry = ir_loop_entry(decl, loop);
+
+    if (!entry || !in_range(delta))
+        return NULL;
+
+    struct ir_sym  *like  = c->bound->ir;
+    struct ir_node *limit = sym_new(decl, like);
+    struct ir_node *store = ir_store_init(
+        ir_node_copy(limit),
+        ir_bin_init(TOK_MINUS, ir_node_copy(c->bound), ir_imm_int_init(delta))
+    );
+    ir_vector_t     stmts = {0};
+
+    store->meta = c->test->meta;
+    vector_push_back(stmts, store);
+    ir_loop_entry_insert(decl, loop, entry, &stmts);
+    vector_free(stmts);
+
+    return limit;
+}
+
+/* Insert copy of loop with the same test after the latch.
+   Result is its header. */
+static struct ir_node *remainder_make(struct ir_fn_decl *decl, struct counted *c, ir_vector_t *body)
+{
+    struct ir_node *pos   = c->latch->next;
+    struct ir_node *latch = ir_jump_init(0);
+
+    latch->meta = c->latch->meta;
+    ir_insert_before(pos, latch, &decl->body);
+
+    struct ir_node *first = body_copy(decl, body, c->latch, latch);
+    struct ir_node *test  = ir_node_copy(c->test);
+    struct ir_node *cond  = ir_node_copy(c->cond);
+    struct ir_node *exit  = ir_node_copy(c->exit);
+
+    ir_insert_before(first, test, &decl->body);
+    ir_insert_before(first, cond, &decl->body);
+    ir_insert_before(first, exit, &decl->body);
+
+    ((struct ir_cond *) cond->ir)->target  = first;
+    ((struct ir_jump *) latch->ir)->target = test;
+
+    return test;
+}
+
+/*   header: t = i op bound          header:    t = i op limit
+             if t != 0 goto body                if t != 0 goto body
+             jmp exit                           jmp remainder
+     body:   ...                     body:      body x factor
+             jmp header                         jmp header
+                                     remainder: original loop   */
+static struct ir_node *partial_unroll(
+    struct ir_fn_decl *decl,
+    struct ir_loop    *loop,
+    struct counted    *c,
+    uint64_t           factor
+) {
+    bool up   = c->op == TOK_LT || c->op == TOK_LE;
+    bool down = c->op == TOK_GT || c->op == TOK_GE;
+
+    if (!(up && c->step > 0) && !(down && c->step < 0))
+        return NULL;
+
+    struct ir_node *limit = limit_make(decl, loop, c, (int64_t) (factor - 1) * c->step);
+
+    if (!limit)
+        return NULL;
+
+    ir_vector_t body = {0};
+
+    body_collect(c, &body);
+
+    struct ir_node *rest = remainder_make(decl, c, &body);
+
+    body_repeat(decl, c, &body, factor);
+    vector_free(body);
+
+    ((struct ir_jump *) c->exit->ir)->target = rest;
+
+    struct ir_bin *bin = ((struct ir_store *) c->test->ir)->body->ir;
+
+    if (bin->lhs == c->bound)
+        bin->lhs = limit;
+    else
+        bin->rhs = limit;
+
+    ir_node_cleanup(c->bound);
+
+    return rest;
+}
+
+/* Innermost loop, not processed yet. */
+static struct ir_loop *loop_next(ir_loop_vector_t *loops)
+{
+    vector_foreach(*loops, i) {
+        struct ir_loop *loop  = vector_at(*loops, i);
+        struct ir_loop *inner = loop_next(&loop->children);
+
+        if (inner)
+            return inner;
+
+        if (!hashmap_has(&processed, (uint64_t) loop->header))
+            return loop;
+    }
+
+    return NULL;
+}
+
+static bool unroll(struct ir_fn_decl *decl, struct ir_loop *loop, uint64_t factor)
+{
+    struct counted c     = {0};
+    uint64_t       size  = syms_collect(decl);
+    int64_t        init  = 0;
+    int64_t        trips = 0;
+
+    if (!counted_match(decl, loop, &c))
+        return 0;
+
+    bool known = init_find(decl, loop, c.sym_idx, &init) &&
+                 trip_count(&c, init, &trips);
+
+    if (known &&
+        trips > 0 &&
+        trips <= UNROLL_FULL_TRIPS &&
+        trips * c.size <= UNROLL_FULL_SIZE &&
+        size + (trips - 1) * c.size <= UNROLL_BUDGET) {
+        full_unroll(decl, &c, trips);
+        return 1;
+    }
+
+    /* Loop is shorter than unrolled body. */
+    if (known && (uint64_t) trips < factor)
+        return 0;
+
+    if (factor < 2 || c.size > UNROLL_BODY_SIZE ||
+        size + factor * c.size + 6 > UNROLL_BUDGET)
+        return 0;
+
+    struct ir_node *rest = partial_unroll(decl, loop, &c, factor);
+
+    if (!rest)
+        return 0;
+
+    hashmap_put(&processed, (uint64_t) rest, 1);
+    return 1;
+}
+
+static void ir_opt_unroll_fn_decl(struct ir_fn_decl *decl, uint64_t factor)
+{
+    if (!decl->body)
+        return;
+
+    hashmap_reset(&processed, 64);
+
+    while (1) {
+        ir_dominator_tree(decl);
+        ir_loops_build(decl);
+
+        struct ir_loop *loop = loop_next(&decl->loops);
+
+        if (!loop)
+            break;
+
+        hashmap_put(&processed, (uint64_t) loop->header, 1);
+
+        if (unroll(decl, loop, factor)) {
+            ir_renumber(decl->body);
+            ir_cfg_build(decl);
+        }
+    }
+
+    ir_loops_cleanup(decl);
+
+    hashmap_destroy(&addr_taken);
+    hashmap_destroy(&ints);
+    hashmap_destroy(&copies);
+    hashmap_destroy(&processed);
+}
+
+void ir_opt_unroll(struct ir_unit *ir, uint64_t factor)
+{
+    struct ir_node *it = ir->fn_decls;
+
+    while (it) {
+        ir_opt_unroll_fn_decl(it->ir, factor);
+        it = it->next;
+    }
+}
@@ -0,0 +1,59 @@
+/* arena.c - Region-based memory allocator.
+ * Copyright (C) 2024 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#include "util/arena.h"
+#include "util/alloc.h"
+
+#define ARENA_CHUNK_SIZE 4096
+
+struct arena_chunk {
+    struct arena_chunk *next;
+    size_t              size;
+    size_t              used;
+    char                data[];
+};
+
+static struct arena_chunk *arena_chunk_new(size_t size)
+{
+    if (size < ARENA_CHUNK_SIZE)
+        size = ARENA_CHUNK_SIZE;
+
+    struct arena_chunk *chunk = weak_calloc(1, sizeof (struct arena_chunk) + size);
+    chunk->size = size;
+
+    return chunk;
+}
+
+void *arena_alloc(struct arena *arena, size_t size)
+{
+    size = (size + 7) & ~(size_t) 7;
+
+    struct arena_chunk *chunk = arena->head;
+
+    if (!chunk || chunk->size - chunk->used < size) {
+        chunk = arena_chunk_new(size);
+        chunk->next = arena->head;
+        arena->head = chunk;
+    }
+
+    void *addr = chunk->data + chunk->used;
+    chunk->used += size;
+
+    return addr;
+}
+
+void arena_destroy(struct arena *arena)
+{
+    struct arena_chunk *chunk = arena->head;
+
+    while (chunk) {
+        struct arena_chunk *next = chunk->next;
+        weak_free(chunk);
+        chunk = next;
+    }
+
+    arena->head = NULL;
+}
@@ -0,0 +1,28 @@
+/* arena.h - Region-based memory allocator.
+ * Copyright (C) 2024 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#ifndef WEAK_COMPILER_UTIL_ARENA_H
+#define WEAK_COMPILER_UTIL_ARENA_H
+
+#include "util/compiler.h"
+#include <stddef.h>
+
+struct arena_chunk;
+
+/** Arena gives memory for many small objects with the same
+    lifetime. Objects are not freed one by one, but all at
+    once with arena_destroy(). */
+struct arena {
+    struct arena_chunk *head;
+};
+
+/** Allocate zeroed `size` bytes, aligned to 8 bytes. */
+wur void *arena_alloc(struct arena *arena, size_t size);
+
+/** Free all memory allocated from `arena`. */
+void arena_destroy(struct arena *arena);
+
+#endif // WEAK_COMPILER_UTIL_ARENA_H
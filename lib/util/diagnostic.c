@@ -62,6 +62,10 @@ static void flush(char *buf, bool is_error)
         ? diag_error_memstream
         : diag_warn_memstream;
 
+    /* Compiler driver has no memory streams. */
+    if (out_stream == NULL)
+        out_stream = stderr;
+
     fputs(buf, out_stream);
     fflush(out_stream);
 }
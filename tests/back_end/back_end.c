@@ -5,10 +5,13 @@
  */
 #include "back_end/elf.h"
 #include "back_end/back_end.h"
-#include "back_end/risc_v.h"
 #include "util/io.h"
 #include "utils/test_utils.h"
+#if defined CONFIG_USE_BACKEND_X86_64
+#include <asm/unistd_64.h>
+#else
 #include <asm-generic/unistd.h>
+#endif
 
 void *diag_error_memstream = NULL;
 void *diag_warn_memstream = NULL;
@@ -21,9 +24,39 @@ void run(const char *path)
     system_run("%s -D %s", __target_objdump, path);
     system_run("chmod +x %s", path);
 
-    int code = system_run("%s %s", __target_exec, path);
+    int code = system_run("%s%s", __target_exec, path);
 
-    printf("*** RISC-V file exited with code %d\n\n", WEXITSTATUS(code));
+    printf("*** ELF file exited with code %d\n\n", WEXITSTATUS(code));
+}
+
+/* Text and symbol table, which are much larger than
+   first page of file. */
+void large(const char *path)
+{
+    struct codegen_output output = {0};
+    int                   reg    = back_end_arg_reg(0);
+    char                  name[32];
+
+    back_end_init(&output);
+
+    back_end_native_li(reg, 0);
+
+    for (int i = 0; i < 40042; ++i) {
+        snprintf(name, sizeof (name), "fn_%d", i);
+        back_end_emit_sym(name, back_end_seek());
+        back_end_native_addi(reg, reg, 1);
+    }
+
+    back_end_native_syscall_0(__NR_exit);
+    back_end_emit(&output, path);
+    vector_free(output.instrs);
+
+    system_run("%s -h %s", __target_readelf, path);
+
+    int code = system_run("%s%s", __target_exec, path);
+
+    printf("*** ELF file exited with code %d\n\n", WEXITSTATUS(code));
+    ASSERT_EQ(WEXITSTATUS(code), 40042 & 0xFF);
 }
 
 int main()
@@ -46,5 +79,8 @@ int main()
 
     run(elf_path);
 
+    snprintf(elf_path, sizeof (elf_path) - 1, "%s/__elf_large.o", current_output_dir);
+    large(elf_path);
+
     return 0;
 }
\ No newline at end of file
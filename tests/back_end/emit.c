@@ -39,7 +39,7 @@ void __gen_test(const char *path, unused const char *filename, FILE *out_stream)
     struct ir_unit ir = gen_ir(path);
     ir_opt_reorder(&ir);
     ir_dump_unit(stdout, &ir);
-    back_end_gen(&ir);
+    back_end_gen(&ir, /*fast_regalloc=*/0);
     ir_unit_cleanup(&ir);
 
     back_end_emit(&output, elf_path);
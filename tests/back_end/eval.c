@@ -14,21 +14,8 @@ void *diag_warn_memstream = NULL;
 
 void __eval_test(const char *path, unused const char *filename, FILE *out_stream)
 {
-    struct ir_unit  ir = gen_ir(path);
-    struct ir_node *it = ir.fn_decls;
-    ir_type_pass(&ir);
-
-    ir_opt_reorder(&ir);
-    ir_opt_arith(&ir);
-    while (it) {
-        struct ir_fn_decl *decl = it->ir;
-        /* Reordering before building CFG links. */
-        ir_cfg_build(decl);
-
-        /* Wrong
-            ir_opt_unreachable_code(decl); */
-        it = it->next;
-    }
+    struct ir_unit ir = gen_ir(path);
+    ir_opt_pipeline(&ir);
 
     ir_dump_unit(stdout, &ir);
 
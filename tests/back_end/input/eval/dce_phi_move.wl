@@ -0,0 +1,19 @@
+//56
+int main() {
+    int acc = 1;
+    int v1 = (((16 * acc) + (acc * acc)) | ((acc ^ 47) % 12)) % 1000;
+    int v2 = (1 - ((acc | 11) / 13)) % 1000;
+    for (int i5 = 0; i5 < 4; ++i5) {
+        if (((v1 * acc) + (v1 / 11)) >= ((i5 + v1) | (i5 - acc))) {
+            if (((38 * 9) + (acc % 29)) >= ((v1 << 2) ^ 21)) {
+                v1 = (v1 + (((i5 - i5) * i5) * ((v1 % 19) | (v2 & acc)))) % 1000;
+            }
+            v2 = (v1 << 1) % 1000;
+        }
+        v2 = (((acc * v1) - (acc ^ v1)) * ((v1 / 11) & (v1 % 29))) % 1000;
+    }
+    int v7 = acc % 1000;
+    int v8 = (((v2 ^ v2) | (11 ^ v2)) ^ v7) % 1000;
+    int v9 = (((17 % 30) % 25) | acc) % 1000;
+    return (acc + v1 + v2 + v7 + v8 + v9) % 1000;
+}
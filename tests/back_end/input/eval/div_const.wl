@@ -0,0 +1,13 @@
+//-4707
+int main() {
+    int s = 0;
+    int i = -1000;
+    while (i < 1000) {
+        int q = (i / 3) + (i % 3) + (i / -7) + (i % 7);
+        int p = (i / 8) + (i % -8) + (i / 1000) + (i % 641);
+        int m = (i * 3) + (i * -7) + (i * 9);
+        s = s + q + p + m;
+        i = i + 13;
+    }
+    return s;
+}
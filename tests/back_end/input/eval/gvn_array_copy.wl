@@ -0,0 +1,14 @@
+//3
+int main() {
+    int a[2];
+    // Address of a[0] is folded to copy of array,
+    // which must not be propagated into dereference.
+    a[0] = -3;
+    a[1] = 1;
+    int acc = 1;
+    int v = acc % 1000;
+    if ((v - 26) <= (v << 2)) {
+        v = v + a[(((v << 0) % 2) + 2) % 2];
+    }
+    return (acc + v) % 1000;
+}
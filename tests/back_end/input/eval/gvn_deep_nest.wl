@@ -0,0 +1,91 @@
+//423
+int main() {
+    int acc = 1;
+    acc = (acc + (acc * 5 + acc) % 6) % 1000;
+    acc = (acc + (acc * 8 + acc) % 9) % 1000;
+    acc = (acc + (acc * 11 + acc) % 12) % 1000;
+    for (int i4 = 0; i4 < acc % 3 + 1; ++i4) {
+        if ((acc + i4) % 13 < 14) {
+            acc = (acc + (acc * 16 + i4) % 17) % 1000;
+            acc = (acc + (acc * 19 + acc) % 20) % 1000;
+            acc = (acc + (acc * 22 + i4) % 23) % 1000;
+            for (int i3 = 0; i3 < acc % 3 + 1; ++i3) {
+                if ((acc + i3) % 24 < 25) {
+                    acc = (acc + (acc * 27 + i3) % 28) % 1000;
+                    acc = (acc + (acc * 30 + i3) % 31) % 1000;
+                    acc = (acc + (acc * 33 + i3) % 34) % 1000;
+                    for (int i2 = 0; i2 < acc % 3 + 1; ++i2) {
+                        if ((acc + i2) % 35 < 36) {
+                            acc = (acc + (acc * 38 + i4) % 39) % 1000;
+                            acc = (acc + (acc * 41 + acc) % 42) % 1000;
+                            acc = (acc + (acc * 44 + i2) % 45) % 1000;
+                            for (int i1 = 0; i1 < acc % 3 + 1; ++i1) {
+                                if ((acc + i1) % 46 < 47) {
+                                    acc = (acc + (acc * 49 + i2) % 50) % 1000;
+                                    acc = (acc + (acc * 52 + i4) % 53) % 1000;
+                                    acc = (acc + (acc * 55 + i1) % 56) % 1000;
+                                } else {
+                                    acc = (acc + (acc * 57 + i1) % 58) % 1000;
+                                }
+                                acc = (acc + (acc * 59 + i1) % 60) % 1000;
+                            }
+                        } else {
+                            acc = (acc + (acc * 61 + i2) % 62) % 1000;
+                        }
+                        acc = (acc + (acc * 63 + i2) % 64) % 1000;
+                    }
+                } else {
+                    acc = (acc + (acc * 65 + i3) % 66) % 1000;
+                }
+                acc = (acc + (acc * 67 + i3) % 68) % 1000;
+            }
+        } else {
+            acc = (acc + (acc * 69 + i4) % 70) % 1000;
+        }
+        acc = (acc + (acc * 71 + i4) % 72) % 1000;
+    }
+    acc = (acc + (acc * 74 + acc) % 75) % 1000;
+    acc = (acc + (acc * 77 + acc) % 78) % 1000;
+    acc = (acc + (acc * 80 + acc) % 81) % 1000;
+    for (int i4 = 0; i4 < acc % 3 + 1; ++i4) {
+        if ((acc + i4) % 82 < 83) {
+            acc = (acc + (acc * 85 + acc) % 86) % 1000;
+            acc = (acc + (acc * 88 + i4) % 89) % 1000;
+            acc = (acc + (acc * 91 + acc) % 92) % 1000;
+            for (int i3 = 0; i3 < acc % 3 + 1; ++i3) {
+                if ((acc + i3) % 93 < 94) {
+                    acc = (acc + (acc * 96 + i3) % 97) % 1000;
+                    acc = (acc + (acc * 99 + i3) % 100) % 1000;
+                    acc = (acc + (acc * 102 + i3) % 103) % 1000;
+                    for (int i2 = 0; i2 < acc % 3 + 1; ++i2) {
+                        if ((acc + i2) % 104 < 105) {
+                            acc = (acc + (acc * 107 + i3) % 108) % 1000;
+                            acc = (acc + (acc * 110 + i4) % 111) % 1000;
+                            acc = (acc + (acc * 113 + acc) % 114) % 1000;
+                            for (int i1 = 0; i1 < acc % 3 + 1; ++i1) {
+                                if ((acc + i1) % 115 < 116) {
+                                    acc = (acc + (acc * 118 + i3) % 119) % 1000;
+                                    acc = (acc + (acc * 121 + acc) % 122) % 1000;
+                                    acc = (acc + (acc * 124 + i2) % 125) % 1000;
+                                } else {
+                                    acc = (acc + (acc * 126 + i1) % 127) % 1000;
+                                }
+                                acc = (acc + (acc * 128 + i1) % 129) % 1000;
+                            }
+                        } else {
+                            acc = (acc + (acc * 130 + i2) % 131) % 1000;
+                        }
+                        acc = (acc + (acc * 132 + i2) % 133) % 1000;
+                    }
+                } else {
+                    acc = (acc + (acc * 134 + i3) % 135) % 1000;
+                }
+                acc = (acc + (acc * 136 + i3) % 137) % 1000;
+            }
+        } else {
+            acc = (acc + (acc * 138 + i4) % 139) % 1000;
+        }
+        acc = (acc + (acc * 140 + i4) % 141) % 1000;
+    }
+    return acc;
+}
@@ -0,0 +1,25 @@
+//9282
+int mix(int n) {
+    int s = 0;
+    for (int i = 0; i < n; ++i) {
+        s = (s * 31 + i) % 1000;
+    }
+    return s;
+}
+
+int fib(int n) {
+    if (n < 2) {
+        return n;
+    }
+    int a = fib(n - 1);
+    int b = fib(n - 2);
+    return a + b;
+}
+
+int main() {
+    int r = 0;
+    for (int k = 0; k < 100; ++k) {
+        r = (r + mix(k) + fib(k % 12)) % 10007;
+    }
+    return r;
+}
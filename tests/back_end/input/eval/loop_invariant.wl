@@ -0,0 +1,17 @@
+//5020
+int f(int n, int a, int b) {
+    int s = 0;
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            if (s > 5000) {
+                break;
+            }
+            s = s + (a + b) * 5 + i * 3 + a % 7;
+        }
+    }
+    return s;
+}
+
+int main() {
+    return f(10, 3, 4) + f(0, 1, 2);
+}
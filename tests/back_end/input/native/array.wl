@@ -0,0 +1,13 @@
+//30
+int main() {
+    int mem[5];
+    for (int i = 0; i < 5; ++i) {
+        mem[i] = i * i;
+    }
+    int sum = 0;
+    int *ptr = &sum;
+    for (int i = 0; i < 5; ++i) {
+        *ptr = *ptr + mem[i];
+    }
+    return sum;
+}
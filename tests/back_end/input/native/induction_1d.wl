@@ -0,0 +1,25 @@
+//168
+int main() {
+    int a[20];
+    int b[20];
+    for (int i = 0; i < 20; ++i) {
+        a[i] = (i * 3) + 1;
+    }
+    for (int i = 0; i < 9; ++i) {
+        b[(2 * i) + 1] = a[i] + a[i + 2];
+        b[2 * i] = a[19 - i];
+    }
+    for (int i = 19; i >= 18; --i) {
+        b[i] = i << 2;
+    }
+    int n = 18;
+    int sum = 0;
+    int i = 0;
+    while (i < n) {
+        sum = sum + (b[i] * (i + 1));
+        ++i;
+    }
+    sum = sum + (b[18] * b[19]);
+    /* Counter is used after the loop. */
+    return (sum + i) % 256;
+}
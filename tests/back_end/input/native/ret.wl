@@ -0,0 +1,5 @@
+//42
+int main()
+{
+    return 42;
+}
@@ -0,0 +1,127 @@
+/* link.c - Test cases for relocatable objects and static linker.
+ * Copyright (C) 2024 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#include "back_end/back_end.h"
+#include "back_end/link.h"
+#include "util/io.h"
+#include "utils/test_utils.h"
+#include <sys/wait.h>
+#if defined CONFIG_USE_BACKEND_X86_64
+#include <asm/unistd_64.h>
+#else
+#include <asm-generic/unistd.h>
+#endif
+
+void *diag_error_memstream = NULL;
+void *diag_warn_memstream = NULL;
+
+char current_output_dir[128];
+
+struct codegen_output output = {0};
+
+void object_path(char *path, const char *name)
+{
+    snprintf(path, 255, "%s/%s", current_output_dir, name);
+}
+
+/* Label of function, which may be defined in
+   other object. */
+uint64_t fn_label(const char *name)
+{
+    uint64_t label = back_end_label();
+    back_end_label_sym(label, name);
+    return label;
+}
+
+/* _start calls main(), main() exits with value,
+   returned by seven(). */
+void emit_main(const char *path)
+{
+    back_end_init(&output);
+
+    uint64_t main  = fn_label("main");
+    uint64_t seven = fn_label("seven");
+
+    back_end_emit_sym("_start", back_end_seek());
+    back_end_fixup(main);
+    back_end_native_call(0);
+
+    back_end_label_bind(main);
+    back_end_emit_sym("main", back_end_seek());
+    back_end_fixup(seven);
+    back_end_native_call(0);
+    back_end_native_addi(back_end_arg_reg(0), back_end_return_reg(), 0);
+    back_end_native_syscall_0(__NR_exit);
+
+    back_end_emit_object(&output, path);
+    vector_free(output.instrs);
+}
+
+/* seven() returns five() + 2. */
+void emit_seven(const char *path)
+{
+    back_end_init(&output);
+
+    uint64_t five = fn_label("five");
+
+    back_end_emit_sym("seven", back_end_seek());
+    back_end_native_prologue(0);
+    back_end_fixup(five);
+    back_end_native_call(0);
+    back_end_native_addi(back_end_return_reg(), back_end_return_reg(), 2);
+    back_end_native_epilogue(0);
+    back_end_native_ret();
+
+    back_end_emit_object(&output, path);
+    vector_free(output.instrs);
+}
+
+void emit_five(const char *path)
+{
+    back_end_init(&output);
+
+    back_end_emit_sym("five", back_end_seek());
+    back_end_native_li(back_end_return_reg(), 5);
+    back_end_native_ret();
+
+    back_end_emit_object(&output, path);
+    vector_free(output.instrs);
+}
+
+int main()
+{
+    cfg_dir("link", current_output_dir);
+
+    char main_path [256] = {0};
+    char seven_path[256] = {0};
+    char five_path [256] = {0};
+    char exec_path [256] = {0};
+
+    object_path(main_path,  "main.o");
+    object_path(seven_path, "seven.o");
+    object_path(five_path,  "five.o");
+    object_path(exec_path,  "link.out");
+
+    emit_main(main_path);
+    emit_seven(seven_path);
+    emit_five(five_path);
+
+    system_run("%s -r -s %s", __target_readelf, seven_path);
+
+    /* Object with entry point is not the first one. */
+    const char *objects[] = {five_path, main_path, seven_path};
+
+    back_end_link(objects, __weak_array_size(objects), exec_path);
+
+    system_run("%s -d %s", __target_objdump, exec_path);
+
+    int code = system_run("%s%s", __target_exec, exec_path);
+
+    printf("*** ELF file exited with code %d\n", WEXITSTATUS(code));
+    ASSERT_EQ(WEXITSTATUS(code), 7);
+
+    return 0;
+}
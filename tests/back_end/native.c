@@ -0,0 +1,158 @@
+/* native.c - Test cases for native code execution.
+ * Copyright (C) 2024 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#include "back_end/back_end.h"
+#include "back_end/emit.h"
+#include "middle_end/ir/ir.h"
+#include "middle_end/ir/ir_dump.h"
+#include "middle_end/ir/type.h"
+#include "middle_end/opt/opt.h"
+#include "util/io.h"
+#include "utils/test_utils.h"
+#include <sys/wait.h>
+
+void *diag_error_memstream = NULL;
+void *diag_warn_memstream = NULL;
+
+char current_output_dir[128];
+
+bool fast_regalloc;
+/* Native inputs are also run without optimizations, so
+   their expected values are checked by unoptimized code. */
+bool optimize;
+
+static bool fn_uses_float(struct ir_fn_decl *decl)
+{
+    if (decl->ret_type == D_T_FLOAT)
+        return 1;
+
+    for (struct ir_node *it = decl->args; it; it = it->next)
+        if (it->type == IR_ALLOCA && ((struct ir_alloca *) it->ir)->dt == D_T_FLOAT)
+            return 1;
+
+    for (struct ir_node *it = decl->body; it; it = it->next)
+        if (it->type == IR_ALLOCA && ((struct ir_alloca *) it->ir)->dt == D_T_FLOAT)
+            return 1;
+
+    return 0;
+}
+
+static bool unit_uses_float(struct ir_unit *unit)
+{
+    for (struct ir_node *it = unit->fn_decls; it; it = it->next)
+        if (fn_uses_float(it->ir))
+            return 1;
+
+    return 0;
+}
+
+void __native_test(const char *path, const char *filename, FILE *out_stream)
+{
+    char elf_path[256] = {0};
+    snprintf(elf_path, sizeof (elf_path) - 1, "%s/%s.out", current_output_dir, filename);
+
+    struct ir_unit ir = gen_ir(path);
+
+    /* Floating point is not supported by native back end. */
+    if (unit_uses_float(&ir)) {
+        fprintf(out_stream, "float\n");
+        ir_unit_cleanup(&ir);
+        return;
+    }
+
+    if (optimize) {
+        ir_opt_pipeline(&ir);
+    } else {
+        ir_type_pass(&ir);
+        for (struct ir_node *it = ir.fn_decls; it; it = it->next)
+            ir_cfg_build(it->ir);
+    }
+
+    ir_dump_unit(stdout, &ir);
+
+    struct codegen_output output = {0};
+    back_end_init(&output);
+    back_end_gen(&ir, fast_regalloc);
+    back_end_emit(&output, elf_path);
+    ir_unit_cleanup(&ir);
+
+    int code = system_run("%s%s", __target_exec, elf_path);
+    fprintf(out_stream, "%d\n", WEXITSTATUS(code));
+
+    vector_free(output.instrs);
+}
+
+int native_test(const char *path, const char *filename)
+{
+    return compare_with_comment(path, filename, __native_test);
+}
+
+/* Interpreter tests are run natively too. They expect whole
+   return value, but exit code of process is its low byte. */
+int native_eval_test(const char *path, const char *filename)
+{
+    int     rc               = 0;
+    char   *expected         = NULL;
+    char   *generated        = NULL;
+    size_t  _                = 0;
+    FILE   *expected_stream  = open_memstream(&expected, &_);
+    FILE   *generated_stream = open_memstream(&generated, &_);
+
+    if (!setjmp(weak_fatal_error_buf)) {
+        __native_test(path, filename, generated_stream);
+
+        get_init_comment(yyin, expected_stream, NULL);
+
+        fflush(generated_stream);
+
+        if (!strcmp(generated, "float\n")) {
+            printf("skipped, floating point... ");
+            goto exit;
+        }
+
+        int32_t got  = atoi(generated);
+        int32_t want = atoi(expected) & 0xFF;
+
+        if (got != want) {
+            printf("\ngot: %d\nexpected: %d (low byte of %s)\n", got, want, expected);
+            rc = -1;
+        }
+    } else {
+        /* Error, will be printed in main. */
+        rc = -1;
+    }
+
+exit:
+    fclose(expected_stream);
+    fclose(generated_stream);
+    free(expected);
+    free(generated);
+
+    return rc;
+}
+
+int main()
+{
+    cfg_dir("native", current_output_dir);
+
+    optimize      = 0;
+    fast_regalloc = 0;
+    if (do_on_each_file("native", native_test) < 0)
+        return -1;
+
+    optimize      = 1;
+    fast_regalloc = 0;
+    if (do_on_each_file("native", native_test) < 0 ||
+        do_on_each_file("eval", native_eval_test) < 0)
+        return -1;
+
+    fast_regalloc = 1;
+    if (do_on_each_file("native", native_test) < 0 ||
+        do_on_each_file("eval", native_eval_test) < 0)
+        return -1;
+
+    return 0;
+}
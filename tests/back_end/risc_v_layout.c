@@ -0,0 +1,181 @@
+/* risc_v_layout.c - Tests for RISC-V compression and branch relaxation.
+ * Copyright (C) 2024 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#include "back_end/back_end.h"
+#include "back_end/risc_v.h"
+#include "utils/test_utils.h"
+#include <stdio.h>
+
+void *diag_error_memstream = NULL;
+void *diag_warn_memstream = NULL;
+
+struct codegen_output output = {0};
+
+void dump_bytes(const void *bytes, uint64_t len)
+{
+    const uint8_t *mem = bytes;
+
+    for (uint64_t i = 0; i < len; ++i)
+        printf("%02x", mem[i]);
+}
+
+/* Expected bytes are checked with
+   llvm-mc -triple=riscv64 -mattr=+c,+m -show-encoding */
+int match_at(uint64_t off, uint64_t len, const char *bytes)
+{
+    instr_vector_t *text = &output.instrs;
+
+    if (text->count < off + len || memcmp(text->data + off, bytes, len)) {
+        printf("RISC-V layout failed at %lu\n ", off);
+        dump_bytes(text->data + off, text->count >= off + len ? len : 0);
+        printf(" got,\n ");
+        dump_bytes(bytes, len);
+        printf(" expected\n");
+        ASSERT_TRUE(0);
+    }
+
+    return 0;
+}
+
+int match(uint64_t len, const char *bytes)
+{
+    back_end_fixups_resolve();
+    ASSERT_EQ(output.instrs.count, len);
+    match_at(0, len, bytes);
+    vector_clear(output.instrs);
+    return 0;
+}
+
+void compress()
+{
+#ifdef CONFIG_USE_RVC
+    back_end_native_addi(risc_v_reg_a0, risc_v_reg_a0, 1);
+    match(2, "\x05\x05");                  /* c.addi     a0, 1       */
+
+    back_end_native_li(risc_v_reg_a1, -3);
+    match(2, "\xf5\x55");                  /* c.li       a1, -3      */
+
+    back_end_native_addi(risc_v_reg_a2, risc_v_reg_a3, 0);
+    match(2, "\x36\x86");                  /* c.mv       a2, a3      */
+
+    back_end_native_addi(risc_v_reg_sp, risc_v_reg_sp, -32);
+    match(2, "\x3d\x71");                  /* c.addi16sp sp, -32     */
+
+    back_end_native_addi(risc_v_reg_s0, risc_v_reg_sp, 16);
+    match(2, "\x00\x08");                  /* c.addi4spn s0, sp, 16  */
+
+    back_end_native_add(risc_v_reg_a0, risc_v_reg_a1, risc_v_reg_a0);
+    match(2, "\x2e\x95");                  /* c.add      a0, a1      */
+
+    back_end_native_sub(risc_v_reg_a0, risc_v_reg_a0, risc_v_reg_a1);
+    match(2, "\x0d\x8d");                  /* c.sub      a0, a1      */
+
+    back_end_native_and(risc_v_reg_s1, risc_v_reg_s1, risc_v_reg_a5);
+    match(2, "\xfd\x8c");                  /* c.and      s1, a5      */
+
+    back_end_native_xor(risc_v_reg_a0, risc_v_reg_a0, risc_v_reg_a1);
+    match(2, "\x2d\x8d");                  /* c.xor      a0, a1      */
+
+    back_end_native_andi(risc_v_reg_a4, risc_v_reg_a4, 7);
+    match(2, "\x1d\x8b");                  /* c.andi     a4, 7       */
+
+    back_end_native_srai(risc_v_reg_a4, risc_v_reg_a4, 3);
+    match(2, "\x0d\x87");                  /* c.srai     a4, 3       */
+
+    back_end_native_slli(risc_v_reg_t0, risc_v_reg_t0, 4);
+    match(2, "\x92\x02");                  /* c.slli     t0, 4       */
+
+    back_end_native_addiw(risc_v_reg_a0, risc_v_reg_a0, 0);
+    match(2, "\x01\x25");                  /* c.addiw    a0, 0       */
+
+    back_end_native_lw(risc_v_reg_a0, risc_v_reg_a1, 8);
+    match(2, "\x88\x45");                  /* c.lw       a0, 8(a1)   */
+
+    back_end_native_ld(risc_v_reg_s1, risc_v_reg_a0, 24);
+    match(2, "\x04\x6d");                  /* c.ld       s1, 24(a0)  */
+
+    back_end_native_sw(risc_v_reg_a2, risc_v_reg_a3, 4);
+    match(2, "\xd0\xc2");                  /* c.sw       a2, 4(a3)   */
+
+    back_end_native_lw(risc_v_reg_a3, risc_v_reg_sp, 12);
+    match(2, "\xb2\x46");                  /* c.lwsp     a3, 12(sp)  */
+
+    back_end_native_ld(risc_v_reg_a0, risc_v_reg_sp, 16);
+    match(2, "\x42\x65");                  /* c.ldsp     a0, 16(sp)  */
+
+    back_end_native_sw(risc_v_reg_t1, risc_v_reg_sp, 20);
+    match(2, "\x1a\xca");                  /* c.swsp     t1, 20(sp)  */
+
+    back_end_native_sd(risc_v_reg_ra, risc_v_reg_sp, 8);
+    match(2, "\x06\xe4");                  /* c.sdsp     ra, 8(sp)   */
+
+    back_end_native_ret();
+    match(2, "\x82\x80");                  /* c.jr       ra          */
+
+    /* No short form. */
+    back_end_native_add(risc_v_reg_t0, risc_v_reg_t1, risc_v_reg_t2);
+    match(4, "\xb3\x02\x73\x00");          /* add        t0, t1, t2  */
+
+    back_end_native_lw(risc_v_reg_a0, risc_v_reg_a1, 2);
+    match(4, "\x03\xa5\x25\x00");          /* lw         a0, 2(a1)   */
+#endif /* CONFIG_USE_RVC */
+}
+
+/* Near jumps are compressed, far branch is relaxed to
+   inverted branch over jump. */
+void relax()
+{
+    uint64_t near = back_end_label();
+    uint64_t far  = back_end_label();
+
+    back_end_label_bind(near);
+    back_end_native_add(risc_v_reg_t0, risc_v_reg_t1, risc_v_reg_t2);
+    back_end_fixup(near);
+    back_end_native_beq(risc_v_reg_a0, risc_v_reg_zero, 0);
+    back_end_fixup(near);
+    back_end_native_jmp(0);
+    back_end_fixup(far);
+    back_end_native_call(0);
+    back_end_fixup(far);
+    back_end_native_bne(risc_v_reg_t0, risc_v_reg_t1, 0);
+
+    for (int i = 0; i < 1100; ++i)
+        back_end_native_add(risc_v_reg_t0, risc_v_reg_t1, risc_v_reg_t2);
+
+    back_end_label_bind(far);
+    back_end_native_ret();
+    back_end_fixups_resolve();
+
+#ifdef CONFIG_USE_RVC
+    ASSERT_EQ(output.instrs.count, 4422);
+    match_at(4,  2, "\x75\xdd");             /* c.beqz a0, -4        */
+    match_at(6,  2, "\xed\xbf");             /* c.j    -6            */
+    match_at(8,  4, "\xef\x10\xc0\x13");     /* jal    ra, 4412      */
+    match_at(12, 4, "\x63\x84\x62\x00");     /* beq    t0, t1, 8     */
+    match_at(16, 4, "\x6f\x10\x40\x13");     /* jal    zero, 4404    */
+    match_at(4420, 2, "\x82\x80");           /* c.jr   ra            */
+#else
+    ASSERT_EQ(output.instrs.count, 4428);
+    match_at(4,  4, "\xe3\x0e\x05\xfe");     /* beq    a0, zero, -4  */
+    match_at(8,  4, "\x6f\xf0\x9f\xff");     /* jal    zero, -8      */
+    match_at(12, 4, "\xef\x10\xc0\x13");     /* jal    ra, 4412      */
+    match_at(16, 4, "\x63\x84\x62\x00");     /* beq    t0, t1, 8     */
+    match_at(20, 4, "\x6f\x10\x40\x13");     /* jal    zero, 4404    */
+    match_at(4424, 4, "\x67\x80\x00\x00");   /* jalr   zero, 0(ra)   */
+#endif /* CONFIG_USE_RVC */
+
+    vector_clear(output.instrs);
+}
+
+int main()
+{
+    back_end_init(&output);
+
+    compress();
+    relax();
+
+    return 0;
+}
@@ -0,0 +1,125 @@
+/* sched.c - Tests for basic block list scheduler.
+ * Copyright (C) 2024 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#include "back_end/back_end.h"
+#include "back_end/sched.h"
+#include "utils/test_utils.h"
+#include <stdio.h>
+
+void *diag_error_memstream = NULL;
+void *diag_warn_memstream = NULL;
+
+struct codegen_output output = {0};
+
+/* Bytes, produced by scheduler. */
+uint8_t  scheduled[256];
+uint64_t scheduled_size;
+
+void take()
+{
+    instr_vector_t *text = &output.instrs;
+
+    scheduled_size = text->count;
+    memcpy(scheduled, text->data, text->count);
+    vector_clear(*text);
+}
+
+/* Compare scheduled code with code, emitted directly
+   in expected order. */
+int match()
+{
+    instr_vector_t *text = &output.instrs;
+
+    if (text->count != scheduled_size || memcmp(text->data, scheduled, scheduled_size)) {
+        printf("Scheduled order differs from expected\n");
+        ASSERT_TRUE(0);
+    }
+
+    vector_clear(*text);
+    return 0;
+}
+
+void stats_match(uint64_t instrs, uint64_t before, uint64_t after)
+{
+    struct sched_stats stats = {0};
+    sched_stats_get(&stats);
+
+    printf("instrs: %lu, cycles before: %lu, after: %lu\n",
+        stats.instrs, stats.cycles_before, stats.cycles_after);
+
+    ASSERT_EQ(stats.instrs, instrs);
+    ASSERT_EQ(stats.cycles_before, before);
+    ASSERT_EQ(stats.cycles_after, after);
+}
+
+int main()
+{
+    back_end_init(&output);
+
+    int sp = back_end_sp_reg();
+    int a  = back_end_tmp_reg(0);
+    int b  = back_end_tmp_reg(1);
+    int c  = back_end_saved_reg(0);
+    int d  = back_end_saved_reg(1);
+    int e  = back_end_saved_reg(2);
+
+    ASSERT_TRUE(sched_model_find("u74") != NULL);
+    ASSERT_TRUE(sched_model_find("unknown") == NULL);
+
+    /* Independent constants fill load delay. */
+    sched_model_set(sched_model_find("u74"));
+    sched_reset();
+    sched_put(SCHED_LD,  a, sp, 0);
+    sched_put(SCHED_ADD, b, a,  a);
+    sched_put(SCHED_LI,  c, 1,  0);
+    sched_put(SCHED_LI,  d, 2,  0);
+    sched_put(SCHED_ADD, e, c,  d);
+    sched_flush();
+    take();
+    stats_match(5, 6, 4);
+
+    back_end_native_ld(a, sp, 0);
+    back_end_native_li(c, 1);
+    back_end_native_li(d, 2);
+    back_end_native_add(e, c, d);
+    back_end_native_add(b, a, a);
+    match();
+
+    /* Load from stored slot waits for store, but not for
+       the preceding load. */
+    sched_reset();
+    sched_put(SCHED_SW,  c, sp, 8);
+    sched_put(SCHED_LW,  a, sp, 16);
+    sched_put(SCHED_ADD, d, a,  a);
+    sched_put(SCHED_LW,  b, sp, 8);
+    sched_put(SCHED_ADD, e, b,  b);
+    sched_flush();
+    take();
+    stats_match(5, 8, 6);
+
+    back_end_native_sw(c, sp, 8);
+    back_end_native_lw(a, sp, 16);
+    back_end_native_lw(b, sp, 8);
+    back_end_native_add(d, a, a);
+    back_end_native_add(e, b, b);
+    match();
+
+    /* Branch ends block and stays last. Dependent chain
+       is left as is. */
+    sched_reset();
+    sched_put(SCHED_LI,  a, 1, 0);
+    sched_put(SCHED_ADD, b, a, a);
+    sched_put(SCHED_BEQ, b, a, 0);
+    take();
+    stats_match(3, 3, 3);
+
+    back_end_native_li(a, 1);
+    back_end_native_add(b, a, a);
+    back_end_native_beq(b, a, 0);
+    match();
+
+    return 0;
+}
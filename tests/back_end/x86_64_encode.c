@@ -0,0 +1,197 @@
+/* x86_64_encode.c - Tests for x86-64 encoding.
+ * Copyright (C) 2024 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#include "back_end/back_end.h"
+#include "back_end/x86_64.h"
+#include "utils/test_utils.h"
+#include <stdio.h>
+
+void *diag_error_memstream = NULL;
+void *diag_warn_memstream = NULL;
+
+struct codegen_output output = {0};
+
+void dump_bytes(const void *bytes, uint64_t len)
+{
+    const uint8_t *mem = bytes;
+
+    for (uint64_t i = 0; i < len; ++i)
+        printf("%02x", mem[i]);
+}
+
+/* Expected bytes are checked with
+   objdump -D -b binary -m i386:x86-64 -M intel */
+int match(uint64_t len, const char *bytes)
+{
+    instr_vector_t *text = &output.instrs;
+
+    if (text->count != len || memcmp(text->data, bytes, len)) {
+        printf("x86-64 encoding failed\n ");
+        dump_bytes(text->data, text->count);
+        printf(" got,\n ");
+        dump_bytes(bytes, len);
+        printf(" expected\n");
+        ASSERT_TRUE(0);
+    }
+
+    vector_clear(*text);
+    return 0;
+}
+
+int main()
+{
+    back_end_init(&output);
+
+    back_end_native_add(x86_64_reg_rax, x86_64_reg_rcx, x86_64_reg_rdx);
+    match(6,
+        "\x48\x89\xc8"                 /* mov rax, rcx */
+        "\x48\x01\xd0"                 /* add rax, rdx */
+    );
+
+    back_end_native_add(x86_64_reg_rdx, x86_64_reg_rcx, x86_64_reg_rdx);
+    match(3, "\x48\x01\xca");          /* add rdx, rcx */
+
+    back_end_native_sub(x86_64_reg_r9, x86_64_reg_r8, x86_64_reg_r9);
+    match(9,
+        "\x4d\x89\xc3"                 /* mov r11, r8  */
+        "\x4d\x29\xcb"                 /* sub r11, r9  */
+        "\x4d\x89\xd9"                 /* mov r9, r11  */
+    );
+
+    back_end_native_addi(x86_64_reg_r12, x86_64_reg_rsp, -16);
+    match(8, "\x4c\x8d\xa4\x24\xf0\xff\xff\xff"); /* lea r12, [rsp-0x10] */
+
+    back_end_native_addiw(x86_64_reg_rax, x86_64_reg_r13, 1);
+    match(10,
+        "\x41\x8d\x85\x01\x00\x00\x00" /* lea eax, [r13+0x1] */
+        "\x48\x63\xc0"                 /* movsxd rax, eax    */
+    );
+
+    back_end_native_mul(x86_64_reg_r8, x86_64_reg_rax, x86_64_reg_r15);
+    match(7,
+        "\x49\x89\xc0"                 /* mov r8, rax   */
+        "\x4d\x0f\xaf\xc7"             /* imul r8, r15  */
+    );
+
+    back_end_native_div(x86_64_reg_r8, x86_64_reg_r9, x86_64_reg_rax);
+    match(18,
+        "\x52"                         /* push rdx      */
+        "\x50"                         /* push rax      */
+        "\x49\x89\xc3"                 /* mov r11, rax  */
+        "\x4c\x89\xc8"                 /* mov rax, r9   */
+        "\x48\x99"                     /* cqo           */
+        "\x49\xf7\xfb"                 /* idiv r11      */
+        "\x49\x89\xc0"                 /* mov r8, rax   */
+        "\x58"                         /* pop rax       */
+        "\x5a"                         /* pop rdx       */
+    );
+
+    back_end_native_sra(x86_64_reg_r8, x86_64_reg_r9, x86_64_reg_r10);
+    match(14,
+        "\x4d\x89\xcb"                 /* mov r11, r9   */
+        "\x51"                         /* push rcx      */
+        "\x4c\x89\xd1"                 /* mov rcx, r10  */
+        "\x49\xd3\xfb"                 /* sar r11, cl   */
+        "\x59"                         /* pop rcx       */
+        "\x4d\x89\xd8"                 /* mov r8, r11   */
+    );
+
+    back_end_native_andi(x86_64_reg_rax, x86_64_reg_rcx, 0xFF);
+    match(10,
+        "\x48\x89\xc8"                 /* mov rax, rcx   */
+        "\x48\x81\xe0\xff\x00\x00\x00" /* and rax, 0xff  */
+    );
+
+    back_end_native_slli(x86_64_reg_r8, x86_64_reg_r9, 3);
+    match(7,
+        "\x4d\x89\xc8"                 /* mov r8, r9     */
+        "\x49\xc1\xe0\x03"             /* shl r8, 0x3    */
+    );
+
+    back_end_native_slti(x86_64_reg_rax, x86_64_reg_r12, 10);
+    match(15,
+        "\x49\x81\xfc\x0a\x00\x00\x00" /* cmp r12, 0xa   */
+        "\x40\x0f\x9c\xc0"             /* setl al        */
+        "\x48\x0f\xb6\xc0"             /* movzx rax, al  */
+    );
+
+    back_end_native_li(x86_64_reg_r8, -1);
+    match(7, "\x49\xc7\xc0\xff\xff\xff\xff"); /* mov r8, -1 */
+
+    back_end_native_lb(x86_64_reg_rax, x86_64_reg_rbp, -8);
+    match(8, "\x48\x0f\xbe\x85\xf8\xff\xff\xff"); /* movsx rax, byte [rbp-0x8] */
+
+    back_end_native_lbu(x86_64_reg_rsi, x86_64_reg_r12, 4);
+    match(9, "\x49\x0f\xb6\xb4\x24\x04\x00\x00\x00"); /* movzx rsi, byte [r12+0x4] */
+
+    back_end_native_lw(x86_64_reg_r8, x86_64_reg_rbp, -8);
+    match(7, "\x4c\x63\x85\xf8\xff\xff\xff"); /* movsxd r8, dword [rbp-0x8] */
+
+    back_end_native_lwu(x86_64_reg_r8, x86_64_reg_rbp, -8);
+    match(7, "\x44\x8b\x85\xf8\xff\xff\xff"); /* mov r8d, dword [rbp-0x8] */
+
+    back_end_native_ld(x86_64_reg_rax, x86_64_reg_rsp, 16);
+    match(8, "\x48\x8b\x84\x24\x10\x00\x00\x00"); /* mov rax, qword [rsp+0x10] */
+
+    back_end_native_sb(x86_64_reg_rsi, x86_64_reg_rbp, -1);
+    match(7, "\x40\x88\xb5\xff\xff\xff\xff"); /* mov byte [rbp-0x1], sil */
+
+    back_end_native_sh(x86_64_reg_r9, x86_64_reg_rbp, -2);
+    match(8, "\x66\x44\x89\x8d\xfe\xff\xff\xff"); /* mov word [rbp-0x2], r9w */
+
+    back_end_native_sd(x86_64_reg_r15, x86_64_reg_r13, -8);
+    match(7, "\x4d\x89\xbd\xf8\xff\xff\xff"); /* mov qword [r13-0x8], r15 */
+
+    back_end_native_ret();
+    match(1, "\xc3");
+
+    back_end_native_jmp_reg(x86_64_reg_r11);
+    match(3, "\x41\xff\xe3");          /* jmp r11 */
+
+    back_end_native_bne(x86_64_reg_rax, x86_64_reg_r8, 0);
+    match(9,
+        "\x4c\x39\xc0"                 /* cmp rax, r8   */
+        "\x0f\x85\xf7\xff\xff\xff"     /* jne <cmp>     */
+    );
+
+    back_end_native_syscall_1(60, 3);
+    match(16,
+        "\x48\xc7\xc7\x03\x00\x00\x00" /* mov rdi, 3    */
+        "\x48\xc7\xc0\x3c\x00\x00\x00" /* mov rax, 60   */
+        "\x0f\x05"                     /* syscall       */
+    );
+
+    back_end_native_prologue(/*stack_usage=*/20);
+    match(11,
+        "\x55"                         /* push rbp      */
+        "\x48\x89\xe5"                 /* mov rbp, rsp  */
+        "\x48\x81\xec\x20\x00\x00\x00" /* sub rsp, 0x20 */
+    );
+
+    back_end_native_epilogue(/*stack_usage=*/20);
+    match(1, "\xc9");                  /* leave */
+
+    /* Forward call and backward branch, resolved by fixups. */
+    uint64_t fn   = back_end_label();
+    uint64_t loop = back_end_label();
+
+    back_end_label_bind(loop);
+    back_end_fixup(fn);
+    back_end_native_call(0);
+    back_end_fixup(loop);
+    back_end_native_beq(x86_64_reg_rax, x86_64_reg_rcx, 0);
+    back_end_label_bind(fn);
+    back_end_native_ret();
+    back_end_fixups_resolve();
+    match(15,
+        "\xe8\x09\x00\x00\x00"         /* call <ret>    */
+        "\x48\x39\xc8"                 /* cmp rax, rcx  */
+        "\x0f\x84\xf2\xff\xff\xff"     /* je <call>     */
+        "\xc3"                         /* ret           */
+    );
+
+    return 0;
+}
@@ -0,0 +1,149 @@
+/* regalloc.c - Register allocators benchmark.
+ * Copyright (C) 2024 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+/* Usage: make bench
+
+   Graph-coloring and linear-scan allocators are run on
+   each test input. Reported are average allocation time,
+   number of operands, left in memory, and number of
+   statements after allocation (including inserted loads
+   and stores). */
+
+#include "middle_end/ir/ir_ops.h"
+#include "middle_end/ir/regalloc.h"
+#include "middle_end/opt/opt.h"
+#include "utils/test_utils.h"
+#include <time.h>
+
+/**********************************************
+ **              Configuration               **
+ **********************************************/
+#define BENCH_REPEATS 100
+#define BENCH_REGS    4
+
+void *diag_error_memstream = NULL;
+void *diag_warn_memstream = NULL;
+
+struct stats {
+    double   usec;
+    uint64_t mem;
+    uint64_t stmts;
+};
+
+static struct stats total[2];
+
+static const char *allocators[2] = {
+    "coloring",
+    "linear"
+};
+
+/**********************************************
+ **                Counters                  **
+ **********************************************/
+static void mem_count(struct ir_node *sym, void *data)
+{
+    if (sym->claimed_reg == IR_NO_CLAIMED_REG)
+        ++*(uint64_t *) data;
+}
+
+static void stats_count(struct ir_unit *unit, struct stats *stats)
+{
+    for (struct ir_node *fn = unit->fn_decls; fn; fn = fn->next) {
+        struct ir_fn_decl *decl = fn->ir;
+
+        for (struct ir_node *it = decl->body; it; it = it->next) {
+            struct ir_node *def = ir_def(it);
+
+            ++stats->stmts;
+            ir_foreach_use(it, mem_count, &stats->mem);
+
+            if (def)
+                mem_count(def, &stats->mem);
+        }
+    }
+}
+
+static double usec_since(struct timespec *start)
+{
+    struct timespec end = {0};
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    return (end.tv_sec  - start->tv_sec)  * 1e6 +
+           (end.tv_nsec - start->tv_nsec) / 1e3;
+}
+
+/**********************************************
+ **                 Driver                   **
+ **********************************************/
+static void run(const char *path, uint64_t allocator, struct stats *stats)
+{
+    struct ir_reg_file file = {.count = BENCH_REGS};
+
+    for (uint64_t i = 0; i < BENCH_REPEATS; ++i) {
+        struct ir_unit  ir    = gen_ir(path);
+        struct timespec start = {0};
+
+        ir_opt_reorder(&ir);
+        clock_gettime(CLOCK_MONOTONIC, &start);
+
+        if (allocator == 0)
+            ir_reg_alloc(&ir, &file);
+        else
+            ir_reg_alloc_linear(&ir, &file);
+
+        stats->usec += usec_since(&start) / BENCH_REPEATS;
+
+        /* Allocation is deterministic, count only once. */
+        if (i == 0)
+            stats_count(&ir, stats);
+
+        ir_unit_cleanup(&ir);
+    }
+}
+
+int bench(const char *path, unused const char *filename)
+{
+    puts("");
+
+    for (uint64_t a = 0; a < 2; ++a) {
+        struct stats stats = {0};
+
+        run(path, a, &stats);
+
+        printf(
+            "    %-10s %10.1f us %6lu mem %6lu stmts\n",
+            allocators[a],
+            stats.usec,
+            stats.mem,
+            stats.stmts
+        );
+
+        total[a].usec  += stats.usec;
+        total[a].mem   += stats.mem;
+        total[a].stmts += stats.stmts;
+    }
+
+    return 0;
+}
+
+int main()
+{
+    if (do_on_each_file("regalloc", bench) < 0 ||
+        do_on_each_file("eval", bench) < 0)
+        return -1;
+
+    printf("Total, %d registers:\n", BENCH_REGS);
+
+    for (uint64_t a = 0; a < 2; ++a)
+        printf(
+            "    %-10s %10.1f us %6lu mem %6lu stmts\n",
+            allocators[a],
+            total[a].usec,
+            total[a].mem,
+            total[a].stmts
+        );
+}
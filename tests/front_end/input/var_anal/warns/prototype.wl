@@ -0,0 +1,12 @@
+//W<3:1>: Function `unused` is never used
+int external(int a);
+int unused(int a);
+int defined_later(int a);
+
+int main() {
+    return external(1) + defined_later(2);
+}
+
+int defined_later(int a) {
+    return a;
+}
@@ -1,11 +1,11 @@
 //fun main():
 //       2:   int t1
-//       3:   t1 = 2
+//       3:   t1.0 = 2
 //       4:   int t2
-//       5:   t2 = 3
+//       5:   t2.0 = 3
 //       8:   int t4
-//       9:   t4 = t1 + t2
-//      10:   ret t4
+//       9:   t4.0 = t1.0 + t2.0
+//      10:   ret t4.0
 int main() {
     int a = 1;
     int b = 2;
@@ -0,0 +1,28 @@
+//fun main():
+//       0:   int t0
+//       1:   t0.0 = 0
+//       4:   int t2
+//       5:   t2.0 = 0
+//            | t0.1 = φ(t0.0, t0.2)
+//            | t2.1 = φ(t2.0, t2.2)
+//       6:   | int t3
+//       7:   | t3.0 = t2.1 < 10
+//       8:   | if t3.0 != 0 goto L10
+//       9:   | jmp L18
+//      10:   | int t4
+//      11:   | t4.0 = t0.1 + t2.1
+//      12:   | t0.2 = t4.0
+//      16:   | t2.2 = t2.1 + 1
+//      17:   | jmp L6
+//      18:   ret t0.1
+int main() {
+    int sum = 0;
+    int unused = 0;
+
+    for (int i = 0; i < 10; ++i) {
+        sum = sum + i;
+        unused = unused * i;
+    }
+
+    return sum;
+}
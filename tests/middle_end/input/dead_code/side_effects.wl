@@ -0,0 +1,22 @@
+//fun g(int t0):
+//       0:   ret t0
+//fun main():
+//       0:   int t0
+//       1:   t0 = 1
+//       2:   int * t1
+//       3:   t1.0 = &t0
+//       4:   *t1.0 = 2
+//       6:   int t3
+//       7:   t3.0 = call g(t0)
+//       9:   ret 0
+int g(int x) {
+    return x;
+}
+
+int main() {
+    int a = 1;
+    int *p = &a;
+    *p = 2;
+    int unused = g(a);
+    return 0;
+}
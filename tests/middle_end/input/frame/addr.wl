@@ -0,0 +1,37 @@
+//fun main():
+//       0:   int t0
+//       4:   int t2
+//       6:   int t3
+//       7:   int t4
+//      11:   int * t6
+//      14:   int * t7
+//       2:   int * t1
+//       1:   t0 = 1
+//       3:   t1 = &t0
+//       5:   t2 = *t1
+//       8:   t4 = t2 + 1
+//       9:   t3 = t4
+//      10:   int t5[4]
+//      12:   t6 = t5 + 0
+//      13:   *t6 = t3
+//      15:   t7 = t5 + 0
+//      16:   ret *t7
+//--------
+//t0: 0
+//t2: 4
+//t3: 4
+//t4: 4
+//t6: 8
+//t7: 8
+//t1: 8
+//t5: 16
+//frame size: 32
+int main() {
+    int a = 1;
+    int *p = &a;
+    int b = *p;
+    int c = b + 1;
+    int arr[4];
+    arr[0] = c;
+    return arr[0];
+}
@@ -0,0 +1,23 @@
+//fun f(int t0):
+//       0:   int t1
+//       1:   t1.0 = t0
+//       2:   int t2
+//       3:   t2.0 = 2
+//       4:   int t3
+//       5:   int t4
+//       6:   t4.0 = t0 * t2.0
+//       7:   t3.0 = t4.0
+//       8:   int t5
+//       9:   int t6
+//      10:   t6.0 = t4.0
+//      11:   t5.0 = t4.0
+//      12:   int t7
+//      13:   t7.0 = t4.0 + t4.0
+//      14:   ret t7.0
+int f(int a) {
+    int b = a;
+    int c = 2;
+    int x = a * c;
+    int y = b * 2;
+    return x + y;
+}
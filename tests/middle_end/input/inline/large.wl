@@ -0,0 +1,51 @@
+//fun big(int t0):
+//       0:   int t1
+//       1:   int t2
+//       2:   t2 = t0 + 1
+//       3:   t1 = t2
+//       4:   int t3
+//       5:   int t4
+//       6:   t4 = t1 * 3
+//       7:   t3 = t4
+//       8:   int t5
+//       9:   int t6
+//      10:   t6 = t3 - t0
+//      11:   t5 = t6
+//      12:   int t7
+//      13:   int t8
+//      14:   t8 = t5 * t5
+//      15:   t7 = t8
+//      16:   int t9
+//      17:   int t10
+//      18:   t10 = t7 + t1
+//      19:   t9 = t10
+//      20:   int t11
+//      21:   int t12
+//      22:   t12 = t9 - t3
+//      23:   t11 = t12
+//      24:   int t13
+//      25:   t13 = t11 + t5
+//      26:   ret t13
+//fun f(int t0):
+//       0:   int t1
+//       1:   int t2
+//       2:   t2 = call big(t0)
+//       3:   int t3
+//       4:   t3 = t0 + 1
+//       5:   int t4
+//       6:   t4 = call big(t3)
+//       7:   t1 = t2 + t4
+//       8:   ret t1
+int big(int x) {
+    int a = x + 1;
+    int b = a * 3;
+    int c = b - x;
+    int d = c * c;
+    int e = d + a;
+    int g = e - b;
+    return g + c;
+}
+
+int f(int a) {
+    return big(a) + big(a + 1);
+}
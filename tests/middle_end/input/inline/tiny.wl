@@ -0,0 +1,29 @@
+//fun sq(int t0):
+//       0:   int t1
+//       1:   t1 = t0 * t0
+//       2:   ret t1
+//fun f(int t0):
+//       0:   int t7
+//       1:   int t8
+//       2:   int t5
+//       3:   int t6
+//       4:   int t1
+//       5:   int t2
+//       6:   t5 = t0
+//       7:   t6 = t5 * t5
+//       8:   t2 = t6
+//       9:   int t3
+//      10:   t3 = t0 + 1
+//      11:   int t4
+//      12:   t7 = t3
+//      13:   t8 = t7 * t7
+//      14:   t4 = t8
+//      15:   t1 = t2 + t4
+//      16:   ret t1
+int sq(int x) {
+    return x * x;
+}
+
+int f(int a) {
+    return sq(a) + sq(a + 1);
+}
@@ -0,0 +1,32 @@
+//fun f(int t0):
+//       0:   int t7
+//       1:   int t6
+//       2:   int t1
+//       3:   t1.0 = 0
+//       4:   int t2
+//       5:   t2.0 = 0
+//       6:   t6.0 = t2.0 * 4
+//       7:   t7.0 = t0 * 4
+//            | t1.1 = φ(t1.0, t1.2)
+//            | t2.1 = φ(t2.0, t2.2)
+//            | t6.1 = φ(t6.0, t6.2)
+//       8:   | int t3
+//       9:   | t3.0 = t6.1 < t7.0
+//      10:   | if t3.0 != 0 goto L12
+//      11:   | jmp L20
+//      12:   | int t4
+//      13:   | int t5
+//      14:   | t5.0 = t6.1
+//      15:   | t4.0 = t1.1 + t5.0
+//      16:   | t1.2 = t4.0
+//      17:   | t2.2 = t2.1 + 1
+//      18:   | t6.2 = t6.1 + 4
+//      19:   | jmp L8
+//      20:   ret t1.1
+int f(int n) {
+    int s = 0;
+    for (int i = 0; i < n; ++i) {
+        s = s + i * 4;
+    }
+    return s;
+}
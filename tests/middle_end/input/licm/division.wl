@@ -0,0 +1,43 @@
+//fun f(int t0, int t1, int t2):
+//       0:   int t3
+//       1:   t3.0 = 0
+//       2:   int t4
+//       3:   t4.0 = 0
+//       4:   int t6
+//       5:   t6.0 = t2 != 0
+//       6:   int t10
+//       7:   t10.0 = t1 % 3
+//            | t3.1 = φ(t3.0, t3.4)
+//            | t4.1 = φ(t4.0, t4.2)
+//       8:   | int t5
+//       9:   | t5.0 = t4.1 < t0
+//      10:   | if t5.0 != 0 goto L12
+//      11:   | jmp L26
+//      12:   | | if t6.0 != 0 goto L14
+//      13:   | | jmp L19
+//      14:   | | int t7
+//      15:   | | int t8
+//      16:   | | t8.0 = t1 / t2
+//      17:   | | t7.0 = t3.1 + t8.0
+//      18:   | | t3.2 = t7.0
+//            | t3.3 = φ(t3.1, t3.2)
+//      19:   | int t9
+//      20:   | t9.0 = t3.3 + t10.0
+//      21:   | t3.4 = t9.0
+//      22:   | int t11
+//      23:   | t11.0 = t4.1 + 1
+//      24:   | t4.2 = t11.0
+//      25:   | jmp L8
+//      26:   ret t3.1
+int f(int n, int a, int b) {
+    int s = 0;
+    int i = 0;
+    while (i < n) {
+        if (b != 0) {
+            s = s + a / b;
+        }
+        s = s + a % 3;
+        i = i + 1;
+    }
+    return s;
+}
@@ -0,0 +1,30 @@
+//fun f(int t0):
+//       0:   int t1
+//       1:   t1.0 = 0
+//       2:   int t2
+//       3:   t2.0 = 0
+//            | t1.1 = φ(t1.0, t1.2)
+//            | t2.1 = φ(t2.0, t2.2)
+//       4:   | int t3
+//       5:   | t3.0 = t2.1 < t0
+//       6:   | if t3.0 != 0 goto L8
+//       7:   | jmp L17
+//       8:   | int t4
+//       9:   | int t5
+//      10:   | t5.0 = t2.1 * 2
+//      11:   | t4.0 = t1.1 + t5.0
+//      12:   | t1.2 = t4.0
+//      13:   | int t6
+//      14:   | t6.0 = t2.1 + 1
+//      15:   | t2.2 = t6.0
+//      16:   | jmp L4
+//      17:   ret t1.1
+int f(int n) {
+    int s = 0;
+    int i = 0;
+    while (i < n) {
+        s = s + i * 2;
+        i = i + 1;
+    }
+    return s;
+}
@@ -0,0 +1,35 @@
+//fun main():
+//       0:   int t0
+//       1:   t0 = 0
+//       2:   | if 1 != 0 goto L4
+//       3:   | jmp L11
+//       4:   | | int t1
+//       5:   | | t1 = t0 > 10
+//       6:   | | if t1 != 0 goto L8
+//       7:   | | jmp L9
+//       8:   | | jmp L11
+//       9:   | t0 = t0 + 1
+//      10:   | jmp L2
+//      11:   | t0 = t0 - 1
+//      12:   | int t2
+//      13:   | t2 = t0 > 0
+//      14:   | if t2 != 0 goto L11
+//      15:   ret t0
+//--------
+//loop 2: depth 1, preheader 1
+// latches (10) exits (3, 8) body (2, 4, 5, 6, 7, 9, 10)
+//loop 11: depth 1
+// latches (14) exits (15) body (11, 12, 13, 14)
+int main() {
+    int a = 0;
+    while (1) {
+        if (a > 10) {
+            break;
+        }
+        ++a;
+    }
+    do {
+        --a;
+    } while (a > 0);
+    return a;
+}
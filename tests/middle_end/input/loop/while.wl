@@ -0,0 +1,20 @@
+//fun main():
+//       0:   int t0
+//       1:   t0 = 0
+//       2:   | int t1
+//       3:   | t1 = t0 < 10
+//       4:   | if t1 != 0 goto L6
+//       5:   | jmp L8
+//       6:   | t0 = t0 + 1
+//       7:   | jmp L2
+//       8:   ret t0
+//--------
+//loop 2: depth 1, preheader 1
+// latches (7) exits (5) body (2, 3, 4, 6, 7)
+int main() {
+    int a = 0;
+    while (a < 10) {
+        ++a;
+    }
+    return a;
+}
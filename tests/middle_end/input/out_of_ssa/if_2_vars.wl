@@ -0,0 +1,29 @@
+//fun f(int t0):
+//       0:   int t1
+//       1:   t1 = 0
+//       2:   int t2
+//       3:   t2 = 0
+//       4:   | int t3
+//       5:   | t3 = t0 < 2
+//       6:   | if t3 != 0 goto L8
+//       7:   | jmp L11
+//       8:   | t1 = 1
+//       9:   | t2 = 1
+//      10:   | jmp L13
+//      11:   | t1 = 2
+//      12:   | t2 = 2
+//      13:   int t4
+//      14:   t4 = t1 + t2
+//      15:   ret t4
+int f(int arg) {
+    int a = 0;
+    int b = 0;
+    if (arg < 2) {
+        a = 1;
+        b = 1;
+    } else {
+        a = 2;
+        b = 2;
+    }
+    return a + b;
+}
@@ -0,0 +1,31 @@
+//fun f(int t0):
+//       0:   int t1
+//       1:   t1 = 0
+//       2:   | int t2
+//       3:   | t2 = t0 > 0
+//       4:   | if t2 != 0 goto L6
+//       5:   | jmp L13
+//       6:   | int t3
+//       7:   | t3 = t1 + t0
+//       8:   | t1 = t3
+//       9:   | int t4
+//      10:   | t4 = t0 - 1
+//      11:   | t0 = t4
+//      12:   | jmp L2
+//      13:   ret t1
+//fun main():
+//       0:   int t0
+//       1:   t0 = call f(5)
+//       2:   ret t0
+int f(int n) {
+    int r = 0;
+    while (n > 0) {
+        r = r + n;
+        n = n - 1;
+    }
+    return r;
+}
+
+int main() {
+    return f(5);
+}
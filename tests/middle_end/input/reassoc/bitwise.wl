@@ -0,0 +1,36 @@
+//fun main(int t0, int t1):
+//       0:   int t2
+//       1:   int t3
+//       2:   int t4
+//       3:   t3.0 = t0 & t1
+//       4:   t2.0 = t3.0
+//       5:   int t5
+//       6:   int t6
+//       7:   int t7
+//       8:   t6.0 = t1
+//       9:   t5.0 = t6.0
+//      10:   int t8
+//      11:   int t9
+//      12:   int t10
+//      13:   int t11
+//      14:   t9.0 = -1
+//      15:   t8.0 = t9.0
+//      16:   int t12
+//      17:   int t13
+//      18:   int t14
+//      19:   t13.0 = 0
+//      20:   t12.0 = t13.0
+//      21:   int t15
+//      22:   int t16
+//      23:   int t17
+//      24:   t16.0 = t2.0 + t5.0
+//      25:   t17.0 = t8.0 + t12.0
+//      26:   t15.0 = t16.0 + t17.0
+//      27:   ret t15.0
+int main(int a, int b) {
+    int x = a & b & a;
+    int y = a ^ b ^ a;
+    int z = (a | 5) | (b | -6);
+    int w = (a * 0) * b;
+    return x + y + z + w;
+}
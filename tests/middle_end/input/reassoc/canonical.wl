@@ -0,0 +1,21 @@
+//fun main(int t0, int t1, int t2):
+//       0:   int t3
+//       1:   int t4
+//       2:   int t5
+//       3:   t5.0 = t0 + t1
+//       4:   t4.0 = t5.0 + t2
+//       5:   t3.0 = t4.0
+//       6:   int t6
+//       7:   int t7
+//       8:   int t8
+//       9:   t8.0 = t0 + t1
+//      10:   t7.0 = t8.0 + t2
+//      11:   t6.0 = t7.0
+//      12:   int t9
+//      13:   t9.0 = t3.0 * t6.0
+//      14:   ret t9.0
+int main(int a, int b, int c) {
+    int x = (a + b) + c;
+    int y = c + (b + a);
+    return x * y;
+}
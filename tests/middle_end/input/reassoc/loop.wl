@@ -0,0 +1,33 @@
+//fun main(int t0):
+//       0:   int t1
+//       1:   t1.0 = 0
+//       2:   int t2
+//       3:   int t3
+//       4:   t3.0 = t0 + 3
+//       5:   t2.0 = t3.0
+//       6:   int t4
+//       7:   t4.0 = 0
+//            | t1.1 = φ(t1.0, t1.2)
+//            | t4.1 = φ(t4.0, t4.2)
+//       8:   | int t5
+//       9:   | t5.0 = t4.1 < t0
+//      10:   | if t5.0 != 0 goto L12
+//      11:   | jmp L21
+//      12:   | int t6
+//      13:   | int t7
+//      14:   | int t8
+//      15:   | t7.0 = t2.0 + 1
+//      16:   | t8.0 = t1.1 + t4.1
+//      17:   | t6.0 = t7.0 + t8.0
+//      18:   | t1.2 = t6.0
+//      19:   | t4.2 = t4.1 + 1
+//      20:   | jmp L8
+//      21:   ret t1.1
+int main(int n) {
+    int s = 0;
+    int k = n + 3;
+    for (int i = 0; i < n; ++i) {
+        s = s + k + i + 1;
+    }
+    return s;
+}
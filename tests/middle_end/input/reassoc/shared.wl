@@ -0,0 +1,32 @@
+//fun main(int t0, int t1, int t2):
+//       0:   int t3
+//       1:   int t4
+//       2:   t4.0 = t0 + t1
+//       3:   t3.0 = t4.0
+//       4:   int t5
+//       5:   int t6
+//       6:   t6.0 = t2 + t3.0
+//       7:   t5.0 = t6.0
+//       8:   int t7
+//       9:   int t8
+//      10:   t8.0 = t3.0 + 1
+//      11:   t7.0 = t8.0
+//      12:   float t9
+//      13:   t9.0 = 1.500000
+//      14:   float t10
+//      15:   float t11
+//      16:   float t12
+//      17:   t12.0 = 2.000000 + t9.0
+//      18:   t11.0 = t9.0 + t12.0
+//      19:   t10.0 = t11.0
+//      20:   int t13
+//      21:   t13.0 = t5.0 + t7.0
+//      22:   ret t13.0
+int main(int a, int b, int c) {
+    int x = a + b;
+    int y = x + c;
+    int z = x + 1;
+    float f = 1.5;
+    float g = f + 2.0 + f;
+    return y + z;
+}
@@ -1,25 +1,23 @@
 //fun main():
 //       0:   int #reg0
-//       4:   int #reg2
-//       5:   int #reg3
-//       8:   int #reg2
-//      10:   int #reg2
-//      12:   int #reg3
-//      14:   int #reg0
-//      15:   int #reg1
-//      16:   int #reg4
+//       1:   int #reg1
 //       2:   int #reg1
-//       1:   #reg0 = 0
-//       3:   #reg1 = 1
-//       6:   #reg3 = #reg0 + #reg1
-//       7:   #reg2 = #reg3
-//       9:   #reg2 = #reg0
-//      11:   #reg2 = 9
-//      13:   #reg3 = 8
-//      17:   #reg4 = #reg0 + #reg1
-//      18:   #reg1 = #reg2 + #reg4
-//      19:   #reg0 = #reg3 + #reg1
-//      20:   ret #reg0
+//       3:   int #reg0
+//       4:   int #reg2
+//       5:   int #reg1
+//       6:   int #reg0
+//       7:   int #reg0
+//       8:   int #reg0
+//       9:   int #reg3
+//      10:   #reg0 = 0
+//      11:   #reg3 = 1
+//      12:   #reg1 = #reg0 + #reg3
+//      13:   #reg2 = 9
+//      14:   #reg1 = 8
+//      15:   #reg0 = #reg0 + #reg3
+//      16:   #reg0 = #reg2 + #reg0
+//      17:   #reg0 = #reg1 + #reg0
+//      18:   ret #reg0
 int main() {
 	int a = 0;
 	int b = 1;
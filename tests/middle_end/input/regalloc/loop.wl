@@ -1,26 +1,25 @@
 //fun main():
-//       0:   int #reg0
-//       4:   int #reg2
-//       8:   int #reg2
-//       9:   int #reg3
-//      10:   int #reg2
-//      11:   int #reg3
-//      19:   int #reg2
-//       2:   int #reg1
-//       1:   #reg0 = 0
-//       3:   #reg1 = 0
-//       5:   | #reg2 = #reg1 >= #reg0
-//       6:   | if #reg2 != 0 goto L12
-//       7:   | jmp L20
-//      12:   | #reg3 = 32 << 2
-//      13:   | #reg2 = 23 & #reg3
-//      14:   | #reg3 = #reg0 & #reg2
-//      15:   | #reg2 = #reg3 | 5
-//      16:   | #reg1 = #reg2
-//      17:   | #reg0 = #reg0 - 1
-//      18:   | jmp L5
-//      20:   #reg2 = #reg0 + #reg1
-//      21:   ret #reg2
+//       0:   int #reg2
+//       1:   int #reg1
+//       2:   int #reg0
+//       3:   int #reg0
+//       4:   int #reg0
+//       5:   int #reg0
+//       6:   int #reg0
+//       7:   int #reg0
+//       8:   #reg2 = 0
+//       9:   #reg0 = 0
+//      10:   | #reg1 = #reg0 >= #reg2
+//      11:   | if #reg1 != 0 goto L13
+//      12:   | jmp L19
+//      13:   | #reg0 = 32 << 2
+//      14:   | #reg0 = 23 & #reg0
+//      15:   | #reg0 = #reg2 & #reg0
+//      16:   | #reg0 = #reg0 | 5
+//      17:   | #reg2 = #reg2 - 1
+//      18:   | jmp L10
+//      19:   #reg0 = #reg2 + #reg0
+//      20:   ret #reg0
 int main() {
 	int a = 0;
 	int b = 0;
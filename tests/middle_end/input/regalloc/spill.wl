@@ -1,4 +1,52 @@
-//a
+//fun main():
+//       0:   int #reg0
+//       1:   int #reg0
+//       2:   int #reg0
+//       3:   int #reg6
+//       4:   int #reg0
+//       5:   int t3
+//       6:   int #reg7
+//       7:   int t5
+//       8:   int t6
+//       9:   int #reg4
+//      10:   int #reg3
+//      11:   int #reg2
+//      12:   int #reg1
+//      13:   int #reg1
+//      14:   int #reg0
+//      15:   int #reg1
+//      16:   int #reg0
+//      17:   int #reg7
+//      18:   int #reg0
+//      19:   int #reg0
+//      20:   int #reg4
+//      21:   int #reg0
+//      22:   int #reg0
+//      23:   int #reg0
+//      24:   int #reg0
+//      25:   int #reg5
+//      26:   #reg6 = 1
+//      27:   #reg5 = 2
+//      28:   #reg0 = 3
+//      29:   #reg7 = 5
+//      30:   #reg4 = 8
+//      31:   #reg3 = 9
+//      32:   #reg2 = 10
+//      33:   #reg1 = #reg5 * #reg0
+//      34:   #reg0 = 4
+//      35:   #reg7 = #reg0 / #reg7
+//      36:   #reg0 = 6
+//      37:   #reg0 = #reg7 + #reg0
+//      38:   #reg0 = #reg1 - #reg0
+//      39:   #reg1 = #reg6 + #reg0
+//      40:   #reg0 = 7
+//      41:   #reg4 = #reg0 * #reg4
+//      42:   #reg0 = #reg2 * #reg6
+//      43:   #reg0 = #reg0 - #reg5
+//      44:   #reg0 = #reg3 + #reg0
+//      45:   #reg0 = #reg4 - #reg0
+//      46:   #reg0 = #reg1 + #reg0
+//      47:   ret #reg0
 int main() {
     int a = 1;
     int b = 2;
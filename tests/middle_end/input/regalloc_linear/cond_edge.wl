@@ -0,0 +1,46 @@
+//fun main():
+//       0:   int #reg0
+//       1:   int #reg2
+//       2:   int #reg3
+//       3:   int #reg1
+//       4:   int #reg0
+//       5:   int #reg1
+//       6:   int #reg0
+//       7:   int #reg0
+//       8:   int #reg1
+//       9:   int #reg0
+//      10:   int #reg1
+//      11:   #reg0 = 100
+//      12:   #reg1 = 2
+//      13:   #reg2 = 3
+//      14:   #reg3 = 4
+//      15:   | if #reg0 != 0 goto L32
+//      16:   | t0 = #reg0
+//      17:   | t1 = #reg1
+//      18:   | jmp L28
+//      19:   | #reg0 = #reg1 * #reg2
+//      20:   | t1 = #reg1
+//      21:   | #reg1 = #reg0
+//      22:   | #reg0 = #reg1 - #reg3
+//      23:   | #reg1 = t0 - #reg0
+//      24:   | t0 = #reg1
+//      25:   | #reg0 = t0
+//      26:   | #reg1 = t1
+//      27:   | jmp L15
+//      28:   #reg0 = #reg2 + #reg3
+//      29:   #reg1 = t1 + #reg0
+//      30:   #reg0 = t0 + #reg1
+//      31:   ret #reg0
+//      32:   | t0 = #reg0
+//      33:   | jmp L19
+int main() {
+    int a = 100;
+    int b = 2;
+    int c = 3;
+    int d = 4;
+    while (a) {
+        int e = b * c;
+        a = a - e - d;
+    }
+    return a + b + c + d;
+}
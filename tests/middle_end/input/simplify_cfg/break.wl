@@ -0,0 +1,36 @@
+//fun main(int t0):
+//       0:   int t1
+//       1:   t1 = 0
+//       2:   int t2
+//       3:   t2 = 0
+//       4:   | int t3
+//       5:   | t3 = t2 < t0
+//       6:   | if t3 == 0 goto L22
+//       7:   | int t4
+//       8:   | t4 = 0
+//       9:   | | int t5
+//      10:   | | t5 = t4 < t0
+//      11:   | | if t5 == 0 goto L20
+//      12:   | | | int t6
+//      13:   | | | t6 = t4 > t2
+//      14:   | | | if t6 != 0 goto L20
+//      15:   | | int t7
+//      16:   | | t7 = t1 + t4
+//      17:   | | t1 = t7
+//      18:   | | t4 = t4 + 1
+//      19:   | | jmp L9
+//      20:   | t2 = t2 + 1
+//      21:   | jmp L4
+//      22:   ret t1
+int main(int n) {
+    int s = 0;
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            if (j > i) {
+                break;
+            }
+            s = s + j;
+        }
+    }
+    return s;
+}
@@ -0,0 +1,28 @@
+//fun main(int t0):
+//       0:   int t1
+//       1:   t1 = 0
+//       2:   | int t2
+//       3:   | t2 = t0 > 10
+//       4:   | if t2 == 0 goto L7
+//       5:   | t1 = 1
+//       6:   | jmp L13
+//       7:   | | int t3
+//       8:   | | t3 = t0 > 5
+//       9:   | | if t3 == 0 goto L12
+//      10:   | | t1 = 2
+//      11:   | | jmp L13
+//      12:   | | t1 = 3
+//      13:   ret t1
+int main(int x) {
+    int r = 0;
+    if (x > 10) {
+        r = 1;
+    } else {
+        if (x > 5) {
+            r = 2;
+        } else {
+            r = 3;
+        }
+    }
+    return r;
+}
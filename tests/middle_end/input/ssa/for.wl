@@ -1,19 +1,19 @@
 //fun main():
 //       0:   int t0
 //       1:   t0.0 = 0
-//            | t0.2 = φ(2, 1)
-//            | t1.1 = φ(2, 1)
-//            | t2.2 = φ(2, 1)
-//       2:   | int t1
-//       3:   | t1.0 = t0.0 < 10
-//       4:   | if t1.0 != 0 goto L6
-//       5:   | jmp L11
-//       6:   | int t2
-//       7:   | t2.0 = t0.0
-//       8:   | t2.1 = t2.0 + 1
-//       9:   | t0.1 = t0.0 + 1
-//      10:   | jmp L2
-//      11:   ret 0
+//       2:   int t1
+//       3:   t1.0 = 0
+//            | t0.1 = φ(t0.0, t0.3)
+//            | t1.1 = φ(t1.0, t1.2)
+//       4:   | int t2
+//       5:   | t2.0 = t1.1 < 10
+//       6:   | if t2.0 != 0 goto L8
+//       7:   | jmp L12
+//       8:   | t0.2 = t1.1
+//       9:   | t0.3 = t0.2 + 1
+//      10:   | t1.2 = t1.1 + 1
+//      11:   | jmp L4
+//      12:   ret t0.1
 int main() {
     int j = 0;
     for (int i = 0; i < 10; ++i) {
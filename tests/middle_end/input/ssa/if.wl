@@ -0,0 +1,21 @@
+//fun f(int t0):
+//       0:   int t1
+//       1:   t1.0 = 0
+//       2:   | int t2
+//       3:   | t2.0 = t0 < 2
+//       4:   | if t2.0 != 0 goto L6
+//       5:   | jmp L8
+//       6:   | t1.2 = 1
+//       7:   | jmp L9
+//       8:   | t1.1 = 2
+//            t1.3 = φ(t1.2, t1.1)
+//       9:   ret t1.3
+int f(int arg) {
+    int result = 0;
+    if (arg < 2) {
+        result = 1;
+    } else {
+        result = 2;
+    }
+    return result;
+}
\ No newline at end of file
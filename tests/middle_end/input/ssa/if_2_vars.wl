@@ -0,0 +1,31 @@
+//fun f(int t0):
+//       0:   int t1
+//       1:   t1.0 = 0
+//       2:   int t2
+//       3:   t2.0 = 0
+//       4:   | int t3
+//       5:   | t3.0 = t0 < 2
+//       6:   | if t3.0 != 0 goto L8
+//       7:   | jmp L11
+//       8:   | t1.2 = 1
+//       9:   | t2.2 = 1
+//      10:   | jmp L13
+//      11:   | t1.1 = 2
+//      12:   | t2.1 = 2
+//            t1.3 = φ(t1.2, t1.1)
+//            t2.3 = φ(t2.2, t2.1)
+//      13:   int t4
+//      14:   t4.0 = t1.3 + t2.3
+//      15:   ret t4.0
+int f(int arg) {
+    int a = 0;
+    int b = 0;
+    if (arg < 2) {
+        a = 1;
+        b = 1;
+    } else {
+        a = 2;
+        b = 2;
+    }
+    return a + b;
+}
\ No newline at end of file
@@ -0,0 +1,33 @@
+//fun main(int t0):
+//       0:   int t13
+//       1:   int t12
+//       2:   int t11
+//       3:   int t10
+//       4:   int t9
+//       5:   int t8
+//       6:   int t7
+//       7:   int t6
+//       8:   int t1
+//       9:   int t2
+//      10:   t6 = t0 mulh -1840700269
+//      11:   t7 = t6 + t0
+//      12:   t8 = t7 >> 2
+//      13:   t9 = t8 >> 31
+//      14:   t2 = t8 - t9
+//      15:   t1 = t2
+//      16:   int t3
+//      17:   int t4
+//      18:   t10 = t0 mulh 1431655765
+//      19:   t11 = t10 - t0
+//      20:   t12 = t11 >> 1
+//      21:   t13 = t12 >> 31
+//      22:   t4 = t12 - t13
+//      23:   t3 = t4
+//      24:   int t5
+//      25:   t5 = t1 + t3
+//      26:   ret t5
+int main(int x) {
+    int a = x / 7;
+    int b = x / -3;
+    return a + b;
+}
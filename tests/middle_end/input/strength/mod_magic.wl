@@ -0,0 +1,20 @@
+//fun main(int t0):
+//       0:   int t7
+//       1:   int t6
+//       2:   int t5
+//       3:   int t4
+//       4:   int t3
+//       5:   int t1
+//       6:   int t2
+//       7:   t3 = t0 mulh 274877907
+//       8:   t4 = t3 >> 6
+//       9:   t5 = t4 >> 31
+//      10:   t6 = t4 - t5
+//      11:   t7 = t6 * 1000
+//      12:   t2 = t0 - t7
+//      13:   t1 = t2
+//      14:   ret t1
+int main(int x) {
+    int h = x % 1000;
+    return h;
+}
@@ -0,0 +1,34 @@
+//fun f():
+//       0:   int t0
+//       1:   t0 = 0
+//       2:   int t1
+//       3:   t1 = 10
+//       4:   | int t2
+//       5:   | int t3
+//       6:   | t3 = t0 + t1
+//       7:   | t0 = t3
+//       8:   | int t4
+//       9:   | t4 = t1 - 3
+//      10:   | t1 = t4
+//      11:   | t3 = t0 + t1
+//      12:   | t0 = t3
+//      13:   | t4 = t1 - 3
+//      14:   | t1 = t4
+//      15:   | t3 = t0 + t1
+//      16:   | t0 = t3
+//      17:   | t4 = t1 - 3
+//      18:   | t1 = t4
+//      19:   | t3 = t0 + t1
+//      20:   | t0 = t3
+//      21:   | t4 = t1 - 3
+//      22:   | t1 = t4
+//      23:   ret t0
+int f() {
+    int s = 0;
+    int j = 10;
+    while (j > 0) {
+        s = s + j;
+        j = j - 3;
+    }
+    return s;
+}
@@ -0,0 +1,68 @@
+//fun f():
+//       0:   int t0
+//       1:   t0 = 0
+//       2:   int t1
+//       3:   t1 = 100
+//       4:   | int t2
+//       5:   | t2 = t1 >= 6
+//       6:   | if t2 != 0 goto L8
+//       7:   | jmp L44
+//       8:   | int t3
+//       9:   | t3 = t0 + t1
+//      10:   | t0 = t3
+//      11:   | | int t4
+//      12:   | | t4 = t0 > 1000
+//      13:   | | if t4 != 0 goto L15
+//      14:   | | jmp L16
+//      15:   | | jmp L56
+//      16:   | int t5
+//      17:   | t5 = t1 - 2
+//      18:   | t1 = t5
+//      19:   | t3 = t0 + t1
+//      20:   | t0 = t3
+//      21:   | | t4 = t0 > 1000
+//      22:   | | if t4 != 0 goto L24
+//      23:   | | jmp L25
+//      24:   | | jmp L56
+//      25:   | t5 = t1 - 2
+//      26:   | t1 = t5
+//      27:   | t3 = t0 + t1
+//      28:   | t0 = t3
+//      29:   | | t4 = t0 > 1000
+//      30:   | | if t4 != 0 goto L32
+//      31:   | | jmp L33
+//      32:   | | jmp L56
+//      33:   | t5 = t1 - 2
+//      34:   | t1 = t5
+//      35:   | t3 = t0 + t1
+//      36:   | t0 = t3
+//      37:   | | t4 = t0 > 1000
+//      38:   | | if t4 != 0 goto L40
+//      39:   | | jmp L41
+//      40:   | | jmp L56
+//      41:   | t5 = t1 - 2
+//      42:   | t1 = t5
+//      43:   | jmp L4
+//      44:   | t2 = t1 >= 0
+//      45:   | if t2 != 0 goto L47
+//      46:   | jmp L56
+//      47:   | t3 = t0 + t1
+//      48:   | t0 = t3
+//      49:   | | t4 = t0 > 1000
+//      50:   | | if t4 != 0 goto L52
+//      51:   | | jmp L53
+//      52:   | | jmp L56
+//      53:   | t5 = t1 - 2
+//      54:   | t1 = t5
+//      55:   | jmp L44
+//      56:   ret t0
+int f() {
+    int s = 0;
+    for (int k = 100; k >= 0; k = k - 2) {
+        s = s + k;
+        if (s > 1000) {
+            break;
+        }
+    }
+    return s;
+}
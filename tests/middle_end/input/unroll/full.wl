@@ -0,0 +1,27 @@
+//fun f():
+//       0:   int t0
+//       1:   t0 = 0
+//       2:   int t1
+//       3:   t1 = 0
+//       4:   | int t2
+//       5:   | int t3
+//       6:   | t3 = t0 + t1
+//       7:   | t0 = t3
+//       8:   | t1 = t1 + 1
+//       9:   | t3 = t0 + t1
+//      10:   | t0 = t3
+//      11:   | t1 = t1 + 1
+//      12:   | t3 = t0 + t1
+//      13:   | t0 = t3
+//      14:   | t1 = t1 + 1
+//      15:   | t3 = t0 + t1
+//      16:   | t0 = t3
+//      17:   | t1 = t1 + 1
+//      18:   ret t0
+int f() {
+    int s = 0;
+    for (int i = 0; i < 4; ++i) {
+        s = s + i;
+    }
+    return s;
+}
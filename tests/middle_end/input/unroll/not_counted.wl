@@ -0,0 +1,36 @@
+//fun f(int t0):
+//       0:   int t1
+//       1:   t1 = 0
+//       2:   int t2
+//       3:   t2 = 0
+//       4:   | int t3
+//       5:   | t3 = t2 < t0
+//       6:   | if t3 != 0 goto L8
+//       7:   | jmp L22
+//       8:   | | int t4
+//       9:   | | t4 = t1 > 10
+//      10:   | | if t4 != 0 goto L12
+//      11:   | | jmp L15
+//      12:   | | int t5
+//      13:   | | t5 = t2 + 2
+//      14:   | | t2 = t5
+//      15:   | int t6
+//      16:   | t6 = t1 + t2
+//      17:   | t1 = t6
+//      18:   | int t7
+//      19:   | t7 = t2 + 1
+//      20:   | t2 = t7
+//      21:   | jmp L4
+//      22:   ret t1
+int f(int n) {
+    int s = 0;
+    int i = 0;
+    while (i < n) {
+        if (s > 10) {
+            i = i + 2;
+        }
+        s = s + i;
+        i = i + 1;
+    }
+    return s;
+}
@@ -0,0 +1,40 @@
+//fun f(int t0):
+//       0:   int t5
+//       1:   int t1
+//       2:   t1 = 0
+//       3:   int t2
+//       4:   t2 = 0
+//       5:   t5 = t0 - 3
+//       6:   | int t3
+//       7:   | t3 = t2 < t5
+//       8:   | if t3 != 0 goto L10
+//       9:   | jmp L24
+//      10:   | int t4
+//      11:   | t4 = t1 + t2
+//      12:   | t1 = t4
+//      13:   | t2 = t2 + 1
+//      14:   | t4 = t1 + t2
+//      15:   | t1 = t4
+//      16:   | t2 = t2 + 1
+//      17:   | t4 = t1 + t2
+//      18:   | t1 = t4
+//      19:   | t2 = t2 + 1
+//      20:   | t4 = t1 + t2
+//      21:   | t1 = t4
+//      22:   | t2 = t2 + 1
+//      23:   | jmp L6
+//      24:   | t3 = t2 < t0
+//      25:   | if t3 != 0 goto L27
+//      26:   | jmp L31
+//      27:   | t4 = t1 + t2
+//      28:   | t1 = t4
+//      29:   | t2 = t2 + 1
+//      30:   | jmp L24
+//      31:   ret t1
+int f(int n) {
+    int s = 0;
+    for (int i = 0; i < n; ++i) {
+        s = s + i;
+    }
+    return s;
+}
@@ -0,0 +1,61 @@
+/* frame.c - Tests for stack frame layout.
+ * Copyright (C) 2024 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#include "middle_end/ir/frame.h"
+#include "middle_end/ir/ir_dump.h"
+#include "middle_end/opt/opt.h"
+#include "utils/test_utils.h"
+
+void *diag_error_memstream = NULL;
+void *diag_warn_memstream = NULL;
+
+void frame_dump(FILE *stream, struct ir_fn_decl *decl)
+{
+    for (struct ir_node *it = decl->body; it; it = it->next) {
+        if (it->type == IR_ALLOCA) {
+            struct ir_alloca *alloca = it->ir;
+            fprintf(stream, "t%ld: %ld\n", alloca->idx, alloca->frame_off);
+        }
+
+        if (it->type == IR_ALLOCA_ARRAY) {
+            struct ir_alloca_array *alloca = it->ir;
+            fprintf(stream, "t%ld: %ld\n", alloca->idx, alloca->frame_off);
+        }
+    }
+
+    fprintf(stream, "frame size: %ld\n", decl->frame_size);
+}
+
+void __frame_test(const char *path, const char *filename, FILE *out_stream)
+{
+    (void) filename;
+
+    struct ir_unit  ir = gen_ir(path);
+    struct ir_node *it = NULL;
+
+    ir_opt_reorder(&ir);
+
+    for (it = ir.fn_decls; it; it = it->next) {
+        struct ir_fn_decl *decl = it->ir;
+
+        ir_frame_build(decl);
+        ir_dump(out_stream, decl);
+        fprintf(out_stream, "--------\n");
+        frame_dump(out_stream, decl);
+    }
+
+    ir_unit_cleanup(&ir);
+}
+
+int frame_test(const char *path, const char *filename)
+{
+    return compare_with_comment(path, filename, __frame_test);
+}
+
+int main()
+{
+    return do_on_each_file("frame", frame_test);
+}
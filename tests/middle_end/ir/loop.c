@@ -0,0 +1,74 @@
+/* loop.c - Tests for loop-nest forest.
+ * Copyright (C) 2024 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#include "middle_end/ir/ir_dump.h"
+#include "middle_end/ir/dom.h"
+#include "middle_end/ir/loop.h"
+#include "utils/test_utils.h"
+
+void *diag_error_memstream = NULL;
+void *diag_warn_memstream = NULL;
+
+void stmts_dump(FILE *stream, const char *name, ir_vector_t *stmts)
+{
+    fprintf(stream, " %s (", name);
+    vector_foreach(*stmts, i) {
+        fprintf(stream, "%ld", vector_at(*stmts, i)->instr_idx);
+        if (i < stmts->count - 1)
+            fprintf(stream, ", ");
+    }
+    fprintf(stream, ")");
+}
+
+void loop_dump(FILE *stream, struct ir_loop *loop)
+{
+    fprintf(stream, "%*sloop %ld: depth %ld", (int) (loop->depth - 1) * 2, "", loop->header->instr_idx, loop->depth);
+    if (loop->preheader)
+        fprintf(stream, ", preheader %ld", loop->preheader->instr_idx);
+    fprintf(stream, "\n%*s", (int) (loop->depth - 1) * 2, "");
+    stmts_dump(stream, "latches", &loop->latches);
+    stmts_dump(stream, "exits", &loop->exits);
+    stmts_dump(stream, "body", &loop->stmts);
+    fprintf(stream, "\n");
+
+    vector_foreach(loop->children, i)
+        loop_dump(stream, vector_at(loop->children, i));
+}
+
+void __loop_test(const char *path, const char *filename, FILE *out_stream)
+{
+    (void) filename;
+
+    struct ir_unit  ir = gen_ir(path);
+    struct ir_node *it = ir.fn_decls;
+
+    while (it) {
+        struct ir_fn_decl *decl = it->ir;
+
+        ir_cfg_build(decl);
+        ir_dominator_tree(decl);
+        ir_loops_build(decl);
+        ir_dump(out_stream, decl);
+        fprintf(out_stream, "--------\n");
+
+        vector_foreach(decl->loops, i)
+            loop_dump(out_stream, vector_at(decl->loops, i));
+
+        it = it->next;
+    }
+
+    ir_unit_cleanup(&ir);
+}
+
+int loop_test(const char *path, const char *filename)
+{
+    return compare_with_comment(path, filename, __loop_test);
+}
+
+int main()
+{
+    return do_on_each_file("loop", loop_test);
+}
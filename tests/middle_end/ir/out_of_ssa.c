@@ -0,0 +1,40 @@
+/* out_of_ssa.c - Tests for translation out of SSA form.
+ * Copyright (C) 2023 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#include "middle_end/ir/ir_dump.h"
+#include "middle_end/ir/ssa.h"
+#include "utils/test_utils.h"
+
+void *diag_error_memstream = NULL;
+void *diag_warn_memstream = NULL;
+
+void __out_of_ssa_test(const char *path, unused const char *filename, FILE *out_stream)
+{
+    struct ir_unit  ir = gen_ir(path);
+    struct ir_node *it = ir.fn_decls;
+
+    while (it) {
+        struct ir_fn_decl *decl = it->ir;
+        ir_cfg_build(decl);
+        it = it->next;
+    }
+
+    ir_compute_ssa(ir.fn_decls);
+    ir_destroy_ssa(ir.fn_decls);
+    ir_dump_unit(out_stream, &ir);
+
+    ir_unit_cleanup(&ir);
+}
+
+int out_of_ssa_test(const char *path, const char *filename)
+{
+    return compare_with_comment(path, filename, __out_of_ssa_test);
+}
+
+int main()
+{
+    return do_on_each_file("out_of_ssa", out_of_ssa_test);
+}
@@ -14,9 +14,10 @@ void *diag_warn_memstream = NULL;
 
 void __reg_alloc_test(const char *path, unused const char *filename, FILE *out_stream)
 {
-    struct ir_unit ir = gen_ir(path);
+    struct ir_reg_file file = {.count = 8};
+    struct ir_unit     ir   = gen_ir(path);
     ir_opt_reorder(&ir);
-    ir_reg_alloc(&ir, /*hardware_regs=*/8);
+    ir_reg_alloc(&ir, &file);
     ir_dump_unit(stdout, &ir);
     ir_dump_unit(out_stream, &ir);
     ir_unit_cleanup(&ir);
@@ -6,6 +6,8 @@
 
 #include "middle_end/ir/ddg.h"
 #include "middle_end/ir/ir_dump.h"
+#include "middle_end/ir/ssa.h"
+#include "middle_end/ir/type.h"
 #include "middle_end/opt/opt.h"
 #include "utils/test_utils.h"
 
@@ -74,6 +76,49 @@ void __opt_test(const char *path, const char *filename, FILE *out_stream)
     ir_unit_cleanup(&ir);
 }
 
+void dce(struct ir_unit *ir)
+{
+    ir_compute_ssa(ir->fn_decls);
+    ir_opt_dce(ir);
+}
+
+void gvn(struct ir_unit *ir)
+{
+    ir_compute_ssa(ir->fn_decls);
+    ir_opt_gvn(ir);
+}
+
+void licm(struct ir_unit *ir)
+{
+    ir_compute_ssa(ir->fn_decls);
+    ir_opt_motion(ir);
+}
+
+void reassoc(struct ir_unit *ir)
+{
+    ir_type_pass(ir);
+    ir_compute_ssa(ir->fn_decls);
+    ir_opt_reassoc(ir);
+}
+
+void strength(struct ir_unit *ir)
+{
+    ir_type_pass(ir);
+    ir_opt_arith(ir);
+}
+
+void unroll(struct ir_unit *ir)
+{
+    ir_opt_unroll(ir, /*factor=*/4);
+}
+
+void iv(struct ir_unit *ir)
+{
+    ir_compute_ssa(ir->fn_decls);
+    ir_opt_motion(ir);
+    ir_opt_induction(ir);
+}
+
 int opt_test(const char *path, const char *filename)
 {
     return compare_with_comment(path, filename, __opt_test);
@@ -100,12 +145,60 @@ int main()
         return -1;
 #endif
 
-#if 0
-    opt_fn = ir_opt_dead_code_elimination;
+#if 1
+    opt_fn = strength;
+    if (run("strength") < 0)
+        return -1;
+#endif
+
+#if 1
+    opt_fn = dce;
     if (run("dead_code") < 0)
         return -1;
 #endif
 
+#if 1
+    opt_fn = reassoc;
+    if (run("reassoc") < 0)
+        return -1;
+#endif
+
+#if 1
+    opt_fn = gvn;
+    if (run("gvn") < 0)
+        return -1;
+#endif
+
+#if 1
+    opt_fn = licm;
+    if (run("licm") < 0)
+        return -1;
+#endif
+
+#if 1
+    opt_fn = ir_opt_inline;
+    if (run("inline") < 0)
+        return -1;
+#endif
+
+#if 1
+    opt_fn = unroll;
+    if (run("unroll") < 0)
+        return -1;
+#endif
+
+#if 1
+    opt_fn = iv;
+    if (run("iv") < 0)
+        return -1;
+#endif
+
+#if 1
+    opt_fn = ir_opt_simplify_cfg;
+    if (run("simplify_cfg") < 0)
+        return -1;
+#endif
+
 #if 0
     opt_fn = ir_opt_reorder;
     if (run("reorder") < 0)
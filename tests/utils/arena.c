@@ -0,0 +1,36 @@
+/* arena.c - Test case for arena allocator.
+ * Copyright (C) 2024 epoll-reactor <glibcxx.chrono@gmail.com>
+ *
+ * This file is distributed under the MIT license.
+ */
+
+#include "util/arena.h"
+#include "utils/test_utils.h"
+#include <stdint.h>
+
+void *diag_error_memstream = NULL;
+void *diag_warn_memstream = NULL;
+
+int main() {
+    {
+        struct arena arena = {0};
+        char *a = arena_alloc(&arena, 1);
+        char *b = arena_alloc(&arena, 1);
+        ASSERT_TRUE(a);
+        ASSERT_TRUE(b);
+        ASSERT_EQ(b - a, 8);
+        ASSERT_EQ(*a, 0);
+        arena_destroy(&arena);
+        ASSERT_FALSE(arena.head);
+    }
+
+    {
+        struct arena arena = {0};
+        uint64_t *big = arena_alloc(&arena, 100000 * sizeof (uint64_t));
+        for (uint64_t i = 0; i < 100000; ++i)
+            ASSERT_EQ(big[i], 0);
+        void *small = arena_alloc(&arena, 16);
+        ASSERT_TRUE(small);
+        arena_destroy(&arena);
+    }
+}